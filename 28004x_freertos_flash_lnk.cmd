@@ -1,3 +1,8 @@
+#if !defined(__TI_EABI__)
+CLA_SCRATCHPAD_SIZE = 0x100;
+--undef_sym=__cla_scratchpad_end
+--undef_sym=__cla_scratchpad_start
+#endif
 
 MEMORY
 {
@@ -12,6 +17,7 @@ PAGE 0 :
    RAMLS2      		: origin = 0x009000, length = 0x000800
    RAMLS3      		: origin = 0x009800, length = 0x000800
    RAMLS4      		: origin = 0x00A000, length = 0x000800
+   RAMLS7          	: origin = 0x00B800, length = 0x000800     /* CLA 程序区 */
    RESET           	: origin = 0x3FFFC0, length = 0x000002
 
    /* Flash sectors */
@@ -48,8 +54,8 @@ PAGE 0 :
    FLASH_BANK1_SEC11 : origin = 0x09B000, length = 0x001000	/* on-chip Flash */
    FLASH_BANK1_SEC12 : origin = 0x09C000, length = 0x001000	/* on-chip Flash */
    FLASH_BANK1_SEC13 : origin = 0x09D000, length = 0x001000	/* on-chip Flash */
-   FLASH_BANK1_SEC14 : origin = 0x09E000, length = 0x001000	/* on-chip Flash */
-   FLASH_BANK1_SEC15 : origin = 0x09F000, length = 0x000FF0	/* on-chip Flash */
+   FLASH_BANK1_SEC14 : origin = 0x09E000, length = 0x001000	/* APP_PARAM 参数存储，不可分配段 */
+   FLASH_BANK1_SEC15 : origin = 0x09F000, length = 0x000FF0	/* APP_PARAM 参数存储，不可分配段 */
 
 //   FLASH_BANK1_SEC15_RSVD : origin = 0x09FFF0, length = 0x000010  /* Reserve and do not use for code as per the errata advisory "Memory: Prefetching Beyond Valid Memory" */
 
@@ -60,8 +66,10 @@ PAGE 1 :
 //   RAMM1_RSVD      : origin = 0x0007F8, length = 0x000008     /* Reserve and do not use for code as per the errata advisory "Memory: Prefetching Beyond Valid Memory" */
 
    RAMLS5      : origin = 0x00A800, length = 0x000800
-   RAMLS6      : origin = 0x00B000, length = 0x000800
-   RAMLS7      : origin = 0x00B800, length = 0x000800
+   RAMLS6      : origin = 0x00B000, length = 0x000800     /* 与 CLA 共用的数据区 */
+
+   CLA1_MSGRAMLOW  : origin = 0x001480, length = 0x000080
+   CLA1_MSGRAMHIGH : origin = 0x001500, length = 0x000080
 
    RAMGS0      : origin = 0x00C000, length = 0x002000
    RAMGS1      : origin = 0x00E000, length = 0x002000
@@ -106,6 +114,8 @@ SECTIONS
 
    ramgs0           : > RAMGS0,    PAGE = 1
    ramgs1           : > RAMGS1,    PAGE = 1
+   ramgs2           : > RAMGS2,    PAGE = 1
+   ramgs3           : > RAMGS3,    PAGE = 1
 
  
 #if defined(__TI_EABI__) 
@@ -130,6 +140,82 @@ SECTIONS
                       PAGE = 0, ALIGN(4)
 #endif
 
+   /* 热路径代码与 FPU 查找表：从 FLASH 加载，启动时由 APP_HOTPATH_init 复制到 RAMLS 运行 */
+#if defined(__TI_EABI__)
+   hotpath          : LOAD = FLASH_BANK0_SEC6,
+                      RUN = RAMLS4,
+                      LOAD_START(HotpathLoadStart),
+                      LOAD_SIZE(HotpathLoadSize),
+                      RUN_START(HotpathRunStart),
+                      RUN_SIZE(HotpathRunSize),
+                      PAGE = 0, ALIGN(4)
+
+   FPUmathTables    : LOAD = FLASH_BANK0_SEC6, PAGE = 0,
+                      RUN = RAMLS6, PAGE = 1,
+                      LOAD_START(FPUmathTablesLoadStart),
+                      LOAD_SIZE(FPUmathTablesLoadSize),
+                      RUN_START(FPUmathTablesRunStart),
+                      ALIGN(4)
+#else
+   hotpath          : LOAD = FLASH_BANK0_SEC6,
+                      RUN = RAMLS4,
+                      LOAD_START(_HotpathLoadStart),
+                      LOAD_SIZE(_HotpathLoadSize),
+                      RUN_START(_HotpathRunStart),
+                      RUN_SIZE(_HotpathRunSize),
+                      PAGE = 0, ALIGN(4)
+
+   FPUmathTables    : LOAD = FLASH_BANK0_SEC6, PAGE = 0,
+                      RUN = RAMLS6, PAGE = 1,
+                      LOAD_START(_FPUmathTablesLoadStart),
+                      LOAD_SIZE(_FPUmathTablesLoadSize),
+                      RUN_START(_FPUmathTablesRunStart),
+                      ALIGN(4)
+#endif
+
+   /* CLA 程序与常量：从 FLASH 加载，由 APP_CLA_init 复制后再把 RAMLS7 切换为 CLA 程序区 */
+   Cla1ToCpuMsgRAM  : > CLA1_MSGRAMLOW,   PAGE = 1
+   CpuToCla1MsgRAM  : > CLA1_MSGRAMHIGH,  PAGE = 1
+
+#if defined(__TI_EABI__)
+   Cla1Prog         : LOAD = FLASH_BANK0_SEC7,
+                      RUN = RAMLS7,
+                      LOAD_START(Cla1ProgLoadStart),
+                      LOAD_SIZE(Cla1ProgLoadSize),
+                      RUN_START(Cla1ProgRunStart),
+                      PAGE = 0, ALIGN(4)
+
+   .const_cla       : LOAD = FLASH_BANK0_SEC7, PAGE = 0,
+                      RUN = RAMLS6, PAGE = 1,
+                      LOAD_START(Cla1ConstLoadStart),
+                      LOAD_SIZE(Cla1ConstLoadSize),
+                      RUN_START(Cla1ConstRunStart),
+                      ALIGN(4)
+
+   .scratchpad      : > RAMLS6,       PAGE = 1
+   .bss_cla         : > RAMLS6,       PAGE = 1
+#else
+   Cla1Prog         : LOAD = FLASH_BANK0_SEC7,
+                      RUN = RAMLS7,
+                      LOAD_START(_Cla1ProgLoadStart),
+                      LOAD_SIZE(_Cla1ProgLoadSize),
+                      RUN_START(_Cla1ProgRunStart),
+                      PAGE = 0, ALIGN(4)
+
+   .const_cla       : LOAD = FLASH_BANK0_SEC7, PAGE = 0,
+                      RUN = RAMLS6, PAGE = 1,
+                      LOAD_START(_Cla1ConstLoadStart),
+                      LOAD_SIZE(_Cla1ConstLoadSize),
+                      RUN_START(_Cla1ConstRunStart),
+                      ALIGN(4)
+
+   CLAscratch       :
+                      { *.obj(CLAscratch)
+                        . += CLA_SCRATCHPAD_SIZE;
+                        *.obj(CLAscratch_end) } >  RAMLS6,  PAGE = 1
+   .bss_cla         : > RAMLS6,       PAGE = 1
+#endif
+
 }
 
 /*
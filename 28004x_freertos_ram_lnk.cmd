@@ -1,3 +1,8 @@
+#if !defined(__TI_EABI__)
+CLA_SCRATCHPAD_SIZE = 0x100;
+--undef_sym=__cla_scratchpad_end
+--undef_sym=__cla_scratchpad_start
+#endif
 
 MEMORY
 {
@@ -12,6 +17,7 @@ PAGE 0 :
    RAMLS2      		: origin = 0x009000, length = 0x000800
    RAMLS3      		: origin = 0x009800, length = 0x000800
    RAMLS4      		: origin = 0x00A000, length = 0x000800
+   RAMLS7          	: origin = 0x00B800, length = 0x000800     /* CLA 程序区 */
    RESET           	: origin = 0x3FFFC0, length = 0x000002
 
  /* Flash sectors: you can use FLASH for program memory when the RAM is filled up*/
@@ -48,8 +54,8 @@ PAGE 0 :
    FLASH_BANK1_SEC11 : origin = 0x09B000, length = 0x001000	/* on-chip Flash */
    FLASH_BANK1_SEC12 : origin = 0x09C000, length = 0x001000	/* on-chip Flash */
    FLASH_BANK1_SEC13 : origin = 0x09D000, length = 0x001000	/* on-chip Flash */
-   FLASH_BANK1_SEC14 : origin = 0x09E000, length = 0x001000	/* on-chip Flash */
-   FLASH_BANK1_SEC15 : origin = 0x09F000, length = 0x001000	/* on-chip Flash */
+   FLASH_BANK1_SEC14 : origin = 0x09E000, length = 0x001000	/* APP_PARAM 参数存储，不可分配段 */
+   FLASH_BANK1_SEC15 : origin = 0x09F000, length = 0x001000	/* APP_PARAM 参数存储，不可分配段 */
 
 PAGE 1 :
 
@@ -58,8 +64,10 @@ PAGE 1 :
 //   RAMM1_RSVD      : origin = 0x0007F8, length = 0x000008     /* Reserve and do not use for code as per the errata advisory "Memory: Prefetching Beyond Valid Memory" */
 
    RAMLS5      : origin = 0x00A800, length = 0x000800
-   RAMLS6      : origin = 0x00B000, length = 0x000800
-   RAMLS7      : origin = 0x00B800, length = 0x000800
+   RAMLS6      : origin = 0x00B000, length = 0x000800     /* 与 CLA 共用的数据区 */
+
+   CLA1_MSGRAMLOW  : origin = 0x001480, length = 0x000080
+   CLA1_MSGRAMHIGH : origin = 0x001500, length = 0x000080
    
    RAMGS0      : origin = 0x00C000, length = 0x002000
    RAMGS1      : origin = 0x00E000, length = 0x002000
@@ -73,6 +81,8 @@ SECTIONS
 {
    codestart        : > BEGIN,     PAGE = 0
    .TI.ramfunc      : > RAMM0,      PAGE = 0
+   hotpath          : >> RAMLS0 | RAMLS1 | RAMLS2 | RAMLS3 | RAMLS4,   PAGE = 0
+   FPUmathTables    : > RAMLS6,     PAGE = 1
    .text            : >> RAMLS0 | RAMLS1 | RAMLS2 | RAMLS3 | RAMLS4,   PAGE = 0
    .cinit           : > RAMM0 | RAMLS3 | RAMLS4,     PAGE = 0
    .switch          : > RAMM0,     PAGE = 0
@@ -105,6 +115,23 @@ SECTIONS
 
    ramgs0           : > RAMGS0,    PAGE = 1
    ramgs1           : > RAMGS1,    PAGE = 1  
+   ramgs2           : > RAMGS2,    PAGE = 1
+   ramgs3           : > RAMGS3,    PAGE = 1
+
+   /* CLA 程序区与数据区，消息 RAM 见 app_cla.h */
+   Cla1Prog         : > RAMLS7,         PAGE = 0
+   Cla1ToCpuMsgRAM  : > CLA1_MSGRAMLOW,  PAGE = 1
+   CpuToCla1MsgRAM  : > CLA1_MSGRAMHIGH, PAGE = 1
+   .bss_cla         : > RAMLS6,         PAGE = 1
+   .const_cla       : > RAMLS6,         PAGE = 1
+#if defined(__TI_EABI__)
+   .scratchpad      : > RAMLS6,         PAGE = 1
+#else
+   CLAscratch       :
+                      { *.obj(CLAscratch)
+                        . += CLA_SCRATCHPAD_SIZE;
+                        *.obj(CLAscratch_end) } >  RAMLS6,  PAGE = 1
+#endif
 }
 
 /*
@@ -0,0 +1,323 @@
+/**
+ * @file app_can.c
+ * @brief CAN 命令与遥测实现文件。
+ */
+
+#include "app_can.h"
+#include "app_cla.h"
+#include "app_drv8316.h"
+#include "drv_can.h"
+#include "drv_adc.h"
+
+#include <stddef.h>
+
+/** 命令帧最短长度。 */
+#define APP_CAN_COMMAND_LENGTH      (6U)
+
+/** 接收过滤器深度：命令帧到达间隔远大于一个 tick，2 个邮箱足够。 */
+#define APP_CAN_COMMAND_DEPTH       (2U)
+
+/** DRV8316 过温位在温度报文中的位置。 */
+#define APP_CAN_THERMAL_OT          (0x01U)
+#define APP_CAN_THERMAL_OTW         (0x02U)
+#define APP_CAN_THERMAL_OTS         (0x04U)
+
+static bool     s_running = false;
+static uint32_t s_tickHz = 1000U;
+static uint16_t s_timeoutTicks = 0U;
+static uint16_t s_sinceCommand = 0U;
+static uint16_t s_lastAlive = 0U;
+static bool     s_haveAlive = false;
+
+static uint16_t s_faultHandle = DRV_CAN_INVALID_HANDLE;
+static uint16_t s_currentsHandle = DRV_CAN_INVALID_HANDLE;
+static uint16_t s_temperatureHandle = DRV_CAN_INVALID_HANDLE;
+static uint16_t s_fault[4] = { 0U, 0U, 0U, 0U };
+
+#if APP_CAN_LOOPBACK
+static uint16_t s_selfTestHandle = DRV_CAN_INVALID_HANDLE;
+static uint16_t s_selfTestAlive = 0U;
+#endif
+
+static APP_CAN_Command s_command;
+
+static uint16_t APP_CAN_msToTicks(uint32_t ms)
+{
+    uint32_t ticks = (ms * s_tickHz + 999U) / 1000U;
+
+    return (uint16_t)((ticks == 0U) ? 1U : ((ticks > 0xFFFFU) ? 0xFFFFU : ticks));
+}
+
+static void APP_CAN_putInt16(uint16_t *data, int32_t value)
+{
+    if(value > 32767)
+    {
+        value = 32767;
+    }
+    else if(value < -32768)
+    {
+        value = -32768;
+    }
+
+    data[0] = (uint16_t)value & 0xFFU;
+    data[1] = ((uint16_t)value >> 8) & 0xFFU;
+}
+
+static void APP_CAN_putUint16(uint16_t *data, uint32_t value)
+{
+    if(value > 0xFFFFU)
+    {
+        value = 0xFFFFU;
+    }
+
+    data[0] = (uint16_t)value & 0xFFU;
+    data[1] = ((uint16_t)value >> 8) & 0xFFU;
+}
+
+static int16_t APP_CAN_getInt16(const uint16_t *data)
+{
+    return (int16_t)((data[0] & 0xFFU) | ((data[1] & 0xFFU) << 8));
+}
+
+static int32_t APP_CAN_toMilli(float value)
+{
+    float scaled = value * 1000.0f;
+
+    /* 先限幅再转换，避免超出 int32 范围。 */
+    if(scaled > 32767.0f)
+    {
+        return 32767;
+    }
+
+    if(scaled < -32768.0f)
+    {
+        return -32768;
+    }
+
+    return (int32_t)((scaled >= 0.0f) ? (scaled + 0.5f) : (scaled - 0.5f));
+}
+
+bool APP_CAN_init(uint32_t tickHz)
+{
+    bool ok;
+
+    s_tickHz = (tickHz == 0U) ? 1U : tickHz;
+    s_timeoutTicks = APP_CAN_msToTicks(APP_CAN_COMMAND_TIMEOUT_MS);
+
+    DRV_CAN_init(s_tickHz);
+
+    s_faultHandle = DRV_CAN_addTxMessage(APP_CAN_ID_FAULT + APP_CAN_NODE_ID, 4U,
+                                         APP_CAN_msToTicks(APP_CAN_FAULT_PERIOD_MS));
+    s_currentsHandle = DRV_CAN_addTxMessage(APP_CAN_ID_CURRENTS + APP_CAN_NODE_ID, 8U,
+                                            APP_CAN_msToTicks(APP_CAN_CURRENTS_PERIOD_MS));
+    s_temperatureHandle = DRV_CAN_addTxMessage(APP_CAN_ID_TEMPERATURE + APP_CAN_NODE_ID, 5U,
+                                               APP_CAN_msToTicks(APP_CAN_TEMPERATURE_PERIOD_MS));
+
+    ok = (s_faultHandle != DRV_CAN_INVALID_HANDLE) && (s_currentsHandle != DRV_CAN_INVALID_HANDLE) &&
+         (s_temperatureHandle != DRV_CAN_INVALID_HANDLE) &&
+         DRV_CAN_addRxFilter(APP_CAN_ID_COMMAND + APP_CAN_NODE_ID, DRV_CAN_ID_STD_MASK, APP_CAN_COMMAND_DEPTH);
+
+#if APP_CAN_LOOPBACK
+    /* 回环自检：以命令 ID 发送不使能的命令帧，经本节点的接收过滤器收回。 */
+    s_selfTestHandle = DRV_CAN_addTxMessage(APP_CAN_ID_COMMAND + APP_CAN_NODE_ID, APP_CAN_COMMAND_LENGTH,
+                                            APP_CAN_msToTicks(APP_CAN_COMMAND_TIMEOUT_MS / 2U));
+    ok = ok && (s_selfTestHandle != DRV_CAN_INVALID_HANDLE);
+#endif
+
+    ok = ok && DRV_CAN_start(APP_CAN_LOOPBACK != 0);
+
+    if(ok)
+    {
+        DRV_CAN_setThrottle(DRV_CAN_THROTTLE_ADAPTIVE, APP_CAN_SHARE_PERCENT);
+    }
+
+    s_running = ok;
+
+    return ok;
+}
+
+/**
+ * @brief 处理一帧命令。
+ */
+static void APP_CAN_handleCommand(const DRV_CAN_Frame *frame)
+{
+    bool enable;
+    float iqRef;
+
+    if(frame->length < APP_CAN_COMMAND_LENGTH)
+    {
+        return;
+    }
+
+    if(s_haveAlive && (frame->data[1] == s_lastAlive))
+    {
+        s_command.stale++;
+        return;
+    }
+
+    s_haveAlive = true;
+    s_lastAlive = frame->data[1];
+    s_sinceCommand = 0U;
+
+    enable = (frame->data[0] & APP_CAN_COMMAND_ENABLE) != 0U;
+    iqRef  = (float)APP_CAN_getInt16(&frame->data[2]) * 0.001f;
+
+    s_command.commands++;
+    s_command.timedOut = false;
+    s_command.iqRef    = iqRef;
+    s_command.speedRpm = APP_CAN_getInt16(&frame->data[4]);
+
+    if(enable)
+    {
+        APP_CLA_setCurrentRef(0.0f, iqRef);
+
+        if(!s_command.enabled)
+        {
+            APP_CLA_setEnabled(true);
+            s_command.enabled = true;
+        }
+    }
+    else if(s_command.enabled)
+    {
+        APP_CLA_setEnabled(false);
+        APP_CLA_setCurrentRef(0.0f, 0.0f);
+        s_command.enabled = false;
+    }
+}
+
+/**
+ * @brief 由 CAN 使能后命令中断时关闭闭环。
+ */
+static void APP_CAN_checkTimeout(void)
+{
+    if(s_sinceCommand < 0xFFFFU)
+    {
+        s_sinceCommand++;
+    }
+
+    if(s_command.enabled && (s_sinceCommand >= s_timeoutTicks))
+    {
+        APP_CLA_setEnabled(false);
+        APP_CLA_setCurrentRef(0.0f, 0.0f);
+        s_command.enabled  = false;
+        s_command.timedOut = true;
+        s_command.timeouts++;
+    }
+}
+
+static void APP_CAN_updateCurrents(void)
+{
+    APP_CLA_Status status;
+    uint16_t data[8];
+
+    if(!APP_CLA_getStatus(&status))
+    {
+        return;
+    }
+
+    APP_CAN_putInt16(&data[0], APP_CAN_toMilli(status.ia));
+    APP_CAN_putInt16(&data[2], APP_CAN_toMilli(status.ib));
+    APP_CAN_putInt16(&data[4], APP_CAN_toMilli(status.id));
+    APP_CAN_putInt16(&data[6], APP_CAN_toMilli(status.iq));
+    (void)DRV_CAN_update(s_currentsHandle, data);
+}
+
+/**
+ * @brief 更新故障与温度报文，故障字变化时立即发送。
+ */
+static void APP_CAN_updateStatus(void)
+{
+    DRV8316_VARS_t vars;
+    APP_CLA_Status status;
+    uint16_t fault[4];
+    uint16_t temperature[5];
+    uint16_t thermal = 0U;
+    float vdc = 0.0f;
+    bool changed = false;
+    uint16_t i;
+
+    fault[0] = s_fault[0];
+    fault[1] = s_fault[1];
+    fault[2] = s_fault[2];
+
+    if(APP_DRV8316_getStatusSnapshot(APP_DRV8316_DEVICE_0, &vars))
+    {
+        fault[0] = vars.statReg00.all & 0xFFU;
+        fault[1] = vars.statReg01.all & 0xFFU;
+        fault[2] = vars.statReg02.all & 0xFFU;
+    }
+
+    fault[3] = (s_command.enabled ? APP_CAN_STATE_ENABLED : 0U) | (s_command.timedOut ? APP_CAN_STATE_TIMEOUT : 0U);
+
+    for(i = 0U; i < 4U; i++)
+    {
+        changed = changed || (fault[i] != s_fault[i]);
+        s_fault[i] = fault[i];
+    }
+
+    if(changed)
+    {
+        (void)DRV_CAN_send(s_faultHandle, fault);
+    }
+    else
+    {
+        (void)DRV_CAN_update(s_faultHandle, fault);
+    }
+
+    if(APP_CLA_getStatus(&status))
+    {
+        vdc = status.vdc;
+    }
+
+    thermal |= ((fault[0] & 0x02U) != 0U) ? APP_CAN_THERMAL_OT : 0U;     /* STAT00.OT */
+    thermal |= ((fault[1] & 0x80U) != 0U) ? APP_CAN_THERMAL_OTW : 0U;    /* STAT01.OTW */
+    thermal |= ((fault[1] & 0x40U) != 0U) ? APP_CAN_THERMAL_OTS : 0U;    /* STAT01.OTS */
+
+    APP_CAN_putInt16(&temperature[0], DRV_ADC_readTemperature());
+    APP_CAN_putUint16(&temperature[2], ((vdc > 0.0f) && (vdc < 655.35f)) ? (uint32_t)(vdc * 100.0f + 0.5f) :
+                                       ((vdc > 0.0f) ? 0xFFFFU : 0U));
+    temperature[4] = thermal;
+    (void)DRV_CAN_update(s_temperatureHandle, temperature);
+}
+
+void APP_CAN_service(void)
+{
+    DRV_CAN_Frame frame;
+
+    if(!s_running)
+    {
+        return;
+    }
+
+    while(DRV_CAN_receive(&frame))
+    {
+        if(frame.id == (APP_CAN_ID_COMMAND + APP_CAN_NODE_ID))
+        {
+            APP_CAN_handleCommand(&frame);
+        }
+    }
+
+    APP_CAN_checkTimeout();
+    APP_CAN_updateCurrents();
+    APP_CAN_updateStatus();
+
+#if APP_CAN_LOOPBACK
+    {
+        uint16_t selfTest[APP_CAN_COMMAND_LENGTH] = { 0U, 0U, 0U, 0U, 0U, 0U };
+
+        s_selfTestAlive = (s_selfTestAlive + 1U) & 0xFFU;
+        selfTest[1] = s_selfTestAlive;
+        (void)DRV_CAN_update(s_selfTestHandle, selfTest);
+    }
+#endif
+
+    DRV_CAN_service();
+}
+
+void APP_CAN_getCommand(APP_CAN_Command *command)
+{
+    if(command != NULL)
+    {
+        *command = s_command;
+    }
+}
@@ -0,0 +1,245 @@
+/**
+ * @file app_cla.c
+ * @brief CLA 电流环的 C28x 侧：存储配置、任务启动、命令发布与状态访问。
+ */
+
+#include "app_cla.h"
+
+#include <string.h>
+
+#include "driverlib.h"
+#include "device.h"
+#include "drv_adc.h"
+#include "drv_eqep.h"
+
+#define APP_CLA_STATUS_RETRY        (16U)   /**< 状态读取不一致时的重试次数。 */
+#define APP_CLA_OFFSET_SAMPLES      (16U)   /**< 零点标定的采样次数。 */
+#define APP_CLA_OFFSET_DELAY_US     (100U)  /**< 零点标定的采样间隔，长于一个 PWM 周期。 */
+
+#pragma CODE_SECTION(APP_CLA_publish, "hotpath")
+
+APP_CLA_Command APP_CLA_command;
+
+#pragma DATA_SECTION(APP_CLA_commandBlock, "CpuToCla1MsgRAM")
+APP_CLA_CommandBlock APP_CLA_commandBlock;
+
+#pragma DATA_SECTION(APP_CLA_status, "Cla1ToCpuMsgRAM")
+volatile APP_CLA_Status APP_CLA_status;
+
+/**
+ * @brief 配置 CLA 可访问的 RAM：LS7 为程序区，LS6 为数据区，并清零消息 RAM。
+ */
+static void APP_CLA_configureMemory(void)
+{
+#ifdef _FLASH
+    /* 切换为 CLA 程序区之前复制，此后 CPU 对 LS7 只读。 */
+    memcpy(&Cla1ProgRunStart, &Cla1ProgLoadStart, (size_t)&Cla1ProgLoadSize);
+    memcpy(&Cla1ConstRunStart, &Cla1ConstLoadStart, (size_t)&Cla1ConstLoadSize);
+#endif
+
+    MemCfg_initSections(MEMCFG_SECT_MSGX_ALL);
+    while(!MemCfg_getInitStatus(MEMCFG_SECT_MSGX_ALL))
+    {
+    }
+
+    MemCfg_setLSRAMControllerSel(MEMCFG_SECT_LS7, MEMCFG_LSRAMCONTROLLER_CPU_CLA1);
+    MemCfg_setCLAMemType(MEMCFG_SECT_LS7, MEMCFG_CLA_MEM_PROGRAM);
+
+    MemCfg_setLSRAMControllerSel(MEMCFG_SECT_LS6, MEMCFG_LSRAMCONTROLLER_CPU_CLA1);
+    MemCfg_setCLAMemType(MEMCFG_SECT_LS6, MEMCFG_CLA_MEM_DATA);
+}
+
+/**
+ * @brief 命令初始化为默认值，闭环关闭。
+ */
+static void APP_CLA_loadDefaults(void)
+{
+    APP_CLA_command.enable        = 0U;
+    APP_CLA_command.angleSource   = APP_CLA_ANGLE_COMMAND;
+    APP_CLA_command.idRef         = 0.0f;
+    APP_CLA_command.iqRef         = 0.0f;
+    APP_CLA_command.angle         = 0.0f;
+    APP_CLA_command.encoderOffset = 0.0f;
+    APP_CLA_command.kp            = APP_CLA_DEFAULT_KP;
+    APP_CLA_command.ki            = APP_CLA_DEFAULT_KI;
+    APP_CLA_command.vLimitPu      = APP_CLA_DEFAULT_VLIMIT_PU;
+    APP_CLA_command.currentScale  = APP_CLA_DEFAULT_CURRENT_SCALE;
+    APP_CLA_command.offsetA       = APP_CLA_DEFAULT_OFFSET;
+    APP_CLA_command.offsetB       = APP_CLA_DEFAULT_OFFSET;
+    APP_CLA_command.vdcScale      = APP_CLA_DEFAULT_VDC_SCALE;
+    APP_CLA_command.vdcMin        = APP_CLA_DEFAULT_VDC_MIN;
+}
+
+void APP_CLA_init(void)
+{
+    APP_CLA_configureMemory();
+    APP_CLA_loadDefaults();
+
+    /* 任务 8 锁存这份命令，任务 1 第一次运行前命令已完整。 */
+    APP_CLA_commandBlock.sequence = 0U;
+    APP_CLA_publish();
+
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_1, (uint16_t)&Cla1Task1);
+    CLA_mapTaskVector(CLA1_BASE, CLA_MVECT_8, (uint16_t)&Cla1Task8);
+
+    CLA_enableIACK(CLA1_BASE);
+    CLA_enableTasks(CLA1_BASE, CLA_TASKFLAG_1 | CLA_TASKFLAG_8);
+
+    /* 任务 8 清零 CLA 数据区中的积分状态，完成后再接入 ADC 触发。 */
+    CLA_forceTasks(CLA1_BASE, CLA_TASKFLAG_8);
+    while(CLA_getTaskRunStatus(CLA1_BASE, CLA_TASK_8))
+    {
+    }
+
+    CLA_setTriggerSource(CLA_TASK_1, CLA_TRIGGER_ADCA1);
+}
+
+void APP_CLA_publish(void)
+{
+    volatile APP_CLA_CommandBlock *block = &APP_CLA_commandBlock;
+
+    /* 奇数表示写入中，CLA 据此沿用上一份命令。 */
+    block->sequence++;
+    APP_CLA_LOOP_copyCommand(&block->command, &APP_CLA_command);
+    block->sequence++;
+}
+
+void APP_CLA_setEnabled(bool enabled)
+{
+    APP_CLA_command.enable = enabled ? 1U : 0U;
+}
+
+void APP_CLA_setCurrentRef(float idRef, float iqRef)
+{
+    bool intsOff = Interrupt_disableGlobal();
+
+    APP_CLA_command.idRef = idRef;
+    APP_CLA_command.iqRef = iqRef;
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+}
+
+void APP_CLA_setAngle(float anglePu)
+{
+    APP_CLA_command.angle = anglePu;
+}
+
+void APP_CLA_setEncoderAngle(bool enabled)
+{
+    bool intsOff = Interrupt_disableGlobal();
+
+    APP_CLA_command.encoderOffset = DRV_EQEP_getAngleOffset();
+    APP_CLA_command.angleSource   = enabled ? APP_CLA_ANGLE_ENCODER : APP_CLA_ANGLE_COMMAND;
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+}
+
+bool APP_CLA_setGains(float kp, float ki)
+{
+    bool intsOff;
+
+    if((kp < 0.0f) || (ki < 0.0f))
+    {
+        return false;
+    }
+
+    intsOff = Interrupt_disableGlobal();
+
+    APP_CLA_command.kp = kp;
+    APP_CLA_command.ki = ki;
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+
+    return true;
+}
+
+bool APP_CLA_calibrateOffsets(void)
+{
+    uint32_t sumA = 0U;
+    uint32_t sumB = 0U;
+    uint16_t ia;
+    uint16_t ib;
+    uint16_t i;
+    bool intsOff;
+
+    if(APP_CLA_command.enable != 0U)
+    {
+        return false;
+    }
+
+    for(i = 0U; i < APP_CLA_OFFSET_SAMPLES; i++)
+    {
+        DRV_ADC_read(&ia, &ib, NULL);
+        sumA += ia;
+        sumB += ib;
+        DEVICE_DELAY_US(APP_CLA_OFFSET_DELAY_US);
+    }
+
+    intsOff = Interrupt_disableGlobal();
+
+    APP_CLA_command.offsetA = (float)sumA / (float)APP_CLA_OFFSET_SAMPLES;
+    APP_CLA_command.offsetB = (float)sumB / (float)APP_CLA_OFFSET_SAMPLES;
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+
+    return true;
+}
+
+bool APP_CLA_getStatus(APP_CLA_Status *status)
+{
+    const volatile APP_CLA_Status *src = &APP_CLA_status;
+    uint16_t retry;
+
+    if(status == NULL)
+    {
+        return false;
+    }
+
+    /* count 为奇数时 CLA 正在写入；前后两次相同且为偶数说明副本来自同一周期。 */
+    for(retry = 0U; retry < APP_CLA_STATUS_RETRY; retry++)
+    {
+        uint32_t count = src->count;
+
+        if((count & 1U) != 0U)
+        {
+            continue;
+        }
+
+        status->ia      = src->ia;
+        status->ib      = src->ib;
+        status->id      = src->id;
+        status->iq      = src->iq;
+        status->vd      = src->vd;
+        status->vq      = src->vq;
+        status->vdc     = src->vdc;
+        status->angle   = src->angle;
+        status->duty[0] = src->duty[0];
+        status->duty[1] = src->duty[1];
+        status->duty[2] = src->duty[2];
+
+        if(src->count == count)
+        {
+            status->count = count;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool APP_CLA_hasOverflowed(void)
+{
+    return CLA_getTaskOverflowFlag(CLA1_BASE, CLA_TASK_1);
+}
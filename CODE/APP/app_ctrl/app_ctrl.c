@@ -0,0 +1,337 @@
+/**
+ * @file app_ctrl.c
+ * @brief 多速率控制执行器实现。
+ *
+ * 中断时隙按编号顺序执行，同一中断内先完成快速时隙，再执行到期的中速、慢速时隙。
+ * 各时隙以倒计数决定是否到期，重装值为分频比减 1，执行路径只有比较与减法，
+ * 中断开销固定。执行器与中断服务程序放在 RAM 中运行，避开闪存等待周期。
+ */
+
+#include "app_ctrl.h"
+#include "app_event.h"
+#include "app_scope.h"
+#include "app_stats.h"
+#include "app_xcp.h"
+
+#include "device.h"
+#include "driverlib/interrupt.h"
+
+#include "drv_epwm.h"
+
+/** 在中断中执行的时隙数量，后台时隙排在最后。 */
+#define APP_CTRL_ISR_SLOT_COUNT     (APP_CTRL_SLOT_BACKGROUND)
+
+/**
+ * @brief 单个时隙的配置与运行状态。
+ */
+typedef struct
+{
+    APP_CTRL_SlotFxn   fxn;             /**< 处理函数，NULL 表示未使用。 */
+    void              *context;         /**< 处理函数参数。 */
+    uint16_t           ratio;           /**< 分频比。 */
+    uint16_t           phase;           /**< 相位。 */
+    uint16_t           countdown;       /**< 距下一次执行的中断数。 */
+    volatile uint16_t  pending;         /**< 后台时隙已释放但尚未执行完成。 */
+    uint32_t           nominalCycles;   /**< 名义启动间隔。 */
+    uint32_t           lastStart;       /**< 上一次启动时刻。 */
+    APP_CTRL_SlotStats stats;           /**< 运行统计。 */
+} APP_CTRL_SlotState;
+
+static APP_CTRL_SlotState s_slots[APP_CTRL_SLOT_COUNT];
+static uint32_t           s_periodCycles = 0U;
+static volatile uint32_t  s_tickCount = 0U;
+static volatile bool      s_running = false;
+
+#pragma CODE_SECTION(APP_CTRL_isr, "hotpath")
+#pragma CODE_SECTION(APP_CTRL_runIsrSlot, "hotpath")
+
+/**
+ * @brief 更新执行时间与抖动统计。
+ */
+static inline void APP_CTRL_recordRun(APP_CTRL_SlotState *state, uint32_t begin,
+                                      uint32_t elapsed, uint32_t jitter)
+{
+    APP_CTRL_SlotStats *stats = &state->stats;
+
+    stats->lastCycles = elapsed;
+
+    if(elapsed > stats->maxCycles)
+    {
+        stats->maxCycles = elapsed;
+    }
+
+    if(jitter > stats->maxJitterCycles)
+    {
+        stats->maxJitterCycles = jitter;
+    }
+
+    state->lastStart = begin;
+    stats->runs++;
+}
+
+/**
+ * @brief 执行一个中断时隙。
+ *
+ * @param[in] release 本次中断入口时刻。
+ */
+static void APP_CTRL_runIsrSlot(APP_CTRL_SlotState *state, uint32_t release)
+{
+    uint32_t begin = APP_STATS_now();
+    uint32_t end;
+    uint32_t jitter = 0U;
+
+    state->fxn(state->context);
+
+    end = APP_STATS_now();
+
+    /* 首次执行没有上一次启动时刻，不计抖动。 */
+    if(state->stats.runs != 0U)
+    {
+        uint32_t interval = begin - state->lastStart;
+
+        jitter = (interval > state->nominalCycles) ?
+                 (interval - state->nominalCycles) : (state->nominalCycles - interval);
+    }
+
+    if((end - release) > s_periodCycles)
+    {
+        state->stats.overruns++;
+    }
+
+    APP_CTRL_recordRun(state, begin, end - begin, jitter);
+}
+
+void APP_CTRL_init(void)
+{
+    uint16_t slot;
+
+    s_running      = false;
+    s_tickCount    = 0U;
+    s_periodCycles = 0U;
+
+    for(slot = 0U; slot < APP_CTRL_SLOT_COUNT; slot++)
+    {
+        s_slots[slot].fxn     = NULL;
+        s_slots[slot].context = NULL;
+        s_slots[slot].ratio   = 1U;
+        s_slots[slot].phase   = 0U;
+    }
+
+    APP_CTRL_resetStats();
+}
+
+bool APP_CTRL_setSlot(uint16_t slot, APP_CTRL_SlotFxn fxn, void *context,
+                      uint16_t ratio, uint16_t phase)
+{
+    APP_CTRL_SlotState *state;
+
+    if((slot >= APP_CTRL_SLOT_COUNT) || s_running ||
+       (ratio == 0U) || (phase >= ratio) ||
+       ((slot == APP_CTRL_SLOT_FAST) && (ratio != 1U)))
+    {
+        return false;
+    }
+
+    state = &s_slots[slot];
+    state->fxn     = fxn;
+    state->context = context;
+    state->ratio   = ratio;
+    state->phase   = phase;
+
+    return true;
+}
+
+bool APP_CTRL_start(uint16_t pwmDivider)
+{
+    uint32_t pwmCycles = DRV_EPWM_getPeriodCycles();
+    bool anySlot = false;
+    uint16_t slot;
+
+    if(s_running || (pwmDivider == 0U) || (pwmDivider > DRV_EPWM_INT_MAX_EVENTS) ||
+       (pwmCycles == 0U))
+    {
+        return false;
+    }
+
+    for(slot = 0U; slot < APP_CTRL_SLOT_COUNT; slot++)
+    {
+        anySlot = anySlot || (s_slots[slot].fxn != NULL);
+    }
+
+    if(!anySlot)
+    {
+        return false;
+    }
+
+    s_periodCycles = pwmCycles * pwmDivider;
+    s_tickCount    = 0U;
+
+    for(slot = 0U; slot < APP_CTRL_SLOT_COUNT; slot++)
+    {
+        APP_CTRL_SlotState *state = &s_slots[slot];
+
+        state->countdown     = state->phase;
+        state->pending       = 0U;
+        state->nominalCycles = s_periodCycles * state->ratio;
+    }
+
+    APP_CTRL_resetStats();
+
+    Interrupt_register(INT_EPWM1, &APP_CTRL_isr);
+
+    if(!DRV_EPWM_enableInterrupt(pwmDivider))
+    {
+        return false;
+    }
+
+    s_running = true;
+
+    return true;
+}
+
+void APP_CTRL_stop(void)
+{
+    DRV_EPWM_disableInterrupt();
+    s_running = false;
+}
+
+uint32_t APP_CTRL_getTickCount(void)
+{
+    return s_tickCount;
+}
+
+bool APP_CTRL_getSlotStats(uint16_t slot, APP_CTRL_SlotStats *stats)
+{
+    if((slot >= APP_CTRL_SLOT_COUNT) || (stats == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = s_slots[slot].stats;
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+void APP_CTRL_resetStats(void)
+{
+    uint16_t slot;
+
+    taskENTER_CRITICAL();
+
+    for(slot = 0U; slot < APP_CTRL_SLOT_COUNT; slot++)
+    {
+        s_slots[slot].stats.runs            = 0U;
+        s_slots[slot].stats.lastCycles      = 0U;
+        s_slots[slot].stats.maxCycles       = 0U;
+        s_slots[slot].stats.overruns        = 0U;
+        s_slots[slot].stats.maxJitterCycles = 0U;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+__interrupt void APP_CTRL_isr(void)
+{
+    uint32_t release = APP_STATS_isrEnter();
+    APP_CTRL_SlotState *background = &s_slots[APP_CTRL_SLOT_BACKGROUND];
+    BaseType_t woken = pdFALSE;
+    uint16_t slot;
+
+    s_tickCount++;
+
+    /* 安全点：标定写入在任何时隙读取参数之前一次完成。 */
+    APP_XCP_safePoint();
+
+    for(slot = 0U; slot < APP_CTRL_ISR_SLOT_COUNT; slot++)
+    {
+        APP_CTRL_SlotState *state = &s_slots[slot];
+
+        if(state->fxn == NULL)
+        {
+            continue;
+        }
+
+        if(state->countdown != 0U)
+        {
+            state->countdown--;
+            continue;
+        }
+
+        state->countdown = state->ratio - 1U;
+        APP_CTRL_runIsrSlot(state, release);
+    }
+
+    /* 中断时隙全部完成后记录，采到的是本周期的计算结果。 */
+    APP_SCOPE_sample();
+    APP_XCP_daqSample(release);
+
+    if(background->fxn != NULL)
+    {
+        if(background->countdown != 0U)
+        {
+            background->countdown--;
+        }
+        else
+        {
+            background->countdown = background->ratio - 1U;
+
+            /* 上一次释放尚未执行完成，跳过本次并计为超时。 */
+            if(background->pending != 0U)
+            {
+                background->stats.overruns++;
+            }
+            else
+            {
+                background->pending = 1U;
+                (void)APP_EVENT_postFromISR(APP_EVENT_SRC_CTRL, 0U, 0U, &woken);
+            }
+        }
+    }
+
+    DRV_EPWM_clearInterrupt();
+
+    APP_STATS_isrExit(APP_STATS_ISR_CTRL, release);
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 后台时隙任务。
+ *
+ * 每个事件对应一次释放，事件时间戳即释放时刻。中断会同时修改超时计数，统计
+ * 在临界区内更新，保证读者取得一致的副本。
+ */
+void APP_CTRL_TASK(void *pvParameters)
+{
+    APP_CTRL_SlotState *state = &s_slots[APP_CTRL_SLOT_BACKGROUND];
+
+    (void)pvParameters;
+
+    (void)APP_EVENT_bind(APP_EVENT_SRC_CTRL);
+
+    for(;;)
+    {
+        APP_EVENT_Event event;
+
+        (void)APP_EVENT_wait(portMAX_DELAY);
+
+        while(APP_EVENT_receive(APP_EVENT_SRC_CTRL, &event))
+        {
+            APP_CTRL_SlotFxn fxn = state->fxn;
+            uint32_t begin = APP_STATS_now();
+
+            if(fxn != NULL)
+            {
+                fxn(state->context);
+            }
+
+            taskENTER_CRITICAL();
+            APP_CTRL_recordRun(state, begin, APP_STATS_now() - begin, begin - event.timestamp);
+            taskEXIT_CRITICAL();
+
+            state->pending = 0U;
+        }
+    }
+}
@@ -3,40 +3,134 @@
  * @brief DRV8316 应用层管理模块，实现对底层驱动的统一封装与周期性维护。
  *
  * 本模块位于应用层，负责协调 SPI 通道、DRV8316 底层驱动库以及 FreeRTOS 任务，
- * 为上层业务提供线程安全的寄存器访问接口。模块通过静态互斥量保护共享状态，
+ * 为上层业务提供线程安全的寄存器访问接口。模块通过静态互斥量保护请求缓存，
  * 在指定任务中周期性触发寄存器刷新，并响应手动写入或读取请求。
+ *
+ * SPI 扫描只操作任务私有的寄存器镜像，互斥量仅在拷贝请求与回填结果时短暂持有。
+ * 扫描结果通过双缓冲加序号的方式发布，读者无需加锁即可获得一致的快照。
+ *
+ * 模块以器件编号区分多个 DRV8316 实例，所有实例共享同一条 SPI 总线，由同一个
+ * 维护任务依次切换片选完成扫描。全部状态均为静态分配。
+ *
+ * 维护任务在扫描到期或收到 APP_EVENT_SRC_DRV8316 事件时唤醒：寄存器访问请求与
+ * 控制寄存器更新提交后立即投递事件，无需等待下一个扫描周期。
  */
 
 #include "app_drv8316.h"
+#include "app_drv8316_fault.h"
+#include "app_stats.h"
+#include "app_event.h"
 
 #include <string.h>
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 #include "semphr.h"
 
 #include "device.h"
 
 #include "drv8316s.h"
 
-/** DRV8316 底层对象实例，供驱动库初始化句柄时使用。 */
-static DRV8316_Obj     s_drvObj;
-/** 指向底层驱动句柄的指针，用于实际执行 SPI 读写。 */
-static DRV8316_Handle  s_drvHandle = NULL;
-/** 用于缓存驱动库维护的寄存器镜像及命令标志。 */
-static DRV8316_VARS_t  s_drvVars;
-/** 记录当前生效的应用层配置，便于任务动态调整周期。 */
-static APP_DRV8316_Config s_runtimeConfig;
+/** 读者在发布者连续改写时的最大重试次数。 */
+#define APP_DRV8316_SNAPSHOT_RETRY      (3U)
+
+/** 结果表深度，为请求队列深度的两倍，保证结果在被覆盖前至少保留一个完整队列周期。 */
+#define APP_DRV8316_REG_RESULT_DEPTH    (2U * APP_DRV8316_REG_QUEUE_DEPTH)
+/** 由令牌求结果表下标的掩码。 */
+#define APP_DRV8316_REG_RESULT_MASK     (APP_DRV8316_REG_RESULT_DEPTH - 1U)
+
+/** 由维护任务按脏标记写入的控制寄存器数量。 */
+#define APP_DRV8316_CTRL_REG_COUNT      (7U)
+
+/** 唤醒维护任务的事件码，参数为器件编号。 */
+#define APP_DRV8316_EVENT_REG_OPS       (1U)
+#define APP_DRV8316_EVENT_CTRL_UPDATE   (2U)
+
+/**
+ * @brief 已发布寄存器快照的缓冲区。
+ *
+ * 写入顺序为 seqBegin -> vars -> seqEnd，读取顺序与之相反，两端序号一致即表明
+ * 读取期间没有发生改写。
+ */
+typedef struct
+{
+    uint32_t       seqBegin;   /**< 开始写入时的发布序号。 */
+    DRV8316_VARS_t vars;       /**< 寄存器镜像。 */
+    uint32_t       seqEnd;     /**< 写入完成时的发布序号。 */
+} APP_DRV8316_SnapshotBuffer;
+
+/**
+ * @brief 单个 DRV8316 器件的运行实例。
+ */
+typedef struct
+{
+    DRV8316_Obj        drvObj;          /**< 底层驱动对象。 */
+    DRV8316_Handle     drvHandle;       /**< 底层驱动句柄。 */
+    DRV8316_VARS_t     drvVars;         /**< 任务私有的寄存器镜像，SPI 扫描只读写该结构。 */
+    DRV8316_VARS_t     requestVars;     /**< 上层请求写入的控制寄存器值，受互斥量保护。 */
+    DRV8316_VARS_t     deviceVars;      /**< 器件控制寄存器的预期值：已交给写入路径的值或最近一次读回值，受互斥量保护。 */
+    uint16_t           dirtyMask;       /**< 待写入控制寄存器的脏标记，受互斥量保护。 */
+    APP_DRV8316_Config config;          /**< 当前生效的应用层配置。 */
+    volatile TickType_t refreshPeriod;  /**< 该器件的扫描周期（系统节拍数）。 */
+    TickType_t         lastScanTick;    /**< 上一次扫描的时刻，仅由维护任务访问。 */
+    APP_DRV8316_RegToken manualReadToken; /**< 旧版手动读取接口占用的令牌。 */
+    volatile APP_DRV8316_SnapshotBuffer snapshot[2]; /**< 快照双缓冲。 */
+    volatile uint32_t  snapshotSeq;     /**< 最近一次发布的序号，仅由发布者修改。 */
+    volatile bool      scanned;         /**< 维护任务是否已完成第一次扫描。 */
+    volatile bool      initialized;     /**< 该器件是否已完成初始化。 */
+} APP_DRV8316_Instance;
+
+/**
+ * @brief 寄存器访问队列中的单个条目。
+ */
+typedef struct
+{
+    APP_DRV8316_RegOp    op;       /**< 访问操作。 */
+    APP_DRV8316_RegToken token;    /**< 分配给该操作的完成令牌。 */
+    uint16_t             device;   /**< 目标器件编号。 */
+} APP_DRV8316_RegQueueItem;
+
+/**
+ * @brief 寄存器访问结果。
+ */
+typedef struct
+{
+    APP_DRV8316_RegToken  token;   /**< 结果所属令牌，用于识别槽位是否已被复用。 */
+    APP_DRV8316_RegStatus status;  /**< 完成状态。 */
+    uint16_t              data;    /**< 读操作返回的寄存器值，写操作为写入值。 */
+} APP_DRV8316_RegResult;
+
+/** 各器件实例的静态存储。 */
+static APP_DRV8316_Instance s_devices[APP_DRV8316_MAX_DEVICES];
+
+/** 按脏标记位序排列的控制寄存器地址。 */
+static const DRV8316_Address_e s_ctrlRegAddr[APP_DRV8316_CTRL_REG_COUNT] =
+{
+    DRV8316_ADDRESS_CONTROL_1,
+    DRV8316_ADDRESS_CONTROL_2,
+    DRV8316_ADDRESS_CONTROL_3,
+    DRV8316_ADDRESS_CONTROL_4,
+    DRV8316_ADDRESS_CONTROL_5,
+    DRV8316_ADDRESS_CONTROL_6,
+    DRV8316_ADDRESS_CONTROL_10
+};
 
 /** 互斥量静态存储缓冲区，避免堆分配依赖。 */
 static StaticSemaphore_t s_mutexBuffer;
 /** 互斥量句柄，保护模块内部共享状态。 */
 static SemaphoreHandle_t s_mutexHandle = NULL;
 
-/** 标识模块是否已经完成初始化流程。 */
-static volatile bool     s_initialized    = false;
-/** 当前用于任务调度的刷新周期（系统节拍数）。 */
-static TickType_t        s_refreshPeriod  = 0U;
+/** 寄存器访问队列静态存储。 */
+static uint8_t           s_regQueueStorage[APP_DRV8316_REG_QUEUE_DEPTH * sizeof(APP_DRV8316_RegQueueItem)];
+/** 寄存器访问队列控制块。 */
+static StaticQueue_t     s_regQueueBuffer;
+/** 寄存器访问队列句柄，所有器件共用。 */
+static QueueHandle_t     s_regQueueHandle = NULL;
+/** 寄存器访问结果表，受互斥量保护。 */
+static APP_DRV8316_RegResult s_regResults[APP_DRV8316_REG_RESULT_DEPTH];
+/** 下一个待分配的令牌，受互斥量保护。 */
+static APP_DRV8316_RegToken  s_nextRegToken = 1U;
 
 /**
  * @brief 进入模块临界区。
@@ -63,263 +157,726 @@ static void APP_DRV8316_unlock(void)
 }
 
 /**
- * @brief 获取当前任务刷新周期。
+ * @brief 根据器件编号获取已初始化的实例。
  *
- * 当外部配置未设定时，退回到模块默认刷新周期，以保证任务仍能按固定速率运行。
+ * @return 实例指针；编号越界或器件未初始化时返回 NULL。
  */
-static TickType_t APP_DRV8316_getRefreshPeriodTicks(void)
+static APP_DRV8316_Instance *APP_DRV8316_getInstance(uint16_t device)
 {
-    TickType_t ticks;
+    if((device >= APP_DRV8316_MAX_DEVICES) || !s_devices[device].initialized)
+    {
+        return NULL;
+    }
 
-    APP_DRV8316_lock();
-    ticks = s_refreshPeriod;
-    APP_DRV8316_unlock();
+    return &s_devices[device];
+}
+
+/**
+ * @brief 按脏标记位序取出控制寄存器值。
+ */
+static uint16_t APP_DRV8316_getCtrlReg(const DRV8316_VARS_t *vars, uint16_t index)
+{
+    switch(index)
+    {
+        case 0U: return vars->ctrlReg01.all & DRV8316_DATA_MASK;
+        case 1U: return vars->ctrlReg02.all & DRV8316_DATA_MASK;
+        case 2U: return vars->ctrlReg03.all & DRV8316_DATA_MASK;
+        case 3U: return vars->ctrlReg04.all & DRV8316_DATA_MASK;
+        case 4U: return vars->ctrlReg05.all & DRV8316_DATA_MASK;
+        case 5U: return vars->ctrlReg06.all & DRV8316_DATA_MASK;
+        default: return vars->ctrlReg10.all & DRV8316_DATA_MASK;
+    }
+}
+
+/**
+ * @brief 按脏标记位序写入控制寄存器镜像。
+ */
+static void APP_DRV8316_setCtrlReg(DRV8316_VARS_t *vars, uint16_t index, uint16_t value)
+{
+    switch(index)
+    {
+        case 0U: vars->ctrlReg01.all = value; break;
+        case 1U: vars->ctrlReg02.all = value; break;
+        case 2U: vars->ctrlReg03.all = value; break;
+        case 3U: vars->ctrlReg04.all = value; break;
+        case 4U: vars->ctrlReg05.all = value; break;
+        case 5U: vars->ctrlReg06.all = value; break;
+        default: vars->ctrlReg10.all = value; break;
+    }
+}
+
+/**
+ * @brief 发布一份新的寄存器快照。
+ *
+ * 总是写入当前未被发布的缓冲区，写完后再推进序号，因此读者正在读取的缓冲区
+ * 至少在一个完整的发布周期内保持不变。仅由初始化流程与维护任务调用。
+ */
+static void APP_DRV8316_publishSnapshot(APP_DRV8316_Instance *inst)
+{
+    uint32_t next = inst->snapshotSeq + 1U;
+    volatile APP_DRV8316_SnapshotBuffer *buffer = &inst->snapshot[next & 1U];
+
+    buffer->seqBegin = next;
+    buffer->vars     = inst->drvVars;
+    buffer->seqEnd   = next;
+
+    inst->snapshotSeq = next;
+}
+
+/**
+ * @brief 无锁读取实例最近发布的快照。
+ */
+static bool APP_DRV8316_readSnapshot(const APP_DRV8316_Instance *inst, DRV8316_VARS_t *outVars)
+{
+    uint16_t attempt;
+
+    for(attempt = 0U; attempt < APP_DRV8316_SNAPSHOT_RETRY; attempt++)
+    {
+        uint32_t seq = inst->snapshotSeq;
+        volatile const APP_DRV8316_SnapshotBuffer *buffer = &inst->snapshot[seq & 1U];
+
+        if(buffer->seqEnd == seq)
+        {
+            *outVars = buffer->vars;
+
+            if(buffer->seqBegin == seq)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 计算距离最早一次到期扫描的节拍数，作为维护任务的最长等待时间。
+ *
+ * 周期值与上次扫描时刻均为单个 32 位字，读取本身即为原子操作，无需互斥量。
+ * 已有器件到期时返回 0；没有可用器件时退回到模块默认刷新周期。
+ */
+static TickType_t APP_DRV8316_getScanDelayTicks(TickType_t now)
+{
+    TickType_t delay = portMAX_DELAY;
+    uint16_t device;
 
-    if(ticks == 0U)
+    for(device = 0U; device < APP_DRV8316_MAX_DEVICES; device++)
     {
-        ticks = pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS);
+        const APP_DRV8316_Instance *inst = &s_devices[device];
+        TickType_t elapsed = (TickType_t)(now - inst->lastScanTick);
+        TickType_t remaining;
+
+        if(!inst->initialized || (inst->refreshPeriod == 0U))
+        {
+            continue;
+        }
+
+        remaining = (elapsed >= inst->refreshPeriod) ? 0U : (inst->refreshPeriod - elapsed);
+
+        if(remaining < delay)
+        {
+            delay = remaining;
+        }
+    }
+
+    if(delay == portMAX_DELAY)
+    {
+        delay = pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS);
     }
 
-    return ticks;
+    return delay;
 }
 
 /**
- * @brief 初始化应用层模块并与底层驱动建立关联。
+ * @brief 初始化指定器件并与底层驱动建立关联。
  *
  * 步骤包括：
- *  1. 创建互斥量并重置内部状态；
- *  2. 调用底层库生成 DRV8316 句柄；
+ *  1. 创建模块共用的互斥量与寄存器访问队列；
+ *  2. 重置器件实例并调用底层库生成 DRV8316 句柄；
  *  3. 合并用户配置与默认参数；
- *  4. 将 SPI 资源附着至驱动并完成 SPI 配置；
- *  5. 根据需要自动拉使能脚。
+ *  4. 将 SPI 资源与该器件的片选附着至驱动并完成 SPI 配置；
+ *  5. 根据需要自动拉使能脚，并发布首份快照。
  */
-void APP_DRV8316_init(const APP_DRV8316_Config *config)
+void APP_DRV8316_init(uint16_t device, const APP_DRV8316_Config *config)
 {
+    APP_DRV8316_Instance *inst;
+
+    if(device >= APP_DRV8316_MAX_DEVICES)
+    {
+        return;
+    }
+
+    /* 除 0 号器件外不存在默认片选，必须显式提供配置。 */
+    if((config == NULL) && (device != APP_DRV8316_DEVICE_0))
+    {
+        return;
+    }
+
     if(s_mutexHandle == NULL)
     {
         s_mutexHandle = xSemaphoreCreateMutexStatic(&s_mutexBuffer);
     }
 
+    if(s_regQueueHandle == NULL)
+    {
+        s_regQueueHandle = xQueueCreateStatic(APP_DRV8316_REG_QUEUE_DEPTH,
+                                              sizeof(APP_DRV8316_RegQueueItem),
+                                              s_regQueueStorage,
+                                              &s_regQueueBuffer);
+    }
+
     APP_DRV8316_lock();
 
-    s_initialized = false;
+    inst = &s_devices[device];
+    inst->initialized = false;
+    inst->scanned     = false;
 
-    memset(&s_drvObj, 0, sizeof(s_drvObj));
-    memset(&s_drvVars, 0, sizeof(s_drvVars));
+    memset(&inst->drvObj, 0, sizeof(inst->drvObj));
+    memset(&inst->drvVars, 0, sizeof(inst->drvVars));
+    memset(&inst->requestVars, 0, sizeof(inst->requestVars));
+    memset(&inst->deviceVars, 0, sizeof(inst->deviceVars));
+    inst->dirtyMask       = 0U;
+    inst->manualReadToken = APP_DRV8316_REG_TOKEN_NONE;
+    APP_DRV8316_resetFaultLog(device);
 
-    s_drvHandle = DRV8316_init(&s_drvObj);
+    inst->drvHandle = DRV8316_init(&inst->drvObj);
 
     APP_DRV8316_Config defaultConfig =
     {
         .csGpio            = DEVICE_GPIO_PIN_SPISTEA,
         .enableGpio        = DRV_SPI_INVALID_GPIO,
         .refreshPeriodTicks = pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS),
-        .autoEnable        = false
+        .autoEnable        = false,
+        .linkSelfTest      = true
     };
 
     if(config != NULL)
     {
-        s_runtimeConfig = *config;
+        inst->config = *config;
 
-        if(s_runtimeConfig.refreshPeriodTicks == 0U)
+        if(inst->config.refreshPeriodTicks == 0U)
         {
-            s_runtimeConfig.refreshPeriodTicks = pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS);
+            inst->config.refreshPeriodTicks = pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS);
         }
     }
     else
     {
-        s_runtimeConfig = defaultConfig;
+        inst->config = defaultConfig;
     }
 
-    s_refreshPeriod = s_runtimeConfig.refreshPeriodTicks;
+    inst->refreshPeriod = inst->config.refreshPeriodTicks;
+
+    DRV_SPI_attachToDRV8316(inst->drvHandle,
+                            inst->config.csGpio,
+                            inst->config.enableGpio);
 
-    DRV_SPI_attachToDRV8316(s_drvHandle,
-                            s_runtimeConfig.csGpio,
-                            s_runtimeConfig.enableGpio);
+    DRV8316_setupSPI(inst->drvHandle, &inst->drvVars);
 
-    DRV8316_setupSPI(s_drvHandle, &s_drvVars);
+    if(inst->config.autoEnable &&
+       (inst->config.enableGpio != DRV_SPI_INVALID_GPIO))
+    {
+        DRV8316_enable(inst->drvHandle);
+    }
 
-    if(s_runtimeConfig.autoEnable &&
-       (s_runtimeConfig.enableGpio != DRV_SPI_INVALID_GPIO))
+    /* 寄存器已读回默认值，此时 PWM 尚未输出，可安全地探测链路速率。 */
+    if(inst->config.linkSelfTest)
     {
-        DRV8316_enable(s_drvHandle);
+        (void)DRV_SPI_runDRV8316SelfTest(inst->drvHandle, NULL);
     }
 
-    s_initialized = true;
+    inst->requestVars = inst->drvVars;
+    inst->deviceVars  = inst->drvVars;
+    APP_DRV8316_publishSnapshot(inst);
+
+    inst->initialized = true;
 
     APP_DRV8316_unlock();
 }
 
 /**
- * @brief 查询模块是否已经完成初始化。
+ * @brief 查询指定器件是否已经完成初始化。
  */
-bool APP_DRV8316_isReady(void)
+bool APP_DRV8316_isReady(uint16_t device)
 {
-    return s_initialized;
+    return (APP_DRV8316_getInstance(device) != NULL);
 }
 
 /**
- * @brief 获取最新的寄存器镜像。
+ * @brief 获取指定器件最新的寄存器镜像。
  *
- * 通过互斥量拷贝底层缓存的寄存器结构，供上层进行状态诊断或 UI 显示。
+ * 无锁读取已发布的快照缓冲区。发布者每个刷新周期只改写另一块缓冲区，读者只有在
+ * 被抢占超过一个完整周期时才需要重试，因此在中断上下文中首次读取即可成功。
  */
-bool APP_DRV8316_getStatusSnapshot(DRV8316_VARS_t *outVars)
+bool APP_DRV8316_getStatusSnapshot(uint16_t device, DRV8316_VARS_t *outVars)
 {
-    if((outVars == NULL) || !s_initialized)
+    const APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+
+    if((outVars == NULL) || (inst == NULL))
     {
         return false;
     }
 
-    APP_DRV8316_lock();
-    *outVars = s_drvVars;
-    APP_DRV8316_unlock();
+    return APP_DRV8316_readSnapshot(inst, outVars);
+}
 
-    return true;
+/**
+ * @brief 获取指定器件最近一次发布快照的序号。
+ */
+uint32_t APP_DRV8316_getSnapshotSequence(uint16_t device)
+{
+    const APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+
+    return (inst != NULL) ? inst->snapshotSeq : 0U;
+}
+
+/**
+ * @brief 查询维护任务是否已完成指定器件的第一次扫描。
+ */
+bool APP_DRV8316_hasScanned(uint16_t device)
+{
+    const APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+
+    return (inst != NULL) && inst->scanned;
 }
 
 /**
  * @brief 申请一次控制寄存器更新。
  *
- * 将待写入的控制寄存器值复制到本地缓存，并设置写入标志，由轮询任务在下一周期
- * 内实际完成 SPI 写操作。
+ * 逐个比较待写入值与器件的预期值，仅将不一致的寄存器标记为脏，由维护任务在下一
+ * 周期写入。与预期值相同的寄存器会撤销先前未完成的写请求。预期值在写入交出时与
+ * 每次扫描读回后更新，不依赖只在扫描时发布的快照：一个扫描周期内 A→B→A 的两次
+ * 请求中，第二次与已写入的 B 比较，仍会写回 A。
  */
-bool APP_DRV8316_scheduleControlUpdate(const DRV8316_VARS_t *ctrlRegs)
+bool APP_DRV8316_scheduleControlUpdate(uint16_t device, const DRV8316_VARS_t *ctrlRegs)
 {
-    if((ctrlRegs == NULL) || !s_initialized)
+    APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+    uint16_t index;
+    uint16_t dirty;
+
+    if((ctrlRegs == NULL) || (inst == NULL))
     {
         return false;
     }
 
     APP_DRV8316_lock();
 
-    s_drvVars.ctrlReg01 = ctrlRegs->ctrlReg01;
-    s_drvVars.ctrlReg02 = ctrlRegs->ctrlReg02;
-    s_drvVars.ctrlReg03 = ctrlRegs->ctrlReg03;
-    s_drvVars.ctrlReg04 = ctrlRegs->ctrlReg04;
-    s_drvVars.ctrlReg05 = ctrlRegs->ctrlReg05;
-    s_drvVars.ctrlReg06 = ctrlRegs->ctrlReg06;
-    s_drvVars.ctrlReg10 = ctrlRegs->ctrlReg10;
-    s_drvVars.writeCmd  = true;
+    for(index = 0U; index < APP_DRV8316_CTRL_REG_COUNT; index++)
+    {
+        uint16_t value = APP_DRV8316_getCtrlReg(ctrlRegs, index);
+
+        APP_DRV8316_setCtrlReg(&inst->requestVars, index, value);
+
+        if(value != APP_DRV8316_getCtrlReg(&inst->deviceVars, index))
+        {
+            inst->dirtyMask |= (uint16_t)(1U << index);
+        }
+        else
+        {
+            inst->dirtyMask &= (uint16_t)~(1U << index);
+        }
+    }
+
+    dirty = inst->dirtyMask;
 
     APP_DRV8316_unlock();
 
+    if(dirty != 0U)
+    {
+        (void)APP_EVENT_post(APP_EVENT_SRC_DRV8316, APP_DRV8316_EVENT_CTRL_UPDATE, device);
+    }
+
     return true;
 }
 
 /**
- * @brief 申请手动读取指定地址寄存器。
+ * @brief 分配下一个完成令牌，跳过保留值 0。
  *
- * 若当前已有手动读取在执行，则返回失败；否则记录目标地址并设置读取标志，由任务
- * 在下一轮刷新的时候触发底层读取流程。
+ * 调用者需持有互斥量。
  */
-bool APP_DRV8316_requestManualRead(uint16_t address)
+static APP_DRV8316_RegToken APP_DRV8316_allocRegToken(void)
 {
-    if(!s_initialized || (address > 0x1FU))
+    APP_DRV8316_RegToken token = s_nextRegToken;
+
+    s_nextRegToken++;
+
+    if(s_nextRegToken == APP_DRV8316_REG_TOKEN_NONE)
+    {
+        s_nextRegToken = 1U;
+    }
+
+    return token;
+}
+
+/**
+ * @brief 批量提交寄存器访问请求。
+ *
+ * 整批请求要么全部入队，要么全部拒绝，保证同一批次在一次 SPI 突发中按顺序执行。
+ * 入队前先在结果表中为每个令牌登记待处理状态。
+ */
+bool APP_DRV8316_submitRegOps(uint16_t device,
+                              const APP_DRV8316_RegOp *ops,
+                              uint16_t count,
+                              APP_DRV8316_RegToken *tokens)
+{
+    uint16_t index;
+
+    if((ops == NULL) || (count == 0U) ||
+       (count > APP_DRV8316_REG_QUEUE_DEPTH) ||
+       (APP_DRV8316_getInstance(device) == NULL))
     {
         return false;
     }
 
+    for(index = 0U; index < count; index++)
+    {
+        if((ops[index].address > 0x1FU) ||
+           ((ops[index].type != APP_DRV8316_REG_OP_READ) &&
+            (ops[index].type != APP_DRV8316_REG_OP_WRITE)))
+        {
+            return false;
+        }
+    }
+
     APP_DRV8316_lock();
 
-    if(s_drvVars.manReadCmd)
+    if(uxQueueSpacesAvailable(s_regQueueHandle) < count)
     {
         APP_DRV8316_unlock();
         return false;
     }
 
-    s_drvVars.manReadAddr = address & 0x1FU;
-    s_drvVars.manReadCmd  = true;
+    for(index = 0U; index < count; index++)
+    {
+        APP_DRV8316_RegQueueItem item;
+        APP_DRV8316_RegResult *result;
+
+        item.op     = ops[index];
+        item.token  = APP_DRV8316_allocRegToken();
+        item.device = device;
+
+        result = &s_regResults[item.token & APP_DRV8316_REG_RESULT_MASK];
+        result->token  = item.token;
+        result->status = APP_DRV8316_REG_STATUS_PENDING;
+        result->data   = 0U;
+
+        /* 空间已预先检查，且入队操作均在互斥量内完成，此处不会失败。 */
+        (void)xQueueSendToBack(s_regQueueHandle, &item, 0U);
+
+        if(tokens != NULL)
+        {
+            tokens[index] = item.token;
+        }
+    }
+
+    APP_DRV8316_unlock();
+
+    /* 事件队列满时维护任务仍会被通知，请求本身已在寄存器访问队列中，不会丢失。 */
+    (void)APP_EVENT_post(APP_EVENT_SRC_DRV8316, APP_DRV8316_EVENT_REG_OPS, device);
+
+    return true;
+}
+
+/**
+ * @brief 查询寄存器访问请求的完成状态。
+ */
+APP_DRV8316_RegStatus APP_DRV8316_getRegOpResult(APP_DRV8316_RegToken token, uint16_t *data)
+{
+    const APP_DRV8316_RegResult *result;
+    APP_DRV8316_RegStatus status;
+    uint16_t value;
+
+    if((token == APP_DRV8316_REG_TOKEN_NONE) || (s_mutexHandle == NULL))
+    {
+        return APP_DRV8316_REG_STATUS_INVALID;
+    }
+
+    APP_DRV8316_lock();
+
+    result = &s_regResults[token & APP_DRV8316_REG_RESULT_MASK];
+    status = (result->token == token) ? result->status : APP_DRV8316_REG_STATUS_INVALID;
+    value  = result->data;
 
     APP_DRV8316_unlock();
 
+    if((status == APP_DRV8316_REG_STATUS_DONE) && (data != NULL))
+    {
+        *data = value;
+    }
+
+    return status;
+}
+
+/**
+ * @brief 申请手动读取指定地址寄存器。
+ *
+ * 兼容旧接口：内部以单条读请求提交至寄存器访问队列。若该器件上一次手动读取尚未
+ * 完成，则返回失败。
+ */
+bool APP_DRV8316_requestManualRead(uint16_t device, uint16_t address)
+{
+    APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+    APP_DRV8316_RegOp op;
+    APP_DRV8316_RegToken token;
+
+    if((inst == NULL) || (address > 0x1FU))
+    {
+        return false;
+    }
+
+    if((inst->manualReadToken != APP_DRV8316_REG_TOKEN_NONE) &&
+       (APP_DRV8316_getRegOpResult(inst->manualReadToken, NULL) == APP_DRV8316_REG_STATUS_PENDING))
+    {
+        return false;
+    }
+
+    op.type    = APP_DRV8316_REG_OP_READ;
+    op.address = address;
+    op.data    = 0U;
+
+    if(!APP_DRV8316_submitRegOps(device, &op, 1U, &token))
+    {
+        return false;
+    }
+
+    inst->manualReadToken = token;
+
     return true;
 }
 
 /**
- * @brief 读取最近一次手动寄存器查询的结果。
+ * @brief 读取指定器件最近一次手动寄存器查询的结果。
  *
  * 当底层读取尚未完成时，函数返回 false 并提示上层稍后重试。
  */
-bool APP_DRV8316_getManualReadResult(uint16_t *data)
+bool APP_DRV8316_getManualReadResult(uint16_t device, uint16_t *data)
 {
-    if((data == NULL) || !s_initialized)
+    const APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+
+    if((data == NULL) || (inst == NULL))
     {
         return false;
     }
 
+    return (APP_DRV8316_getRegOpResult(inst->manualReadToken, data) == APP_DRV8316_REG_STATUS_DONE);
+}
+
+/**
+ * @brief 返回指定器件的底层驱动句柄，供特殊场景直接调用底层接口。
+ */
+DRV8316_Handle APP_DRV8316_getHandle(uint16_t device)
+{
+    const APP_DRV8316_Instance *inst = APP_DRV8316_getInstance(device);
+
+    return (inst != NULL) ? inst->drvHandle : NULL;
+}
+
+/**
+ * @brief 取出器件的脏控制寄存器并在锁外写入。
+ *
+ * 互斥量只用于拷贝脏标记与寄存器值，并在交出时把这些值记为器件预期值；写入后
+ * 同步更新任务私有镜像，使本周期的快照在读回前即可反映新值。
+ */
+static void APP_DRV8316_writeDirtyRegs(APP_DRV8316_Instance *inst)
+{
+    uint16_t values[APP_DRV8316_CTRL_REG_COUNT];
+    uint16_t dirty;
+    uint16_t index;
+
     APP_DRV8316_lock();
 
-    bool busy = s_drvVars.manReadCmd;
-    uint16_t value = s_drvVars.manReadData;
+    dirty = inst->dirtyMask;
+    inst->dirtyMask = 0U;
+
+    for(index = 0U; index < APP_DRV8316_CTRL_REG_COUNT; index++)
+    {
+        values[index] = APP_DRV8316_getCtrlReg(&inst->requestVars, index);
+
+        if((dirty & (1U << index)) != 0U)
+        {
+            APP_DRV8316_setCtrlReg(&inst->deviceVars, index, values[index]);
+        }
+    }
 
     APP_DRV8316_unlock();
 
-    if(busy)
+    for(index = 0U; (dirty != 0U) && (index < APP_DRV8316_CTRL_REG_COUNT); index++)
     {
-        return false;
+        if((dirty & (1U << index)) != 0U)
+        {
+            DRV8316_writeSPI(inst->drvHandle, s_ctrlRegAddr[index], values[index]);
+            APP_DRV8316_setCtrlReg(&inst->drvVars, index, values[index]);
+            dirty &= (uint16_t)~(1U << index);
+        }
     }
+}
 
-    *data = value;
-    return true;
+/**
+ * @brief 在一次 SPI 突发中执行队列中的全部寄存器访问请求。
+ *
+ * 先在锁外连续完成所有 SPI 传输，再一次性获取互斥量回填结果，避免逐条加锁。
+ * 单个周期最多处理 APP_DRV8316_REG_QUEUE_DEPTH 条请求。
+ */
+static void APP_DRV8316_processRegQueue(void)
+{
+    static APP_DRV8316_RegQueueItem items[APP_DRV8316_REG_QUEUE_DEPTH];
+    static uint16_t values[APP_DRV8316_REG_QUEUE_DEPTH];
+    uint16_t count = 0U;
+    uint16_t index;
+
+    while((count < APP_DRV8316_REG_QUEUE_DEPTH) &&
+          (xQueueReceive(s_regQueueHandle, &items[count], 0U) == pdPASS))
+    {
+        count++;
+    }
+
+    if(count == 0U)
+    {
+        return;
+    }
+
+    for(index = 0U; index < count; index++)
+    {
+        const APP_DRV8316_RegOp *op = &items[index].op;
+        DRV8316_Handle handle = s_devices[items[index].device].drvHandle;
+        DRV8316_Address_e regAddr = (DRV8316_Address_e)((op->address & 0x1FU) << 9);
+
+        if(op->type == APP_DRV8316_REG_OP_WRITE)
+        {
+            values[index] = op->data & DRV8316_DATA_MASK;
+            DRV8316_writeSPI(handle, regAddr, values[index]);
+        }
+        else
+        {
+            values[index] = DRV8316_readSPI(handle, regAddr);
+        }
+    }
+
+    APP_DRV8316_lock();
+
+    for(index = 0U; index < count; index++)
+    {
+        APP_DRV8316_RegResult *result =
+            &s_regResults[items[index].token & APP_DRV8316_REG_RESULT_MASK];
+
+        /* 槽位可能已被更新的请求复用，此时丢弃过期结果。 */
+        if(result->token == items[index].token)
+        {
+            result->data   = values[index];
+            result->status = APP_DRV8316_REG_STATUS_DONE;
+        }
+    }
+
+    APP_DRV8316_unlock();
 }
 
 /**
- * @brief 返回底层驱动句柄，供特殊场景直接调用底层接口。
+ * @brief 扫描单个器件的状态与控制寄存器，以读回值更新器件预期值，并发布快照。
  */
-DRV8316_Handle APP_DRV8316_getHandle(void)
+static void APP_DRV8316_scanDevice(uint16_t device, APP_DRV8316_Instance *inst, TickType_t now)
 {
-    return s_drvHandle;
+    uint16_t index;
+
+    inst->drvVars.readCmd = true;
+    DRV8316_readData(inst->drvHandle, &inst->drvVars);
+    (void)APP_DRV8316_recordFaultEvent(device, &inst->drvVars, now);
+
+    /* 器件复位等原因造成的变化由此反映到脏标记的比较基准中。 */
+    APP_DRV8316_lock();
+
+    for(index = 0U; index < APP_DRV8316_CTRL_REG_COUNT; index++)
+    {
+        APP_DRV8316_setCtrlReg(&inst->deviceVars, index, APP_DRV8316_getCtrlReg(&inst->drvVars, index));
+    }
+
+    APP_DRV8316_unlock();
+
+    APP_DRV8316_publishSnapshot(inst);
+
+    inst->scanned      = true;
+    inst->lastScanTick = now;
 }
 
 /**
  * @brief DRV8316 周期性维护任务。
  *
  * 任务逻辑：
- *  - 等待模块初始化完成；
- *  - 周期性检查是否有待写入/读取命令；
- *  - 依据驱动库提供的 API 执行写入和读取操作；
- *  - 按照当前配置的刷新周期休眠，确保寄存器数据保持最新。
+ *  - 等待至少一个器件完成初始化；
+ *  - 在锁外依次写入各器件的脏控制寄存器；
+ *  - 以一次 SPI 突发执行寄存器访问队列中的全部请求；
+ *  - 对扫描周期已到的器件依次切换片选完成寄存器读取；
+ *  - 状态寄存器发生变化时追加一条故障事件记录；
+ *  - 发布新的寄存器快照；
+ *  - 阻塞等待 APP_EVENT_SRC_DRV8316 事件，最长等到下一个器件扫描到期，
+ *    新的请求提交后立即唤醒处理。
  */
 void APP_DRV8316_TASK(void *pvParameters)
 {
     (void)pvParameters;
 
-    TickType_t periodTicks = APP_DRV8316_getRefreshPeriodTicks();
+    uint16_t device;
+    bool anyReady = false;
+
+    while(!anyReady)
+    {
+        for(device = 0U; device < APP_DRV8316_MAX_DEVICES; device++)
+        {
+            anyReady = anyReady || APP_DRV8316_isReady(device);
+        }
+
+        if(!anyReady)
+        {
+            vTaskDelay(pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS));
+        }
+    }
+
+    TickType_t startTick = xTaskGetTickCount();
 
-    while(!APP_DRV8316_isReady())
+    /* 首个周期立即扫描全部器件。 */
+    for(device = 0U; device < APP_DRV8316_MAX_DEVICES; device++)
     {
-        vTaskDelay(pdMS_TO_TICKS(APP_DRV8316_DEFAULT_REFRESH_MS));
+        s_devices[device].lastScanTick = startTick - s_devices[device].refreshPeriod;
     }
 
-    periodTicks = APP_DRV8316_getRefreshPeriodTicks();
-    TickType_t lastWakeTick = xTaskGetTickCount();
+    (void)APP_EVENT_bind(APP_EVENT_SRC_DRV8316);
 
     for(;;)
     {
-        bool needWrite;
+        APP_EVENT_Event event;
+        TickType_t now;
+        uint32_t statsStart = APP_STATS_taskBegin();
 
-        /*
-         * 预读取互斥量中缓存的命令标志。s_drvVars 结构由底层驱动维护，
-         * writeCmd/manWriteCmd 标记存在写指令，readCmd 置位后将触发常规刷新。
-         */
-        APP_DRV8316_lock();
-        needWrite = (s_drvVars.writeCmd || s_drvVars.manWriteCmd);
-        s_drvVars.readCmd = true;
-        APP_DRV8316_unlock();
+        /* 事件只用于唤醒，待处理的工作由脏标记与寄存器访问队列描述。 */
+        while(APP_EVENT_receive(APP_EVENT_SRC_DRV8316, &event))
+        {
+        }
 
-        if(needWrite)
+        for(device = 0U; device < APP_DRV8316_MAX_DEVICES; device++)
         {
-            APP_DRV8316_lock();
-            DRV8316_writeData(s_drvHandle, &s_drvVars);
-            APP_DRV8316_unlock();
+            if(s_devices[device].initialized)
+            {
+                APP_DRV8316_writeDirtyRegs(&s_devices[device]);
+            }
         }
 
-        /* 执行常规寄存器读取，更新状态镜像和手动读回数据。 */
-        APP_DRV8316_lock();
-        DRV8316_readData(s_drvHandle, &s_drvVars);
-        APP_DRV8316_unlock();
+        /* 批量执行排队的寄存器读写请求。 */
+        APP_DRV8316_processRegQueue();
+
+        /* 对到期的器件背靠背完成常规寄存器读取。 */
+        now = xTaskGetTickCount();
+
+        for(device = 0U; device < APP_DRV8316_MAX_DEVICES; device++)
+        {
+            APP_DRV8316_Instance *inst = &s_devices[device];
+
+            if(inst->initialized &&
+               ((TickType_t)(now - inst->lastScanTick) >= inst->refreshPeriod))
+            {
+                APP_DRV8316_scanDevice(device, inst, now);
+            }
+        }
+
+        APP_STATS_taskEnd(statsStart);
 
-        periodTicks = APP_DRV8316_getRefreshPeriodTicks();
-        vTaskDelayUntil(&lastWakeTick, periodTicks);
+        (void)APP_EVENT_wait(APP_DRV8316_getScanDelayTicks(xTaskGetTickCount()));
     }
 }
@@ -0,0 +1,256 @@
+/**
+ * @file app_drv8316_fault.c
+ * @brief DRV8316 故障事件环形缓冲区实现。
+ *
+ * 缓冲区采用单生产者/多消费者的无锁设计：
+ *  - 生产者（APP_DRV8316_TASK）写槽位前先将槽位序号置为无效值，写完数据后再写入
+ *    真实序号，最后推进全局写序号；
+ *  - 消费者读取槽位前后各检查一次序号，两次一致且等于期望序号才视为有效数据，
+ *    否则说明该槽位已被覆盖，计入丢失并跳过。
+ * C28x 上 32 位对齐访问为单条指令完成，序号读写天然原子。
+ * 每个器件拥有独立的缓冲区与序号空间。
+ */
+
+#include "app_drv8316_fault.h"
+
+/** 槽位正在被生产者改写时使用的序号标记。 */
+#define APP_DRV8316_FAULT_SEQ_INVALID   (0xFFFFFFFFUL)
+/** 由序号求槽位下标的掩码。 */
+#define APP_DRV8316_FAULT_LOG_MASK      (APP_DRV8316_FAULT_LOG_DEPTH - 1U)
+
+/**
+ * @brief 单个器件的故障事件缓冲区。
+ */
+typedef struct
+{
+    /** 环形缓冲区存储，volatile 保证编译器不会重排序号与数据的访问顺序。 */
+    volatile APP_DRV8316_FaultEvent log[APP_DRV8316_FAULT_LOG_DEPTH];
+    /** 下一条待写入事件的序号，即累计事件总数。 */
+    volatile uint32_t head;
+    /** 缓冲区满后被覆盖的旧事件数。 */
+    volatile uint32_t overwritten;
+    /** 上一次记录时的状态字，仅由生产者访问。 */
+    uint16_t lastStat00;
+    uint16_t lastStat01;
+    uint16_t lastStat02;
+} APP_DRV8316_FaultLog;
+
+/** 各器件的故障事件缓冲区。 */
+static APP_DRV8316_FaultLog s_faultLogs[APP_DRV8316_MAX_DEVICES];
+
+/**
+ * @brief 计算当前仍保留在缓冲区中的最旧事件序号。
+ */
+static uint32_t APP_DRV8316_getOldestSequence(uint32_t head)
+{
+    return (head > APP_DRV8316_FAULT_LOG_DEPTH) ? (head - APP_DRV8316_FAULT_LOG_DEPTH) : 0U;
+}
+
+void APP_DRV8316_resetFaultLog(uint16_t device)
+{
+    APP_DRV8316_FaultLog *faultLog;
+    uint16_t index;
+
+    if(device >= APP_DRV8316_MAX_DEVICES)
+    {
+        return;
+    }
+
+    faultLog = &s_faultLogs[device];
+
+    for(index = 0U; index < APP_DRV8316_FAULT_LOG_DEPTH; index++)
+    {
+        faultLog->log[index].sequence = APP_DRV8316_FAULT_SEQ_INVALID;
+        faultLog->log[index].device   = device;
+    }
+
+    faultLog->head        = 0U;
+    faultLog->overwritten = 0U;
+
+    faultLog->lastStat00 = 0U;
+    faultLog->lastStat01 = 0U;
+    faultLog->lastStat02 = 0U;
+}
+
+/**
+ * @brief 生产者追加事件。
+ *
+ * 只有状态字发生变化时才写入，因而持续存在的故障只占用一条记录，故障的出现与
+ * 清除各自留下一条带时间戳的事件。
+ */
+bool APP_DRV8316_recordFaultEvent(uint16_t device,
+                                  const DRV8316_VARS_t *vars,
+                                  TickType_t timestamp)
+{
+    APP_DRV8316_FaultLog *faultLog;
+    volatile APP_DRV8316_FaultEvent *slot;
+    uint32_t sequence;
+
+    if((vars == NULL) || (device >= APP_DRV8316_MAX_DEVICES))
+    {
+        return false;
+    }
+
+    faultLog = &s_faultLogs[device];
+
+    if((vars->statReg00.all == faultLog->lastStat00) &&
+       (vars->statReg01.all == faultLog->lastStat01) &&
+       (vars->statReg02.all == faultLog->lastStat02))
+    {
+        return false;
+    }
+
+    faultLog->lastStat00 = vars->statReg00.all;
+    faultLog->lastStat01 = vars->statReg01.all;
+    faultLog->lastStat02 = vars->statReg02.all;
+
+    sequence = faultLog->head;
+    slot = &faultLog->log[sequence & APP_DRV8316_FAULT_LOG_MASK];
+
+    if(sequence >= APP_DRV8316_FAULT_LOG_DEPTH)
+    {
+        faultLog->overwritten = faultLog->overwritten + 1U;
+    }
+
+    /* 先作废槽位，使并发读者能够识别出正在改写的数据。 */
+    slot->sequence       = APP_DRV8316_FAULT_SEQ_INVALID;
+    slot->timestampTicks = timestamp;
+    slot->device         = device;
+    slot->statReg00      = vars->statReg00.all;
+    slot->statReg01      = vars->statReg01.all;
+    slot->statReg02      = vars->statReg02.all;
+    slot->ctrlReg01      = vars->ctrlReg01.all;
+    slot->ctrlReg02      = vars->ctrlReg02.all;
+    slot->ctrlReg03      = vars->ctrlReg03.all;
+    slot->ctrlReg04      = vars->ctrlReg04.all;
+    slot->ctrlReg05      = vars->ctrlReg05.all;
+    slot->ctrlReg06      = vars->ctrlReg06.all;
+    slot->ctrlReg10      = vars->ctrlReg10.all;
+    slot->sequence       = sequence;
+
+    faultLog->head = sequence + 1U;
+
+    return true;
+}
+
+void APP_DRV8316_initFaultReader(APP_DRV8316_FaultReader *reader,
+                                 uint16_t device,
+                                 bool fromOldest)
+{
+    uint32_t head;
+
+    if((reader == NULL) || (device >= APP_DRV8316_MAX_DEVICES))
+    {
+        return;
+    }
+
+    head = s_faultLogs[device].head;
+
+    reader->device       = device;
+    reader->nextSequence = fromOldest ? APP_DRV8316_getOldestSequence(head) : head;
+    reader->lostCount    = 0U;
+}
+
+/**
+ * @brief 消费者读取事件。
+ *
+ * 每次循环要么成功返回一条事件，要么将游标前移至少一格，因此在生产者被抢占于
+ * 写入中途时也不会自旋等待，循环次数不超过缓冲区深度加一。
+ */
+bool APP_DRV8316_readFaultEvent(APP_DRV8316_FaultReader *reader,
+                                APP_DRV8316_FaultEvent *event)
+{
+    const APP_DRV8316_FaultLog *faultLog;
+
+    if((reader == NULL) || (event == NULL) ||
+       (reader->device >= APP_DRV8316_MAX_DEVICES))
+    {
+        return false;
+    }
+
+    faultLog = &s_faultLogs[reader->device];
+
+    for(;;)
+    {
+        volatile const APP_DRV8316_FaultEvent *slot;
+        uint32_t head = faultLog->head;
+        uint32_t oldest = APP_DRV8316_getOldestSequence(head);
+        uint32_t expected;
+
+        if(reader->nextSequence == head)
+        {
+            return false;
+        }
+
+        /* 游标已落后于缓冲区保存范围，跳到最旧的有效事件。 */
+        if((head - reader->nextSequence) > APP_DRV8316_FAULT_LOG_DEPTH)
+        {
+            reader->lostCount   += oldest - reader->nextSequence;
+            reader->nextSequence = oldest;
+        }
+
+        expected = reader->nextSequence;
+        slot = &faultLog->log[expected & APP_DRV8316_FAULT_LOG_MASK];
+
+        if(slot->sequence == expected)
+        {
+            *event = *slot;
+
+            if(slot->sequence == expected)
+            {
+                reader->nextSequence = expected + 1U;
+                return true;
+            }
+        }
+
+        /* 读取期间槽位被改写，该事件已不可恢复。 */
+        reader->lostCount    += 1U;
+        reader->nextSequence  = expected + 1U;
+    }
+}
+
+uint16_t APP_DRV8316_readFaultHistory(uint16_t device,
+                                      APP_DRV8316_FaultEvent *events,
+                                      uint16_t maxCount)
+{
+    APP_DRV8316_FaultReader reader;
+    uint32_t head;
+    uint32_t oldest;
+    uint16_t count = 0U;
+
+    if((events == NULL) || (maxCount == 0U) || (device >= APP_DRV8316_MAX_DEVICES))
+    {
+        return 0U;
+    }
+
+    head   = s_faultLogs[device].head;
+    oldest = APP_DRV8316_getOldestSequence(head);
+
+    if((head - oldest) > maxCount)
+    {
+        oldest = head - maxCount;
+    }
+
+    reader.device       = device;
+    reader.nextSequence = oldest;
+    reader.lostCount    = 0U;
+
+    while((count < maxCount) && APP_DRV8316_readFaultEvent(&reader, &events[count]))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+void APP_DRV8316_getFaultLogStats(uint16_t device, APP_DRV8316_FaultLogStats *stats)
+{
+    if((stats == NULL) || (device >= APP_DRV8316_MAX_DEVICES))
+    {
+        return;
+    }
+
+    stats->totalEvents       = s_faultLogs[device].head;
+    stats->overwrittenEvents = s_faultLogs[device].overwritten;
+    stats->depth             = APP_DRV8316_FAULT_LOG_DEPTH;
+}
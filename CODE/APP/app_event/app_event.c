@@ -0,0 +1,190 @@
+/**
+ * @file app_event.c
+ * @brief 中断到任务的延迟处理框架实现。
+ */
+
+#include "app_event.h"
+#include "app_stats.h"
+
+#if ((APP_EVENT_QUEUE_DEPTH & APP_EVENT_QUEUE_MASK) != 0U)
+#error "APP_EVENT_QUEUE_DEPTH 必须为 2 的幂。"
+#endif
+
+/**
+ * @brief 单个事件源的环形队列。
+ *
+ * head 与 tail 自由递增，二者之差即队列中的事件数；槽位以 volatile 访问，保证
+ * 事件内容先于 head 写入。
+ */
+typedef struct
+{
+    volatile uint16_t        head;      /**< 生产者写入位置。 */
+    volatile uint16_t        tail;      /**< 消费者读取位置。 */
+    volatile uint16_t        dropped;   /**< 队列满时丢弃的事件数。 */
+    TaskHandle_t volatile    owner;     /**< 处理任务，未绑定时为 NULL。 */
+    volatile APP_EVENT_Event slots[APP_EVENT_QUEUE_DEPTH];
+} APP_EVENT_Queue;
+
+static APP_EVENT_Queue s_queues[APP_EVENT_SRC_COUNT];
+
+/**
+ * @brief 写入一个事件，调用者保证同一时刻只有一个生产者。
+ */
+static bool APP_EVENT_push(APP_EVENT_Queue *queue, uint16_t code, uint16_t arg)
+{
+    uint16_t head = queue->head;
+    volatile APP_EVENT_Event *slot;
+
+    if((uint16_t)(head - queue->tail) >= APP_EVENT_QUEUE_DEPTH)
+    {
+        queue->dropped++;
+        return false;
+    }
+
+    slot = &queue->slots[head & APP_EVENT_QUEUE_MASK];
+    slot->code      = code;
+    slot->arg       = arg;
+    slot->timestamp = APP_STATS_now();
+
+    queue->head = (uint16_t)(head + 1U);
+
+    return true;
+}
+
+void APP_EVENT_init(void)
+{
+    uint16_t source;
+
+    for(source = 0U; source < APP_EVENT_SRC_COUNT; source++)
+    {
+        s_queues[source].head    = 0U;
+        s_queues[source].tail    = 0U;
+        s_queues[source].dropped = 0U;
+        s_queues[source].owner   = NULL;
+    }
+}
+
+bool APP_EVENT_bind(uint16_t source)
+{
+    APP_EVENT_Queue *queue;
+    TaskHandle_t self;
+
+    if(source >= APP_EVENT_SRC_COUNT)
+    {
+        return false;
+    }
+
+    queue = &s_queues[source];
+    self  = xTaskGetCurrentTaskHandle();
+
+    queue->owner = self;
+
+    /* 绑定前到达的事件未能通知任何任务，补发一次通知。 */
+    if(queue->head != queue->tail)
+    {
+        (void)xTaskNotifyGive(self);
+    }
+
+    return true;
+}
+
+bool APP_EVENT_postFromISR(uint16_t source, uint16_t code, uint16_t arg, BaseType_t *woken)
+{
+    APP_EVENT_Queue *queue;
+    TaskHandle_t owner;
+    bool queued;
+
+    if(source >= APP_EVENT_SRC_COUNT)
+    {
+        return false;
+    }
+
+    queue  = &s_queues[source];
+    queued = APP_EVENT_push(queue, code, arg);
+    owner  = queue->owner;
+
+    if(owner != NULL)
+    {
+        vTaskNotifyGiveFromISR(owner, woken);
+    }
+
+    return queued;
+}
+
+bool APP_EVENT_post(uint16_t source, uint16_t code, uint16_t arg)
+{
+    APP_EVENT_Queue *queue;
+    TaskHandle_t owner;
+    bool queued;
+
+    if(source >= APP_EVENT_SRC_COUNT)
+    {
+        return false;
+    }
+
+    queue = &s_queues[source];
+
+    taskENTER_CRITICAL();
+    queued = APP_EVENT_push(queue, code, arg);
+    taskEXIT_CRITICAL();
+
+    owner = queue->owner;
+
+    if(owner != NULL)
+    {
+        (void)xTaskNotifyGive(owner);
+    }
+
+    return queued;
+}
+
+uint32_t APP_EVENT_wait(TickType_t timeout)
+{
+    return ulTaskNotifyTake(pdTRUE, timeout);
+}
+
+bool APP_EVENT_receive(uint16_t source, APP_EVENT_Event *event)
+{
+    APP_EVENT_Queue *queue;
+    volatile const APP_EVENT_Event *slot;
+    uint16_t tail;
+
+    if((source >= APP_EVENT_SRC_COUNT) || (event == NULL))
+    {
+        return false;
+    }
+
+    queue = &s_queues[source];
+    tail  = queue->tail;
+
+    if(tail == queue->head)
+    {
+        return false;
+    }
+
+    slot = &queue->slots[tail & APP_EVENT_QUEUE_MASK];
+    event->code      = slot->code;
+    event->arg       = slot->arg;
+    event->timestamp = slot->timestamp;
+
+    queue->tail = (uint16_t)(tail + 1U);
+
+    return true;
+}
+
+uint16_t APP_EVENT_takeDropped(uint16_t source)
+{
+    uint16_t dropped;
+
+    if(source >= APP_EVENT_SRC_COUNT)
+    {
+        return 0U;
+    }
+
+    taskENTER_CRITICAL();
+    dropped = s_queues[source].dropped;
+    s_queues[source].dropped = 0U;
+    taskEXIT_CRITICAL();
+
+    return dropped;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file app_flashprof.c
+ * @brief 闪存配置测量与固定的实现。
+ *
+ * 负载函数与系数表保持在默认的 .text/.const 段，即从闪存取指与取数；切换配置与
+ * 计时的函数放在 .TI.ramfunc，保证修改闪存控制寄存器时 CPU 不在闪存中取指。
+ */
+
+#include "app_flashprof.h"
+#include "app_stats.h"
+
+#include "driverlib/flash.h"
+
+/** 负载中每次执行的控制周期数。 */
+#define APP_FLASHPROF_WORK_STEPS    (32U)
+
+/** 系数表长度，须为 2 的幂。 */
+#define APP_FLASHPROF_TABLE_SIZE    (64U)
+#define APP_FLASHPROF_TABLE_MASK    (APP_FLASHPROF_TABLE_SIZE - 1U)
+
+/**
+ * @brief 负载的控制器状态，位于 RAM。
+ */
+typedef struct
+{
+    float32_t ui;       /**< 积分项。 */
+    float32_t x1;       /**< 滤波器上一次输入。 */
+    float32_t y1;       /**< 滤波器上一次输出。 */
+    uint16_t  index;    /**< 查表位置。 */
+} APP_FLASHPROF_Work;
+
+#if defined(_FLASH) && (APP_FLASHPROF_ENABLE != 0)
+#define APP_FLASHPROF_MEASURE       (1)
+#endif
+
+#ifdef APP_FLASHPROF_MEASURE
+/** 一个电周期的正弦参考，常量留在闪存中，以覆盖数据缓存的影响。 */
+static const float32_t s_reference[APP_FLASHPROF_TABLE_SIZE] =
+{
+     0.0000f,  0.0980f,  0.1951f,  0.2903f,  0.3827f,  0.4714f,  0.5556f,  0.6344f,
+     0.7071f,  0.7730f,  0.8315f,  0.8819f,  0.9239f,  0.9569f,  0.9808f,  0.9952f,
+     1.0000f,  0.9952f,  0.9808f,  0.9569f,  0.9239f,  0.8819f,  0.8315f,  0.7730f,
+     0.7071f,  0.6344f,  0.5556f,  0.4714f,  0.3827f,  0.2903f,  0.1951f,  0.0980f,
+     0.0000f, -0.0980f, -0.1951f, -0.2903f, -0.3827f, -0.4714f, -0.5556f, -0.6344f,
+    -0.7071f, -0.7730f, -0.8315f, -0.8819f, -0.9239f, -0.9569f, -0.9808f, -0.9952f,
+    -1.0000f, -0.9952f, -0.9808f, -0.9569f, -0.9239f, -0.8819f, -0.8315f, -0.7730f,
+    -0.7071f, -0.6344f, -0.5556f, -0.4714f, -0.3827f, -0.2903f, -0.1951f, -0.0980f
+};
+
+static APP_FLASHPROF_Work   s_work;
+#endif
+
+static APP_FLASHPROF_Result s_results[APP_FLASHPROF_CONFIG_COUNT];
+static uint16_t             s_resultCount = 0U;
+static uint16_t             s_best = 0U;
+
+#ifdef _FLASH
+#pragma CODE_SECTION(APP_FLASHPROF_configure, ".TI.ramfunc")
+
+/**
+ * @brief 切换闪存配置。
+ *
+ * driverlib 的内联函数可能被展开到调用者中，因此调用者本身必须在 RAM 中运行。
+ */
+static void APP_FLASHPROF_configure(uint16_t waitstates, bool prefetch, bool cache)
+{
+    /* 先关闭预取与缓存，再修改等待周期。 */
+    Flash_disablePrefetch(FLASH0CTRL_BASE);
+    Flash_disableCache(FLASH0CTRL_BASE);
+
+    Flash_setWaitstates(FLASH0CTRL_BASE, waitstates);
+
+    if(prefetch)
+    {
+        Flash_enablePrefetch(FLASH0CTRL_BASE);
+    }
+
+    if(cache)
+    {
+        Flash_enableCache(FLASH0CTRL_BASE);
+    }
+
+    /* 清空流水线，保证返回闪存取指前最后一次寄存器写入已生效。 */
+    __asm(" RPT #7 || NOP");
+}
+#endif
+
+#ifdef APP_FLASHPROF_MEASURE
+#pragma CODE_SECTION(APP_FLASHPROF_measure, ".TI.ramfunc")
+
+/**
+ * @brief 固定的控制环负载：查表得到参考，PI 调节后经一阶滤波输出。
+ *
+ * 禁止内联，保证代码始终从闪存执行。
+ */
+#pragma FUNC_CANNOT_INLINE(APP_FLASHPROF_workload)
+static float32_t APP_FLASHPROF_workload(APP_FLASHPROF_Work *work)
+{
+    float32_t out = 0.0f;
+    uint16_t step;
+
+    for(step = 0U; step < APP_FLASHPROF_WORK_STEPS; step++)
+    {
+        float32_t ref   = s_reference[work->index & APP_FLASHPROF_TABLE_MASK];
+        float32_t fback = s_reference[(work->index + 8U) & APP_FLASHPROF_TABLE_MASK] * 0.9f;
+        float32_t error = ref - fback;
+        float32_t pi;
+
+        work->ui += 0.01f * error;
+
+        if(work->ui > 1.0f)
+        {
+            work->ui = 1.0f;
+        }
+        else if(work->ui < -1.0f)
+        {
+            work->ui = -1.0f;
+        }
+
+        pi = (0.5f * error) + work->ui;
+
+        out = (0.2f * pi) + (0.2f * work->x1) + (0.6f * work->y1);
+        work->x1 = pi;
+        work->y1 = out;
+
+        work->index += 3U;
+    }
+
+    return out;
+}
+
+/**
+ * @brief 在指定配置下执行负载并记录结果。
+ */
+static void APP_FLASHPROF_measure(APP_FLASHPROF_Result *result)
+{
+    uint32_t total = 0U;
+    uint16_t run;
+
+    APP_FLASHPROF_configure(result->waitstates, result->prefetch != 0U, result->cache != 0U);
+
+    result->minCycles = UINT32_MAX;
+    result->maxCycles = 0U;
+
+    /* 预热：填充预取缓冲与数据缓存。 */
+    (void)APP_FLASHPROF_workload(&s_work);
+
+    for(run = 0U; run < APP_FLASHPROF_RUNS; run++)
+    {
+        uint32_t begin = APP_STATS_now();
+        uint32_t elapsed;
+
+        (void)APP_FLASHPROF_workload(&s_work);
+
+        elapsed = APP_STATS_now() - begin;
+        total  += elapsed;
+
+        if(elapsed < result->minCycles)
+        {
+            result->minCycles = elapsed;
+        }
+
+        if(elapsed > result->maxCycles)
+        {
+            result->maxCycles = elapsed;
+        }
+    }
+
+    result->avgCycles = total / APP_FLASHPROF_RUNS;
+}
+#endif
+
+bool APP_FLASHPROF_run(void)
+{
+#ifdef APP_FLASHPROF_MEASURE
+    uint16_t step;
+    uint16_t combo;
+    uint16_t index = 0U;
+    APP_FLASHPROF_Result *best;
+
+    s_work.ui    = 0.0f;
+    s_work.x1    = 0.0f;
+    s_work.y1    = 0.0f;
+    s_work.index = 0U;
+    s_best       = 0U;
+
+    for(step = 0U; step < APP_FLASHPROF_WAITSTATE_STEPS; step++)
+    {
+        for(combo = 0U; combo < 4U; combo++)
+        {
+            APP_FLASHPROF_Result *result = &s_results[index];
+
+            result->waitstates = DEVICE_FLASH_WAITSTATES + step;
+            result->prefetch   = combo & 1U;
+            result->cache      = (combo >> 1) & 1U;
+            result->reserved   = 0U;
+
+            APP_FLASHPROF_measure(result);
+
+            if(result->avgCycles < s_results[s_best].avgCycles)
+            {
+                s_best = index;
+            }
+
+            index++;
+        }
+    }
+
+    s_resultCount = index;
+
+    best = &s_results[s_best];
+    APP_FLASHPROF_configure(best->waitstates, best->prefetch != 0U, best->cache != 0U);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void APP_FLASHPROF_apply(void)
+{
+#ifdef _FLASH
+    APP_FLASHPROF_configure(APP_FLASHPROF_WAITSTATES,
+                            APP_FLASHPROF_PREFETCH != 0, APP_FLASHPROF_CACHE != 0);
+#endif
+}
+
+uint16_t APP_FLASHPROF_getResults(const APP_FLASHPROF_Result **results, uint16_t *best)
+{
+    if(results != NULL)
+    {
+        *results = s_results;
+    }
+
+    if(best != NULL)
+    {
+        *best = s_best;
+    }
+
+    return s_resultCount;
+}
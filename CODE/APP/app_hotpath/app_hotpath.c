@@ -0,0 +1,17 @@
+/**
+ * @file app_hotpath.c
+ * @brief 热路径代码的启动复制。
+ */
+
+#include "app_hotpath.h"
+
+#include <string.h>
+
+void APP_HOTPATH_init(void)
+{
+#ifdef _FLASH
+    /* 链接器生成的大小以 16 bit 字计，与 C28x 上 memcpy 的计数单位一致。 */
+    memcpy(&HotpathRunStart, &HotpathLoadStart, (size_t)&HotpathLoadSize);
+    memcpy(&FPUmathTablesRunStart, &FPUmathTablesLoadStart, (size_t)&FPUmathTablesLoadSize);
+#endif
+}
@@ -0,0 +1,529 @@
+/**
+ * @file app_param.c
+ * @brief 闪存参数存储的日志、索引与整理，与闪存硬件无关。
+ *
+ * 记录在闪存中的布局（字）：
+ *  - [0] 编号，[1] 数据字数，[2] 版本，[3] CRC16（覆盖 [0]~[2] 与数据）；
+ *  - [4] 起为数据，末尾不足一个单元的部分保持擦除值 0xFFFF。
+ *
+ * 扇区头占单元 0：[0] 魔数，[1] 格式，[2]~[3] 代数（低字在前），[4]~[6] 保持
+ * 0xFFFF，[7] CRC16（覆盖 [0]~[6]）。
+ *
+ * 每条记录编程后读回比较。编程失败或读回不符时，写指针移到第一个仍为擦除状态的
+ * 单元，已部分编程的单元由 CRC 排除，不会再次编程。
+ */
+
+#include "app_param.h"
+
+#include <string.h>
+
+/** 扇区头魔数与格式。 */
+#define APP_PARAM_MAGIC             (0x5041U)
+#define APP_PARAM_FORMAT            (1U)
+
+/** 扇区头 CRC 所在字。 */
+#define APP_PARAM_HEADER_CRC_INDEX  (7U)
+
+/** 记录头字数与各字下标。 */
+#define APP_PARAM_RECORD_HEADER     (4U)
+#define APP_PARAM_RECORD_ID         (0U)
+#define APP_PARAM_RECORD_WORDS      (1U)
+#define APP_PARAM_RECORD_VERSION    (2U)
+#define APP_PARAM_RECORD_CRC        (3U)
+
+/** 最长记录的单元数与字数。 */
+#define APP_PARAM_RECORD_MAX_UNITS  ((APP_PARAM_RECORD_HEADER + APP_PARAM_MAX_WORDS + APP_PARAM_UNIT_WORDS - 1U) / APP_PARAM_UNIT_WORDS)
+#define APP_PARAM_RECORD_MAX_WORDS  (APP_PARAM_RECORD_MAX_UNITS * APP_PARAM_UNIT_WORDS)
+
+/** 闪存擦除值。 */
+#define APP_PARAM_ERASED            (0xFFFFU)
+
+/** 索引中表示无记录的单元号，单元 0 是扇区头。 */
+#define APP_PARAM_NO_RECORD         (0U)
+
+/** 按 4 bit 查表计算 CRC16，表只占 16 个字。 */
+static const uint16_t s_crcTable[16] =
+{
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+};
+
+static uint16_t s_index[APP_PARAM_MAX_ID];      /**< 各编号最新记录所在单元。 */
+static uint16_t s_newIndex[APP_PARAM_MAX_ID];   /**< 整理时新扇区中的单元。 */
+static uint16_t s_record[APP_PARAM_RECORD_MAX_WORDS];  /**< 扫描、读取与整理时的记录副本。 */
+static uint16_t s_pending[APP_PARAM_RECORD_MAX_WORDS]; /**< 待追加的记录。 */
+static uint16_t s_check[APP_PARAM_RECORD_MAX_WORDS];   /**< 编程后的读回。 */
+
+static bool     s_ready = false;
+static uint16_t s_active = 0U;
+static uint32_t s_generation = 0U;
+static uint16_t s_writeUnit = 0U;
+
+static APP_PARAM_Stats s_stats;
+
+uint16_t APP_PARAM_crc16(uint16_t crc, const uint16_t *data, uint16_t words)
+{
+    uint16_t i;
+
+    for(i = 0U; i < words; i++)
+    {
+        uint16_t word = data[i];
+
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (word >> 12)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (word >> 8)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (word >> 4)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ word) & 0xFU]);
+    }
+
+    return crc;
+}
+
+static uint16_t APP_PARAM_recordUnits(uint16_t words)
+{
+    return (uint16_t)((APP_PARAM_RECORD_HEADER + words + APP_PARAM_UNIT_WORDS - 1U) / APP_PARAM_UNIT_WORDS);
+}
+
+static uint16_t APP_PARAM_recordCrc(const uint16_t *record)
+{
+    uint16_t crc = APP_PARAM_crc16(0xFFFFU, record, APP_PARAM_RECORD_CRC);
+
+    return APP_PARAM_crc16(crc, &record[APP_PARAM_RECORD_HEADER], record[APP_PARAM_RECORD_WORDS]);
+}
+
+static void APP_PARAM_readUnits(uint16_t sector, uint16_t unit, uint16_t *data, uint16_t units)
+{
+    APP_PARAM_PORT_read(sector, (uint16_t)(unit * APP_PARAM_UNIT_WORDS), data,
+                        (uint16_t)(units * APP_PARAM_UNIT_WORDS));
+}
+
+static bool APP_PARAM_isErased(const uint16_t *unit)
+{
+    uint16_t i;
+
+    for(i = 0U; i < APP_PARAM_UNIT_WORDS; i++)
+    {
+        if(unit[i] != APP_PARAM_ERASED)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool APP_PARAM_erase(uint16_t sector)
+{
+    s_stats.erases++;
+
+    if(!APP_PARAM_PORT_erase(sector))
+    {
+        s_stats.flashErrors++;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 编程连续的单元并读回比较。
+ */
+static bool APP_PARAM_program(uint16_t sector, uint16_t unit, const uint16_t *data, uint16_t units)
+{
+    uint16_t i;
+
+    for(i = 0U; i < units; i++)
+    {
+        if(!APP_PARAM_PORT_program(sector, (uint16_t)((unit + i) * APP_PARAM_UNIT_WORDS),
+                                   &data[i * APP_PARAM_UNIT_WORDS]))
+        {
+            s_stats.flashErrors++;
+            return false;
+        }
+    }
+
+    APP_PARAM_readUnits(sector, unit, s_check, units);
+
+    if(memcmp(s_check, data, (size_t)units * APP_PARAM_UNIT_WORDS * sizeof(uint16_t)) != 0)
+    {
+        s_stats.flashErrors++;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 把 unit 处的记录读入 buffer，长度与版本须与期望一致。
+ */
+static bool APP_PARAM_readRecord(uint16_t unit, uint16_t version, uint16_t words, uint16_t *buffer)
+{
+    APP_PARAM_readUnits(s_active, unit, buffer, 1U);
+
+    if((buffer[APP_PARAM_RECORD_WORDS] != words) || (buffer[APP_PARAM_RECORD_VERSION] != version))
+    {
+        return false;
+    }
+
+    if(APP_PARAM_recordUnits(words) > 1U)
+    {
+        APP_PARAM_readUnits(s_active, unit, buffer, APP_PARAM_recordUnits(words));
+    }
+
+    return true;
+}
+
+/**
+ * @brief 读取扇区头。
+ *
+ * @retval false 扇区头无效。
+ */
+static bool APP_PARAM_readHeader(uint16_t sector, uint32_t *generation)
+{
+    uint16_t header[APP_PARAM_UNIT_WORDS];
+
+    APP_PARAM_readUnits(sector, 0U, header, 1U);
+
+    if((header[0] != APP_PARAM_MAGIC) || (header[1] != APP_PARAM_FORMAT) ||
+       (APP_PARAM_crc16(0xFFFFU, header, APP_PARAM_HEADER_CRC_INDEX) != header[APP_PARAM_HEADER_CRC_INDEX]))
+    {
+        return false;
+    }
+
+    *generation = (uint32_t)header[2] | ((uint32_t)header[3] << 16);
+
+    return true;
+}
+
+static bool APP_PARAM_writeHeader(uint16_t sector, uint32_t generation)
+{
+    uint16_t header[APP_PARAM_UNIT_WORDS];
+
+    header[0] = APP_PARAM_MAGIC;
+    header[1] = APP_PARAM_FORMAT;
+    header[2] = (uint16_t)(generation & 0xFFFFU);
+    header[3] = (uint16_t)(generation >> 16);
+    header[4] = APP_PARAM_ERASED;
+    header[5] = APP_PARAM_ERASED;
+    header[6] = APP_PARAM_ERASED;
+    header[APP_PARAM_HEADER_CRC_INDEX] = APP_PARAM_crc16(0xFFFFU, header, APP_PARAM_HEADER_CRC_INDEX);
+
+    return APP_PARAM_program(sector, 0U, header, 1U);
+}
+
+/**
+ * @brief 从 unit 起跳过未擦除的单元，返回第一个擦除单元。
+ */
+static uint16_t APP_PARAM_findErased(uint16_t sector, uint16_t unit)
+{
+    uint16_t data[APP_PARAM_UNIT_WORDS];
+
+    while(unit < APP_PARAM_SECTOR_UNITS)
+    {
+        APP_PARAM_readUnits(sector, unit, data, 1U);
+
+        if(APP_PARAM_isErased(data))
+        {
+            break;
+        }
+
+        unit++;
+    }
+
+    return unit;
+}
+
+/**
+ * @brief 顺序扫描当前扇区的日志，建立索引并确定写指针。
+ */
+static void APP_PARAM_scan(void)
+{
+    uint16_t unit = 1U;
+
+    memset(s_index, 0, sizeof(s_index));
+
+    while(unit < APP_PARAM_SECTOR_UNITS)
+    {
+        uint16_t id;
+        uint16_t words;
+        uint16_t units;
+
+        APP_PARAM_readUnits(s_active, unit, s_record, 1U);
+
+        if(APP_PARAM_isErased(s_record))
+        {
+            break;
+        }
+
+        id    = s_record[APP_PARAM_RECORD_ID];
+        words = s_record[APP_PARAM_RECORD_WORDS];
+        units = APP_PARAM_recordUnits(words);
+
+        if((id < APP_PARAM_MAX_ID) && (words <= APP_PARAM_MAX_WORDS) &&
+           ((uint32_t)unit + units <= APP_PARAM_SECTOR_UNITS))
+        {
+            APP_PARAM_readUnits(s_active, unit, s_record, units);
+
+            if(APP_PARAM_recordCrc(s_record) == s_record[APP_PARAM_RECORD_CRC])
+            {
+                s_index[id] = (words != 0U) ? unit : APP_PARAM_NO_RECORD;
+                unit = (uint16_t)(unit + units);
+                continue;
+            }
+        }
+
+        /* 未写完或损坏的单元，逐个跳过直到下一条有效记录或擦除区。 */
+        s_stats.skippedUnits++;
+        unit++;
+    }
+
+    s_writeUnit = unit;
+}
+
+/**
+ * @brief 把每个编号的最新记录复制到备用扇区，成功后切换到备用扇区。
+ *
+ * 备用扇区总是先擦除，上一次整理留下的旧扇区或未完成的复制在此清除。
+ */
+static bool APP_PARAM_compact(void)
+{
+    uint16_t spare = (uint16_t)(1U - s_active);
+    uint16_t unit = 1U;
+    uint16_t id;
+
+    s_stats.compactions++;
+
+    if(!APP_PARAM_erase(spare))
+    {
+        return false;
+    }
+
+    for(id = 0U; id < APP_PARAM_MAX_ID; id++)
+    {
+        uint16_t units;
+
+        s_newIndex[id] = APP_PARAM_NO_RECORD;
+
+        if(s_index[id] == APP_PARAM_NO_RECORD)
+        {
+            continue;
+        }
+
+        APP_PARAM_readUnits(s_active, s_index[id], s_record, 1U);
+        units = APP_PARAM_recordUnits(s_record[APP_PARAM_RECORD_WORDS]);
+        APP_PARAM_readUnits(s_active, s_index[id], s_record, units);
+
+        if(!APP_PARAM_program(spare, unit, s_record, units))
+        {
+            return false;
+        }
+
+        s_newIndex[id] = unit;
+        unit = (uint16_t)(unit + units);
+    }
+
+    /* 扇区头最后写入，此前掉电时旧扇区仍为当前扇区。 */
+    if(!APP_PARAM_writeHeader(spare, s_generation + 1U))
+    {
+        return false;
+    }
+
+    s_active = spare;
+    s_generation++;
+    s_writeUnit = unit;
+    memcpy(s_index, s_newIndex, sizeof(s_index));
+
+    return true;
+}
+
+/**
+ * @brief 把 s_pending 中的记录追加到日志，空间不足时先整理。
+ */
+static bool APP_PARAM_append(void)
+{
+    uint16_t id = s_pending[APP_PARAM_RECORD_ID];
+    uint16_t words = s_pending[APP_PARAM_RECORD_WORDS];
+    uint16_t units = APP_PARAM_recordUnits(words);
+    uint16_t unit;
+
+    if((uint32_t)s_writeUnit + units > APP_PARAM_SECTOR_UNITS)
+    {
+        if(!APP_PARAM_compact() || ((uint32_t)s_writeUnit + units > APP_PARAM_SECTOR_UNITS))
+        {
+            return false;
+        }
+    }
+
+    unit = s_writeUnit;
+
+    if(!APP_PARAM_program(s_active, unit, s_pending, units))
+    {
+        s_writeUnit = APP_PARAM_findErased(s_active, unit);
+        return false;
+    }
+
+    s_index[id] = (words != 0U) ? unit : APP_PARAM_NO_RECORD;
+    s_writeUnit = (uint16_t)(unit + units);
+    s_stats.writes++;
+
+    return true;
+}
+
+static void APP_PARAM_buildRecord(uint16_t id, uint16_t version, const void *value, uint16_t words)
+{
+    memset(s_pending, 0xFF, sizeof(s_pending));
+
+    s_pending[APP_PARAM_RECORD_ID]      = id;
+    s_pending[APP_PARAM_RECORD_WORDS]   = words;
+    s_pending[APP_PARAM_RECORD_VERSION] = version;
+
+    if(words != 0U)
+    {
+        memcpy(&s_pending[APP_PARAM_RECORD_HEADER], value, (size_t)words * sizeof(uint16_t));
+    }
+
+    s_pending[APP_PARAM_RECORD_CRC] = APP_PARAM_recordCrc(s_pending);
+}
+
+bool APP_PARAM_init(void)
+{
+    uint32_t generation[APP_PARAM_SECTOR_COUNT];
+    bool valid[APP_PARAM_SECTOR_COUNT];
+    uint16_t sector;
+
+    s_ready = false;
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(s_index, 0, sizeof(s_index));
+
+    if(!APP_PARAM_PORT_init())
+    {
+        return false;
+    }
+
+    for(sector = 0U; sector < APP_PARAM_SECTOR_COUNT; sector++)
+    {
+        valid[sector] = APP_PARAM_readHeader(sector, &generation[sector]);
+    }
+
+    if(valid[0] && valid[1])
+    {
+        /* 整理完成但旧扇区尚未擦除，代数较大者为当前扇区。 */
+        s_active = ((int32_t)(generation[1] - generation[0]) > 0) ? 1U : 0U;
+    }
+    else if(valid[0] || valid[1])
+    {
+        s_active = valid[0] ? 0U : 1U;
+    }
+    else
+    {
+        /* 全新芯片或两个扇区都损坏，格式化 SEC14。 */
+        s_active = 0U;
+        generation[0] = 1U;
+
+        if(!APP_PARAM_erase(0U) || !APP_PARAM_writeHeader(0U, generation[0]))
+        {
+            return false;
+        }
+    }
+
+    s_generation = generation[s_active];
+    APP_PARAM_scan();
+    s_ready = true;
+
+    return true;
+}
+
+bool APP_PARAM_read(uint16_t id, uint16_t version, void *value, uint16_t words)
+{
+    uint16_t unit;
+
+    if(!s_ready || (id >= APP_PARAM_MAX_ID) || (value == NULL) ||
+       (words == 0U) || (words > APP_PARAM_MAX_WORDS))
+    {
+        return false;
+    }
+
+    unit = s_index[id];
+
+    if(unit == APP_PARAM_NO_RECORD)
+    {
+        return false;
+    }
+
+    if(!APP_PARAM_readRecord(unit, version, words, s_record))
+    {
+        return false;
+    }
+
+    memcpy(value, &s_record[APP_PARAM_RECORD_HEADER], (size_t)words * sizeof(uint16_t));
+
+    return true;
+}
+
+bool APP_PARAM_write(uint16_t id, uint16_t version, const void *value, uint16_t words)
+{
+    uint16_t unit;
+
+    if(!s_ready || (id >= APP_PARAM_MAX_ID) || (value == NULL) ||
+       (words == 0U) || (words > APP_PARAM_MAX_WORDS))
+    {
+        return false;
+    }
+
+    unit = s_index[id];
+
+    if((unit != APP_PARAM_NO_RECORD) && APP_PARAM_readRecord(unit, version, words, s_record))
+    {
+        if(memcmp(&s_record[APP_PARAM_RECORD_HEADER], value, (size_t)words * sizeof(uint16_t)) == 0)
+        {
+            s_stats.unchanged++;
+            return true;
+        }
+    }
+
+    APP_PARAM_buildRecord(id, version, value, words);
+
+    return APP_PARAM_append();
+}
+
+bool APP_PARAM_remove(uint16_t id)
+{
+    if(!s_ready || (id >= APP_PARAM_MAX_ID))
+    {
+        return false;
+    }
+
+    if(s_index[id] == APP_PARAM_NO_RECORD)
+    {
+        return true;
+    }
+
+    APP_PARAM_buildRecord(id, 0U, NULL, 0U);
+
+    return APP_PARAM_append();
+}
+
+void APP_PARAM_getStats(APP_PARAM_Stats *stats)
+{
+    uint16_t id;
+
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    *stats = s_stats;
+    stats->ready        = s_ready;
+    stats->activeSector = s_active;
+    stats->generation   = s_generation;
+    stats->records      = 0U;
+    stats->usedUnits    = s_ready ? s_writeUnit : 0U;
+    stats->freeUnits    = s_ready ? (uint16_t)(APP_PARAM_SECTOR_UNITS - s_writeUnit) : 0U;
+
+    for(id = 0U; id < APP_PARAM_MAX_ID; id++)
+    {
+        if(s_index[id] != APP_PARAM_NO_RECORD)
+        {
+            stats->records++;
+        }
+    }
+}
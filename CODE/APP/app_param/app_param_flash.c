@@ -0,0 +1,171 @@
+/**
+ * @file app_param_flash.c
+ * @brief APP_PARAM 闪存接口的 Flash API 实现，擦写 FLASH_BANK1_SEC14/15。
+ *
+ * 参数扇区位于 BANK1，程序与中断服务在 BANK0 运行，擦写期间不必停止中断。
+ * 读取时短暂关闭 ECC：掉电时未写完的单元 ECC 可能不符，带 ECC 读取会产生不可纠正
+ * 错误；数据由记录 CRC 校验。改写闪存控制寄存器的函数须从 RAM 运行，放在
+ * .TI.ramfunc 中。
+ *
+ * 工程默认链接 C2000Ware libraries/flash_api/f28004x 的 ROM Flash API
+ * （F021_ROM_API_F28004x_FPU32_eabi.lib）。APP_PARAM_FLASH_API 置 0 时不链接，
+ * APP_PARAM_PORT_init 返回 false，参数沿用代码中的默认值。
+ */
+
+#include "app_param.h"
+
+#include "driverlib.h"
+#include "device.h"
+
+#if APP_PARAM_FLASH_API != 0
+#include "F021_F28004x_C28x.h"
+#endif
+
+/** 参数扇区起始地址。 */
+#define APP_PARAM_SEC14_ADDR        (0x09E000UL)
+#define APP_PARAM_SEC15_ADDR        (0x09F000UL)
+
+#pragma CODE_SECTION(APP_PARAM_PORT_read, ".TI.ramfunc")
+#pragma CODE_SECTION(APP_PARAM_PORT_program, ".TI.ramfunc")
+#pragma CODE_SECTION(APP_PARAM_PORT_erase, ".TI.ramfunc")
+
+static const uint32_t s_sectorAddr[APP_PARAM_SECTOR_COUNT] =
+{
+    APP_PARAM_SEC14_ADDR,
+    APP_PARAM_SEC15_ADDR
+};
+
+#if APP_PARAM_FLASH_API != 0
+
+static bool s_ready = false;
+
+/**
+ * @brief 等待状态机完成并检查结果。
+ */
+static bool APP_PARAM_PORT_waitFsm(void)
+{
+    while(Fapi_checkFsmForReady() == Fapi_Status_FsmBusy)
+    {
+    }
+
+    return Fapi_getFsmStatus() == 0U;
+}
+
+bool APP_PARAM_PORT_init(void)
+{
+    Fapi_StatusType status;
+
+    EALLOW;
+    status = Fapi_initializeAPI(F021_CPU0_BASE_ADDRESS, DEVICE_SYSCLK_FREQ / 1000000U);
+
+    if(status == Fapi_Status_Success)
+    {
+        status = Fapi_setActiveFlashBank(Fapi_FlashBank1);
+    }
+
+    EDIS;
+
+    s_ready = (status == Fapi_Status_Success);
+
+    return s_ready;
+}
+
+void APP_PARAM_PORT_read(uint16_t sector, uint16_t offset, uint16_t *data, uint16_t words)
+{
+    const volatile uint16_t *src = (const volatile uint16_t *)(s_sectorAddr[sector] + offset);
+    uint16_t state;
+    uint16_t i;
+
+    state = __disable_interrupts();
+    Flash_disableECC(FLASH0ECC_BASE);
+
+    for(i = 0U; i < words; i++)
+    {
+        data[i] = src[i];
+    }
+
+    Flash_enableECC(FLASH0ECC_BASE);
+    __restore_interrupts(state);
+}
+
+bool APP_PARAM_PORT_program(uint16_t sector, uint16_t offset, const uint16_t *data)
+{
+    Fapi_StatusType status;
+    bool ok;
+
+    if(!s_ready)
+    {
+        return false;
+    }
+
+    EALLOW;
+    status = Fapi_issueProgrammingCommand((uint32_t *)(s_sectorAddr[sector] + offset), (uint16_t *)data,
+                                          APP_PARAM_UNIT_WORDS, 0, 0, Fapi_AutoEccGeneration);
+    ok = (status == Fapi_Status_Success) && APP_PARAM_PORT_waitFsm();
+    EDIS;
+
+    return ok;
+}
+
+bool APP_PARAM_PORT_erase(uint16_t sector)
+{
+    Fapi_FlashStatusWordType statusWord;
+    Fapi_StatusType status;
+    bool ok;
+
+    if(!s_ready)
+    {
+        return false;
+    }
+
+    EALLOW;
+    status = Fapi_issueAsyncCommandWithAddress(Fapi_EraseSector, (uint32_t *)s_sectorAddr[sector]);
+    ok = (status == Fapi_Status_Success) && APP_PARAM_PORT_waitFsm();
+
+    if(ok)
+    {
+        /* 长度以 32 bit 为单位。 */
+        ok = (Fapi_doBlankCheck((uint32_t *)s_sectorAddr[sector], APP_PARAM_SECTOR_WORDS / 2U,
+                                &statusWord) == Fapi_Status_Success);
+    }
+
+    EDIS;
+
+    return ok;
+}
+
+#else
+
+bool APP_PARAM_PORT_init(void)
+{
+    return false;
+}
+
+void APP_PARAM_PORT_read(uint16_t sector, uint16_t offset, uint16_t *data, uint16_t words)
+{
+    const volatile uint16_t *src = (const volatile uint16_t *)(s_sectorAddr[sector] + offset);
+    uint16_t i;
+
+    for(i = 0U; i < words; i++)
+    {
+        data[i] = src[i];
+    }
+}
+
+bool APP_PARAM_PORT_program(uint16_t sector, uint16_t offset, const uint16_t *data)
+{
+    (void)sector;
+    (void)offset;
+    (void)data;
+
+    return false;
+}
+
+bool APP_PARAM_PORT_erase(uint16_t sector)
+{
+    (void)sector;
+
+    return false;
+}
+
+#endif
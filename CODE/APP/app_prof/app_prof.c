@@ -0,0 +1,167 @@
+/**
+ * @file app_prof.c
+ * @brief 代码区域周期测量的统计部分，与计数硬件无关。
+ *
+ * 统计的更新与读取都在 APP_PROF_PORT_lock 保护的几条指令内完成，快照可在任意任务
+ * 中读取；平均值的除法在保护区外进行。
+ */
+
+#include "app_prof.h"
+
+#include <stddef.h>
+
+/**
+ * @brief 单个区域的配置与统计。
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t    startAddr;
+    uint32_t    endAddr;
+    uint32_t    samples;
+    uint32_t    lastCycles;
+    uint32_t    minCycles;
+    uint64_t    sum;            /**< 样本累加和。 */
+} APP_PROF_Region;
+
+static APP_PROF_Region    s_regions[APP_PROF_MAX_REGIONS];
+static uint16_t           s_regionCount = 0U;
+static bool               s_ready = false;
+
+static void APP_PROF_clearStats(APP_PROF_Region *region)
+{
+    region->samples    = 0U;
+    region->lastCycles = 0U;
+    region->minCycles  = 0U;
+    region->sum        = 0U;
+}
+
+bool APP_PROF_init(void)
+{
+    s_regionCount = 0U;
+    s_ready       = APP_PROF_PORT_init();
+
+    return s_ready;
+}
+
+bool APP_PROF_addRegion(const char *name, uint32_t startAddr, uint32_t endAddr, uint16_t *id)
+{
+    APP_PROF_Region *region;
+    uint16_t index = s_regionCount;
+
+    if(!s_ready || (name == NULL) || (endAddr < startAddr) ||
+       (index >= APP_PROF_MAX_REGIONS))
+    {
+        return false;
+    }
+
+    region = &s_regions[index];
+    region->name      = name;
+    region->startAddr = startAddr;
+    region->endAddr   = endAddr;
+    APP_PROF_clearStats(region);
+
+    APP_PROF_PORT_attach(index, startAddr, endAddr);
+    APP_PROF_PORT_clearMax(index);
+
+    s_regionCount = index + 1U;
+
+    if(id != NULL)
+    {
+        *id = index;
+    }
+
+    return true;
+}
+
+bool APP_PROF_addFunction(const char *name, uint32_t entryAddr, uint32_t sizeWords, uint16_t *id)
+{
+    if(sizeWords == 0U)
+    {
+        return false;
+    }
+
+    return APP_PROF_addRegion(name, entryAddr, entryAddr + sizeWords - 1U, id);
+}
+
+void APP_PROF_sample(void)
+{
+    uint16_t index;
+
+    for(index = 0U; index < s_regionCount; index++)
+    {
+        APP_PROF_Region *region = &s_regions[index];
+        uint32_t cycles = APP_PROF_PORT_takeCount(index);
+        uint16_t state;
+
+        if(cycles == 0U)
+        {
+            continue;
+        }
+
+        state = APP_PROF_PORT_lock();
+
+        if((region->samples == 0U) || (cycles < region->minCycles))
+        {
+            region->minCycles = cycles;
+        }
+
+        region->sum       += cycles;
+        region->lastCycles = cycles;
+        region->samples++;
+
+        APP_PROF_PORT_unlock(state);
+    }
+}
+
+bool APP_PROF_getSnapshot(uint16_t id, APP_PROF_Snapshot *snapshot)
+{
+    const APP_PROF_Region *region;
+    uint64_t sum;
+    uint16_t state;
+
+    if((id >= s_regionCount) || (snapshot == NULL))
+    {
+        return false;
+    }
+
+    region = &s_regions[id];
+
+    state = APP_PROF_PORT_lock();
+    snapshot->samples    = region->samples;
+    snapshot->lastCycles = region->lastCycles;
+    snapshot->minCycles  = region->minCycles;
+    sum                  = region->sum;
+    APP_PROF_PORT_unlock(state);
+
+    snapshot->name      = region->name;
+    snapshot->startAddr = region->startAddr;
+    snapshot->endAddr   = region->endAddr;
+    snapshot->maxCycles = APP_PROF_PORT_getMax(id);
+    snapshot->avgCycles = (snapshot->samples != 0U) ?
+                          (uint32_t)(sum / snapshot->samples) : 0U;
+
+    return true;
+}
+
+uint16_t APP_PROF_getRegionCount(void)
+{
+    return s_regionCount;
+}
+
+void APP_PROF_reset(void)
+{
+    uint16_t index;
+
+    for(index = 0U; index < s_regionCount; index++)
+    {
+        uint16_t state;
+
+        (void)APP_PROF_PORT_takeCount(index);
+        APP_PROF_PORT_clearMax(index);
+
+        state = APP_PROF_PORT_lock();
+        APP_PROF_clearStats(&s_regions[index]);
+        APP_PROF_PORT_unlock(state);
+    }
+}
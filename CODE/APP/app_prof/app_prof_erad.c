@@ -0,0 +1,103 @@
+/**
+ * @file app_prof_erad.c
+ * @brief APP_PROF 计数硬件接口的 ERAD 实现。
+ *
+ * 区域 n 使用总线比较器 HWBP(2n+1)、HWBP(2n+2) 与计数器 COUNTER(n+1)，由
+ * ERAD_profile 一次配置完成。ERAD 寄存器受 EALLOW 保护，driverlib 函数内部已
+ * 处理。
+ */
+
+#include "app_prof.h"
+
+#include "driverlib.h"
+
+/** 相邻总线比较器与计数器的基地址间隔。 */
+#define APP_PROF_HWBP_STRIDE        (ERAD_HWBP2_BASE - ERAD_HWBP1_BASE)
+#define APP_PROF_COUNTER_STRIDE     (ERAD_COUNTER2_BASE - ERAD_COUNTER1_BASE)
+
+static inline uint32_t APP_PROF_counterBase(uint16_t index)
+{
+    return ERAD_COUNTER1_BASE + ((uint32_t)index * APP_PROF_COUNTER_STRIDE);
+}
+
+static inline uint32_t APP_PROF_busCompBase(uint16_t index, uint16_t which)
+{
+    return ERAD_HWBP1_BASE + ((uint32_t)((index * 2U) + which) * APP_PROF_HWBP_STRIDE);
+}
+
+bool APP_PROF_PORT_init(void)
+{
+    if(ERAD_getOwnership() == ERAD_OWNER_DEBUGGER)
+    {
+        return false;
+    }
+
+    ERAD_initModule(ERAD_OWNER_APPLICATION);
+
+    return true;
+}
+
+void APP_PROF_PORT_attach(uint16_t index, uint32_t startAddr, uint32_t endAddr)
+{
+    ERAD_Profile_Params params;
+    uint32_t counterBase = APP_PROF_counterBase(index);
+
+    params.start_address = startAddr;
+    params.end_address   = endAddr;
+    params.bus_sel       = ERAD_BUSCOMP_BUS_VPC;
+    params.busComp_base1 = APP_PROF_busCompBase(index, 0U);
+    params.busComp_base2 = APP_PROF_busCompBase(index, 1U);
+    params.counter_base  = counterBase;
+
+    /* 重新配置前停用原有模块，ERAD_profile 要求计数器处于空闲状态。 */
+    ERAD_disableModules(ERAD_getBusCompInstance(params.busComp_base1) |
+                        ERAD_getBusCompInstance(params.busComp_base2) |
+                        ERAD_getCounterInstance(counterBase));
+
+    ERAD_profile(params);
+}
+
+uint32_t APP_PROF_PORT_takeCount(uint16_t index)
+{
+    uint32_t counterBase = APP_PROF_counterBase(index);
+    uint32_t first;
+    uint32_t second;
+    uint16_t state = __disable_interrupts();
+
+    /* 计数进行中两次读数不同；屏蔽中断后中断区域不会在清零前重新开始。 */
+    first  = ERAD_getCurrentCount(counterBase);
+    second = ERAD_getCurrentCount(counterBase);
+
+    if((first != second) || (first == 0U))
+    {
+        first = 0U;
+    }
+    else
+    {
+        ERAD_setCurrentCount(counterBase, 0U);
+    }
+
+    __restore_interrupts(state);
+
+    return first;
+}
+
+uint32_t APP_PROF_PORT_getMax(uint16_t index)
+{
+    return ERAD_getMaxCount(APP_PROF_counterBase(index));
+}
+
+void APP_PROF_PORT_clearMax(uint16_t index)
+{
+    ERAD_setMaxCount(APP_PROF_counterBase(index), 0U);
+}
+
+uint16_t APP_PROF_PORT_lock(void)
+{
+    return __disable_interrupts();
+}
+
+void APP_PROF_PORT_unlock(uint16_t state)
+{
+    __restore_interrupts(state);
+}
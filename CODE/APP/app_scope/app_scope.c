@@ -0,0 +1,329 @@
+/**
+ * @file app_scope.c
+ * @brief 实时数据记录器实现。
+ */
+
+#include "app_scope.h"
+
+#include <stddef.h>
+
+/** 缓冲区放在 RAMGS1，与 .bss 分开，便于按固定地址导出。 */
+#pragma DATA_SECTION(APP_SCOPE_buffer, "ramgs1")
+APP_SCOPE_Buffer APP_SCOPE_buffer;
+
+#pragma CODE_SECTION(APP_SCOPE_sample, "hotpath")
+#pragma CODE_SECTION(APP_SCOPE_read, "hotpath")
+#pragma CODE_SECTION(APP_SCOPE_isTriggered, "hotpath")
+
+/**
+ * @brief 已登记的信号。
+ */
+typedef struct
+{
+    const volatile void *address;
+    uint16_t             type;
+} APP_SCOPE_Channel;
+
+static APP_SCOPE_Channel s_channels[APP_SCOPE_MAX_CHANNELS];
+static uint16_t s_channelCount = 0U;
+
+static APP_SCOPE_Config s_config;
+static uint16_t s_preSamples = 0U;      /**< 预触发采样数。 */
+static uint16_t s_postSamples = 0U;     /**< 触发后采样数，含触发点。 */
+static uint16_t s_writeSlot = 0U;       /**< 下一次写入的槽位。 */
+static uint16_t s_filled = 0U;          /**< 已记录采样数，不超过深度。 */
+static uint16_t s_remaining = 0U;       /**< 触发后尚需记录的采样数。 */
+static uint16_t s_countdown = 0U;       /**< 距下一次记录的调用次数。 */
+static float    s_previous = 0.0f;      /**< 触发通道的上一个值，用于边沿判断。 */
+static bool     s_hasPrevious = false;
+static volatile uint16_t s_forced = 0U;
+
+static inline bool APP_SCOPE_isStopped(void)
+{
+    return (APP_SCOPE_buffer.state == (uint16_t)APP_SCOPE_STATE_IDLE) ||
+           (APP_SCOPE_buffer.state == (uint16_t)APP_SCOPE_STATE_DONE);
+}
+
+/**
+ * @brief 读取一个信号并换算为 float32。
+ */
+static float APP_SCOPE_read(const APP_SCOPE_Channel *channel)
+{
+    if(channel->type == (uint16_t)APP_SCOPE_TYPE_FLOAT32)
+    {
+        return *(const volatile float *)channel->address;
+    }
+
+    if(channel->type == (uint16_t)APP_SCOPE_TYPE_INT16)
+    {
+        return (float)*(const volatile int16_t *)channel->address;
+    }
+
+    return (float)*(const volatile uint16_t *)channel->address;
+}
+
+/**
+ * @brief 判断触发条件。
+ */
+static bool APP_SCOPE_isTriggered(float value)
+{
+    switch(s_config.mode)
+    {
+        case APP_SCOPE_TRIG_ABOVE:
+            return (value >= s_config.level);
+
+        case APP_SCOPE_TRIG_BELOW:
+            return (value <= s_config.level);
+
+        case APP_SCOPE_TRIG_RISING:
+            return s_hasPrevious && (s_previous < s_config.level) && (value >= s_config.level);
+
+        case APP_SCOPE_TRIG_FALLING:
+            return s_hasPrevious && (s_previous > s_config.level) && (value <= s_config.level);
+
+        case APP_SCOPE_TRIG_FAULT:
+            return (((uint16_t)(int32_t)value & s_config.mask) != 0U);
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 冻结缓冲区并计算时间顺序的起点与触发位置。
+ */
+static void APP_SCOPE_freeze(void)
+{
+    uint16_t depth = APP_SCOPE_buffer.depth;
+
+    APP_SCOPE_buffer.start = (s_writeSlot >= s_filled) ?
+                             (s_writeSlot - s_filled) : (uint16_t)((s_writeSlot + depth) - s_filled);
+    APP_SCOPE_buffer.samples      = s_filled;
+    APP_SCOPE_buffer.triggerIndex = s_filled - s_postSamples;
+    APP_SCOPE_buffer.state        = (uint16_t)APP_SCOPE_STATE_DONE;
+}
+
+void APP_SCOPE_init(void)
+{
+    APP_SCOPE_buffer.state        = (uint16_t)APP_SCOPE_STATE_IDLE;
+    APP_SCOPE_buffer.magic        = APP_SCOPE_MAGIC;
+    APP_SCOPE_buffer.version      = APP_SCOPE_VERSION;
+    APP_SCOPE_buffer.channels     = 0U;
+    APP_SCOPE_buffer.depth        = 0U;
+    APP_SCOPE_buffer.divider      = 1U;
+    APP_SCOPE_buffer.start        = 0U;
+    APP_SCOPE_buffer.samples      = 0U;
+    APP_SCOPE_buffer.triggerIndex = 0U;
+
+    s_channelCount = 0U;
+    s_forced = 0U;
+}
+
+bool APP_SCOPE_addChannel(const volatile void *address, uint16_t type, uint16_t *channel)
+{
+    if((address == NULL) || (type > (uint16_t)APP_SCOPE_TYPE_UINT16) ||
+       (s_channelCount >= APP_SCOPE_MAX_CHANNELS) || !APP_SCOPE_isStopped())
+    {
+        return false;
+    }
+
+    s_channels[s_channelCount].address = address;
+    s_channels[s_channelCount].type    = type;
+
+    if(channel != NULL)
+    {
+        *channel = s_channelCount;
+    }
+
+    s_channelCount++;
+
+    return true;
+}
+
+bool APP_SCOPE_clearChannels(void)
+{
+    if(!APP_SCOPE_isStopped())
+    {
+        return false;
+    }
+
+    s_channelCount = 0U;
+
+    return true;
+}
+
+bool APP_SCOPE_arm(const APP_SCOPE_Config *config)
+{
+    uint16_t depth;
+
+    if((config == NULL) || (s_channelCount == 0U) ||
+       (config->mode >= (uint16_t)APP_SCOPE_TRIG_COUNT) ||
+       (config->channel >= s_channelCount) ||
+       (config->preTriggerPercent > 100U) || (config->divider == 0U))
+    {
+        return false;
+    }
+
+    /* 先停止，控制中断在配置期间不会写入。 */
+    APP_SCOPE_buffer.state = (uint16_t)APP_SCOPE_STATE_IDLE;
+
+    depth = APP_SCOPE_CAPACITY / s_channelCount;
+
+    s_config      = *config;
+    s_preSamples  = (uint16_t)(((uint32_t)depth * config->preTriggerPercent) / 100U);
+
+    /* 触发点本身属于触发后部分，预触发最多为深度减一。 */
+    if(s_preSamples >= depth)
+    {
+        s_preSamples = depth - 1U;
+    }
+
+    s_postSamples = depth - s_preSamples;
+    s_writeSlot   = 0U;
+    s_filled      = 0U;
+    s_remaining   = 0U;
+    s_countdown   = 0U;
+    s_previous    = 0.0f;
+    s_hasPrevious = false;
+    s_forced      = 0U;
+
+    APP_SCOPE_buffer.channels     = s_channelCount;
+    APP_SCOPE_buffer.depth        = depth;
+    APP_SCOPE_buffer.divider      = config->divider;
+    APP_SCOPE_buffer.start        = 0U;
+    APP_SCOPE_buffer.samples      = 0U;
+    APP_SCOPE_buffer.triggerIndex = 0U;
+
+    APP_SCOPE_buffer.state = (s_preSamples == 0U) ?
+                             (uint16_t)APP_SCOPE_STATE_ARMED : (uint16_t)APP_SCOPE_STATE_PRETRIGGER;
+
+    return true;
+}
+
+void APP_SCOPE_trigger(void)
+{
+    s_forced = 1U;
+}
+
+void APP_SCOPE_stop(void)
+{
+    APP_SCOPE_buffer.state = (uint16_t)APP_SCOPE_STATE_IDLE;
+}
+
+uint16_t APP_SCOPE_getState(void)
+{
+    return APP_SCOPE_buffer.state;
+}
+
+bool APP_SCOPE_getCapture(APP_SCOPE_Capture *capture)
+{
+    if((capture == NULL) || (APP_SCOPE_buffer.state != (uint16_t)APP_SCOPE_STATE_DONE))
+    {
+        return false;
+    }
+
+    capture->channels     = APP_SCOPE_buffer.channels;
+    capture->samples      = APP_SCOPE_buffer.samples;
+    capture->triggerIndex = APP_SCOPE_buffer.triggerIndex;
+    capture->divider      = APP_SCOPE_buffer.divider;
+
+    return true;
+}
+
+bool APP_SCOPE_readSample(uint16_t index, float *values)
+{
+    uint16_t slot;
+    uint16_t channel;
+    const float *src;
+
+    if((values == NULL) || (APP_SCOPE_buffer.state != (uint16_t)APP_SCOPE_STATE_DONE) ||
+       (index >= APP_SCOPE_buffer.samples))
+    {
+        return false;
+    }
+
+    slot = (uint16_t)(((uint32_t)APP_SCOPE_buffer.start + index) % APP_SCOPE_buffer.depth);
+    src  = &APP_SCOPE_buffer.data[(uint32_t)slot * APP_SCOPE_buffer.channels];
+
+    for(channel = 0U; channel < APP_SCOPE_buffer.channels; channel++)
+    {
+        values[channel] = src[channel];
+    }
+
+    return true;
+}
+
+void APP_SCOPE_sample(void)
+{
+    uint16_t state = APP_SCOPE_buffer.state;
+    uint16_t channel;
+    float *dst;
+    float value;
+
+    if((state == (uint16_t)APP_SCOPE_STATE_IDLE) || (state == (uint16_t)APP_SCOPE_STATE_DONE))
+    {
+        return;
+    }
+
+    if(s_countdown != 0U)
+    {
+        s_countdown--;
+        return;
+    }
+
+    s_countdown = s_config.divider - 1U;
+
+    dst = &APP_SCOPE_buffer.data[(uint32_t)s_writeSlot * s_channelCount];
+
+    for(channel = 0U; channel < s_channelCount; channel++)
+    {
+        dst[channel] = APP_SCOPE_read(&s_channels[channel]);
+    }
+
+    value = dst[s_config.channel];
+
+    s_writeSlot++;
+    if(s_writeSlot >= APP_SCOPE_buffer.depth)
+    {
+        s_writeSlot = 0U;
+    }
+
+    if(s_filled < APP_SCOPE_buffer.depth)
+    {
+        s_filled++;
+    }
+
+    if(state == (uint16_t)APP_SCOPE_STATE_TRIGGERED)
+    {
+        s_remaining--;
+    }
+    else
+    {
+        /* 预触发阶段只响应软件触发。 */
+        bool triggered = (s_forced != 0U) ||
+                         ((state == (uint16_t)APP_SCOPE_STATE_ARMED) && APP_SCOPE_isTriggered(value));
+
+        if(triggered)
+        {
+            s_forced    = 0U;
+            s_remaining = s_postSamples - 1U;
+            state       = (uint16_t)APP_SCOPE_STATE_TRIGGERED;
+        }
+        else if((state == (uint16_t)APP_SCOPE_STATE_PRETRIGGER) && (s_filled >= s_preSamples))
+        {
+            state = (uint16_t)APP_SCOPE_STATE_ARMED;
+        }
+    }
+
+    s_previous    = value;
+    s_hasPrevious = true;
+
+    if((state == (uint16_t)APP_SCOPE_STATE_TRIGGERED) && (s_remaining == 0U))
+    {
+        APP_SCOPE_freeze();
+    }
+    else
+    {
+        APP_SCOPE_buffer.state = state;
+    }
+}
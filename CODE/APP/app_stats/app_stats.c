@@ -0,0 +1,372 @@
+/**
+ * @file app_stats.c
+ * @brief CPU 占用与运行时统计实现。
+ *
+ * 每个窗口结束时：
+ *  - 通过 uxTaskGetSystemState 取得各任务累计运行时间与栈高水位，与上一窗口的
+ *    快照相减得到窗口内占用（32 bit 计数回绕由无符号减法自然处理）；
+ *  - 在临界区内取走并清零各中断累加器与任务最长执行时间；
+ *  - 组装记录后在临界区内整体复制到发布缓冲区，读者取得的始终是完整记录。
+ *
+ * 任务部分依赖 configGENERATE_RUN_TIME_STATS 与 configUSE_TRACE_FACILITY，
+ * 未开启时记录只包含中断条目，总体占用以中断占用代替。
+ */
+
+#include "app_stats.h"
+
+#include <string.h>
+
+#if defined(configGENERATE_RUN_TIME_STATS) && (configGENERATE_RUN_TIME_STATS == 1) && \
+    defined(configUSE_TRACE_FACILITY) && (configUSE_TRACE_FACILITY == 1)
+#define APP_STATS_HAS_TASK_STATS    (1)
+#else
+#define APP_STATS_HAS_TASK_STATS    (0)
+#endif
+
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME        "IDLE"
+#endif
+
+/**
+ * @brief 任务最长执行时间表项，以任务句柄索引。
+ */
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t     maxCycles;
+} APP_STATS_TaskMax;
+
+/**
+ * @brief 上一窗口结束时的任务运行时间快照。
+ */
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t     runTime;
+} APP_STATS_TaskPrev;
+
+volatile APP_STATS_IsrAcc APP_STATS_isrAcc[APP_STATS_MAX_ISRS];
+
+static APP_STATS_TaskMax  s_taskMax[APP_STATS_MAX_TASKS];
+static APP_STATS_Record   s_record;
+static bool               s_recordValid = false;
+static uint32_t           s_windowStart = 0U;
+
+#if APP_STATS_HAS_TASK_STATS
+static TaskStatus_t       s_taskStatus[APP_STATS_MAX_TASKS];
+static APP_STATS_TaskPrev s_taskPrev[APP_STATS_MAX_TASKS];
+#endif
+
+/**
+ * @brief 按千分比换算占用，避免 32 位乘法溢出。
+ */
+static uint16_t APP_STATS_permille(uint32_t busy, uint32_t window)
+{
+    uint32_t permille;
+
+    if(window == 0U)
+    {
+        return 0U;
+    }
+
+    permille = (uint32_t)(((uint64_t)busy * 1000U) / window);
+
+    return (uint16_t)((permille > 1000U) ? 1000U : permille);
+}
+
+void APP_STATS_init(void)
+{
+    /**
+     * 周期设为最大值、预分频为 1，计数器以 SYSCLK 连续递减并自动重装，
+     * 不使能中断；仿真暂停时计数器继续运行，保证窗口长度与实际时间一致。
+     */
+    CPUTimer_stopTimer(APP_STATS_TIMER_BASE);
+    CPUTimer_setPeriod(APP_STATS_TIMER_BASE, 0xFFFFFFFFUL);
+    CPUTimer_setPreScaler(APP_STATS_TIMER_BASE, 0U);
+    CPUTimer_disableInterrupt(APP_STATS_TIMER_BASE);
+    CPUTimer_setEmulationMode(APP_STATS_TIMER_BASE, CPUTIMER_EMULATIONMODE_RUNFREE);
+    CPUTimer_reloadTimerCounter(APP_STATS_TIMER_BASE);
+    CPUTimer_startTimer(APP_STATS_TIMER_BASE);
+
+    memset((void *)APP_STATS_isrAcc, 0, sizeof(APP_STATS_isrAcc));
+    memset(s_taskMax, 0, sizeof(s_taskMax));
+
+    s_recordValid = false;
+    s_windowStart = APP_STATS_now();
+}
+
+void vConfigureTimerForRunTimeStats(void)
+{
+    /* 时间基准已由 APP_STATS_init 在调度启动前开启。 */
+}
+
+uint32_t ulGetRunTimeCounterValue(void)
+{
+    return APP_STATS_now();
+}
+
+void APP_STATS_taskEnd(uint32_t start)
+{
+    /**
+     * 以当前任务句柄查表，首次出现的任务占用一个空表项；表满时忽略。
+     * 每个任务只改写自己的表项，最长值比较无需加锁。
+     */
+    uint32_t elapsed = APP_STATS_now() - start;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    uint16_t index;
+
+    for(index = 0U; index < APP_STATS_MAX_TASKS; index++)
+    {
+        APP_STATS_TaskMax *slot = &s_taskMax[index];
+
+        if(slot->handle == NULL)
+        {
+            taskENTER_CRITICAL();
+
+            if(slot->handle == NULL)
+            {
+                slot->handle = self;
+            }
+
+            taskEXIT_CRITICAL();
+        }
+
+        if(slot->handle == self)
+        {
+            if(elapsed > slot->maxCycles)
+            {
+                slot->maxCycles = elapsed;
+            }
+
+            return;
+        }
+    }
+}
+
+#if APP_STATS_HAS_TASK_STATS
+/**
+ * @brief 取出并清零指定任务的最长执行时间。调用时已处于临界区。
+ */
+static uint32_t APP_STATS_takeTaskMax(TaskHandle_t handle)
+{
+    uint16_t index;
+
+    for(index = 0U; index < APP_STATS_MAX_TASKS; index++)
+    {
+        if(s_taskMax[index].handle == handle)
+        {
+            uint32_t maxCycles = s_taskMax[index].maxCycles;
+
+            s_taskMax[index].maxCycles = 0U;
+            return maxCycles;
+        }
+    }
+
+    return 0U;
+}
+
+/**
+ * @brief 求任务在本窗口内的运行时间，并更新快照。
+ */
+static uint32_t APP_STATS_taskDelta(TaskHandle_t handle, uint32_t runTime)
+{
+    uint16_t index;
+    uint16_t freeSlot = APP_STATS_MAX_TASKS;
+
+    for(index = 0U; index < APP_STATS_MAX_TASKS; index++)
+    {
+        if(s_taskPrev[index].handle == handle)
+        {
+            uint32_t delta = runTime - s_taskPrev[index].runTime;
+
+            s_taskPrev[index].runTime = runTime;
+            return delta;
+        }
+
+        if((s_taskPrev[index].handle == NULL) && (freeSlot == APP_STATS_MAX_TASKS))
+        {
+            freeSlot = index;
+        }
+    }
+
+    /* 首次出现的任务以 0 为起点，计入其全部累计时间。 */
+    if(freeSlot < APP_STATS_MAX_TASKS)
+    {
+        s_taskPrev[freeSlot].handle  = handle;
+        s_taskPrev[freeSlot].runTime = runTime;
+    }
+
+    return runTime;
+}
+#endif
+
+void APP_STATS_update(void)
+{
+    APP_STATS_Record record;
+    APP_STATS_IsrAcc isr[APP_STATS_MAX_ISRS];
+    uint32_t now;
+    uint32_t isrBusy = 0U;
+    uint16_t index;
+    uint16_t count = 0U;
+    uint16_t cpuLoad;
+#if APP_STATS_HAS_TASK_STATS
+    uint32_t taskMax[APP_STATS_MAX_TASKS];
+    UBaseType_t taskCount;
+    uint32_t totalRunTime;
+    uint16_t idleLoad = 0U;
+    bool     idleFound = false;
+
+    /* 任务总数超过 APP_STATS_MAX_TASKS 时内核返回 0，记录只含中断条目。 */
+    taskCount = uxTaskGetSystemState(s_taskStatus, APP_STATS_MAX_TASKS, &totalRunTime);
+#endif
+
+    taskENTER_CRITICAL();
+
+    now = APP_STATS_now();
+
+    for(index = 0U; index < APP_STATS_MAX_ISRS; index++)
+    {
+        isr[index].busyCycles = APP_STATS_isrAcc[index].busyCycles;
+        isr[index].maxCycles  = APP_STATS_isrAcc[index].maxCycles;
+        isr[index].count      = APP_STATS_isrAcc[index].count;
+
+        APP_STATS_isrAcc[index].busyCycles = 0U;
+        APP_STATS_isrAcc[index].maxCycles  = 0U;
+        APP_STATS_isrAcc[index].count      = 0U;
+    }
+
+#if APP_STATS_HAS_TASK_STATS
+    for(index = 0U; index < (uint16_t)taskCount; index++)
+    {
+        taskMax[index] = APP_STATS_takeTaskMax(s_taskStatus[index].xHandle);
+    }
+#endif
+
+    taskEXIT_CRITICAL();
+
+    record.version      = APP_STATS_RECORD_VERSION;
+    record.windowCycles = now - s_windowStart;
+    s_windowStart       = now;
+
+#if APP_STATS_HAS_TASK_STATS
+    for(index = 0U; index < (uint16_t)taskCount; index++)
+    {
+        const TaskStatus_t *status = &s_taskStatus[index];
+        APP_STATS_Entry *entry = &record.entries[count];
+        uint32_t delta = APP_STATS_taskDelta(status->xHandle, status->ulRunTimeCounter);
+
+        entry->id           = (uint16_t)(status->xTaskNumber & (uint16_t)~APP_STATS_ID_ISR_FLAG);
+        entry->loadPermille = APP_STATS_permille(delta, record.windowCycles);
+        entry->maxCycles    = taskMax[index];
+        entry->stackFree    = (status->usStackHighWaterMark > 0xFFFEU) ?
+                              0xFFFEU : (uint16_t)status->usStackHighWaterMark;
+
+        if(strncmp(status->pcTaskName, configIDLE_TASK_NAME, sizeof(configIDLE_TASK_NAME)) == 0)
+        {
+            idleLoad  = entry->loadPermille;
+            idleFound = true;
+        }
+
+        count++;
+    }
+#endif
+
+    for(index = 0U; index < APP_STATS_MAX_ISRS; index++)
+    {
+        APP_STATS_Entry *entry;
+
+        if(isr[index].count == 0U)
+        {
+            continue;
+        }
+
+        entry = &record.entries[count];
+        entry->id           = (uint16_t)(APP_STATS_ID_ISR_FLAG | index);
+        entry->loadPermille = APP_STATS_permille(isr[index].busyCycles, record.windowCycles);
+        entry->maxCycles    = isr[index].maxCycles;
+        entry->stackFree    = APP_STATS_STACK_UNKNOWN;
+
+        isrBusy += isr[index].busyCycles;
+        count++;
+    }
+
+    record.count           = count;
+    record.isrLoadPermille = APP_STATS_permille(isrBusy, record.windowCycles);
+    cpuLoad                = record.isrLoadPermille;
+
+#if APP_STATS_HAS_TASK_STATS
+    /* 中断时间计入被打断的任务，空闲任务的余量即为整体余量。 */
+    if(idleFound)
+    {
+        cpuLoad = (uint16_t)(1000U - idleLoad);
+    }
+#endif
+
+    record.cpuLoadPermille = cpuLoad;
+
+    taskENTER_CRITICAL();
+    s_record      = record;
+    s_recordValid = true;
+    taskEXIT_CRITICAL();
+}
+
+bool APP_STATS_getRecord(APP_STATS_Record *record)
+{
+    bool valid;
+
+    if(record == NULL)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    valid = s_recordValid;
+
+    if(valid)
+    {
+        *record = s_record;
+    }
+
+    taskEXIT_CRITICAL();
+
+    return valid;
+}
+
+uint16_t APP_STATS_serialize(const APP_STATS_Record *record, uint16_t *buffer, uint16_t maxWords)
+{
+    uint16_t words;
+    uint16_t index;
+    uint16_t *out = buffer;
+
+    if((record == NULL) || (buffer == NULL))
+    {
+        return 0U;
+    }
+
+    words = (uint16_t)(APP_STATS_HEADER_WORDS + (record->count * APP_STATS_ENTRY_WORDS));
+
+    if(words > maxWords)
+    {
+        return 0U;
+    }
+
+    *out++ = record->version;
+    *out++ = record->count;
+    *out++ = (uint16_t)(record->windowCycles & 0xFFFFU);
+    *out++ = (uint16_t)(record->windowCycles >> 16);
+    *out++ = record->cpuLoadPermille;
+    *out++ = record->isrLoadPermille;
+
+    for(index = 0U; index < record->count; index++)
+    {
+        const APP_STATS_Entry *entry = &record->entries[index];
+
+        *out++ = entry->id;
+        *out++ = entry->loadPermille;
+        *out++ = (uint16_t)(entry->maxCycles & 0xFFFFU);
+        *out++ = (uint16_t)(entry->maxCycles >> 16);
+        *out++ = entry->stackFree;
+    }
+
+    return words;
+}
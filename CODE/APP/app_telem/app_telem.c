@@ -0,0 +1,354 @@
+/**
+ * @file app_telem.c
+ * @brief SCIA 二进制遥测调度实现。
+ *
+ * 本文件只依赖 DRV_SCI 的发送接口，主机端以模拟驱动编译本文件做回环测试；
+ * FreeRTOS 任务入口在 app_telem_task.c。
+ */
+
+#include "app_telem.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "drv_sci.h"
+
+/**
+ * @brief 流的调度状态。
+ */
+typedef struct
+{
+    uint16_t period;                /**< 发送周期（tick），0 表示暂停。 */
+    uint16_t countdown;             /**< 距下一次到期的 tick 数。 */
+    uint16_t pending;               /**< 已到期尚未发出。 */
+    uint16_t sequence;              /**< 包序号，发出后加 1。 */
+    uint16_t payload;               /**< 变量字节数。 */
+    APP_TELEM_CaptureFxn capture;   /**< 组包前调用的采集函数，可为 NULL。 */
+    void    *context;               /**< 采集函数的参数。 */
+} APP_TELEM_Stream;
+
+/**
+ * @brief 已登记的变量。
+ */
+typedef struct
+{
+    const volatile void *address;
+    uint16_t             type;
+    uint16_t             stream;
+} APP_TELEM_Signal;
+
+/**
+ * @brief 包缓冲区：帧直接编码在 frame 中，tx 指向它交给驱动。
+ */
+typedef struct
+{
+    DRV_SCI_TxBuffer tx;
+    uint16_t         frame[APP_TELEM_FRAME_MAX];
+} APP_TELEM_Packet;
+
+static APP_TELEM_Stream s_streams[APP_TELEM_MAX_STREAMS];
+static uint16_t s_streamCount = 0U;
+
+static APP_TELEM_Signal s_signals[APP_TELEM_MAX_SIGNALS];
+static uint16_t s_signalCount = 0U;
+
+static APP_TELEM_Packet s_packets[APP_TELEM_PACKET_COUNT];
+
+/** 编码前的原始内容，CRC 追加在末尾。 */
+static uint16_t s_raw[APP_TELEM_RAW_MAX];
+
+static uint32_t s_tickHz = 1U;
+static uint32_t s_bytesPerSecond = 0U;
+
+/** 字节额度，单位为 1 / tickHz 字节，避免每个 tick 的除法与累积误差。 */
+static uint32_t s_credit = 0U;
+static uint32_t s_creditMax = 0U;
+
+/** 下一次轮询的起始流。 */
+static uint16_t s_next = 0U;
+
+static APP_TELEM_Stats s_stats;
+
+static uint16_t APP_TELEM_typeBytes(uint16_t type)
+{
+    return ((type == (uint16_t)APP_TELEM_TYPE_FLOAT32) || (type == (uint16_t)APP_TELEM_TYPE_UINT32)) ? 4U : 2U;
+}
+
+/**
+ * @brief 读取一个变量并以小端序写入，返回字节数。
+ */
+static uint16_t APP_TELEM_putSignal(uint16_t *dst, const APP_TELEM_Signal *signal)
+{
+    if(signal->type == (uint16_t)APP_TELEM_TYPE_FLOAT32)
+    {
+        float value = *(const volatile float *)signal->address;
+        uint32_t bits;
+
+        (void)memcpy(&bits, &value, sizeof(bits));
+
+        return APP_TELEM_FRAME_putU32(dst, bits);
+    }
+
+    if(signal->type == (uint16_t)APP_TELEM_TYPE_UINT32)
+    {
+        return APP_TELEM_FRAME_putU32(dst, *(const volatile uint32_t *)signal->address);
+    }
+
+    return APP_TELEM_FRAME_putU16(dst, *(const volatile uint16_t *)signal->address);
+}
+
+static APP_TELEM_Packet *APP_TELEM_findFreePacket(void)
+{
+    uint16_t i;
+
+    for(i = 0U; i < APP_TELEM_PACKET_COUNT; i++)
+    {
+        if(s_packets[i].tx.busy == 0U)
+        {
+            return &s_packets[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 组包并编码进 packet，返回帧长度。
+ */
+static uint16_t APP_TELEM_build(uint16_t stream, uint32_t timestamp, APP_TELEM_Packet *packet)
+{
+    uint16_t length = 0U;
+    uint16_t i;
+
+    if(s_streams[stream].capture != NULL)
+    {
+        s_streams[stream].capture(s_streams[stream].context);
+    }
+
+    s_raw[0] = stream & 0xFFU;
+    s_raw[1] = s_streams[stream].sequence & 0xFFU;
+    length = 2U + APP_TELEM_FRAME_putU32(&s_raw[2], timestamp);
+
+    for(i = 0U; i < s_signalCount; i++)
+    {
+        if(s_signals[i].stream == stream)
+        {
+            length += APP_TELEM_putSignal(&s_raw[length], &s_signals[i]);
+        }
+    }
+
+    return APP_TELEM_FRAME_encode(s_raw, length, packet->frame, APP_TELEM_FRAME_MAX);
+}
+
+void APP_TELEM_init(uint32_t tickHz, uint32_t bytesPerSecond)
+{
+    uint16_t i;
+
+    s_streamCount = 0U;
+    s_signalCount = 0U;
+    s_next        = 0U;
+    s_tickHz      = (tickHz == 0U) ? 1U : tickHz;
+
+    (void)memset(&s_stats, 0, sizeof(s_stats));
+
+    for(i = 0U; i < APP_TELEM_PACKET_COUNT; i++)
+    {
+        s_packets[i].tx.data   = s_packets[i].frame;
+        s_packets[i].tx.length = 0U;
+        s_packets[i].tx.busy   = 0U;
+    }
+
+    APP_TELEM_setBudget(bytesPerSecond);
+}
+
+void APP_TELEM_setBudget(uint32_t bytesPerSecond)
+{
+    s_bytesPerSecond = (bytesPerSecond == 0U) ? (DRV_SCI_BAUD / DRV_SCI_BITS_PER_BYTE) : bytesPerSecond;
+
+    /* 最多积累整个缓冲池的额度，空闲之后的突发不超过缓冲区能容纳的帧数。 */
+    s_creditMax = (uint32_t)APP_TELEM_PACKET_COUNT * APP_TELEM_FRAME_MAX * s_tickHz;
+    s_credit    = 0U;
+}
+
+bool APP_TELEM_addStream(uint16_t periodTicks, uint16_t *stream)
+{
+    APP_TELEM_Stream *entry;
+
+    if(s_streamCount >= APP_TELEM_MAX_STREAMS)
+    {
+        return false;
+    }
+
+    entry = &s_streams[s_streamCount];
+    entry->period    = periodTicks;
+    entry->countdown = periodTicks;
+    entry->pending   = 0U;
+    entry->sequence  = 0U;
+    entry->payload   = 0U;
+    entry->capture   = NULL;
+    entry->context   = NULL;
+
+    if(stream != NULL)
+    {
+        *stream = s_streamCount;
+    }
+
+    s_streamCount++;
+
+    return true;
+}
+
+bool APP_TELEM_addSignal(uint16_t stream, const volatile void *address, uint16_t type)
+{
+    uint16_t bytes;
+
+    if((stream >= s_streamCount) || (address == NULL) ||
+       (type > (uint16_t)APP_TELEM_TYPE_UINT32) || (s_signalCount >= APP_TELEM_MAX_SIGNALS))
+    {
+        return false;
+    }
+
+    bytes = APP_TELEM_typeBytes(type);
+
+    if((s_streams[stream].payload + bytes) > APP_TELEM_MAX_PAYLOAD)
+    {
+        return false;
+    }
+
+    s_signals[s_signalCount].address = address;
+    s_signals[s_signalCount].type    = type;
+    s_signals[s_signalCount].stream  = stream;
+    s_signalCount++;
+
+    s_streams[stream].payload += bytes;
+
+    return true;
+}
+
+bool APP_TELEM_setCapture(uint16_t stream, APP_TELEM_CaptureFxn capture, void *context)
+{
+    if(stream >= s_streamCount)
+    {
+        return false;
+    }
+
+    s_streams[stream].capture = capture;
+    s_streams[stream].context = context;
+
+    return true;
+}
+
+bool APP_TELEM_setPeriod(uint16_t stream, uint16_t periodTicks)
+{
+    if(stream >= s_streamCount)
+    {
+        return false;
+    }
+
+    s_streams[stream].period    = periodTicks;
+    s_streams[stream].countdown = periodTicks;
+    s_streams[stream].pending   = 0U;
+
+    return true;
+}
+
+void APP_TELEM_service(uint32_t timestamp)
+{
+    uint16_t i;
+
+    s_credit += s_bytesPerSecond;
+
+    if(s_credit > s_creditMax)
+    {
+        s_credit = s_creditMax;
+    }
+
+    /* 到期后保持 pending，推迟期间再次到期不重复计数，相当于自动降低该流的速率。 */
+    for(i = 0U; i < s_streamCount; i++)
+    {
+        APP_TELEM_Stream *stream = &s_streams[i];
+
+        if(stream->period == 0U)
+        {
+            continue;
+        }
+
+        if(stream->countdown <= 1U)
+        {
+            stream->countdown = stream->period;
+            stream->pending   = 1U;
+        }
+        else
+        {
+            stream->countdown--;
+        }
+    }
+
+    for(i = 0U; i < s_streamCount; i++)
+    {
+        uint16_t index = s_next + i;
+        APP_TELEM_Packet *packet;
+        uint16_t length;
+        uint32_t cost;
+
+        if(index >= s_streamCount)
+        {
+            index -= s_streamCount;
+        }
+
+        if(s_streams[index].pending == 0U)
+        {
+            continue;
+        }
+
+        /* 推迟的流在下一个 tick 最先处理。 */
+        packet = APP_TELEM_findFreePacket();
+
+        if(packet == NULL)
+        {
+            s_stats.noBuffer++;
+            s_next = index;
+            return;
+        }
+
+        length = APP_TELEM_build(index, timestamp, packet);
+        cost   = (uint32_t)length * s_tickHz;
+
+        if(s_credit < cost)
+        {
+            s_stats.deferred++;
+            s_next = index;
+            return;
+        }
+
+        packet->tx.length = length;
+
+        if(!DRV_SCI_send(&packet->tx))
+        {
+            s_stats.noBuffer++;
+            s_next = index;
+            return;
+        }
+
+        s_credit -= cost;
+        s_streams[index].pending = 0U;
+        s_streams[index].sequence++;
+        s_stats.frames++;
+        s_stats.bytes += length;
+
+        s_next = (uint16_t)(index + 1U);
+
+        if(s_next >= s_streamCount)
+        {
+            s_next = 0U;
+        }
+    }
+}
+
+void APP_TELEM_getStats(APP_TELEM_Stats *stats)
+{
+    if(stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ * @file app_telem_frame.c
+ * @brief 遥测帧编码实现。
+ */
+
+#include "app_telem_frame.h"
+
+#include <stddef.h>
+
+/** 按 4 bit 查表计算 CRC16，表只占 16 个字。 */
+static const uint16_t s_crcTable[16] =
+{
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+};
+
+uint16_t APP_TELEM_FRAME_crc16(uint16_t crc, const uint16_t *data, uint16_t length)
+{
+    uint16_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        uint16_t byte = data[i] & 0xFFU;
+
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (byte >> 4)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ byte) & 0xFU]);
+    }
+
+    return crc;
+}
+
+uint16_t APP_TELEM_FRAME_cobsEncode(const uint16_t *src, uint16_t length, uint16_t *dst)
+{
+    uint16_t codeIndex = 0U;
+    uint16_t out = 1U;
+    uint16_t code = 1U;
+    uint16_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        uint16_t byte = src[i] & 0xFFU;
+
+        if(byte != 0U)
+        {
+            dst[out] = byte;
+            out++;
+            code++;
+        }
+
+        /* 遇到 0 或已满 254 个非 0 字节时结束当前块；输入末尾恰好满块时不再开新块。 */
+        if((byte == 0U) || ((code == 0xFFU) && ((i + 1U) < length)))
+        {
+            dst[codeIndex] = code;
+            codeIndex = out;
+            out++;
+            code = 1U;
+        }
+    }
+
+    dst[codeIndex] = code;
+
+    return out;
+}
+
+bool APP_TELEM_FRAME_cobsDecode(const uint16_t *src, uint16_t length,
+                                uint16_t *dst, uint16_t maxLength, uint16_t *decoded)
+{
+    uint16_t in = 0U;
+    uint16_t out = 0U;
+
+    while(in < length)
+    {
+        uint16_t code = src[in] & 0xFFU;
+        uint16_t i;
+
+        if((code == 0U) || ((uint16_t)(in + code) > length))
+        {
+            return false;
+        }
+
+        in++;
+
+        for(i = 1U; i < code; i++)
+        {
+            uint16_t byte = src[in] & 0xFFU;
+
+            if((byte == 0U) || (out >= maxLength))
+            {
+                return false;
+            }
+
+            dst[out] = byte;
+            out++;
+            in++;
+        }
+
+        /* 满块之后与最后一块之后没有隐含的 0。 */
+        if((code != 0xFFU) && (in < length))
+        {
+            if(out >= maxLength)
+            {
+                return false;
+            }
+
+            dst[out] = 0U;
+            out++;
+        }
+    }
+
+    *decoded = out;
+
+    return true;
+}
+
+uint16_t APP_TELEM_FRAME_encode(uint16_t *raw, uint16_t length,
+                                uint16_t *frame, uint16_t maxFrame)
+{
+    uint16_t crc;
+    uint16_t encoded;
+
+    if((raw == NULL) || (frame == NULL) || (maxFrame < APP_TELEM_FRAME_ENCODED_MAX(length)))
+    {
+        return 0U;
+    }
+
+    crc = APP_TELEM_FRAME_crc16(0xFFFFU, raw, length);
+    (void)APP_TELEM_FRAME_putU16(&raw[length], crc);
+
+    encoded = APP_TELEM_FRAME_cobsEncode(raw, length + APP_TELEM_FRAME_CRC_BYTES, frame);
+    frame[encoded] = APP_TELEM_FRAME_DELIMITER;
+
+    return encoded + 1U;
+}
+
+bool APP_TELEM_FRAME_decode(const uint16_t *frame, uint16_t frameLength,
+                            uint16_t *raw, uint16_t maxRaw, uint16_t *length)
+{
+    uint16_t decoded = 0U;
+    uint16_t body;
+
+    if((frame == NULL) || (raw == NULL) || (length == NULL) ||
+       !APP_TELEM_FRAME_cobsDecode(frame, frameLength, raw, maxRaw, &decoded) ||
+       (decoded < APP_TELEM_FRAME_CRC_BYTES))
+    {
+        return false;
+    }
+
+    body = decoded - APP_TELEM_FRAME_CRC_BYTES;
+
+    if(APP_TELEM_FRAME_crc16(0xFFFFU, raw, body) != APP_TELEM_FRAME_getU16(&raw[body]))
+    {
+        return false;
+    }
+
+    *length = body;
+
+    return true;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file app_telem_task.c
+ * @brief 遥测任务入口。
+ *
+ * 遥测与 XCP 协议共用 SCIA，二者在本任务中依次调用，DRV_SCI_send 只有一个生产者。
+ * CAN 命令与遥测也在本任务中处理，DRV_CAN 的任务侧接口只在这里调用。
+ */
+
+#include "app_telem.h"
+#include "app_xcp.h"
+#include "app_can.h"
+#include "app_stats.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief 遥测任务，每个 tick 处理一次 XCP 命令并推进遥测调度。
+ *
+ * 以 vTaskDelayUntil 保持固定节拍，任务偶尔被抢占时下一次调用补齐，流的周期不漂移。
+ * XCP 应答先于遥测入队，命令延迟不受遥测流量影响。
+ */
+void APP_TELEM_TASK(void *pvParameters)
+{
+    TickType_t wake = xTaskGetTickCount();
+
+    (void)pvParameters;
+
+    for(;;)
+    {
+        vTaskDelayUntil(&wake, 1U);
+        APP_XCP_service();
+        APP_TELEM_service(APP_STATS_now());
+        APP_CAN_service();
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file app_trace.c
+ * @brief 二进制跟踪缓冲区实现。
+ */
+
+#include "app_trace.h"
+#include "app_trace_freertos.h"
+
+#if ((APP_TRACE_CAPACITY & APP_TRACE_MASK) != 0U)
+#error "APP_TRACE_CAPACITY 必须为 2 的幂。"
+#endif
+
+/** 缓冲区放在 RAMGS0，与 .bss 分开，便于按固定地址导出。 */
+#pragma DATA_SECTION(APP_TRACE_buffer, "ramgs0")
+APP_TRACE_Buffer APP_TRACE_buffer;
+
+/** 内核钩子在每次任务切换时调用，放在 RAM 中执行以避开闪存等待周期。 */
+#pragma CODE_SECTION(APP_TRACE_kernelEvent, "hotpath")
+
+void APP_TRACE_init(void)
+{
+    uint16_t index;
+
+    APP_TRACE_buffer.enabled   = 0U;
+    APP_TRACE_buffer.magic     = APP_TRACE_MAGIC;
+    APP_TRACE_buffer.version   = APP_TRACE_VERSION;
+    APP_TRACE_buffer.capacity  = APP_TRACE_CAPACITY;
+    APP_TRACE_buffer.sysclkMHz = (uint16_t)(DEVICE_SYSCLK_FREQ / 1000000UL);
+    APP_TRACE_buffer.sequence  = 0U;
+    APP_TRACE_buffer.reserved  = 0U;
+
+    for(index = 0U; index < APP_TRACE_CAPACITY; index++)
+    {
+        APP_TRACE_buffer.records[index].id        = 0U;
+        APP_TRACE_buffer.records[index].arg       = 0U;
+        APP_TRACE_buffer.records[index].timestamp = 0U;
+    }
+
+    APP_TRACE_buffer.enabled = 1U;
+}
+
+void APP_TRACE_setEnabled(bool enabled)
+{
+    APP_TRACE_buffer.enabled = enabled ? 1U : 0U;
+}
+
+void APP_TRACE_kernelEvent(uint16_t id, uint16_t arg)
+{
+    APP_TRACE_record(id, arg);
+}
@@ -0,0 +1,1045 @@
+/**
+ * @file app_xcp.c
+ * @brief 轻量测量/标定协议实现。
+ *
+ * 任务侧与控制中断之间只有两处共享：暂存写入与 DAQ 样本队列。暂存写入以提交序号
+ * 交接，任务写好暂存数据后令 request = done + 1，中断在安全点发现二者相差 1 时写入
+ * 全部暂存数据并令 done = request；超时撤销时任务把 request 写回提交前的值，中断
+ * 只在相差 1 时动作，撤销与写入不会重复或交错。DAQ 样本队列为单生产者/单消费者，
+ * 槽位以 volatile 访问，与 app_event 相同。
+ */
+
+#include "app_xcp.h"
+
+#include <stddef.h>
+
+#include "drv_sci.h"
+
+#pragma CODE_SECTION(APP_XCP_safePoint, "hotpath")
+#pragma CODE_SECTION(APP_XCP_daqSample, "hotpath")
+#pragma CODE_SECTION(APP_XCP_readMemory, "hotpath")
+
+#define APP_XCP_DAQ_QUEUE_MASK      (APP_XCP_DAQ_QUEUE_DEPTH - 1U)
+
+/** 等待中的操作。 */
+#define APP_XCP_PENDING_NONE        (0U)
+#define APP_XCP_PENDING_COMMIT      (1U)
+#define APP_XCP_PENDING_SPACE       (2U)
+
+/**
+ * @brief 暂存的一项写入，数据位于 s_stageData[offset]。
+ */
+typedef struct
+{
+    uint32_t address;
+    uint16_t offset;
+    uint16_t words;
+} APP_XCP_StageEntry;
+
+/**
+ * @brief DAQ 条目。
+ */
+typedef struct
+{
+    uint32_t address;
+    uint16_t words;
+} APP_XCP_DaqEntry;
+
+/**
+ * @brief DAQ 列表，只在停止时由任务修改。
+ */
+typedef struct
+{
+    APP_XCP_DaqEntry entries[APP_XCP_DAQ_ENTRIES];
+    uint16_t         entryCount;
+    uint16_t         words;             /**< 全部条目的字数。 */
+    uint16_t         prescaler;         /**< 每 prescaler 次采样调用记录一次。 */
+    uint16_t         countdown;
+    uint16_t         sequence;          /**< 到期计数，队列满丢弃的样本同样计入。 */
+    uint16_t         running;
+} APP_XCP_DaqList;
+
+/**
+ * @brief DAQ 样本。
+ */
+typedef struct
+{
+    uint16_t list;
+    uint16_t sequence;
+    uint16_t words;
+    uint32_t timestamp;
+    uint16_t data[APP_XCP_DAQ_MAX_WORDS];
+} APP_XCP_DaqSample;
+
+/**
+ * @brief 发送缓冲区。
+ */
+typedef struct
+{
+    DRV_SCI_TxBuffer tx;
+    uint16_t         frame[APP_XCP_FRAME_MAX];
+} APP_XCP_Packet;
+
+static const APP_XCP_Symbol *s_symbols = NULL;
+static uint16_t s_symbolCount = 0U;
+
+static volatile uint16_t *s_base = NULL;
+static uint32_t s_windowWords = 0U;
+
+static const APP_XCP_Space *s_spaces[APP_XCP_MAX_SPACES];
+
+/** 接收中的帧。 */
+static uint16_t s_rxFrame[APP_XCP_FRAME_MAX];
+static uint16_t s_rxLength = 0U;
+static bool     s_rxDiscard = false;
+
+/** 解码后的请求与待发送的应答，均在末尾留出 CRC。 */
+static uint16_t s_request[APP_XCP_RAW_MAX + APP_TELEM_FRAME_CRC_BYTES];
+static uint16_t s_requestLength = 0U;
+static uint16_t s_response[APP_XCP_RAW_MAX + APP_TELEM_FRAME_CRC_BYTES];
+static uint16_t s_responseLength = 0U;
+static bool     s_responseReady = false;
+
+static uint16_t s_pending = APP_XCP_PENDING_NONE;
+static uint16_t s_pendingTicks = 0U;
+static uint16_t s_pendingCounter = 0U;
+static uint16_t s_pendingWords = 0U;
+static bool     s_pendingWrite = false;
+static const APP_XCP_Space *s_pendingSpace = NULL;
+static uint16_t s_spaceData[APP_XCP_MAX_WORDS];
+
+static volatile APP_XCP_StageEntry s_stageEntries[APP_XCP_STAGE_ENTRIES];
+static volatile uint16_t s_stageData[APP_XCP_STAGE_WORDS];
+static volatile uint16_t s_stageCount = 0U;
+static uint16_t s_stageWords = 0U;
+static volatile uint16_t s_commitRequest = 0U;
+static volatile uint16_t s_commitDone = 0U;
+static volatile uint32_t s_safePoints = 0U;
+
+static volatile APP_XCP_DaqList s_daq[APP_XCP_DAQ_LISTS];
+static volatile APP_XCP_DaqSample s_daqQueue[APP_XCP_DAQ_QUEUE_DEPTH];
+static volatile uint16_t s_daqHead = 0U;
+static volatile uint16_t s_daqTail = 0U;
+static volatile uint32_t s_daqOverruns = 0U;
+
+static APP_XCP_Packet s_packets[APP_XCP_PACKET_COUNT];
+
+static APP_XCP_Stats s_stats;
+
+static uint16_t APP_XCP_typeWords(uint16_t type)
+{
+    return ((type == (uint16_t)APP_XCP_TYPE_INT16) || (type == (uint16_t)APP_XCP_TYPE_UINT16)) ? 1U : 2U;
+}
+
+static volatile uint16_t *APP_XCP_pointer(uint32_t address)
+{
+    if(s_base != NULL)
+    {
+        return &s_base[address];
+    }
+
+    return (volatile uint16_t *)(uintptr_t)address;
+}
+
+static uint32_t APP_XCP_addressOf(const volatile void *pointer)
+{
+    if(s_base != NULL)
+    {
+        return (uint32_t)((const volatile uint16_t *)pointer - s_base);
+    }
+
+    return (uint32_t)(uintptr_t)pointer;
+}
+
+static bool APP_XCP_inWindow(uint32_t address, uint16_t words)
+{
+    return (s_base == NULL) || ((address < s_windowWords) && (words <= (s_windowWords - address)));
+}
+
+/**
+ * @brief 读取内存，偶地址上的双字以一次 32 bit 访问读取，不会读到半新半旧的 float32。
+ */
+static void APP_XCP_readMemory(uint32_t address, volatile uint16_t *dst, uint16_t words)
+{
+    volatile uint16_t *src = APP_XCP_pointer(address);
+    uint16_t i = 0U;
+
+    while(i < words)
+    {
+        if((((address + i) & 1U) == 0U) && ((i + 1U) < words))
+        {
+            uint32_t value = *(volatile uint32_t *)&src[i];
+
+            dst[i]      = (uint16_t)(value & 0xFFFFU);
+            dst[i + 1U] = (uint16_t)(value >> 16);
+            i += 2U;
+        }
+        else
+        {
+            dst[i] = src[i];
+            i++;
+        }
+    }
+}
+
+static void APP_XCP_writeMemory(uint32_t address, const volatile uint16_t *src, uint16_t words)
+{
+    volatile uint16_t *dst = APP_XCP_pointer(address);
+    uint16_t i = 0U;
+
+    while(i < words)
+    {
+        if((((address + i) & 1U) == 0U) && ((i + 1U) < words))
+        {
+            *(volatile uint32_t *)&dst[i] = (uint32_t)src[i] | ((uint32_t)src[i + 1U] << 16);
+            i += 2U;
+        }
+        else
+        {
+            dst[i] = src[i];
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief 写入范围须整体落在一个可写符号之内。
+ */
+static bool APP_XCP_isWritable(uint32_t address, uint16_t words)
+{
+    uint16_t i;
+
+    for(i = 0U; i < s_symbolCount; i++)
+    {
+        const APP_XCP_Symbol *symbol = &s_symbols[i];
+        uint32_t start;
+
+        if((symbol->flags & APP_XCP_SYM_WRITABLE) == 0U)
+        {
+            continue;
+        }
+
+        start = APP_XCP_addressOf(symbol->address);
+
+        if((address >= start) &&
+           ((address + words) <= (start + APP_XCP_typeWords(symbol->type))))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void APP_XCP_respond(uint16_t length)
+{
+    s_response[0]    = APP_XCP_PID_RES;
+    s_response[1]    = s_request[1];
+    s_responseLength = length;
+    s_responseReady  = true;
+}
+
+static void APP_XCP_error(uint16_t code)
+{
+    s_response[0]    = APP_XCP_PID_ERR;
+    s_response[1]    = s_request[1];
+    s_response[2]    = code;
+    s_responseLength = 3U;
+    s_responseReady  = true;
+    s_stats.errors++;
+}
+
+static APP_XCP_Packet *APP_XCP_findFreePacket(void)
+{
+    uint16_t i;
+
+    for(i = 0U; i < APP_XCP_PACKET_COUNT; i++)
+    {
+        if(s_packets[i].tx.busy == 0U)
+        {
+            return &s_packets[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 编码并发送一个原始包，raw 末尾须留出 CRC。
+ */
+static bool APP_XCP_send(uint16_t *raw, uint16_t length)
+{
+    APP_XCP_Packet *packet = APP_XCP_findFreePacket();
+
+    if(packet == NULL)
+    {
+        return false;
+    }
+
+    packet->tx.length = APP_TELEM_FRAME_encode(raw, length, packet->frame, APP_XCP_FRAME_MAX);
+
+    return (packet->tx.length != 0U) && DRV_SCI_send(&packet->tx);
+}
+
+/**
+ * @brief 解析 [字数][扩展][地址 4B] 并检查范围。
+ */
+static bool APP_XCP_parseAccess(uint16_t *words, uint16_t *extension, uint32_t *address)
+{
+    if(s_requestLength < 8U)
+    {
+        APP_XCP_error(APP_XCP_ERR_CMD_SYNTAX);
+        return false;
+    }
+
+    *words     = s_request[2];
+    *extension = s_request[3];
+    *address   = APP_TELEM_FRAME_getU32(&s_request[4]);
+
+    if((*words == 0U) || (*words > APP_XCP_MAX_WORDS) || (*extension >= APP_XCP_MAX_SPACES) ||
+       ((*extension == 0U) && !APP_XCP_inWindow(*address, *words)))
+    {
+        APP_XCP_error(APP_XCP_ERR_OUT_OF_RANGE);
+        return false;
+    }
+
+    if((*extension != 0U) && (s_spaces[*extension] == NULL))
+    {
+        APP_XCP_error(APP_XCP_ERR_ACCESS_DENIED);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 开始一次异步地址空间操作，完成后由 APP_XCP_pollPending 应答。
+ */
+static void APP_XCP_startSpace(uint16_t extension, bool write, uint32_t address, uint16_t words)
+{
+    const APP_XCP_Space *space = s_spaces[extension];
+
+    if(!space->start(write, address, s_spaceData, words))
+    {
+        APP_XCP_error(APP_XCP_ERR_CMD_BUSY);
+        return;
+    }
+
+    s_pending        = APP_XCP_PENDING_SPACE;
+    s_pendingSpace   = space;
+    s_pendingWrite   = write;
+    s_pendingWords   = words;
+    s_pendingTicks   = 0U;
+}
+
+/**
+ * @brief 请求在安全点写入暂存数据。
+ */
+static void APP_XCP_commit(void)
+{
+    if(s_stageCount == 0U)
+    {
+        APP_XCP_respond(2U);
+        return;
+    }
+
+    s_pendingCounter = s_commitDone;
+    s_pending        = APP_XCP_PENDING_COMMIT;
+    s_pendingTicks   = 0U;
+    s_commitRequest  = s_pendingCounter + 1U;
+}
+
+static void APP_XCP_clearStage(void)
+{
+    s_stageCount = 0U;
+    s_stageWords = 0U;
+}
+
+/**
+ * @brief 暂存一项写入。
+ */
+static bool APP_XCP_stage(uint32_t address, uint16_t words)
+{
+    uint16_t index = s_stageCount;
+    uint16_t i;
+
+    if(!APP_XCP_isWritable(address, words))
+    {
+        APP_XCP_error(APP_XCP_ERR_WRITE_PROTECTED);
+        return false;
+    }
+
+    if((index >= APP_XCP_STAGE_ENTRIES) || ((s_stageWords + words) > APP_XCP_STAGE_WORDS))
+    {
+        APP_XCP_error(APP_XCP_ERR_MEMORY_OVERFLOW);
+        return false;
+    }
+
+    for(i = 0U; i < words; i++)
+    {
+        s_stageData[s_stageWords + i] = APP_TELEM_FRAME_getU16(&s_request[8U + (2U * i)]);
+    }
+
+    s_stageEntries[index].address = address;
+    s_stageEntries[index].offset  = s_stageWords;
+    s_stageEntries[index].words   = words;
+    s_stageWords += words;
+    s_stageCount  = index + 1U;
+
+    return true;
+}
+
+static void APP_XCP_handleDownload(bool commit)
+{
+    uint16_t words;
+    uint16_t extension;
+    uint32_t address;
+    uint16_t i;
+
+    if(!APP_XCP_parseAccess(&words, &extension, &address))
+    {
+        return;
+    }
+
+    if(s_requestLength < (8U + (2U * words)))
+    {
+        APP_XCP_error(APP_XCP_ERR_CMD_SYNTAX);
+        return;
+    }
+
+    if(extension != 0U)
+    {
+        /* 异步空间没有安全点，只接受立即写入。 */
+        if(!commit)
+        {
+            APP_XCP_error(APP_XCP_ERR_ACCESS_DENIED);
+            return;
+        }
+
+        for(i = 0U; i < words; i++)
+        {
+            s_spaceData[i] = APP_TELEM_FRAME_getU16(&s_request[8U + (2U * i)]);
+        }
+
+        APP_XCP_startSpace(extension, true, address, words);
+        return;
+    }
+
+    if(!APP_XCP_stage(address, words))
+    {
+        return;
+    }
+
+    if(commit)
+    {
+        APP_XCP_commit();
+    }
+    else
+    {
+        APP_XCP_respond(2U);
+    }
+}
+
+static void APP_XCP_handleUpload(void)
+{
+    uint16_t words;
+    uint16_t extension;
+    uint32_t address;
+    uint16_t i;
+
+    if(!APP_XCP_parseAccess(&words, &extension, &address))
+    {
+        return;
+    }
+
+    if(extension != 0U)
+    {
+        APP_XCP_startSpace(extension, false, address, words);
+        return;
+    }
+
+    APP_XCP_readMemory(address, s_spaceData, words);
+
+    for(i = 0U; i < words; i++)
+    {
+        (void)APP_TELEM_FRAME_putU16(&s_response[2U + (2U * i)], s_spaceData[i]);
+    }
+
+    APP_XCP_respond(2U + (2U * words));
+}
+
+static void APP_XCP_handleGetSymbol(void)
+{
+    const APP_XCP_Symbol *symbol;
+    uint16_t index;
+    uint16_t length = 0U;
+
+    if(s_requestLength < 5U)
+    {
+        APP_XCP_error(APP_XCP_ERR_CMD_SYNTAX);
+        return;
+    }
+
+    index = APP_TELEM_FRAME_getU16(&s_request[3]);
+
+    if(index >= s_symbolCount)
+    {
+        APP_XCP_error(APP_XCP_ERR_OUT_OF_RANGE);
+        return;
+    }
+
+    symbol = &s_symbols[index];
+
+    /* [类型][标志][字数][名称长度][地址 4B][名称]。 */
+    s_response[2] = symbol->type;
+    s_response[3] = symbol->flags & 0xFFU;
+    s_response[4] = APP_XCP_typeWords(symbol->type);
+    (void)APP_TELEM_FRAME_putU32(&s_response[6], APP_XCP_addressOf(symbol->address));
+
+    while((length < APP_XCP_NAME_MAX) && (symbol->name[length] != '\0'))
+    {
+        s_response[10U + length] = (uint16_t)symbol->name[length] & 0xFFU;
+        length++;
+    }
+
+    s_response[5] = length;
+    APP_XCP_respond(10U + length);
+}
+
+static void APP_XCP_handleDaq(uint16_t command)
+{
+    volatile APP_XCP_DaqList *list;
+
+    if((s_requestLength < 3U) || (s_request[2] >= APP_XCP_DAQ_LISTS))
+    {
+        APP_XCP_error(APP_XCP_ERR_OUT_OF_RANGE);
+        return;
+    }
+
+    list = &s_daq[s_request[2]];
+
+    if(command == APP_XCP_CMD_START_STOP_DAQ_LIST)
+    {
+        if((s_requestLength < 4U) || ((s_request[3] != 0U) && (list->entryCount == 0U)))
+        {
+            APP_XCP_error(APP_XCP_ERR_DAQ_CONFIG);
+            return;
+        }
+
+        if((s_request[3] != 0U) && (list->running == 0U))
+        {
+            list->countdown = 0U;
+            list->sequence  = 0U;
+        }
+
+        list->running = (s_request[3] != 0U) ? 1U : 0U;
+        APP_XCP_respond(2U);
+        return;
+    }
+
+    /* 列表运行期间中断在读取配置。 */
+    if(list->running != 0U)
+    {
+        APP_XCP_error(APP_XCP_ERR_DAQ_ACTIVE);
+        return;
+    }
+
+    if(command == APP_XCP_CMD_CLEAR_DAQ_LIST)
+    {
+        list->entryCount = 0U;
+        list->words      = 0U;
+        list->prescaler  = 1U;
+    }
+    else if(command == APP_XCP_CMD_SET_DAQ_LIST_MODE)
+    {
+        uint16_t prescaler;
+
+        if(s_requestLength < 5U)
+        {
+            APP_XCP_error(APP_XCP_ERR_CMD_SYNTAX);
+            return;
+        }
+
+        prescaler = APP_TELEM_FRAME_getU16(&s_request[3]);
+
+        if(prescaler == 0U)
+        {
+            APP_XCP_error(APP_XCP_ERR_OUT_OF_RANGE);
+            return;
+        }
+
+        list->prescaler = prescaler;
+    }
+    else
+    {
+        uint16_t words;
+        uint32_t address;
+
+        if(s_requestLength < 8U)
+        {
+            APP_XCP_error(APP_XCP_ERR_CMD_SYNTAX);
+            return;
+        }
+
+        words   = s_request[3];
+        address = APP_TELEM_FRAME_getU32(&s_request[4]);
+
+        if((words == 0U) || !APP_XCP_inWindow(address, words))
+        {
+            APP_XCP_error(APP_XCP_ERR_OUT_OF_RANGE);
+            return;
+        }
+
+        if((list->entryCount >= APP_XCP_DAQ_ENTRIES) || ((list->words + words) > APP_XCP_DAQ_MAX_WORDS))
+        {
+            APP_XCP_error(APP_XCP_ERR_MEMORY_OVERFLOW);
+            return;
+        }
+
+        list->entries[list->entryCount].address = address;
+        list->entries[list->entryCount].words   = words;
+        list->entryCount++;
+        list->words += words;
+    }
+
+    APP_XCP_respond(2U);
+}
+
+static void APP_XCP_stopAllDaq(void)
+{
+    uint16_t i;
+
+    for(i = 0U; i < APP_XCP_DAQ_LISTS; i++)
+    {
+        s_daq[i].running = 0U;
+    }
+}
+
+static void APP_XCP_handle(void)
+{
+    uint16_t command = s_request[0];
+
+    s_stats.commands++;
+
+    switch(command)
+    {
+        case APP_XCP_CMD_CONNECT:
+            /* [版本][最大字数][DAQ 列表数][条目数][符号数 2B][空间掩码]。 */
+            {
+                uint16_t mask = 1U;
+                uint16_t i;
+
+                for(i = 1U; i < APP_XCP_MAX_SPACES; i++)
+                {
+                    mask |= (s_spaces[i] != NULL) ? (uint16_t)(1U << i) : 0U;
+                }
+
+                s_response[2] = APP_XCP_VERSION;
+                s_response[3] = APP_XCP_MAX_WORDS;
+                s_response[4] = APP_XCP_DAQ_LISTS;
+                s_response[5] = APP_XCP_DAQ_ENTRIES;
+                (void)APP_TELEM_FRAME_putU16(&s_response[6], s_symbolCount);
+                s_response[8] = mask;
+                APP_XCP_respond(9U);
+            }
+            break;
+
+        case APP_XCP_CMD_DISCONNECT:
+            APP_XCP_stopAllDaq();
+            APP_XCP_clearStage();
+            APP_XCP_respond(2U);
+            break;
+
+        case APP_XCP_CMD_GET_STATUS:
+            /* [运行中的 DAQ 列表掩码][暂存条目数][安全点计数 4B][DAQ 丢弃计数 4B]。 */
+            {
+                uint16_t mask = 0U;
+                uint16_t i;
+
+                for(i = 0U; i < APP_XCP_DAQ_LISTS; i++)
+                {
+                    mask |= (s_daq[i].running != 0U) ? (uint16_t)(1U << i) : 0U;
+                }
+
+                s_response[2] = mask;
+                s_response[3] = s_stageCount;
+                (void)APP_TELEM_FRAME_putU32(&s_response[4], s_safePoints);
+                (void)APP_TELEM_FRAME_putU32(&s_response[8], s_daqOverruns);
+                APP_XCP_respond(12U);
+            }
+            break;
+
+        case APP_XCP_CMD_SHORT_UPLOAD:
+            APP_XCP_handleUpload();
+            break;
+
+        case APP_XCP_CMD_DOWNLOAD:
+            APP_XCP_handleDownload(false);
+            break;
+
+        case APP_XCP_CMD_SHORT_DOWNLOAD:
+            APP_XCP_handleDownload(true);
+            break;
+
+        case APP_XCP_CMD_USER:
+            if((s_requestLength >= 3U) && (s_request[2] == APP_XCP_USER_GET_SYMBOL))
+            {
+                APP_XCP_handleGetSymbol();
+            }
+            else if((s_requestLength >= 3U) && (s_request[2] == APP_XCP_USER_COMMIT))
+            {
+                APP_XCP_commit();
+            }
+            else
+            {
+                APP_XCP_error(APP_XCP_ERR_CMD_UNKNOWN);
+            }
+            break;
+
+        case APP_XCP_CMD_CLEAR_DAQ_LIST:
+        case APP_XCP_CMD_WRITE_DAQ:
+        case APP_XCP_CMD_SET_DAQ_LIST_MODE:
+        case APP_XCP_CMD_START_STOP_DAQ_LIST:
+            APP_XCP_handleDaq(command);
+            break;
+
+        default:
+            APP_XCP_error(APP_XCP_ERR_CMD_UNKNOWN);
+            break;
+    }
+}
+
+/**
+ * @brief 检查等待中的提交或异步空间操作。
+ */
+static void APP_XCP_pollPending(void)
+{
+    s_pendingTicks++;
+
+    if(s_pending == APP_XCP_PENDING_COMMIT)
+    {
+        if(s_commitDone == (uint16_t)(s_pendingCounter + 1U))
+        {
+            s_stats.commits++;
+            APP_XCP_clearStage();
+            s_pending = APP_XCP_PENDING_NONE;
+            APP_XCP_respond(2U);
+        }
+        else if(s_pendingTicks >= APP_XCP_TIMEOUT_TICKS)
+        {
+            /* 撤销请求；若中断恰好已经写入，done 已等于请求值，按成功应答。 */
+            s_commitRequest = s_pendingCounter;
+            s_pending = APP_XCP_PENDING_NONE;
+
+            if(s_commitDone == (uint16_t)(s_pendingCounter + 1U))
+            {
+                s_stats.commits++;
+                APP_XCP_clearStage();
+                APP_XCP_respond(2U);
+            }
+            else
+            {
+                APP_XCP_clearStage();
+                APP_XCP_error(APP_XCP_ERR_RESOURCE_UNAVAILABLE);
+            }
+        }
+    }
+    else
+    {
+        uint16_t status = s_pendingSpace->poll(s_spaceData, s_pendingWords);
+
+        if(status == APP_XCP_SPACE_BUSY)
+        {
+            if(s_pendingTicks < APP_XCP_TIMEOUT_TICKS)
+            {
+                return;
+            }
+
+            status = APP_XCP_SPACE_ERROR;
+        }
+
+        s_pending = APP_XCP_PENDING_NONE;
+
+        if(status != APP_XCP_SPACE_DONE)
+        {
+            APP_XCP_error(APP_XCP_ERR_RESOURCE_UNAVAILABLE);
+        }
+        else if(s_pendingWrite)
+        {
+            APP_XCP_respond(2U);
+        }
+        else
+        {
+            uint16_t i;
+
+            for(i = 0U; i < s_pendingWords; i++)
+            {
+                (void)APP_TELEM_FRAME_putU16(&s_response[2U + (2U * i)], s_spaceData[i]);
+            }
+
+            APP_XCP_respond(2U + (2U * s_pendingWords));
+        }
+    }
+}
+
+/**
+ * @brief 从接收缓冲区取出下一个有效请求。
+ */
+static bool APP_XCP_receive(void)
+{
+    uint16_t byte;
+
+    while(DRV_SCI_read(&byte, 1U) == 1U)
+    {
+        if(byte == APP_TELEM_FRAME_DELIMITER)
+        {
+            bool valid = !s_rxDiscard && (s_rxLength != 0U);
+            uint16_t length = 0U;
+
+            if(valid)
+            {
+                valid = APP_TELEM_FRAME_decode(s_rxFrame, s_rxLength, s_request,
+                                               APP_XCP_RAW_MAX + APP_TELEM_FRAME_CRC_BYTES, &length) &&
+                        (length >= 2U);
+
+                if(!valid)
+                {
+                    s_stats.badFrames++;
+                }
+            }
+
+            s_rxLength  = 0U;
+            s_rxDiscard = false;
+
+            if(valid)
+            {
+                s_requestLength = length;
+                return true;
+            }
+
+            continue;
+        }
+
+        if(s_rxLength >= APP_XCP_FRAME_MAX)
+        {
+            if(!s_rxDiscard)
+            {
+                s_stats.badFrames++;
+            }
+
+            s_rxDiscard = true;
+            continue;
+        }
+
+        if(!s_rxDiscard)
+        {
+            s_rxFrame[s_rxLength] = byte;
+            s_rxLength++;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 发送队列中的 DAQ 样本，缓冲区不足时留到下一个 tick。
+ */
+static void APP_XCP_sendDaq(void)
+{
+    static uint16_t raw[APP_XCP_RAW_MAX + APP_TELEM_FRAME_CRC_BYTES];
+    uint16_t tail = s_daqTail;
+
+    while(tail != s_daqHead)
+    {
+        volatile const APP_XCP_DaqSample *sample = &s_daqQueue[tail & APP_XCP_DAQ_QUEUE_MASK];
+        uint16_t words = sample->words;
+        uint16_t i;
+
+        raw[0] = APP_XCP_PID_DAQ + sample->list;
+        raw[1] = sample->sequence & 0xFFU;
+        (void)APP_TELEM_FRAME_putU32(&raw[2], sample->timestamp);
+
+        for(i = 0U; i < words; i++)
+        {
+            (void)APP_TELEM_FRAME_putU16(&raw[6U + (2U * i)], sample->data[i]);
+        }
+
+        if(!APP_XCP_send(raw, 6U + (2U * words)))
+        {
+            break;
+        }
+
+        s_stats.daqPackets++;
+        tail++;
+        s_daqTail = tail;
+    }
+}
+
+void APP_XCP_init(const APP_XCP_Symbol *symbols, uint16_t count)
+{
+    uint16_t i;
+
+    s_symbols     = symbols;
+    s_symbolCount = (symbols == NULL) ? 0U : count;
+
+    for(i = 0U; i < APP_XCP_MAX_SPACES; i++)
+    {
+        s_spaces[i] = NULL;
+    }
+
+    for(i = 0U; i < APP_XCP_DAQ_LISTS; i++)
+    {
+        s_daq[i].running    = 0U;
+        s_daq[i].entryCount = 0U;
+        s_daq[i].words      = 0U;
+        s_daq[i].prescaler  = 1U;
+    }
+
+    for(i = 0U; i < APP_XCP_PACKET_COUNT; i++)
+    {
+        s_packets[i].tx.data   = s_packets[i].frame;
+        s_packets[i].tx.length = 0U;
+        s_packets[i].tx.busy   = 0U;
+    }
+
+    APP_XCP_clearStage();
+    s_commitRequest = s_commitDone;
+    s_pending       = APP_XCP_PENDING_NONE;
+    s_responseReady = false;
+    s_rxLength      = 0U;
+    s_rxDiscard     = false;
+    s_daqTail       = s_daqHead;
+}
+
+void APP_XCP_setMemoryWindow(volatile void *base, uint32_t words)
+{
+    s_base        = (volatile uint16_t *)base;
+    s_windowWords = words;
+}
+
+bool APP_XCP_setSpace(uint16_t extension, const APP_XCP_Space *space)
+{
+    if((extension == 0U) || (extension >= APP_XCP_MAX_SPACES) ||
+       (space == NULL) || (space->start == NULL) || (space->poll == NULL))
+    {
+        return false;
+    }
+
+    s_spaces[extension] = space;
+
+    return true;
+}
+
+void APP_XCP_service(void)
+{
+    if(s_pending != APP_XCP_PENDING_NONE)
+    {
+        APP_XCP_pollPending();
+    }
+
+    /* 一次处理一个命令，应答发出后才取下一个，等待中的命令留在接收缓冲区。 */
+    for(;;)
+    {
+        if(s_responseReady)
+        {
+            if(!APP_XCP_send(s_response, s_responseLength))
+            {
+                break;
+            }
+
+            s_responseReady = false;
+        }
+
+        if((s_pending != APP_XCP_PENDING_NONE) || !APP_XCP_receive())
+        {
+            break;
+        }
+
+        APP_XCP_handle();
+    }
+
+    APP_XCP_sendDaq();
+}
+
+void APP_XCP_safePoint(void)
+{
+    uint16_t request = s_commitRequest;
+
+    if((uint16_t)(request - s_commitDone) == 1U)
+    {
+        uint16_t count = s_stageCount;
+        uint16_t i;
+
+        for(i = 0U; i < count; i++)
+        {
+            volatile const APP_XCP_StageEntry *entry = &s_stageEntries[i];
+
+            APP_XCP_writeMemory(entry->address, &s_stageData[entry->offset], entry->words);
+        }
+
+        s_commitDone = request;
+    }
+
+    s_safePoints++;
+}
+
+void APP_XCP_daqSample(uint32_t timestamp)
+{
+    uint16_t index;
+
+    for(index = 0U; index < APP_XCP_DAQ_LISTS; index++)
+    {
+        volatile APP_XCP_DaqList *list = &s_daq[index];
+        volatile APP_XCP_DaqSample *sample;
+        uint16_t head;
+        uint16_t offset = 0U;
+        uint16_t i;
+
+        if(list->running == 0U)
+        {
+            continue;
+        }
+
+        if(list->countdown != 0U)
+        {
+            list->countdown--;
+            continue;
+        }
+
+        list->countdown = list->prescaler - 1U;
+        list->sequence++;
+
+        head = s_daqHead;
+
+        if((uint16_t)(head - s_daqTail) >= APP_XCP_DAQ_QUEUE_DEPTH)
+        {
+            s_daqOverruns++;
+            continue;
+        }
+
+        sample = &s_daqQueue[head & APP_XCP_DAQ_QUEUE_MASK];
+        sample->list      = index;
+        sample->sequence  = list->sequence - 1U;
+        sample->words     = list->words;
+        sample->timestamp = timestamp;
+
+        for(i = 0U; i < list->entryCount; i++)
+        {
+            APP_XCP_readMemory(list->entries[i].address, &sample->data[offset], list->entries[i].words);
+            offset += list->entries[i].words;
+        }
+
+        s_daqHead = head + 1U;
+    }
+}
+
+void APP_XCP_getStats(APP_XCP_Stats *stats)
+{
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    *stats = s_stats;
+    stats->daqOverruns = s_daqOverruns;
+}
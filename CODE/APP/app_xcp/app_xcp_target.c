@@ -0,0 +1,101 @@
+/**
+ * @file app_xcp_target.c
+ * @brief 目标板的 XCP 符号表与 DRV8316 寄存器地址空间。
+ *
+ * 符号表中的地址由链接器在构建时解析，主机连接后以 GET_SYMBOL 读取，新增可标定
+ * 变量只需在表中加一行。地址扩展 1 为 0 号 DRV8316 的寄存器，读写经
+ * APP_DRV8316_submitRegOps 交给维护任务执行，完成后应答。
+ *
+ * cla.* 命令项指向 CPU 侧的暂存副本 APP_CLA_command，安全点写入后由同一次控制中断的
+ * 快速时隙以 APP_CLA_publish 整体发布，CLA 任务 1 在周期开始时按序号锁存，同一次提交
+ * 的增益与给定不会被 CLA 拆开读取。
+ */
+
+#include "app_xcp.h"
+#include "app_cla.h"
+#include "app_drv8316.h"
+
+/** DRV8316 寄存器地址空间的地址扩展。 */
+#define APP_XCP_TARGET_EXT_DRV8316      (1U)
+
+/** DRV8316 寄存器地址范围。 */
+#define APP_XCP_TARGET_DRV8316_REGS     (32U)
+
+#define APP_XCP_TARGET_RW               (APP_XCP_SYM_WRITABLE)
+#define APP_XCP_TARGET_RO               (0U)
+
+static const APP_XCP_Symbol s_symbols[] =
+{
+    { "cla.enable",     &APP_CLA_command.enable,   APP_XCP_TYPE_UINT16,  APP_XCP_TARGET_RW },
+    { "cla.idRef",      &APP_CLA_command.idRef,    APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RW },
+    { "cla.iqRef",      &APP_CLA_command.iqRef,    APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RW },
+    { "cla.kp",         &APP_CLA_command.kp,       APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RW },
+    { "cla.ki",         &APP_CLA_command.ki,       APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RW },
+    { "cla.vLimitPu",   &APP_CLA_command.vLimitPu, APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RW },
+    { "cla.count",      &APP_CLA_status.count,     APP_XCP_TYPE_UINT32,  APP_XCP_TARGET_RO },
+    { "cla.ia",         &APP_CLA_status.ia,        APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.ib",         &APP_CLA_status.ib,        APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.id",         &APP_CLA_status.id,        APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.iq",         &APP_CLA_status.iq,        APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.vd",         &APP_CLA_status.vd,        APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.vq",         &APP_CLA_status.vq,        APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.vdc",        &APP_CLA_status.vdc,       APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO },
+    { "cla.angle",      &APP_CLA_status.angle,     APP_XCP_TYPE_FLOAT32, APP_XCP_TARGET_RO }
+};
+
+static APP_DRV8316_RegToken s_tokens[APP_XCP_MAX_WORDS];
+
+static bool APP_XCP_TARGET_drv8316Start(bool write, uint32_t address, uint16_t *data, uint16_t words)
+{
+    APP_DRV8316_RegOp ops[APP_XCP_MAX_WORDS];
+    uint16_t i;
+
+    if((words > APP_XCP_MAX_WORDS) || (address >= APP_XCP_TARGET_DRV8316_REGS) ||
+       (words > (APP_XCP_TARGET_DRV8316_REGS - address)))
+    {
+        return false;
+    }
+
+    for(i = 0U; i < words; i++)
+    {
+        ops[i].type    = write ? APP_DRV8316_REG_OP_WRITE : APP_DRV8316_REG_OP_READ;
+        ops[i].address = (uint16_t)address + i;
+        ops[i].data    = write ? (data[i] & 0xFFU) : 0U;
+    }
+
+    return APP_DRV8316_submitRegOps(0U, ops, words, s_tokens);
+}
+
+static uint16_t APP_XCP_TARGET_drv8316Poll(uint16_t *data, uint16_t words)
+{
+    uint16_t i;
+
+    for(i = 0U; i < words; i++)
+    {
+        APP_DRV8316_RegStatus status = APP_DRV8316_getRegOpResult(s_tokens[i], &data[i]);
+
+        if(status == APP_DRV8316_REG_STATUS_PENDING)
+        {
+            return APP_XCP_SPACE_BUSY;
+        }
+
+        if(status != APP_DRV8316_REG_STATUS_DONE)
+        {
+            return APP_XCP_SPACE_ERROR;
+        }
+    }
+
+    return APP_XCP_SPACE_DONE;
+}
+
+static const APP_XCP_Space s_drv8316Space =
+{
+    APP_XCP_TARGET_drv8316Start,
+    APP_XCP_TARGET_drv8316Poll
+};
+
+void APP_XCP_TARGET_init(void)
+{
+    APP_XCP_init(s_symbols, (uint16_t)(sizeof(s_symbols) / sizeof(s_symbols[0])));
+    (void)APP_XCP_setSpace(APP_XCP_TARGET_EXT_DRV8316, &s_drv8316Space);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file app_cla.h
+ * @brief CLA 电流环接口。
+ *
+ * 电流环在 CLA 任务 1 中运行，由 ADCA INT1（ePWM1 周期点触发的采样序列结束）直接
+ * 启动，不经过 CPU 中断：读取 ADC 结果、执行 app_cla_loop.h 中的计算，使能时写
+ * ePWM1~3 的 CMPA。
+ *
+ * CPU 与 CLA 之间只经消息 RAM 交换数据：
+ *  - APP_CLA_command 为 CPU 侧的命令暂存副本，设置函数与标定写入只修改它；
+ *    APP_CLA_publish 在控制中断中把它整体写入 CpuToCla1MsgRAM 中的 APP_CLA_commandBlock，
+ *    CLA 任务 1 在周期开始时按序号锁存完整的一份，同一次发布的增益与给定在同一个
+ *    周期生效，发布未完成时沿用上一份；
+ *  - APP_CLA_status 位于 Cla1ToCpuMsgRAM，CLA 写、CPU 读。CLA 在数据 RAM 中算完一个
+ *    周期后，以 volatile 访问依次写奇数 count、全部字段与偶数 count；直接读取时多个
+ *    字段之间可能相差一个控制周期，APP_CLA_getStatus 读取一致的副本。
+ *
+ * 存储划分：CLA 程序（Cla1Prog）在 RAMLS7 运行，CLA 数据（.bss_cla、.const_cla 与
+ * 暂存区）在 RAMLS6，与 FPUmathTables 共用，CPU 对 RAMLS6 的访问不受影响。FLASH
+ * 构建中 Cla1Prog 与 .const_cla 由 APP_CLA_init 从闪存复制。
+ *
+ * 闭环使能后 CMPA 由 CLA 写入，CPU 不应再调用 DRV_EPWM_setDutyCycle。
+ *
+ * 电角度来源为 APP_CLA_ANGLE_ENCODER 时，CLA 任务 1 在周期开始时直接读 eQEP1 的
+ * QPOSCNT，以 DRV_EQEP_angleFromPosition 换算，与 ADC 采样同一时刻，不经过 C28x 侧
+ * 的 DRV_EQEP_output。
+ */
+
+#ifndef APP_CLA_H
+#define APP_CLA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_cla_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 默认换算系数与调节参数，按硬件与电机修改。 */
+#define APP_CLA_DEFAULT_CURRENT_SCALE   (0.00805664f)   /**< ±16.5 A 对应 0~4095。 */
+#define APP_CLA_DEFAULT_OFFSET          (2048.0f)
+#define APP_CLA_DEFAULT_VDC_SCALE       (0.0147705f)    /**< 60.5 V 满量程。 */
+#define APP_CLA_DEFAULT_VDC_MIN         (1.0f)
+#define APP_CLA_DEFAULT_KP              (0.5f)
+#define APP_CLA_DEFAULT_KI              (0.05f)
+#define APP_CLA_DEFAULT_VLIMIT_PU       (0.40f)
+
+/** 置 1 时 main 初始化 eQEP1 并由 CLA 以编码器计算电角度，硬件须接入增量编码器。 */
+#ifndef APP_CLA_ENCODER_ANGLE
+#define APP_CLA_ENCODER_ANGLE           (0)
+#endif
+
+extern APP_CLA_Command      APP_CLA_command;
+extern APP_CLA_CommandBlock APP_CLA_commandBlock;
+extern volatile APP_CLA_Status APP_CLA_status;
+
+#if defined(_FLASH) && !defined(__TMS320C28XX_CLA__)
+extern uint16_t Cla1ProgLoadStart;
+extern uint16_t Cla1ProgLoadSize;
+extern uint16_t Cla1ProgRunStart;
+extern uint16_t Cla1ConstLoadStart;
+extern uint16_t Cla1ConstLoadSize;
+extern uint16_t Cla1ConstRunStart;
+#endif
+
+#if defined(__TMS320C28XX__) || defined(__TMS320C28XX_CLA__)
+/** CLA 任务，定义在 app_cla_tasks.cla 中。 */
+__attribute__((interrupt)) void Cla1Task1(void);
+__attribute__((interrupt)) void Cla1Task8(void);
+#endif
+
+#ifndef __TMS320C28XX_CLA__
+
+/**
+ * @brief 配置 CLA 存储、复制 CLA 程序并启动任务 1。
+ *
+ * 需在 EALLOW 下、DRV_ADC_init 与 DRV_EPWM_enableAdcTrigger 之后调用；命令初始化为
+ * 默认值且不使能闭环，并在接入 ADC 触发之前发布一次。
+ */
+void APP_CLA_init(void);
+
+/**
+ * @brief 把命令暂存副本发布给 CLA，每个控制周期在控制中断中调用一次。
+ *
+ * 只能在一个上下文中调用；设置函数在屏蔽中断期间修改多个字段，不会被发布拆开。
+ */
+void APP_CLA_publish(void);
+
+/**
+ * @brief 闭环使能或关闭，关闭时 CLA 清零积分并停止写 CMPA。
+ */
+void APP_CLA_setEnabled(bool enabled);
+
+/**
+ * @brief 设置 d/q 轴电流给定（A）。
+ */
+void APP_CLA_setCurrentRef(float idRef, float iqRef);
+
+/**
+ * @brief 设置电角度标幺值。
+ */
+void APP_CLA_setAngle(float anglePu);
+
+/**
+ * @brief 选择电角度来源：编码器或 APP_CLA_setAngle 的给定。
+ *
+ * 使能时同时取 DRV_EQEP_getAngleOffset 的偏移，偏移改变后需再次调用；须在
+ * DRV_EQEP_init 成功之后使能。
+ */
+void APP_CLA_setEncoderAngle(bool enabled);
+
+/**
+ * @brief 设置 PI 参数，ki 为每个控制周期的积分增益。
+ *
+ * @retval false 参数非法。
+ */
+bool APP_CLA_setGains(float kp, float ki);
+
+/**
+ * @brief 以当前 ADC 读数作为两相电流零点，只能在闭环关闭且无电流时调用。
+ *
+ * @retval false 闭环已使能。
+ */
+bool APP_CLA_calibrateOffsets(void);
+
+/**
+ * @brief 读取一份一致的状态副本。
+ *
+ * @retval false CLA 持续更新导致多次读取仍不一致。
+ */
+bool APP_CLA_getStatus(APP_CLA_Status *status);
+
+/**
+ * @brief 返回任务 1 的溢出标志，即上一次任务未完成时又被触发。
+ */
+bool APP_CLA_hasOverflowed(void);
+
+#endif /* __TMS320C28XX_CLA__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CLA_H */
@@ -0,0 +1,134 @@
+/**
+ * @file app_ctrl.h
+ * @brief 由 PWM 周期中断驱动的多速率控制执行器接口。
+ *
+ * 执行器在 ePWM1 计数器归零中断中运行，时隙划分如下：
+ *  - 快速时隙：每次中断执行，用于电流环；
+ *  - 中速、慢速时隙：按配置的分频比在中断中执行，用于速度环与位置环，可设置相位
+ *    使其落在不同的中断中，避免多个时隙叠加在同一周期；
+ *  - 后台时隙：按分频比以 APP_EVENT_SRC_CTRL 事件交给 APP_CTRL 任务执行。
+ *
+ * 每个时隙以 CPUTIMER0（APP_STATS_now）统计执行时间、超时次数与启动抖动：
+ *  - 中断时隙的抖动为相邻两次启动间隔与名义间隔之差的最大绝对值，超时指时隙结束时
+ *    距本次中断入口已超过一个中断周期；
+ *  - 后台时隙的抖动为事件投递到任务开始执行的最大延迟，超时指上一次尚未执行完成
+ *    又到了下一次释放时刻。
+ */
+
+#ifndef APP_CTRL_H
+#define APP_CTRL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 默认每个 PWM 周期中断一次。 */
+#define APP_CTRL_DEFAULT_PWM_DIVIDER        (1U)
+
+/** 默认分频比，以快速时隙为单位。 */
+#define APP_CTRL_DEFAULT_MEDIUM_RATIO       (10U)
+#define APP_CTRL_DEFAULT_SLOW_RATIO         (100U)
+#define APP_CTRL_DEFAULT_BACKGROUND_RATIO   (1000U)
+
+/**
+ * @brief 时隙编号，按优先级从高到低排列。
+ */
+typedef enum
+{
+    APP_CTRL_SLOT_FAST = 0,     /**< 每次中断执行。 */
+    APP_CTRL_SLOT_MEDIUM,       /**< 中断中按分频比执行。 */
+    APP_CTRL_SLOT_SLOW,         /**< 中断中按分频比执行。 */
+    APP_CTRL_SLOT_BACKGROUND,   /**< APP_CTRL 任务中按分频比执行。 */
+    APP_CTRL_SLOT_COUNT
+} APP_CTRL_Slot;
+
+/**
+ * @brief 时隙处理函数。
+ */
+typedef void (*APP_CTRL_SlotFxn)(void *context);
+
+/**
+ * @brief 单个时隙的运行统计，时间单位为 SYSCLK 周期。
+ */
+typedef struct
+{
+    uint32_t runs;              /**< 执行次数。 */
+    uint32_t lastCycles;        /**< 最近一次执行时间。 */
+    uint32_t maxCycles;         /**< 最长执行时间。 */
+    uint32_t overruns;          /**< 超时次数。 */
+    uint32_t maxJitterCycles;   /**< 最大启动抖动。 */
+} APP_CTRL_SlotStats;
+
+/**
+ * @brief 清空全部时隙配置与统计，需在 FreeRTOS_init 之前调用。
+ */
+void APP_CTRL_init(void);
+
+/**
+ * @brief 配置一个时隙，只能在执行器停止时调用。
+ *
+ * @param[in] slot    时隙编号。
+ * @param[in] fxn     处理函数，为 NULL 时关闭该时隙。
+ * @param[in] context 传给处理函数的参数。
+ * @param[in] ratio   分频比，以快速时隙为单位；快速时隙必须为 1。
+ * @param[in] phase   相位，即首次执行前跳过的中断数，须小于 @p ratio。
+ *
+ * @retval false 参数非法或执行器正在运行。
+ */
+bool APP_CTRL_setSlot(uint16_t slot, APP_CTRL_SlotFxn fxn, void *context,
+                      uint16_t ratio, uint16_t phase);
+
+/**
+ * @brief 注册中断服务程序并启动执行器。
+ *
+ * 需在 DRV_EPWM_init 之后调用。
+ *
+ * @param[in] pwmDivider 每隔多少个 PWM 周期中断一次，取值 1~DRV_EPWM_INT_MAX_EVENTS。
+ *
+ * @retval false 参数非法、未配置任何时隙或 PWM 频率无效。
+ */
+bool APP_CTRL_start(uint16_t pwmDivider);
+
+/**
+ * @brief 停止执行器，已投递的后台事件仍会执行。
+ */
+void APP_CTRL_stop(void);
+
+/**
+ * @brief 返回执行器启动后的中断次数。
+ */
+uint32_t APP_CTRL_getTickCount(void);
+
+/**
+ * @brief 读取时隙统计。
+ *
+ * @retval false 参数非法。
+ */
+bool APP_CTRL_getSlotStats(uint16_t slot, APP_CTRL_SlotStats *stats);
+
+/**
+ * @brief 清零全部时隙统计。
+ */
+void APP_CTRL_resetStats(void);
+
+/**
+ * @brief 执行器中断服务程序，由 APP_CTRL_start 注册到 INT_EPWM1。
+ */
+__interrupt void APP_CTRL_isr(void);
+
+/**
+ * @brief 后台时隙任务，由 SysConfig 创建。
+ */
+void APP_CTRL_TASK(void *pvParameters);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CTRL_H */
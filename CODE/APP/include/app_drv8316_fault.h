@@ -0,0 +1,149 @@
+/**
+ * @file app_drv8316_fault.h
+ * @brief DRV8316 故障事件记录接口说明。
+ *
+ * 周期任务每次刷新寄存器后，若状态寄存器 STATUS_0/1/2 发生变化，便将当时的状态字
+ * 与控制寄存器连同时间戳写入静态环形缓冲区，避免瞬态故障在下一周期被覆盖而丢失。
+ * 写入端只有 APP_DRV8316_TASK 一个生产者，读取端可以有多个消费者，各自持有独立
+ * 的读游标，读取过程无需获取 app_drv8316 模块的互斥量。
+ * 每个 DRV8316 器件拥有独立的缓冲区，接口均以器件编号区分。
+ */
+
+#ifndef APP_DRV8316_FAULT_H
+#define APP_DRV8316_FAULT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+
+#include "drv8316s.h"
+
+#include "app_drv8316.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 故障事件环形缓冲区深度，必须为 2 的整数次幂。
+ */
+#define APP_DRV8316_FAULT_LOG_DEPTH     (16U)
+
+/**
+ * @brief 单条 DRV8316 故障事件记录。
+ */
+typedef struct
+{
+    uint32_t   sequence;        /**< 事件序号，自模块初始化起单调递增。 */
+    TickType_t timestampTicks;  /**< 捕获事件时的 FreeRTOS 时钟节拍数。 */
+    uint16_t   device;          /**< 产生事件的器件编号。 */
+    uint16_t   statReg00;       /**< STATUS_0 寄存器值。 */
+    uint16_t   statReg01;       /**< STATUS_1 寄存器值。 */
+    uint16_t   statReg02;       /**< STATUS_2 寄存器值。 */
+    uint16_t   ctrlReg01;       /**< CONTROL_1 寄存器值。 */
+    uint16_t   ctrlReg02;       /**< CONTROL_2 寄存器值。 */
+    uint16_t   ctrlReg03;       /**< CONTROL_3 寄存器值。 */
+    uint16_t   ctrlReg04;       /**< CONTROL_4 寄存器值。 */
+    uint16_t   ctrlReg05;       /**< CONTROL_5 寄存器值。 */
+    uint16_t   ctrlReg06;       /**< CONTROL_6 寄存器值。 */
+    uint16_t   ctrlReg10;       /**< CONTROL_10 寄存器值。 */
+} APP_DRV8316_FaultEvent;
+
+/**
+ * @brief 消费者读游标。
+ *
+ * 每个消费者持有一份游标，互不干扰；游标内容仅由其所有者修改。
+ */
+typedef struct
+{
+    uint32_t nextSequence;      /**< 下一条待读取事件的序号。 */
+    uint16_t device;            /**< 游标所属的器件编号。 */
+    uint32_t lostCount;         /**< 因读取过慢被生产者覆盖而丢失的事件数。 */
+} APP_DRV8316_FaultReader;
+
+/**
+ * @brief 故障事件缓冲区统计信息。
+ */
+typedef struct
+{
+    uint32_t totalEvents;       /**< 自初始化以来记录的事件总数。 */
+    uint32_t overwrittenEvents; /**< 缓冲区已满时被新事件覆盖的旧事件数。 */
+    uint16_t depth;             /**< 缓冲区深度，等于 APP_DRV8316_FAULT_LOG_DEPTH。 */
+} APP_DRV8316_FaultLogStats;
+
+/**
+ * @brief 清空指定器件的故障事件缓冲区及统计计数。
+ *
+ * 由 APP_DRV8316_init 在调度器启动前调用，运行期间不应再调用。
+ *
+ * @param[in] device 器件编号。
+ */
+void APP_DRV8316_resetFaultLog(uint16_t device);
+
+/**
+ * @brief 比较最新寄存器镜像并在状态字变化时追加一条事件。
+ *
+ * 仅允许 APP_DRV8316_TASK 调用，是缓冲区唯一的生产者。
+ *
+ * @param[in] device    器件编号。
+ * @param[in] vars      最新一次刷新得到的寄存器镜像。
+ * @param[in] timestamp 本次刷新的时间戳（FreeRTOS 节拍数）。
+ * @retval true  状态发生变化并已追加事件；
+ * @retval false 状态未变化或参数无效。
+ */
+bool APP_DRV8316_recordFaultEvent(uint16_t device,
+                                  const DRV8316_VARS_t *vars,
+                                  TickType_t timestamp);
+
+/**
+ * @brief 初始化消费者读游标。
+ *
+ * @param[out] reader     待初始化的读游标。
+ * @param[in]  device     需要读取的器件编号。
+ * @param[in]  fromOldest true 表示从缓冲区中最旧的事件开始读取，false 表示仅读取
+ *                        此后新产生的事件。
+ */
+void APP_DRV8316_initFaultReader(APP_DRV8316_FaultReader *reader,
+                                 uint16_t device,
+                                 bool fromOldest);
+
+/**
+ * @brief 读取下一条故障事件。
+ *
+ * 无锁实现，可在任务或中断上下文中调用。若游标落后超过缓冲区深度，将自动跳至
+ * 仍然有效的最旧事件，并把被跳过的数量累加到 lostCount。
+ *
+ * @param[in,out] reader 消费者读游标。
+ * @param[out]    event  读取到的事件。
+ * @retval true  已读取一条事件；
+ * @retval false 暂无新事件或参数无效。
+ */
+bool APP_DRV8316_readFaultEvent(APP_DRV8316_FaultReader *reader,
+                                APP_DRV8316_FaultEvent *event);
+
+/**
+ * @brief 拷贝最近的若干条故障事件。
+ *
+ * @param[in]  device   器件编号。
+ * @param[out] events   事件缓冲区，按时间由旧到新排列。
+ * @param[in]  maxCount 缓冲区可容纳的事件数。
+ * @return 实际拷贝的事件数。
+ */
+uint16_t APP_DRV8316_readFaultHistory(uint16_t device,
+                                      APP_DRV8316_FaultEvent *events,
+                                      uint16_t maxCount);
+
+/**
+ * @brief 获取故障事件缓冲区统计信息。
+ *
+ * @param[in]  device 器件编号。
+ * @param[out] stats  统计结果，指针需有效。
+ */
+void APP_DRV8316_getFaultLogStats(uint16_t device, APP_DRV8316_FaultLogStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_DRV8316_FAULT_H */
@@ -0,0 +1,103 @@
+/**
+ * @file app_flashprof.h
+ * @brief 闪存等待周期、预取与缓存配置的启动测量与固定。
+ *
+ * 从闪存运行的代码受 FRD_INTF_CTRL 中的预取、数据缓存使能以及 FRDCNTL 中的等待周期
+ * 影响。APP_FLASHPROF_ENABLE 置 1 的测量构建在启动时依次切换到下列配置：
+ *  - 等待周期：DEVICE_FLASH_WAITSTATES（100 MHz 下的最小合法值）起共
+ *    APP_FLASHPROF_WAITSTATE_STEPS 档；
+ *  - 每档等待周期下预取、数据缓存的四种开关组合。
+ *
+ * 每种配置下以 CPUTIMER0（APP_STATS_now）测量一段固定的控制环负载：负载代码与
+ * 系数表均位于闪存，包含 PI 调节、一阶滤波与查表，执行 APP_FLASHPROF_RUNS 次，
+ * 记录最小、最大与平均周期数。测量结束后应用平均周期最少的配置，结果表可在调试器
+ * 中查看或由 APP_FLASHPROF_getResults 读出。
+ *
+ * 生产构建不做测量，由 APP_FLASHPROF_apply 固定 APP_FLASHPROF_WAITSTATES、
+ * APP_FLASHPROF_PREFETCH、APP_FLASHPROF_CACHE 指定的配置，把测量得到的最佳值写入
+ * 这三个宏即可。切换配置的函数位于 .TI.ramfunc，由 Device_init 复制到 RAM 运行。
+ * 只在 FLASH 构建中有意义，RAM 构建中两个接口均为空操作。
+ */
+
+#ifndef APP_FLASHPROF_H
+#define APP_FLASHPROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 置 1 时启动阶段执行配置测量，生产构建保持 0。 */
+#ifndef APP_FLASHPROF_ENABLE
+#define APP_FLASHPROF_ENABLE            (0)
+#endif
+
+/** 生产构建固定的配置，默认与 Device_init 中 Flash_initModule 的设置相同。 */
+#ifndef APP_FLASHPROF_WAITSTATES
+#define APP_FLASHPROF_WAITSTATES        (DEVICE_FLASH_WAITSTATES)
+#endif
+
+#ifndef APP_FLASHPROF_PREFETCH
+#define APP_FLASHPROF_PREFETCH          (1)
+#endif
+
+#ifndef APP_FLASHPROF_CACHE
+#define APP_FLASHPROF_CACHE             (1)
+#endif
+
+/** 测量的等待周期档数，从 DEVICE_FLASH_WAITSTATES 起逐档加 1。 */
+#define APP_FLASHPROF_WAITSTATE_STEPS   (3U)
+
+/** 每种配置下负载的执行次数，首次执行用于预热，不计入结果。 */
+#define APP_FLASHPROF_RUNS              (16U)
+
+#define APP_FLASHPROF_CONFIG_COUNT      (APP_FLASHPROF_WAITSTATE_STEPS * 4U)
+
+/**
+ * @brief 单种配置的测量结果，时间单位为 SYSCLK 周期。
+ */
+typedef struct
+{
+    uint16_t waitstates;    /**< 等待周期数。 */
+    uint16_t prefetch;      /**< 预取使能。 */
+    uint16_t cache;         /**< 数据缓存使能。 */
+    uint16_t reserved;
+    uint32_t minCycles;     /**< 单次负载最短周期数。 */
+    uint32_t maxCycles;     /**< 单次负载最长周期数。 */
+    uint32_t avgCycles;     /**< 单次负载平均周期数。 */
+} APP_FLASHPROF_Result;
+
+/**
+ * @brief 依次测量全部配置并应用平均周期最少的一种。
+ *
+ * 需在 APP_STATS_init 之后、开中断之前调用。APP_FLASHPROF_ENABLE 为 0 或 RAM 构建时
+ * 直接返回 false。
+ *
+ * @retval false 未执行测量。
+ */
+bool APP_FLASHPROF_run(void);
+
+/**
+ * @brief 固定生产配置，需在 Device_init 之后调用。
+ */
+void APP_FLASHPROF_apply(void);
+
+/**
+ * @brief 读取测量结果表。
+ *
+ * @param[out] results 结果表首地址。
+ * @param[out] best    最佳配置在表中的下标。
+ *
+ * @return 结果数量，未执行测量时为 0。
+ */
+uint16_t APP_FLASHPROF_getResults(const APP_FLASHPROF_Result **results, uint16_t *best);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_FLASHPROF_H */
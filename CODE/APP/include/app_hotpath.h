@@ -0,0 +1,44 @@
+/**
+ * @file app_hotpath.h
+ * @brief 热路径代码的 RAM 运行支持。
+ *
+ * 控制中断及其调用的函数以 `#pragma CODE_SECTION(fn, "hotpath")` 放入 hotpath 段，
+ * 汇编函数以 `.sect "hotpath"` 放入；FPU 查找表位于 FPUmathTables 段。FLASH 构建中
+ * 两个段从 FLASH_BANK0_SEC6 加载，分别在 RAMLS4 与 RAMLS6 运行，避开闪存等待周期；
+ * RAM 构建中直接链接到 RAMLS。
+ *
+ * pid.h、filter_fo.h 中的内联计算函数随调用者所在的段放置，无需单独标注。
+ * 段大小可由 tools/host/map_report 从链接映射文件中读取。
+ */
+
+#ifndef APP_HOTPATH_H
+#define APP_HOTPATH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef _FLASH
+extern uint16_t HotpathLoadStart;
+extern uint16_t HotpathLoadSize;
+extern uint16_t HotpathRunStart;
+extern uint16_t HotpathRunSize;
+extern uint16_t FPUmathTablesLoadStart;
+extern uint16_t FPUmathTablesLoadSize;
+extern uint16_t FPUmathTablesRunStart;
+#endif
+
+/**
+ * @brief 将热路径代码与 FPU 查找表复制到运行地址。
+ *
+ * 需在 Device_init 之后、任何热路径函数被调用之前执行；RAM 构建中为空操作。
+ */
+void APP_HOTPATH_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_HOTPATH_H */
@@ -0,0 +1,166 @@
+/**
+ * @file app_param.h
+ * @brief 闪存参数存储：FLASH_BANK1_SEC14/15 中的日志式参数记录。
+ *
+ * 参数以编号（0~APP_PARAM_MAX_ID-1）区分，每条记录带数据版本号与 CRC16，写入时
+ * 追加到当前扇区日志的末尾，同一编号的最后一条有效记录即当前值：
+ *  - 闪存按 8 字（128 bit）为一个编程单元，带 ECC 编程后不能再次写入，因此记录与
+ *    扇区头都按单元对齐，每个单元只编程一次；
+ *  - 单元 0 为扇区头（魔数、格式、代数、CRC），记录从单元 1 开始，记录头 4 字
+ *    （编号、数据字数、版本、CRC）后紧跟数据；数据字数为 0 的记录表示删除；
+ *  - 当前扇区写满时整理到另一个扇区：擦除备用扇区，复制每个编号的最新记录，最后
+ *    写入代数加 1 的扇区头。两个扇区轮流使用，每次整理只擦除一个扇区，擦除次数
+ *    均摊到两个扇区。
+ *
+ * 启动时 APP_PARAM_init 读两个扇区头，取代数较大的有效扇区，顺序扫描一次日志，
+ * 建立以编号为下标的 RAM 索引（记录所在单元），之后的查找为 O(1)。旧扇区留到
+ * 下一次整理时作为备用扇区擦除，启动阶段不擦写闪存（全新芯片的首次格式化除外）。
+ *
+ * 掉电恢复：
+ *  - 写记录中途掉电：记录 CRC 不符，扫描时按单元跳过，该编号保持旧值；
+ *  - 整理中途掉电：新扇区头最后写入，未写完时旧扇区仍有效；新扇区头写完后两扇区
+ *    均有效，取代数较大者；
+ *  - 写指针取扫描到的第一个全擦除单元，未写完的单元不会再次编程。
+ *
+ * 闪存经 APP_PARAM_PORT_* 接口访问：目标板由 app_param_flash.c 以 C2000Ware
+ * Flash API 实现，主机端由 tools/host/param_host 中的闪存模拟器提供，两者共用
+ * app_param.c。擦写由调用任务阻塞完成，程序在 BANK0 运行，中断不受影响。
+ * 接口不可重入，也不能在中断中调用。
+ */
+
+#ifndef APP_PARAM_H
+#define APP_PARAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 置 1 时目标板经 Flash API 擦写闪存，工程默认链接 C2000Ware 的 F28004x ROM Flash API。 */
+#ifndef APP_PARAM_FLASH_API
+#define APP_PARAM_FLASH_API         (1)
+#endif
+
+/** 参数编号上限，RAM 索引按编号直接寻址。 */
+#define APP_PARAM_MAX_ID            (64U)
+
+/** 单个参数的最大数据字数。 */
+#define APP_PARAM_MAX_WORDS         (28U)
+
+/** 编程单元字数。 */
+#define APP_PARAM_UNIT_WORDS        (8U)
+
+/** 每个扇区可用的字数，SEC15 末尾 16 字按勘误保留。 */
+#define APP_PARAM_SECTOR_WORDS      (0x0FF0U)
+
+/** 每个扇区的编程单元数。 */
+#define APP_PARAM_SECTOR_UNITS      (APP_PARAM_SECTOR_WORDS / APP_PARAM_UNIT_WORDS)
+
+/** 参数存储占用的扇区数。 */
+#define APP_PARAM_SECTOR_COUNT      (2U)
+
+/** 以 16 bit 字计的对象长度。 */
+#define APP_PARAM_WORDS(x)          ((uint16_t)(sizeof(x) / (sizeof(uint16_t))))
+
+/**
+ * @brief 已分配的参数编号。
+ *
+ * 数据布局改变时应增加对应的版本号，旧版本的记录在读取时被忽略。
+ */
+typedef enum
+{
+    APP_PARAM_ID_PWM_FREQUENCY = 0,     /**< 版本 1：uint32_t PWM 频率（Hz）。 */
+    APP_PARAM_ID_PWM_DEADBAND  = 1,     /**< 版本 1：uint16_t[2] 死区上升沿、下降沿计数。 */
+    APP_PARAM_ID_CLA_GAINS     = 2,     /**< 版本 1：float[2] 电流环 kp、ki。 */
+    APP_PARAM_ID_DRV8316_CTRL  = 3      /**< 版本 1：uint16_t[6] 0 号 DRV8316 的 CTRL2~CTRL6、CTRL10。 */
+} APP_PARAM_Id;
+
+/**
+ * @brief 存储统计。
+ */
+typedef struct
+{
+    bool     ready;             /**< 初始化成功。 */
+    uint16_t activeSector;      /**< 当前扇区，0 为 SEC14。 */
+    uint32_t generation;        /**< 当前扇区代数，每次整理加 1。 */
+    uint16_t records;           /**< 有当前值的参数数。 */
+    uint16_t usedUnits;         /**< 当前扇区已用单元数（含扇区头）。 */
+    uint16_t freeUnits;         /**< 当前扇区剩余单元数。 */
+    uint32_t writes;            /**< 写入的记录数。 */
+    uint32_t unchanged;         /**< 值未变而省略的写入次数。 */
+    uint32_t compactions;       /**< 本次上电后的整理次数。 */
+    uint32_t erases;            /**< 本次上电后的扇区擦除次数。 */
+    uint16_t skippedUnits;      /**< 启动扫描时跳过的损坏单元数。 */
+    uint32_t flashErrors;       /**< 擦除或编程失败次数。 */
+} APP_PARAM_Stats;
+
+/**
+ * @brief 扫描参数扇区并建立 RAM 索引。
+ *
+ * 两个扇区都没有有效扇区头时格式化 SEC14。
+ *
+ * @retval false 闪存不可用或格式化失败，此后读写均返回 false。
+ */
+bool APP_PARAM_init(void);
+
+/**
+ * @brief 读取参数当前值。
+ *
+ * @param[in]  id      参数编号。
+ * @param[in]  version 期望的数据版本。
+ * @param[out] value   目标缓冲区。
+ * @param[in]  words   目标长度（字）。
+ *
+ * @retval false 无记录、已删除、版本或长度不符，@p value 保持不变。
+ */
+bool APP_PARAM_read(uint16_t id, uint16_t version, void *value, uint16_t words);
+
+/**
+ * @brief 写入参数，值与当前记录相同时不写闪存。
+ *
+ * 当前扇区空间不足时先整理，整理需擦除一个扇区，耗时可达数百毫秒。
+ *
+ * @param[in] words 数据长度（字），1~APP_PARAM_MAX_WORDS。
+ *
+ * @retval false 未初始化、参数非法或擦写失败，失败时该编号保持原值。
+ */
+bool APP_PARAM_write(uint16_t id, uint16_t version, const void *value, uint16_t words);
+
+/**
+ * @brief 删除参数，之后读取返回 false。
+ */
+bool APP_PARAM_remove(uint16_t id);
+
+/**
+ * @brief 读取统计。
+ */
+void APP_PARAM_getStats(APP_PARAM_Stats *stats);
+
+/**
+ * @brief 参数数据的 CRC16（CCITT，多项式 0x1021），按字高字节在前计算。
+ */
+uint16_t APP_PARAM_crc16(uint16_t crc, const uint16_t *data, uint16_t words);
+
+/*
+ * 闪存接口，sector 为 0（SEC14）或 1（SEC15），offset 为扇区内字偏移。
+ */
+
+/** 准备擦写，闪存不可用时返回 false。 */
+bool APP_PARAM_PORT_init(void);
+
+/** 读取，可读到未写完的单元，不得因 ECC 错误产生异常。 */
+void APP_PARAM_PORT_read(uint16_t sector, uint16_t offset, uint16_t *data, uint16_t words);
+
+/** 编程一个单元，offset 按 APP_PARAM_UNIT_WORDS 对齐。 */
+bool APP_PARAM_PORT_program(uint16_t sector, uint16_t offset, const uint16_t *data);
+
+/** 擦除扇区。 */
+bool APP_PARAM_PORT_erase(uint16_t sector);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PARAM_H */
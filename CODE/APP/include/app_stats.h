@@ -0,0 +1,195 @@
+/**
+ * @file app_stats.h
+ * @brief CPU 占用与运行时统计接口。
+ *
+ * 以自由运行的 CPUTIMER0 作为 SYSCLK 分辨率的时间基准（CPUTIMER1 用于 timer1_ISR，
+ * CPUTIMER2 为 FreeRTOS 节拍），同时作为 FreeRTOS 运行时统计计数器。统计分为三部分：
+ *  - 任务：由内核运行时统计得到窗口内占用，另由任务循环标注单次执行的最长耗时；
+ *  - 中断：在中断入口与出口处累加耗时，开销为两次计时器读取与数次加法；
+ *  - 汇总：以 1000 减去空闲任务占用得到总体 CPU 占用。
+ *
+ * 统计按窗口计算，需由某个任务以不超过 40 s 的间隔调用 APP_STATS_update，
+ * 结果以紧凑二进制记录的形式供遥测读取。
+ */
+
+#ifndef APP_STATS_H
+#define APP_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "device.h"
+#include "driverlib/cputimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 作为时间基准的 CPU 定时器。 */
+#define APP_STATS_TIMER_BASE        (CPUTIMER0_BASE)
+
+/** 统计的任务数量上限。 */
+#ifndef APP_STATS_MAX_TASKS
+#define APP_STATS_MAX_TASKS         (8U)
+#endif
+
+/** 统计的中断数量上限。 */
+#ifndef APP_STATS_MAX_ISRS
+#define APP_STATS_MAX_ISRS          (4U)
+#endif
+
+/** 中断编号。 */
+#define APP_STATS_ISR_TIMER1        (0U)
+#define APP_STATS_ISR_CTRL          (1U)
+
+/** 记录格式版本。 */
+#define APP_STATS_RECORD_VERSION    (1U)
+
+/** 记录条目 id 中标识中断的最高位，其余位为中断编号。 */
+#define APP_STATS_ID_ISR_FLAG       (0x8000U)
+
+/** 中断条目或无法获取时的栈高水位取值。 */
+#define APP_STATS_STACK_UNKNOWN     (0xFFFFU)
+
+/** 序列化后每个条目占用的 16 bit 字数。 */
+#define APP_STATS_ENTRY_WORDS       (5U)
+
+/** 序列化后记录头占用的 16 bit 字数。 */
+#define APP_STATS_HEADER_WORDS      (6U)
+
+/**
+ * @brief 单个任务或中断的统计条目。
+ */
+typedef struct
+{
+    uint16_t id;            /**< 任务为 xTaskNumber；中断为 APP_STATS_ID_ISR_FLAG | 中断编号。 */
+    uint16_t loadPermille;  /**< 窗口内 CPU 占用，单位 0.1 %。 */
+    uint32_t maxCycles;     /**< 窗口内单次执行最长耗时（SYSCLK 周期），任务未标注时为 0。 */
+    uint16_t stackFree;     /**< 栈剩余高水位（字），中断为 ::APP_STATS_STACK_UNKNOWN。 */
+} APP_STATS_Entry;
+
+/**
+ * @brief 一个统计窗口的完整记录。
+ */
+typedef struct
+{
+    uint16_t        version;         /**< ::APP_STATS_RECORD_VERSION。 */
+    uint16_t        count;           /**< 有效条目数。 */
+    uint32_t        windowCycles;    /**< 窗口长度（SYSCLK 周期）。 */
+    uint16_t        cpuLoadPermille; /**< 总体 CPU 占用，单位 0.1 %。 */
+    uint16_t        isrLoadPermille; /**< 全部中断的占用，单位 0.1 %。 */
+    APP_STATS_Entry entries[APP_STATS_MAX_TASKS + APP_STATS_MAX_ISRS];
+} APP_STATS_Record;
+
+/**
+ * @brief 中断耗时累加器，由 APP_STATS_isrExit 在中断上下文中更新。
+ */
+typedef struct
+{
+    uint32_t busyCycles;    /**< 窗口内累计耗时。 */
+    uint32_t maxCycles;     /**< 窗口内单次最长耗时。 */
+    uint32_t count;         /**< 窗口内进入次数。 */
+} APP_STATS_IsrAcc;
+
+extern volatile APP_STATS_IsrAcc APP_STATS_isrAcc[APP_STATS_MAX_ISRS];
+
+/**
+ * @brief 启动自由运行的时间基准，需在 FreeRTOS_init 之前调用。
+ */
+void APP_STATS_init(void);
+
+/**
+ * @brief 读取递增的 SYSCLK 周期计数，32 bit 回绕约 42.9 s。
+ */
+static inline uint32_t APP_STATS_now(void)
+{
+    /* CPU 定时器向下计数，取反即得到递增计数。 */
+    return ~CPUTimer_getTimerCount(APP_STATS_TIMER_BASE);
+}
+
+/**
+ * @brief 中断入口处调用，返回入口时刻。
+ */
+static inline uint32_t APP_STATS_isrEnter(void)
+{
+    return APP_STATS_now();
+}
+
+/**
+ * @brief 中断出口处调用，累加本次耗时。
+ *
+ * 中断默认不嵌套，累加器只在中断上下文中修改，无需额外保护。
+ *
+ * @param[in] isr   中断编号，小于 ::APP_STATS_MAX_ISRS。
+ * @param[in] start APP_STATS_isrEnter 的返回值。
+ */
+static inline void APP_STATS_isrExit(uint16_t isr, uint32_t start)
+{
+    uint32_t elapsed = APP_STATS_now() - start;
+    volatile APP_STATS_IsrAcc *acc = &APP_STATS_isrAcc[isr];
+
+    acc->busyCycles += elapsed;
+    acc->count++;
+
+    if(elapsed > acc->maxCycles)
+    {
+        acc->maxCycles = elapsed;
+    }
+}
+
+/**
+ * @brief 任务单次执行开始时调用，返回开始时刻。
+ */
+static inline uint32_t APP_STATS_taskBegin(void)
+{
+    return APP_STATS_now();
+}
+
+/**
+ * @brief 任务单次执行结束时调用，更新当前任务的最长执行时间。
+ *
+ * 耗时为墙钟时间，包含期间被更高优先级任务或中断抢占的时间。
+ *
+ * @param[in] start APP_STATS_taskBegin 的返回值。
+ */
+void APP_STATS_taskEnd(uint32_t start);
+
+/**
+ * @brief 结束当前统计窗口并生成新记录。
+ *
+ * 由任务周期调用，间隔须小于计数器回绕时间。
+ */
+void APP_STATS_update(void);
+
+/**
+ * @brief 读取最近一个窗口的统计记录。
+ *
+ * @retval false 参数为空或尚未完成首个窗口。
+ */
+bool APP_STATS_getRecord(APP_STATS_Record *record);
+
+/**
+ * @brief 将记录序列化为紧凑的 16 bit 字流，供遥测发送。
+ *
+ * 格式：version, count, windowCycles 低/高字, cpuLoadPermille, isrLoadPermille，
+ * 随后每个条目依次为 id, loadPermille, maxCycles 低/高字, stackFree。
+ *
+ * @return 写入的字数，缓冲区不足时返回 0。
+ */
+uint16_t APP_STATS_serialize(const APP_STATS_Record *record, uint16_t *buffer, uint16_t maxWords);
+
+/**
+ * @brief FreeRTOS 运行时统计接口，由 FreeRTOSConfig.h 中的
+ *        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS / portGET_RUN_TIME_COUNTER_VALUE 调用。
+ */
+void vConfigureTimerForRunTimeStats(void);
+uint32_t ulGetRunTimeCounterValue(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_STATS_H */
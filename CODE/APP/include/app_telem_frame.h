@@ -0,0 +1,120 @@
+/**
+ * @file app_telem_frame.h
+ * @brief 遥测帧编码接口：CRC16、COBS 与小端序字段。
+ *
+ * 一帧的原始内容为若干字节加 2 字节 CRC16（CCITT-FALSE，多项式 0x1021，初值 0xFFFF，
+ * 小端序），整体经 COBS 编码后以 0x00 结尾。COBS 保证帧内不出现 0x00，接收端以 0x00
+ * 重新同步，丢失或损坏的字节最多影响一帧。
+ *
+ * 每个 uint16_t 的低 8 bit 为一个字节，C28x 与主机使用同一份实现。本模块不依赖硬件，
+ * 主机端解码器直接编译本文件。
+ */
+
+#ifndef APP_TELEM_FRAME_H
+#define APP_TELEM_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** CRC 字节数。 */
+#define APP_TELEM_FRAME_CRC_BYTES       (2U)
+
+/** COBS 每 254 字节增加 1 字节开销。 */
+#define APP_TELEM_FRAME_COBS_BLOCK      (254U)
+
+/** 原始内容为 n 字节时编码后的最大长度，含 CRC 与结尾 0x00。 */
+#define APP_TELEM_FRAME_ENCODED_MAX(n)  \
+    ((n) + APP_TELEM_FRAME_CRC_BYTES + \
+     (((n) + APP_TELEM_FRAME_CRC_BYTES) / APP_TELEM_FRAME_COBS_BLOCK) + 2U)
+
+/** 帧分隔符。 */
+#define APP_TELEM_FRAME_DELIMITER       (0x00U)
+
+/**
+ * @brief 计算 CRC16-CCITT-FALSE。
+ *
+ * @param[in] crc    初值，首次调用为 0xFFFF，可分段续算。
+ */
+uint16_t APP_TELEM_FRAME_crc16(uint16_t crc, const uint16_t *data, uint16_t length);
+
+/**
+ * @brief COBS 编码，不写结尾 0x00。
+ *
+ * @param[out] dst 至少 length + length / 254 + 1 字节。
+ *
+ * @return 编码后的字节数。
+ */
+uint16_t APP_TELEM_FRAME_cobsEncode(const uint16_t *src, uint16_t length, uint16_t *dst);
+
+/**
+ * @brief COBS 解码，输入不含结尾 0x00。
+ *
+ * @param[out] decoded 解码后的字节数。
+ *
+ * @retval false 输入含 0x00、长度码越界或输出超过 maxLength。
+ */
+bool APP_TELEM_FRAME_cobsDecode(const uint16_t *src, uint16_t length,
+                                uint16_t *dst, uint16_t maxLength, uint16_t *decoded);
+
+/**
+ * @brief 追加 CRC 并编码为一帧。
+ *
+ * raw 须在 length 之后留出 2 字节，CRC 写入其中。
+ *
+ * @return 帧长度（含结尾 0x00），frame 容量不足时为 0。
+ */
+uint16_t APP_TELEM_FRAME_encode(uint16_t *raw, uint16_t length,
+                                uint16_t *frame, uint16_t maxFrame);
+
+/**
+ * @brief 解码一帧并校验 CRC。
+ *
+ * @param[in]  frame  帧内容，不含结尾 0x00。
+ * @param[out] length 去掉 CRC 后的原始内容字节数。
+ *
+ * @retval false COBS 非法、长度不足或 CRC 不符。
+ */
+bool APP_TELEM_FRAME_decode(const uint16_t *frame, uint16_t frameLength,
+                            uint16_t *raw, uint16_t maxRaw, uint16_t *length);
+
+/**
+ * @brief 以小端序写入字段，返回写入的字节数。
+ */
+static inline uint16_t APP_TELEM_FRAME_putU16(uint16_t *dst, uint16_t value)
+{
+    dst[0] = value & 0xFFU;
+    dst[1] = (value >> 8) & 0xFFU;
+
+    return 2U;
+}
+
+static inline uint16_t APP_TELEM_FRAME_putU32(uint16_t *dst, uint32_t value)
+{
+    (void)APP_TELEM_FRAME_putU16(dst, (uint16_t)(value & 0xFFFFU));
+    (void)APP_TELEM_FRAME_putU16(&dst[2], (uint16_t)(value >> 16));
+
+    return 4U;
+}
+
+/**
+ * @brief 以小端序读取字段。
+ */
+static inline uint16_t APP_TELEM_FRAME_getU16(const uint16_t *src)
+{
+    return (uint16_t)((src[0] & 0xFFU) | ((src[1] & 0xFFU) << 8));
+}
+
+static inline uint32_t APP_TELEM_FRAME_getU32(const uint16_t *src)
+{
+    return (uint32_t)APP_TELEM_FRAME_getU16(src) | ((uint32_t)APP_TELEM_FRAME_getU16(&src[2]) << 16);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_TELEM_FRAME_H */
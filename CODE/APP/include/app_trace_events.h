@@ -0,0 +1,41 @@
+/**
+ * @file app_trace_events.h
+ * @brief 二进制跟踪记录的事件编号。
+ *
+ * 本文件只含宏定义，可被 app_trace_freertos.h 预包含到任意编译单元。
+ * 主机端解码器 tools/host/trace_decode 使用同一套编号。
+ */
+
+#ifndef APP_TRACE_EVENTS_H
+#define APP_TRACE_EVENTS_H
+
+/** 任务切入/切出，参数为任务编号 uxTCBNumber。 */
+#define APP_TRACE_EV_TASK_IN            (0x0001U)
+#define APP_TRACE_EV_TASK_OUT           (0x0002U)
+
+/**
+ * 队列与信号量操作，参数高 4 位为 ucQueueType（0 队列、1 互斥量、2 计数信号量、
+ * 3 二值信号量、4 递归互斥量），低 12 位为 uxQueueNumber。
+ */
+#define APP_TRACE_EV_QUEUE_SEND         (0x0010U)
+#define APP_TRACE_EV_QUEUE_SEND_ISR     (0x0011U)
+#define APP_TRACE_EV_QUEUE_RECV         (0x0012U)
+#define APP_TRACE_EV_QUEUE_RECV_ISR     (0x0013U)
+#define APP_TRACE_EV_QUEUE_SEND_FAIL    (0x0014U)
+#define APP_TRACE_EV_QUEUE_RECV_FAIL    (0x0015U)
+#define APP_TRACE_EV_QUEUE_BLOCK_RECV   (0x0016U)
+
+/** 任务通知，参数为被通知任务（TAKE 为当前任务）的编号。 */
+#define APP_TRACE_EV_NOTIFY             (0x0020U)
+#define APP_TRACE_EV_NOTIFY_ISR         (0x0021U)
+#define APP_TRACE_EV_NOTIFY_GIVE_ISR    (0x0022U)
+#define APP_TRACE_EV_NOTIFY_TAKE        (0x0023U)
+
+/** 用户中断入口/出口，参数为 APP_STATS_ISR_* 中断编号。 */
+#define APP_TRACE_EV_ISR_ENTER          (0x0100U)
+#define APP_TRACE_EV_ISR_EXIT           (0x0101U)
+
+/** 用户自定义事件的起始编号。 */
+#define APP_TRACE_EV_USER               (0x8000U)
+
+#endif /* APP_TRACE_EVENTS_H */
@@ -0,0 +1,228 @@
+/**
+ * @file app_xcp.h
+ * @brief SCIA 上的轻量测量/标定协议接口（XCP 风格）。
+ *
+ * 协议与遥测共用 SCIA 与 app_telem_frame.h 的帧格式（CRC16 + COBS，以 0x00 结尾），
+ * 帧的第一个字节区分内容：遥测流号小于 APP_TELEM_MAX_STREAMS，XCP 使用 0xE0 以上。
+ *
+ * 主机请求：[命令][计数][参数 ...]，目标应答 [0xFF][计数][数据 ...] 或
+ * [0xFE][计数][错误码]，计数原样返回，主机据此匹配应答。DAQ 包与遥测包格式相同：
+ * [0xE0 + 列表号][序号][时间戳 4B][数据 ...]。多字节字段均为小端序。
+ *
+ * 地址以 16 bit 字为单位，长度以字计，地址扩展 0 为 CPU 内存，1 以上为以
+ * APP_XCP_setSpace 登记的异步地址空间（例如 DRV8316 寄存器）。
+ *
+ * 符号表：目标以 APP_XCP_Symbol 数组登记可访问的变量，地址由链接器在构建时解析，
+ * 主机连接后以 GET_SYMBOL 逐项读取，不需要映射文件。读取不受符号表限制，写入只
+ * 允许落在标记为可写的符号之内。
+ *
+ * 写入：DOWNLOAD 只把数据暂存，COMMIT 请求在控制中断的安全点（APP_CTRL_isr 执行任何
+ * 时隙之前）一次写入全部暂存数据，同一次提交中的 PID 增益、滤波器系数等在同一个控制
+ * 周期内生效。偶地址上的双字以一次 32 bit 访问写入。SHORT_DOWNLOAD 为单项写入加提交。
+ * 控制中断未运行时提交超时，返回 APP_XCP_ERR_RESOURCE_UNAVAILABLE。
+ *
+ * DAQ：每个列表登记若干地址与分频，APP_CTRL_isr 在全部时隙之后调用 APP_XCP_daqSample，
+ * 到期的列表在中断内同步读取，样本进入单生产者/单消费者队列，由任务打包发送。
+ *
+ * APP_XCP_service 与 APP_TELEM_service 在同一个任务中调用，DRV_SCI_send 只有一个
+ * 生产者。本模块不依赖硬件与 FreeRTOS，主机端模拟目标直接编译本文件。
+ */
+
+#ifndef APP_XCP_H
+#define APP_XCP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_telem_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 协议版本，CONNECT 应答中返回。 */
+#define APP_XCP_VERSION                 (1U)
+
+/** 单次读写的最大字数。 */
+#define APP_XCP_MAX_WORDS               (16U)
+
+/** 地址空间数量，含 CPU 内存。 */
+#define APP_XCP_MAX_SPACES              (4U)
+
+/** DAQ 列表数量、每个列表的条目数与字数上限。 */
+#define APP_XCP_DAQ_LISTS               (4U)
+#define APP_XCP_DAQ_ENTRIES             (8U)
+#define APP_XCP_DAQ_MAX_WORDS           (16U)
+
+/** DAQ 样本队列深度，必须为 2 的幂。 */
+#ifndef APP_XCP_DAQ_QUEUE_DEPTH
+#define APP_XCP_DAQ_QUEUE_DEPTH         (8U)
+#endif
+
+/** 一次提交可暂存的条目数与字数。 */
+#define APP_XCP_STAGE_ENTRIES           (8U)
+#define APP_XCP_STAGE_WORDS             (32U)
+
+/** 等待安全点或异步地址空间的最长 tick 数。 */
+#ifndef APP_XCP_TIMEOUT_TICKS
+#define APP_XCP_TIMEOUT_TICKS           (100U)
+#endif
+
+/** 符号名最大字符数。 */
+#define APP_XCP_NAME_MAX                (24U)
+
+/** 发送缓冲区数量。 */
+#ifndef APP_XCP_PACKET_COUNT
+#define APP_XCP_PACKET_COUNT            (4U)
+#endif
+
+/** 原始包最大字节数，不含 CRC：DOWNLOAD 请求 8 字节头加最大数据，其余包均更短。 */
+#define APP_XCP_RAW_MAX                 (8U + (2U * APP_XCP_MAX_WORDS))
+
+/** 编码后一帧的最大字节数。 */
+#define APP_XCP_FRAME_MAX               (APP_TELEM_FRAME_ENCODED_MAX(APP_XCP_RAW_MAX))
+
+/** 包标识。 */
+#define APP_XCP_PID_RES                 (0xFFU)
+#define APP_XCP_PID_ERR                 (0xFEU)
+#define APP_XCP_PID_DAQ                 (0xE0U)     /**< 加列表号。 */
+
+/** 命令，编码沿用 XCP，COMMIT 与 GET_SYMBOL 为 USER_CMD 的子命令。 */
+#define APP_XCP_CMD_CONNECT             (0xFFU)     /**< 无参数。 */
+#define APP_XCP_CMD_DISCONNECT          (0xFEU)     /**< 停止全部 DAQ 并丢弃暂存数据。 */
+#define APP_XCP_CMD_GET_STATUS          (0xFDU)
+#define APP_XCP_CMD_USER                (0xF1U)     /**< [子命令][参数]。 */
+#define APP_XCP_CMD_DOWNLOAD            (0xF0U)     /**< [字数][扩展][地址 4B][数据]，只暂存。 */
+#define APP_XCP_CMD_SHORT_UPLOAD        (0xF4U)     /**< [字数][扩展][地址 4B]。 */
+#define APP_XCP_CMD_SHORT_DOWNLOAD      (0xEDU)     /**< [字数][扩展][地址 4B][数据]，立即生效。 */
+#define APP_XCP_CMD_CLEAR_DAQ_LIST      (0xE3U)     /**< [列表]。 */
+#define APP_XCP_CMD_WRITE_DAQ           (0xE1U)     /**< [列表][字数][地址 4B]，追加条目。 */
+#define APP_XCP_CMD_SET_DAQ_LIST_MODE   (0xE0U)     /**< [列表][分频 2B]。 */
+#define APP_XCP_CMD_START_STOP_DAQ_LIST (0xDEU)     /**< [列表][0 停止 / 1 启动]。 */
+
+#define APP_XCP_USER_GET_SYMBOL         (0x01U)     /**< [序号 2B]。 */
+#define APP_XCP_USER_COMMIT             (0x02U)     /**< 在安全点写入暂存数据。 */
+
+/** 错误码，编码沿用 XCP。 */
+#define APP_XCP_ERR_CMD_BUSY            (0x10U)
+#define APP_XCP_ERR_CMD_UNKNOWN         (0x20U)
+#define APP_XCP_ERR_CMD_SYNTAX          (0x21U)
+#define APP_XCP_ERR_OUT_OF_RANGE        (0x22U)
+#define APP_XCP_ERR_WRITE_PROTECTED     (0x23U)
+#define APP_XCP_ERR_ACCESS_DENIED       (0x24U)
+#define APP_XCP_ERR_DAQ_ACTIVE          (0x28U)
+#define APP_XCP_ERR_DAQ_CONFIG          (0x29U)
+#define APP_XCP_ERR_MEMORY_OVERFLOW     (0x30U)
+#define APP_XCP_ERR_RESOURCE_UNAVAILABLE (0x33U)
+
+/**
+ * @brief 符号类型。
+ */
+typedef enum
+{
+    APP_XCP_TYPE_FLOAT32 = 0,
+    APP_XCP_TYPE_INT16,
+    APP_XCP_TYPE_UINT16,
+    APP_XCP_TYPE_INT32,
+    APP_XCP_TYPE_UINT32
+} APP_XCP_Type;
+
+/** 符号可写。 */
+#define APP_XCP_SYM_WRITABLE            (0x0001U)
+
+/**
+ * @brief 符号表项。
+ */
+typedef struct
+{
+    const char          *name;      /**< 不超过 APP_XCP_NAME_MAX 个字符。 */
+    const volatile void *address;
+    uint16_t             type;      /**< ::APP_XCP_Type。 */
+    uint16_t             flags;     /**< APP_XCP_SYM_*。 */
+} APP_XCP_Symbol;
+
+/** 异步地址空间的操作状态。 */
+#define APP_XCP_SPACE_BUSY              (0U)
+#define APP_XCP_SPACE_DONE              (1U)
+#define APP_XCP_SPACE_ERROR             (2U)
+
+/**
+ * @brief 异步地址空间。
+ *
+ * start 开始一次读或写，data 在写时为输入；poll 在每个 tick 调用，完成读操作时把
+ * 结果填入 data。同一时刻只有一次操作。
+ */
+typedef struct
+{
+    bool     (*start)(bool write, uint32_t address, uint16_t *data, uint16_t words);
+    uint16_t (*poll)(uint16_t *data, uint16_t words);
+} APP_XCP_Space;
+
+/**
+ * @brief 协议统计。
+ */
+typedef struct
+{
+    uint32_t commands;              /**< 收到的有效命令数。 */
+    uint32_t errors;                /**< 错误应答数。 */
+    uint32_t badFrames;             /**< CRC 或 COBS 错误的帧数。 */
+    uint32_t commits;               /**< 在安全点完成的提交数。 */
+    uint32_t daqPackets;            /**< 发出的 DAQ 包数。 */
+    uint32_t daqOverruns;           /**< DAQ 队列满而丢弃的样本数。 */
+} APP_XCP_Stats;
+
+/**
+ * @brief 初始化协议并登记符号表。
+ *
+ * @param[in] symbols 符号表，须在整个运行期间有效。
+ */
+void APP_XCP_init(const APP_XCP_Symbol *symbols, uint16_t count);
+
+/**
+ * @brief 把 CPU 内存限制在一个窗口内，地址相对于窗口起点；base 为 NULL 时为绝对地址。
+ *
+ * 目标板不需要调用；主机端模拟目标以此把 64 bit 指针映射到 32 bit 地址。
+ */
+void APP_XCP_setMemoryWindow(volatile void *base, uint32_t words);
+
+/**
+ * @brief 登记异步地址空间。
+ *
+ * @param[in] extension 地址扩展，1~APP_XCP_MAX_SPACES-1。
+ *
+ * @retval false 扩展号非法或接口不完整。
+ */
+bool APP_XCP_setSpace(uint16_t extension, const APP_XCP_Space *space);
+
+/**
+ * @brief 处理命令、等待中的操作与 DAQ 发送，每个 tick 调用一次。
+ */
+void APP_XCP_service(void);
+
+/**
+ * @brief 安全点：写入已提交的暂存数据，在控制中断执行时隙之前调用。
+ */
+void APP_XCP_safePoint(void);
+
+/**
+ * @brief DAQ 采样，在控制中断的全部时隙之后调用。
+ *
+ * @param[in] timestamp 写入 DAQ 包的时间戳。
+ */
+void APP_XCP_daqSample(uint32_t timestamp);
+
+/**
+ * @brief 读取协议统计。
+ */
+void APP_XCP_getStats(APP_XCP_Stats *stats);
+
+/**
+ * @brief 以目标板符号表初始化协议并登记 DRV8316 寄存器空间（地址扩展 1），见 app_xcp_target.c。
+ */
+void APP_XCP_TARGET_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_XCP_H */
@@ -0,0 +1,78 @@
+/**
+ * @file drv_adc.c
+ * @brief ADC 驱动实现文件，配置相电流、母线电压与芯片温度的同步采样。
+ */
+
+#include "drv_adc.h"
+
+#include "device.h"
+#include "driverlib/adc.h"
+#include "driverlib/asysctl.h"
+#include "driverlib/sysctl.h"
+
+#define DRV_ADC_TRIGGER     (ADC_TRIGGER_EPWM1_SOCA) /**< 采样触发源。 */
+#define DRV_ADC_VREF        (3.3f)                   /**< 内部参考电压。 */
+
+/**
+ * @brief 配置单个 ADC 模块的参考、时钟与中断脉冲位置并上电。
+ *
+ * @param[in] base ADC 模块基地址。
+ */
+static void DRV_ADC_configureModule(uint32_t base)
+{
+    ADC_setVREF(base, ADC_REFERENCE_INTERNAL, ADC_REFERENCE_3_3V);
+    ADC_setPrescaler(base, ADC_CLK_DIV_2_0);
+    ADC_setInterruptPulseMode(base, ADC_PULSE_END_OF_CONV);
+    ADC_enableConverter(base);
+}
+
+void DRV_ADC_init(void)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_ADCA);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_ADCC);
+
+    DRV_ADC_configureModule(ADCA_BASE);
+    DRV_ADC_configureModule(ADCC_BASE);
+    ASysCtl_enableTemperatureSensor();
+
+    /* 等待 ADC 上电完成。 */
+    DEVICE_DELAY_US(1000U);
+
+    ADC_setupSOC(ADCA_BASE, ADC_SOC_NUMBER0, DRV_ADC_TRIGGER,
+                 (ADC_Channel)DRV_ADC_IA_CHANNEL, DRV_ADC_ACQPS);
+    ADC_setupSOC(ADCC_BASE, ADC_SOC_NUMBER0, DRV_ADC_TRIGGER,
+                 (ADC_Channel)DRV_ADC_IB_CHANNEL, DRV_ADC_ACQPS);
+    ADC_setupSOC(ADCA_BASE, ADC_SOC_NUMBER1, DRV_ADC_TRIGGER,
+                 (ADC_Channel)DRV_ADC_VDC_CHANNEL, DRV_ADC_ACQPS);
+    ADC_setupSOC(ADCA_BASE, ADC_SOC_NUMBER2, DRV_ADC_TRIGGER,
+                 (ADC_Channel)DRV_ADC_TEMP_CHANNEL, DRV_ADC_TEMP_ACQPS);
+
+    /* ADCINT1 只作为 CLA 触发源，连续模式下无需每次清除标志。 */
+    ADC_setInterruptSource(ADCA_BASE, ADC_INT_NUMBER1, ADC_SOC_NUMBER1);
+    ADC_enableContinuousMode(ADCA_BASE, ADC_INT_NUMBER1);
+    ADC_enableInterrupt(ADCA_BASE, ADC_INT_NUMBER1);
+    ADC_clearInterruptStatus(ADCA_BASE, ADC_INT_NUMBER1);
+}
+
+void DRV_ADC_read(uint16_t *ia, uint16_t *ib, uint16_t *vdc)
+{
+    if(ia != NULL)
+    {
+        *ia = ADC_readResult(ADCARESULT_BASE, ADC_SOC_NUMBER0);
+    }
+
+    if(ib != NULL)
+    {
+        *ib = ADC_readResult(ADCCRESULT_BASE, ADC_SOC_NUMBER0);
+    }
+
+    if(vdc != NULL)
+    {
+        *vdc = ADC_readResult(ADCARESULT_BASE, ADC_SOC_NUMBER1);
+    }
+}
+
+int16_t DRV_ADC_readTemperature(void)
+{
+    return ADC_getTemperatureC(ADC_readResult(ADCARESULT_BASE, ADC_SOC_NUMBER2), DRV_ADC_VREF);
+}
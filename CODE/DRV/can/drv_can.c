@@ -0,0 +1,621 @@
+/**
+ * @file drv_can.c
+ * @brief CANA 驱动的邮箱分配、接收队列与发送调度，不直接访问硬件。
+ */
+
+#include "drv_can.h"
+
+#include <stddef.h>
+
+#pragma CODE_SECTION(DRV_CAN_pushRx, "hotpath")
+#pragma CODE_SECTION(DRV_CAN_frameBits, "hotpath")
+
+/** 自适应限流的最小份额为设定值的 1/8，恢复步长为设定值的 1/32。 */
+#define DRV_CAN_SHARE_MIN_SHIFT     (3U)
+#define DRV_CAN_SHARE_STEP_SHIFT    (5U)
+
+/** 份额以 1/65536 为单位计算，避免整数百分比的截断。 */
+#define DRV_CAN_SHARE_ONE           (65536UL)
+
+/** 令牌桶最多积累的最长帧数。 */
+#define DRV_CAN_BURST_FRAMES        (8U)
+
+/** 最长帧（扩展帧、8 字节）的最坏情况位数。 */
+#define DRV_CAN_MAX_FRAME_BITS      (160U)
+
+/**
+ * @brief 发送报文。
+ */
+typedef struct
+{
+    uint32_t id;
+    uint16_t length;
+    uint16_t period;
+    uint16_t countdown;
+    uint16_t mailbox;
+    uint16_t bits;                  /**< 每帧最坏情况位数。 */
+    bool     due;                   /**< 等待装入。 */
+    bool     inFlight;              /**< 已装入，等待发出。 */
+    uint16_t data[8];
+} DRV_CAN_TxMessage;
+
+/**
+ * @brief 接收过滤器。
+ */
+typedef struct
+{
+    uint32_t id;
+    uint32_t mask;
+    uint16_t depth;
+} DRV_CAN_RxFilter;
+
+static DRV_CAN_TxMessage s_tx[DRV_CAN_MAX_TX];
+static uint16_t s_txCount = 0U;
+static uint16_t s_txOrder[DRV_CAN_MAX_TX];     /**< 按 ID 从小到大排列的句柄，即邮箱顺序。 */
+
+static DRV_CAN_RxFilter s_rx[DRV_CAN_MAX_RX_FILTERS];
+static uint16_t s_rxCount = 0U;
+
+/** 接收队列：中断只写 head，任务只写 tail。 */
+static volatile DRV_CAN_Frame s_rxQueue[DRV_CAN_RX_QUEUE_DEPTH];
+static volatile uint16_t s_rxHead = 0U;
+static volatile uint16_t s_rxTail = 0U;
+
+/** 中断更新的统计。 */
+static volatile uint32_t s_rxFrames = 0U;
+static volatile uint32_t s_rxDropped = 0U;
+static volatile uint32_t s_rxLost = 0U;
+static volatile uint32_t s_rxBits = 0U;
+
+static bool     s_started = false;
+static uint32_t s_tickHz = 1U;
+
+static DRV_CAN_Throttle s_throttle = DRV_CAN_THROTTLE_OFF;
+static uint32_t s_shareMax = DRV_CAN_SHARE_ONE;    /**< 设定份额。 */
+static uint32_t s_share = DRV_CAN_SHARE_ONE;       /**< 当前份额。 */
+
+/** 令牌桶，单位为 1 / (tickHz * DRV_CAN_SHARE_ONE) 位。 */
+static uint64_t s_credit = 0U;
+
+/** 总线负载窗口。 */
+static uint32_t s_windowBits = 0U;
+static uint32_t s_windowRxBits = 0U;
+static uint32_t s_windowTicks = 0U;
+
+static uint16_t s_busState = 0U;
+static uint16_t s_holdoff = 0U;
+
+static DRV_CAN_Stats s_stats;
+
+uint16_t DRV_CAN_frameBits(uint32_t id, uint16_t length)
+{
+    /* 控制域到 CRC 之间可被填充的位数：标准帧 34 + 8n，扩展帧 54 + 8n。 */
+    uint16_t stuffable = (uint16_t)((((id & DRV_CAN_ID_EXTENDED) != 0U) ? 54U : 34U) + (8U * length));
+
+    /* 另有 CRC 界定、应答、帧结束与帧间隔 13 位不填充。 */
+    return (uint16_t)(stuffable + 13U + ((stuffable - 1U) / 4U));
+}
+
+static bool DRV_CAN_isValidId(uint32_t id)
+{
+    uint32_t mask = ((id & DRV_CAN_ID_EXTENDED) != 0U) ? DRV_CAN_ID_EXT_MASK : DRV_CAN_ID_STD_MASK;
+
+    return ((id & ~DRV_CAN_ID_EXTENDED) & ~mask) == 0U;
+}
+
+/**
+ * @brief 扩展帧排在同值的标准帧之后：标准帧的 IDE 位为显性，仲裁时先于扩展帧。
+ */
+static uint32_t DRV_CAN_arbitrationKey(uint32_t id)
+{
+    if((id & DRV_CAN_ID_EXTENDED) != 0U)
+    {
+        return ((id & DRV_CAN_ID_EXT_MASK) << 1) | 1U;
+    }
+
+    return (id & DRV_CAN_ID_STD_MASK) << 19;
+}
+
+void DRV_CAN_init(uint32_t tickHz)
+{
+    uint16_t i;
+
+    s_tickHz   = (tickHz == 0U) ? 1U : tickHz;
+    s_txCount  = 0U;
+    s_rxCount  = 0U;
+    s_started  = false;
+    s_throttle = DRV_CAN_THROTTLE_OFF;
+    s_shareMax = DRV_CAN_SHARE_ONE;
+    s_share    = DRV_CAN_SHARE_ONE;
+    s_credit   = 0U;
+    s_rxTail   = s_rxHead;
+
+    s_rxFrames  = 0U;
+    s_rxDropped = 0U;
+    s_rxLost    = 0U;
+
+    s_windowBits   = 0U;
+    s_windowRxBits = s_rxBits;
+    s_windowTicks  = 0U;
+    s_busState     = 0U;
+    s_holdoff      = 0U;
+
+    s_stats.txFrames       = 0U;
+    s_stats.deferred       = 0U;
+    s_stats.busy           = 0U;
+    s_stats.overruns       = 0U;
+    s_stats.congestion     = 0U;
+    s_stats.busOff         = 0U;
+    s_stats.busLoadPercent = 0U;
+
+    for(i = 0U; i < DRV_CAN_MAX_TX; i++)
+    {
+        s_txOrder[i] = i;
+    }
+}
+
+uint16_t DRV_CAN_addTxMessage(uint32_t id, uint16_t length, uint16_t periodTicks)
+{
+    DRV_CAN_TxMessage *message;
+    uint16_t handle = s_txCount;
+    uint16_t i;
+
+    if(s_started || (handle >= DRV_CAN_MAX_TX) || (length > 8U) || !DRV_CAN_isValidId(id))
+    {
+        return DRV_CAN_INVALID_HANDLE;
+    }
+
+    message = &s_tx[handle];
+    message->id        = id;
+    message->length    = length;
+    message->period    = periodTicks;
+    message->countdown = 0U;
+    message->mailbox   = 0U;
+    message->bits      = DRV_CAN_frameBits(id, length);
+    message->due       = false;
+    message->inFlight  = false;
+
+    for(i = 0U; i < 8U; i++)
+    {
+        message->data[i] = 0U;
+    }
+
+    s_txCount = handle + 1U;
+
+    return handle;
+}
+
+bool DRV_CAN_addRxFilter(uint32_t id, uint32_t mask, uint16_t depth)
+{
+    if(s_started || (s_rxCount >= DRV_CAN_MAX_RX_FILTERS) || (depth == 0U) || !DRV_CAN_isValidId(id))
+    {
+        return false;
+    }
+
+    s_rx[s_rxCount].id    = id;
+    s_rx[s_rxCount].mask  = mask;
+    s_rx[s_rxCount].depth = depth;
+    s_rxCount++;
+
+    return true;
+}
+
+bool DRV_CAN_start(bool loopback)
+{
+    uint16_t mailbox = 1U;
+    uint16_t i;
+    uint16_t j;
+
+    if(s_started)
+    {
+        return false;
+    }
+
+    /* 插入排序，报文数很少。 */
+    for(i = 1U; i < s_txCount; i++)
+    {
+        uint16_t handle = s_txOrder[i];
+        uint32_t key = DRV_CAN_arbitrationKey(s_tx[handle].id);
+
+        for(j = i; (j > 0U) && (DRV_CAN_arbitrationKey(s_tx[s_txOrder[j - 1U]].id) > key); j--)
+        {
+            s_txOrder[j] = s_txOrder[j - 1U];
+        }
+
+        s_txOrder[j] = handle;
+    }
+
+    for(i = 0U; i < s_rxCount; i++)
+    {
+        mailbox += s_rx[i].depth;
+    }
+
+    if(((uint16_t)(mailbox - 1U) + s_txCount) > DRV_CAN_MAILBOXES)
+    {
+        return false;
+    }
+
+    if(!DRV_CAN_PORT_init(DRV_CAN_BITRATE, loopback))
+    {
+        return false;
+    }
+
+    mailbox = 1U;
+
+    for(i = 0U; i < s_txCount; i++)
+    {
+        DRV_CAN_TxMessage *message = &s_tx[s_txOrder[i]];
+
+        message->mailbox = mailbox;
+        DRV_CAN_PORT_setupTx(mailbox, message->id, message->length);
+        mailbox++;
+    }
+
+    for(i = 0U; i < s_rxCount; i++)
+    {
+        for(j = 0U; j < s_rx[i].depth; j++)
+        {
+            DRV_CAN_PORT_setupRx(mailbox, s_rx[i].id, s_rx[i].mask, (j + 1U) < s_rx[i].depth);
+            mailbox++;
+        }
+    }
+
+    s_started = true;
+    DRV_CAN_PORT_enable();
+
+    return true;
+}
+
+bool DRV_CAN_update(uint16_t handle, const uint16_t *data)
+{
+    DRV_CAN_TxMessage *message;
+    uint16_t i;
+
+    if((handle >= s_txCount) || (data == NULL))
+    {
+        return false;
+    }
+
+    message = &s_tx[handle];
+
+    for(i = 0U; i < message->length; i++)
+    {
+        message->data[i] = data[i] & 0xFFU;
+    }
+
+    return true;
+}
+
+bool DRV_CAN_send(uint16_t handle, const uint16_t *data)
+{
+    if(!DRV_CAN_update(handle, data))
+    {
+        return false;
+    }
+
+    s_tx[handle].due = true;
+
+    return true;
+}
+
+bool DRV_CAN_receive(DRV_CAN_Frame *frame)
+{
+    uint16_t tail = s_rxTail;
+    volatile const DRV_CAN_Frame *slot;
+    uint16_t i;
+
+    if((frame == NULL) || (tail == s_rxHead))
+    {
+        return false;
+    }
+
+    slot = &s_rxQueue[tail & DRV_CAN_RX_QUEUE_MASK];
+    frame->id     = slot->id;
+    frame->length = slot->length;
+
+    for(i = 0U; i < 8U; i++)
+    {
+        frame->data[i] = slot->data[i];
+    }
+
+    s_rxTail = tail + 1U;
+
+    return true;
+}
+
+void DRV_CAN_setThrottle(DRV_CAN_Throttle mode, uint16_t sharePercent)
+{
+    if(sharePercent == 0U)
+    {
+        sharePercent = 1U;
+    }
+    else if(sharePercent > 100U)
+    {
+        sharePercent = 100U;
+    }
+
+    s_throttle = mode;
+    s_shareMax = ((uint32_t)sharePercent * DRV_CAN_SHARE_ONE) / 100U;
+    s_share    = s_shareMax;
+    s_credit   = 0U;
+}
+
+/**
+ * @brief 统计已发出的帧，检测拥塞并调整自适应份额。
+ */
+static void DRV_CAN_trackCompletion(void)
+{
+    uint32_t pending = DRV_CAN_PORT_getTxPending();
+    bool congested = false;
+    uint16_t i;
+
+    for(i = 0U; i < s_txCount; i++)
+    {
+        DRV_CAN_TxMessage *message = &s_tx[i];
+
+        if(!message->inFlight)
+        {
+            continue;
+        }
+
+        if((pending & (1UL << (message->mailbox - 1U))) == 0U)
+        {
+            message->inFlight = false;
+            s_stats.txFrames++;
+            s_windowBits += message->bits;
+        }
+        else
+        {
+            congested = true;
+        }
+    }
+
+    if(s_throttle != DRV_CAN_THROTTLE_ADAPTIVE)
+    {
+        return;
+    }
+
+    if(congested)
+    {
+        uint32_t minimum = s_shareMax >> DRV_CAN_SHARE_MIN_SHIFT;
+
+        s_stats.congestion++;
+        s_share = ((s_share >> 1) > minimum) ? (s_share >> 1) : minimum;
+    }
+    else if(s_share < s_shareMax)
+    {
+        s_share += s_shareMax >> DRV_CAN_SHARE_STEP_SHIFT;
+
+        if(s_share > s_shareMax)
+        {
+            s_share = s_shareMax;
+        }
+    }
+}
+
+/**
+ * @brief 每秒更新一次总线负载估计。
+ */
+static void DRV_CAN_updateLoad(void)
+{
+    uint32_t rxBits = s_rxBits;
+
+    s_windowTicks++;
+
+    if(s_windowTicks < s_tickHz)
+    {
+        return;
+    }
+
+    s_stats.busLoadPercent = (uint16_t)((((uint64_t)s_windowBits + (uint32_t)(rxBits - s_windowRxBits)) * 100U) /
+                                        DRV_CAN_BITRATE);
+    s_windowBits   = 0U;
+    s_windowRxBits = rxBits;
+    s_windowTicks  = 0U;
+}
+
+/**
+ * @brief 总线关闭时停止装入，等待后重新恢复。
+ *
+ * @retval true 可以装入。
+ */
+static bool DRV_CAN_checkBus(void)
+{
+    uint16_t state = DRV_CAN_PORT_getBusState();
+
+    if(((state & DRV_CAN_BUS_OFF) != 0U) && ((s_busState & DRV_CAN_BUS_OFF) == 0U))
+    {
+        uint16_t i;
+
+        s_stats.busOff++;
+        s_holdoff = DRV_CAN_BUSOFF_HOLDOFF_TICKS;
+
+        /* 控制器进入初始化状态，邮箱中的请求随恢复一起发出，不再跟踪。 */
+        for(i = 0U; i < s_txCount; i++)
+        {
+            s_tx[i].inFlight = false;
+        }
+    }
+
+    s_busState = state;
+
+    if((state & DRV_CAN_BUS_OFF) == 0U)
+    {
+        return true;
+    }
+
+    if(s_holdoff > 0U)
+    {
+        s_holdoff--;
+
+        if(s_holdoff == 0U)
+        {
+            DRV_CAN_PORT_recover();
+        }
+    }
+
+    return false;
+}
+
+void DRV_CAN_service(void)
+{
+    uint64_t perTick;
+    uint64_t creditMax;
+    bool busAvailable;
+    bool limited = false;
+    uint16_t i;
+
+    if(!s_started)
+    {
+        return;
+    }
+
+    busAvailable = DRV_CAN_checkBus();
+
+    if(busAvailable)
+    {
+        DRV_CAN_trackCompletion();
+    }
+
+    DRV_CAN_updateLoad();
+
+    for(i = 0U; i < s_txCount; i++)
+    {
+        DRV_CAN_TxMessage *message = &s_tx[i];
+
+        if(message->period == 0U)
+        {
+            continue;
+        }
+
+        if(message->countdown > 0U)
+        {
+            message->countdown--;
+            continue;
+        }
+
+        message->countdown = message->period - 1U;
+
+        if(message->due)
+        {
+            s_stats.overruns++;
+        }
+
+        message->due = true;
+    }
+
+    if(!busAvailable)
+    {
+        return;
+    }
+
+    /* 令牌桶每个 tick 增加份额对应的位数，最多积累 DRV_CAN_BURST_FRAMES 个最长帧，空闲时不积累。 */
+    perTick   = (uint64_t)DRV_CAN_BITRATE * s_share;
+    creditMax = (uint64_t)DRV_CAN_BURST_FRAMES * DRV_CAN_MAX_FRAME_BITS * s_tickHz * DRV_CAN_SHARE_ONE;
+    s_credit += perTick;
+
+    if(s_credit > creditMax)
+    {
+        s_credit = creditMax;
+    }
+
+    /* 按 ID 优先级依次装入。 */
+    for(i = 0U; i < s_txCount; i++)
+    {
+        DRV_CAN_TxMessage *message = &s_tx[s_txOrder[i]];
+        uint64_t cost;
+
+        if(!message->due)
+        {
+            continue;
+        }
+
+        if(message->inFlight)
+        {
+            s_stats.busy++;
+            continue;
+        }
+
+        cost = (uint64_t)message->bits * s_tickHz * DRV_CAN_SHARE_ONE;
+
+        if(s_throttle != DRV_CAN_THROTTLE_OFF)
+        {
+            /* 优先级高的帧被推迟后，低优先级的帧也不再装入，保持严格的优先级顺序。 */
+            if(limited || (s_credit < cost))
+            {
+                limited = true;
+                s_stats.deferred++;
+                continue;
+            }
+
+            s_credit -= cost;
+        }
+
+        DRV_CAN_PORT_transmit(message->mailbox, message->data, message->length);
+        message->due      = false;
+        message->inFlight = true;
+    }
+
+    if(!limited)
+    {
+        bool anyDue = false;
+
+        for(i = 0U; i < s_txCount; i++)
+        {
+            anyDue = anyDue || s_tx[i].due;
+        }
+
+        if(!anyDue)
+        {
+            s_credit = (s_credit > perTick) ? perTick : s_credit;
+        }
+    }
+}
+
+void DRV_CAN_getStats(DRV_CAN_Stats *stats)
+{
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    *stats = s_stats;
+    stats->rxFrames     = s_rxFrames;
+    stats->rxDropped    = s_rxDropped;
+    stats->rxLost       = s_rxLost;
+    stats->busState     = s_busState;
+    stats->sharePercent = (uint16_t)(((((s_throttle == DRV_CAN_THROTTLE_OFF) ? DRV_CAN_SHARE_ONE : s_share) *
+                                       100U) + (DRV_CAN_SHARE_ONE / 2U)) / DRV_CAN_SHARE_ONE);
+}
+
+void DRV_CAN_pushRx(const DRV_CAN_Frame *frame, bool lost)
+{
+    uint16_t head = s_rxHead;
+    volatile DRV_CAN_Frame *slot;
+    uint16_t i;
+
+    if(lost)
+    {
+        s_rxLost++;
+    }
+
+    s_rxBits += DRV_CAN_frameBits(frame->id, frame->length);
+
+    if((uint16_t)(head - s_rxTail) >= DRV_CAN_RX_QUEUE_DEPTH)
+    {
+        s_rxDropped++;
+        return;
+    }
+
+    slot = &s_rxQueue[head & DRV_CAN_RX_QUEUE_MASK];
+    slot->id     = frame->id;
+    slot->length = frame->length;
+
+    for(i = 0U; i < 8U; i++)
+    {
+        slot->data[i] = frame->data[i];
+    }
+
+    s_rxHead = head + 1U;
+    s_rxFrames++;
+}
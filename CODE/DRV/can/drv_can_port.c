@@ -0,0 +1,192 @@
+/**
+ * @file drv_can_port.c
+ * @brief CANA 驱动的硬件接口，DriverLib 实现。
+ *
+ * 配置与发送经 DriverLib 使用 IF1；接收中断直接操作 IF2 读出报文，两者互不打断。
+ * 总线状态由任务读 ES 寄存器获得，不开启状态/错误中断，中断原因只会是邮箱编号。
+ */
+
+#include "drv_can.h"
+
+#include "driverlib.h"
+#include "device.h"
+
+#define DRV_CAN_BASE            (CANA_BASE)
+
+__interrupt void DRV_CAN_isr(void);
+
+#pragma CODE_SECTION(DRV_CAN_isr, "hotpath")
+
+static void DRV_CAN_configurePins(void)
+{
+    GPIO_setPinConfig(DEVICE_GPIO_CFG_CANRXA);
+    GPIO_setPinConfig(DEVICE_GPIO_CFG_CANTXA);
+
+    GPIO_setQualificationMode(DEVICE_GPIO_PIN_CANRXA, GPIO_QUAL_ASYNC);
+    GPIO_setPadConfig(DEVICE_GPIO_PIN_CANRXA, GPIO_PIN_TYPE_PULLUP);
+    GPIO_setPadConfig(DEVICE_GPIO_PIN_CANTXA, GPIO_PIN_TYPE_STD);
+}
+
+bool DRV_CAN_PORT_init(uint32_t bitRate, bool loopback)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_CANA);
+    DRV_CAN_configurePins();
+
+    /* 进入初始化状态并清空消息 RAM，全部邮箱无效。 */
+    CAN_initModule(DRV_CAN_BASE);
+    CAN_selectClockSource(DRV_CAN_BASE, CAN_CLOCK_SOURCE_SYS);
+    CAN_setBitRate(DRV_CAN_BASE, DEVICE_SYSCLK_FREQ, bitRate, DRV_CAN_BIT_QUANTA);
+
+    if(loopback)
+    {
+        CAN_enableTestMode(DRV_CAN_BASE, CAN_TEST_LBACK);
+    }
+
+    CAN_enableInterrupt(DRV_CAN_BASE, CAN_INT_IE0);
+    CAN_enableGlobalInterrupt(DRV_CAN_BASE, CAN_GLOBAL_INT_CANINT0);
+
+    Interrupt_register(INT_CANA0, &DRV_CAN_isr);
+    Interrupt_enable(INT_CANA0);
+
+    return true;
+}
+
+void DRV_CAN_PORT_setupTx(uint16_t mailbox, uint32_t id, uint16_t length)
+{
+    bool extended = (id & DRV_CAN_ID_EXTENDED) != 0U;
+
+    CAN_setupMessageObject(DRV_CAN_BASE, mailbox, id & DRV_CAN_ID_EXT_MASK,
+                           extended ? CAN_MSG_FRAME_EXT : CAN_MSG_FRAME_STD,
+                           CAN_MSG_OBJ_TYPE_TX, 0U, CAN_MSG_OBJ_NO_FLAGS, length);
+}
+
+void DRV_CAN_PORT_setupRx(uint16_t mailbox, uint32_t id, uint32_t mask, bool fifo)
+{
+    bool extended = (id & DRV_CAN_ID_EXTENDED) != 0U;
+
+    /* 同时比较 IDE 位，标准帧过滤器不会收到低位相同的扩展帧。 */
+    uint32_t flags = CAN_MSG_OBJ_RX_INT_ENABLE | CAN_MSG_OBJ_USE_ID_FILTER | CAN_MSG_OBJ_USE_EXT_FILTER;
+
+    if(fifo)
+    {
+        flags |= CAN_MSG_OBJ_FIFO;
+    }
+
+    CAN_setupMessageObject(DRV_CAN_BASE, mailbox, id & DRV_CAN_ID_EXT_MASK,
+                           extended ? CAN_MSG_FRAME_EXT : CAN_MSG_FRAME_STD,
+                           CAN_MSG_OBJ_TYPE_RX, mask & DRV_CAN_ID_EXT_MASK, flags, 0U);
+}
+
+void DRV_CAN_PORT_enable(void)
+{
+    CAN_startModule(DRV_CAN_BASE);
+}
+
+void DRV_CAN_PORT_transmit(uint16_t mailbox, const uint16_t *data, uint16_t length)
+{
+    CAN_sendMessage(DRV_CAN_BASE, mailbox, length, data);
+}
+
+uint32_t DRV_CAN_PORT_getTxPending(void)
+{
+    return CAN_getTxRequests(DRV_CAN_BASE);
+}
+
+uint16_t DRV_CAN_PORT_getBusState(void)
+{
+    uint16_t status = HWREGH(DRV_CAN_BASE + CAN_O_ES);
+    uint16_t state = 0U;
+
+    if((status & CAN_ES_EWARN) != 0U)
+    {
+        state |= DRV_CAN_BUS_WARNING;
+    }
+
+    if((status & CAN_ES_EPASS) != 0U)
+    {
+        state |= DRV_CAN_BUS_PASSIVE;
+    }
+
+    if((status & CAN_ES_BOFF) != 0U)
+    {
+        state |= DRV_CAN_BUS_OFF;
+    }
+
+    return state;
+}
+
+void DRV_CAN_PORT_recover(void)
+{
+    /* 清除 INIT 后控制器等待 128 次 11 个隐性位再回到总线。 */
+    CAN_startModule(DRV_CAN_BASE);
+}
+
+/**
+ * @brief 经 IF2 读出一个接收邮箱，同时清除中断挂起与新数据标志。
+ */
+static void DRV_CAN_readMailbox(uint16_t mailbox)
+{
+    DRV_CAN_Frame frame;
+    uint32_t arbitration;
+    uint16_t control;
+
+    HWREG_BP(DRV_CAN_BASE + CAN_O_IF2CMD) = CAN_IF2CMD_DATA_A | CAN_IF2CMD_DATA_B | CAN_IF2CMD_CONTROL |
+                                            CAN_IF2CMD_ARB | CAN_IF2CMD_CLRINTPND | CAN_IF2CMD_TXRQST |
+                                            (uint32_t)mailbox;
+
+    while((HWREGH(DRV_CAN_BASE + CAN_O_IF2CMD) & CAN_IF2CMD_BUSY) != 0U)
+    {
+    }
+
+    control     = HWREGH(DRV_CAN_BASE + CAN_O_IF2MCTL);
+    arbitration = HWREG_BP(DRV_CAN_BASE + CAN_O_IF2ARB);
+
+    if((arbitration & CAN_IF2ARB_XTD) != 0U)
+    {
+        frame.id = (arbitration & CAN_IF2ARB_ID_M) | DRV_CAN_ID_EXTENDED;
+    }
+    else
+    {
+        frame.id = (arbitration & CAN_IF2ARB_STD_ID_M) >> CAN_IF2ARB_STD_ID_S;
+    }
+
+    frame.length = control & CAN_IF2MCTL_DLC_M;
+
+    if(frame.length > 8U)
+    {
+        frame.length = 8U;
+    }
+
+    CAN_readDataReg(frame.data, DRV_CAN_BASE + CAN_O_IF2DATA, frame.length);
+
+    if((control & CAN_IF2MCTL_MSGLST) != 0U)
+    {
+        /* 写回控制字清除 MSGLST。 */
+        HWREGH(DRV_CAN_BASE + CAN_O_IF2MCTL) = control & ~(CAN_IF2MCTL_MSGLST | CAN_IF2MCTL_NEWDAT |
+                                                           CAN_IF2MCTL_INTPND);
+        HWREG_BP(DRV_CAN_BASE + CAN_O_IF2CMD) = CAN_IF2CMD_DIR | CAN_IF2CMD_CONTROL | (uint32_t)mailbox;
+
+        while((HWREGH(DRV_CAN_BASE + CAN_O_IF2CMD) & CAN_IF2CMD_BUSY) != 0U)
+        {
+        }
+    }
+
+    DRV_CAN_pushRx(&frame, (control & CAN_IF2MCTL_MSGLST) != 0U);
+}
+
+/**
+ * @brief CANA 中断 0，读出全部挂起的接收邮箱。
+ */
+__interrupt void DRV_CAN_isr(void)
+{
+    uint32_t cause = CAN_getInterruptCause(DRV_CAN_BASE);
+
+    while((cause > 0U) && (cause <= DRV_CAN_MAILBOXES))
+    {
+        DRV_CAN_readMailbox((uint16_t)cause);
+        cause = CAN_getInterruptCause(DRV_CAN_BASE);
+    }
+
+    CAN_clearGlobalInterruptStatus(DRV_CAN_BASE, CAN_GLOBAL_INT_CANINT0);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP9);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file drv_dma.c
+ * @brief DMA 驱动实现文件，ADC 结果到 RAMGS2 的双缓冲采集。
+ */
+
+#include "drv_dma.h"
+
+#include "driverlib.h"
+#include "device.h"
+
+#define DRV_DMA_BASE            (DMA_CH1_BASE)          /**< 使用的 DMA 通道。 */
+#define DRV_DMA_INT             (INT_DMA_CH1)
+#define DRV_DMA_TRIGGER         (DMA_TRIGGER_ADCA1)     /**< 与 CLA 任务 1 同源。 */
+
+/** burst 结束后源地址回到第一个结果寄存器。 */
+#define DRV_DMA_SRC_RETURN      ((int16_t)(-((int16_t)DRV_DMA_CHANNELS - 1) * DRV_DMA_SRC_STEP))
+
+/** 大于传输长度的回绕尺寸即不回绕。 */
+#define DRV_DMA_NO_WRAP         (0x10000UL)
+
+#pragma DATA_SECTION(DRV_DMA_buffer, "ramgs2")
+uint16_t DRV_DMA_buffer[DRV_DMA_BUFFER_WORDS];
+
+#pragma CODE_SECTION(DRV_DMA_isr, "hotpath")
+
+static bool s_initialized = false;
+static DRV_DMA_Callback s_callback = NULL;
+
+/** 已开始的传输次数，由中断更新；第 n 次传输写第 n 个窗口。 */
+static volatile uint32_t s_started = 0U;
+
+/** 下一个待读取的窗口序号，只由读者更新。 */
+static uint32_t s_readSequence = 0U;
+
+static uint32_t s_dropped = 0U;
+static uint32_t s_overruns = 0U;
+
+__interrupt void DRV_DMA_isr(void);
+
+static inline uint16_t *DRV_DMA_windowAddress(uint32_t sequence)
+{
+    return &DRV_DMA_buffer[(uint16_t)(sequence & 1U) * DRV_DMA_HALF_WORDS];
+}
+
+void DRV_DMA_init(void)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_DMA);
+
+    DMA_initController();
+    DMA_setEmulationMode(DMA_EMULATION_FREE_RUN);
+
+    /* burst 内按 SRC_STEP 依次读取结果寄存器，burst 结束后回到第一个寄存器。 */
+    DMA_configAddresses(DRV_DMA_BASE, DRV_DMA_windowAddress(0U),
+                        (const void *)DRV_DMA_SRC_ADDR);
+    DMA_configBurst(DRV_DMA_BASE, DRV_DMA_CHANNELS, DRV_DMA_SRC_STEP, 1);
+    DMA_configTransfer(DRV_DMA_BASE, DRV_DMA_HALF_SAMPLES, DRV_DMA_SRC_RETURN, 1);
+    DMA_configWrap(DRV_DMA_BASE, DRV_DMA_NO_WRAP, 0, DRV_DMA_NO_WRAP, 0);
+    DMA_configMode(DRV_DMA_BASE, DRV_DMA_TRIGGER,
+                   DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE | DMA_CFG_SIZE_16BIT);
+
+    /* 传输开始时中断：影子地址已装入，有一个窗口时长改写下一次的目标地址。 */
+    DMA_setInterruptMode(DRV_DMA_BASE, DMA_INT_AT_BEGINNING);
+    DMA_enableInterrupt(DRV_DMA_BASE);
+    DMA_enableTrigger(DRV_DMA_BASE);
+
+    Interrupt_register(DRV_DMA_INT, &DRV_DMA_isr);
+    Interrupt_enable(DRV_DMA_INT);
+
+    s_initialized = true;
+}
+
+void DRV_DMA_setCallback(DRV_DMA_Callback callback)
+{
+    s_callback = callback;
+}
+
+bool DRV_DMA_start(void)
+{
+    if(!s_initialized)
+    {
+        return false;
+    }
+
+    DMA_stopChannel(DRV_DMA_BASE);
+
+    s_started      = 0U;
+    s_readSequence = 0U;
+    s_dropped      = 0U;
+    s_overruns     = 0U;
+
+    DMA_configDestAddress(DRV_DMA_BASE, DRV_DMA_windowAddress(0U));
+    DMA_clearTriggerFlag(DRV_DMA_BASE);
+    DMA_clearErrorFlag(DRV_DMA_BASE);
+    DMA_startChannel(DRV_DMA_BASE);
+
+    return true;
+}
+
+void DRV_DMA_stop(void)
+{
+    DMA_stopChannel(DRV_DMA_BASE);
+}
+
+bool DRV_DMA_acquireWindow(DRV_DMA_Window *window)
+{
+    uint32_t started = s_started;
+    uint32_t completed;
+
+    if((window == NULL) || (started < 2U))
+    {
+        return false;
+    }
+
+    /* 第 started - 1 次传输正在进行，之前的窗口均已写满。 */
+    completed = started - 1U;
+
+    if(s_readSequence >= completed)
+    {
+        return false;
+    }
+
+    /* 只有最新的完整窗口不会在本窗口时长内被覆盖。 */
+    if((completed - s_readSequence) > 1U)
+    {
+        s_dropped += (completed - 1U) - s_readSequence;
+        s_readSequence = completed - 1U;
+    }
+
+    window->data     = DRV_DMA_windowAddress(s_readSequence);
+    window->samples  = DRV_DMA_HALF_SAMPLES;
+    window->channels = DRV_DMA_CHANNELS;
+    window->sequence = s_readSequence;
+
+    s_readSequence++;
+
+    return true;
+}
+
+bool DRV_DMA_releaseWindow(const DRV_DMA_Window *window)
+{
+    if(window == NULL)
+    {
+        return false;
+    }
+
+    /* 第 sequence + 2 次传输开始后同一半缓冲区被重新写入。 */
+    if(s_started > (window->sequence + 2U))
+    {
+        s_overruns++;
+        return false;
+    }
+
+    return true;
+}
+
+void DRV_DMA_getStats(DRV_DMA_Stats *stats)
+{
+    uint32_t started = s_started;
+
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    stats->windows  = (started > 0U) ? (started - 1U) : 0U;
+    stats->dropped  = s_dropped;
+    stats->overruns = s_overruns;
+}
+
+/**
+ * @brief DMA CH1 传输开始中断：准备下一次传输的目标地址并报告上一个窗口。
+ */
+__interrupt void DRV_DMA_isr(void)
+{
+    uint32_t started = s_started + 1U;
+
+    s_started = started;
+
+    /* 当前为第 started - 1 次传输，影子寄存器在下一次传输开始时装入。 */
+    DMA_configDestAddress(DRV_DMA_BASE, DRV_DMA_windowAddress(started));
+
+    if((started >= 2U) && (s_callback != NULL))
+    {
+        uint32_t sequence = started - 2U;
+
+        s_callback((uint16_t)(sequence & 1U), sequence);
+    }
+
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP7);
+}
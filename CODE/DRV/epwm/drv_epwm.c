@@ -9,6 +9,7 @@
 #include "driverlib/gpio.h"
 #include "driverlib/epwm.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 
 #define DRV_EPWM_DEFAULT_FREQUENCY_HZ      (20000UL) /**< 默认 PWM 开关频率，单位 Hz。 */
@@ -27,8 +28,16 @@ static float s_dutyCycle[DRV_EPWM_CHANNEL_COUNT] =
 }; /**< 各通道占空比缓存，用于延迟生效与状态查询。 */
 static uint16_t s_risingEdgeDelayCount = DRV_EPWM_DEFAULT_RED_COUNT; /**< 死区上升沿计数。 */
 static uint16_t s_fallingEdgeDelayCount = DRV_EPWM_DEFAULT_FED_COUNT; /**< 死区下降沿计数。 */
+static uint16_t s_period = 1U; /**< 当前时基周期值，初始化后由频率配置维护，供占空比更新直接使用。 */
 static bool s_initialized = false; /**< 驱动初始化标志。 */
 
+/* 占空比更新与中断应答在控制中断中调用，放在 RAM 中执行。 */
+#pragma CODE_SECTION(DRV_EPWM_setDutyCycle, "hotpath")
+#pragma CODE_SECTION(DRV_EPWM_convertDutyToCompare, "hotpath")
+#pragma CODE_SECTION(DRV_EPWM_clampDuty, "hotpath")
+#pragma CODE_SECTION(DRV_EPWM_trimPeriod, "hotpath")
+#pragma CODE_SECTION(DRV_EPWM_clearInterrupt, "hotpath")
+
 static const uint32_t s_epwmBase[DRV_EPWM_CHANNEL_COUNT] =
 {
     EPWM1_BASE,
@@ -50,6 +59,8 @@ static const uint32_t s_gpioPinConfigB[DRV_EPWM_CHANNEL_COUNT] =
     GPIO_5_EPWM3B
 }; /**< ePWM B 相引脚复用配置表。 */
 
+#define DRV_EPWM_INT_BASE                  (EPWM1_BASE) /**< 产生周期中断的 ePWM 模块。 */
+
 static const uint32_t s_gpioPinA[DRV_EPWM_CHANNEL_COUNT] = { 0U, 2U, 4U }; /**< ePWM A 相 GPIO 序号表。 */
 static const uint32_t s_gpioPinB[DRV_EPWM_CHANNEL_COUNT] = { 1U, 3U, 5U }; /**< ePWM B 相 GPIO 序号表。 */
 
@@ -282,6 +293,7 @@ void DRV_EPWM_init(void)
 
     SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
 
+    s_period = period;
     s_initialized = true;
 }
 
@@ -321,6 +333,7 @@ bool DRV_EPWM_setFrequency(uint32_t frequencyHz)
 
     SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_TBCLKSYNC);
 
+    s_period = period;
     s_frequencyHz = frequencyHz;
     return true;
 }
@@ -336,7 +349,6 @@ bool DRV_EPWM_setFrequency(uint32_t frequencyHz)
  */
 bool DRV_EPWM_setDutyCycle(uint32_t channelIndex, float dutyCycle)
 {
-    uint16_t period;
     uint16_t compare;
 
     if(channelIndex >= DRV_EPWM_CHANNEL_COUNT)
@@ -344,21 +356,18 @@ bool DRV_EPWM_setDutyCycle(uint32_t channelIndex, float dutyCycle)
         return false;
     }
 
-    if(!DRV_EPWM_calculatePeriod(s_frequencyHz, &period))
-    {
-        return false;
-    }
-
     dutyCycle = DRV_EPWM_clampDuty(dutyCycle);
-    compare = DRV_EPWM_convertDutyToCompare(dutyCycle, period);
-
     s_dutyCycle[channelIndex] = dutyCycle;
 
+    /* 初始化前只缓存占空比，由 DRV_EPWM_init 换算比较值。 */
     if(!s_initialized)
     {
         return true;
     }
 
+    /* 使用缓存的周期值，避免在控制中断中做 64 位除法。 */
+    compare = DRV_EPWM_convertDutyToCompare(dutyCycle, s_period);
+
     EPWM_setCounterCompareValue(s_epwmBase[channelIndex],
                                 EPWM_COUNTER_COMPARE_A,
                                 compare);
@@ -414,3 +423,116 @@ void DRV_EPWM_getState(DRV_EPWM_State *state)
         state->dutyCycle[index] = s_dutyCycle[index];
     }
 }
+
+/**
+ * @brief 返回一个 PWM 周期对应的 SYSCLK 周期数。
+ *
+ * 增减计数模式下一个周期为 2 * TBPRD 个 TBCLK。
+ */
+uint32_t DRV_EPWM_getPeriodCycles(void)
+{
+    uint16_t period;
+
+    if(!DRV_EPWM_calculatePeriod(s_frequencyHz, &period))
+    {
+        return 0U;
+    }
+
+    return 2UL * (uint32_t)period * DRV_EPWM_TBCLK_DIVIDER * DRV_EPWM_TBCLK_HS_DIVIDER;
+}
+
+/**
+ * @brief 使能 ePWM1 计数器归零时刻的周期中断。
+ *
+ * @param[in] eventCount 中断分频，取值 1~DRV_EPWM_INT_MAX_EVENTS。
+ *
+ * @retval true  配置成功。
+ * @retval false 参数非法或驱动尚未初始化。
+ */
+bool DRV_EPWM_enableInterrupt(uint16_t eventCount)
+{
+    if((eventCount == 0U) || (eventCount > DRV_EPWM_INT_MAX_EVENTS) || !s_initialized)
+    {
+        return false;
+    }
+
+    EPWM_disableInterrupt(DRV_EPWM_INT_BASE);
+    EPWM_setInterruptSource(DRV_EPWM_INT_BASE, EPWM_INT_TBCTR_ZERO);
+    EPWM_setInterruptEventCount(DRV_EPWM_INT_BASE, eventCount);
+    EPWM_clearEventTriggerInterruptFlag(DRV_EPWM_INT_BASE);
+    EPWM_enableInterrupt(DRV_EPWM_INT_BASE);
+
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+    Interrupt_enable(INT_EPWM1);
+
+    return true;
+}
+
+/**
+ * @brief 关闭 ePWM1 周期中断。
+ */
+void DRV_EPWM_disableInterrupt(void)
+{
+    Interrupt_disable(INT_EPWM1);
+    EPWM_disableInterrupt(DRV_EPWM_INT_BASE);
+    EPWM_clearEventTriggerInterruptFlag(DRV_EPWM_INT_BASE);
+}
+
+/**
+ * @brief 清除 ePWM1 中断标志并应答 PIE 组 3。
+ */
+void DRV_EPWM_clearInterrupt(void)
+{
+    EPWM_clearEventTriggerInterruptFlag(DRV_EPWM_INT_BASE);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP3);
+}
+
+/**
+ * @brief 使能 ePWM1 周期点的 ADC SOCA 触发。
+ *
+ * @retval true  配置成功。
+ * @retval false 驱动尚未初始化。
+ */
+bool DRV_EPWM_enableAdcTrigger(void)
+{
+    if(!s_initialized)
+    {
+        return false;
+    }
+
+    EPWM_disableADCTrigger(DRV_EPWM_INT_BASE, EPWM_SOC_A);
+    EPWM_setADCTriggerSource(DRV_EPWM_INT_BASE, EPWM_SOC_A, EPWM_SOC_TBCTR_PERIOD);
+    EPWM_setADCTriggerEventPrescale(DRV_EPWM_INT_BASE, EPWM_SOC_A, 1U);
+    EPWM_clearADCTriggerFlag(DRV_EPWM_INT_BASE, EPWM_SOC_A);
+    EPWM_enableADCTrigger(DRV_EPWM_INT_BASE, EPWM_SOC_A);
+
+    return true;
+}
+
+/**
+ * @brief 微调三路 ePWM 的周期值。
+ *
+ * @param[in] counts 相对标称周期值的微调量。
+ *
+ * @retval true  配置成功。
+ * @retval false 驱动尚未初始化或微调量超过周期值的 1/8。
+ */
+bool DRV_EPWM_trimPeriod(int16_t counts)
+{
+    int32_t period = (int32_t)s_period + (int32_t)counts;
+    uint32_t index;
+
+    if(!s_initialized || (counts > (int16_t)(s_period / 8U)) || (counts < -(int16_t)(s_period / 8U)) ||
+       (period > (int32_t)UINT16_MAX))
+    {
+        return false;
+    }
+
+    /* 周期值默认经影子寄存器装入，三路在同一次归零时同时生效。 */
+    for(index = 0U; index < DRV_EPWM_CHANNEL_COUNT; index++)
+    {
+        EPWM_setTimeBasePeriod(s_epwmBase[index], (uint16_t)period);
+    }
+
+    return true;
+}
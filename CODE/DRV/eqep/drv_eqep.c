@@ -0,0 +1,242 @@
+/**
+ * @file drv_eqep.c
+ * @brief eQEP1 驱动的测速、零位检查与电角度计算，不直接访问硬件。
+ */
+
+#include "drv_eqep.h"
+
+#include <stddef.h>
+
+#pragma CODE_SECTION(DRV_EQEP_updateAngle, "hotpath")
+#pragma CODE_SECTION(DRV_EQEP_onEvents, "hotpath")
+
+/** 频率法：每个单位周期一个计数对应的转速（转/秒）。 */
+#define DRV_EQEP_FREQ_SCALE         ((float)DRV_EQEP_UNIT_HZ / (float)DRV_EQEP_COUNTS_PER_REV)
+
+/** 周期法：转速 = DRV_EQEP_PERIOD_SCALE / 捕获周期。 */
+#define DRV_EQEP_PERIOD_SCALE       ((float)DRV_EQEP_UPEVNT_COUNTS * (float)DRV_EQEP_CAPCLK_HZ / \
+                                     (float)DRV_EQEP_COUNTS_PER_REV)
+
+volatile DRV_EQEP_Output DRV_EQEP_output;
+
+static bool     s_ready = false;
+static float    s_offsetPu = 0.0f;
+static uint32_t s_lastPosition = 0U;
+static uint16_t s_skipSamples = 0U;
+static DRV_EQEP_Mode s_mode = DRV_EQEP_MODE_PERIOD;
+
+static DRV_EQEP_Stats s_stats;
+
+/**
+ * @brief 两个计数器值之差，按每转计数回绕到 [-半转, 半转)。
+ */
+static int32_t DRV_EQEP_wrapDelta(uint32_t to, uint32_t from)
+{
+    int32_t delta = (int32_t)to - (int32_t)from;
+
+    if(delta >= (int32_t)(DRV_EQEP_COUNTS_PER_REV / 2U))
+    {
+        delta -= (int32_t)DRV_EQEP_COUNTS_PER_REV;
+    }
+    else if(delta < -(int32_t)(DRV_EQEP_COUNTS_PER_REV / 2U))
+    {
+        delta += (int32_t)DRV_EQEP_COUNTS_PER_REV;
+    }
+
+    return delta;
+}
+
+bool DRV_EQEP_init(void)
+{
+    s_ready        = false;
+    s_offsetPu     = 0.0f;
+    s_lastPosition = 0U;
+    s_skipSamples  = 0U;
+    s_mode         = DRV_EQEP_MODE_PERIOD;
+
+    s_stats.unitEvents       = 0U;
+    s_stats.indexEvents      = 0U;
+    s_stats.indexErrors      = 0U;
+    s_stats.lastIndexError   = 0;
+    s_stats.modeSwitches     = 0U;
+    s_stats.captureOverflows = 0U;
+    s_stats.captureDirErrors = 0U;
+
+    DRV_EQEP_output.anglePu     = 0.0f;
+    DRV_EQEP_output.speedRps    = 0.0f;
+    DRV_EQEP_output.elecSpeedHz = 0.0f;
+    DRV_EQEP_output.position    = 0U;
+    DRV_EQEP_output.mode        = (uint16_t)DRV_EQEP_MODE_PERIOD;
+    DRV_EQEP_output.aligned     = 0U;
+
+    /* 计数器从 0 开始，首个单位周期的增量以 0 为基准。 */
+    if(!DRV_EQEP_PORT_init())
+    {
+        return false;
+    }
+
+    s_ready = true;
+
+    return true;
+}
+
+void DRV_EQEP_setAngleOffset(float offsetPu)
+{
+    offsetPu -= (float)(int32_t)offsetPu;
+
+    if(offsetPu < 0.0f)
+    {
+        offsetPu += 1.0f;
+    }
+
+    s_offsetPu = offsetPu;
+}
+
+float DRV_EQEP_getAngleOffset(void)
+{
+    return s_offsetPu;
+}
+
+float DRV_EQEP_updateAngle(void)
+{
+    uint32_t position = DRV_EQEP_PORT_getPosition();
+    float angle = DRV_EQEP_angleFromPosition(position, s_offsetPu);
+
+    DRV_EQEP_output.position = position;
+    DRV_EQEP_output.anglePu  = angle;
+
+    return angle;
+}
+
+/**
+ * @brief 零位事件：第一个零位完成对齐，之后检查锁存值。
+ */
+static void DRV_EQEP_onIndex(const DRV_EQEP_Latch *latch)
+{
+    int32_t error;
+
+    s_stats.indexEvents++;
+
+    if(DRV_EQEP_output.aligned == 0U)
+    {
+        /* 第一个零位前的计数只相对上电位置，复位造成的跳变不是转速。 */
+        DRV_EQEP_output.aligned = 1U;
+        s_skipSamples = DRV_EQEP_SKIP_AFTER_ALIGN;
+        return;
+    }
+
+    error = DRV_EQEP_wrapDelta(latch->indexPosition, 0U);
+
+    if((error > DRV_EQEP_INDEX_TOLERANCE) || (error < -DRV_EQEP_INDEX_TOLERANCE))
+    {
+        s_stats.indexErrors++;
+        s_stats.lastIndexError = error;
+    }
+}
+
+/**
+ * @brief 周期法转速，无有效样本时为 0。
+ */
+static float DRV_EQEP_periodSpeed(const DRV_EQEP_Latch *latch)
+{
+    uint16_t period;
+    float speed;
+
+    if((latch->status & DRV_EQEP_STS_CAP_OVERFLOW) != 0U)
+    {
+        s_stats.captureOverflows++;
+        return 0.0f;
+    }
+
+    if((latch->status & DRV_EQEP_STS_CAP_DIR_ERROR) != 0U)
+    {
+        s_stats.captureDirErrors++;
+        return 0.0f;
+    }
+
+    /* 上次事件以来的时间已超过上一个周期时，以它为周期，减速时不保持旧值。 */
+    period = (latch->captureTimer > latch->capturePeriod) ? latch->captureTimer : latch->capturePeriod;
+
+    if(period == 0U)
+    {
+        return DRV_EQEP_output.speedRps;
+    }
+
+    speed = DRV_EQEP_PERIOD_SCALE / (float)period;
+
+    return ((latch->status & DRV_EQEP_STS_FORWARD) != 0U) ? speed : -speed;
+}
+
+/**
+ * @brief 单位超时：按位置增量选择测速方法并更新转速。
+ */
+static void DRV_EQEP_onUnitTimeout(const DRV_EQEP_Latch *latch)
+{
+    int32_t delta = DRV_EQEP_wrapDelta(latch->position, s_lastPosition);
+    uint32_t magnitude = (delta < 0) ? (uint32_t)(-delta) : (uint32_t)delta;
+    float speed;
+
+    s_stats.unitEvents++;
+    s_lastPosition = latch->position;
+
+    if(s_skipSamples != 0U)
+    {
+        s_skipSamples--;
+        return;
+    }
+
+    if((s_mode == DRV_EQEP_MODE_FREQUENCY) && (magnitude < DRV_EQEP_TO_PERIOD_COUNTS))
+    {
+        s_mode = DRV_EQEP_MODE_PERIOD;
+        s_stats.modeSwitches++;
+    }
+    else if((s_mode == DRV_EQEP_MODE_PERIOD) && (magnitude > DRV_EQEP_TO_FREQ_COUNTS))
+    {
+        s_mode = DRV_EQEP_MODE_FREQUENCY;
+        s_stats.modeSwitches++;
+    }
+    else
+    {
+    }
+
+    if(s_mode == DRV_EQEP_MODE_FREQUENCY)
+    {
+        speed = (float)delta * DRV_EQEP_FREQ_SCALE;
+    }
+    else
+    {
+        speed = DRV_EQEP_periodSpeed(latch);
+    }
+
+    DRV_EQEP_output.speedRps    = speed;
+    DRV_EQEP_output.elecSpeedHz = speed * (float)DRV_EQEP_POLE_PAIRS;
+    DRV_EQEP_output.mode        = (uint16_t)s_mode;
+}
+
+void DRV_EQEP_onEvents(uint16_t events, const DRV_EQEP_Latch *latch)
+{
+    if(!s_ready || (latch == NULL))
+    {
+        return;
+    }
+
+    if((events & DRV_EQEP_EVT_INDEX) != 0U)
+    {
+        DRV_EQEP_onIndex(latch);
+    }
+
+    if((events & DRV_EQEP_EVT_UNIT_TIMEOUT) != 0U)
+    {
+        DRV_EQEP_onUnitTimeout(latch);
+    }
+}
+
+void DRV_EQEP_getStats(DRV_EQEP_Stats *stats)
+{
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    *stats = s_stats;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file drv_eqep_port.c
+ * @brief eQEP1 驱动的硬件接口，DriverLib 实现。
+ *
+ * 引脚为 LaunchPad QEP1 接口：EQEP1A GPIO35、EQEP1B GPIO37、EQEP1I GPIO59，同步采样。
+ * 计数器按零位复位（QPOSMAX = 每转计数 - 1），单位超时锁存位置与捕获值，零位上升沿
+ * 锁存复位前的位置。中断 INT_EQEP1（第 5 组）响应单位超时与零位锁存。CLA 任务 1
+ * 直接读取 QPOSCNT，初始化时开放 CLA1 对 eQEP1 的访问。
+ */
+
+#include "drv_eqep.h"
+
+#include "driverlib.h"
+#include "device.h"
+
+#define DRV_EQEP_BASE           (EQEP1_BASE)
+
+#define DRV_EQEP_INT_EVENTS     (EQEP_INT_UNIT_TIME_OUT | EQEP_INT_INDEX_EVNT_LATCH)
+
+/** 捕获单元的粘滞状态，每个单位周期清除一次。 */
+#define DRV_EQEP_CAP_STATUS     (EQEP_STS_CAP_OVRFLW_ERROR | EQEP_STS_CAP_DIR_ERROR | EQEP_STS_UNIT_POS_EVNT)
+
+__interrupt void DRV_EQEP_isr(void);
+
+#pragma CODE_SECTION(DRV_EQEP_isr, "hotpath")
+#pragma CODE_SECTION(DRV_EQEP_PORT_getPosition, "hotpath")
+
+static void DRV_EQEP_configurePins(void)
+{
+    GPIO_setPinConfig(GPIO_35_EQEP1_A);
+    GPIO_setPinConfig(GPIO_37_EQEP1_B);
+    GPIO_setPinConfig(GPIO_59_EQEP1_INDEX);
+
+    GPIO_setQualificationMode(35U, GPIO_QUAL_SYNC);
+    GPIO_setQualificationMode(37U, GPIO_QUAL_SYNC);
+    GPIO_setQualificationMode(59U, GPIO_QUAL_SYNC);
+}
+
+bool DRV_EQEP_PORT_init(void)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_EQEP1);
+    SysCtl_setPeripheralAccessControl(SYSCTL_ACCESS_EQEP1, SYSCTL_ACCESS_CLA1, SYSCTL_ACCESS_FULL);
+    DRV_EQEP_configurePins();
+
+    /* 正交输入，A、B 两路的上升沿与下降沿均计数。 */
+    EQEP_setDecoderConfig(DRV_EQEP_BASE, EQEP_CONFIG_2X_RESOLUTION | EQEP_CONFIG_QUADRATURE |
+                                         EQEP_CONFIG_NO_SWAP);
+    EQEP_setEmulationMode(DRV_EQEP_BASE, EQEP_EMULATIONMODE_RUNFREE);
+
+    EQEP_setPositionCounterConfig(DRV_EQEP_BASE, EQEP_POSITION_RESET_IDX,
+                                  DRV_EQEP_COUNTS_PER_REV - 1UL);
+    EQEP_setPosition(DRV_EQEP_BASE, 0U);
+
+    EQEP_setLatchMode(DRV_EQEP_BASE, EQEP_LATCH_UNIT_TIME_OUT | EQEP_LATCH_RISING_INDEX);
+    EQEP_enableUnitTimer(DRV_EQEP_BASE, DRV_EQEP_UNIT_PERIOD_CYCLES);
+
+    EQEP_setCaptureConfig(DRV_EQEP_BASE, EQEP_CAPTURE_CLK_DIV_128, EQEP_UNIT_POS_EVNT_DIV_4);
+    EQEP_enableCapture(DRV_EQEP_BASE);
+
+    EQEP_enableModule(DRV_EQEP_BASE);
+
+    EQEP_clearStatus(DRV_EQEP_BASE, DRV_EQEP_CAP_STATUS);
+    EQEP_clearInterruptStatus(DRV_EQEP_BASE, DRV_EQEP_INT_EVENTS | EQEP_INT_GLOBAL);
+    EQEP_enableInterrupt(DRV_EQEP_BASE, DRV_EQEP_INT_EVENTS);
+
+    Interrupt_register(INT_EQEP1, &DRV_EQEP_isr);
+    Interrupt_enable(INT_EQEP1);
+
+    return true;
+}
+
+uint32_t DRV_EQEP_PORT_getPosition(void)
+{
+    return EQEP_getPosition(DRV_EQEP_BASE);
+}
+
+__interrupt void DRV_EQEP_isr(void)
+{
+    uint16_t flags = EQEP_getInterruptStatus(DRV_EQEP_BASE) & DRV_EQEP_INT_EVENTS;
+    uint16_t status = EQEP_getStatus(DRV_EQEP_BASE);
+    uint16_t events = 0U;
+    DRV_EQEP_Latch latch;
+
+    latch.position      = EQEP_getPositionLatch(DRV_EQEP_BASE);
+    latch.indexPosition = EQEP_getIndexPositionLatch(DRV_EQEP_BASE);
+    latch.capturePeriod = EQEP_getCapturePeriodLatch(DRV_EQEP_BASE);
+    latch.captureTimer  = EQEP_getCaptureTimerLatch(DRV_EQEP_BASE);
+    latch.status        = 0U;
+
+    if((status & EQEP_STS_DIR_FLAG) != 0U)
+    {
+        latch.status |= DRV_EQEP_STS_FORWARD;
+    }
+
+    if((status & EQEP_STS_CAP_OVRFLW_ERROR) != 0U)
+    {
+        latch.status |= DRV_EQEP_STS_CAP_OVERFLOW;
+    }
+
+    if((status & EQEP_STS_CAP_DIR_ERROR) != 0U)
+    {
+        latch.status |= DRV_EQEP_STS_CAP_DIR_ERROR;
+    }
+
+    if((flags & EQEP_INT_INDEX_EVNT_LATCH) != 0U)
+    {
+        events |= DRV_EQEP_EVT_INDEX;
+    }
+
+    if((flags & EQEP_INT_UNIT_TIME_OUT) != 0U)
+    {
+        events |= DRV_EQEP_EVT_UNIT_TIMEOUT;
+        EQEP_clearStatus(DRV_EQEP_BASE, status & DRV_EQEP_CAP_STATUS);
+    }
+
+    DRV_EQEP_onEvents(events, &latch);
+
+    EQEP_clearInterruptStatus(DRV_EQEP_BASE, flags | EQEP_INT_GLOBAL);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP5);
+}
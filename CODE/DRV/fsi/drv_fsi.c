@@ -0,0 +1,446 @@
+/**
+ * @file drv_fsi.c
+ * @brief FSIA 驱动的帧组装、接收校验与 PWM 同步，不直接访问硬件。
+ */
+
+#include "drv_fsi.h"
+
+#include <stddef.h>
+
+#pragma CODE_SECTION(DRV_FSI_send, "hotpath")
+#pragma CODE_SECTION(DRV_FSI_receive, "hotpath")
+#pragma CODE_SECTION(DRV_FSI_crc16, "hotpath")
+#pragma CODE_SECTION(DRV_FSI_updateSync, "hotpath")
+
+/** 微调量以 1/16 计数计算：比例 1/4，积分 1/16，积分器即以 1/16 计数为单位。 */
+#define DRV_FSI_SYNC_FRAC           (16)
+#define DRV_FSI_SYNC_KP_MUL         (4)
+
+/** 发送暂存区与接收环形缓冲区须位于 DMA 可访问的 GS RAM。 */
+#pragma DATA_SECTION(DRV_FSI_txStage, "ramgs3")
+uint16_t DRV_FSI_txStage[2][DRV_FSI_FRAME_WORDS];
+
+#pragma DATA_SECTION(DRV_FSI_rxRing, "ramgs3")
+uint16_t DRV_FSI_rxRing[DRV_FSI_RX_SLOTS * DRV_FSI_SLOT_WORDS];
+
+/** 按 4 bit 查表计算 CRC16，表只占 16 个字。 */
+static const uint16_t s_crcTable[16] =
+{
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+};
+
+static bool     s_running = false;
+static bool     s_syncEnabled = false;
+static uint16_t s_period = 0U;
+static uint16_t s_latency = DRV_FSI_SYNC_LATENCY_COUNTS;
+
+static uint16_t s_txNext = 0U;
+static uint16_t s_txSequence = 0U;
+
+/** 最近处理过的槽，槽号、时间戳与序号都相同视为同一次到达。 */
+static uint16_t s_lastSlot = DRV_FSI_RX_SLOTS - 1U;
+static uint16_t s_lastStamp[DRV_FSI_STAMP_WORDS];
+static uint16_t s_lastSeqWord = 0U;
+
+static uint16_t s_lastSequence = 0U;
+static bool     s_haveSequence = false;
+
+static int32_t  s_integral = 0;
+static int32_t  s_residual = 0;             /**< 取整余下的小数部分，累加到下一帧。 */
+static uint16_t s_lockCount = 0U;
+static uint16_t s_outlierRun = 0U;
+
+/** 中断更新的字段。 */
+static volatile bool     s_linkUp = false;
+static volatile bool     s_locked = false;
+static volatile uint32_t s_linkDowns = 0U;
+static volatile uint32_t s_hwCrcErrors = 0U;
+static volatile uint32_t s_frameErrors = 0U;
+static volatile uint32_t s_overruns = 0U;
+
+static uint32_t s_txFrames = 0U;
+static uint32_t s_rxFrames = 0U;
+static uint32_t s_rxLost = 0U;
+static uint32_t s_repeats = 0U;
+static uint32_t s_crcErrors = 0U;
+static uint32_t s_torn = 0U;
+static uint32_t s_outliers = 0U;
+static int16_t  s_phaseError = 0;
+static int16_t  s_trim = 0;
+static uint16_t s_arrivalLatency = 0U;
+
+uint16_t DRV_FSI_crc16(uint16_t crc, const uint16_t *data, uint16_t length)
+{
+    uint16_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        uint16_t word = data[i];
+
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (word >> 12)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (word >> 8)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ (word >> 4)) & 0xFU]);
+        crc = (uint16_t)((crc << 4) ^ s_crcTable[((crc >> 12) ^ word) & 0xFU]);
+    }
+
+    return crc;
+}
+
+/**
+ * @brief 在暂存区的一半中组装一帧。
+ */
+static void DRV_FSI_buildFrame(uint16_t *frame, const uint16_t *payload)
+{
+    uint16_t i;
+
+    for(i = 0U; i < DRV_FSI_PAYLOAD_WORDS; i++)
+    {
+        frame[i] = (payload != NULL) ? payload[i] : 0U;
+    }
+
+    frame[DRV_FSI_SEQ_INDEX] = s_txSequence;
+    frame[DRV_FSI_CRC_INDEX] = DRV_FSI_crc16(0xFFFFU, frame, DRV_FSI_CRC_INDEX);
+    s_txSequence++;
+}
+
+bool DRV_FSI_init(DRV_FSI_Role role, bool loopback)
+{
+    uint16_t i;
+
+    s_running      = false;
+    s_syncEnabled  = (role == DRV_FSI_ROLE_SLAVE) && !loopback;
+    s_txSequence   = 0U;
+    s_haveSequence = false;
+    s_integral     = 0;
+    s_residual     = 0;
+    s_lockCount    = 0U;
+    s_outlierRun   = 0U;
+
+    s_linkUp       = false;
+    s_locked       = false;
+    s_linkDowns    = 0U;
+    s_hwCrcErrors  = 0U;
+    s_frameErrors  = 0U;
+    s_overruns     = 0U;
+
+    s_txFrames     = 0U;
+    s_rxFrames     = 0U;
+    s_rxLost       = 0U;
+    s_repeats      = 0U;
+    s_crcErrors    = 0U;
+    s_torn         = 0U;
+    s_outliers     = 0U;
+    s_phaseError   = 0;
+    s_trim         = 0;
+    s_arrivalLatency = 0U;
+
+    /* 环形缓冲区清零，并把全零的槽记为已处理，DMA 写入第一帧前不会误报 CRC 错误。 */
+    for(i = 0U; i < (DRV_FSI_RX_SLOTS * DRV_FSI_SLOT_WORDS); i++)
+    {
+        DRV_FSI_rxRing[i] = 0U;
+    }
+
+    s_lastSlot     = DRV_FSI_RX_SLOTS - 1U;
+    s_lastStamp[0] = 0U;
+    s_lastStamp[1] = 0U;
+    s_lastSeqWord  = 0U;
+
+    if(!DRV_FSI_PORT_init(loopback, DRV_FSI_rxRing))
+    {
+        return false;
+    }
+
+    s_period = DRV_FSI_PORT_getPeriod();
+
+    if(s_syncEnabled)
+    {
+        DRV_FSI_PORT_trimPeriod(0);
+    }
+
+    DRV_FSI_buildFrame(DRV_FSI_txStage[0], NULL);
+    s_txNext = 1U;
+    DRV_FSI_PORT_start(DRV_FSI_txStage[0]);
+
+    s_running = true;
+
+    return true;
+}
+
+bool DRV_FSI_send(const uint16_t *payload)
+{
+    uint16_t *frame;
+
+    if(!s_running || (payload == NULL))
+    {
+        return false;
+    }
+
+    /* DMA 只读上一次设置的一半，写另一半不会与搬运冲突。 */
+    frame = DRV_FSI_txStage[s_txNext];
+    DRV_FSI_buildFrame(frame, payload);
+    DRV_FSI_PORT_setTxSource(frame);
+
+    s_txNext ^= 1U;
+    s_txFrames++;
+
+    return true;
+}
+
+static int16_t DRV_FSI_clamp(int32_t value, int32_t limit)
+{
+    if(value > limit)
+    {
+        return (int16_t)limit;
+    }
+
+    if(value < -limit)
+    {
+        return (int16_t)(-limit);
+    }
+
+    return (int16_t)value;
+}
+
+static int32_t DRV_FSI_abs(int32_t value)
+{
+    return (value < 0) ? -value : value;
+}
+
+/**
+ * @brief 从板锁相：按到达时刻调整 TBPRD。
+ *
+ * @param[in] arrival 到达时距本板归零的计数。
+ */
+static void DRV_FSI_updateSync(uint16_t arrival)
+{
+    int32_t error = ((int32_t)s_period - (int32_t)s_latency) - (int32_t)arrival;
+    int32_t magnitude;
+    int32_t output;
+    int32_t trim;
+
+    /* 归到 [-TBPRD, TBPRD)，即相差不超过半个 PWM 周期。 */
+    if(error >= (int32_t)s_period)
+    {
+        error -= 2 * (int32_t)s_period;
+    }
+    else if(error < -(int32_t)s_period)
+    {
+        error += 2 * (int32_t)s_period;
+    }
+
+    magnitude = DRV_FSI_abs(error);
+    s_phaseError = DRV_FSI_clamp(error, 32767);
+
+    if(s_locked && (magnitude > DRV_FSI_SYNC_OUTLIER_COUNTS))
+    {
+        s_outliers++;
+        s_outlierRun++;
+
+        if(s_outlierRun < DRV_FSI_SYNC_OUTLIER_LIMIT)
+        {
+            return;
+        }
+
+        s_locked = false;
+        s_lockCount = 0U;
+    }
+
+    s_outlierRun = 0U;
+
+    if(magnitude <= DRV_FSI_SYNC_CAPTURE_COUNTS)
+    {
+        s_integral += error;
+        s_integral = DRV_FSI_clamp(s_integral, (int32_t)DRV_FSI_SYNC_MAX_TRIM * DRV_FSI_SYNC_FRAC);
+    }
+
+    /* 两板频率差通常不是整数个计数，余数逐帧累加，平均后的 TBPRD 带有小数部分。 */
+    output = error * DRV_FSI_SYNC_KP_MUL + s_integral + s_residual;
+    trim = (output >= 0) ? (output / DRV_FSI_SYNC_FRAC) : -((DRV_FSI_SYNC_FRAC - 1 - output) / DRV_FSI_SYNC_FRAC);
+    s_trim = DRV_FSI_clamp(trim, DRV_FSI_SYNC_MAX_TRIM);
+    s_residual = (s_trim == trim) ? (output - trim * DRV_FSI_SYNC_FRAC) : 0;
+    DRV_FSI_PORT_trimPeriod(s_trim);
+
+    if(magnitude <= DRV_FSI_SYNC_LOCK_COUNTS)
+    {
+        if(s_lockCount < DRV_FSI_SYNC_LOCK_FRAMES)
+        {
+            s_lockCount++;
+        }
+
+        if(s_lockCount >= DRV_FSI_SYNC_LOCK_FRAMES)
+        {
+            s_locked = true;
+        }
+    }
+    else
+    {
+        s_lockCount = 0U;
+    }
+}
+
+bool DRV_FSI_receive(DRV_FSI_Frame *frame)
+{
+    uint16_t slotWords[DRV_FSI_SLOT_WORDS];
+    const uint16_t *body = &slotWords[DRV_FSI_STAMP_WORDS];
+    uint16_t next;
+    uint16_t slot;
+    uint16_t advanced;
+    uint16_t counter;
+    uint16_t arrival;
+    uint16_t sequence;
+    uint16_t i;
+
+    if(!s_running || (frame == NULL))
+    {
+        return false;
+    }
+
+    next = DRV_FSI_PORT_getRxSlot();
+    slot = (uint16_t)((next + DRV_FSI_RX_SLOTS - 1U) % DRV_FSI_RX_SLOTS);
+
+    for(i = 0U; i < DRV_FSI_SLOT_WORDS; i++)
+    {
+        slotWords[i] = DRV_FSI_rxRing[slot * DRV_FSI_SLOT_WORDS + i];
+    }
+
+    /* 读取期间 DMA 又写了 SLOTS-1 个槽时，下一个写入的就是刚读的槽。 */
+    advanced = (uint16_t)((DRV_FSI_PORT_getRxSlot() + DRV_FSI_RX_SLOTS - next) % DRV_FSI_RX_SLOTS);
+
+    if(advanced >= (DRV_FSI_RX_SLOTS - 1U))
+    {
+        s_torn++;
+        return false;
+    }
+
+    if((slot == s_lastSlot) && (slotWords[0] == s_lastStamp[0]) && (slotWords[1] == s_lastStamp[1]) &&
+       (body[DRV_FSI_SEQ_INDEX] == s_lastSeqWord))
+    {
+        return false;
+    }
+
+    s_lastSlot     = slot;
+    s_lastStamp[0] = slotWords[0];
+    s_lastStamp[1] = slotWords[1];
+    s_lastSeqWord  = body[DRV_FSI_SEQ_INDEX];
+
+    if(DRV_FSI_crc16(0xFFFFU, body, DRV_FSI_CRC_INDEX) != body[DRV_FSI_CRC_INDEX])
+    {
+        s_crcErrors++;
+        return false;
+    }
+
+    s_linkUp = true;
+
+    /* 减计数段 TBCTR 即距归零的计数；增计数段还要再加上半个周期的减计数。 */
+    counter = slotWords[0];
+
+    if((slotWords[1] & DRV_FSI_TBSTS_CTRDIR) != 0U)
+    {
+        arrival = (uint16_t)(2U * s_period - counter);
+        s_arrivalLatency = 0U;
+    }
+    else
+    {
+        arrival = counter;
+        s_arrivalLatency = (counter <= s_period) ? (uint16_t)(s_period - counter) : 0U;
+    }
+
+    if(s_syncEnabled)
+    {
+        DRV_FSI_updateSync(arrival);
+    }
+
+    sequence = body[DRV_FSI_SEQ_INDEX];
+
+    if(s_haveSequence)
+    {
+        uint16_t gap = (uint16_t)(sequence - s_lastSequence);
+
+        if(gap == 0U)
+        {
+            s_repeats++;
+            return false;
+        }
+
+        if(gap < 0x8000U)
+        {
+            s_rxLost += gap - 1U;
+        }
+    }
+
+    s_haveSequence = true;
+    s_lastSequence = sequence;
+
+    for(i = 0U; i < DRV_FSI_PAYLOAD_WORDS; i++)
+    {
+        frame->payload[i] = body[i];
+    }
+
+    frame->sequence = sequence;
+    frame->arrival  = arrival;
+    s_rxFrames++;
+
+    return true;
+}
+
+void DRV_FSI_setSyncLatency(uint16_t counts)
+{
+    s_latency = counts;
+}
+
+void DRV_FSI_onRxEvents(uint16_t events)
+{
+    if((events & DRV_FSI_EVT_PING_TIMEOUT) != 0U)
+    {
+        /* 链路断开时保持当前 TBPRD，即保持最近一次估计的频率。 */
+        if(s_linkUp)
+        {
+            s_linkDowns++;
+        }
+
+        s_linkUp = false;
+        s_locked = false;
+        s_lockCount = 0U;
+    }
+
+    if((events & DRV_FSI_EVT_CRC_ERROR) != 0U)
+    {
+        s_hwCrcErrors++;
+    }
+
+    if((events & DRV_FSI_EVT_FRAME_ERROR) != 0U)
+    {
+        s_frameErrors++;
+    }
+
+    if((events & DRV_FSI_EVT_OVERRUN) != 0U)
+    {
+        s_overruns++;
+    }
+}
+
+void DRV_FSI_getStats(DRV_FSI_Stats *stats)
+{
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    stats->txFrames    = s_txFrames;
+    stats->rxFrames    = s_rxFrames;
+    stats->rxLost      = s_rxLost;
+    stats->repeats     = s_repeats;
+    stats->crcErrors   = s_crcErrors;
+    stats->torn        = s_torn;
+    stats->hwCrcErrors = s_hwCrcErrors;
+    stats->frameErrors = s_frameErrors;
+    stats->overruns    = s_overruns;
+    stats->linkDowns   = s_linkDowns;
+    stats->outliers    = s_outliers;
+    stats->linkUp      = s_linkUp;
+    stats->locked      = s_locked;
+    stats->phaseError  = s_phaseError;
+    stats->trim        = s_trim;
+    stats->latency     = s_arrivalLatency;
+}
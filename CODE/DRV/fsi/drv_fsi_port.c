@@ -0,0 +1,226 @@
+/**
+ * @file drv_fsi_port.c
+ * @brief FSIA 驱动的硬件接口，DriverLib 实现。
+ *
+ * LaunchPad 默认的 FSI 引脚与 CANA RX（GPIO33）和 LED（GPIO6）冲突，改用
+ * TXCLK GPIO27、TX0 GPIO26、RXCLK GPIO13、RX0 GPIO12，单通道。
+ *
+ * DMA 通道（CH1 由 DRV_DMA 使用）：
+ *  - CH2：RX 事件，读 ePWM1 TBCTR、TBSTS 写入槽首，编号较小，先于 CH3 执行；
+ *  - CH3：RX 事件，接收缓冲区 16 字写入槽内帧区，一次传输 DRV_FSI_RX_SLOTS 个 burst，
+ *    结束后目标地址从影子寄存器回到环形缓冲区起点；
+ *  - CH4：软件触发或 TX 事件，暂存帧 16 字写入发送缓冲区，每次传输一个 burst，开始
+ *    时装入最新的源地址影子寄存器。
+ */
+
+#include "drv_fsi.h"
+#include "drv_epwm.h"
+
+#include "driverlib.h"
+#include "device.h"
+
+#define DRV_FSI_TX_BASE         (FSITXA_BASE)
+#define DRV_FSI_RX_BASE         (FSIRXA_BASE)
+
+#define DRV_FSI_DMA_STAMP       (DMA_CH2_BASE)
+#define DRV_FSI_DMA_RX          (DMA_CH3_BASE)
+#define DRV_FSI_DMA_TX          (DMA_CH4_BASE)
+
+/** ePWM1 的 TBCTR 与 TBSTS 相邻。 */
+#define DRV_FSI_STAMP_ADDR      (EPWM1_BASE + EPWM_O_TBCTR)
+
+/** 接收中断只处理错误与 Ping 看门狗；FRAME_DONE 不清除，不开启 FRAME_OVERRUN。 */
+#define DRV_FSI_RX_INT_EVENTS   (FSI_RX_EVT_PING_WD_TIMEOUT | FSI_RX_EVT_CRC_ERR | FSI_RX_EVT_TYPE_ERR | \
+                                 FSI_RX_EVT_EOF_ERR | FSI_RX_EVT_OVERRUN)
+
+__interrupt void DRV_FSI_isr(void);
+
+#pragma CODE_SECTION(DRV_FSI_isr, "hotpath")
+#pragma CODE_SECTION(DRV_FSI_PORT_setTxSource, "hotpath")
+#pragma CODE_SECTION(DRV_FSI_PORT_getRxSlot, "hotpath")
+#pragma CODE_SECTION(DRV_FSI_PORT_trimPeriod, "hotpath")
+
+static uint32_t s_rxFrameAddress = 0U;
+
+static void DRV_FSI_configurePins(void)
+{
+    GPIO_setPinConfig(GPIO_27_FSITXA_CLK);
+    GPIO_setPinConfig(GPIO_26_FSITXA_D0);
+    GPIO_setPinConfig(GPIO_13_FSIRXA_CLK);
+    GPIO_setPinConfig(GPIO_12_FSIRXA_D0);
+
+    GPIO_setQualificationMode(13U, GPIO_QUAL_ASYNC);
+    GPIO_setQualificationMode(12U, GPIO_QUAL_ASYNC);
+}
+
+static void DRV_FSI_configureDma(uint16_t *rxRing)
+{
+    uint16_t *txBuffer = (uint16_t *)FSI_getTxBufferAddress(DRV_FSI_TX_BASE);
+    uint16_t *rxBuffer = (uint16_t *)FSI_getRxBufferAddress(DRV_FSI_RX_BASE);
+
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_DMA);
+
+    /* 时间戳：burst 内读 TBCTR、TBSTS，burst 后源地址退回 TBCTR，目标跳到下一槽首。 */
+    DMA_configAddresses(DRV_FSI_DMA_STAMP, rxRing, (const void *)DRV_FSI_STAMP_ADDR);
+    DMA_configBurst(DRV_FSI_DMA_STAMP, DRV_FSI_STAMP_WORDS, 1, 1);
+    DMA_configTransfer(DRV_FSI_DMA_STAMP, DRV_FSI_RX_SLOTS, -1,
+                       (int16_t)(DRV_FSI_SLOT_WORDS - DRV_FSI_STAMP_WORDS + 1U));
+    DMA_configMode(DRV_FSI_DMA_STAMP, DMA_TRIGGER_FSIRXA,
+                   DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE | DMA_CFG_SIZE_16BIT);
+
+    /* 帧：接收缓冲区 16 字正好是一圈，burst 后源地址回到 0。 */
+    DMA_configAddresses(DRV_FSI_DMA_RX, &rxRing[DRV_FSI_STAMP_WORDS], rxBuffer);
+    DMA_configBurst(DRV_FSI_DMA_RX, DRV_FSI_FRAME_WORDS, 1, 1);
+    DMA_configTransfer(DRV_FSI_DMA_RX, DRV_FSI_RX_SLOTS, -(int16_t)(DRV_FSI_FRAME_WORDS - 1U),
+                       (int16_t)(DRV_FSI_SLOT_WORDS - DRV_FSI_FRAME_WORDS + 1U));
+    DMA_configMode(DRV_FSI_DMA_RX, DMA_TRIGGER_FSIRXA,
+                   DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE | DMA_CFG_SIZE_16BIT);
+
+    DMA_configAddresses(DRV_FSI_DMA_TX, txBuffer, txBuffer);
+    DMA_configBurst(DRV_FSI_DMA_TX, DRV_FSI_FRAME_WORDS, 1, 1);
+    DMA_configTransfer(DRV_FSI_DMA_TX, 1U, 0, 0);
+    DMA_configMode(DRV_FSI_DMA_TX, DMA_TRIGGER_FSITXA,
+                   DMA_CFG_ONESHOT_DISABLE | DMA_CFG_CONTINUOUS_ENABLE | DMA_CFG_SIZE_16BIT);
+
+    s_rxFrameAddress = (uint32_t)&rxRing[DRV_FSI_STAMP_WORDS];
+}
+
+bool DRV_FSI_PORT_init(bool loopback, uint16_t *rxRing)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_FSITXA);
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_FSIRXA);
+    DRV_FSI_configurePins();
+
+    FSI_performTxInitialization(DRV_FSI_TX_BASE, FSI_PRESCALE_50MHZ);
+    FSI_performRxInitialization(DRV_FSI_RX_BASE);
+
+    FSI_setTxDataWidth(DRV_FSI_TX_BASE, FSI_DATA_WIDTH_1_LANE);
+    FSI_setRxDataWidth(DRV_FSI_RX_BASE, FSI_DATA_WIDTH_1_LANE);
+    FSI_setTxFrameType(DRV_FSI_TX_BASE, FSI_FRAME_TYPE_NWORD_DATA);
+    FSI_setTxSoftwareFrameSize(DRV_FSI_TX_BASE, DRV_FSI_FRAME_WORDS);
+    FSI_setRxSoftwareFrameSize(DRV_FSI_RX_BASE, DRV_FSI_FRAME_WORDS);
+    FSI_setTxFrameTag(DRV_FSI_TX_BASE, (FSI_FrameTag)DRV_FSI_TAG_DATA);
+    FSI_setTxUserDefinedData(DRV_FSI_TX_BASE, DRV_FSI_NODE_ID);
+
+    if(loopback)
+    {
+        FSI_enableRxInternalLoopback(DRV_FSI_RX_BASE);
+    }
+
+    /* 任何一帧都使 Ping 定时器与看门狗重新计时，数据帧持续时不发送 Ping 帧。 */
+    FSI_setTxPingTimeoutMode(DRV_FSI_TX_BASE, FSI_PINGTIMEOUT_ON_HWSWINIT_PING_FRAME);
+    FSI_enableTxPingTimer(DRV_FSI_TX_BASE, DRV_FSI_PING_PERIOD_CYCLES, (FSI_FrameTag)DRV_FSI_TAG_PING);
+    FSI_setRxPingTimeoutMode(DRV_FSI_RX_BASE, FSI_PINGTIMEOUT_ON_HWSWINIT_PING_FRAME);
+    FSI_enableRxPingWatchdog(DRV_FSI_RX_BASE, DRV_FSI_PING_TIMEOUT_CYCLES);
+
+    DRV_FSI_configureDma(rxRing);
+    FSI_enableTxDMAEvent(DRV_FSI_TX_BASE);
+    FSI_enableRxDMAEvent(DRV_FSI_RX_BASE);
+
+    FSI_clearRxEvents(DRV_FSI_RX_BASE, FSI_RX_EVTMASK);
+    FSI_enableRxInterrupt(DRV_FSI_RX_BASE, FSI_INT1, DRV_FSI_RX_INT_EVENTS);
+
+    Interrupt_register(INT_FSIRXA_INT1, &DRV_FSI_isr);
+    Interrupt_enable(INT_FSIRXA_INT1);
+
+    return true;
+}
+
+void DRV_FSI_PORT_start(const uint16_t *frame)
+{
+    FSI_setTxBufferPtr(DRV_FSI_TX_BASE, 0U);
+    FSI_setRxBufferPtr(DRV_FSI_RX_BASE, 0U);
+    FSI_writeTxBuffer(DRV_FSI_TX_BASE, frame, DRV_FSI_FRAME_WORDS, 0U);
+
+    DMA_configSourceAddress(DRV_FSI_DMA_TX, frame);
+
+    DMA_clearTriggerFlag(DRV_FSI_DMA_STAMP);
+    DMA_clearTriggerFlag(DRV_FSI_DMA_RX);
+    DMA_clearTriggerFlag(DRV_FSI_DMA_TX);
+    DMA_enableTrigger(DRV_FSI_DMA_STAMP);
+    DMA_enableTrigger(DRV_FSI_DMA_RX);
+    DMA_enableTrigger(DRV_FSI_DMA_TX);
+    DMA_startChannel(DRV_FSI_DMA_STAMP);
+    DMA_startChannel(DRV_FSI_DMA_RX);
+    DMA_startChannel(DRV_FSI_DMA_TX);
+
+    /* 此后每个 ePWM1 SOCA 发出发送缓冲区中的一帧。 */
+    FSI_setTxExtFrameTrigger(DRV_FSI_TX_BASE, FSI_EXT_TRIGSRC_EPWM1_SOCA);
+    FSI_setTxStartMode(DRV_FSI_TX_BASE, FSI_TX_START_EXT_TRIG);
+}
+
+void DRV_FSI_PORT_setTxSource(const uint16_t *frame)
+{
+    uint16_t counter = HWREGH(EPWM1_BASE + EPWM_O_TBCTR);
+    bool up = (HWREGH(EPWM1_BASE + EPWM_O_TBSTS) & EPWM_TBSTS_CTRDIR) != 0U;
+    uint16_t period = HWREGH(EPWM1_BASE + EPWM_O_TBPRD);
+
+    DMA_configSourceAddress(DRV_FSI_DMA_TX, frame);
+
+    /* 保护窗口内发送缓冲区正在或即将被读出，留给帧完成事件搬运。 */
+    if(( up && ((uint32_t)counter + DRV_FSI_TX_GUARD_BEFORE >= period)) ||
+       (!up && ((uint32_t)counter + DRV_FSI_TX_GUARD_AFTER >= period)))
+    {
+        return;
+    }
+
+    DMA_forceTrigger(DRV_FSI_DMA_TX);
+}
+
+uint16_t DRV_FSI_PORT_getRxSlot(void)
+{
+    uint32_t address = HWREG(DRV_FSI_DMA_RX + DMA_O_DST_ADDR_ACTIVE);
+
+    /* 第一帧到达前活动寄存器尚未装入。 */
+    if(address < s_rxFrameAddress)
+    {
+        return 0U;
+    }
+
+    return (uint16_t)(((address - s_rxFrameAddress) / DRV_FSI_SLOT_WORDS) % DRV_FSI_RX_SLOTS);
+}
+
+uint16_t DRV_FSI_PORT_getPeriod(void)
+{
+    /* TBCLK 不分频，增减计数下一个周期为 2 * TBPRD。 */
+    return (uint16_t)(DRV_EPWM_getPeriodCycles() / 2U);
+}
+
+void DRV_FSI_PORT_trimPeriod(int16_t counts)
+{
+    (void)DRV_EPWM_trimPeriod(counts);
+}
+
+/**
+ * @brief FSIRXA INT1：统计错误与 Ping 看门狗超时。
+ */
+__interrupt void DRV_FSI_isr(void)
+{
+    uint16_t status = FSI_getRxEventStatus(DRV_FSI_RX_BASE) & DRV_FSI_RX_INT_EVENTS;
+    uint16_t events = 0U;
+
+    if((status & FSI_RX_EVT_PING_WD_TIMEOUT) != 0U)
+    {
+        events |= DRV_FSI_EVT_PING_TIMEOUT;
+    }
+
+    if((status & FSI_RX_EVT_CRC_ERR) != 0U)
+    {
+        events |= DRV_FSI_EVT_CRC_ERROR;
+    }
+
+    if((status & (FSI_RX_EVT_TYPE_ERR | FSI_RX_EVT_EOF_ERR)) != 0U)
+    {
+        events |= DRV_FSI_EVT_FRAME_ERROR;
+    }
+
+    if((status & FSI_RX_EVT_OVERRUN) != 0U)
+    {
+        events |= DRV_FSI_EVT_OVERRUN;
+    }
+
+    FSI_clearRxEvents(DRV_FSI_RX_BASE, status);
+    DRV_FSI_onRxEvents(events);
+
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP7);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file drv_adc.h
+ * @brief ADC 驱动接口定义，完成相电流与母线电压的同步采样配置。
+ *
+ * ADCA 与 ADCC 由 ePWM1 SOCA 同时触发：
+ *  - ADCA SOC0：A 相电流；ADCC SOC0：B 相电流，两路同时采样；
+ *  - ADCA SOC1：母线电压，在 A 相电流之后转换；
+ *  - ADCA SOC2：片内温度传感器，排在 SOC1 之后，不推迟电流环的触发。
+ * ADCA SOC1 转换结束产生 ADCINT1，作为 CLA 任务 1 的触发源，不进入 CPU 中断。
+ *
+ * 结果寄存器地址以宏给出，本头文件只依赖寄存器定义，可被 CLA 代码包含。
+ */
+
+#ifndef DRV_ADC_H
+#define DRV_ADC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_adc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 采样通道，按硬件接线修改。 */
+#ifndef DRV_ADC_IA_CHANNEL
+#define DRV_ADC_IA_CHANNEL          (2U)    /**< ADCINA2。 */
+#endif
+
+#ifndef DRV_ADC_IB_CHANNEL
+#define DRV_ADC_IB_CHANNEL          (2U)    /**< ADCINC2。 */
+#endif
+
+#ifndef DRV_ADC_VDC_CHANNEL
+#define DRV_ADC_VDC_CHANNEL         (3U)    /**< ADCINA3。 */
+#endif
+
+/** 片内温度传感器固定接在 ADCA 通道 14。 */
+#define DRV_ADC_TEMP_CHANNEL        (14U)
+
+/** 采样窗口（SYSCLK 周期），须不小于器件手册的最小值。 */
+#define DRV_ADC_ACQPS               (15U)
+
+/** 温度传感器要求至少 450 ns 的采样窗口。 */
+#define DRV_ADC_TEMP_ACQPS          (49U)
+
+/** 12 bit 满量程计数。 */
+#define DRV_ADC_FULL_SCALE          (4096.0f)
+
+/** 结果寄存器地址。 */
+#define DRV_ADC_IA_RESULT_ADDR      (ADCARESULT_BASE + ADC_O_RESULT0)
+#define DRV_ADC_IB_RESULT_ADDR      (ADCCRESULT_BASE + ADC_O_RESULT0)
+#define DRV_ADC_VDC_RESULT_ADDR     (ADCARESULT_BASE + ADC_O_RESULT1)
+#define DRV_ADC_TEMP_RESULT_ADDR    (ADCARESULT_BASE + ADC_O_RESULT2)
+
+/**
+ * @brief 初始化 ADCA、ADCC 并配置由 ePWM1 SOCA 触发的采样序列。
+ *
+ * 需在 EALLOW 下调用，内含 1 ms 上电延时。
+ */
+void DRV_ADC_init(void);
+
+/**
+ * @brief 读取最近一次转换结果。
+ *
+ * @param[out] ia  A 相电流计数。
+ * @param[out] ib  B 相电流计数。
+ * @param[out] vdc 母线电压计数。
+ */
+void DRV_ADC_read(uint16_t *ia, uint16_t *ib, uint16_t *vdc);
+
+/**
+ * @brief 读取芯片结温，按出厂标定的斜率与偏置换算。
+ *
+ * @return 温度，单位 ℃。
+ */
+int16_t DRV_ADC_readTemperature(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_ADC_H */
@@ -0,0 +1,215 @@
+/**
+ * @file drv_can.h
+ * @brief CANA 驱动接口：专用邮箱、硬件验收过滤、按优先级的周期发送与总线负载限流。
+ *
+ * 邮箱（消息对象）在 DRV_CAN_start 时一次分配：
+ *  - 每个发送报文独占一个邮箱，按 ID 从小到大占用 1 号起的邮箱。控制器在多个待发
+ *    邮箱中先发编号小的，因此邮箱顺序与总线仲裁顺序一致，不会出现低优先级报文挡住
+ *    高优先级报文的情况；
+ *  - 接收过滤器以 ID 与掩码在硬件上验收，不相关的报文不会产生中断；深度大于 1 的
+ *    过滤器占用连续的邮箱组成 FIFO。
+ *
+ * 接收由中断驱动：中断经 IF2 读出报文并清除中断挂起，放入单生产者/单消费者队列，
+ * 任务以 DRV_CAN_receive 取出。发送与配置只使用 IF1，中断与任务不共用接口寄存器。
+ *
+ * 发送由 DRV_CAN_service 在每个 tick 调度：周期报文到期或事件报文被请求后，按优先级
+ * 依次装入邮箱；邮箱中的上一帧尚未发出时保留数据等到下一个 tick。限流模式下以令牌桶
+ * 限制本节点占用的总线比例，按最坏情况位填充计算每帧位数；自适应模式下，已装入的帧
+ * 在一个 tick 后仍未发出（总线繁忙、仲裁失败）时份额减半，此后每个 tick 逐步恢复。
+ * 总线关闭时停止装入，经过 DRV_CAN_BUSOFF_HOLDOFF_TICKS 后重新开始恢复序列。
+ *
+ * 硬件经 DRV_CAN_PORT_* 接口访问：目标板由 drv_can_port.c 以 DriverLib 实现，主机端由
+ * tools/host/can_host 中的总线模型提供，两者共用 drv_can.c。
+ * DRV_CAN_update、DRV_CAN_send、DRV_CAN_receive 与 DRV_CAN_service 须在同一个任务中调用。
+ */
+
+#ifndef DRV_CAN_H
+#define DRV_CAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 位速率与每位时间量子数，CAN 时钟为 SYSCLK。 */
+#define DRV_CAN_BITRATE             (500000UL)
+#define DRV_CAN_BIT_QUANTA          (20U)
+
+/** 消息对象数量。 */
+#define DRV_CAN_MAILBOXES           (32U)
+
+/** 发送报文与接收过滤器数量上限。 */
+#define DRV_CAN_MAX_TX              (16U)
+#define DRV_CAN_MAX_RX_FILTERS      (8U)
+
+/** 接收队列深度，必须为 2 的幂。 */
+#define DRV_CAN_RX_QUEUE_DEPTH      (16U)
+#define DRV_CAN_RX_QUEUE_MASK       (DRV_CAN_RX_QUEUE_DEPTH - 1U)
+
+/** 总线关闭后等待多少 tick 再开始恢复。 */
+#define DRV_CAN_BUSOFF_HOLDOFF_TICKS (100U)
+
+/** ID 中的扩展帧标志，其余位为 11 bit 或 29 bit 标识符。 */
+#define DRV_CAN_ID_EXTENDED         (0x80000000UL)
+#define DRV_CAN_ID_STD_MASK         (0x000007FFUL)
+#define DRV_CAN_ID_EXT_MASK         (0x1FFFFFFFUL)
+
+/** 无效的发送报文句柄。 */
+#define DRV_CAN_INVALID_HANDLE      (0xFFFFU)
+
+/** 总线状态。 */
+#define DRV_CAN_BUS_WARNING         (0x0001U)   /**< 错误计数达到 96。 */
+#define DRV_CAN_BUS_PASSIVE         (0x0002U)   /**< 错误被动。 */
+#define DRV_CAN_BUS_OFF             (0x0004U)   /**< 总线关闭。 */
+
+/**
+ * @brief 限流模式。
+ */
+typedef enum
+{
+    DRV_CAN_THROTTLE_OFF = 0,       /**< 到期即发送。 */
+    DRV_CAN_THROTTLE_FIXED,         /**< 本节点占用不超过设定比例。 */
+    DRV_CAN_THROTTLE_ADAPTIVE       /**< 在设定比例内随总线拥塞调整。 */
+} DRV_CAN_Throttle;
+
+/**
+ * @brief 报文，data 每个元素一个字节（0~255）。
+ */
+typedef struct
+{
+    uint32_t id;                    /**< 含 DRV_CAN_ID_EXTENDED 标志。 */
+    uint16_t length;                /**< 0~8。 */
+    uint16_t data[8];
+} DRV_CAN_Frame;
+
+/**
+ * @brief 驱动统计。
+ */
+typedef struct
+{
+    uint32_t txFrames;              /**< 已发出的帧数。 */
+    uint32_t rxFrames;              /**< 放入接收队列的帧数。 */
+    uint32_t rxDropped;             /**< 接收队列满而丢弃的帧数。 */
+    uint32_t rxLost;                /**< 邮箱中未及读出被覆盖的帧数。 */
+    uint32_t deferred;              /**< 因限流推迟的次数。 */
+    uint32_t busy;                  /**< 邮箱中上一帧未发出而推迟的次数。 */
+    uint32_t overruns;              /**< 周期报文上一周期未发出即再次到期的次数。 */
+    uint32_t congestion;            /**< 装入后一个 tick 仍未发出的次数。 */
+    uint32_t busOff;                /**< 进入总线关闭的次数。 */
+    uint16_t busState;              /**< DRV_CAN_BUS_*。 */
+    uint16_t busLoadPercent;        /**< 最近 1 s 内本节点收发占用的总线比例估计。 */
+    uint16_t sharePercent;          /**< 当前限流份额。 */
+} DRV_CAN_Stats;
+
+/**
+ * @brief 清空报文表与统计，在登记报文之前调用。
+ *
+ * @param[in] tickHz DRV_CAN_service 的调用频率。
+ */
+void DRV_CAN_init(uint32_t tickHz);
+
+/**
+ * @brief 登记一个发送报文。
+ *
+ * @param[in] id          标识符，扩展帧带 DRV_CAN_ID_EXTENDED。
+ * @param[in] length      数据长度 0~8。
+ * @param[in] periodTicks 发送周期，0 为只在 DRV_CAN_send 时发送。
+ *
+ * @return 报文句柄；表满、参数非法或已启动时返回 DRV_CAN_INVALID_HANDLE。
+ */
+uint16_t DRV_CAN_addTxMessage(uint32_t id, uint16_t length, uint16_t periodTicks);
+
+/**
+ * @brief 登记一个接收过滤器，报文 ID 与 id 在 mask 为 1 的位上相同时接收。
+ *
+ * @param[in] depth 占用的邮箱数，大于 1 时组成 FIFO。
+ */
+bool DRV_CAN_addRxFilter(uint32_t id, uint32_t mask, uint16_t depth);
+
+/**
+ * @brief 分配邮箱并启动控制器。
+ *
+ * @param[in] loopback 为 true 时使用内部回环测试模式，发出的帧不上总线，由本节点
+ *                     的接收过滤器接收。
+ *
+ * @retval false 邮箱不足或控制器初始化失败。
+ */
+bool DRV_CAN_start(bool loopback);
+
+/**
+ * @brief 更新报文数据，下一次发送时使用。
+ */
+bool DRV_CAN_update(uint16_t handle, const uint16_t *data);
+
+/**
+ * @brief 更新报文数据并请求在下一个 tick 发送。
+ */
+bool DRV_CAN_send(uint16_t handle, const uint16_t *data);
+
+/**
+ * @brief 取出一帧接收报文。
+ */
+bool DRV_CAN_receive(DRV_CAN_Frame *frame);
+
+/**
+ * @brief 设置限流模式与本节点允许占用的总线比例（1~100）。
+ */
+void DRV_CAN_setThrottle(DRV_CAN_Throttle mode, uint16_t sharePercent);
+
+/**
+ * @brief 发送调度与总线状态处理，每个 tick 调用一次。
+ */
+void DRV_CAN_service(void);
+
+/**
+ * @brief 读取驱动统计。
+ */
+void DRV_CAN_getStats(DRV_CAN_Stats *stats);
+
+/**
+ * @brief 按最坏情况位填充计算一帧占用的位数，含帧间隔。
+ */
+uint16_t DRV_CAN_frameBits(uint32_t id, uint16_t length);
+
+/**
+ * @brief 接收中断把报文放入队列，由端口实现调用。
+ *
+ * @param[in] lost 邮箱报告此前有报文被覆盖。
+ */
+void DRV_CAN_pushRx(const DRV_CAN_Frame *frame, bool lost);
+
+/*
+ * 硬件接口，mailbox 为消息对象编号 1~DRV_CAN_MAILBOXES。
+ */
+
+/** 初始化控制器、位时序与中断，全部邮箱无效。 */
+bool DRV_CAN_PORT_init(uint32_t bitRate, bool loopback);
+
+/** 配置发送邮箱。 */
+void DRV_CAN_PORT_setupTx(uint16_t mailbox, uint32_t id, uint16_t length);
+
+/** 配置接收邮箱，fifo 为 true 表示与下一个邮箱组成 FIFO。 */
+void DRV_CAN_PORT_setupRx(uint16_t mailbox, uint32_t id, uint32_t mask, bool fifo);
+
+/** 离开初始化状态，开始参与总线通信。 */
+void DRV_CAN_PORT_enable(void);
+
+/** 写入数据并置发送请求。 */
+void DRV_CAN_PORT_transmit(uint16_t mailbox, const uint16_t *data, uint16_t length);
+
+/** 返回发送请求仍未完成的邮箱，第 n 位对应 n+1 号邮箱。 */
+uint32_t DRV_CAN_PORT_getTxPending(void);
+
+/** 返回 DRV_CAN_BUS_* 状态。 */
+uint16_t DRV_CAN_PORT_getBusState(void);
+
+/** 总线关闭后重新开始恢复序列。 */
+void DRV_CAN_PORT_recover(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_CAN_H */
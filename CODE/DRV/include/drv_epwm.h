@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 #define DRV_EPWM_CHANNEL_COUNT    (3U) /**< ePWM 互补通道数量。 */
+#define DRV_EPWM_INT_MAX_EVENTS   (15U) /**< 周期中断最大分频（硬件 ETPS 限制）。 */
 
 /**
  * @brief ePWM 运行状态信息。
@@ -71,6 +72,54 @@ void DRV_EPWM_setDeadbandCounts(uint16_t risingEdgeCount, uint16_t fallingEdgeCo
  */
 void DRV_EPWM_getState(DRV_EPWM_State *state);
 
+/**
+ * @brief 返回一个 PWM 周期对应的 SYSCLK 周期数。
+ */
+uint32_t DRV_EPWM_getPeriodCycles(void);
+
+/**
+ * @brief 使能 ePWM1 计数器归零时刻的周期中断（PIE 组 3，INT_EPWM1）。
+ *
+ * 中断服务程序由调用者注册，并在其中调用 DRV_EPWM_clearInterrupt。
+ *
+ * @param[in] eventCount 每隔多少个 PWM 周期触发一次，取值 1~DRV_EPWM_INT_MAX_EVENTS。
+ *
+ * @retval true  配置成功。
+ * @retval false 参数非法或驱动尚未初始化。
+ */
+bool DRV_EPWM_enableInterrupt(uint16_t eventCount);
+
+/**
+ * @brief 关闭 ePWM1 周期中断。
+ */
+void DRV_EPWM_disableInterrupt(void);
+
+/**
+ * @brief 清除 ePWM1 中断标志并应答 PIE 组 3，在中断服务程序末尾调用。
+ */
+void DRV_EPWM_clearInterrupt(void);
+
+/**
+ * @brief 使能 ePWM1 在计数器到达周期值时产生 ADC SOCA，每个 PWM 周期一次。
+ *
+ * 增减计数模式下周期点处于各相下桥臂导通的中间，适合低边采样电阻测电流。
+ *
+ * @retval false 驱动尚未初始化。
+ */
+bool DRV_EPWM_enableAdcTrigger(void);
+
+/**
+ * @brief 以当前频率对应的周期值加 counts 设置三路 TBPRD，用于跨板同步时微调频率。
+ *
+ * 写入影子寄存器，计数器归零时生效；比较值不变，微调量应远小于周期值。
+ * DRV_EPWM_setFrequency 会清除微调。
+ *
+ * @param[in] counts 微调量，绝对值不超过周期值的 1/8。
+ *
+ * @retval false 驱动尚未初始化或微调量过大。
+ */
+bool DRV_EPWM_trimPeriod(int16_t counts);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,223 @@
+/**
+ * @file drv_fsi.h
+ * @brief FSIA 驱动接口：两块 F28004x 之间按 PWM 周期交换固定长度控制帧，并同步 PWM 时基。
+ *
+ * 链路为单通道，TXCLK 50 MHz，双沿传输。每帧为 16 字的 N-word 数据帧，恰好占满 FSI
+ * 的 16 字收发缓冲区，缓冲区指针每帧回到 0：
+ *  - 第 0~13 字为载荷，第 14 字为发送序号，第 15 字为前 15 字的 CRC16（CCITT，初值
+ *    0xFFFF）。硬件 CRC 保护线路，软件 CRC 保护从发送暂存区到接收环形缓冲区的整个
+ *    路径，读者与 DMA 冲突读到半新半旧的槽时也能识别；
+ *  - 帧标签固定为 DRV_FSI_TAG_DATA，用户数据为本板节点号，Ping 帧使用 DRV_FSI_TAG_PING。
+ *
+ * 收发不经 CPU：
+ *  - 发送由 ePWM1 SOCA（计数器顶点）经外部触发直接启动，帧与 PWM 周期锁定。暂存区
+ *    为双缓冲，DRV_FSI_send 写入空闲的一半后改写 DMA 源地址影子寄存器，并以软件触发
+ *    DMA 把整帧搬入发送缓冲区，帧在下一个 SOCA 发出。顶点前后的保护窗口内正在或即将
+ *    发送，此时不触发，改由该帧发完产生的 TX DMA 事件搬入，帧推迟一个周期；
+ *  - 接收每帧产生 RX DMA 事件，一个通道先读 ePWM1 的 TBCTR 与 TBSTS 作为到达时间戳，
+ *    另一个通道把 16 字搬入 RAMGS3 的环形缓冲区（DRV_FSI_RX_SLOTS 个槽）。
+ *    DRV_FSI_receive 按 DMA 目标地址找出最新的槽并校验。
+ *
+ * 链路监视：发送端的 Ping 定时器在任何一帧发出后重新计时，数据帧持续时不额外发送
+ * Ping 帧，数据停止后每 DRV_FSI_PING_PERIOD_CYCLES 发送一次；接收端 Ping 看门狗在
+ * DRV_FSI_PING_TIMEOUT_CYCLES 内未收到任何帧时产生中断，链路标记为断开，之后收到
+ * 有效帧即恢复。CRC、帧尾、帧类型与缓冲区溢出错误由同一个中断计数。
+ *
+ * PWM 同步：F28004x 的 FSI 接收端不能直接同步 ePWM，从板改为测量到达时刻。主板在计数
+ * 器顶点发帧，经固定延迟 L 到达；两板计数器归零时刻对齐时，从板在减计数段收到帧，
+ * 此时 TBCTR = TBPRD - L。从板以两者之差为相位误差，经 PI 调节在 ±DRV_FSI_SYNC_MAX_TRIM
+ * 内微调三路 ePWM 的 TBPRD（影子寄存器，归零时装入），相当于一个锁相环，同时消除
+ * 初始相位差与两板晶振的频率差。L 在回环模式下由 DRV_FSI_Stats.latency 测得，连接
+ * 两板时加上线缆延迟后经 DRV_FSI_setSyncLatency 设置。
+ *
+ * 回环模式使用 FSI_enableRxInternalLoopback，本板发出的帧由自己接收，不同步 PWM。
+ *
+ * 硬件经 DRV_FSI_PORT_* 接口访问：目标板由 drv_fsi_port.c 以 DriverLib 实现，主机端由
+ * tools/host/fsi_host 中的链路模型提供，两者共用 drv_fsi.c。
+ */
+
+#ifndef DRV_FSI_H
+#define DRV_FSI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 帧长与载荷长度（字）。 */
+#define DRV_FSI_FRAME_WORDS         (16U)
+#define DRV_FSI_PAYLOAD_WORDS       (14U)
+#define DRV_FSI_SEQ_INDEX           (14U)
+#define DRV_FSI_CRC_INDEX           (15U)
+
+/** 接收槽：[TBCTR][TBSTS][16 字帧]。 */
+#define DRV_FSI_STAMP_WORDS         (2U)
+#define DRV_FSI_SLOT_WORDS          (DRV_FSI_STAMP_WORDS + DRV_FSI_FRAME_WORDS)
+#define DRV_FSI_RX_SLOTS            (4U)
+
+/** 帧标签。 */
+#define DRV_FSI_TAG_DATA            (1U)
+#define DRV_FSI_TAG_PING            (15U)
+
+/** 发送保护窗口（TBCLK）：顶点前 DRV_FSI_TX_GUARD_BEFORE 至顶点后 DRV_FSI_TX_GUARD_AFTER。 */
+#define DRV_FSI_TX_GUARD_BEFORE     (128U)
+#define DRV_FSI_TX_GUARD_AFTER      (400U)
+
+/** 本板节点号，作为帧的用户数据发送。 */
+#ifndef DRV_FSI_NODE_ID
+#define DRV_FSI_NODE_ID             (1U)
+#endif
+
+/** Ping 周期与看门狗超时，单位 SYSCLK。 */
+#define DRV_FSI_PING_PERIOD_CYCLES  (100000UL)
+#define DRV_FSI_PING_TIMEOUT_CYCLES (300000UL)
+
+/** 默认发送到接收 DMA 的延迟（TBCLK）：16 字帧约 292 位，100 Mbit/s，另加 DMA 读出。 */
+#ifndef DRV_FSI_SYNC_LATENCY_COUNTS
+#define DRV_FSI_SYNC_LATENCY_COUNTS (300U)
+#endif
+
+/** TBPRD 微调上限（计数）。 */
+#define DRV_FSI_SYNC_MAX_TRIM       (32)
+
+/** 相位误差小于该值时积分才累加，避免大误差牵引期间积分饱和。 */
+#define DRV_FSI_SYNC_CAPTURE_COUNTS (64)
+
+/** 连续 DRV_FSI_SYNC_LOCK_FRAMES 帧误差不超过 DRV_FSI_SYNC_LOCK_COUNTS 视为锁定。 */
+#define DRV_FSI_SYNC_LOCK_COUNTS    (4)
+#define DRV_FSI_SYNC_LOCK_FRAMES    (32U)
+
+/** 锁定后单帧误差超过该值视为离群（例如帧被 Ping 帧推迟），连续 3 帧离群才失锁。 */
+#define DRV_FSI_SYNC_OUTLIER_COUNTS (64)
+#define DRV_FSI_SYNC_OUTLIER_LIMIT  (3U)
+
+/** 接收事件，由端口实现从硬件事件换算。 */
+#define DRV_FSI_EVT_PING_TIMEOUT    (0x0001U)
+#define DRV_FSI_EVT_CRC_ERROR       (0x0002U)
+#define DRV_FSI_EVT_FRAME_ERROR     (0x0004U)   /**< 帧尾或帧类型错误。 */
+#define DRV_FSI_EVT_OVERRUN         (0x0008U)
+
+/** ePWM 时基状态中的计数方向位（1 为增计数）。 */
+#define DRV_FSI_TBSTS_CTRDIR        (0x0001U)
+
+/**
+ * @brief 角色。两种角色都在每个 PWM 周期发送一帧，只有从板调整自己的 PWM。
+ */
+typedef enum
+{
+    DRV_FSI_ROLE_MASTER = 0,
+    DRV_FSI_ROLE_SLAVE
+} DRV_FSI_Role;
+
+/**
+ * @brief 接收到的一帧。
+ */
+typedef struct
+{
+    uint16_t payload[DRV_FSI_PAYLOAD_WORDS];
+    uint16_t sequence;
+    uint16_t arrival;               /**< 到达时距本板计数器归零的 TBCLK 数。 */
+} DRV_FSI_Frame;
+
+/**
+ * @brief 驱动统计。
+ */
+typedef struct
+{
+    uint32_t txFrames;              /**< 已暂存的帧数。 */
+    uint32_t rxFrames;              /**< 返回给读者的新帧数。 */
+    uint32_t rxLost;                /**< 按序号推算未读到的帧数。 */
+    uint32_t repeats;               /**< 对端未更新、序号重复的到达次数。 */
+    uint32_t crcErrors;             /**< 软件 CRC 不符的槽。 */
+    uint32_t torn;                  /**< 读取期间槽被 DMA 改写的次数。 */
+    uint32_t hwCrcErrors;           /**< 硬件 CRC 错误。 */
+    uint32_t frameErrors;           /**< 帧尾或帧类型错误。 */
+    uint32_t overruns;              /**< 接收缓冲区溢出。 */
+    uint32_t linkDowns;             /**< Ping 看门狗超时次数。 */
+    uint32_t outliers;              /**< 锁定后被忽略的离群相位误差。 */
+    bool     linkUp;
+    bool     locked;                /**< 从板：PWM 已与主板同步。 */
+    int16_t  phaseError;            /**< 最近一次相位误差（TBCLK），正值表示本板超前。 */
+    int16_t  trim;                  /**< 当前 TBPRD 微调量。 */
+    uint16_t latency;               /**< 最近一帧在顶点之后多久到达（TBCLK），减计数段有效。 */
+} DRV_FSI_Stats;
+
+/**
+ * @brief 初始化 FSIA、三路 DMA 通道与接收中断并开始收发。
+ *
+ * 需在 EALLOW 下、DRV_EPWM_init、DRV_EPWM_enableAdcTrigger 与 DRV_DMA_init 之后调用
+ * （DRV_DMA_init 会复位整个 DMA 控制器）。第一帧载荷为 0。
+ *
+ * @param[in] role     角色，从板在非回环模式下同步 PWM。
+ * @param[in] loopback 使用内部回环。
+ *
+ * @retval false 端口初始化失败。
+ */
+bool DRV_FSI_init(DRV_FSI_Role role, bool loopback);
+
+/**
+ * @brief 暂存下一帧载荷，在下一次 SOCA 发出。
+ *
+ * 在控制中断中每个 PWM 周期调用一次；调用更频繁时只有最后一次生效。在发送保护窗口
+ * 内调用时帧推迟一个周期。
+ *
+ * @param[in] payload DRV_FSI_PAYLOAD_WORDS 个字。
+ */
+bool DRV_FSI_send(const uint16_t *payload);
+
+/**
+ * @brief 读取最新的一帧。从板在此更新 PWM 同步。
+ *
+ * @retval false 没有新帧，或最新的槽校验失败。
+ */
+bool DRV_FSI_receive(DRV_FSI_Frame *frame);
+
+/**
+ * @brief 设置从板期望的到达延迟（TBCLK）。
+ */
+void DRV_FSI_setSyncLatency(uint16_t counts);
+
+/**
+ * @brief 读取驱动统计。
+ */
+void DRV_FSI_getStats(DRV_FSI_Stats *stats);
+
+/**
+ * @brief 按 4 bit 查表计算 CRC16（CCITT），每个字按高字节在前处理。
+ */
+uint16_t DRV_FSI_crc16(uint16_t crc, const uint16_t *data, uint16_t length);
+
+/**
+ * @brief 接收错误中断报告 DRV_FSI_EVT_* 事件，由端口实现调用。
+ */
+void DRV_FSI_onRxEvents(uint16_t events);
+
+/*
+ * 硬件接口。
+ */
+
+/** 配置时钟、引脚、FSIA、DMA 与中断，接收 DMA 的目标为 rxRing，尚未开始收发。 */
+bool DRV_FSI_PORT_init(bool loopback, uint16_t *rxRing);
+
+/** 把第一帧直接写入发送缓冲区，以 frame 为 DMA 源并开始按 SOCA 发送。 */
+void DRV_FSI_PORT_start(const uint16_t *frame);
+
+/** 改写发送 DMA 源地址影子寄存器，不在发送保护窗口内时立即触发搬运。 */
+void DRV_FSI_PORT_setTxSource(const uint16_t *frame);
+
+/** 返回接收 DMA 下一次写入的槽号 0~DRV_FSI_RX_SLOTS-1。 */
+uint16_t DRV_FSI_PORT_getRxSlot(void);
+
+/** 返回本板 TBPRD 的标称值。 */
+uint16_t DRV_FSI_PORT_getPeriod(void);
+
+/** 以标称值加 counts 设置三路 ePWM 的 TBPRD。 */
+void DRV_FSI_PORT_trimPeriod(int16_t counts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_FSI_H */
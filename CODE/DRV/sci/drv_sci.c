@@ -0,0 +1,209 @@
+/**
+ * @file drv_sci.c
+ * @brief SCIA 驱动实现文件，FIFO 中断驱动的零复制发送与环形接收。
+ */
+
+#include "drv_sci.h"
+
+#include "driverlib.h"
+#include "device.h"
+
+#define DRV_SCI_BASE            (SCIA_BASE)
+#define DRV_SCI_TX_FIFO_LEVEL   (SCI_FIFO_TX4)  /**< TX FIFO 不多于 4 字节时补充。 */
+#define DRV_SCI_RX_FIFO_LEVEL   (SCI_FIFO_RX1)  /**< 收到即取走，降低命令延迟。 */
+
+__interrupt void DRV_SCI_txISR(void);
+__interrupt void DRV_SCI_rxISR(void);
+
+/** 发送队列：任务只写 head，中断只写 tail；槽位以 volatile 访问，保证先于 head 写入。 */
+static DRV_SCI_TxBuffer * volatile s_txQueue[DRV_SCI_TX_QUEUE_DEPTH];
+static volatile uint16_t s_txHead = 0U;
+static volatile uint16_t s_txTail = 0U;
+static uint16_t s_txIndex = 0U;                 /**< 当前缓冲区已发送的字节数。 */
+
+/** 接收缓冲区：中断只写 head，任务只写 tail。 */
+static volatile uint16_t s_rxBuffer[DRV_SCI_RX_BUFFER_SIZE];
+static volatile uint16_t s_rxHead = 0U;
+static volatile uint16_t s_rxTail = 0U;
+
+static DRV_SCI_Stats s_stats;
+
+static void DRV_SCI_configurePins(void)
+{
+    GPIO_setPinConfig(DEVICE_GPIO_CFG_SCIRXDA);
+    GPIO_setPinConfig(DEVICE_GPIO_CFG_SCITXDA);
+
+    GPIO_setQualificationMode(DEVICE_GPIO_PIN_SCIRXDA, GPIO_QUAL_ASYNC);
+    GPIO_setPadConfig(DEVICE_GPIO_PIN_SCIRXDA, GPIO_PIN_TYPE_PULLUP);
+    GPIO_setPadConfig(DEVICE_GPIO_PIN_SCITXDA, GPIO_PIN_TYPE_STD);
+}
+
+void DRV_SCI_init(void)
+{
+    SysCtl_enablePeripheral(SYSCTL_PERIPH_CLK_SCIA);
+    DRV_SCI_configurePins();
+
+    SCI_performSoftwareReset(DRV_SCI_BASE);
+    SCI_setConfig(DRV_SCI_BASE, DEVICE_LSPCLK_FREQ, DRV_SCI_BAUD,
+                  SCI_CONFIG_WLEN_8 | SCI_CONFIG_STOP_ONE | SCI_CONFIG_PAR_NONE);
+
+    SCI_resetChannels(DRV_SCI_BASE);
+    SCI_enableFIFO(DRV_SCI_BASE);
+    SCI_setFIFOInterruptLevel(DRV_SCI_BASE, DRV_SCI_TX_FIFO_LEVEL, DRV_SCI_RX_FIFO_LEVEL);
+    SCI_resetTxFIFO(DRV_SCI_BASE);
+    SCI_resetRxFIFO(DRV_SCI_BASE);
+    SCI_clearInterruptStatus(DRV_SCI_BASE, SCI_INT_TXFF | SCI_INT_RXFF | SCI_INT_RXERR);
+
+    /* TX 中断在有数据入队时才打开。 */
+    SCI_enableInterrupt(DRV_SCI_BASE, SCI_INT_RXFF | SCI_INT_RXERR);
+    SCI_enableModule(DRV_SCI_BASE);
+
+    Interrupt_register(INT_SCIA_TX, &DRV_SCI_txISR);
+    Interrupt_register(INT_SCIA_RX, &DRV_SCI_rxISR);
+    Interrupt_enable(INT_SCIA_TX);
+    Interrupt_enable(INT_SCIA_RX);
+}
+
+bool DRV_SCI_send(DRV_SCI_TxBuffer *buffer)
+{
+    uint16_t head = s_txHead;
+
+    if((buffer == NULL) || (buffer->data == NULL) || (buffer->length == 0U) ||
+       (buffer->busy != 0U) || ((uint16_t)(head - s_txTail) >= DRV_SCI_TX_QUEUE_DEPTH))
+    {
+        return false;
+    }
+
+    buffer->busy = 1U;
+    s_txQueue[head & DRV_SCI_TX_QUEUE_MASK] = buffer;
+    s_txHead = head + 1U;
+
+    /* 中断可能已因队列为空而关闭；重新打开后 FIFO 低于门限会立即进入中断。 */
+    SCI_enableInterrupt(DRV_SCI_BASE, SCI_INT_TXFF);
+
+    return true;
+}
+
+uint16_t DRV_SCI_getTxPending(void)
+{
+    return (uint16_t)(s_txHead - s_txTail);
+}
+
+uint16_t DRV_SCI_read(uint16_t *data, uint16_t maxLength)
+{
+    uint16_t tail = s_rxTail;
+    uint16_t head = s_rxHead;
+    uint16_t count = 0U;
+
+    if(data == NULL)
+    {
+        return 0U;
+    }
+
+    while((tail != head) && (count < maxLength))
+    {
+        data[count] = s_rxBuffer[tail & DRV_SCI_RX_BUFFER_MASK];
+        count++;
+        tail++;
+    }
+
+    s_rxTail = tail;
+
+    return count;
+}
+
+void DRV_SCI_getStats(DRV_SCI_Stats *stats)
+{
+    if(stats == NULL)
+    {
+        return;
+    }
+
+    Interrupt_disable(INT_SCIA_TX);
+    Interrupt_disable(INT_SCIA_RX);
+    *stats = s_stats;
+    Interrupt_enable(INT_SCIA_RX);
+    Interrupt_enable(INT_SCIA_TX);
+}
+
+/**
+ * @brief TX FIFO 中断：从队首缓冲区填满 FIFO，队列为空时关闭中断。
+ */
+__interrupt void DRV_SCI_txISR(void)
+{
+    uint16_t tail = s_txTail;
+
+    while(tail != s_txHead)
+    {
+        DRV_SCI_TxBuffer *buffer = s_txQueue[tail & DRV_SCI_TX_QUEUE_MASK];
+
+        while((s_txIndex < buffer->length) &&
+              (SCI_getTxFIFOStatus(DRV_SCI_BASE) != SCI_FIFO_TX16))
+        {
+            HWREGH(DRV_SCI_BASE + SCI_O_TXBUF) = buffer->data[s_txIndex] & 0xFFU;
+            s_txIndex++;
+            s_stats.txBytes++;
+        }
+
+        if(s_txIndex < buffer->length)
+        {
+            break;
+        }
+
+        s_txIndex = 0U;
+        buffer->busy = 0U;
+        s_stats.txBuffers++;
+        tail++;
+    }
+
+    s_txTail = tail;
+
+    if(tail == s_txHead)
+    {
+        SCI_disableInterrupt(DRV_SCI_BASE, SCI_INT_TXFF);
+    }
+
+    SCI_clearInterruptStatus(DRV_SCI_BASE, SCI_INT_TXFF);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP9);
+}
+
+/**
+ * @brief RX FIFO 中断：取空 FIFO 放入接收缓冲区，出错时复位接收器。
+ */
+__interrupt void DRV_SCI_rxISR(void)
+{
+    uint16_t head = s_rxHead;
+
+    while(SCI_getRxFIFOStatus(DRV_SCI_BASE) != SCI_FIFO_RX0)
+    {
+        uint16_t data = HWREGH(DRV_SCI_BASE + SCI_O_RXBUF) & 0xFFU;
+
+        if((uint16_t)(head - s_rxTail) < DRV_SCI_RX_BUFFER_SIZE)
+        {
+            s_rxBuffer[head & DRV_SCI_RX_BUFFER_MASK] = data;
+            head++;
+            s_stats.rxBytes++;
+        }
+        else
+        {
+            s_stats.rxDropped++;
+        }
+    }
+
+    s_rxHead = head;
+
+    if((SCI_getRxStatus(DRV_SCI_BASE) & SCI_RXSTATUS_ERROR) != 0U)
+    {
+        s_stats.rxErrors++;
+        SCI_performSoftwareReset(DRV_SCI_BASE);
+    }
+
+    if(SCI_getOverflowStatus(DRV_SCI_BASE))
+    {
+        s_stats.rxErrors++;
+        SCI_clearOverflowStatus(DRV_SCI_BASE);
+    }
+
+    SCI_clearInterruptStatus(DRV_SCI_BASE, SCI_INT_RXFF | SCI_INT_RXERR);
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP9);
+}
@@ -1,18 +1,79 @@
 /**
  * @file drv_spi.c
  * @brief SPI 驱动实现文件，完成 SPI 外设初始化与 DRV8316 兼容绑定。
+ *
+ * DRV8316 的寄存器访问经由 drv_spi_xfer.c 中的总线事务管理器发送。任务上下文中
+ * 调用者阻塞在每个器件的二值信号量上，由事务完成回调释放；全局中断被屏蔽的
+ * 初始化阶段改为轮询。
  */
 
 #include "drv_spi.h"
 
 #include "device.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/spi.h"
 #include "driverlib/sysctl.h"
 
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#include <string.h>
+
 #define DRV_SPI_DEFAULT_BASE            (SPIA_BASE)        /**< 默认使用 SPIA 外设作为通信控制器。 */
 #define DRV_SPI_DEFAULT_BITRATE_HZ      (1000000UL)        /**< 默认 SPI 波特率 1 MHz，兼顾 DRV8316 的时序要求与 EMC。 */
 #define DRV_SPI_DEFAULT_DATA_WIDTH      (16U)              /**< DRV8316 寄存器宽度为 16 bit，对齐读写操作。 */
+#define DRV_SPI_DRV8316_TIMEOUT_FRAMES  (64UL)             /**< DRV8316 单帧等待上限，按帧时间计，包含排在前面的事务。 */
+#define DRV_SPI_DRV8316_RESP_RESERVED   (0x8000U)          /**< 应答中 STATUS_0 的保留位，恒为 0。 */
+#define DRV_SPI_DRV8316_RESP_SPI_FLT    ((uint16_t)DRV8316_SPI_FLT << 8) /**< 应答中 STATUS_0 的 SPI_FLT 位。 */
+#define DRV_SPI_DRV8316_DLY_TARGET_MASK (0x000FU)          /**< CONTROL_10 中自检使用的 DLY_TARGET 字段。 */
+#define DRV_SPI_DRV8316_TIMEOUT_TICKS   (2U)               /**< 任务上下文单帧等待上限，至少跨过一个完整 tick。 */
+
+/**
+ * @brief 速率档位，取 LSPCLK 的整数分频，保证 SPI_setConfig 得到的实际速率与表值一致。
+ *
+ * 第 0 档约为 DRV_SPI_DEFAULT_BITRATE_HZ，最高档为 SPI 外设允许的 LSPCLK/4。
+ */
+static const uint32_t s_rateSteps[] =
+{
+    DEVICE_LSPCLK_FREQ / 25UL,
+    DEVICE_LSPCLK_FREQ / 12UL,
+    DEVICE_LSPCLK_FREQ / 8UL,
+    DEVICE_LSPCLK_FREQ / 6UL,
+    DEVICE_LSPCLK_FREQ / 5UL,
+    DEVICE_LSPCLK_FREQ / 4UL
+};
+
+#define DRV_SPI_RATE_STEP_COUNT         ((uint16_t)(sizeof(s_rateSteps) / sizeof(s_rateSteps[0])))
+
+/** 自检写入 DLY_TARGET 的测试图样，覆盖全 0、全 1 与交替位。 */
+static const uint16_t s_selfTestPatterns[] = { 0x5U, 0xAU, 0x0U, 0xFU, 0x3U, 0xCU, 0x6U, 0x9U };
+
+/**
+ * @brief DRV8316 句柄与总线事务管理器之间的绑定。
+ *
+ * 每个句柄占用一个静态事务描述符，DRV8316 驱动的每一帧都经由该描述符提交，
+ * 从而与总线上其它设备按优先级仲裁。
+ */
+typedef struct
+{
+    DRV8316_Handle      handle;
+    uint16_t            txWord;
+    uint16_t            rxWord;
+    uint32_t            timeoutPolls;
+    uint16_t            lastStatus;     /**< 上一帧应答中的 SPI_FLT 状态。 */
+    uint16_t            rateStep;       /**< 当前速率所在档位。 */
+    uint16_t            windowFrames;   /**< 降速判据窗口内的帧数。 */
+    uint16_t            windowErrors;   /**< 降速判据窗口内的错误数。 */
+    bool                probing;        /**< 自检进行中，暂停自动降速。 */
+    DRV_SPI_LinkStats   stats;
+    DRV_SPI_Transaction xfer;
+    SemaphoreHandle_t   done;           /**< 事务完成时由回调释放。 */
+    StaticSemaphore_t   doneBuffer;
+} DRV_SPI_Drv8316Link;
+
+static DRV_SPI_Drv8316Link s_drv8316Links[DRV_SPI_MAX_DEVICES];
+static uint16_t            s_drv8316LinkCount = 0U;
 
 static DRV_SPI_State s_spiState =
 {
@@ -21,6 +82,7 @@ static DRV_SPI_State s_spiState =
     .dataWidth   = DRV_SPI_DEFAULT_DATA_WIDTH,
     .csGpio      = DRV_SPI_INVALID_GPIO,
     .enableGpio  = DRV_SPI_INVALID_GPIO,
+    .csCount     = 0U,
     .initialized = false
 };
 
@@ -148,8 +210,16 @@ void DRV_SPI_init(void)
                              SPI_INT_TXFF);
 
     DRV_SPI_configureChipSelectPin(s_spiState.csGpio);
+
+    for(uint16_t index = 0U; index < s_spiState.csCount; index++)
+    {
+        DRV_SPI_configureChipSelectPin(s_spiState.csTable[index]);
+    }
+
     DRV_SPI_configureEnablePin(s_spiState.enableGpio);
 
+    DRV_SPI_xferInit(s_spiState.base);
+
     s_spiState.initialized = true;
 }
 
@@ -167,6 +237,43 @@ void DRV_SPI_setChipSelectGPIO(uint32_t gpio)
     }
 }
 
+bool DRV_SPI_addChipSelectGPIO(uint32_t gpio)
+{
+    /**
+     * 共享总线上的每个从设备各占一个片选。先查重，保证同一引脚只登记一次；
+     * 未满时追加到片选表，并在驱动已初始化时立即完成引脚配置。
+     */
+    uint16_t index;
+
+    if(gpio == DRV_SPI_INVALID_GPIO)
+    {
+        return false;
+    }
+
+    for(index = 0U; index < s_spiState.csCount; index++)
+    {
+        if(s_spiState.csTable[index] == gpio)
+        {
+            return true;
+        }
+    }
+
+    if(s_spiState.csCount >= DRV_SPI_MAX_CHIP_SELECTS)
+    {
+        return false;
+    }
+
+    s_spiState.csTable[s_spiState.csCount] = gpio;
+    s_spiState.csCount++;
+
+    if(s_spiState.initialized)
+    {
+        DRV_SPI_configureChipSelectPin(gpio);
+    }
+
+    return true;
+}
+
 void DRV_SPI_setEnableGPIO(uint32_t gpio)
 {
     /**
@@ -193,12 +300,249 @@ void DRV_SPI_getState(DRV_SPI_State *state)
     }
 }
 
+static uint16_t DRV_SPI_findRateStep(uint32_t bitRate)
+{
+    /* 返回不高于 bitRate 的最高档位，低于第 0 档时按第 0 档处理。 */
+    uint16_t step = 0U;
+
+    while(((step + 1U) < DRV_SPI_RATE_STEP_COUNT) && (s_rateSteps[step + 1U] <= bitRate))
+    {
+        step++;
+    }
+
+    return step;
+}
+
+static bool DRV_SPI_applyDrv8316Rate(DRV_SPI_Drv8316Link *link, uint32_t bitRate)
+{
+    if(!DRV_SPI_setDeviceBitRate(link->xfer.device, bitRate))
+    {
+        return false;
+    }
+
+    DRV8316_setTiming(link->handle, DEVICE_SYSCLK_FREQ, bitRate);
+
+    link->timeoutPolls   = (uint32_t)((16ULL * DEVICE_SYSCLK_FREQ) / bitRate) *
+                           DRV_SPI_DRV8316_TIMEOUT_FRAMES;
+    link->rateStep       = DRV_SPI_findRateStep(bitRate);
+    link->windowFrames   = 0U;
+    link->windowErrors   = 0U;
+    link->stats.bitRate  = bitRate;
+
+    return true;
+}
+
+static void DRV_SPI_updateLinkQuality(DRV_SPI_Drv8316Link *link, bool received)
+{
+    /**
+     * 按帧累计链路错误。窗口内错误数达到门限即降低一档速率，
+     * 降速后重新开窗，窗口满而错误不足门限时清零重计。
+     */
+    bool error = false;
+
+    link->stats.frames++;
+
+    if(!received)
+    {
+        link->stats.timeouts++;
+        error = true;
+    }
+    else if((link->rxWord & DRV_SPI_DRV8316_RESP_RESERVED) != 0U)
+    {
+        link->stats.respErrors++;
+        error = true;
+    }
+    else
+    {
+        uint16_t spiFlt = link->rxWord & DRV_SPI_DRV8316_RESP_SPI_FLT;
+
+        if((spiFlt != 0U) && (link->lastStatus == 0U))
+        {
+            link->stats.parityFaults++;
+            error = true;
+        }
+
+        link->lastStatus = spiFlt;
+    }
+
+    if(error)
+    {
+        link->windowErrors++;
+    }
+
+    if(link->probing)
+    {
+        return;
+    }
+
+    if(link->windowErrors >= DRV_SPI_BACKOFF_ERRORS)
+    {
+        if((link->rateStep > 0U) &&
+           DRV_SPI_applyDrv8316Rate(link, s_rateSteps[link->rateStep - 1U]))
+        {
+            link->stats.rateDowns++;
+        }
+
+        link->windowFrames = 0U;
+        link->windowErrors = 0U;
+    }
+    else if(++link->windowFrames >= DRV_SPI_BACKOFF_WINDOW)
+    {
+        link->windowFrames = 0U;
+        link->windowErrors = 0U;
+    }
+}
+
+static void DRV_SPI_drv8316Done(DRV_SPI_Transaction *xfer)
+{
+    /* 在 SPI 中断中执行；初始化阶段的轮询路径也会调用，此时无任务等待。 */
+    DRV_SPI_Drv8316Link *link = (DRV_SPI_Drv8316Link *)xfer->context;
+    BaseType_t woken = pdFALSE;
+
+    (void)xSemaphoreGiveFromISR(link->done, &woken);
+
+    portYIELD_FROM_ISR(woken);
+}
+
+static bool DRV_SPI_drv8316Wait(DRV_SPI_Drv8316Link *link)
+{
+    /**
+     * 提交后阻塞在完成信号量上，帧间不占用 CPU，也不反复开关全局中断。
+     * 先清除轮询路径或超时事务遗留的释放；超时后取消事务，取消与完成之间的
+     * 竞争由 DRV_SPI_cancel 在屏蔽中断时判断状态解决。
+     */
+    (void)xSemaphoreTake(link->done, 0U);
+
+    if(!DRV_SPI_submit(&link->xfer))
+    {
+        return false;
+    }
+
+    while((link->xfer.status == DRV_SPI_XFER_QUEUED) || (link->xfer.status == DRV_SPI_XFER_ACTIVE))
+    {
+        if(xSemaphoreTake(link->done, DRV_SPI_DRV8316_TIMEOUT_TICKS) != pdTRUE)
+        {
+            DRV_SPI_cancel(&link->xfer);
+        }
+    }
+
+    return (link->xfer.status == DRV_SPI_XFER_DONE);
+}
+
+static bool DRV_SPI_drv8316Transfer(void *context, uint16_t ctrlWord, uint16_t *response)
+{
+    /**
+     * DRV8316 驱动的单帧传输委托：一帧即一笔事务，逐帧片选，
+     * 高优先级事务可以插入同一次扫描的两帧之间。全局中断开启时（任务上下文）
+     * 阻塞等待完成回调，屏蔽时（调度启动前）轮询。
+     */
+    DRV_SPI_Drv8316Link *link = (DRV_SPI_Drv8316Link *)context;
+    bool intsOff;
+    bool received;
+
+    link->txWord = ctrlWord;
+    link->rxWord = 0U;
+
+    intsOff = Interrupt_disableGlobal();
+
+    if(intsOff)
+    {
+        received = DRV_SPI_transferBlocking(&link->xfer, link->timeoutPolls);
+    }
+    else
+    {
+        (void)Interrupt_enableGlobal();
+        received = DRV_SPI_drv8316Wait(link);
+    }
+
+    *response = link->rxWord;
+
+    DRV_SPI_updateLinkQuality(link, received);
+
+    return received;
+}
+
+static DRV_SPI_Drv8316Link *DRV_SPI_findDrv8316Link(DRV8316_Handle handle)
+{
+    uint16_t index;
+
+    for(index = 0U; index < s_drv8316LinkCount; index++)
+    {
+        if(s_drv8316Links[index].handle == handle)
+        {
+            return &s_drv8316Links[index];
+        }
+    }
+
+    return NULL;
+}
+
+static DRV_SPI_Drv8316Link *DRV_SPI_getDrv8316Link(DRV8316_Handle handle, uint32_t csGpio)
+{
+    /**
+     * 同一句柄重复绑定时复用原有描述符；新句柄在总线上登记为一个逐帧片选设备。
+     */
+    DRV_SPI_DeviceConfig config;
+    DRV_SPI_Drv8316Link *link = DRV_SPI_findDrv8316Link(handle);
+
+    if(link != NULL)
+    {
+        return link;
+    }
+
+    if(s_drv8316LinkCount >= DRV_SPI_MAX_DEVICES)
+    {
+        return NULL;
+    }
+
+    link = &s_drv8316Links[s_drv8316LinkCount];
+
+    config.csGpio     = csGpio;
+    config.bitRate    = s_spiState.bitRate;
+    config.protocol   = SPI_PROT_POL0PHA1;
+    config.dataWidth  = s_spiState.dataWidth;
+    config.csPerFrame = true;
+    config.csSetupNs  = DRV8316_CS_SETUP_NS;
+    config.csHoldNs   = DRV8316_CS_HOLD_NS;
+    config.csIdleNs   = DRV8316_CS_IDLE_NS;
+
+    if(!DRV_SPI_registerDevice(&config, &link->xfer.device))
+    {
+        return NULL;
+    }
+
+    link->handle        = handle;
+    link->timeoutPolls  = (uint32_t)((16ULL * DEVICE_SYSCLK_FREQ) / s_spiState.bitRate) *
+                          DRV_SPI_DRV8316_TIMEOUT_FRAMES;
+    link->lastStatus    = 0U;
+    link->rateStep      = DRV_SPI_findRateStep(s_spiState.bitRate);
+    link->windowFrames  = 0U;
+    link->windowErrors  = 0U;
+    link->probing       = false;
+    memset(&link->stats, 0, sizeof(link->stats));
+    link->stats.bitRate = s_spiState.bitRate;
+    link->xfer.priority = DRV_SPI_DRV8316_PRIORITY;
+    link->xfer.txBuf    = &link->txWord;
+    link->xfer.rxBuf    = &link->rxWord;
+    link->xfer.length   = 1U;
+    link->xfer.callback = &DRV_SPI_drv8316Done;
+    link->xfer.context  = link;
+    link->xfer.status   = DRV_SPI_XFER_IDLE;
+    link->done          = xSemaphoreCreateBinaryStatic(&link->doneBuffer);
+
+    s_drv8316LinkCount++;
+
+    return link;
+}
+
 void DRV_SPI_attachToDRV8316(DRV8316_Handle handle, uint32_t csGpio, uint32_t enableGpio)
 {
     /**
      * 为保持与现有 DRV8316 软件栈兼容，此接口封装了 SPI 初始化
      * 及 GPIO 绑定流程，并将 SPI 基地址交给 DRV8316 底层驱动使用。
      */
+    DRV_SPI_Drv8316Link *link;
+
     if(handle == NULL)
     {
         return;
@@ -206,9 +550,10 @@ void DRV_SPI_attachToDRV8316(DRV8316_Handle handle, uint32_t csGpio, uint32_t en
 
     DRV_SPI_init();
 
-    if(csGpio != DRV_SPI_INVALID_GPIO)
+    if((csGpio != DRV_SPI_INVALID_GPIO) && DRV_SPI_addChipSelectGPIO(csGpio))
     {
-        DRV_SPI_setChipSelectGPIO(csGpio);
+        /* 当前片选指向最近绑定的器件，其余片选保留在片选表中。 */
+        s_spiState.csGpio = csGpio;
         DRV8316_setGPIOCSNumber(handle, csGpio);
     }
 
@@ -219,4 +564,148 @@ void DRV_SPI_attachToDRV8316(DRV8316_Handle handle, uint32_t csGpio, uint32_t en
     }
 
     DRV8316_setSPIHandle(handle, s_spiState.base);
+
+    /* 片选建立/保持时间与应答超时按当前时钟与波特率一次性换算。 */
+    DRV8316_setTiming(handle, DEVICE_SYSCLK_FREQ, s_spiState.bitRate);
+
+    /* 之后的每一帧都经由总线事务管理器发送，片选由管理器按设备切换。 */
+    link = DRV_SPI_getDrv8316Link(handle, csGpio);
+
+    if(link != NULL)
+    {
+        DRV8316_setTransferFxn(handle, &DRV_SPI_drv8316Transfer, link);
+    }
+}
+
+bool DRV_SPI_setDRV8316BitRate(DRV8316_Handle handle, uint32_t bitRate)
+{
+    DRV_SPI_Drv8316Link *link = DRV_SPI_findDrv8316Link(handle);
+
+    if(link == NULL)
+    {
+        return false;
+    }
+
+    return DRV_SPI_applyDrv8316Rate(link, bitRate);
+}
+
+static uint16_t DRV_SPI_selfTestStep(DRV_SPI_Drv8316Link *link, uint16_t keepBits)
+{
+    /**
+     * 在当前速率下逐个写入测试图样并回读。回读不一致、应答超时以及
+     * readSPI 内部因应答校验失败而发生的重试都计为错误。
+     */
+    DRV8316_Obj *obj = (DRV8316_Obj *)link->handle;
+    uint16_t retriesBefore = DRV8316_getRxErrorCount(link->handle, DRV8316_ADDRESS_CONTROL_10);
+    uint16_t errors = 0U;
+    uint16_t round;
+
+    for(round = 0U; round < DRV_SPI_SELFTEST_ROUNDS; round++)
+    {
+        uint16_t pattern = keepBits |
+            s_selfTestPatterns[round % (sizeof(s_selfTestPatterns) / sizeof(s_selfTestPatterns[0]))];
+        uint16_t readBack;
+
+        obj->rxError = false;
+        DRV8316_resetRxTimeout(link->handle);
+
+        DRV8316_writeSPI(link->handle, DRV8316_ADDRESS_CONTROL_10, pattern);
+        readBack = DRV8316_readSPI(link->handle, DRV8316_ADDRESS_CONTROL_10);
+
+        if(obj->rxError || obj->rxTimeOut || (readBack != pattern))
+        {
+            errors++;
+        }
+    }
+
+    return (uint16_t)(errors +
+        (DRV8316_getRxErrorCount(link->handle, DRV8316_ADDRESS_CONTROL_10) - retriesBefore));
+}
+
+bool DRV_SPI_runDRV8316SelfTest(DRV8316_Handle handle, DRV_SPI_SelfTestResult *result)
+{
+    /**
+     * 逐档升速直至出现首个错误，取最高无误档位回退裕量后作为工作速率。
+     * 原始寄存器值在最低档读取，测试结束后在选定速率下写回。
+     */
+    DRV_SPI_Drv8316Link *link = DRV_SPI_findDrv8316Link(handle);
+    DRV_SPI_SelfTestResult local = { 0UL, 0UL, 0U, 0U, false };
+    uint16_t original;
+    uint16_t keepBits;
+    uint16_t step;
+    uint16_t cleanSteps = 0U;
+
+    if((link == NULL) || !DRV_SPI_applyDrv8316Rate(link, s_rateSteps[0]))
+    {
+        return false;
+    }
+
+    link->probing = true;
+
+    original = DRV8316_readSPI(handle, DRV8316_ADDRESS_CONTROL_10);
+    keepBits = original & (uint16_t)~DRV_SPI_DRV8316_DLY_TARGET_MASK;
+
+    for(step = 0U; step < DRV_SPI_RATE_STEP_COUNT; step++)
+    {
+        uint16_t errors;
+
+        (void)DRV_SPI_applyDrv8316Rate(link, s_rateSteps[step]);
+        local.stepsTested++;
+
+        errors = DRV_SPI_selfTestStep(link, keepBits);
+
+        if(errors != 0U)
+        {
+            local.failErrors = errors;
+            break;
+        }
+
+        cleanSteps = (uint16_t)(step + 1U);
+        local.maxCleanRate = s_rateSteps[step];
+    }
+
+    /* 最高无误档位为 cleanSteps - 1，再回退裕量档位。 */
+    step = (cleanSteps > (DRV_SPI_SELFTEST_MARGIN + 1U)) ?
+           (uint16_t)(cleanSteps - 1U - DRV_SPI_SELFTEST_MARGIN) : 0U;
+
+    (void)DRV_SPI_applyDrv8316Rate(link, s_rateSteps[step]);
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_10, original);
+
+    /* 高速档位上被器件判为错误的帧会锁存 SPI_FLT，以 CLR_FLT 清除。 */
+    if(link->lastStatus != 0U)
+    {
+        uint16_t ctrl02 = DRV8316_readSPI(handle, DRV8316_ADDRESS_CONTROL_2);
+
+        DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_2, (uint16_t)(ctrl02 | DRV8316_CTRL04_CLR_FLT_BITS));
+    }
+
+    link->probing      = false;
+    local.selectedRate = s_rateSteps[step];
+    local.passed       = (cleanSteps > 0U);
+
+    /* 自检期间的错误是刻意探测的结果，不计入运行期统计。 */
+    memset(&link->stats, 0, sizeof(link->stats));
+    link->stats.bitRate = local.selectedRate;
+    link->lastStatus    = 0U;
+
+    if(result != NULL)
+    {
+        *result = local;
+    }
+
+    return local.passed;
+}
+
+bool DRV_SPI_getDRV8316LinkStats(DRV8316_Handle handle, DRV_SPI_LinkStats *stats)
+{
+    const DRV_SPI_Drv8316Link *link = DRV_SPI_findDrv8316Link(handle);
+
+    if((link == NULL) || (stats == NULL))
+    {
+        return false;
+    }
+
+    *stats = link->stats;
+
+    return true;
 }
@@ -0,0 +1,586 @@
+/**
+ * @file drv_spi_xfer.c
+ * @brief 共享 SPI 总线的事务管理器，按优先级排队并由 RX FIFO 中断驱动传输。
+ *
+ * 每个从设备登记自己的片选、波特率、极性/相位与位宽，管理器在切换设备时重新
+ * 写入 SPI 外设。事务分块装入硬件 FIFO：片选保持型设备每块最多 16 帧，逐帧
+ * 片选设备（DRV8316）每块 1 帧。RX FIFO 中断阈值设为块内帧数，中断到来即表示
+ * 整块已移位完成。逐帧片选的事务在每个块边界检查是否有更高优先级的事务在等待，
+ * 有则让出总线，待高优先级事务完成后从断点继续。
+ *
+ * 队列与引擎状态只在屏蔽全局中断时修改，任务与中断两侧均可提交事务。
+ */
+
+#include "drv_spi.h"
+
+#include "device.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/spi.h"
+#include "driverlib/sysctl.h"
+
+#define DRV_SPI_XFER_QUEUE_MASK     (DRV_SPI_XFER_QUEUE_DEPTH - 1U)
+
+#if ((DRV_SPI_XFER_QUEUE_DEPTH & DRV_SPI_XFER_QUEUE_MASK) != 0U)
+#error "DRV_SPI_XFER_QUEUE_DEPTH 必须为 2 的幂。"
+#endif
+
+/**
+ * @brief 已登记的从设备。
+ */
+typedef struct
+{
+    DRV_SPI_DeviceConfig config;
+    uint16_t             rxMask;     /**< 接收数据的有效位掩码。 */
+    uint16_t             txShift;    /**< 发送数据左对齐所需的移位数。 */
+    uint32_t             setupDelay; /**< csSetupNs 换算得到的延时计数。 */
+    uint32_t             holdDelay;  /**< csHoldNs 换算得到的延时计数。 */
+    uint32_t             idleDelay;  /**< csIdleNs 换算得到的延时计数。 */
+} DRV_SPI_XferDevice;
+
+/**
+ * @brief 事务管理器运行状态。
+ */
+typedef struct
+{
+    uint32_t             base;
+    DRV_SPI_Transaction *queue[DRV_SPI_PRIO_COUNT][DRV_SPI_XFER_QUEUE_DEPTH];
+    uint16_t             head[DRV_SPI_PRIO_COUNT];
+    uint16_t             tail[DRV_SPI_PRIO_COUNT];
+    DRV_SPI_Transaction *resume[DRV_SPI_PRIO_COUNT]; /**< 在帧间被抢占、等待继续的事务。 */
+    DRV_SPI_Transaction * volatile active; /**< 当前占用总线的事务。 */
+    uint16_t             chunk;          /**< 已装入 FIFO、等待应答的帧数。 */
+    uint16_t             currentDevice;  /**< 外设当前配置所属的设备。 */
+    uint16_t             lastDeselected; /**< 最近一次释放片选的设备。 */
+    bool                 initialized;
+} DRV_SPI_XferEngine;
+
+static DRV_SPI_XferDevice s_xferDevices[DRV_SPI_MAX_DEVICES];
+static uint16_t           s_xferDeviceCount = 0U;
+
+static DRV_SPI_XferEngine s_xfer =
+{
+    .base           = SPIA_BASE,
+    .active         = NULL,
+    .chunk          = 0U,
+    .currentDevice  = DRV_SPI_INVALID_DEVICE,
+    .lastDeselected = DRV_SPI_INVALID_DEVICE,
+    .initialized    = false
+};
+
+static uint32_t DRV_SPI_nsToDelayCount(uint32_t ns)
+{
+    /* SysCtl_delay(count) 耗时约 5 * count + 9 个 SYSCLK 周期，向上取整；0 ns 不等待。 */
+    uint32_t cycles = (uint32_t)(((uint64_t)ns * (DEVICE_SYSCLK_FREQ / 1000000UL) + 999UL) / 1000UL);
+
+    if(ns == 0UL)
+    {
+        return 0UL;
+    }
+
+    return (cycles > 9UL) ? ((cycles - 9UL + 4UL) / 5UL) : 1UL;
+}
+
+static void DRV_SPI_delay(uint32_t count)
+{
+    if(count != 0UL)
+    {
+        SysCtl_delay(count);
+    }
+}
+
+static void DRV_SPI_writeChipSelect(const DRV_SPI_XferDevice *dev, uint32_t level)
+{
+    if(dev->config.csGpio != DRV_SPI_INVALID_GPIO)
+    {
+        GPIO_writePin(dev->config.csGpio, level);
+    }
+}
+
+static void DRV_SPI_applyDevice(uint16_t device)
+{
+    /**
+     * 不同设备的波特率、极性与位宽可能不同，只在切换设备时重新写入外设，
+     * 同一设备的连续事务不产生额外开销。FIFO 配置不受模块复位影响。
+     */
+    const DRV_SPI_XferDevice *dev = &s_xferDevices[device];
+
+    if(device == s_xfer.currentDevice)
+    {
+        return;
+    }
+
+    SPI_disableModule(s_xfer.base);
+    SPI_setConfig(s_xfer.base,
+                  DEVICE_LSPCLK_FREQ,
+                  dev->config.protocol,
+                  SPI_MODE_CONTROLLER,
+                  dev->config.bitRate,
+                  dev->config.dataWidth);
+    SPI_enableModule(s_xfer.base);
+
+    s_xfer.currentDevice = device;
+}
+
+static void DRV_SPI_loadChunk(void)
+{
+    /**
+     * 按设备类型决定块大小，设置 RX 中断阈值后拉低片选，等待片选建立时间后
+     * 连续写入 TX FIFO。逐帧片选时，同一设备两帧之间补足片选高电平时间。
+     */
+    DRV_SPI_Transaction *xfer = s_xfer.active;
+    const DRV_SPI_XferDevice *dev = &s_xferDevices[xfer->device];
+    uint16_t remaining = (uint16_t)(xfer->length - xfer->position);
+    uint16_t chunk;
+    uint16_t index;
+
+    if(dev->config.csPerFrame)
+    {
+        chunk = 1U;
+    }
+    else
+    {
+        chunk = (remaining > DRV_SPI_FIFO_DEPTH) ? DRV_SPI_FIFO_DEPTH : remaining;
+    }
+
+    SPI_resetRxFIFO(s_xfer.base);
+    SPI_setFIFOInterruptLevel(s_xfer.base, SPI_FIFO_TX0, (SPI_RxFIFOLevel)chunk);
+    SPI_clearInterruptStatus(s_xfer.base, SPI_INT_RXFF | SPI_INT_RXFF_OVERFLOW);
+
+    if(dev->config.csPerFrame || (xfer->position == 0U))
+    {
+        if(s_xfer.lastDeselected == xfer->device)
+        {
+            DRV_SPI_delay(dev->idleDelay);
+        }
+
+        DRV_SPI_writeChipSelect(dev, 0U);
+        DRV_SPI_delay(dev->setupDelay);
+    }
+
+    for(index = 0U; index < chunk; index++)
+    {
+        SPI_writeDataNonBlocking(s_xfer.base,
+                                 (uint16_t)(xfer->txBuf[xfer->position + index] << dev->txShift));
+    }
+
+    s_xfer.chunk = chunk;
+}
+
+static void DRV_SPI_startTransaction(DRV_SPI_Transaction *xfer)
+{
+    s_xfer.active = xfer;
+    xfer->status  = DRV_SPI_XFER_ACTIVE;
+
+    DRV_SPI_applyDevice(xfer->device);
+    DRV_SPI_loadChunk();
+}
+
+static DRV_SPI_Transaction *DRV_SPI_takeNext(DRV_SPI_Priority above)
+{
+    /**
+     * 从最高优先级开始查找，只返回优先级数值小于 above 的事务。同一优先级中
+     * 被抢占的事务先于新入队的事务继续；已被取消的队列项直接丢弃。
+     */
+    uint16_t prio;
+
+    for(prio = 0U; prio < (uint16_t)above; prio++)
+    {
+        if(s_xfer.resume[prio] != NULL)
+        {
+            DRV_SPI_Transaction *xfer = s_xfer.resume[prio];
+
+            s_xfer.resume[prio] = NULL;
+            return xfer;
+        }
+
+        while(s_xfer.head[prio] != s_xfer.tail[prio])
+        {
+            DRV_SPI_Transaction *xfer = s_xfer.queue[prio][s_xfer.head[prio]];
+
+            s_xfer.head[prio] = (uint16_t)((s_xfer.head[prio] + 1U) & DRV_SPI_XFER_QUEUE_MASK);
+
+            if(xfer->status == DRV_SPI_XFER_QUEUED)
+            {
+                return xfer;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void DRV_SPI_startNext(void)
+{
+    DRV_SPI_Transaction *xfer = DRV_SPI_takeNext(DRV_SPI_PRIO_COUNT);
+
+    s_xfer.active = NULL;
+    s_xfer.chunk  = 0U;
+
+    if(xfer != NULL)
+    {
+        DRV_SPI_startTransaction(xfer);
+    }
+}
+
+static void DRV_SPI_finish(DRV_SPI_Transaction *xfer, DRV_SPI_XferStatus status)
+{
+    /* 先释放总线再回调，回调中可以立即提交下一笔事务。 */
+    s_xfer.active = NULL;
+    s_xfer.chunk  = 0U;
+    xfer->status  = status;
+
+    if(xfer->callback != NULL)
+    {
+        xfer->callback(xfer);
+    }
+
+    if(s_xfer.active == NULL)
+    {
+        DRV_SPI_startNext();
+    }
+}
+
+static void DRV_SPI_service(void)
+{
+    /**
+     * 块内全部应答到齐后取出数据、推进断点，然后完成事务、让出总线或装入下一块。
+     * 应答未到齐时（轮询与中断同时触发的残留）直接返回。调用时全局中断已屏蔽。
+     */
+    DRV_SPI_Transaction *xfer = s_xfer.active;
+    const DRV_SPI_XferDevice *dev;
+    DRV_SPI_Transaction *next;
+    uint16_t index;
+
+    if((xfer == NULL) || (s_xfer.chunk == 0U))
+    {
+        SPI_clearInterruptStatus(s_xfer.base, SPI_INT_RXFF | SPI_INT_RXFF_OVERFLOW);
+        return;
+    }
+
+    if((uint16_t)SPI_getRxFIFOStatus(s_xfer.base) < s_xfer.chunk)
+    {
+        return;
+    }
+
+    dev = &s_xferDevices[xfer->device];
+
+    for(index = 0U; index < s_xfer.chunk; index++)
+    {
+        uint16_t word = SPI_readDataNonBlocking(s_xfer.base) & dev->rxMask;
+
+        if(xfer->rxBuf != NULL)
+        {
+            xfer->rxBuf[xfer->position + index] = word;
+        }
+    }
+
+    xfer->position = (uint16_t)(xfer->position + s_xfer.chunk);
+    s_xfer.chunk   = 0U;
+
+    if(dev->config.csPerFrame || (xfer->position >= xfer->length))
+    {
+        /* 应答到齐即末个 SCLK 沿已过，补足片选保持时间后释放。 */
+        DRV_SPI_delay(dev->holdDelay);
+        DRV_SPI_writeChipSelect(dev, 1U);
+        s_xfer.lastDeselected = xfer->device;
+    }
+
+    SPI_clearInterruptStatus(s_xfer.base, SPI_INT_RXFF | SPI_INT_RXFF_OVERFLOW);
+
+    if(xfer->position >= xfer->length)
+    {
+        DRV_SPI_finish(xfer, DRV_SPI_XFER_DONE);
+        return;
+    }
+
+    /* 片选已释放的块边界是唯一允许抢占的位置。 */
+    if(dev->config.csPerFrame)
+    {
+        next = DRV_SPI_takeNext(xfer->priority);
+
+        if(next != NULL)
+        {
+            s_xfer.resume[xfer->priority] = xfer;
+            DRV_SPI_startTransaction(next);
+            return;
+        }
+    }
+
+    DRV_SPI_loadChunk();
+}
+
+static void DRV_SPI_cancelLocked(DRV_SPI_Transaction *xfer)
+{
+    /**
+     * 排队中的事务只改状态，出队时被丢弃；正在传输的事务释放片选并清空 FIFO
+     * 后让出总线；被抢占的事务从断点槽中移除。调用时全局中断已屏蔽。
+     */
+    uint16_t prio;
+
+    if(xfer->status == DRV_SPI_XFER_QUEUED)
+    {
+        xfer->status = DRV_SPI_XFER_ERROR;
+        return;
+    }
+
+    if(xfer->status != DRV_SPI_XFER_ACTIVE)
+    {
+        return;
+    }
+
+    if(s_xfer.active == xfer)
+    {
+        DRV_SPI_writeChipSelect(&s_xferDevices[xfer->device], 1U);
+        s_xfer.lastDeselected = xfer->device;
+        SPI_resetTxFIFO(s_xfer.base);
+        SPI_resetRxFIFO(s_xfer.base);
+        SPI_clearInterruptStatus(s_xfer.base, SPI_INT_RXFF | SPI_INT_RXFF_OVERFLOW);
+        xfer->status = DRV_SPI_XFER_ERROR;
+        DRV_SPI_startNext();
+        return;
+    }
+
+    for(prio = 0U; prio < (uint16_t)DRV_SPI_PRIO_COUNT; prio++)
+    {
+        if(s_xfer.resume[prio] == xfer)
+        {
+            s_xfer.resume[prio] = NULL;
+        }
+    }
+
+    xfer->status = DRV_SPI_XFER_ERROR;
+}
+
+void DRV_SPI_xferInit(uint32_t base)
+{
+    /**
+     * 清空队列并挂接 RX FIFO 中断。中断在此使能，但全局中断打开之前的
+     * 传输由 DRV_SPI_transferBlocking 轮询完成。
+     */
+    uint16_t prio;
+    uint32_t intNumber = (base == SPIB_BASE) ? INT_SPIB_RX : INT_SPIA_RX;
+
+    if(s_xfer.initialized)
+    {
+        return;
+    }
+
+    s_xfer.base           = base;
+    s_xfer.active         = NULL;
+    s_xfer.chunk          = 0U;
+    s_xfer.currentDevice  = DRV_SPI_INVALID_DEVICE;
+    s_xfer.lastDeselected = DRV_SPI_INVALID_DEVICE;
+
+    for(prio = 0U; prio < (uint16_t)DRV_SPI_PRIO_COUNT; prio++)
+    {
+        s_xfer.head[prio]   = 0U;
+        s_xfer.tail[prio]   = 0U;
+        s_xfer.resume[prio] = NULL;
+    }
+
+    SPI_clearInterruptStatus(base, SPI_INT_RXFF | SPI_INT_RXFF_OVERFLOW);
+    SPI_enableInterrupt(base, SPI_INT_RXFF);
+
+    Interrupt_register(intNumber, &DRV_SPI_rxISR);
+    Interrupt_enable(intNumber);
+
+    s_xfer.initialized = true;
+}
+
+bool DRV_SPI_registerDevice(const DRV_SPI_DeviceConfig *config, uint16_t *deviceId)
+{
+    DRV_SPI_XferDevice *dev;
+
+    if((config == NULL) || (deviceId == NULL) ||
+       (config->bitRate == 0UL) ||
+       (config->dataWidth == 0U) || (config->dataWidth > 16U) ||
+       (s_xferDeviceCount >= DRV_SPI_MAX_DEVICES))
+    {
+        return false;
+    }
+
+    if((config->csGpio != DRV_SPI_INVALID_GPIO) && !DRV_SPI_addChipSelectGPIO(config->csGpio))
+    {
+        return false;
+    }
+
+    dev = &s_xferDevices[s_xferDeviceCount];
+
+    dev->config     = *config;
+    dev->txShift    = (uint16_t)(16U - config->dataWidth);
+    dev->rxMask     = (uint16_t)(0xFFFFU >> dev->txShift);
+    dev->setupDelay = DRV_SPI_nsToDelayCount(config->csSetupNs);
+    dev->holdDelay  = DRV_SPI_nsToDelayCount(config->csHoldNs);
+    dev->idleDelay  = DRV_SPI_nsToDelayCount(config->csIdleNs);
+
+    *deviceId = s_xferDeviceCount;
+    s_xferDeviceCount++;
+
+    return true;
+}
+
+bool DRV_SPI_setDeviceBitRate(uint16_t device, uint32_t bitRate)
+{
+    /**
+     * 只改写登记表；若该设备的参数正在外设中生效，则标记为失效，
+     * 下一笔事务开始时按新速率重新配置，不打断正在移位的帧。
+     */
+    bool intsOff;
+
+    if((device >= s_xferDeviceCount) ||
+       (bitRate < (DEVICE_LSPCLK_FREQ / 128UL)) || (bitRate > (DEVICE_LSPCLK_FREQ / 4UL)))
+    {
+        return false;
+    }
+
+    intsOff = Interrupt_disableGlobal();
+
+    s_xferDevices[device].config.bitRate = bitRate;
+
+    if(s_xfer.currentDevice == device)
+    {
+        s_xfer.currentDevice = DRV_SPI_INVALID_DEVICE;
+    }
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+
+    return true;
+}
+
+uint32_t DRV_SPI_getDeviceBitRate(uint16_t device)
+{
+    return (device < s_xferDeviceCount) ? s_xferDevices[device].config.bitRate : 0UL;
+}
+
+bool DRV_SPI_submit(DRV_SPI_Transaction *xfer)
+{
+    bool     intsOff;
+    uint16_t prio;
+    uint16_t nextTail;
+
+    if((xfer == NULL) || (xfer->txBuf == NULL) || (xfer->length == 0U) ||
+       (xfer->device >= s_xferDeviceCount) ||
+       ((uint16_t)xfer->priority >= (uint16_t)DRV_SPI_PRIO_COUNT) ||
+       !s_xfer.initialized)
+    {
+        return false;
+    }
+
+    prio = (uint16_t)xfer->priority;
+
+    intsOff = Interrupt_disableGlobal();
+
+    /* 仍在排队或传输中的描述符不能重复提交。 */
+    if((xfer->status == DRV_SPI_XFER_QUEUED) || (xfer->status == DRV_SPI_XFER_ACTIVE))
+    {
+        if(!intsOff)
+        {
+            (void)Interrupt_enableGlobal();
+        }
+
+        return false;
+    }
+
+    nextTail = (uint16_t)((s_xfer.tail[prio] + 1U) & DRV_SPI_XFER_QUEUE_MASK);
+
+    if(nextTail == s_xfer.head[prio])
+    {
+        if(!intsOff)
+        {
+            (void)Interrupt_enableGlobal();
+        }
+
+        return false;
+    }
+
+    xfer->position = 0U;
+    xfer->status   = DRV_SPI_XFER_QUEUED;
+
+    s_xfer.queue[prio][s_xfer.tail[prio]] = xfer;
+    s_xfer.tail[prio] = nextTail;
+
+    if(s_xfer.active == NULL)
+    {
+        DRV_SPI_startNext();
+    }
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+
+    return true;
+}
+
+bool DRV_SPI_transferBlocking(DRV_SPI_Transaction *xfer, uint32_t timeoutPolls)
+{
+    /**
+     * 等待期间每次轮询短暂屏蔽全局中断。若进入时中断本就被屏蔽，中断服务函数
+     * 无法运行，此时由本函数检查 RXFF 标志并直接调用服务例程推进传输。
+     * 只用于初始化阶段，任务上下文由完成回调唤醒。
+     */
+    uint32_t polls = 0UL;
+    bool     intsOff;
+
+    if(!DRV_SPI_submit(xfer))
+    {
+        return false;
+    }
+
+    while((xfer->status == DRV_SPI_XFER_QUEUED) || (xfer->status == DRV_SPI_XFER_ACTIVE))
+    {
+        intsOff = Interrupt_disableGlobal();
+
+        if(intsOff && ((SPI_getInterruptStatus(s_xfer.base) & SPI_INT_RXFF) != 0UL))
+        {
+            DRV_SPI_service();
+        }
+
+        if(++polls >= timeoutPolls)
+        {
+            DRV_SPI_cancelLocked(xfer);
+        }
+
+        if(!intsOff)
+        {
+            (void)Interrupt_enableGlobal();
+        }
+    }
+
+    return (xfer->status == DRV_SPI_XFER_DONE);
+}
+
+void DRV_SPI_cancel(DRV_SPI_Transaction *xfer)
+{
+    bool intsOff;
+
+    if(xfer == NULL)
+    {
+        return;
+    }
+
+    intsOff = Interrupt_disableGlobal();
+
+    DRV_SPI_cancelLocked(xfer);
+
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+}
+
+bool DRV_SPI_isBusy(void)
+{
+    return (s_xfer.active != NULL);
+}
+
+__interrupt void DRV_SPI_rxISR(void)
+{
+    DRV_SPI_service();
+
+    Interrupt_clearACKGroup(INTERRUPT_ACK_GROUP6);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file app_can.h
+ * @brief CAN 命令与遥测接口。
+ *
+ * 报文 ID 按节点号分配，均为标准帧，多字节字段为小端序：
+ *  - 0x080 + 节点号，故障，4 字节，周期发送且 DRV8316 状态变化时立即发送：
+ *    [STAT00][STAT01][STAT02][命令状态 bit0 已使能 bit1 命令超时]；
+ *  - 0x180 + 节点号，电流，8 字节：ia、ib、id、iq，int16，单位 mA；
+ *  - 0x200 + 节点号，命令（接收），6 字节：[标志 bit0 使能][存活计数]
+ *    [q 轴电流给定 int16 mA][转速给定 int16 rpm]；
+ *  - 0x380 + 节点号，温度，5 字节：[芯片温度 int16 ℃][母线电压 uint16 10 mV]
+ *    [DRV8316 过温 bit0 OT bit1 OTW bit2 OTS]。
+ * ID 越小仲裁优先级越高，故障报文排在最前。
+ *
+ * 命令帧的存活计数每帧须改变，计数不变的帧视为发送端停滞而忽略。使能命令经
+ * APP_CLA_setEnabled 与 APP_CLA_setCurrentRef 生效；由 CAN 使能后超过
+ * APP_CAN_COMMAND_TIMEOUT_MS 未收到有效命令则关闭闭环。CAN 未使能过闭环时不干预
+ * 其他途径（例如标定协议）的设置。当前没有转速环，转速给定只保存供读取。
+ *
+ * 定义 APP_CAN_LOOPBACK=1 时控制器工作在内部回环模式，本节点周期发送不使能的命令帧
+ * 并由自己的接收过滤器收到，用于在无总线时检查收发路径。
+ *
+ * APP_CAN_service 在 APP_TELEM 任务中每个 tick 调用，DRV_CAN 的全部任务侧接口都在
+ * 该任务中使用。
+ */
+
+#ifndef APP_CAN_H
+#define APP_CAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 节点号 1~127。 */
+#ifndef APP_CAN_NODE_ID
+#define APP_CAN_NODE_ID                 (1U)
+#endif
+
+#ifndef APP_CAN_LOOPBACK
+#define APP_CAN_LOOPBACK                (0)
+#endif
+
+/** 报文 ID 基址。 */
+#define APP_CAN_ID_FAULT                (0x080UL)
+#define APP_CAN_ID_CURRENTS             (0x180UL)
+#define APP_CAN_ID_COMMAND              (0x200UL)
+#define APP_CAN_ID_TEMPERATURE          (0x380UL)
+
+/** 发送周期。 */
+#define APP_CAN_FAULT_PERIOD_MS         (100U)
+#define APP_CAN_CURRENTS_PERIOD_MS      (10U)
+#define APP_CAN_TEMPERATURE_PERIOD_MS   (500U)
+
+/** 命令超时。 */
+#ifndef APP_CAN_COMMAND_TIMEOUT_MS
+#define APP_CAN_COMMAND_TIMEOUT_MS      (100U)
+#endif
+
+/** 自适应限流的总线份额上限。 */
+#ifndef APP_CAN_SHARE_PERCENT
+#define APP_CAN_SHARE_PERCENT           (30U)
+#endif
+
+/** 命令帧标志。 */
+#define APP_CAN_COMMAND_ENABLE          (0x01U)
+
+/** 故障报文中的命令状态。 */
+#define APP_CAN_STATE_ENABLED           (0x01U)
+#define APP_CAN_STATE_TIMEOUT           (0x02U)
+
+/**
+ * @brief 最近一次有效命令。
+ */
+typedef struct
+{
+    bool     enabled;               /**< 闭环由 CAN 使能。 */
+    bool     timedOut;              /**< 使能后命令超时。 */
+    float    iqRef;                 /**< q 轴电流给定（A）。 */
+    int16_t  speedRpm;              /**< 转速给定。 */
+    uint32_t commands;              /**< 有效命令帧数。 */
+    uint32_t stale;                 /**< 存活计数未改变而忽略的帧数。 */
+    uint32_t timeouts;              /**< 超时次数。 */
+} APP_CAN_Command;
+
+/**
+ * @brief 登记报文、启动 CANA 并打开自适应限流。
+ *
+ * 需在 EALLOW 下调用。
+ *
+ * @param[in] tickHz APP_CAN_service 的调用频率。
+ *
+ * @retval false 控制器启动失败，APP_CAN_service 不做任何事。
+ */
+bool APP_CAN_init(uint32_t tickHz);
+
+/**
+ * @brief 处理命令、更新遥测并调度发送，每个 tick 调用一次。
+ */
+void APP_CAN_service(void);
+
+/**
+ * @brief 读取最近一次有效命令与统计。
+ */
+void APP_CAN_getCommand(APP_CAN_Command *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CAN_H */
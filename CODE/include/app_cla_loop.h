@@ -0,0 +1,380 @@
+/**
+ * @file app_cla_loop.h
+ * @brief 电流环计算，由 CLA 任务与主机端验证程序共同使用。
+ *
+ * 一次计算包括：ADC 计数换算、Clarke 与 Park 变换、d/q 轴 PI 调节、反 Park 变换以及
+ * 中点注入的 SVPWM，输出三相占空比（0~1）。全部函数为 static inline，只用单精度
+ * 浮点与定宽整数，不调用库函数，可由 CLA 编译器与主机编译器分别编译：
+ *  - d/q 轴 PI 使用 components 中的 PID_run_parallel，微分增益为 0，微分滤波器系数
+ *    清零，PID_run_parallel 与 FILTER_FO_run 均为 static inline，不依赖 Cla1Prog2 中的
+ *    FILTER_FO 函数；
+ *  - 角度以标幺值（一周为 1）表示，正余弦由多项式计算，绝对误差小于 1e-5；
+ *  - 除以母线电压用 CLA 的倒数近似指令加两次牛顿迭代，主机上直接相除。
+ *
+ * 命令与状态结构放在消息 RAM 中，C28x 与 CLA 各自编译，因此只使用定宽类型：CLA 上
+ * int 为 32 bit，指针为 16 bit，与 C28x 不同。
+ */
+
+#ifndef APP_CLA_LOOP_H
+#define APP_CLA_LOOP_H
+
+#include <stdint.h>
+
+#include "pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APP_CLA_LOOP_2PI            (6.283185307f)
+#define APP_CLA_LOOP_HALF_PI        (1.570796327f)
+#define APP_CLA_LOOP_PI             (3.141592654f)
+#define APP_CLA_LOOP_ONE_OVER_SQRT3 (0.577350269f)
+
+/** APP_CLA_Command.angleSource：电角度来源。 */
+#define APP_CLA_ANGLE_COMMAND       (0U)    /**< 使用命令中的 angle。 */
+#define APP_CLA_ANGLE_ENCODER       (1U)    /**< CLA 任务读 eQEP1 计数器换算，覆盖 angle。 */
+
+/**
+ * @brief 电流环命令：CPU 侧为可随时修改的暂存副本，发布到 APP_CLA_CommandBlock 后由
+ *        CLA 在周期开始时锁存。
+ */
+typedef struct
+{
+    uint16_t enable;            /**< 非 0 时闭环并写 CMPA，为 0 时积分清零、只测量。 */
+    uint16_t angleSource;       /**< APP_CLA_ANGLE_*。 */
+    float    idRef;             /**< d 轴电流给定（A）。 */
+    float    iqRef;             /**< q 轴电流给定（A）。 */
+    float    angle;             /**< 电角度标幺值。 */
+    float    encoderOffset;     /**< 编码器零位处的电角度偏移（标幺值）。 */
+    float    kp;                /**< 比例增益（V/A）。 */
+    float    ki;                /**< 每个控制周期的积分增益（V/A）。 */
+    float    vLimitPu;          /**< d/q 轴电压限幅，相对母线电压。 */
+    float    currentScale;      /**< 电流换算系数（A/计数）。 */
+    float    offsetA;           /**< A 相零电流计数。 */
+    float    offsetB;           /**< B 相零电流计数。 */
+    float    vdcScale;          /**< 母线电压换算系数（V/计数）。 */
+    float    vdcMin;            /**< 母线电压下限（V），防止除零。 */
+} APP_CLA_Command;
+
+/**
+ * @brief CPU 写、CLA 读的命令发布块，位于 CpuToCla1MsgRAM。
+ *
+ * CPU 写入期间 sequence 为奇数，写完加到下一个偶数；CLA 只锁存前后两次读到相同偶数
+ * 序号的副本，否则沿用上一次锁存的命令。
+ */
+typedef struct
+{
+    uint32_t        sequence;   /**< 发布序号，每次发布加 2。 */
+    APP_CLA_Command command;    /**< 发布的命令。 */
+} APP_CLA_CommandBlock;
+
+/**
+ * @brief CLA 写、CPU 读的电流环状态，位于 Cla1ToCpuMsgRAM。
+ */
+typedef struct
+{
+    uint32_t count;             /**< 更新序号，CLA 写入期间为奇数，每个周期加 2。 */
+    float    ia;                /**< A 相电流（A）。 */
+    float    ib;                /**< B 相电流（A）。 */
+    float    id;                /**< d 轴电流（A）。 */
+    float    iq;                /**< q 轴电流（A）。 */
+    float    vd;                /**< d 轴电压输出（V）。 */
+    float    vq;                /**< q 轴电压输出（V）。 */
+    float    vdc;               /**< 母线电压（V）。 */
+    float    angle;             /**< 本周期使用的电角度标幺值。 */
+    float    duty[3];           /**< 三相占空比。 */
+} APP_CLA_Status;
+
+/**
+ * @brief 电流环内部状态，位于 CLA 数据 RAM，只由 CLA 访问。
+ *
+ * PID_Obj 含微分滤波器指针，C28x 与 CLA 上布局不同，不能放在消息 RAM 中。
+ */
+typedef struct
+{
+    PID_Obj pidD;               /**< d 轴 PI，积分项即 Ui（V）。 */
+    PID_Obj pidQ;               /**< q 轴 PI，积分项即 Ui（V）。 */
+} APP_CLA_LoopState;
+
+/**
+ * @brief 逐字段复制命令，CLA 上不依赖结构体整体赋值；两侧按 volatile 访问，发布时
+ *        不会被移到序号写入之外。
+ */
+static inline void APP_CLA_LOOP_copyCommand(volatile APP_CLA_Command *dst,
+                                            const volatile APP_CLA_Command *src)
+{
+    dst->enable        = src->enable;
+    dst->angleSource   = src->angleSource;
+    dst->idRef         = src->idRef;
+    dst->iqRef         = src->iqRef;
+    dst->angle         = src->angle;
+    dst->encoderOffset = src->encoderOffset;
+    dst->kp            = src->kp;
+    dst->ki            = src->ki;
+    dst->vLimitPu      = src->vLimitPu;
+    dst->currentScale  = src->currentScale;
+    dst->offsetA       = src->offsetA;
+    dst->offsetB       = src->offsetB;
+    dst->vdcScale      = src->vdcScale;
+    dst->vdcMin        = src->vdcMin;
+}
+
+/**
+ * @brief 逐字段发布一个周期的计算结果，不含 count；目标按 volatile 访问，在 count
+ *        的两次写入之间完成，不会被编译器移出奇数窗口。
+ */
+static inline void APP_CLA_LOOP_copyStatus(volatile APP_CLA_Status *dst, const APP_CLA_Status *src)
+{
+    dst->ia      = src->ia;
+    dst->ib      = src->ib;
+    dst->id      = src->id;
+    dst->iq      = src->iq;
+    dst->vd      = src->vd;
+    dst->vq      = src->vq;
+    dst->vdc     = src->vdc;
+    dst->angle   = src->angle;
+    dst->duty[0] = src->duty[0];
+    dst->duty[1] = src->duty[1];
+    dst->duty[2] = src->duty[2];
+}
+
+/**
+ * @brief 锁存一份完整发布的命令，在 CLA 任务开始时调用，本周期只使用锁存的副本。
+ *
+ * @param[in]     block    发布块。
+ * @param[in,out] active   锁存的命令，发布不完整或未更新时保持不变。
+ * @param[in,out] sequence 已锁存的发布序号。
+ *
+ * @return 本次是否锁存了新的命令。
+ */
+static inline uint16_t APP_CLA_LOOP_latchCommand(const volatile APP_CLA_CommandBlock *block,
+                                                 APP_CLA_Command *active, uint32_t *sequence)
+{
+    uint32_t seq = block->sequence;
+    APP_CLA_Command copy;
+
+    if(((seq & 1U) != 0U) || (seq == *sequence))
+    {
+        return 0U;
+    }
+
+    APP_CLA_LOOP_copyCommand(&copy, &block->command);
+
+    /* 复制期间 CPU 开始了新的发布，副本可能不完整。 */
+    if(block->sequence != seq)
+    {
+        return 0U;
+    }
+
+    APP_CLA_LOOP_copyCommand(active, &copy);
+    *sequence = seq;
+
+    return 1U;
+}
+
+/**
+ * @brief 求倒数。
+ */
+static inline float APP_CLA_LOOP_inv(float x)
+{
+#ifdef __TMS320C28XX_CLA__
+    float y = __meinvf32(x);
+
+    /* 牛顿迭代：y = y * (2 - x * y)。 */
+    y = y * (2.0f - (x * y));
+    y = y * (2.0f - (x * y));
+
+    return y;
+#else
+    return 1.0f / x;
+#endif
+}
+
+static inline float APP_CLA_LOOP_clampDuty(float duty)
+{
+    if(duty > 1.0f)
+    {
+        return 1.0f;
+    }
+
+    if(duty < 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return duty;
+}
+
+/**
+ * @brief 求标幺角度的正弦。
+ *
+ * 先把角度折算到 [-0.5, 0.5)，再利用对称性折算到 [-π/2, π/2]，用 9 阶奇次多项式
+ * 计算。
+ */
+static inline float APP_CLA_LOOP_sinPu(float anglePu)
+{
+    float x = anglePu - (float)(int32_t)anglePu;
+    float theta;
+    float theta2;
+
+    if(x < 0.0f)
+    {
+        x += 1.0f;
+    }
+
+    if(x >= 0.5f)
+    {
+        x -= 1.0f;
+    }
+
+    theta = x * APP_CLA_LOOP_2PI;
+
+    if(theta > APP_CLA_LOOP_HALF_PI)
+    {
+        theta = APP_CLA_LOOP_PI - theta;
+    }
+    else if(theta < -APP_CLA_LOOP_HALF_PI)
+    {
+        theta = -APP_CLA_LOOP_PI - theta;
+    }
+
+    theta2 = theta * theta;
+
+    return theta * (1.0f + theta2 * (-1.666666667e-1f + theta2 * (8.333333333e-3f +
+           theta2 * (-1.984126984e-4f + theta2 * 2.755731922e-6f))));
+}
+
+/**
+ * @brief 初始化一个轴的 PI：增益与积分清零，微分滤波器输出恒为 0。
+ */
+static inline void APP_CLA_LOOP_resetPid(PID_Obj *pid)
+{
+    pid->derFilterHandle = &pid->derFilter;
+    pid->derFilter.a1 = 0.0f;
+    pid->derFilter.b0 = 0.0f;
+    pid->derFilter.b1 = 0.0f;
+    pid->derFilter.x1 = 0.0f;
+    pid->derFilter.y1 = 0.0f;
+
+    PID_setGains(pid, 0.0f, 0.0f, 0.0f);
+    PID_setMinMax(pid, 0.0f, 0.0f);
+    PID_setUi(pid, 0.0f);
+    PID_setRefValue(pid, 0.0f);
+    PID_setFbackValue(pid, 0.0f);
+    PID_setFfwdValue(pid, 0.0f);
+}
+
+/**
+ * @brief 初始化电流环状态，须在第一次 APP_CLA_LOOP_run 之前调用。
+ */
+static inline void APP_CLA_LOOP_reset(APP_CLA_LoopState *state)
+{
+    APP_CLA_LOOP_resetPid(&state->pidD);
+    APP_CLA_LOOP_resetPid(&state->pidQ);
+}
+
+/**
+ * @brief 一个控制周期的电流环计算。
+ *
+ * @param[in]     cmd    命令。
+ * @param[in,out] state  PI 状态，命令未使能时积分清零。
+ * @param[in]     adcA   A 相电流计数。
+ * @param[in]     adcB   B 相电流计数。
+ * @param[in]     adcVdc 母线电压计数。
+ * @param[out]    status 测量值、电压与占空比。
+ */
+static inline void APP_CLA_LOOP_run(const APP_CLA_Command *cmd, APP_CLA_LoopState *state,
+                                    uint16_t adcA, uint16_t adcB, uint16_t adcVdc,
+                                    APP_CLA_Status *status)
+{
+    float ia = ((float)adcA - cmd->offsetA) * cmd->currentScale;
+    float ib = ((float)adcB - cmd->offsetB) * cmd->currentScale;
+    float vdc = (float)adcVdc * cmd->vdcScale;
+    float sinTheta = APP_CLA_LOOP_sinPu(cmd->angle);
+    float cosTheta = APP_CLA_LOOP_sinPu(cmd->angle + 0.25f);
+    float alpha;
+    float beta;
+    float id;
+    float iq;
+    float vd = 0.0f;
+    float vq = 0.0f;
+    float vAlpha;
+    float vBeta;
+    float va;
+    float vb;
+    float vc;
+    float vMax;
+    float vMin;
+    float vCom;
+    float invVdc;
+
+    if(vdc < cmd->vdcMin)
+    {
+        vdc = cmd->vdcMin;
+    }
+
+    /* Clarke：两相电流，ic = -(ia + ib)。 */
+    alpha = ia;
+    beta  = (ia + (2.0f * ib)) * APP_CLA_LOOP_ONE_OVER_SQRT3;
+
+    /* Park。 */
+    id = (alpha * cosTheta) + (beta * sinTheta);
+    iq = (beta * cosTheta) - (alpha * sinTheta);
+
+    if(cmd->enable != 0U)
+    {
+        float limit = cmd->vLimitPu * vdc;
+
+        /* 增益与限幅每周期取自命令，限幅同时约束积分项与输出。 */
+        PID_setGains(&state->pidD, cmd->kp, cmd->ki, 0.0f);
+        PID_setGains(&state->pidQ, cmd->kp, cmd->ki, 0.0f);
+        PID_setMinMax(&state->pidD, -limit, limit);
+        PID_setMinMax(&state->pidQ, -limit, limit);
+
+        PID_run_parallel(&state->pidD, cmd->idRef, id, 0.0f, &vd);
+        PID_run_parallel(&state->pidQ, cmd->iqRef, iq, 0.0f, &vq);
+    }
+    else
+    {
+        PID_setUi(&state->pidD, 0.0f);
+        PID_setUi(&state->pidQ, 0.0f);
+    }
+
+    /* 反 Park 与反 Clarke。 */
+    vAlpha = (vd * cosTheta) - (vq * sinTheta);
+    vBeta  = (vd * sinTheta) + (vq * cosTheta);
+
+    va = vAlpha;
+    vb = (-0.5f * vAlpha) + (0.866025404f * vBeta);
+    vc = (-0.5f * vAlpha) - (0.866025404f * vBeta);
+
+    /* 中点注入：减去最大、最小相电压的平均值，线性区扩大到 vdc/√3。 */
+    vMax = (va > vb) ? va : vb;
+    vMax = (vMax > vc) ? vMax : vc;
+    vMin = (va < vb) ? va : vb;
+    vMin = (vMin < vc) ? vMin : vc;
+    vCom = 0.5f * (vMax + vMin);
+
+    invVdc = APP_CLA_LOOP_inv(vdc);
+
+    /* vLimitPu 不超过 1/√6 时不会过调制，钳位只用于保护。 */
+    status->duty[0] = APP_CLA_LOOP_clampDuty(0.5f + ((va - vCom) * invVdc));
+    status->duty[1] = APP_CLA_LOOP_clampDuty(0.5f + ((vb - vCom) * invVdc));
+    status->duty[2] = APP_CLA_LOOP_clampDuty(0.5f + ((vc - vCom) * invVdc));
+
+    status->ia  = ia;
+    status->ib  = ib;
+    status->id  = id;
+    status->iq  = iq;
+    status->vd  = vd;
+    status->vq  = vq;
+    status->vdc = vdc;
+    status->angle = cmd->angle;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_CLA_LOOP_H */
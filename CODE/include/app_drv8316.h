@@ -5,6 +5,9 @@
  * 该模块对底层 DRV8316 驱动库与 SPI 适配层进行封装，提供线程安全的寄存器配置、
  * 状态轮询与手动读取接口。通过 SysConfig 生成的 APP_DRV8316_TASK 任务可直接调
  * 用本接口，完成对驱动芯片的周期性维护。
+ *
+ * 模块支持 APP_DRV8316_MAX_DEVICES 个共享同一 SPI 总线的器件，各接口以器件编号
+ * 区分实例。各器件的片选由 SPI 总线事务管理器在每一帧切换。
  */
 
 #ifndef APP_DRV8316_H
@@ -21,11 +24,70 @@
 extern "C" {
 #endif
 
+/**
+ * @brief 支持的 DRV8316 器件数量，可在编译选项中覆盖。
+ */
+#ifndef APP_DRV8316_MAX_DEVICES
+#define APP_DRV8316_MAX_DEVICES            (1U)
+#endif
+
+/**
+ * @brief 器件编号。
+ */
+#define APP_DRV8316_DEVICE_0               (0U)
+#define APP_DRV8316_DEVICE_1               (1U)
+
 /**
  * @brief 默认的周期性刷新时间（毫秒）。
  */
 #define APP_DRV8316_DEFAULT_REFRESH_MS     (10U)
 
+/**
+ * @brief 寄存器访问队列深度，足以在一个刷新周期内访问全部 32 个地址。
+ *
+ * 必须为 2 的整数次幂。
+ */
+#define APP_DRV8316_REG_QUEUE_DEPTH        (32U)
+
+/**
+ * @brief 无效的寄存器访问令牌。
+ */
+#define APP_DRV8316_REG_TOKEN_NONE         (0U)
+
+/**
+ * @brief 寄存器访问操作类型。
+ */
+typedef enum
+{
+    APP_DRV8316_REG_OP_READ  = 0,   /**< 读取寄存器。 */
+    APP_DRV8316_REG_OP_WRITE = 1    /**< 写入寄存器。 */
+} APP_DRV8316_RegOpType;
+
+/**
+ * @brief 寄存器访问请求完成状态。
+ */
+typedef enum
+{
+    APP_DRV8316_REG_STATUS_INVALID = 0, /**< 令牌无效或结果已被后续请求覆盖。 */
+    APP_DRV8316_REG_STATUS_PENDING = 1, /**< 请求已入队，尚未执行。 */
+    APP_DRV8316_REG_STATUS_DONE    = 2  /**< 请求已执行完成。 */
+} APP_DRV8316_RegStatus;
+
+/**
+ * @brief 单条寄存器访问请求。
+ */
+typedef struct
+{
+    APP_DRV8316_RegOpType type;    /**< 操作类型。 */
+    uint16_t              address; /**< 寄存器地址，取值范围 0~31。 */
+    uint16_t              data;    /**< 写操作的数据，读操作忽略。 */
+} APP_DRV8316_RegOp;
+
+/**
+ * @brief 寄存器访问请求的完成令牌。
+ */
+typedef uint16_t APP_DRV8316_RegToken;
+
 /**
  * @brief DRV8316 应用层初始化配置。
  */
@@ -35,73 +97,136 @@ typedef struct
     uint32_t  enableGpio;          /**< DRV8316 使能 GPIO，使用 @ref DRV_SPI_INVALID_GPIO 表示无效。 */
     TickType_t refreshPeriodTicks; /**< 任务刷新周期（FreeRTOS 时钟节拍数）。 */
     bool      autoEnable;          /**< 初始化后是否自动拉低 EN 引脚使能驱动。 */
+    bool      linkSelfTest;        /**< 初始化时运行 SPI 链路自检，并以最高可靠速率运行。 */
 } APP_DRV8316_Config;
 
 /**
- * @brief 初始化 DRV8316 应用层模块。
+ * @brief 初始化指定的 DRV8316 器件。
  *
- * 若 @p config 为空，将沿用模块默认设置：使用 SPI 默认片选、禁用自动使能并以
- * APP_DRV8316_DEFAULT_REFRESH_MS 作为刷新周期。该函数内部会创建互斥量并初始化
- * 底层驱动句柄，因此务必在任务调度或其他 API 调用之前执行。
+ * 若 @p config 为空，将沿用模块默认设置：使用 SPI 默认片选、禁用自动使能、运行链路
+ * 自检并以 APP_DRV8316_DEFAULT_REFRESH_MS 作为刷新周期；默认配置仅适用于 0 号器件，其余
+ * 器件必须提供各自的片选。首次调用时会创建互斥量与请求队列，因此务必在任务调度
+ * 或其他 API 调用之前执行。
+ *
+ * @param[in] device 器件编号，取值范围 0~APP_DRV8316_MAX_DEVICES-1。
+ * @param[in] config 器件配置，可为 NULL。
  */
-void APP_DRV8316_init(const APP_DRV8316_Config *config);
+void APP_DRV8316_init(uint16_t device, const APP_DRV8316_Config *config);
 
 /**
- * @brief 查询模块是否已经完成初始化。
+ * @brief 查询指定器件是否已经完成初始化。
  *
- * @retval true  模块已经可用，可安全调用其余接口。
- * @retval false 模块尚未准备好，需要等待 APP_DRV8316_init 完成。
+ * @retval true  器件已经可用，可安全调用其余接口。
+ * @retval false 器件尚未准备好或编号越界，需要等待 APP_DRV8316_init 完成。
  */
-bool APP_DRV8316_isReady(void);
+bool APP_DRV8316_isReady(uint16_t device);
 
 /**
  * @brief 获取最新的 DRV8316 寄存器快照。
  *
+ * 快照由维护任务在每次扫描结束后发布，读取过程不获取互斥量，可在中断中调用。
+ *
+ * @param[in]  device  器件编号。
  * @param[out] outVars 结果缓冲区，必须为有效指针。
- * @retval true  已将底层缓存拷贝至 @p outVars；
- * @retval false 模块未初始化或参数非法。
+ * @retval true  已将最近发布的快照拷贝至 @p outVars；
+ * @retval false 器件未初始化、参数非法，或读取期间快照被连续改写。
+ */
+bool APP_DRV8316_getStatusSnapshot(uint16_t device, DRV8316_VARS_t *outVars);
+
+/**
+ * @brief 获取最近一次发布快照的序号。
+ *
+ * 每次扫描完成后序号加一，上层可据此判断快照是否已更新。
  */
-bool APP_DRV8316_getStatusSnapshot(DRV8316_VARS_t *outVars);
+uint32_t APP_DRV8316_getSnapshotSequence(uint16_t device);
+
+/**
+ * @brief 查询维护任务是否已完成第一次扫描。
+ *
+ * APP_DRV8316_init 以初始化时的读回值发布第一份快照，序号因此不为 0；需要以维护任务
+ * 扫描得到的器件值为基准时，应等待本函数返回 true。
+ *
+ * @retval false 器件未初始化或尚未扫描。
+ */
+bool APP_DRV8316_hasScanned(uint16_t device);
 
 /**
  * @brief 根据传入配置更新控制寄存器，并在后台写入。
  *
+ * 仅与器件预期值（已交给写入的值或最近一次读回值）不同的寄存器会被标记为待写入，
+ * 维护任务只写入这些寄存器；同一扫描周期内的连续请求以最后一次为准。
+ *
+ * @param[in] device   器件编号。
  * @param[in] ctrlRegs 待写入的控制寄存器集合，指针需有效。
- * @retval true  请求已缓存，任务将在下一刷新周期完成写入；
- * @retval false 参数无效或模块尚未初始化。
+ * @retval true  请求已缓存并已唤醒维护任务，由其尽快完成写入；
+ * @retval false 参数无效或器件尚未初始化。
+ */
+bool APP_DRV8316_scheduleControlUpdate(uint16_t device, const DRV8316_VARS_t *ctrlRegs);
+
+/**
+ * @brief 批量提交寄存器读写请求。
+ *
+ * 请求进入静态分配的队列并唤醒维护任务，由其以一次 SPI 突发按提交顺序执行
+ * 整批请求。整批请求要么全部入队，要么全部拒绝。
+ *
+ * @param[in]  device 目标器件编号。
+ * @param[in]  ops    请求数组，指针需有效。
+ * @param[in]  count  请求数量，取值范围 1~APP_DRV8316_REG_QUEUE_DEPTH。
+ * @param[out] tokens 返回每条请求的完成令牌，可为 NULL。
+ * @retval true  整批请求已入队；
+ * @retval false 参数非法、模块未初始化或队列剩余空间不足。
  */
-bool APP_DRV8316_scheduleControlUpdate(const DRV8316_VARS_t *ctrlRegs);
+bool APP_DRV8316_submitRegOps(uint16_t device,
+                              const APP_DRV8316_RegOp *ops,
+                              uint16_t count,
+                              APP_DRV8316_RegToken *tokens);
+
+/**
+ * @brief 查询寄存器读写请求的完成状态。
+ *
+ * 结果在此后至少 APP_DRV8316_REG_QUEUE_DEPTH 条请求提交之前保持可查询。令牌在
+ * 全部器件间唯一，因此查询时无需指定器件。
+ *
+ * @param[in]  token 由 APP_DRV8316_submitRegOps 返回的令牌。
+ * @param[out] data  完成时返回寄存器值，可为 NULL。
+ * @return 请求当前状态。
+ */
+APP_DRV8316_RegStatus APP_DRV8316_getRegOpResult(APP_DRV8316_RegToken token, uint16_t *data);
 
 /**
  * @brief 请求手动读取指定寄存器。
  *
+ * 该接口基于寄存器访问队列实现，每个器件同一时刻仅允许一个未完成的手动读取。
+ *
+ * @param[in] device  器件编号。
  * @param[in] address DRV8316 寄存器地址，取值范围 0~31。
  * @retval true  请求已接受，读取结果可通过 APP_DRV8316_getManualReadResult 获取；
  * @retval false 当前忙碌或参数错误。
  */
-bool APP_DRV8316_requestManualRead(uint16_t address);
+bool APP_DRV8316_requestManualRead(uint16_t device, uint16_t address);
 
 /**
  * @brief 获取最近一次手动读取的结果。
  *
- * @param[out] data 指向接收数据的缓冲区。
+ * @param[in]  device 器件编号。
+ * @param[out] data   指向接收数据的缓冲区。
  * @retval true  已成功返回最新手动读取数据；
- * @retval false 尚未完成手动读取或模块未初始化。
+ * @retval false 尚未完成手动读取或器件未初始化。
  */
-bool APP_DRV8316_getManualReadResult(uint16_t *data);
+bool APP_DRV8316_getManualReadResult(uint16_t device, uint16_t *data);
 
 /**
  * @brief 获取底层 DRV8316 句柄。
  *
  * 该接口主要用于诊断或特殊场景下直接访问底层驱动 API，常规业务无需调用。
  */
-DRV8316_Handle APP_DRV8316_getHandle(void);
+DRV8316_Handle APP_DRV8316_getHandle(uint16_t device);
 
 /**
  * @brief DRV8316 周期性处理任务。
  *
  * 建议在 SysConfig 生成的 APP_DRV8316_TASK 任务入口中直接调用，用于在后台维护
- * 寄存器镜像、处理手动读写请求以及更新驱动状态。
+ * 全部器件的寄存器镜像、处理手动读写请求以及更新驱动状态。
  */
 void APP_DRV8316_TASK(void *pvParameters);
 
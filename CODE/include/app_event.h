@@ -0,0 +1,115 @@
+/**
+ * @file app_event.h
+ * @brief 中断到任务的延迟处理框架接口。
+ *
+ * 每个事件源拥有一个静态分配的单生产者/单消费者环形队列，并绑定一个处理任务。
+ * 中断只负责把事件放入队列并以 vTaskNotifyGiveFromISR 唤醒处理任务，耗时的工作
+ * 在任务中完成；任务以 APP_EVENT_wait 阻塞，事件到达即刻唤醒，无需周期轮询。
+ *
+ * 队列索引为 16 bit，单次读写即为原子操作：生产者只写 head，消费者只写 tail，
+ * 中断投递无需加锁。任务上下文投递可能有多个生产者，由 APP_EVENT_post 在临界区内
+ * 串行化。
+ */
+
+#ifndef APP_EVENT_H
+#define APP_EVENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 每个事件源的队列深度，必须为 2 的幂。 */
+#ifndef APP_EVENT_QUEUE_DEPTH
+#define APP_EVENT_QUEUE_DEPTH       (8U)
+#endif
+
+#define APP_EVENT_QUEUE_MASK        (APP_EVENT_QUEUE_DEPTH - 1U)
+
+/**
+ * @brief 事件源编号，每个事件源只能绑定一个处理任务。
+ */
+typedef enum
+{
+    APP_EVENT_SRC_TIMER1 = 0,   /**< timer1_ISR 周期事件，由 myTask0 处理。 */
+    APP_EVENT_SRC_DRV8316,      /**< DRV8316 寄存器请求，由 APP_DRV8316 任务处理。 */
+    APP_EVENT_SRC_CTRL,         /**< 控制执行器后台时隙，由 APP_CTRL 任务处理。 */
+    APP_EVENT_SRC_PARAM,        /**< 参数保存请求，由 myTask0 处理。 */
+    APP_EVENT_SRC_COUNT
+} APP_EVENT_Source;
+
+/**
+ * @brief 单个事件，4 个 16 bit 字。
+ */
+typedef struct
+{
+    uint16_t code;          /**< 事件码，由各事件源自行定义。 */
+    uint16_t arg;           /**< 事件参数。 */
+    uint32_t timestamp;     /**< 投递时刻（APP_STATS_now），用于计算处理延迟。 */
+} APP_EVENT_Event;
+
+/**
+ * @brief 清空全部队列并解除绑定，需在 FreeRTOS_init 之前调用。
+ */
+void APP_EVENT_init(void);
+
+/**
+ * @brief 将当前任务绑定为事件源的处理任务。
+ *
+ * 绑定前投递的事件保留在队列中，绑定时若队列非空则立即给自身一次通知。
+ *
+ * @retval false 事件源编号越界。
+ */
+bool APP_EVENT_bind(uint16_t source);
+
+/**
+ * @brief 在中断中投递事件并通知处理任务。
+ *
+ * 每个事件源只允许一个中断作为生产者。队列满时丢弃事件并计数，但仍会通知处理
+ * 任务，使其尽快取走积压的事件。
+ *
+ * @param[out] woken 需要切换任务时置为 pdTRUE，调用者在中断末尾以
+ *                   portYIELD_FROM_ISR 处理。
+ *
+ * @retval false 事件源编号越界或队列已满。
+ */
+bool APP_EVENT_postFromISR(uint16_t source, uint16_t code, uint16_t arg, BaseType_t *woken);
+
+/**
+ * @brief 在任务中投递事件并通知处理任务。
+ *
+ * @retval false 事件源编号越界或队列已满。
+ */
+bool APP_EVENT_post(uint16_t source, uint16_t code, uint16_t arg);
+
+/**
+ * @brief 阻塞等待发给当前任务的事件通知。
+ *
+ * @param[in] timeout 最长等待的时钟节拍数。
+ *
+ * @return 期间累计的通知次数，超时返回 0。
+ */
+uint32_t APP_EVENT_wait(TickType_t timeout);
+
+/**
+ * @brief 从事件源队列取出最早的一个事件，只能由绑定的处理任务调用。
+ *
+ * @retval false 队列为空或参数非法。
+ */
+bool APP_EVENT_receive(uint16_t source, APP_EVENT_Event *event);
+
+/**
+ * @brief 读取并清零事件源因队列满而丢弃的事件数。
+ */
+uint16_t APP_EVENT_takeDropped(uint16_t source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_EVENT_H */
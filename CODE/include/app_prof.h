@@ -0,0 +1,133 @@
+/**
+ * @file app_prof.h
+ * @brief 基于 ERAD 的代码区域周期测量接口。
+ *
+ * 每个区域占用 2 个总线比较器与 1 个计数器，最多 APP_PROF_MAX_REGIONS 个：
+ *  - 比较器在虚拟程序计数器（VPC）上分别匹配区域起始与结束地址；
+ *  - 计数器工作在启停模式，起始地址执行时从 0 开始计 CPU 周期，结束地址执行时
+ *    停止，同时由硬件更新最大值寄存器。
+ *
+ * 被测代码中没有任何插桩指令。APP_PROF_sample 在屏蔽中断的几条指令内读取计数器，
+ * 两次读数相同（计数已停止）且非 0 时记为一个样本并清零计数器：
+ *  - 最大值直接取硬件最大值寄存器，不漏掉任何一次执行；
+ *  - 最小值、平均值与样本数基于采样，两次采样之间的多次执行只计最后一次。
+ *
+ * 区域执行期间发生的中断或任务切换计入区域周期。结束地址应为区域内最后执行的
+ * 指令，函数区域即返回指令（LRETR/IRET）的地址，可从反汇编或 .lst 文件读取；
+ * 有多个出口的函数只覆盖经过该地址的路径。
+ *
+ * 计数硬件经 APP_PROF_PORT_* 接口访问：目标板由 app_prof_erad.c 实现，主机端由
+ * tools/host/prof_host 中基于 CPUTIMER 替身的实现提供，两者共用 app_prof.c。
+ * 模块不依赖调试构建，发布固件中同样可用；调试器占用 ERAD 时 APP_PROF_init 失败，
+ * 其余接口成为空操作。
+ */
+
+#ifndef APP_PROF_H
+#define APP_PROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** ERAD 共 8 个总线比较器与 4 个计数器。 */
+#define APP_PROF_MAX_REGIONS        (4U)
+
+/** 取函数入口地址。 */
+#define APP_PROF_ADDR(fxn)          ((uint32_t)(uintptr_t)&(fxn))
+
+/**
+ * @brief 区域统计快照，时间单位为 SYSCLK 周期。
+ */
+typedef struct
+{
+    const char *name;           /**< 区域名称。 */
+    uint32_t    startAddr;      /**< 起始地址。 */
+    uint32_t    endAddr;        /**< 结束地址。 */
+    uint32_t    samples;        /**< 样本数。 */
+    uint32_t    lastCycles;     /**< 最近一个样本。 */
+    uint32_t    minCycles;      /**< 样本最小值，无样本时为 0。 */
+    uint32_t    maxCycles;      /**< 硬件捕获的最大值。 */
+    uint32_t    avgCycles;      /**< 样本平均值。 */
+} APP_PROF_Snapshot;
+
+/**
+ * @brief 取得计数硬件并清空全部区域。
+ *
+ * @retval false 计数硬件被调试器占用。
+ */
+bool APP_PROF_init(void);
+
+/**
+ * @brief 为代码区域分配比较器与计数器并立即开始测量。
+ *
+ * @param[in]  name      区域名称，须为静态字符串。
+ * @param[in]  startAddr 区域第一条指令地址。
+ * @param[in]  endAddr   区域最后一条指令地址。
+ * @param[out] id        区域编号，可为 NULL。
+ *
+ * @retval false 未初始化、参数非法或计数器已分配完。
+ */
+bool APP_PROF_addRegion(const char *name, uint32_t startAddr, uint32_t endAddr, uint16_t *id);
+
+/**
+ * @brief 以函数入口与长度定义区域，结束地址为最后一个字。
+ *
+ * @param[in] sizeWords 函数长度（16 bit 字），最后一个字须为返回指令。
+ */
+bool APP_PROF_addFunction(const char *name, uint32_t entryAddr, uint32_t sizeWords, uint16_t *id);
+
+/**
+ * @brief 采集各区域最近一次完成的执行周期，需周期调用，不能在中断中调用。
+ */
+void APP_PROF_sample(void);
+
+/**
+ * @brief 读取区域统计快照。
+ *
+ * @retval false 区域编号无效。
+ */
+bool APP_PROF_getSnapshot(uint16_t id, APP_PROF_Snapshot *snapshot);
+
+/**
+ * @brief 返回已分配的区域数。
+ */
+uint16_t APP_PROF_getRegionCount(void);
+
+/**
+ * @brief 清零全部区域统计与硬件最大值，区域分配保持不变。
+ */
+void APP_PROF_reset(void);
+
+/*
+ * 计数硬件接口，index 为计数器编号，取值 0~APP_PROF_MAX_REGIONS-1。
+ */
+
+/** 取得计数硬件，被占用时返回 false。 */
+bool APP_PROF_PORT_init(void);
+
+/** 配置并启动一个区域的起止比较与启停计数。 */
+void APP_PROF_PORT_attach(uint16_t index, uint32_t startAddr, uint32_t endAddr);
+
+/** 原子地读取已停止的计数并清零，计数进行中或为 0 时返回 0。 */
+uint32_t APP_PROF_PORT_takeCount(uint16_t index);
+
+/** 读取硬件最大值。 */
+uint32_t APP_PROF_PORT_getMax(uint16_t index);
+
+/** 清零硬件最大值。 */
+void APP_PROF_PORT_clearMax(uint16_t index);
+
+/** 屏蔽中断，返回原中断状态。 */
+uint16_t APP_PROF_PORT_lock(void);
+
+/** 恢复 APP_PROF_PORT_lock 返回的中断状态。 */
+void APP_PROF_PORT_unlock(uint16_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_PROF_H */
@@ -0,0 +1,200 @@
+/**
+ * @file app_scope.h
+ * @brief 带触发与预触发历史的实时数据记录器接口。
+ *
+ * 记录器按地址登记最多 APP_SCOPE_MAX_CHANNELS 个信号（float32、int16 或 uint16），
+ * 在控制中断中每次或每 k 次调用 APP_SCOPE_sample 记录一次，统一换算为 float32 写入
+ * RAMGS1（段 ramgs1）中的环形缓冲区。缓冲区容量按通道数平分为采样深度。
+ *
+ * 一次采集的过程：
+ *  - APP_SCOPE_arm 后先记录预触发部分（深度 × 预触发百分比），期间不判断触发条件；
+ *  - 随后等待触发：电平、边沿、故障位或 APP_SCOPE_trigger 软件触发；
+ *  - 触发后再记录剩余深度，然后冻结缓冲区，直到再次 arm。
+ * 冻结后触发点之前的历史与之后的数据按时间顺序由 APP_SCOPE_readSample 读出，也可
+ * 用调试器导出 APP_SCOPE_buffer 整个结构体。
+ *
+ * APP_SCOPE_sample 对每个通道只做一次读取与换算，触发判断为常数次比较，不含取模与
+ * 循环等待，每次记录的周期数只与通道数有关。
+ */
+
+#ifndef APP_SCOPE_H
+#define APP_SCOPE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 通道数量上限。 */
+#ifndef APP_SCOPE_MAX_CHANNELS
+#define APP_SCOPE_MAX_CHANNELS      (8U)
+#endif
+
+/** 缓冲区容量（float32 个数），占 RAMGS1 的一半。 */
+#ifndef APP_SCOPE_CAPACITY
+#define APP_SCOPE_CAPACITY          (2048U)
+#endif
+
+/** 缓冲区头部标识（"SC"）与格式版本，供主机端校验内存导出。 */
+#define APP_SCOPE_MAGIC             (0x4353U)
+#define APP_SCOPE_VERSION           (1U)
+
+/**
+ * @brief 信号类型。
+ */
+typedef enum
+{
+    APP_SCOPE_TYPE_FLOAT32 = 0,
+    APP_SCOPE_TYPE_INT16,
+    APP_SCOPE_TYPE_UINT16
+} APP_SCOPE_Type;
+
+/**
+ * @brief 触发方式，触发通道的值与 level 或 mask 比较。
+ */
+typedef enum
+{
+    APP_SCOPE_TRIG_MANUAL = 0,      /**< 只响应 APP_SCOPE_trigger，可作滚动记录。 */
+    APP_SCOPE_TRIG_ABOVE,           /**< 值不小于 level。 */
+    APP_SCOPE_TRIG_BELOW,           /**< 值不大于 level。 */
+    APP_SCOPE_TRIG_RISING,          /**< 值由小于 level 变为不小于 level。 */
+    APP_SCOPE_TRIG_FALLING,         /**< 值由大于 level 变为不大于 level。 */
+    APP_SCOPE_TRIG_FAULT,           /**< 16 bit 值与 mask 的按位与非 0。 */
+    APP_SCOPE_TRIG_COUNT
+} APP_SCOPE_TrigMode;
+
+/**
+ * @brief 记录器状态。
+ */
+typedef enum
+{
+    APP_SCOPE_STATE_IDLE = 0,       /**< 未启动。 */
+    APP_SCOPE_STATE_PRETRIGGER,     /**< 记录预触发历史。 */
+    APP_SCOPE_STATE_ARMED,          /**< 等待触发，继续滚动记录。 */
+    APP_SCOPE_STATE_TRIGGERED,      /**< 已触发，记录触发后数据。 */
+    APP_SCOPE_STATE_DONE            /**< 已冻结，可读取。 */
+} APP_SCOPE_State;
+
+/**
+ * @brief 一次采集的配置。
+ */
+typedef struct
+{
+    uint16_t mode;                  /**< ::APP_SCOPE_TrigMode。 */
+    uint16_t channel;               /**< 触发通道。 */
+    float    level;                 /**< 电平与边沿触发的门限。 */
+    uint16_t mask;                  /**< 故障触发的位掩码。 */
+    uint16_t preTriggerPercent;     /**< 预触发部分占深度的百分比，0~100。 */
+    uint16_t divider;               /**< 每 divider 次调用记录一次，至少为 1。 */
+} APP_SCOPE_Config;
+
+/**
+ * @brief 冻结后的采集信息。
+ */
+typedef struct
+{
+    uint16_t channels;              /**< 通道数。 */
+    uint16_t samples;               /**< 有效采样数。 */
+    uint16_t triggerIndex;          /**< 触发点在时间顺序中的位置。 */
+    uint16_t divider;               /**< 记录分频。 */
+} APP_SCOPE_Capture;
+
+/**
+ * @brief 记录器缓冲区，头部 12 个字，随后为按采样交错存放的数据。
+ *
+ * 冻结后第 i 个（时间顺序）采样的第 c 个通道位于
+ * data[((start + i) % depth) * channels + c]。
+ */
+typedef struct
+{
+    uint16_t          magic;        /**< ::APP_SCOPE_MAGIC。 */
+    uint16_t          version;      /**< ::APP_SCOPE_VERSION。 */
+    uint16_t          channels;     /**< 通道数。 */
+    uint16_t          depth;        /**< 采样深度。 */
+    volatile uint16_t state;        /**< ::APP_SCOPE_State。 */
+    uint16_t          divider;      /**< 记录分频。 */
+    uint16_t          start;        /**< 冻结后最早采样的槽位。 */
+    uint16_t          samples;      /**< 冻结后有效采样数。 */
+    uint16_t          triggerIndex; /**< 冻结后触发点在时间顺序中的位置。 */
+    uint16_t          reserved[3];
+    float             data[APP_SCOPE_CAPACITY];
+} APP_SCOPE_Buffer;
+
+extern APP_SCOPE_Buffer APP_SCOPE_buffer;
+
+/**
+ * @brief 初始化缓冲区头部并清除全部通道，需在控制中断启动之前调用。
+ */
+void APP_SCOPE_init(void);
+
+/**
+ * @brief 登记一个信号，只能在未启动或已冻结时调用。
+ *
+ * @param[in]  address 信号地址，须在整个记录期间有效。
+ * @param[in]  type    ::APP_SCOPE_Type。
+ * @param[out] channel 分配到的通道号。
+ *
+ * @retval false 参数非法、通道已满或记录器正在运行。
+ */
+bool APP_SCOPE_addChannel(const volatile void *address, uint16_t type, uint16_t *channel);
+
+/**
+ * @brief 清除全部通道，只能在未启动或已冻结时调用。
+ *
+ * @retval false 记录器正在运行。
+ */
+bool APP_SCOPE_clearChannels(void);
+
+/**
+ * @brief 按配置开始一次采集，正在进行的采集被放弃。
+ *
+ * @retval false 未登记通道或配置非法。
+ */
+bool APP_SCOPE_arm(const APP_SCOPE_Config *config);
+
+/**
+ * @brief 软件触发，可在任务或中断中调用，用于设定值阶跃或软件检测到的故障。
+ *
+ * 预触发历史尚未记满时同样立即触发，历史长度相应缩短。
+ */
+void APP_SCOPE_trigger(void);
+
+/**
+ * @brief 停止记录并回到未启动状态。
+ */
+void APP_SCOPE_stop(void);
+
+/**
+ * @brief 返回 ::APP_SCOPE_State。
+ */
+uint16_t APP_SCOPE_getState(void);
+
+/**
+ * @brief 读取冻结后的采集信息。
+ *
+ * @retval false 尚未冻结。
+ */
+bool APP_SCOPE_getCapture(APP_SCOPE_Capture *capture);
+
+/**
+ * @brief 按时间顺序读取一个采样的全部通道。
+ *
+ * @param[in]  index  采样序号，0 为最早的采样。
+ * @param[out] values 至少容纳通道数个值。
+ *
+ * @retval false 尚未冻结或序号越界。
+ */
+bool APP_SCOPE_readSample(uint16_t index, float *values);
+
+/**
+ * @brief 记录一次，由 APP_CTRL_isr 在全部中断时隙之后调用。
+ */
+void APP_SCOPE_sample(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_SCOPE_H */
@@ -0,0 +1,161 @@
+/**
+ * @file app_telem.h
+ * @brief SCIA 二进制遥测调度接口。
+ *
+ * 遥测以流为单位：每个流登记若干变量（float32、int16、uint16 或 uint32）与发送周期
+ * （tick 数），到期时读取全部变量组成一个包。包的原始内容为
+ *
+ *   [流号 1B][序号 1B][时间戳 4B][变量 ...][CRC16 2B]
+ *
+ * 多字节字段均为小端序，经 app_telem_frame.h 的 COBS 编码后以 0x00 结尾。时间戳为
+ * APP_STATS_now 的 CPU 周期数，主机端据此重建采样时刻；序号按流递增，用于发现丢包。
+ *
+ * 帧直接编码进静态分配的包缓冲区，由 DRV_SCI_send 入队，发送中断从缓冲区取数据，
+ * 发送完毕后缓冲区自动回到空闲状态，全程不复制。
+ *
+ * 发送速率由字节预算限制：每个 tick 增加 bytesPerSecond / tickHz 字节额度，额度不足
+ * 或没有空闲缓冲区时包推迟到下一个 tick，流不会因此丢失周期以外的数据。预算默认等于
+ * 线路速率（波特率 / 10），即允许占满线路；降低预算可为其他协议留出带宽。多个流同时
+ * 到期时从上一次之后的流开始轮询，避免固定顺序使后面的流长期推迟。
+ *
+ * 变量由中断或 CLA 写入时，可为流设置采集函数：组包前在遥测任务中调用，在临界区内
+ * 把变量复制到任务侧副本，流登记副本的地址，同一包内的变量即来自同一时刻。
+ *
+ * APP_TELEM_service 只允许一个任务调用；登记接口须在 APP_TELEM_TASK 运行之前调用。
+ */
+
+#ifndef APP_TELEM_H
+#define APP_TELEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_telem_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 流数量上限。 */
+#ifndef APP_TELEM_MAX_STREAMS
+#define APP_TELEM_MAX_STREAMS       (8U)
+#endif
+
+/** 全部流的变量总数上限。 */
+#ifndef APP_TELEM_MAX_SIGNALS
+#define APP_TELEM_MAX_SIGNALS       (32U)
+#endif
+
+/** 包缓冲区数量，即同时在发送队列中的帧数上限。 */
+#ifndef APP_TELEM_PACKET_COUNT
+#define APP_TELEM_PACKET_COUNT      (4U)
+#endif
+
+/** 每个包的变量字节数上限。 */
+#define APP_TELEM_MAX_PAYLOAD       (64U)
+
+/** 包头字节数：流号、序号与时间戳。 */
+#define APP_TELEM_HEADER_BYTES      (6U)
+
+/** 原始内容最大字节数，含 CRC。 */
+#define APP_TELEM_RAW_MAX           (APP_TELEM_HEADER_BYTES + APP_TELEM_MAX_PAYLOAD + APP_TELEM_FRAME_CRC_BYTES)
+
+/** 编码后一帧的最大字节数。 */
+#define APP_TELEM_FRAME_MAX         (APP_TELEM_FRAME_ENCODED_MAX(APP_TELEM_HEADER_BYTES + APP_TELEM_MAX_PAYLOAD))
+
+/**
+ * @brief 采集函数，组包前在遥测任务中调用。
+ */
+typedef void (*APP_TELEM_CaptureFxn)(void *context);
+
+/**
+ * @brief 变量类型。
+ */
+typedef enum
+{
+    APP_TELEM_TYPE_FLOAT32 = 0,
+    APP_TELEM_TYPE_INT16,
+    APP_TELEM_TYPE_UINT16,
+    APP_TELEM_TYPE_UINT32
+} APP_TELEM_Type;
+
+/**
+ * @brief 发送统计。
+ */
+typedef struct
+{
+    uint32_t frames;                /**< 入队的帧数。 */
+    uint32_t bytes;                 /**< 入队的字节数。 */
+    uint32_t deferred;              /**< 因字节预算不足推迟的次数。 */
+    uint32_t noBuffer;              /**< 因没有空闲缓冲区推迟的次数。 */
+} APP_TELEM_Stats;
+
+/**
+ * @brief 清除全部流并设定调度参数。
+ *
+ * @param[in] tickHz         APP_TELEM_service 的调用频率。
+ * @param[in] bytesPerSecond 字节预算，0 表示线路速率。
+ */
+void APP_TELEM_init(uint32_t tickHz, uint32_t bytesPerSecond);
+
+/**
+ * @brief 修改字节预算，0 表示线路速率。
+ */
+void APP_TELEM_setBudget(uint32_t bytesPerSecond);
+
+/**
+ * @brief 新建一个流。
+ *
+ * @param[in]  periodTicks 发送周期，0 表示暂停。
+ * @param[out] stream      分配到的流号。
+ *
+ * @retval false 流已满。
+ */
+bool APP_TELEM_addStream(uint16_t periodTicks, uint16_t *stream);
+
+/**
+ * @brief 向流登记一个变量，包内按登记顺序排列。
+ *
+ * 变量在 APP_TELEM_service 中读取，32 bit 变量若由中断或 CLA 写入，读到的两个半字
+ * 可能来自相邻两个周期；需要一致的包时登记采集副本，见 APP_TELEM_setCapture。
+ *
+ * @retval false 参数非法、变量已满或超过 APP_TELEM_MAX_PAYLOAD。
+ */
+bool APP_TELEM_addSignal(uint16_t stream, const volatile void *address, uint16_t type);
+
+/**
+ * @brief 设置流的采集函数，每次组包前调用一次，NULL 表示不采集。
+ *
+ * @retval false 流号非法。
+ */
+bool APP_TELEM_setCapture(uint16_t stream, APP_TELEM_CaptureFxn capture, void *context);
+
+/**
+ * @brief 修改流的发送周期，0 表示暂停。
+ *
+ * @retval false 流号非法。
+ */
+bool APP_TELEM_setPeriod(uint16_t stream, uint16_t periodTicks);
+
+/**
+ * @brief 推进一个 tick，发送到期的流。
+ *
+ * @param[in] timestamp 写入本 tick 各包的时间戳。
+ */
+void APP_TELEM_service(uint32_t timestamp);
+
+/**
+ * @brief 读取发送统计。
+ */
+void APP_TELEM_getStats(APP_TELEM_Stats *stats);
+
+/**
+ * @brief 遥测任务入口，每个 tick 调用一次 APP_TELEM_service。
+ */
+void APP_TELEM_TASK(void *pvParameters);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_TELEM_H */
@@ -0,0 +1,124 @@
+/**
+ * @file app_trace.h
+ * @brief 低开销二进制跟踪缓冲区接口。
+ *
+ * 缓冲区静态分配在 RAMGS0（段 ramgs0），以环形方式覆盖最旧记录。每条记录为
+ * 16 bit 事件编号、16 bit 参数与 32 bit 时间戳，共 4 个 16 bit 字；时间戳取自
+ * APP_STATS_now（CPUTIMER0，SYSCLK 周期）。
+ *
+ * 写入路径只在读取时间戳与领取槽位的几条指令内屏蔽中断，不使用锁，可在任务与
+ * 中断中任意调用。内联写入约 25 个周期，内核钩子经 APP_TRACE_kernelEvent 调用，
+ * 另加调用开销约 8 个周期。
+ *
+ * 用调试器导出 APP_TRACE_buffer 整个结构体的内存（16 bit 字，小端），即可交给
+ * tools/host/trace_decode 生成时间线与延迟直方图。
+ */
+
+#ifndef APP_TRACE_H
+#define APP_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_stats.h"
+#include "app_trace_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 记录条数，必须为 2 的幂。 */
+#ifndef APP_TRACE_CAPACITY
+#define APP_TRACE_CAPACITY      (512U)
+#endif
+
+#define APP_TRACE_MASK          (APP_TRACE_CAPACITY - 1U)
+
+/** 缓冲区头部标识（"TR"）与格式版本，供主机端校验内存导出。 */
+#define APP_TRACE_MAGIC         (0x5254U)
+#define APP_TRACE_VERSION       (1U)
+
+/**
+ * @brief 单条跟踪记录，4 个 16 bit 字，时间戳 32 bit 对齐。
+ */
+typedef struct
+{
+    uint16_t id;            /**< 事件编号，见 app_trace_events.h。 */
+    uint16_t arg;           /**< 事件参数。 */
+    uint32_t timestamp;     /**< SYSCLK 周期计数。 */
+} APP_TRACE_Record;
+
+/**
+ * @brief 跟踪缓冲区，头部 8 个字，随后为记录数组。
+ */
+typedef struct
+{
+    uint16_t          magic;      /**< ::APP_TRACE_MAGIC。 */
+    uint16_t          version;    /**< ::APP_TRACE_VERSION。 */
+    uint16_t          capacity;   /**< 记录条数。 */
+    uint16_t          sysclkMHz;  /**< 时间戳频率（MHz）。 */
+    volatile uint32_t sequence;   /**< 累计写入条数，低位即下一条记录的槽位。 */
+    volatile uint16_t enabled;    /**< 非 0 时记录，0 时冻结缓冲区。 */
+    uint16_t          reserved;
+    APP_TRACE_Record  records[APP_TRACE_CAPACITY];
+} APP_TRACE_Buffer;
+
+extern APP_TRACE_Buffer APP_TRACE_buffer;
+
+/**
+ * @brief 初始化缓冲区头部并开始记录，需在 APP_STATS_init 之后调用。
+ */
+void APP_TRACE_init(void);
+
+/**
+ * @brief 冻结或恢复记录，冻结后缓冲区内容保持不变，便于现场导出。
+ */
+void APP_TRACE_setEnabled(bool enabled);
+
+/**
+ * @brief 写入一条记录。
+ *
+ * 时间戳在屏蔽中断期间读取，保证槽位顺序与时间顺序一致。
+ */
+static inline void APP_TRACE_record(uint16_t id, uint16_t arg)
+{
+    APP_TRACE_Record *rec;
+    uint32_t timestamp;
+    uint32_t seq;
+    uint16_t intState;
+
+    if(APP_TRACE_buffer.enabled == 0U)
+    {
+        return;
+    }
+
+    intState = __disable_interrupts();
+    timestamp = APP_STATS_now();
+    seq = APP_TRACE_buffer.sequence;
+    APP_TRACE_buffer.sequence = seq + 1U;
+    __restore_interrupts(intState);
+
+    rec = &APP_TRACE_buffer.records[(uint16_t)seq & APP_TRACE_MASK];
+    rec->id        = id;
+    rec->arg       = arg;
+    rec->timestamp = timestamp;
+}
+
+/**
+ * @brief 记录用户中断入口与出口。
+ */
+static inline void APP_TRACE_isrEnter(uint16_t isr)
+{
+    APP_TRACE_record(APP_TRACE_EV_ISR_ENTER, isr);
+}
+
+static inline void APP_TRACE_isrExit(uint16_t isr)
+{
+    APP_TRACE_record(APP_TRACE_EV_ISR_EXIT, isr);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_TRACE_H */
@@ -0,0 +1,69 @@
+/**
+ * @file app_trace_freertos.h
+ * @brief 将 FreeRTOS 跟踪钩子映射到二进制跟踪缓冲区。
+ *
+ * 通过编译选项 --preinclude 包含到每个编译单元，使内核源文件展开这些钩子。
+ * 钩子中使用的 uxTCBNumber、uxQueueNumber 与 ucQueueType 需要
+ * configUSE_TRACE_FACILITY 为 1（main.syscfg 中已开启）。
+ * 本文件不得包含其它工程头文件，以免影响不使用跟踪的编译单元。
+ */
+
+#ifndef APP_TRACE_FREERTOS_H
+#define APP_TRACE_FREERTOS_H
+
+#include <stdint.h>
+
+#include "app_trace_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 内核钩子的记录入口，与 APP_TRACE_record 相同但不内联，位于 RAM 中执行。
+ */
+extern void APP_TRACE_kernelEvent(uint16_t id, uint16_t arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifndef APP_TRACE_DISABLE_KERNEL_HOOKS
+
+#define APP_TRACE_QUEUE_ARG(pxQueue) \
+    ((uint16_t)((((uint16_t)(pxQueue)->ucQueueType) << 12) | \
+                ((uint16_t)(pxQueue)->uxQueueNumber & 0x0FFFU)))
+
+#define traceTASK_SWITCHED_IN() \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_TASK_IN, (uint16_t)pxCurrentTCB->uxTCBNumber)
+#define traceTASK_SWITCHED_OUT() \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_TASK_OUT, (uint16_t)pxCurrentTCB->uxTCBNumber)
+
+#define traceQUEUE_SEND(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_SEND, APP_TRACE_QUEUE_ARG(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_SEND_ISR, APP_TRACE_QUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_RECV, APP_TRACE_QUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_RECV_ISR, APP_TRACE_QUEUE_ARG(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_SEND_FAIL, APP_TRACE_QUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_RECV_FAIL, APP_TRACE_QUEUE_ARG(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_QUEUE_BLOCK_RECV, APP_TRACE_QUEUE_ARG(pxQueue))
+
+/* 不同内核版本的通知钩子参数个数不同，统一以可变参数接收并忽略。 */
+#define traceTASK_NOTIFY(...) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_NOTIFY, (uint16_t)pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_FROM_ISR(...) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_NOTIFY_ISR, (uint16_t)pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(...) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_NOTIFY_GIVE_ISR, (uint16_t)pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_TAKE(...) \
+    APP_TRACE_kernelEvent(APP_TRACE_EV_NOTIFY_TAKE, (uint16_t)pxCurrentTCB->uxTCBNumber)
+
+#endif /* APP_TRACE_DISABLE_KERNEL_HOOKS */
+
+#endif /* APP_TRACE_FREERTOS_H */
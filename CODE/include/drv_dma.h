@@ -0,0 +1,128 @@
+/**
+ * @file drv_dma.h
+ * @brief DMA 驱动接口定义，把 ADC 结果寄存器连续搬运到 RAMGS2 中的采集缓冲区。
+ *
+ * DMA CH1 由 ADCA INT1 触发（与 CLA 任务 1 同源，每个 PWM 周期一次），每次触发以一个
+ * burst 读取 DRV_DMA_CHANNELS 个结果寄存器，按采样交错写入缓冲区，CPU 不参与逐点
+ * 搬运。缓冲区分为前后两半，每半为一个窗口（DRV_DMA_HALF_SAMPLES 次采样），两半
+ * 交替写入：
+ *  - 每个窗口对应一次 DMA 传输，传输开始时产生中断，中断中把下一次传输的目标地址
+ *    写入影子寄存器，并报告上一个窗口已写满（半满/全满）；
+ *  - 读者以 DRV_DMA_acquireWindow 直接取得缓冲区内的窗口指针，无需复制，处理完后以
+ *    DRV_DMA_releaseWindow 检查窗口在持有期间是否已被覆盖。
+ *
+ * 一个窗口在其后第二次传输开始时被覆盖，因此读者须在一个窗口时长内处理完毕。
+ * 读取接口只允许一个任务调用。
+ */
+
+#ifndef DRV_DMA_H
+#define DRV_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_adc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 每次触发搬运的结果寄存器数量，1~32。 */
+#define DRV_DMA_CHANNELS            (2U)
+
+/** 第一个结果寄存器与同一 burst 内相邻寄存器的地址间隔（16 bit 字）。 */
+#define DRV_DMA_SRC_ADDR            (DRV_ADC_IA_RESULT_ADDR)
+#define DRV_DMA_SRC_STEP            ((int16_t)(DRV_ADC_IB_RESULT_ADDR - DRV_ADC_IA_RESULT_ADDR))
+
+/** 每个窗口的采样次数。 */
+#ifndef DRV_DMA_HALF_SAMPLES
+#define DRV_DMA_HALF_SAMPLES        (512U)
+#endif
+
+#define DRV_DMA_HALF_WORDS          (DRV_DMA_HALF_SAMPLES * DRV_DMA_CHANNELS)
+#define DRV_DMA_BUFFER_WORDS        (2U * DRV_DMA_HALF_WORDS)
+
+/**
+ * @brief 采集窗口，指向缓冲区内部。
+ *
+ * 第 n 次采样第 c 路结果位于 data[n * channels + c]。
+ */
+typedef struct
+{
+    const uint16_t *data;       /**< 窗口首地址。 */
+    uint16_t        samples;    /**< 采样次数。 */
+    uint16_t        channels;   /**< 每次采样的结果数量。 */
+    uint32_t        sequence;   /**< 窗口序号，从 0 递增，奇偶对应后/前半缓冲区。 */
+} DRV_DMA_Window;
+
+/**
+ * @brief 采集统计。
+ */
+typedef struct
+{
+    uint32_t windows;           /**< 已写满的窗口数。 */
+    uint32_t dropped;           /**< 读者未及时取走而被跳过的窗口数。 */
+    uint32_t overruns;          /**< 持有期间被覆盖的窗口数。 */
+} DRV_DMA_Stats;
+
+/**
+ * @brief 窗口写满回调，在 DMA 中断中调用。
+ *
+ * @param[in] half     0 为前半缓冲区（半满），1 为后半缓冲区（全满）。
+ * @param[in] sequence 写满的窗口序号。
+ */
+typedef void (*DRV_DMA_Callback)(uint16_t half, uint32_t sequence);
+
+/** 采集缓冲区，位于 RAMGS2（段 ramgs2），可按固定地址导出。 */
+extern uint16_t DRV_DMA_buffer[DRV_DMA_BUFFER_WORDS];
+
+/**
+ * @brief 初始化 DMA 控制器与 CH1 并挂接中断，不启动采集。
+ *
+ * 需在 EALLOW 下、DRV_ADC_init 之后调用。
+ */
+void DRV_DMA_init(void);
+
+/**
+ * @brief 设置窗口写满回调，传入 NULL 取消。
+ */
+void DRV_DMA_setCallback(DRV_DMA_Callback callback);
+
+/**
+ * @brief 从前半缓冲区开始采集，窗口序号与统计清零。
+ *
+ * @retval false 驱动尚未初始化。
+ */
+bool DRV_DMA_start(void);
+
+/**
+ * @brief 停止采集，已写满的窗口仍可读取。
+ */
+void DRV_DMA_stop(void);
+
+/**
+ * @brief 取得最早一个尚未读取的完整窗口。
+ *
+ * 积压超过一个窗口时跳到最新的完整窗口，跳过的窗口计入 dropped。
+ *
+ * @retval false 没有新的完整窗口。
+ */
+bool DRV_DMA_acquireWindow(DRV_DMA_Window *window);
+
+/**
+ * @brief 结束对窗口的访问。
+ *
+ * @retval false 窗口在持有期间已开始被覆盖，读到的数据可能不完整。
+ */
+bool DRV_DMA_releaseWindow(const DRV_DMA_Window *window);
+
+/**
+ * @brief 读取采集统计。
+ */
+void DRV_DMA_getStats(DRV_DMA_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_DMA_H */
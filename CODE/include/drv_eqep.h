@@ -0,0 +1,211 @@
+/**
+ * @file drv_eqep.h
+ * @brief eQEP1 增量编码器驱动：位置、零位锁存与全速度范围的测速。
+ *
+ * 计数器对 A、B 两路的上升沿与下降沿计数，每转 DRV_EQEP_COUNTS_PER_REV 个计数，
+ * 每个零位脉冲复位为 0（反转时为最大值），零位之间到达最大值后自然回绕：
+ *  - 零位锁存：每次零位事件锁存复位前的计数器值，无丢计数时与 0 的环形距离不超过
+ *    DRV_EQEP_INDEX_TOLERANCE，否则记为零位误差，计数器由本次复位纠正；
+ *  - 第一个零位之前位置只相对上电时刻，DRV_EQEP_output.aligned 为 0，之后电角度
+ *    才与转子绝对位置对应。
+ *
+ * 测速由单位定时器（DRV_EQEP_UNIT_HZ）驱动，超时同时锁存位置、捕获周期与捕获
+ * 定时器，中断中二选一：
+ *  - 频率法：单位时间内的位置增量，高速时分辨率高；
+ *  - 周期法：捕获单元以 SYSCLK/128 计量每 DRV_EQEP_UPEVNT_COUNTS 个计数的时间，
+ *    低速时分辨率高。取捕获周期与自上次事件以来的捕获定时器中的较大者，减速到
+ *    停止时速度随之下降；捕获定时器溢出时速度为 0，期间方向改变的样本记为 0。
+ * 每个单位周期的位置增量低于 DRV_EQEP_TO_PERIOD_COUNTS 时切换到周期法，高于
+ * DRV_EQEP_TO_FREQ_COUNTS 时切换回频率法，两者之间保持当前方法；切换点附近两种
+ * 方法的分辨率相近。第一个零位复位计数器时跳过前后两个频率法样本。
+ *
+ * 结果以 DRV_EQEP_output 发布：速度由 eQEP 中断每个单位周期更新；电角度由电流环
+ * 中断调用 DRV_EQEP_updateAngle 从当前计数器值计算，标幺值与 APP_CLA_Command.angle
+ * 相同。各字段为单个 32 bit 量，中断中可直接读取。DRV_EQEP_output 位于 C28x 的
+ * .bss，CLA 不能访问：CLA 任务以 DRV_EQEP_POSITION_ADDR 直接读计数器，用同一个
+ * DRV_EQEP_angleFromPosition 换算。
+ *
+ * 硬件经 DRV_EQEP_PORT_* 接口访问：目标板由 drv_eqep_port.c 实现，主机端编码器
+ * 信号模拟器见 tools/host/eqep_host，两者共用 drv_eqep.c。
+ */
+
+#ifndef DRV_EQEP_H
+#define DRV_EQEP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 编码器线数。 */
+#ifndef DRV_EQEP_LINES
+#define DRV_EQEP_LINES                  (1000U)
+#endif
+
+/** 电机极对数。 */
+#ifndef DRV_EQEP_POLE_PAIRS
+#define DRV_EQEP_POLE_PAIRS             (4U)
+#endif
+
+/** 每转计数（四倍频）。 */
+#define DRV_EQEP_COUNTS_PER_REV         (4UL * DRV_EQEP_LINES)
+
+/** 单位定时器频率与 100 MHz SYSCLK 下的周期。 */
+#define DRV_EQEP_UNIT_HZ                (1000U)
+#define DRV_EQEP_UNIT_PERIOD_CYCLES     (100000UL)
+
+/** 捕获时钟：SYSCLK/128。 */
+#define DRV_EQEP_CAPCLK_DIV             (128U)
+#define DRV_EQEP_CAPCLK_HZ              (781250UL)
+
+/** 每个捕获事件的计数数（QCLK/4，即一个完整线周期）。 */
+#define DRV_EQEP_UPEVNT_COUNTS          (4U)
+
+/** 频率法与周期法的切换阈值（每个单位周期的计数）。 */
+#define DRV_EQEP_TO_PERIOD_COUNTS       (48U)
+#define DRV_EQEP_TO_FREQ_COUNTS         (64U)
+
+/** 零位锁存允许的偏差（计数）。 */
+#define DRV_EQEP_INDEX_TOLERANCE        (2)
+
+/** 第一个零位后跳过的频率法样本数。 */
+#define DRV_EQEP_SKIP_AFTER_ALIGN       (2U)
+
+/** eQEP1 位置计数器 QPOSCNT 的地址，使用处须包含 inc/hw_memmap.h 与 inc/hw_eqep.h。 */
+#define DRV_EQEP_POSITION_ADDR          (EQEP1_BASE + EQEP_O_QPOSCNT)
+
+/** DRV_EQEP_onEvents 的事件位。 */
+#define DRV_EQEP_EVT_UNIT_TIMEOUT       (0x0001U)
+#define DRV_EQEP_EVT_INDEX              (0x0002U)
+
+/** DRV_EQEP_Latch.status 的状态位，自上一次单位超时以来。 */
+#define DRV_EQEP_STS_FORWARD            (0x0001U)   /**< 当前为正转。 */
+#define DRV_EQEP_STS_CAP_OVERFLOW       (0x0002U)   /**< 捕获定时器溢出。 */
+#define DRV_EQEP_STS_CAP_DIR_ERROR      (0x0004U)   /**< 两次捕获事件之间方向改变。 */
+
+/**
+ * @brief 测速方法。
+ */
+typedef enum
+{
+    DRV_EQEP_MODE_FREQUENCY = 0,    /**< 频率法（单位时间计数）。 */
+    DRV_EQEP_MODE_PERIOD    = 1     /**< 周期法（捕获边沿间隔）。 */
+} DRV_EQEP_Mode;
+
+/**
+ * @brief 中断中读取的锁存值。
+ */
+typedef struct
+{
+    uint32_t position;          /**< 单位超时锁存的位置。 */
+    uint32_t indexPosition;     /**< 零位事件锁存的位置。 */
+    uint16_t capturePeriod;     /**< 单位超时锁存的捕获周期（捕获时钟）。 */
+    uint16_t captureTimer;      /**< 单位超时锁存的捕获定时器（捕获时钟）。 */
+    uint16_t status;            /**< DRV_EQEP_STS_* 组合。 */
+} DRV_EQEP_Latch;
+
+/**
+ * @brief 发布给控制中断的结果。
+ */
+typedef struct
+{
+    float    anglePu;           /**< 电角度标幺值 [0, 1)，由 DRV_EQEP_updateAngle 更新。 */
+    float    speedRps;          /**< 机械转速（转/秒），正转为正。 */
+    float    elecSpeedHz;       /**< 电频率（Hz），正转为正。 */
+    uint32_t position;          /**< 最近一次 DRV_EQEP_updateAngle 读到的计数器值。 */
+    uint16_t mode;              /**< 当前测速方法，DRV_EQEP_Mode。 */
+    uint16_t aligned;           /**< 已经过零位，位置为绝对位置。 */
+} DRV_EQEP_Output;
+
+/**
+ * @brief 统计。
+ */
+typedef struct
+{
+    uint32_t unitEvents;        /**< 单位超时次数。 */
+    uint32_t indexEvents;       /**< 零位事件次数。 */
+    uint32_t indexErrors;       /**< 零位锁存超出允许偏差的次数。 */
+    int32_t  lastIndexError;    /**< 最近一次超差的锁存偏差（计数）。 */
+    uint32_t modeSwitches;      /**< 测速方法切换次数。 */
+    uint32_t captureOverflows;  /**< 周期法下捕获定时器溢出的单位周期数。 */
+    uint32_t captureDirErrors;  /**< 周期法下方向改变的单位周期数。 */
+} DRV_EQEP_Stats;
+
+/**
+ * @brief 计数器值换算为电角度标幺值 [0, 1)，C28x 与 CLA 共用。
+ *
+ * @param[in] offsetPu 零位处的电角度偏移，[0, 1)。
+ */
+static inline float DRV_EQEP_angleFromPosition(uint32_t position, float offsetPu)
+{
+    float angle;
+
+    /* 计数器与偏移均非负，截断即取小数部分。 */
+    angle  = ((float)position * (1.0f / (float)DRV_EQEP_COUNTS_PER_REV) * (float)DRV_EQEP_POLE_PAIRS) +
+             offsetPu;
+    angle -= (float)(int32_t)angle;
+
+    return angle;
+}
+
+#ifndef __TMS320C28XX_CLA__
+
+/** 控制中断可直接读取的结果。 */
+extern volatile DRV_EQEP_Output DRV_EQEP_output;
+
+/**
+ * @brief 初始化 eQEP1，开始计数与测速。
+ *
+ * @retval false 硬件初始化失败。
+ */
+bool DRV_EQEP_init(void);
+
+/**
+ * @brief 设置零位处的电角度偏移（标幺值），由转子对齐标定得到。
+ */
+void DRV_EQEP_setAngleOffset(float offsetPu);
+
+/**
+ * @brief 读取零位处的电角度偏移（标幺值），[0, 1)。
+ */
+float DRV_EQEP_getAngleOffset(void);
+
+/**
+ * @brief 由当前计数器值计算电角度并发布，供电流环中断每个周期调用。
+ *
+ * @return 电角度标幺值 [0, 1)。
+ */
+float DRV_EQEP_updateAngle(void);
+
+/**
+ * @brief 读取统计。
+ */
+void DRV_EQEP_getStats(DRV_EQEP_Stats *stats);
+
+/**
+ * @brief eQEP 中断入口，由硬件接口调用。
+ *
+ * @param[in] events DRV_EQEP_EVT_* 组合，同时发生时先处理零位。
+ * @param[in] latch  锁存值与状态。
+ */
+void DRV_EQEP_onEvents(uint16_t events, const DRV_EQEP_Latch *latch);
+
+/*
+ * 硬件接口。
+ */
+
+/** 配置引脚、计数、锁存、单位定时器、捕获单元与中断。 */
+bool DRV_EQEP_PORT_init(void);
+
+/** 读取当前计数器值。 */
+uint32_t DRV_EQEP_PORT_getPosition(void);
+
+#endif /* __TMS320C28XX_CLA__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_EQEP_H */
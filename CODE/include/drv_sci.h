@@ -0,0 +1,104 @@
+/**
+ * @file drv_sci.h
+ * @brief SCIA 驱动接口定义，以 16 级 FIFO 中断收发字节流。
+ *
+ * 发送以缓冲区为单位：调用者提供静态分配的 DRV_SCI_TxBuffer 并入队，驱动不复制数据，
+ * 发送中断直接从缓冲区填充 TX FIFO，发送完毕后清除 busy，缓冲区随即归还调用者。
+ * TX FIFO 降到 DRV_SCI_TX_FIFO_LEVEL 以下时中断，队列为空时关闭 TX 中断。
+ *
+ * 接收中断把 RX FIFO 中的字节放入环形缓冲区，由 DRV_SCI_read 在任务中取出。
+ *
+ * 每个字的低 8 bit 为一个字节。发送队列与接收缓冲区均为单生产者/单消费者：
+ * DRV_SCI_send 与 DRV_SCI_read 各自只允许一个任务调用。
+ */
+
+#ifndef DRV_SCI_H
+#define DRV_SCI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 波特率，LSPCLK 为 25 MHz 时误差 0.47%。 */
+#ifndef DRV_SCI_BAUD
+#define DRV_SCI_BAUD                (115200UL)
+#endif
+
+/** 每字节在线路上的位数（8N1）。 */
+#define DRV_SCI_BITS_PER_BYTE       (10U)
+
+/** 发送队列深度，必须为 2 的幂。 */
+#ifndef DRV_SCI_TX_QUEUE_DEPTH
+#define DRV_SCI_TX_QUEUE_DEPTH      (8U)
+#endif
+
+/** 接收缓冲区字节数，必须为 2 的幂。 */
+#ifndef DRV_SCI_RX_BUFFER_SIZE
+#define DRV_SCI_RX_BUFFER_SIZE      (256U)
+#endif
+
+#define DRV_SCI_TX_QUEUE_MASK       (DRV_SCI_TX_QUEUE_DEPTH - 1U)
+#define DRV_SCI_RX_BUFFER_MASK      (DRV_SCI_RX_BUFFER_SIZE - 1U)
+
+/**
+ * @brief 发送缓冲区，入队后归驱动所有，直到 busy 被清除。
+ */
+typedef struct
+{
+    const uint16_t   *data;     /**< 待发送字节。 */
+    uint16_t          length;   /**< 字节数。 */
+    volatile uint16_t busy;     /**< 入队时置 1，发送完毕后由中断清 0。 */
+} DRV_SCI_TxBuffer;
+
+/**
+ * @brief 收发统计。
+ */
+typedef struct
+{
+    uint32_t txBytes;           /**< 已写入 TX FIFO 的字节数。 */
+    uint32_t txBuffers;         /**< 发送完毕的缓冲区数。 */
+    uint32_t rxBytes;           /**< 放入接收缓冲区的字节数。 */
+    uint32_t rxDropped;         /**< 接收缓冲区满而丢弃的字节数。 */
+    uint32_t rxErrors;          /**< 帧错误、奇偶错误或 FIFO 溢出次数。 */
+} DRV_SCI_Stats;
+
+/**
+ * @brief 初始化 SCIA、引脚与 FIFO 中断，需在 EALLOW 下调用。
+ */
+void DRV_SCI_init(void);
+
+/**
+ * @brief 发送缓冲区入队。
+ *
+ * @retval false 参数非法、缓冲区仍在发送或队列已满。
+ */
+bool DRV_SCI_send(DRV_SCI_TxBuffer *buffer);
+
+/**
+ * @brief 返回发送队列中尚未发送完毕的缓冲区数量。
+ */
+uint16_t DRV_SCI_getTxPending(void);
+
+/**
+ * @brief 取出已接收的字节。
+ *
+ * @param[out] data      接收缓冲区。
+ * @param[in]  maxLength 最多取出的字节数。
+ *
+ * @return 实际取出的字节数。
+ */
+uint16_t DRV_SCI_read(uint16_t *data, uint16_t maxLength);
+
+/**
+ * @brief 读取收发统计。
+ */
+void DRV_SCI_getStats(DRV_SCI_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV_SCI_H */
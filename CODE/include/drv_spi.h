@@ -1,6 +1,6 @@
 /**
  * @file drv_spi.h
- * @brief SPI 驱动接口定义，负责 SPI 外设的初始化与状态查询。
+ * @brief SPI 驱动接口定义，负责 SPI 外设的初始化、状态查询与共享总线的事务调度。
  */
 
 #ifndef DRV_SPI_H
@@ -25,6 +25,162 @@ extern "C" {
  */
 #define DRV_SPI_INVALID_GPIO        (0xFFFFFFFFUL)
 
+/**
+ * @brief 共享同一 SPI 总线的软件片选数量上限。
+ */
+#define DRV_SPI_MAX_CHIP_SELECTS    (4U)
+
+/**
+ * @brief 总线事务管理器可登记的从设备数量上限，与软件片选数量一致。
+ */
+#define DRV_SPI_MAX_DEVICES         DRV_SPI_MAX_CHIP_SELECTS
+
+/**
+ * @brief 每个优先级的事务队列深度，必须为 2 的幂。
+ */
+#ifndef DRV_SPI_XFER_QUEUE_DEPTH
+#define DRV_SPI_XFER_QUEUE_DEPTH    (8U)
+#endif
+
+/**
+ * @brief SPI 硬件 FIFO 深度，片选保持型事务按此分块装入。
+ */
+#define DRV_SPI_FIFO_DEPTH          (16U)
+
+/**
+ * @brief 无效的从设备编号。
+ */
+#define DRV_SPI_INVALID_DEVICE      (0xFFFFU)
+
+/**
+ * @brief DRV8316 寄存器访问使用的事务优先级。
+ */
+#ifndef DRV_SPI_DRV8316_PRIORITY
+#define DRV_SPI_DRV8316_PRIORITY    DRV_SPI_PRIO_NORMAL
+#endif
+
+/**
+ * @brief 事务优先级，数值越小越优先。
+ *
+ * 高优先级事务只在低优先级事务的帧间隙抢占总线，不会打断正在移位的帧。
+ * 例如编码器读取使用 ::DRV_SPI_PRIO_HIGH，可以插入 DRV8316 状态扫描的两帧之间。
+ */
+typedef enum
+{
+    DRV_SPI_PRIO_CRITICAL = 0,  /**< 控制环路内的访问，例如位置传感器。 */
+    DRV_SPI_PRIO_HIGH,          /**< 周期性的时间敏感访问。 */
+    DRV_SPI_PRIO_NORMAL,        /**< 常规寄存器访问，例如 DRV8316 扫描。 */
+    DRV_SPI_PRIO_LOW,           /**< 诊断与后台访问。 */
+    DRV_SPI_PRIO_COUNT
+} DRV_SPI_Priority;
+
+/**
+ * @brief 链路自检在每个速率档位上的写入/回读次数。
+ */
+#ifndef DRV_SPI_SELFTEST_ROUNDS
+#define DRV_SPI_SELFTEST_ROUNDS     (8U)
+#endif
+
+/**
+ * @brief 链路自检选定速率时相对最高无误档位回退的档位数。
+ */
+#ifndef DRV_SPI_SELFTEST_MARGIN
+#define DRV_SPI_SELFTEST_MARGIN     (1U)
+#endif
+
+/**
+ * @brief 运行期降速判据：在 DRV_SPI_BACKOFF_WINDOW 帧内出现
+ *        DRV_SPI_BACKOFF_ERRORS 次错误即降低一档速率。
+ */
+#ifndef DRV_SPI_BACKOFF_WINDOW
+#define DRV_SPI_BACKOFF_WINDOW      (256U)
+#endif
+#ifndef DRV_SPI_BACKOFF_ERRORS
+#define DRV_SPI_BACKOFF_ERRORS      (2U)
+#endif
+
+/**
+ * @brief 事务状态。
+ */
+typedef enum
+{
+    DRV_SPI_XFER_IDLE = 0,      /**< 未提交或已被调用者回收。 */
+    DRV_SPI_XFER_QUEUED,        /**< 已入队，等待总线。 */
+    DRV_SPI_XFER_ACTIVE,        /**< 正在传输或在帧间被抢占。 */
+    DRV_SPI_XFER_DONE,          /**< 全部帧已完成。 */
+    DRV_SPI_XFER_ERROR          /**< 超时或被取消。 */
+} DRV_SPI_XferStatus;
+
+/**
+ * @brief 从设备总线参数，切换到该设备时写入 SPI 外设。
+ */
+typedef struct
+{
+    uint32_t             csGpio;     /**< 软件片选 GPIO，未连接时为 ::DRV_SPI_INVALID_GPIO。 */
+    uint32_t             bitRate;    /**< 传输速率（Hz）。 */
+    SPI_TransferProtocol protocol;   /**< 时钟极性与相位。 */
+    uint16_t             dataWidth;  /**< 数据位宽，1~16 bit。 */
+    bool                 csPerFrame; /**< true 表示每帧单独拉低片选（DRV8316），帧间可被抢占；
+                                          false 表示整笔事务保持片选，不可抢占。 */
+    uint32_t             csSetupNs;  /**< 片选拉低到首个 SCLK 沿的最短时间（ns），0 表示不等待。 */
+    uint32_t             csHoldNs;   /**< 末个 SCLK 沿到片选拉高的最短时间（ns），0 表示不等待。 */
+    uint32_t             csIdleNs;   /**< 同一设备连续两次选中之间片选高电平的最短时间（ns）。 */
+} DRV_SPI_DeviceConfig;
+
+struct DRV_SPI_Transaction_;
+
+/**
+ * @brief 事务完成回调，在 SPI 中断上下文中执行。
+ */
+typedef void (*DRV_SPI_XferCallback)(struct DRV_SPI_Transaction_ *xfer);
+
+/**
+ * @brief 一笔 SPI 事务。
+ *
+ * 描述符由调用者静态分配，提交后直到状态变为 DONE 或 ERROR 之前不得修改或释放。
+ * 位宽小于 16 bit 时，txBuf 中的数据右对齐存放，rxBuf 返回的数据同样右对齐。
+ */
+typedef struct DRV_SPI_Transaction_
+{
+    uint16_t                     device;   /**< DRV_SPI_registerDevice 返回的设备编号。 */
+    DRV_SPI_Priority             priority; /**< 事务优先级。 */
+    const uint16_t              *txBuf;    /**< 发送数据，length 个字。 */
+    uint16_t                    *rxBuf;    /**< 接收数据，可为 NULL 表示丢弃。 */
+    uint16_t                     length;   /**< 帧数。 */
+    DRV_SPI_XferCallback         callback; /**< 完成回调，可为 NULL。 */
+    void                        *context;  /**< 调用者上下文。 */
+    volatile DRV_SPI_XferStatus  status;   /**< 事务状态。 */
+    uint16_t                     position; /**< 已完成的帧数，由管理器维护。 */
+} DRV_SPI_Transaction;
+
+/**
+ * @brief DRV8316 链路质量统计。
+ *
+ * DRV8316 帧不带 CRC，错误由两类现象判定：应答中恒为 0 的保留位被置位
+ * （SDO 采样错误），以及 STATUS_0 的 SPI_FLT 新出现（器件判定命令帧校验错误）。
+ */
+typedef struct
+{
+    uint32_t frames;        /**< 已发送的帧数。 */
+    uint32_t timeouts;      /**< 应答超时次数。 */
+    uint32_t respErrors;    /**< 应答保留位异常次数。 */
+    uint32_t parityFaults;  /**< 器件报告的命令帧校验/地址错误次数。 */
+    uint32_t rateDowns;     /**< 因错误自动降速的次数。 */
+    uint32_t bitRate;       /**< 当前速率（Hz）。 */
+} DRV_SPI_LinkStats;
+
+/**
+ * @brief DRV8316 链路自检结果。
+ */
+typedef struct
+{
+    uint32_t maxCleanRate;  /**< 全部写入/回读无误的最高速率（Hz），0 表示最低档亦失败。 */
+    uint32_t selectedRate;  /**< 回退裕量后最终采用的速率（Hz）。 */
+    uint16_t stepsTested;   /**< 实际测试的速率档位数。 */
+    uint16_t failErrors;    /**< 首个失败档位上的错误次数。 */
+    bool     passed;        /**< 最低档位是否通过。 */
+} DRV_SPI_SelfTestResult;
+
 /**
  * @brief SPI 驱动运行状态。
  */
@@ -35,6 +191,8 @@ typedef struct
     uint16_t dataWidth;     /**< SPI 数据位宽，取值范围 1~16 bit，对应 DRV8316 寄存器宽度。 */
     uint32_t csGpio;        /**< 软件片选 GPIO 编号，使用 Device 层宏定义的逻辑引脚编号。 */
     uint32_t enableGpio;    /**< 使能信号 GPIO 编号，用于控制驱动器 EN 引脚。 */
+    uint32_t csTable[DRV_SPI_MAX_CHIP_SELECTS]; /**< 总线上已登记的全部软件片选 GPIO。 */
+    uint16_t csCount;       /**< 已登记的软件片选数量。 */
     bool     initialized;   /**< SPI 是否已完成初始化，避免多次重复配置。 */
 } DRV_SPI_State;
 
@@ -55,6 +213,18 @@ void DRV_SPI_init(void);
  */
 void DRV_SPI_setChipSelectGPIO(uint32_t gpio);
 
+/**
+ * @brief 在共享总线上登记一个软件片选 GPIO。
+ *
+ * 多个从设备共用同一 SPI 通道时，每个从设备调用一次。重复登记同一引脚不会占用
+ * 新的表项；引脚在登记时即被配置为输出并拉高。
+ *
+ * @param[in] gpio GPIO 引脚编号。
+ * @retval true  引脚已登记；
+ * @retval false 引脚无效或片选表已满。
+ */
+bool DRV_SPI_addChipSelectGPIO(uint32_t gpio);
+
 /**
  * @brief 设置驱动器使能 GPIO。
  *
@@ -76,7 +246,9 @@ void DRV_SPI_getState(DRV_SPI_State *state);
  * @brief 绑定 SPI 驱动到 DRV8316 对象，保持接口兼容性。
  *
  * 函数会自动完成 SPI 初始化、软件片选及 EN 引脚绑定，并将 SPI 基地址
- * 传递给 DRV8316 底层驱动，便于其执行寄存器访问。
+ * 传递给 DRV8316 底层驱动，便于其执行寄存器访问。多个 DRV8316 共享总线时，
+ * 每个句柄分别调用一次并传入各自的片选。句柄同时登记为总线事务管理器中的
+ * 逐帧片选设备，此后每一帧以 ::DRV_SPI_DRV8316_PRIORITY 提交。
  *
  * @param[in] handle    DRV8316 句柄，需由上层通过 DRV8316_init 获取。
  * @param[in] csGpio    片选 GPIO 编号，未连接时传入 ::DRV_SPI_INVALID_GPIO。
@@ -84,6 +256,112 @@ void DRV_SPI_getState(DRV_SPI_State *state);
  */
 void DRV_SPI_attachToDRV8316(DRV8316_Handle handle, uint32_t csGpio, uint32_t enableGpio);
 
+/**
+ * @brief 初始化总线事务管理器并挂接 RX FIFO 中断，由 DRV_SPI_init 调用。
+ *
+ * @param[in] base SPI 模块基地址。
+ */
+void DRV_SPI_xferInit(uint32_t base);
+
+/**
+ * @brief 登记共享总线上的一个从设备。
+ *
+ * 片选同时加入片选表。登记应在 DRV_SPI_init 之后、调度启动之前完成。
+ *
+ * @param[in]  config   总线参数。
+ * @param[out] deviceId 返回的设备编号。
+ * @retval true  登记成功；
+ * @retval false 参数无效或设备表已满。
+ */
+bool DRV_SPI_registerDevice(const DRV_SPI_DeviceConfig *config, uint16_t *deviceId);
+
+/**
+ * @brief 修改已登记设备的传输速率。
+ *
+ * 新速率从该设备的下一笔事务开始生效，正在传输的事务不受影响。
+ *
+ * @retval true  已修改；
+ * @retval false 设备无效或速率超出 LSPCLK/128 ~ LSPCLK/4。
+ */
+bool DRV_SPI_setDeviceBitRate(uint16_t device, uint32_t bitRate);
+
+/**
+ * @brief 读取已登记设备的传输速率（Hz），设备无效时返回 0。
+ */
+uint32_t DRV_SPI_getDeviceBitRate(uint16_t device);
+
+/**
+ * @brief 提交一笔事务，立即返回。
+ *
+ * 可在任务或中断上下文中调用。总线空闲时立即开始传输，否则按优先级排队；
+ * 同一优先级内先进先出。
+ *
+ * @retval true  已入队；
+ * @retval false 参数无效或该优先级队列已满。
+ */
+bool DRV_SPI_submit(DRV_SPI_Transaction *xfer);
+
+/**
+ * @brief 提交一笔事务并轮询等待完成。
+ *
+ * 供全局中断被屏蔽的场合使用（例如调度启动前的初始化阶段），由本函数轮询 FIFO
+ * 标志驱动传输。等待超过 timeoutPolls 次轮询时取消该事务。任务上下文应以完成
+ * 回调唤醒等待的任务，而不是调用本函数占用 CPU。
+ *
+ * @retval true  事务完成；
+ * @retval false 提交失败或超时。
+ */
+bool DRV_SPI_transferBlocking(DRV_SPI_Transaction *xfer, uint32_t timeoutPolls);
+
+/**
+ * @brief 取消一笔尚未完成的事务，状态置为 ::DRV_SPI_XFER_ERROR。
+ *
+ * 正在传输的事务释放片选并让出总线；已完成的事务不受影响，也不调用完成回调。
+ */
+void DRV_SPI_cancel(DRV_SPI_Transaction *xfer);
+
+/**
+ * @brief 查询总线上是否有正在传输或排队的事务。
+ */
+bool DRV_SPI_isBusy(void);
+
+/**
+ * @brief SPI RX FIFO 中断服务函数，由 DRV_SPI_init 注册到 INT_SPIA_RX。
+ */
+__interrupt void DRV_SPI_rxISR(void);
+
+/**
+ * @brief 修改 DRV8316 的 SPI 速率。
+ *
+ * 同时更新总线设备参数、DRV8316 的时序换算与应答等待上限。
+ *
+ * @retval true  已修改；
+ * @retval false 句柄未绑定或速率无效。
+ */
+bool DRV_SPI_setDRV8316BitRate(DRV8316_Handle handle, uint32_t bitRate);
+
+/**
+ * @brief 运行 DRV8316 链路自检并选定速率。
+ *
+ * 从最低档开始逐档升速，每档对 CONTROL_10 的 DLY_TARGET 字段写入若干测试图样
+ * 并回读比较，保留 DLYCMP_EN 位不变，结束后恢复原值。取全部无误的最高档位再
+ * 回退 ::DRV_SPI_SELFTEST_MARGIN 档作为工作速率，同时清零链路统计。
+ * 需在寄存器解锁后、PWM 输出开启前调用。
+ *
+ * @param[in]  handle DRV8316 句柄，需已通过 DRV_SPI_attachToDRV8316 绑定。
+ * @param[out] result 自检结果，可为 NULL。
+ * @retval true  最低档位通过，已切换到选定速率；
+ * @retval false 最低档位亦失败，保持最低速率。
+ */
+bool DRV_SPI_runDRV8316SelfTest(DRV8316_Handle handle, DRV_SPI_SelfTestResult *result);
+
+/**
+ * @brief 读取 DRV8316 链路质量统计。
+ *
+ * @retval false 句柄未绑定或参数为空。
+ */
+bool DRV_SPI_getDRV8316LinkStats(DRV8316_Handle handle, DRV_SPI_LinkStats *stats);
+
 #ifdef __cplusplus
 }
 #endif
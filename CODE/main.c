@@ -6,17 +6,83 @@
 #include "c2000_freertos.h"
 // user include********************************************/
 #include "drv_epwm.h"
+#include "drv_adc.h"
+#include "drv_dma.h"
 #include "drv_spi.h"
+#include "drv_sci.h"
+#include "drv_eqep.h"
 #include "app_drv8316.h"
+#include "app_stats.h"
+#include "app_trace.h"
+#include "app_event.h"
+#include "app_ctrl.h"
+#include "app_hotpath.h"
+#include "app_flashprof.h"
+#include "app_prof.h"
+#include "app_cla.h"
+#include "app_scope.h"
+#include "app_telem.h"
+#include "app_xcp.h"
+#include "app_can.h"
+#include "app_param.h"
 
 DRV_EPWM_State epwmstate0 = {};
 
+// 控制执行器启动失败时写入跟踪缓冲区的事件
+#define MAIN_TRACE_EV_CTRL_START_FAIL   (APP_TRACE_EV_USER + 1U)
+
+// 参数保存的 XCP 地址扩展：写地址 0 请求保存，读地址 0~1 为保存成功与失败次数
+#define MAIN_XCP_EXT_PARAM              (2U)
+#define MAIN_PARAM_STATUS_WORDS         (2U)
+
+// 保存的 DRV8316 控制寄存器数：CTRL2~CTRL6 与 CTRL10，CTRL1 为寄存器锁，不属于配置
+#define MAIN_PARAM_DRV8316_REGS         (6U)
+
+// 参数保存请求由 XCP 服务任务置位、myTask0 完成后清除；结果与计数只由 myTask0 写
+static volatile bool paramStoreBusy;
+static volatile bool paramStoreResult;
+static volatile uint16_t paramStoreCount[MAIN_PARAM_STATUS_WORDS];
+
+// 进行中的参数地址空间操作
+static bool paramSpaceWrite;
+static uint16_t paramSpaceAddress;
+
+// 中速时隙发布的电流环状态副本，由控制中断写入
+APP_CLA_Status ctrlStatus;
+
+// 遥测任务组包前从 ctrlStatus 复制的副本，一个包内的变量来自同一次发布
+static APP_CLA_Status telemStatus;
+
+// 默认采集：控制中断中滚动记录电流环状态，CLA 溢出时由快速时隙软件触发，保留故障前 75% 的历史
+static const APP_SCOPE_Config scopeConfig = {
+    APP_SCOPE_TRIG_MANUAL, 0U, 0.0f, 0U, 75U, 1U
+};
+
 //
 // 函数原型
 //
 void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName);
 void vApplicationMallocFailedHook( void );
 void ePWMConfigurationTemplate(uint32_t base);
+static void loadStoredParams(void);
+static bool applyStoredDrv8316(void);
+static bool storeParams(void);
+static bool paramSpaceStart(bool write, uint32_t address, uint16_t *data, uint16_t words);
+static uint16_t paramSpacePoll(uint16_t *data, uint16_t words);
+static void startScope(void);
+static void startCtrl(void);
+static void ctrlFastSlot(void *context);
+static void ctrlMediumSlot(void *context);
+static void captureTelemStatus(void *context);
+
+#pragma CODE_SECTION(ctrlFastSlot, "hotpath")
+#pragma CODE_SECTION(ctrlMediumSlot, "hotpath")
+
+// 参数保存的 XCP 地址空间，由 myTask0 在任务中擦写闪存
+static const APP_XCP_Space paramSpace = {
+    paramSpaceStart,
+    paramSpacePoll
+};
 
 
 void myTask0_func(void * pvParameters);
@@ -30,9 +96,14 @@ __interrupt void timer1_ISR(void);
 //
 void main(void)
 {
+    uint16_t telemStream;
+
     // 初始化器件时钟和外设
     Device_init();
 
+    // 热路径代码与 FPU 查找表复制到 RAM，须先于任何中断与任务运行
+    APP_HOTPATH_init();
+
 
     // 初始化 PIE 并清除 PIE 寄存器，禁用 CPU 中断。
     Interrupt_initModule();
@@ -58,12 +129,70 @@ void main(void)
 
     EALLOW;//外设配置必须在rtosinit前??
     DRV_SPI_init();
+    DRV_SCI_init();
     DRV_EPWM_init();
-    APP_DRV8316_init(NULL);
+    DRV_ADC_init();
+    (void)DRV_EPWM_enableAdcTrigger();
+    DRV_DMA_init();
+    (void)DRV_DMA_start();
+    // 电流环由 CLA 任务 1 运行，默认不闭环，使能后 CPU 不再写 CMPA
+    APP_CLA_init();
+#if APP_CLA_ENCODER_ANGLE
+    // 增量编码器：eQEP1 计数与测速，CLA 任务 1 直接读计数器换算电角度，初始化失败时沿用给定角度
+    if(DRV_EQEP_init())
+    {
+        APP_CLA_setEncoderAngle(true);
+    }
+#endif
+    APP_DRV8316_init(APP_DRV8316_DEVICE_0, NULL);
+    // CAN 命令与遥测，在 APP_TELEM 任务中每个 tick 调度
+    (void)APP_CAN_init(configTICK_RATE_HZ);
     //ePWMConfigurationTemplate(EPWM1_BASE);
 
     EDIS;
 
+    // 闪存中保存的参数覆盖代码默认值，须在控制执行器启动之前
+    loadStoredParams();
+
+    // 运行时统计与跟踪的时间基准须先于调度器启动
+    APP_STATS_init();
+    APP_TRACE_init();
+
+    // 闪存等待周期、预取与缓存：测量构建中逐一测量并应用最佳配置，否则固定生产配置
+    if(!APP_FLASHPROF_run())
+    {
+        APP_FLASHPROF_apply();
+    }
+
+    // ERAD 区域测量：调试器占用 ERAD 时不可用，各模块随后以 APP_PROF_addFunction 注册区域
+    (void)APP_PROF_init();
+
+    // 事件队列须在中断投递之前清空
+    APP_EVENT_init();
+
+    // 数据记录器在控制中断中采样，须先于执行器启动
+    startScope();
+
+    // 遥测：默认以 100 Hz 发送电流环状态，APP_TELEM 任务启动后开始发送
+    APP_TELEM_init(configTICK_RATE_HZ, 0U);
+
+    if(APP_TELEM_addStream(pdMS_TO_TICKS(10), &telemStream))
+    {
+        (void)APP_TELEM_setCapture(telemStream, captureTelemStatus, NULL);
+        (void)APP_TELEM_addSignal(telemStream, &telemStatus.count, APP_TELEM_TYPE_UINT32);
+        (void)APP_TELEM_addSignal(telemStream, &telemStatus.id, APP_TELEM_TYPE_FLOAT32);
+        (void)APP_TELEM_addSignal(telemStream, &telemStatus.iq, APP_TELEM_TYPE_FLOAT32);
+        (void)APP_TELEM_addSignal(telemStream, &telemStatus.vd, APP_TELEM_TYPE_FLOAT32);
+        (void)APP_TELEM_addSignal(telemStream, &telemStatus.vq, APP_TELEM_TYPE_FLOAT32);
+        (void)APP_TELEM_addSignal(telemStream, &telemStatus.vdc, APP_TELEM_TYPE_FLOAT32);
+    }
+
+    // 标定协议与遥测共用 SCIA，写入在控制中断的安全点生效
+    APP_XCP_TARGET_init();
+    (void)APP_XCP_setSpace(MAIN_XCP_EXT_PARAM, &paramSpace);
+
+    // 控制执行器：注册时隙后以 PWM 频率启动，标定安全点、数据记录与 DAQ 采样随之运行
+    startCtrl();
 
     // 配置 FreeRTOS
     FreeRTOS_init();
@@ -84,10 +213,47 @@ void main(void)
 void myTask0_func(void * pvParameters){
     (void) pvParameters;
     static int i;
+    TickType_t statsTick;
+    bool drvParamsApplied = false;
+
+    // 处理 timer1_ISR 投递的事件，取代在中断中直接执行；参数存储只在本任务中擦写
+    (void)APP_EVENT_bind(APP_EVENT_SRC_TIMER1);
+    (void)APP_EVENT_bind(APP_EVENT_SRC_PARAM);
+    statsTick = xTaskGetTickCount();
 
     while (1) {
-        i++;
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        APP_EVENT_Event event;
+        TickType_t elapsed;
+
+        while (APP_EVENT_receive(APP_EVENT_SRC_TIMER1, &event)) {
+            i++;
+            DRV_EPWM_getState(&epwmstate0);
+            APP_PROF_sample();
+        }
+
+        // DRV8316 控制寄存器须等维护任务完成第一次扫描后，以扫描读回的器件值为基准写入
+        if (!drvParamsApplied && APP_DRV8316_hasScanned(APP_DRV8316_DEVICE_0)) {
+            (void)applyStoredDrv8316();
+            drvParamsApplied = true;
+        }
+
+        while (APP_EVENT_receive(APP_EVENT_SRC_PARAM, &event)) {
+            paramStoreResult = storeParams();
+            paramStoreCount[paramStoreResult ? 0U : 1U]++;
+            paramStoreBusy = false;
+        }
+
+        // 每秒结束一个统计窗口，事件处理超过一秒时补齐错过的窗口，保证等待时间不回绕
+        elapsed = xTaskGetTickCount() - statsTick;
+
+        while (elapsed >= pdMS_TO_TICKS(1000)) {
+            APP_STATS_update();
+            statsTick += pdMS_TO_TICKS(1000);
+            elapsed -= pdMS_TO_TICKS(1000);
+        }
+
+        // 事件到达即唤醒，否则等到下一个统计窗口结束
+        (void)APP_EVENT_wait(pdMS_TO_TICKS(1000) - elapsed);
     }
 }
 
@@ -99,12 +265,21 @@ void myTask0_func(void * pvParameters){
 //可以作为时基?
 __interrupt void timer1_ISR( void )
 {
+    uint32_t statsStart = APP_STATS_isrEnter();
+    BaseType_t woken = pdFALSE;
+
+    APP_TRACE_isrEnter(APP_STATS_ISR_TIMER1);
+
     //GPIO_togglePin(myLED1_GPIO);
     GPIO_togglePin(myLED2_GPIO);
 
+    // 读取 ePWM 状态的工作交给 myTask0
+    (void)APP_EVENT_postFromISR(APP_EVENT_SRC_TIMER1, 0U, 0U, &woken);
 
-    DRV_EPWM_getState(&epwmstate0);
-    
+    APP_TRACE_isrExit(APP_STATS_ISR_TIMER1);
+    APP_STATS_isrExit(APP_STATS_ISR_TIMER1, statsStart);
+
+    portYIELD_FROM_ISR(woken);
 }
 
 
@@ -138,6 +313,264 @@ void vApplicationMallocFailedHook( void )
     for( ;; );
 }
 
+//
+// loadStoredParams - 读取闪存参数存储，有记录的参数覆盖驱动与电流环的默认值
+//
+static void loadStoredParams(void)
+{
+    uint32_t pwmFrequency;
+    uint16_t deadband[2];
+    float gains[2];
+
+    // 未启用 Flash API 或闪存不可用时全部沿用默认值
+    if(!APP_PARAM_init())
+    {
+        return;
+    }
+
+    if(APP_PARAM_read(APP_PARAM_ID_PWM_FREQUENCY, 1U, &pwmFrequency, APP_PARAM_WORDS(pwmFrequency)))
+    {
+        (void)DRV_EPWM_setFrequency(pwmFrequency);
+    }
+
+    if(APP_PARAM_read(APP_PARAM_ID_PWM_DEADBAND, 1U, deadband, APP_PARAM_WORDS(deadband)))
+    {
+        DRV_EPWM_setDeadbandCounts(deadband[0], deadband[1]);
+    }
+
+    if(APP_PARAM_read(APP_PARAM_ID_CLA_GAINS, 1U, gains, APP_PARAM_WORDS(gains)))
+    {
+        (void)APP_CLA_setGains(gains[0], gains[1]);
+    }
+}
+
+//
+// applyStoredDrv8316 - 以保存的控制寄存器覆盖 0 号 DRV8316 的当前配置，CTRL1 沿用器件实际值
+//
+static bool applyStoredDrv8316(void)
+{
+    uint16_t regs[MAIN_PARAM_DRV8316_REGS];
+    DRV8316_VARS_t vars;
+
+    if(!APP_PARAM_read(APP_PARAM_ID_DRV8316_CTRL, 1U, regs, APP_PARAM_WORDS(regs)) ||
+       !APP_DRV8316_getStatusSnapshot(APP_DRV8316_DEVICE_0, &vars))
+    {
+        return false;
+    }
+
+    vars.ctrlReg02.all = regs[0];
+    vars.ctrlReg03.all = regs[1];
+    vars.ctrlReg04.all = regs[2];
+    vars.ctrlReg05.all = regs[3];
+    vars.ctrlReg06.all = regs[4];
+    vars.ctrlReg10.all = regs[5];
+
+    return APP_DRV8316_scheduleControlUpdate(APP_DRV8316_DEVICE_0, &vars);
+}
+
+//
+// storeParams - 把当前的 PWM 频率、死区、电流环增益与 DRV8316 控制寄存器写入参数存储
+//
+// 值未变的参数不写闪存；整理时擦除一个扇区，阻塞本任务数百毫秒，控制中断不受影响
+//
+static bool storeParams(void)
+{
+    DRV_EPWM_State pwm;
+    uint16_t deadband[2];
+    float gains[2];
+    uint16_t regs[MAIN_PARAM_DRV8316_REGS];
+    DRV8316_VARS_t vars;
+    bool intsOff;
+    bool ok;
+
+    DRV_EPWM_getState(&pwm);
+    deadband[0] = pwm.risingEdgeDelayCount;
+    deadband[1] = pwm.fallingEdgeDelayCount;
+
+    // 增益由控制中断的安全点写入，关中断取同一次提交的一对值
+    intsOff = Interrupt_disableGlobal();
+    gains[0] = APP_CLA_command.kp;
+    gains[1] = APP_CLA_command.ki;
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+
+    ok = APP_PARAM_write(APP_PARAM_ID_PWM_FREQUENCY, 1U, &pwm.frequencyHz, APP_PARAM_WORDS(pwm.frequencyHz));
+    ok = APP_PARAM_write(APP_PARAM_ID_PWM_DEADBAND, 1U, deadband, APP_PARAM_WORDS(deadband)) && ok;
+    ok = APP_PARAM_write(APP_PARAM_ID_CLA_GAINS, 1U, gains, APP_PARAM_WORDS(gains)) && ok;
+
+    // DRV8316 尚未完成第一次扫描时，保存的寄存器值还未写入器件，快照只是初始化时的读回，
+    // 保留闪存中的旧记录
+    if(APP_DRV8316_hasScanned(APP_DRV8316_DEVICE_0) &&
+       APP_DRV8316_getStatusSnapshot(APP_DRV8316_DEVICE_0, &vars))
+    {
+        regs[0] = vars.ctrlReg02.all;
+        regs[1] = vars.ctrlReg03.all;
+        regs[2] = vars.ctrlReg04.all;
+        regs[3] = vars.ctrlReg05.all;
+        regs[4] = vars.ctrlReg06.all;
+        regs[5] = vars.ctrlReg10.all;
+        ok = APP_PARAM_write(APP_PARAM_ID_DRV8316_CTRL, 1U, regs, APP_PARAM_WORDS(regs)) && ok;
+    }
+    else
+    {
+        ok = false;
+    }
+
+    return ok;
+}
+
+//
+// paramSpaceStart - XCP 参数地址空间：写地址 0 请求 myTask0 保存当前参数，读返回保存成功与失败次数
+//
+static bool paramSpaceStart(bool write, uint32_t address, uint16_t *data, uint16_t words)
+{
+    (void)data;
+
+    // 上一次保存未完成（例如 XCP 等待超时后主机重发）时拒绝
+    if(paramStoreBusy)
+    {
+        return false;
+    }
+
+    if(write ? ((address != 0U) || (words != 1U))
+             : ((address >= MAIN_PARAM_STATUS_WORDS) || (words > (MAIN_PARAM_STATUS_WORDS - address))))
+    {
+        return false;
+    }
+
+    paramSpaceWrite   = write;
+    paramSpaceAddress = (uint16_t)address;
+
+    if(write)
+    {
+        paramStoreBusy = true;
+
+        if(!APP_EVENT_post(APP_EVENT_SRC_PARAM, 0U, 0U))
+        {
+            paramStoreBusy = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//
+// paramSpacePoll - 保存完成后按结果应答；读操作立即完成
+//
+static uint16_t paramSpacePoll(uint16_t *data, uint16_t words)
+{
+    uint16_t i;
+
+    if(paramSpaceWrite)
+    {
+        if(paramStoreBusy)
+        {
+            return APP_XCP_SPACE_BUSY;
+        }
+
+        return paramStoreResult ? APP_XCP_SPACE_DONE : APP_XCP_SPACE_ERROR;
+    }
+
+    for(i = 0U; i < words; i++)
+    {
+        data[i] = paramStoreCount[paramSpaceAddress + i];
+    }
+
+    return APP_XCP_SPACE_DONE;
+}
+
+//
+// startScope - 登记电流环状态通道并按默认配置开始采集，调试器或标定工具可重新配置
+//
+static void startScope(void)
+{
+    bool ok;
+
+    APP_SCOPE_init();
+
+    ok = APP_SCOPE_addChannel(&APP_CLA_status.id, APP_SCOPE_TYPE_FLOAT32, NULL);
+    ok = ok && APP_SCOPE_addChannel(&APP_CLA_status.iq, APP_SCOPE_TYPE_FLOAT32, NULL);
+    ok = ok && APP_SCOPE_addChannel(&APP_CLA_status.vd, APP_SCOPE_TYPE_FLOAT32, NULL);
+    ok = ok && APP_SCOPE_addChannel(&APP_CLA_status.vq, APP_SCOPE_TYPE_FLOAT32, NULL);
+    ok = ok && APP_SCOPE_addChannel(&APP_CLA_status.vdc, APP_SCOPE_TYPE_FLOAT32, NULL);
+
+    if(ok)
+    {
+        (void)APP_SCOPE_arm(&scopeConfig);
+    }
+}
+
+//
+// startCtrl - 注册控制时隙并启动执行器，失败时记录跟踪事件，电流环保持不闭环
+//
+static void startCtrl(void)
+{
+    bool ok;
+
+    APP_CTRL_init();
+
+    ok = APP_CTRL_setSlot(APP_CTRL_SLOT_FAST, &ctrlFastSlot, NULL, 1U, 0U);
+    ok = ok && APP_CTRL_setSlot(APP_CTRL_SLOT_MEDIUM, &ctrlMediumSlot, NULL,
+                                APP_CTRL_DEFAULT_MEDIUM_RATIO, 0U);
+    ok = ok && APP_CTRL_start(APP_CTRL_DEFAULT_PWM_DIVIDER);
+
+    if(!ok)
+    {
+        APP_CLA_setEnabled(false);
+        APP_TRACE_record(MAIN_TRACE_EV_CTRL_START_FAIL, APP_CTRL_DEFAULT_PWM_DIVIDER);
+    }
+}
+
+//
+// ctrlFastSlot - 每个 PWM 周期执行：CLA 任务 1 溢出说明占空比已迟于本周期写入，关闭闭环，
+// 并触发数据记录器，本中断随后记录的采样即触发点；最后把安全点写入的标定值与各任务的
+// 命令一次发布给 CLA，在下一次 CLA 任务开始时整体生效
+//
+static void ctrlFastSlot(void *context)
+{
+    (void)context;
+
+    if(APP_CLA_hasOverflowed() && (APP_CLA_command.enable != 0U))
+    {
+        APP_CLA_setEnabled(false);
+        APP_SCOPE_trigger();
+    }
+
+    APP_CLA_publish();
+}
+
+//
+// ctrlMediumSlot - 每 APP_CTRL_DEFAULT_MEDIUM_RATIO 个周期发布一份一致的电流环状态，
+// 速度环接入后在此执行
+//
+static void ctrlMediumSlot(void *context)
+{
+    (void)context;
+
+    (void)APP_CLA_getStatus(&ctrlStatus);
+}
+
+//
+// captureTelemStatus - 遥测任务组包前调用：中速时隙在控制中断中整体改写 ctrlStatus，
+// 关中断复制，避免一个包混入两次发布的字段
+//
+static void captureTelemStatus(void *context)
+{
+    bool intsOff;
+
+    (void)context;
+
+    intsOff = Interrupt_disableGlobal();
+    telemStatus = ctrlStatus;
+    if(!intsOff)
+    {
+        (void)Interrupt_enableGlobal();
+    }
+}
+
 void ePWMConfigurationTemplate(uint32_t base){
     EPWM_setClockPrescaler(base, EPWM_CLOCK_DIVIDER_4, EPWM_HSCLOCK_DIVIDER_4);	
     EPWM_setTimeBasePeriod(base, 2000);	
@@ -30,6 +30,7 @@ extern "C"
 // 驱动
 #include "spi.h"
 #include "gpio.h"
+#include "sysctl.h"
 
 // **************************************************************************
 // 模块
@@ -52,6 +53,67 @@ extern "C"
 //!
 #define DRV8316_RW_MASK                     (0x8000)
 
+//! \brief 定义校验位掩码
+//!
+#define DRV8316_PARITY_MASK                 (0x0100)
+
+//! \brief 定义应答字中状态字节的掩码
+//!
+#define DRV8316_RESP_STATUS_MASK            (0xFF00)
+
+//! \brief 定义帧表长度，覆盖 6 bit 地址空间的全部 64 个地址，DRV8316_getFrameIndex 的结果不会越界
+//!
+#define DRV8316_FRAME_TABLE_SIZE            (64U)
+
+//! \brief 定义记录错误计数的寄存器数量，覆盖地址 0x00~0x0F
+//!
+#define DRV8316_ERR_COUNT_REGS              (16U)
+
+//! \brief 定义读应答校验失败后的最大重试次数
+//!
+#ifndef DRV8316_RX_RETRY_MAX
+#define DRV8316_RX_RETRY_MAX                (2U)
+#endif
+
+//! \brief 定义 SPI 时序参数（ns），取自 DRV8316 数据手册并留有裕量，可在编译选项中覆盖
+//!
+#ifndef DRV8316_CS_SETUP_NS
+#define DRV8316_CS_SETUP_NS                 (50UL)      //!< nSCS 拉低到首个 SCLK 沿
+#endif
+#ifndef DRV8316_CS_HOLD_NS
+#define DRV8316_CS_HOLD_NS                  (50UL)      //!< 末个 SCLK 沿到 nSCS 拉高
+#endif
+#ifndef DRV8316_CS_IDLE_NS
+#define DRV8316_CS_IDLE_NS                  (400UL)     //!< 两帧之间 nSCS 保持高电平
+#endif
+#ifndef DRV8316_READY_NS
+#define DRV8316_READY_NS                    (1000000UL) //!< 使能后等待器件就绪
+#endif
+
+//! \brief 定义未调用 DRV8316_setTiming 时使用的默认时钟与波特率
+//!
+#define DRV8316_DEFAULT_SYSCLK_HZ           (100000000UL)
+#define DRV8316_DEFAULT_BITRATE_HZ          (1000000UL)
+
+//! \brief 定义 RX FIFO 轮询超时相对一帧时间的倍数
+//!
+#define DRV8316_RX_TIMEOUT_FRAMES           (4UL)
+
+//! \brief 计算 6 bit 地址的奇偶性，结果为编译期常量
+//!
+#define DRV8316_PARITY6(a)                  ((((a) >> 0) ^ ((a) >> 1) ^ ((a) >> 2) ^   \
+                                              ((a) >> 3) ^ ((a) >> 4) ^ ((a) >> 5)) & 1U)
+
+//! \brief 生成数据为 0 的写帧，校验位只覆盖地址
+//!
+#define DRV8316_WRITE_FRAME(a)              ((uint16_t)(((uint16_t)(a) << 9) |           \
+                                              (DRV8316_PARITY6(a) << 8)))
+
+//! \brief 生成读帧，读写位为 1，数据为 0
+//!
+#define DRV8316_READ_FRAME(a)               ((uint16_t)(0x8000U | ((uint16_t)(a) << 9) | \
+                                              ((DRV8316_PARITY6(a) ^ 1U) << 8)))
+
 //
 // 状态寄存器 00
 //
@@ -599,6 +661,28 @@ typedef struct _DRV8316_VARS_t_
 //!
 typedef struct _DRV8316_VARS_t_ *DRV8316VARS_Handle;
 
+//! \brief 定义单帧传输委托函数类型
+//! \details  安装后 DRV8316_transfer 不再直接操作 SPI 外设，而是把每一帧交给
+//!           共享总线的事务管理器发送，由其负责片选、时序与仲裁
+//! \param[in]  context   安装时传入的上下文
+//! \param[in]  ctrlWord  待发送的控制字
+//! \param[out] response  从机应答
+//! \return     true 表示收到应答，false 表示超时
+typedef bool (*DRV8316_TransferFxn)(void *context, uint16_t ctrlWord, uint16_t *response);
+
+//! \brief 定义 SPI 时序参数，由 DRV8316_setTiming 一次性换算
+//! \details  各延时以 SysCtl_delay 的计数值保存，每个计数约 5 个 SYSCLK 周期
+//!
+typedef struct _DRV8316_Timing_
+{
+    uint32_t  csSetupDelay;  //!< nSCS 建立时间对应的延时计数
+    uint32_t  csHoldDelay;   //!< nSCS 保持时间对应的延时计数
+    uint32_t  csIdleDelay;   //!< 帧间 nSCS 高电平时间对应的延时计数
+    uint32_t  readyDelay;    //!< 使能后就绪等待对应的延时计数
+    uint32_t  frameTimeNs;   //!< 一帧 16 bit 的传输时间（ns）
+    uint32_t  rxTimeoutPolls;//!< 等待应答的最大轮询次数
+} DRV8316_Timing;
+
 //! \brief 定义 DRV8316 对象
 //!
 typedef struct _DRV8316_Obj_
@@ -608,6 +692,12 @@ typedef struct _DRV8316_Obj_
     uint32_t  gpioNumber_EN; //!< 连接到 DRV8316 使能引脚的 GPIO
     bool      rxTimeOut;     //!< RX FIFO 的超时标志
     bool      enableTimeOut; //!< DRV8316 使能的超时标志
+    bool      rxError;       //!< 读应答重试后仍校验失败的标志
+    uint16_t  lastStatus;    //!< 最近一次有效应答中的状态字节
+    uint16_t  rxErrorCount[DRV8316_ERR_COUNT_REGS]; //!< 各寄存器读应答校验失败次数
+    DRV8316_Timing timing;   //!< SPI 时序参数
+    DRV8316_TransferFxn transferFxn; //!< 单帧传输委托，为 NULL 时直接访问 SPI
+    void     *transferContext;//!< 单帧传输委托的上下文
 } DRV8316_Obj;
 
 //! \brief 定义 DRV8316 句柄
@@ -631,6 +721,54 @@ typedef  uint16_t    DRV_Word_t;
 //! \return    DRV8316 对象句柄
 extern DRV8316_Handle DRV8316_init(void *pMemory);
 
+//! \brief 预先生成的读帧表，按 6 bit 地址索引
+//!
+extern const uint16_t DRV8316_readFrameTable[DRV8316_FRAME_TABLE_SIZE];
+
+//! \brief 预先生成的写帧表，按 6 bit 地址索引，数据字段为 0
+//!
+extern const uint16_t DRV8316_writeFrameTable[DRV8316_FRAME_TABLE_SIZE];
+
+//! \brief     计算 8 bit 数据的奇偶性
+//! \param[in] data  数据，仅低 8 位有效
+//! \return    1 表示置 1 位数为奇数
+static inline uint16_t DRV8316_parity8(const uint16_t data)
+{
+    uint16_t x = data & DRV8316_DATA_MASK;
+
+    // 折叠为 4 bit 后查 0x6996 真值表
+    x ^= x >> 4;
+
+    return((0x6996U >> (x & 0x0FU)) & 1U);
+} // DRV8316_parity8() 函数结束
+
+//! \brief     由寄存器地址求帧表下标
+//! \param[in] regAddr  寄存器地址（已左移 9 位）
+//! \return    帧表下标
+static inline uint16_t DRV8316_getFrameIndex(const DRV8316_Address_e regAddr)
+{
+    return(((uint16_t)regAddr & DRV8316_ADDR_MASK) >> 9);
+} // DRV8316_getFrameIndex() 函数结束
+
+//! \brief     查表生成读帧
+//! \param[in] regAddr  寄存器地址
+//! \return    控制字
+static inline DRV_Word_t DRV8316_buildReadWord(const DRV8316_Address_e regAddr)
+{
+    return(DRV8316_readFrameTable[DRV8316_getFrameIndex(regAddr)]);
+} // DRV8316_buildReadWord() 函数结束
+
+//! \brief     查表生成写帧，数据部分的奇偶性翻转表中预置的校验位
+//! \param[in] regAddr  寄存器地址
+//! \param[in] data     数据
+//! \return    控制字
+static inline DRV_Word_t DRV8316_buildWriteWord(const DRV8316_Address_e regAddr,
+                                                const uint16_t data)
+{
+    return((DRV8316_writeFrameTable[DRV8316_getFrameIndex(regAddr)] ^
+            (DRV8316_parity8(data) << 8)) | (data & DRV8316_DATA_MASK));
+} // DRV8316_buildWriteWord() 函数结束
+
 //! \brief     构建控制字
 //! \param[in] ctrlMode  控制模式
 //! \param[in] regName   寄存器名称
@@ -641,25 +779,43 @@ static inline DRV_Word_t DRV8316_buildCtrlWord(
                                             const DRV8316_Address_e regAddr,
                                             const uint16_t data)
 {
-    uint16_t p_addr = regAddr;
-    uint16_t p_data = data;
-    uint16_t p_mode = ctrlMode;
+    DRV_Word_t ctrlWord = DRV8316_buildWriteWord(regAddr, data);
 
-    uint16_t calc = (p_mode & 0x8000) | (p_addr & 0x7E00) | (p_data & 0x00FF);
-    uint16_t parity = 0;
-    while(calc)
+    // 读写位置 1 同时翻转校验位
+    if(((uint16_t)ctrlMode & DRV8316_RW_MASK) != 0U)
     {
-        parity ^= (calc & 1);
-        calc >>= 1;
+        ctrlWord ^= (DRV8316_RW_MASK | DRV8316_PARITY_MASK);
     }
 
-    parity <<= 8;
-
-    DRV_Word_t ctrlWord = ctrlMode | regAddr | parity | (data & DRV8316_DATA_MASK);
-
     return(ctrlWord);
 } // DRV8316_buildCtrlWord() 函数结束
 
+//! \brief     校验读应答
+//! \details   应答高字节为 STATUS_0。保留位被置位说明 SDO 线受干扰或悬空；
+//!            SPI_FLT 相对上一次有效应答新出现，说明本次命令帧已被器件判为
+//!            错误帧。定义 DRV8316_RESP_PARITY 时额外要求整字满足偶校验。
+//! \param[in] handle    DRV8316 句柄
+//! \param[in] response  SPI 读到的完整应答字
+//! \return    true 表示应答有效
+extern bool DRV8316_validateResponse(DRV8316_Handle handle, const uint16_t response);
+
+//! \brief     读取指定寄存器的读应答校验失败次数
+//! \param[in] handle   DRV8316 句柄
+//! \param[in] regAddr  寄存器地址
+//! \return    失败次数
+static inline uint16_t DRV8316_getRxErrorCount(DRV8316_Handle handle,
+                                               const DRV8316_Address_e regAddr)
+{
+    DRV8316_Obj *obj = (DRV8316_Obj *)handle;
+    uint16_t index = DRV8316_getFrameIndex(regAddr);
+
+    return((index < DRV8316_ERR_COUNT_REGS) ? obj->rxErrorCount[index] : 0U);
+} // DRV8316_getRxErrorCount() 函数结束
+
+//! \brief     清零全部读应答错误计数与错误标志
+//! \param[in] handle   DRV8316 句柄
+extern void DRV8316_resetRxErrors(DRV8316_Handle handle);
+
 //! \brief     使能 DRV8316
 //! \param[in] handle     DRV8316 句柄
 extern void DRV8316_enable(DRV8316_Handle handle);
@@ -679,6 +835,21 @@ void DRV8316_setGPIOCSNumber(DRV8316_Handle handle,uint32_t gpioNumber);
 //! \param[in] gpioHandle   要使用的 GPIO 编号
 void DRV8316_setGPIOENNumber(DRV8316_Handle handle,uint32_t gpioNumber);
 
+//! \brief     安装单帧传输委托
+//! \details   传入 NULL 恢复直接访问 SPI 外设
+//! \param[in] handle    DRV8316 句柄
+//! \param[in] fxn       传输委托函数
+//! \param[in] context   传给委托函数的上下文
+extern void DRV8316_setTransferFxn(DRV8316_Handle handle, DRV8316_TransferFxn fxn,
+                                   void *context);
+
+//! \brief     根据系统时钟与 SPI 波特率换算时序参数
+//! \details   仅在初始化时调用一次，运行期间的传输直接使用换算结果
+//! \param[in] handle     DRV8316 句柄
+//! \param[in] sysclkHz   CPU 时钟频率（Hz）
+//! \param[in] bitRateHz  SPI 波特率（Hz）
+extern void DRV8316_setTiming(DRV8316_Handle handle, uint32_t sysclkHz, uint32_t bitRateHz);
+
 //! \brief     Resets the enable timeout flag
 //! \param[in] handle   DRV8316 句柄
 static inline void DRV8316_resetEnableTimeout(DRV8316_Handle handle)
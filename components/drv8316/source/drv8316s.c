@@ -6,6 +6,7 @@
 // 引用的头文件
 
 #include <math.h>
+#include <stddef.h>
 
 // **************************************************************************
 // 驱动
@@ -20,12 +21,57 @@
 // **************************************************************************
 // 宏定义
 
+//! \brief 以 8 个连续地址为一组展开帧表
+//!
+#define DRV8316_FRAMES_8(F, b)  F((b) + 0U), F((b) + 1U), F((b) + 2U), F((b) + 3U), \
+                                F((b) + 4U), F((b) + 5U), F((b) + 6U), F((b) + 7U)
+
+//! \brief STATUS_0 中的 SPI 故障位与保留位在应答字中的位置
+//!
+#define DRV8316_RESP_SPI_FLT_BITS   (DRV8316_STAT00_SPI_FLT_BITS << 8)
+#define DRV8316_RESP_RESERVED_BITS  (DRV8316_STAT00_RESERVED_BITS << 8)
+
 // **************************************************************************
 // 全局变量
 
+// 读帧表，编译期生成，位于只读段
+const uint16_t DRV8316_readFrameTable[DRV8316_FRAME_TABLE_SIZE] =
+{
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 0U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 8U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 16U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 24U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 32U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 40U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 48U),
+    DRV8316_FRAMES_8(DRV8316_READ_FRAME, 56U)
+};
+
+// 写帧表，数据字段为 0，写入时按数据奇偶性翻转校验位
+const uint16_t DRV8316_writeFrameTable[DRV8316_FRAME_TABLE_SIZE] =
+{
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 0U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 8U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 16U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 24U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 32U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 40U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 48U),
+    DRV8316_FRAMES_8(DRV8316_WRITE_FRAME, 56U)
+};
+
 // **************************************************************************
 // 函数原型
 
+//! \brief     将纳秒换算为 SysCtl_delay 计数
+//! \details   SysCtl_delay(count) 耗时 5 * count + 9 个 SYSCLK 周期，结果向上取整
+static uint32_t DRV8316_nsToDelayCount(const uint32_t ns, const uint32_t sysclkHz)
+{
+    uint32_t cycles = ((ns * (sysclkHz / 1000000UL)) + 999UL) / 1000UL;
+
+    return((cycles > 9UL) ? ((cycles - 9UL + 4UL) / 5UL) : 0UL);
+} // DRV8316_nsToDelayCount() 函数结束
+
 DRV8316_Handle DRV8316_init(void *pMemory)
 {
     DRV8316_Handle handle;
@@ -35,25 +81,65 @@ DRV8316_Handle DRV8316_init(void *pMemory)
 
     DRV8316_resetRxTimeout(handle);
     DRV8316_resetEnableTimeout(handle);
+    DRV8316_resetRxErrors(handle);
+    DRV8316_setTiming(handle, DRV8316_DEFAULT_SYSCLK_HZ, DRV8316_DEFAULT_BITRATE_HZ);
+    DRV8316_setTransferFxn(handle, NULL, NULL);
 
     return(handle);
 } // DRV8316_init() 函数结束
 
+void DRV8316_setTransferFxn(DRV8316_Handle handle, DRV8316_TransferFxn fxn,
+                            void *context)
+{
+    DRV8316_Obj *obj = (DRV8316_Obj *)handle;
+
+    obj->transferFxn     = fxn;
+    obj->transferContext = context;
+
+    return;
+} // DRV8316_setTransferFxn() 函数结束
+
+void DRV8316_setTiming(DRV8316_Handle handle, uint32_t sysclkHz, uint32_t bitRateHz)
+{
+    DRV8316_Obj *obj = (DRV8316_Obj *)handle;
+    uint32_t frameCycles;
+
+    if(sysclkHz < 1000000UL)
+    {
+        sysclkHz = DRV8316_DEFAULT_SYSCLK_HZ;
+    }
+
+    if(bitRateHz < 1000UL)
+    {
+        bitRateHz = DRV8316_DEFAULT_BITRATE_HZ;
+    }
+
+    obj->timing.csSetupDelay = DRV8316_nsToDelayCount(DRV8316_CS_SETUP_NS, sysclkHz);
+    obj->timing.csHoldDelay  = DRV8316_nsToDelayCount(DRV8316_CS_HOLD_NS, sysclkHz);
+    obj->timing.csIdleDelay  = DRV8316_nsToDelayCount(DRV8316_CS_IDLE_NS, sysclkHz);
+    obj->timing.readyDelay   = DRV8316_nsToDelayCount(DRV8316_READY_NS, sysclkHz);
+
+    // 16 bit 帧时间，波特率以 kHz 参与运算避免 32 位溢出
+    obj->timing.frameTimeNs = (16UL * 1000000UL) / (bitRateHz / 1000UL);
+
+    // 每次轮询至少耗费一个周期，以帧时间对应的周期数为单位即留有足够裕量
+    frameCycles = (obj->timing.frameTimeNs * (sysclkHz / 1000000UL)) / 1000UL;
+    obj->timing.rxTimeoutPolls = frameCycles * DRV8316_RX_TIMEOUT_FRAMES;
+
+    return;
+} // DRV8316_setTiming() 函数结束
+
 void DRV8316_enable(DRV8316_Handle handle)
 {
     DRV8316_Obj *obj = (DRV8316_Obj *)handle;
     volatile uint16_t enableWaitTimeOut;
-    uint16_t n = 0;
 
     // 使能 DRV8316
     GPIO_writePin(obj->gpioNumber_EN, 0);
     GPIO_writePin(obj->gpioNumber_EN, 0);
 
     // 等待 DRV8316 完成启动流程
-    for(n = 0; n < 0xffff; n++)
-    {
-        __asm(" NOP");
-    }
+    SysCtl_delay(obj->timing.readyDelay);
 
     enableWaitTimeOut = 0;
 
@@ -68,10 +154,7 @@ void DRV8316_enable(DRV8316_Handle handle)
     }
 
     // 等待 DRV8316 完成启动流程
-    for(n = 0; n < 0xffff; n++)
-    {
-        __asm(" NOP");
-    }
+    SysCtl_delay(obj->timing.readyDelay);
 
     // 向该寄存器写入 011b 以解锁全部寄存器
     DRV8316_writeSPI(handle,  DRV8316_ADDRESS_CONTROL_1, 0x03);
@@ -160,7 +243,7 @@ void DRV8316_setupSPI(DRV8316_Handle handle,
     // 读取控制寄存器 3
     drvRegAddr = DRV8316_ADDRESS_CONTROL_3;
     drvDataNew = DRV8316_readSPI(handle, drvRegAddr);
-    drv8316Vars->ctrlReg02.all = drvDataNew;
+    drv8316Vars->ctrlReg03.all = drvDataNew;
 
     // 读取控制寄存器 4
     drvRegAddr = DRV8316_ADDRESS_CONTROL_4;
@@ -185,120 +268,160 @@ void DRV8316_setupSPI(DRV8316_Handle handle,
     return;
 } // DRV8316_setupSPI() 函数结束
 
-uint16_t DRV8316_readSPI(DRV8316_Handle handle,
-                         const DRV8316_Address_e regAddr)
+void DRV8316_resetRxErrors(DRV8316_Handle handle)
 {
     DRV8316_Obj *obj = (DRV8316_Obj *)handle;
-    uint16_t ctrlWord;
     uint16_t n;
-    const uint16_t data = 0;
-    volatile uint16_t readWord;
-    volatile uint16_t WaitTimeOut = 0;
 
-    volatile SPI_RxFIFOLevel RxFifoCnt = SPI_FIFO_RXEMPTY;
+    obj->rxError    = false;
+    obj->lastStatus = 0;
 
-    // build the control word
-    ctrlWord = (uint16_t)DRV8316_buildCtrlWord(DRV8316_CTRLMODE_READ, regAddr, data);
+    for(n = 0; n < DRV8316_ERR_COUNT_REGS; n++)
+    {
+        obj->rxErrorCount[n] = 0;
+    }
 
-#ifdef DRV_CS_GPIO
-    GPIO_writePin(obj->gpioNumber_CS, 0);
-    GPIO_writePin(obj->gpioNumber_CS, 0);
-#endif  // DRV_CS_GPIO
+    return;
+} // DRV8316_resetRxErrors() 函数结束
+
+bool DRV8316_validateResponse(DRV8316_Handle handle, const uint16_t response)
+{
+    DRV8316_Obj *obj = (DRV8316_Obj *)handle;
 
-    // wait for registers to update
-    for(n = 0; n < 0x08; n++)
+    // 保留位恒为 0，SDO 悬空或受干扰时通常读到全 1
+    if((response & DRV8316_RESP_RESERVED_BITS) != 0)
     {
-        __asm(" NOP");
+        return(false);
     }
 
-    // reset the Rx fifo pointer to zero
-    SPI_resetRxFIFO(obj->spiHandle);
-    SPI_enableFIFO(obj->spiHandle);
-
-    // wait for registers to update
-    for(n = 0; n < 0x20; n++)
+    // SPI_FLT 新出现，说明器件判定本次命令帧无效
+    if(((response & DRV8316_RESP_SPI_FLT_BITS) != 0) &&
+       ((obj->lastStatus & DRV8316_RESP_SPI_FLT_BITS) == 0))
     {
-        __asm(" NOP");
+        obj->lastStatus = response & DRV8316_RESP_STATUS_MASK;
+        return(false);
     }
 
-    // write the command
-    SPI_writeDataBlockingNonFIFO(obj->spiHandle, ctrlWord);
+#ifdef DRV8316_RESP_PARITY
+    if((DRV8316_parity8(response >> 8) ^ DRV8316_parity8(response)) != 0)
+    {
+        return(false);
+    }
+#endif  // DRV8316_RESP_PARITY
+
+    obj->lastStatus = response & DRV8316_RESP_STATUS_MASK;
+
+    return(true);
+} // DRV8316_validateResponse() 函数结束
+
+//! \brief     完成一帧 SPI 传输
+//! \details   发送后等待应答进入 RX FIFO，即本帧 16 bit 已全部移出，随后满足
+//!            nSCS 保持时间再释放片选。轮询次数按一帧时间换算，超时即退出。
+//! \param[in]  obj       DRV8316 对象
+//! \param[in]  ctrlWord  控制字
+//! \param[out] response  应答字
+//! \return    true 表示在超时前收到应答
+static bool DRV8316_transfer(DRV8316_Obj *obj, const uint16_t ctrlWord,
+                             uint16_t *response)
+{
+    uint32_t polls = 0;
+    bool received = true;
 
-    // wait for two words to populate the RX fifo, or a wait timeout will occur
-    while(RxFifoCnt < SPI_FIFO_RX1)
+    // 已委托给总线事务管理器时，片选与帧间时序由管理器负责
+    if(obj->transferFxn != NULL)
     {
-        RxFifoCnt = SPI_getRxFIFOStatus(obj->spiHandle);
+        received = obj->transferFxn(obj->transferContext, ctrlWord, response);
 
-        if(++WaitTimeOut > 0xfffe)
+        if(!received)
         {
             obj->rxTimeOut = true;
         }
+
+        return(received);
     }
 
-    WaitTimeOut = 0xffff;
+    // 先清空 RX FIFO，片选拉低后无需再等待寄存器更新
+    SPI_resetRxFIFO(obj->spiHandle);
+    SPI_enableFIFO(obj->spiHandle);
+
+#ifdef DRV_CS_GPIO
+    GPIO_writePin(obj->gpioNumber_CS, 0);
+    SysCtl_delay(obj->timing.csSetupDelay);
+#endif  // DRV_CS_GPIO
+
+    // write the command
+    SPI_writeDataBlockingNonFIFO(obj->spiHandle, ctrlWord);
 
-    // wait for registers to update
-    for(n = 0; n < 0x100; n++)
+    // 应答进入 RX FIFO 即表示本帧传输完成
+    while(SPI_getRxFIFOStatus(obj->spiHandle) < SPI_FIFO_RX1)
     {
-        __asm(" NOP");
+        if(++polls >= obj->timing.rxTimeoutPolls)
+        {
+            obj->rxTimeOut = true;
+            received = false;
+            break;
+        }
     }
 
 #ifdef DRV_CS_GPIO
-    GPIO_writePin(obj->gpioNumber_CS, 1);
+    SysCtl_delay(obj->timing.csHoldDelay);
     GPIO_writePin(obj->gpioNumber_CS, 1);
 #endif  // DRV_CS_GPIO
 
     // Read the word
-    readWord = SPI_readDataNonBlocking(obj->spiHandle);
+    *response = SPI_readDataNonBlocking(obj->spiHandle);
 
-    return(readWord & DRV8316_DATA_MASK);
-} // DRV8316_readSPI() 函数结束
+    // 保证下一帧之前 nSCS 的最短高电平时间
+    SysCtl_delay(obj->timing.csIdleDelay);
 
+    return(received);
+} // DRV8316_transfer() 函数结束
 
-void DRV8316_writeSPI(DRV8316_Handle handle, const DRV8316_Address_e regAddr,
-                      const uint16_t data)
+uint16_t DRV8316_readSPI(DRV8316_Handle handle,
+                         const DRV8316_Address_e regAddr)
 {
     DRV8316_Obj *obj = (DRV8316_Obj *)handle;
     uint16_t ctrlWord;
-    uint16_t n;
+    uint16_t readWord = 0;
+    uint16_t index = DRV8316_getFrameIndex(regAddr);
+    uint16_t attempt;
 
-    // build the control word
-    ctrlWord = (uint16_t)DRV8316_buildCtrlWord(DRV8316_CTRLMODE_WRITE, regAddr, data);
+    // 读帧查表获得
+    ctrlWord = DRV8316_buildReadWord(regAddr);
 
-#ifdef DRV_CS_GPIO
-    GPIO_writePin(obj->gpioNumber_CS, 0);
-    GPIO_writePin(obj->gpioNumber_CS, 0);
-#endif  // DRV_CS_GPIO
-
-    // wait for GPIO
-    for(n = 0; n < 0x08; n++)
+    // 应答超时或校验失败时重发，同一寄存器的失败次数单独累计
+    for(attempt = 0; attempt <= DRV8316_RX_RETRY_MAX; attempt++)
     {
-        __asm(" NOP");
+        if(DRV8316_transfer(obj, ctrlWord, &readWord) &&
+           DRV8316_validateResponse(handle, readWord))
+        {
+            return(readWord & DRV8316_DATA_MASK);
+        }
+
+        if((index < DRV8316_ERR_COUNT_REGS) && (obj->rxErrorCount[index] < 0xFFFF))
+        {
+            obj->rxErrorCount[index]++;
+        }
     }
 
-    // reset the Rx fifo pointer to zero
-    SPI_resetRxFIFO(obj->spiHandle);
-    SPI_enableFIFO(obj->spiHandle);
+    obj->rxError = true;
 
-    // wait for registers to update
-    for(n = 0; n < 0x40; n++)
-    {
-        __asm(" NOP");
-    }
+    return(readWord & DRV8316_DATA_MASK);
+} // DRV8316_readSPI() 函数结束
 
-    // write the command
-    SPI_writeDataBlockingNonFIFO(obj->spiHandle, ctrlWord);
 
-    // wait for registers to update
-    for(n = 0; n < 0x100; n++)
-    {
-        __asm(" NOP");
-    }
+void DRV8316_writeSPI(DRV8316_Handle handle, const DRV8316_Address_e regAddr,
+                      const uint16_t data)
+{
+    DRV8316_Obj *obj = (DRV8316_Obj *)handle;
+    uint16_t ctrlWord;
+    uint16_t response;
 
-#ifdef DRV_CS_GPIO
-    GPIO_writePin(obj->gpioNumber_CS, 1);
-    GPIO_writePin(obj->gpioNumber_CS, 1);
-#endif  // DRV_CS_GPIO
+    // 写帧查表并按数据奇偶性修正校验位
+    ctrlWord = DRV8316_buildWriteWord(regAddr, data);
+
+    // 写操作的应答仅用于确认传输完成
+    (void)DRV8316_transfer(obj, ctrlWord, &response);
 
     return;
 }  // DRV8316_writeSPI() 函数结束
@@ -353,7 +476,7 @@ void DRV8316_writeData(DRV8316_Handle handle, DRV8316_VARS_t *drv8316Vars)
     if(drv8316Vars->manWriteCmd)
     {
         // Custom Write
-        drvRegAddr = (DRV8316_Address_e)(drv8316Vars->manWriteAddr << 11);
+        drvRegAddr = (DRV8316_Address_e)(drv8316Vars->manWriteAddr << 9);
         drvDataNew = drv8316Vars->manWriteData;
         DRV8316_writeSPI(handle, drvRegAddr, drvDataNew);
 
@@ -428,7 +551,7 @@ void DRV8316_readData(DRV8316_Handle handle, DRV8316_VARS_t *drv8316Vars)
     if(drv8316Vars->manReadCmd)
     {
         // Custom Read
-        drvRegAddr = (DRV8316_Address_e)(drv8316Vars->manReadAddr << 11);
+        drvRegAddr = (DRV8316_Address_e)(drv8316Vars->manReadAddr << 9);
         drvDataNew = DRV8316_readSPI(handle, drvRegAddr);
         drv8316Vars->manReadData = drvDataNew;
 
@@ -77,7 +77,7 @@
        .global _sincos_fastRTS
        .ref    _FPUsinTable
        .ref    _FPUcosTable
-       .text
+       .sect   "hotpath"           ; hot path, copied to RAM at boot
 _sincos_fastRTS:                     ; On entry: R0H = Radian, XAR4 = PtrSin, XAR5 = PtrCos
         MOVIZ     R1H,#0x42A2        ; R1H = 512/(2*pi) = 512/6.28318531 = 81.4873309
         MOVXI     R1H,#0xF983
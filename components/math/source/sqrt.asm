@@ -57,7 +57,7 @@
 
         .page
         .global     _sqrt_fastRTS
-        .text
+        .sect   "hotpath"           ; hot path, copied to RAM at boot
 
 _sqrt_fastRTS:
                                         ; R0H = X on entry
@@ -0,0 +1,70 @@
+/**
+ * @file can_bus_mock.h
+ * @brief DRV_CAN_PORT_* 的主机实现：按位时间推进的单总线模型。
+ *
+ * 模型包含 32 个消息对象、按 ID 仲裁的总线与一个可注入报文的外部节点：
+ *  - 本节点的待发邮箱中编号最小的一个参与仲裁，与外部节点队首的帧按 ID 比较，
+ *    胜者占用 DRV_CAN_frameBits 位时间；
+ *  - 接收按 ID、掩码与 IDE 位验收，FIFO 组中存入第一个空邮箱，组满时覆盖最后一个
+ *    邮箱并置报文丢失；
+ *  - 接收“中断”在存入后立即执行，读出顺序与 INT0ID 一致（编号小者优先），可暂时
+ *    屏蔽以模拟中断延迟；
+ *  - 回环模式下本节点发出的帧只被自己接收，外部节点的帧不进入；
+ *  - 故障注入使控制器进入总线关闭，故障解除后须调用恢复并经过 128 × 11 位才回到总线。
+ */
+
+#ifndef CAN_BUS_MOCK_H
+#define CAN_BUS_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_can.h"
+
+/** 外部节点发送队列深度。 */
+#define CAN_BUS_MOCK_FOREIGN_DEPTH      (256U)
+
+/** 总线日志长度。 */
+#define CAN_BUS_MOCK_LOG_SIZE           (4096U)
+
+/** 总线关闭恢复所需的位时间。 */
+#define CAN_BUS_MOCK_RECOVERY_BITS      (128U * 11U)
+
+/**
+ * @brief 总线上完成的一帧。
+ */
+typedef struct
+{
+    uint32_t id;
+    uint32_t endBit;                /**< 帧结束时的总线时间（位）。 */
+    uint16_t mailbox;               /**< 本节点发出时为邮箱号，外部节点为 0。 */
+} CAN_BUS_MOCK_Entry;
+
+/** 清空模型状态与日志。 */
+void CAN_BUS_MOCK_reset(void);
+
+/** 推进总线时间。 */
+void CAN_BUS_MOCK_run(uint32_t bits);
+
+/** 外部节点排队发送一帧。 */
+bool CAN_BUS_MOCK_inject(const DRV_CAN_Frame *frame);
+
+/** 外部节点队列中尚未发出的帧数。 */
+uint16_t CAN_BUS_MOCK_foreignPending(void);
+
+/** 屏蔽或恢复接收中断，恢复时立即读出挂起的邮箱。 */
+void CAN_BUS_MOCK_setIsrEnabled(bool enabled);
+
+/** 注入或解除总线故障。 */
+void CAN_BUS_MOCK_setFault(bool fault);
+
+/** 返回总线日志与条目数。 */
+const CAN_BUS_MOCK_Entry *CAN_BUS_MOCK_log(uint16_t *count);
+
+/** 清空总线日志。 */
+void CAN_BUS_MOCK_clearLog(void);
+
+/** 返回恢复请求次数。 */
+uint16_t CAN_BUS_MOCK_recoveries(void);
+
+#endif /* CAN_BUS_MOCK_H */
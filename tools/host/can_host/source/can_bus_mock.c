@@ -0,0 +1,420 @@
+/**
+ * @file can_bus_mock.c
+ * @brief 单总线模型上的 DRV_CAN_PORT_* 实现。
+ */
+
+#include <string.h>
+
+#include "can_bus_mock.h"
+
+/**
+ * @brief 消息对象。
+ */
+typedef struct
+{
+    bool     valid;
+    bool     transmit;
+    bool     endOfBlock;            /**< FIFO 组的最后一个邮箱。 */
+    bool     pending;               /**< 发送请求。 */
+    bool     newData;
+    bool     lost;
+    uint32_t id;
+    uint32_t mask;
+    uint16_t length;
+    uint16_t data[8];
+} CAN_BUS_MOCK_Mailbox;
+
+static CAN_BUS_MOCK_Mailbox s_mailboxes[DRV_CAN_MAILBOXES + 1U];
+
+static DRV_CAN_Frame s_foreign[CAN_BUS_MOCK_FOREIGN_DEPTH];
+static uint16_t s_foreignHead = 0U;
+static uint16_t s_foreignTail = 0U;
+
+static CAN_BUS_MOCK_Entry s_log[CAN_BUS_MOCK_LOG_SIZE];
+static uint16_t s_logCount = 0U;
+
+static bool     s_loopback = false;
+static bool     s_enabled = false;
+static bool     s_isrEnabled = true;
+static bool     s_busOff = false;
+static bool     s_fault = false;
+static uint32_t s_recoverBits = 0U;
+static uint16_t s_recoveries = 0U;
+static uint32_t s_time = 0U;
+
+/** 正在总线上传输的帧。 */
+static bool          s_active = false;
+static DRV_CAN_Frame s_current;
+static uint16_t      s_currentMailbox = 0U;
+static uint32_t      s_remaining = 0U;
+
+static uint32_t CAN_BUS_MOCK_key(uint32_t id)
+{
+    if((id & DRV_CAN_ID_EXTENDED) != 0U)
+    {
+        return ((id & DRV_CAN_ID_EXT_MASK) << 1) | 1U;
+    }
+
+    return (id & DRV_CAN_ID_STD_MASK) << 19;
+}
+
+void CAN_BUS_MOCK_reset(void)
+{
+    memset(s_mailboxes, 0, sizeof(s_mailboxes));
+    s_foreignHead = 0U;
+    s_foreignTail = 0U;
+    s_logCount    = 0U;
+    s_loopback    = false;
+    s_enabled     = false;
+    s_isrEnabled  = true;
+    s_busOff      = false;
+    s_fault       = false;
+    s_recoverBits = 0U;
+    s_recoveries  = 0U;
+    s_time        = 0U;
+    s_active      = false;
+}
+
+/**
+ * @brief 模拟接收中断：按邮箱编号读出全部新数据。
+ */
+static void CAN_BUS_MOCK_isr(void)
+{
+    uint16_t mailbox;
+
+    for(mailbox = 1U; mailbox <= DRV_CAN_MAILBOXES; mailbox++)
+    {
+        CAN_BUS_MOCK_Mailbox *object = &s_mailboxes[mailbox];
+        DRV_CAN_Frame frame;
+
+        if(!object->valid || object->transmit || !object->newData)
+        {
+            continue;
+        }
+
+        frame.id     = object->id;
+        frame.length = object->length;
+        memcpy(frame.data, object->data, sizeof(frame.data));
+        DRV_CAN_pushRx(&frame, object->lost);
+
+        object->newData = false;
+        object->lost    = false;
+    }
+}
+
+/**
+ * @brief 按验收规则把一帧存入接收邮箱。
+ */
+static void CAN_BUS_MOCK_deliver(const DRV_CAN_Frame *frame)
+{
+    CAN_BUS_MOCK_Mailbox *target = NULL;
+    CAN_BUS_MOCK_Mailbox *last = NULL;
+    uint16_t mailbox;
+
+    for(mailbox = 1U; mailbox <= DRV_CAN_MAILBOXES; mailbox++)
+    {
+        CAN_BUS_MOCK_Mailbox *object = &s_mailboxes[mailbox];
+
+        if(!object->valid || object->transmit ||
+           (((frame->id ^ object->id) & (object->mask | DRV_CAN_ID_EXTENDED)) != 0U))
+        {
+            continue;
+        }
+
+        if(!object->newData)
+        {
+            target = object;
+            break;
+        }
+
+        last = object;
+
+        if(object->endOfBlock)
+        {
+            break;
+        }
+    }
+
+    if(target == NULL)
+    {
+        if(last == NULL)
+        {
+            return;
+        }
+
+        target = last;
+        target->lost = true;
+    }
+
+    target->length  = frame->length;
+    target->newData = true;
+    memcpy(target->data, frame->data, sizeof(target->data));
+
+    /* 接收邮箱的 ID 位在掩码为 0 的位置上记录实际收到的值。 */
+    target->id = frame->id;
+
+    if(s_isrEnabled)
+    {
+        CAN_BUS_MOCK_isr();
+    }
+}
+
+static bool CAN_BUS_MOCK_pickNext(void)
+{
+    uint16_t own = 0U;
+    bool foreign = (s_foreignHead != s_foreignTail) && !s_loopback;
+    uint16_t mailbox;
+
+    if(s_enabled && !s_busOff)
+    {
+        for(mailbox = 1U; mailbox <= DRV_CAN_MAILBOXES; mailbox++)
+        {
+            if(s_mailboxes[mailbox].valid && s_mailboxes[mailbox].transmit && s_mailboxes[mailbox].pending)
+            {
+                own = mailbox;
+                break;
+            }
+        }
+    }
+
+    if((own != 0U) &&
+       (!foreign || (CAN_BUS_MOCK_key(s_mailboxes[own].id) <
+                     CAN_BUS_MOCK_key(s_foreign[s_foreignTail % CAN_BUS_MOCK_FOREIGN_DEPTH].id))))
+    {
+        CAN_BUS_MOCK_Mailbox *object = &s_mailboxes[own];
+
+        s_current.id     = object->id;
+        s_current.length = object->length;
+        memcpy(s_current.data, object->data, sizeof(s_current.data));
+        s_currentMailbox = own;
+    }
+    else if(foreign)
+    {
+        s_current        = s_foreign[s_foreignTail % CAN_BUS_MOCK_FOREIGN_DEPTH];
+        s_currentMailbox = 0U;
+    }
+    else
+    {
+        return false;
+    }
+
+    s_active    = true;
+    s_remaining = DRV_CAN_frameBits(s_current.id, s_current.length);
+
+    return true;
+}
+
+static void CAN_BUS_MOCK_complete(void)
+{
+    s_active = false;
+
+    if(s_logCount < CAN_BUS_MOCK_LOG_SIZE)
+    {
+        s_log[s_logCount].id      = s_current.id;
+        s_log[s_logCount].endBit  = s_time;
+        s_log[s_logCount].mailbox = s_currentMailbox;
+        s_logCount++;
+    }
+
+    if(s_currentMailbox != 0U)
+    {
+        s_mailboxes[s_currentMailbox].pending = false;
+
+        if(s_loopback)
+        {
+            CAN_BUS_MOCK_deliver(&s_current);
+        }
+    }
+    else
+    {
+        s_foreignTail++;
+
+        if(s_enabled && !s_busOff)
+        {
+            CAN_BUS_MOCK_deliver(&s_current);
+        }
+    }
+}
+
+static void CAN_BUS_MOCK_advance(uint32_t bits)
+{
+    s_time += bits;
+
+    if(s_busOff && !s_fault && (s_recoverBits > 0U))
+    {
+        s_recoverBits = (bits >= s_recoverBits) ? 0U : (s_recoverBits - bits);
+
+        if(s_recoverBits == 0U)
+        {
+            s_busOff = false;
+        }
+    }
+}
+
+void CAN_BUS_MOCK_run(uint32_t bits)
+{
+    while(bits > 0U)
+    {
+        uint32_t step;
+
+        if(!s_active && !CAN_BUS_MOCK_pickNext())
+        {
+            CAN_BUS_MOCK_advance(bits);
+            return;
+        }
+
+        step = (bits < s_remaining) ? bits : s_remaining;
+        CAN_BUS_MOCK_advance(step);
+        s_remaining -= step;
+        bits -= step;
+
+        if(s_remaining == 0U)
+        {
+            CAN_BUS_MOCK_complete();
+        }
+    }
+}
+
+bool CAN_BUS_MOCK_inject(const DRV_CAN_Frame *frame)
+{
+    if((uint16_t)(s_foreignHead - s_foreignTail) >= CAN_BUS_MOCK_FOREIGN_DEPTH)
+    {
+        return false;
+    }
+
+    s_foreign[s_foreignHead % CAN_BUS_MOCK_FOREIGN_DEPTH] = *frame;
+    s_foreignHead++;
+
+    return true;
+}
+
+uint16_t CAN_BUS_MOCK_foreignPending(void)
+{
+    return (uint16_t)(s_foreignHead - s_foreignTail);
+}
+
+void CAN_BUS_MOCK_setIsrEnabled(bool enabled)
+{
+    s_isrEnabled = enabled;
+
+    if(enabled)
+    {
+        CAN_BUS_MOCK_isr();
+    }
+}
+
+void CAN_BUS_MOCK_setFault(bool fault)
+{
+    s_fault = fault;
+
+    if(fault)
+    {
+        s_busOff      = true;
+        s_recoverBits = 0U;
+
+        /* 正在发送的本节点帧被错误帧打断，请求保留。 */
+        if(s_active && (s_currentMailbox != 0U))
+        {
+            s_active = false;
+        }
+    }
+}
+
+const CAN_BUS_MOCK_Entry *CAN_BUS_MOCK_log(uint16_t *count)
+{
+    *count = s_logCount;
+
+    return s_log;
+}
+
+void CAN_BUS_MOCK_clearLog(void)
+{
+    s_logCount = 0U;
+}
+
+uint16_t CAN_BUS_MOCK_recoveries(void)
+{
+    return s_recoveries;
+}
+
+bool DRV_CAN_PORT_init(uint32_t bitRate, bool loopback)
+{
+    (void)bitRate;
+
+    memset(s_mailboxes, 0, sizeof(s_mailboxes));
+    s_loopback = loopback;
+    s_enabled  = false;
+    s_active   = false;
+
+    return true;
+}
+
+void DRV_CAN_PORT_setupTx(uint16_t mailbox, uint32_t id, uint16_t length)
+{
+    CAN_BUS_MOCK_Mailbox *object = &s_mailboxes[mailbox];
+
+    memset(object, 0, sizeof(*object));
+    object->valid    = true;
+    object->transmit = true;
+    object->id       = id;
+    object->length   = length;
+}
+
+void DRV_CAN_PORT_setupRx(uint16_t mailbox, uint32_t id, uint32_t mask, bool fifo)
+{
+    CAN_BUS_MOCK_Mailbox *object = &s_mailboxes[mailbox];
+
+    memset(object, 0, sizeof(*object));
+    object->valid      = true;
+    object->endOfBlock = !fifo;
+    object->id         = id;
+    object->mask       = mask & DRV_CAN_ID_EXT_MASK;
+}
+
+void DRV_CAN_PORT_enable(void)
+{
+    s_enabled = true;
+}
+
+void DRV_CAN_PORT_transmit(uint16_t mailbox, const uint16_t *data, uint16_t length)
+{
+    CAN_BUS_MOCK_Mailbox *object = &s_mailboxes[mailbox];
+    uint16_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        object->data[i] = data[i];
+    }
+
+    object->pending = true;
+}
+
+uint32_t DRV_CAN_PORT_getTxPending(void)
+{
+    uint32_t pending = 0U;
+    uint16_t mailbox;
+
+    for(mailbox = 1U; mailbox <= DRV_CAN_MAILBOXES; mailbox++)
+    {
+        if(s_mailboxes[mailbox].pending)
+        {
+            pending |= 1UL << (mailbox - 1U);
+        }
+    }
+
+    return pending;
+}
+
+uint16_t DRV_CAN_PORT_getBusState(void)
+{
+    return s_busOff ? (DRV_CAN_BUS_OFF | DRV_CAN_BUS_PASSIVE | DRV_CAN_BUS_WARNING) : 0U;
+}
+
+void DRV_CAN_PORT_recover(void)
+{
+    if(s_busOff)
+    {
+        s_recoverBits = CAN_BUS_MOCK_RECOVERY_BITS;
+        s_recoveries++;
+    }
+}
@@ -0,0 +1,461 @@
+/**
+ * @file can_host_main.c
+ * @brief 在总线模型上运行 drv_can.c，检查仲裁顺序、周期调度、验收过滤、FIFO、
+ *        接收溢出、限流与总线关闭恢复。任一检查失败时返回非零值。
+ *
+ * 每个 tick 为 1 ms：先调用 DRV_CAN_service，再推进 500 位总线时间（500 kbit/s）。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "drv_can.h"
+#include "can_bus_mock.h"
+
+#define SIM_TICK_HZ         (1000U)
+#define SIM_BITS_PER_TICK   (DRV_CAN_BITRATE / SIM_TICK_HZ)
+
+static unsigned int s_failures = 0U;
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+static void SIM_setup(void)
+{
+    CAN_BUS_MOCK_reset();
+    DRV_CAN_init(SIM_TICK_HZ);
+}
+
+static void SIM_run(uint32_t ticks)
+{
+    uint32_t i;
+
+    for(i = 0U; i < ticks; i++)
+    {
+        DRV_CAN_service();
+        CAN_BUS_MOCK_run(SIM_BITS_PER_TICK);
+    }
+}
+
+static void SIM_inject(uint32_t id, uint16_t length, uint16_t first)
+{
+    DRV_CAN_Frame frame;
+    uint16_t i;
+
+    frame.id     = id;
+    frame.length = length;
+
+    for(i = 0U; i < 8U; i++)
+    {
+        frame.data[i] = (uint16_t)(first + i) & 0xFFU;
+    }
+
+    (void)CAN_BUS_MOCK_inject(&frame);
+}
+
+/**
+ * @brief 统计日志中本节点发出的某个 ID 的帧数，id 为 0 时统计全部本节点帧。
+ */
+static uint32_t SIM_countOwn(uint32_t id, uint32_t *bits)
+{
+    uint16_t count;
+    const CAN_BUS_MOCK_Entry *log = CAN_BUS_MOCK_log(&count);
+    uint32_t frames = 0U;
+    uint16_t i;
+
+    if(bits != NULL)
+    {
+        *bits = 0U;
+    }
+
+    for(i = 0U; i < count; i++)
+    {
+        if((log[i].mailbox != 0U) && ((id == 0U) || (log[i].id == id)))
+        {
+            frames++;
+
+            if(bits != NULL)
+            {
+                /* 日志不记长度，本测试中的帧均为 8 字节。 */
+                *bits += DRV_CAN_frameBits(log[i].id, 8U);
+            }
+        }
+    }
+
+    return frames;
+}
+
+static void testFrameBits(void)
+{
+    SIM_check(DRV_CAN_frameBits(0x123U, 0U) == 55U, "standard frame, 0 bytes");
+    SIM_check(DRV_CAN_frameBits(0x123U, 8U) == 135U, "standard frame, 8 bytes");
+    SIM_check(DRV_CAN_frameBits(0x123U | DRV_CAN_ID_EXTENDED, 8U) == 160U, "extended frame, 8 bytes");
+}
+
+static void testPriority(void)
+{
+    static const uint32_t expected[] =
+    {
+        0x100U, (0x100UL << 18) | DRV_CAN_ID_EXTENDED, 0x180U, 0x200U, 0x300U
+    };
+    const CAN_BUS_MOCK_Entry *log;
+    uint16_t count;
+    uint16_t i;
+    bool order = true;
+
+    SIM_setup();
+
+    /* 登记顺序与优先级无关；扩展帧的基本 ID 与 0x100 相同，仲裁时排在标准帧之后。 */
+    (void)DRV_CAN_addTxMessage(0x300U, 8U, 10U);
+    (void)DRV_CAN_addTxMessage((0x100UL << 18) | DRV_CAN_ID_EXTENDED, 8U, 10U);
+    (void)DRV_CAN_addTxMessage(0x100U, 8U, 10U);
+    (void)DRV_CAN_addTxMessage(0x200U, 8U, 10U);
+    SIM_check(DRV_CAN_start(false), "priority: start");
+
+    /* 外部节点的 0x180 同时等待发送。 */
+    SIM_inject(0x180U, 8U, 0U);
+    SIM_run(3U);
+
+    log = CAN_BUS_MOCK_log(&count);
+    SIM_check(count == 5U, "priority: five frames on the bus");
+
+    for(i = 0U; (i < count) && (i < 5U); i++)
+    {
+        order = order && (log[i].id == expected[i]);
+    }
+
+    SIM_check(order, "priority: bus order follows identifiers");
+    SIM_check((count > 0U) && (log[0].mailbox == 1U), "priority: lowest identifier in mailbox 1");
+    SIM_check(DRV_CAN_addTxMessage(0x400U, 8U, 10U) == DRV_CAN_INVALID_HANDLE, "priority: no add after start");
+}
+
+static void testPeriodic(void)
+{
+    DRV_CAN_Stats stats;
+    uint32_t fast;
+    uint32_t medium;
+    uint32_t slow;
+
+    SIM_setup();
+    (void)DRV_CAN_addTxMessage(0x110U, 8U, 1U);
+    (void)DRV_CAN_addTxMessage(0x120U, 8U, 5U);
+    (void)DRV_CAN_addTxMessage(0x130U, 8U, 20U);
+    (void)DRV_CAN_addTxMessage(0x140U, 8U, 0U);
+    SIM_check(DRV_CAN_start(false), "periodic: start");
+
+    SIM_run(1000U);
+
+    fast   = SIM_countOwn(0x110U, NULL);
+    medium = SIM_countOwn(0x120U, NULL);
+    slow   = SIM_countOwn(0x130U, NULL);
+    DRV_CAN_getStats(&stats);
+
+    SIM_check((fast >= 999U) && (fast <= 1000U), "periodic: 1 tick period");
+    SIM_check((medium >= 199U) && (medium <= 200U), "periodic: 5 tick period");
+    SIM_check((slow >= 49U) && (slow <= 50U), "periodic: 20 tick period");
+    SIM_check(SIM_countOwn(0x140U, NULL) == 0U, "periodic: event message not sent unrequested");
+    SIM_check(stats.overruns == 0U, "periodic: no overruns");
+    SIM_check(stats.txFrames >= (fast + medium + slow - 1U), "periodic: completions counted");
+
+    {
+        uint16_t data[8] = { 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U };
+
+        CAN_BUS_MOCK_clearLog();
+        SIM_check(DRV_CAN_send(3U, data), "periodic: event send");
+        SIM_run(2U);
+        SIM_check(SIM_countOwn(0x140U, NULL) == 1U, "periodic: event message sent once");
+    }
+}
+
+static void testFiltering(void)
+{
+    DRV_CAN_Frame frame;
+    uint32_t ids[4];
+    uint16_t received = 0U;
+
+    SIM_setup();
+    SIM_check(DRV_CAN_addRxFilter(0x200U, 0x7F0U, 1U), "filter: standard");
+    SIM_check(DRV_CAN_addRxFilter(0x18FF0000UL | DRV_CAN_ID_EXTENDED, DRV_CAN_ID_EXT_MASK, 1U), "filter: extended");
+    SIM_check(!DRV_CAN_addRxFilter(0x800U, 0x7FFU, 1U), "filter: invalid identifier rejected");
+    SIM_check(DRV_CAN_start(false), "filter: start");
+
+    SIM_inject(0x205U, 8U, 0U);
+    SIM_inject(0x215U, 8U, 0U);
+    SIM_inject(0x205U | DRV_CAN_ID_EXTENDED, 8U, 0U);
+    SIM_inject(0x18FF0000UL | DRV_CAN_ID_EXTENDED, 8U, 0U);
+    SIM_inject(0x18FF0001UL | DRV_CAN_ID_EXTENDED, 8U, 0U);
+    SIM_run(3U);
+
+    while(DRV_CAN_receive(&frame) && (received < 4U))
+    {
+        ids[received] = frame.id;
+        received++;
+    }
+
+    SIM_check(received == 2U, "filter: only matching frames received");
+    SIM_check((received >= 2U) && (ids[0] == 0x205U) && (ids[1] == (0x18FF0000UL | DRV_CAN_ID_EXTENDED)),
+              "filter: received identifiers");
+}
+
+static void testFifo(void)
+{
+    DRV_CAN_Frame frame;
+    DRV_CAN_Stats stats;
+    uint16_t first[4];
+    uint16_t received = 0U;
+    bool neighbour = false;
+
+    SIM_setup();
+    (void)DRV_CAN_addRxFilter(0x300U, 0x7FFU, 3U);
+    (void)DRV_CAN_addRxFilter(0x301U, 0x7FFU, 1U);
+    SIM_check(DRV_CAN_start(false), "fifo: start");
+
+    /* 中断被屏蔽期间到达 4 帧，3 个邮箱的 FIFO 最后一个被覆盖。 */
+    CAN_BUS_MOCK_setIsrEnabled(false);
+    SIM_inject(0x300U, 8U, 1U);
+    SIM_inject(0x300U, 8U, 2U);
+    SIM_inject(0x300U, 8U, 3U);
+    SIM_inject(0x300U, 8U, 4U);
+    SIM_inject(0x301U, 8U, 9U);
+    SIM_run(3U);
+    CAN_BUS_MOCK_setIsrEnabled(true);
+
+    while(DRV_CAN_receive(&frame))
+    {
+        if(frame.id == 0x301U)
+        {
+            neighbour = true;
+        }
+        else if(received < 4U)
+        {
+            first[received] = frame.data[0];
+            received++;
+        }
+    }
+
+    DRV_CAN_getStats(&stats);
+    SIM_check(received == 3U, "fifo: three frames held");
+    SIM_check((received == 3U) && (first[0] == 1U) && (first[1] == 2U) && (first[2] == 4U),
+              "fifo: order kept, last mailbox overwritten");
+    SIM_check(stats.rxLost == 1U, "fifo: overwrite reported as lost");
+    SIM_check(neighbour, "fifo: neighbouring filter unaffected");
+}
+
+static void testOverflow(void)
+{
+    DRV_CAN_Frame frame;
+    DRV_CAN_Stats stats;
+    uint16_t expected = 0U;
+    bool ordered = true;
+    uint16_t i;
+
+    SIM_setup();
+    (void)DRV_CAN_addRxFilter(0x400U, 0x700U, 2U);
+    SIM_check(DRV_CAN_start(false), "overflow: start");
+
+    for(i = 0U; i < 20U; i++)
+    {
+        SIM_inject(0x400U + i, 8U, i);
+    }
+
+    SIM_run(10U);
+    DRV_CAN_getStats(&stats);
+    SIM_check(stats.rxFrames == DRV_CAN_RX_QUEUE_DEPTH, "overflow: queue filled");
+    SIM_check(stats.rxDropped == (20U - DRV_CAN_RX_QUEUE_DEPTH), "overflow: excess dropped");
+
+    while(DRV_CAN_receive(&frame))
+    {
+        ordered = ordered && (frame.data[0] == expected);
+        expected++;
+    }
+
+    SIM_check(ordered && (expected == DRV_CAN_RX_QUEUE_DEPTH), "overflow: oldest frames kept in order");
+}
+
+/**
+ * @brief 4 个 8 字节报文每 tick 发送一次，需求 540 位/tick，超过总线容量。
+ */
+static void SIM_setupHeavy(void)
+{
+    SIM_setup();
+    (void)DRV_CAN_addTxMessage(0x101U, 8U, 1U);
+    (void)DRV_CAN_addTxMessage(0x102U, 8U, 1U);
+    (void)DRV_CAN_addTxMessage(0x103U, 8U, 1U);
+    (void)DRV_CAN_addTxMessage(0x104U, 8U, 1U);
+    SIM_check(DRV_CAN_start(false), "throttle: start");
+}
+
+static void testThrottleFixed(void)
+{
+    DRV_CAN_Stats stats;
+    uint32_t bits;
+    uint32_t budget = (DRV_CAN_BITRATE * 20U) / 100U;
+
+    SIM_setupHeavy();
+    DRV_CAN_setThrottle(DRV_CAN_THROTTLE_FIXED, 20U);
+    SIM_run(1000U);
+    CAN_BUS_MOCK_clearLog();
+    SIM_run(1000U);
+
+    (void)SIM_countOwn(0U, &bits);
+    DRV_CAN_getStats(&stats);
+
+    SIM_check((bits <= (budget + (8U * 160U))) && (bits >= ((budget * 9U) / 10U)), "fixed: own bits within share");
+    SIM_check((stats.busLoadPercent >= 18U) && (stats.busLoadPercent <= 21U), "fixed: bus load estimate");
+    SIM_check(stats.sharePercent == 20U, "fixed: share unchanged");
+    SIM_check(stats.deferred > 0U, "fixed: deferrals counted");
+    SIM_check(SIM_countOwn(0x101U, NULL) >= SIM_countOwn(0x102U, NULL), "fixed: higher priority served first");
+}
+
+static void testThrottleOff(void)
+{
+    DRV_CAN_Stats stats;
+    uint32_t bits;
+
+    SIM_setupHeavy();
+    SIM_run(100U);
+    CAN_BUS_MOCK_clearLog();
+    SIM_run(1000U);
+
+    (void)SIM_countOwn(0U, &bits);
+    DRV_CAN_getStats(&stats);
+
+    /* 调度以 tick 为粒度，tick 内邮箱发空后总线空闲到下一个 tick。 */
+    SIM_check(bits >= ((DRV_CAN_BITRATE * 90U) / 100U), "off: bus saturated");
+    SIM_check(stats.busy > 0U, "off: busy mailboxes counted");
+    SIM_check(stats.deferred == 0U, "off: nothing deferred");
+    SIM_check(stats.sharePercent == 100U, "off: share reported as 100");
+}
+
+static void testThrottleAdaptive(void)
+{
+    DRV_CAN_Stats stats;
+    uint16_t lowest = 100U;
+    uint32_t tick;
+
+    SIM_setup();
+    (void)DRV_CAN_addTxMessage(0x100U, 8U, 1U);
+    SIM_check(DRV_CAN_start(false), "adaptive: start");
+    DRV_CAN_setThrottle(DRV_CAN_THROTTLE_ADAPTIVE, 60U);
+
+    SIM_run(500U);
+    DRV_CAN_getStats(&stats);
+    SIM_check((stats.sharePercent == 60U) && (stats.congestion == 0U), "adaptive: idle bus keeps full share");
+    SIM_check(SIM_countOwn(0x100U, NULL) >= 499U, "adaptive: every period sent on idle bus");
+
+    /* 外部节点以更高优先级占满总线。 */
+    for(tick = 0U; tick < 500U; tick++)
+    {
+        while(CAN_BUS_MOCK_foreignPending() < 8U)
+        {
+            SIM_inject(0x010U, 8U, 0U);
+        }
+
+        SIM_run(1U);
+        DRV_CAN_getStats(&stats);
+        lowest = (stats.sharePercent < lowest) ? stats.sharePercent : lowest;
+    }
+
+    SIM_check(stats.congestion > 0U, "adaptive: congestion detected");
+    SIM_check(lowest <= 30U, "adaptive: share reduced under congestion");
+    SIM_check(lowest >= 7U, "adaptive: share kept above minimum");
+
+    SIM_run(500U);
+    DRV_CAN_getStats(&stats);
+    SIM_check(stats.sharePercent == 60U, "adaptive: share recovered");
+}
+
+static void testBusOff(void)
+{
+    DRV_CAN_Stats stats;
+    const CAN_BUS_MOCK_Entry *log;
+    uint16_t count;
+
+    SIM_setup();
+    (void)DRV_CAN_addTxMessage(0x100U, 8U, 1U);
+    SIM_check(DRV_CAN_start(false), "bus-off: start");
+    SIM_run(10U);
+
+    CAN_BUS_MOCK_setFault(true);
+    CAN_BUS_MOCK_clearLog();
+    SIM_run(50U);
+    DRV_CAN_getStats(&stats);
+    SIM_check(stats.busOff == 1U, "bus-off: entry counted");
+    SIM_check((stats.busState & DRV_CAN_BUS_OFF) != 0U, "bus-off: state reported");
+    SIM_check(SIM_countOwn(0U, NULL) == 0U, "bus-off: nothing transmitted");
+
+    CAN_BUS_MOCK_setFault(false);
+    SIM_run(40U);
+    SIM_check(CAN_BUS_MOCK_recoveries() == 0U, "bus-off: holdoff respected");
+    SIM_check(SIM_countOwn(0U, NULL) == 0U, "bus-off: silent during holdoff");
+
+    SIM_run(20U);
+    SIM_check(CAN_BUS_MOCK_recoveries() == 1U, "bus-off: recovery requested");
+
+    log = CAN_BUS_MOCK_log(&count);
+    SIM_check((count > 0U) && (log[0].endBit >= (DRV_CAN_BUSOFF_HOLDOFF_TICKS * SIM_BITS_PER_TICK)),
+              "bus-off: first frame after holdoff");
+
+    SIM_run(10U);
+    DRV_CAN_getStats(&stats);
+    SIM_check(stats.busState == 0U, "bus-off: back on the bus");
+    SIM_check(SIM_countOwn(0U, NULL) > 10U, "bus-off: transmission resumed");
+    SIM_check(stats.busOff == 1U, "bus-off: single entry");
+}
+
+static void testLoopback(void)
+{
+    DRV_CAN_Frame frame;
+    uint16_t data[6] = { 0U, 0x5AU, 0x10U, 0x27U, 0xE8U, 0x03U };
+    uint16_t received = 0U;
+    bool intact = true;
+
+    SIM_setup();
+    (void)DRV_CAN_addTxMessage(0x201U, 6U, 10U);
+    (void)DRV_CAN_addRxFilter(0x201U, 0x7FFU, 2U);
+    SIM_check(DRV_CAN_start(true), "loopback: start");
+    (void)DRV_CAN_update(0U, data);
+
+    SIM_inject(0x201U, 6U, 0U);
+    SIM_run(100U);
+
+    while(DRV_CAN_receive(&frame))
+    {
+        intact = intact && (frame.length == 6U) && (memcmp(frame.data, data, sizeof(data)) == 0);
+        received++;
+    }
+
+    SIM_check(received == 10U, "loopback: own frames received");
+    SIM_check(intact, "loopback: payload intact, foreign frames ignored");
+}
+
+int main(void)
+{
+    testFrameBits();
+    testPriority();
+    testPeriodic();
+    testFiltering();
+    testFifo();
+    testOverflow();
+    testThrottleFixed();
+    testThrottleOff();
+    testThrottleAdaptive();
+    testBusOff();
+    testLoopback();
+
+    if(s_failures != 0U)
+    {
+        printf("%u check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file cla_loop_main.c
+ * @brief 在主机上运行 app_cla_loop.h 的电流环计算并检查结果。
+ *
+ * 检查正弦多项式精度、Clarke/Park 变换对已知电流的还原、关闭时的输出，以及带
+ * 三相 RL 负载时 d/q 轴电流对给定的跟踪，以及命令发布块的序号锁存。任一检查失败时
+ * 返回非零值。
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "app_cla_loop.h"
+
+#define SIM_TS              (50.0e-6)   /**< 控制周期（s）。 */
+#define SIM_R               (0.5)       /**< 相电阻（Ω）。 */
+#define SIM_L               (0.5e-3)    /**< 相电感（H）。 */
+#define SIM_VDC             (24.0)      /**< 母线电压（V）。 */
+#define SIM_STEPS           (4000U)
+#define SIM_ANGLE_STEP      (0.001f)    /**< 每周期电角度增量（标幺）。 */
+#define SIM_PI              (3.14159265358979323846)
+
+static unsigned int s_failures = 0U;
+
+static void SIM_check(int condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+static void SIM_defaultCommand(APP_CLA_Command *cmd)
+{
+    cmd->enable        = 0U;
+    cmd->angleSource   = APP_CLA_ANGLE_COMMAND;
+    cmd->idRef         = 0.0f;
+    cmd->iqRef         = 0.0f;
+    cmd->angle         = 0.0f;
+    cmd->encoderOffset = 0.0f;
+    cmd->kp            = 1.0f;       /* L·ωc，ωc = 2000 rad/s。 */
+    cmd->ki            = 0.05f;      /* R·ωc·Ts。 */
+    cmd->vLimitPu      = 0.40f;
+    cmd->currentScale  = 0.00805664f;
+    cmd->offsetA       = 2048.0f;
+    cmd->offsetB       = 2048.0f;
+    cmd->vdcScale      = 0.0147705f;
+    cmd->vdcMin        = 1.0f;
+}
+
+/**
+ * @brief 电流换算为 ADC 计数，含量化与饱和。
+ */
+static uint16_t SIM_toCounts(double value, double offset, double scale)
+{
+    double counts = floor(offset + (value / scale) + 0.5);
+
+    if(counts < 0.0)
+    {
+        counts = 0.0;
+    }
+
+    if(counts > 4095.0)
+    {
+        counts = 4095.0;
+    }
+
+    return (uint16_t)counts;
+}
+
+static void SIM_checkSin(void)
+{
+    double maxErr = 0.0;
+    int i;
+
+    for(i = -4000; i <= 4000; i++)
+    {
+        float angle = (float)i / 1000.0f;
+        double err = fabs((double)APP_CLA_LOOP_sinPu(angle) - sin(2.0 * SIM_PI * (double)angle));
+
+        if(err > maxErr)
+        {
+            maxErr = err;
+        }
+    }
+
+    printf("sin max error: %.3g\n", maxErr);
+    SIM_check(maxErr < 1.0e-5, "sin polynomial accuracy");
+}
+
+static void SIM_checkTransform(void)
+{
+    APP_CLA_Command cmd;
+    APP_CLA_LoopState state;
+    APP_CLA_Status status;
+    const double id = 1.5;
+    const double iq = -2.0;
+    double maxErr = 0.0;
+    int i;
+
+    SIM_defaultCommand(&cmd);
+    APP_CLA_LOOP_reset(&state);
+    PID_setUi(&state.pidD, 1.0f);
+    PID_setUi(&state.pidQ, 1.0f);
+
+    for(i = 0; i < 64; i++)
+    {
+        double theta = 2.0 * SIM_PI * (double)i / 64.0;
+        double ia = (id * cos(theta)) - (iq * sin(theta));
+        double ib = (id * cos(theta - (2.0 * SIM_PI / 3.0))) - (iq * sin(theta - (2.0 * SIM_PI / 3.0)));
+        double err;
+
+        cmd.angle = (float)i / 64.0f;
+        APP_CLA_LOOP_run(&cmd, &state,
+                         SIM_toCounts(ia, cmd.offsetA, cmd.currentScale),
+                         SIM_toCounts(ib, cmd.offsetB, cmd.currentScale),
+                         SIM_toCounts(SIM_VDC, 0.0, cmd.vdcScale), &status);
+
+        err = fabs((double)status.id - id) + fabs((double)status.iq - iq);
+        if(err > maxErr)
+        {
+            maxErr = err;
+        }
+    }
+
+    printf("dq transform max error: %.3g A\n", maxErr);
+    SIM_check(maxErr < 0.03, "Clarke/Park transform");
+
+    /* 关闭时积分清零，输出 50% 占空比。 */
+    SIM_check((PID_getUi(&state.pidD) == 0.0f) && (PID_getUi(&state.pidQ) == 0.0f), "integrators cleared when disabled");
+    SIM_check((status.duty[0] == 0.5f) && (status.duty[1] == 0.5f) && (status.duty[2] == 0.5f),
+              "neutral duty when disabled");
+    SIM_check(fabs((double)status.vdc - SIM_VDC) < 0.02, "dc bus scaling");
+    SIM_check(status.angle == cmd.angle, "angle reported in status");
+}
+
+static void SIM_checkClosedLoop(float idRef, float iqRef)
+{
+    APP_CLA_Command cmd;
+    APP_CLA_LoopState state;
+    APP_CLA_Status status;
+    double current[3] = { 0.0, 0.0, 0.0 };
+    double idErr = 0.0;
+    double iqErr = 0.0;
+    int dutyValid = 1;
+    unsigned int k;
+    char what[64];
+
+    SIM_defaultCommand(&cmd);
+    APP_CLA_LOOP_reset(&state);
+    cmd.enable = 1U;
+    cmd.idRef  = idRef;
+    cmd.iqRef  = iqRef;
+
+    for(k = 0U; k < SIM_STEPS; k++)
+    {
+        double mean;
+        int phase;
+
+        APP_CLA_LOOP_run(&cmd, &state,
+                         SIM_toCounts(current[0], cmd.offsetA, cmd.currentScale),
+                         SIM_toCounts(current[1], cmd.offsetB, cmd.currentScale),
+                         SIM_toCounts(SIM_VDC, 0.0, cmd.vdcScale), &status);
+
+        /* 星形连接对称负载：相电压为端电压减去三相平均值。 */
+        mean = ((double)status.duty[0] + (double)status.duty[1] + (double)status.duty[2]) / 3.0;
+
+        for(phase = 0; phase < 3; phase++)
+        {
+            double v = SIM_VDC * ((double)status.duty[phase] - mean);
+
+            if((status.duty[phase] < 0.0f) || (status.duty[phase] > 1.0f))
+            {
+                dutyValid = 0;
+            }
+
+            current[phase] += ((v - (SIM_R * current[phase])) / SIM_L) * SIM_TS;
+        }
+
+        if(k >= (SIM_STEPS - 200U))
+        {
+            idErr = fmax(idErr, fabs((double)status.id - (double)idRef));
+            iqErr = fmax(iqErr, fabs((double)status.iq - (double)iqRef));
+        }
+
+        cmd.angle += SIM_ANGLE_STEP;
+        if(cmd.angle >= 1.0f)
+        {
+            cmd.angle -= 1.0f;
+        }
+    }
+
+    printf("closed loop id=%.2f iq=%.2f: error id %.3f A, iq %.3f A\n",
+           (double)idRef, (double)iqRef, idErr, iqErr);
+
+    snprintf(what, sizeof(what), "tracking id=%.2f iq=%.2f", (double)idRef, (double)iqRef);
+    SIM_check((idErr < 0.05) && (iqErr < 0.05), what);
+    SIM_check(dutyValid, "duty within 0..1");
+}
+
+/**
+ * @brief 按 APP_CLA_publish 的顺序写发布块，检查锁存只接受完整且更新过的发布。
+ */
+static void SIM_checkLatch(void)
+{
+    APP_CLA_CommandBlock block;
+    APP_CLA_Command active;
+    uint32_t sequence = 0U;
+
+    block.sequence = 0U;
+    SIM_defaultCommand(&block.command);
+    SIM_defaultCommand(&active);
+
+    /* 完整发布：增益与给定在同一次锁存中生效。 */
+    block.sequence++;
+    block.command.kp    = 2.0f;
+    block.command.ki    = 0.1f;
+    block.command.iqRef = 3.0f;
+    block.sequence++;
+    SIM_check(APP_CLA_LOOP_latchCommand(&block, &active, &sequence) == 1U, "latch complete publish");
+    SIM_check((active.kp == 2.0f) && (active.ki == 0.1f) && (active.iqRef == 3.0f) &&
+              (sequence == 2U), "latched command");
+
+    /* 序号未变：不重复复制。 */
+    SIM_check(APP_CLA_LOOP_latchCommand(&block, &active, &sequence) == 0U, "no latch without publish");
+
+    /* 发布进行中（序号为奇数）：已写入的字段不生效，沿用上一份。 */
+    block.sequence++;
+    block.command.kp = 5.0f;
+    SIM_check(APP_CLA_LOOP_latchCommand(&block, &active, &sequence) == 0U, "no latch while publishing");
+    SIM_check((active.kp == 2.0f) && (active.ki == 0.1f) && (sequence == 2U), "previous command kept");
+
+    block.command.ki = 0.2f;
+    block.sequence++;
+    SIM_check(APP_CLA_LOOP_latchCommand(&block, &active, &sequence) == 1U, "latch after publish");
+    SIM_check((active.kp == 5.0f) && (active.ki == 0.2f) && (sequence == 4U), "new command latched");
+}
+
+int main(void)
+{
+    SIM_checkSin();
+    SIM_checkTransform();
+    SIM_checkClosedLoop(0.0f, 2.0f);
+    SIM_checkClosedLoop(-1.0f, 3.0f);
+    SIM_checkClosedLoop(0.5f, -4.0f);
+    SIM_checkLatch();
+
+    if(s_failures != 0U)
+    {
+        printf("%u check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 主机端 FreeRTOS 替身，只提供 app_drv8316.c 用到的类型与宏。
+ *
+ * 主机端以单线程顺序执行维护任务，临界区与互斥量均为空操作，节拍由
+ * rtos_mock.h 的接口推进。
+ */
+
+#ifndef DRV8316_SIM_FREERTOS_H
+#define DRV8316_SIM_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t      TickType_t;
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  (pdTRUE)
+#define pdFAIL                  (pdFALSE)
+
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+
+/** 节拍为 1 ms。 */
+#define configTICK_RATE_HZ      (1000U)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_FREERTOS_H */
@@ -0,0 +1,11 @@
+/**
+ * @file device.h
+ * @brief 主机端 device.h 替身，只提供 app_drv8316.c 用到的引脚定义。
+ */
+
+#ifndef DRV8316_SIM_DEVICE_H
+#define DRV8316_SIM_DEVICE_H
+
+#define DEVICE_GPIO_PIN_SPISTEA     (11U)
+
+#endif /* DRV8316_SIM_DEVICE_H */
@@ -0,0 +1,22 @@
+/**
+ * @file cputimer.h
+ * @brief 主机端 CPU 定时器替身，供 app_stats.h 的时间基准编译，计数取自模拟时钟。
+ */
+
+#ifndef DRV8316_SIM_CPUTIMER_H
+#define DRV8316_SIM_CPUTIMER_H
+
+#include <stdint.h>
+
+#include "drv8316_sim.h"
+
+#define CPUTIMER0_BASE              (0x0C00U)
+
+static inline uint32_t CPUTimer_getTimerCount(uint32_t base)
+{
+    (void)base;
+
+    return ~DRV8316_SIM_now();
+}
+
+#endif /* DRV8316_SIM_CPUTIMER_H */
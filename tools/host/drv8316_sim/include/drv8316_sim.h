@@ -0,0 +1,171 @@
+/**
+ * @file drv8316_sim.h
+ * @brief DRV8316 SPI 从机行为模型接口说明（主机端）。
+ *
+ * 模型按照 DRV8316_buildCtrlWord 的帧格式解码 16 bit SPI 帧：
+ *  - bit 15    读写标志（1 为读）；
+ *  - bit 14:9  寄存器地址；
+ *  - bit 8     偶校验位；
+ *  - bit 7:0   写入数据。
+ * 应答帧高 8 位为 STATUS_0，低 8 位为寄存器数据（写操作返回写入前的旧值）。
+ *
+ * 模型覆盖寄存器文件、CONTROL_1 的 REG_LOCK 锁定/解锁、CLR_FLT 清除故障、
+ * 故障注入与校验错误检测，并统计帧数、忙等待次数与模拟耗时，供主机端运行
+ * 真实驱动代码。
+ *
+ * 模拟时钟以目标板 SYSCLK 周期计：SysCtl_delay 按 5 * count + 9 周期推进，
+ * 每次 RX FIFO 轮询、SPI 写入与 GPIO 写入按固定周期推进，应答在一帧的位时间
+ * 之后才进入 RX FIFO。
+ */
+
+#ifndef DRV8316_SIM_H
+#define DRV8316_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 模型寄存器文件大小，对应 6 bit 地址空间中的前 32 个地址。 */
+#define DRV8316_SIM_REG_COUNT           (32U)
+/** 最后一个有效寄存器地址（CONTROL_10）。 */
+#define DRV8316_SIM_LAST_VALID_ADDR     (0x0CU)
+
+/** 寄存器地址。 */
+#define DRV8316_SIM_ADDR_STATUS_0       (0x00U)
+#define DRV8316_SIM_ADDR_STATUS_1       (0x01U)
+#define DRV8316_SIM_ADDR_STATUS_2       (0x02U)
+#define DRV8316_SIM_ADDR_CONTROL_1      (0x03U)
+#define DRV8316_SIM_ADDR_CONTROL_2      (0x04U)
+
+/** CONTROL_1 中 REG_LOCK 字段的解锁与锁定值。 */
+#define DRV8316_SIM_REG_UNLOCK          (0x03U)
+#define DRV8316_SIM_REG_LOCK            (0x06U)
+
+/** 默认的模拟 SYSCLK 与 SPI 波特率。 */
+#define DRV8316_SIM_DEFAULT_SYSCLK_HZ   (100000000UL)
+#define DRV8316_SIM_DEFAULT_BITRATE_HZ  (1000000UL)
+
+/** 单次外设寄存器访问的模拟耗时（SYSCLK 周期）。 */
+#define DRV8316_SIM_POLL_CYCLES         (6U)
+#define DRV8316_SIM_SPI_WRITE_CYCLES    (4U)
+#define DRV8316_SIM_GPIO_WRITE_CYCLES   (4U)
+
+/**
+ * @brief 模型统计计数。
+ */
+typedef struct
+{
+    uint32_t frames;        /**< 收到的 SPI 帧总数。 */
+    uint32_t readFrames;    /**< 读帧数。 */
+    uint32_t writeFrames;   /**< 写帧数。 */
+    uint32_t parityErrors;  /**< 校验错误帧数。 */
+    uint32_t addrErrors;    /**< 访问无效地址的帧数。 */
+    uint32_t lockedWrites;  /**< 因寄存器锁定而被忽略的写帧数。 */
+    uint32_t rxPolls;       /**< SPI_getRxFIFOStatus 被轮询的次数。 */
+    uint32_t delayCycles;   /**< SysCtl_delay 消耗的周期数。 */
+    uint32_t elapsedCycles; /**< 模拟时钟推进的总周期数。 */
+    uint32_t csAsserts;     /**< 片选被拉低的次数。 */
+} DRV8316_SIM_Counters;
+
+/**
+ * @brief 复位模型到上电状态并清零统计计数。
+ *
+ * 上电后寄存器全部为 0，REG_LOCK 处于解锁状态。总线时序设置保持不变。
+ */
+void DRV8316_SIM_reset(void);
+
+/**
+ * @brief 设置模拟时钟频率与 SPI 波特率，决定应答到达前的等待时间。
+ */
+void DRV8316_SIM_setBusTiming(uint32_t sysclkHz, uint32_t bitRateHz);
+
+/**
+ * @brief 读取一帧 16 bit 的传输周期数。
+ */
+uint32_t DRV8316_SIM_getFrameCycles(void);
+
+/**
+ * @brief 将模拟周期数换算为纳秒。
+ */
+uint32_t DRV8316_SIM_cyclesToNs(uint32_t cycles);
+
+/**
+ * @brief 处理一帧主机发出的数据并返回从机应答。
+ *
+ * 由模拟 SPI 层在每次发送时调用，也可直接用于单独验证帧解码。
+ */
+uint16_t DRV8316_SIM_transfer(uint16_t mosi);
+
+/**
+ * @brief 注入故障位。
+ *
+ * 注入的位与现有状态按位或，并自动置位 STATUS_0 的 FAULT 位。
+ *
+ * @param[in] persistent true 表示故障条件持续存在，CLR_FLT 后立即重新锁存；
+ *                       false 表示瞬态故障，CLR_FLT 可以清除。
+ */
+void DRV8316_SIM_injectFault(uint16_t stat00, uint16_t stat01, uint16_t stat02, bool persistent);
+
+/**
+ * @brief 撤销全部持续故障条件，已锁存的状态位仍需 CLR_FLT 清除。
+ */
+void DRV8316_SIM_releaseFaults(void);
+
+/**
+ * @brief 翻转后续若干帧的最低数据位，用于制造校验错误。
+ */
+void DRV8316_SIM_corruptFrames(uint16_t count);
+
+/**
+ * @brief 后门读取寄存器值，不产生 SPI 帧。
+ */
+uint16_t DRV8316_SIM_getReg(uint16_t address);
+
+/**
+ * @brief 后门写入寄存器值，不经过锁定检查。
+ */
+void DRV8316_SIM_setReg(uint16_t address, uint16_t value);
+
+/**
+ * @brief 查询寄存器是否处于锁定状态。
+ */
+bool DRV8316_SIM_isLocked(void);
+
+/**
+ * @brief 读取统计计数。
+ */
+void DRV8316_SIM_getCounters(DRV8316_SIM_Counters *counters);
+
+/**
+ * @brief 清零统计计数，寄存器文件保持不变。
+ */
+void DRV8316_SIM_clearCounters(void);
+
+/**
+ * @brief 由模拟 SPI 层登记一次 RX FIFO 轮询。
+ */
+void DRV8316_SIM_countRxPoll(void);
+
+/**
+ * @brief 推进模拟时钟。
+ */
+void DRV8316_SIM_advance(uint32_t cycles);
+
+/**
+ * @brief 读取模拟时钟的当前周期数。
+ */
+uint32_t DRV8316_SIM_now(void);
+
+/**
+ * @brief 由模拟 GPIO 层登记一次片选拉低。
+ */
+void DRV8316_SIM_countCsAssert(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_H */
@@ -0,0 +1,36 @@
+/**
+ * @file gpio.h
+ * @brief 主机端 driverlib GPIO 接口替身。
+ *
+ * 仅提供 DRV8316 驱动用到的 GPIO_writePin，记录引脚电平并统计片选动作。
+ */
+
+#ifndef DRV8316_SIM_GPIO_H
+#define DRV8316_SIM_GPIO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 模拟的 GPIO 数量。 */
+#define GPIO_SIM_PIN_COUNT      (64U)
+
+void GPIO_writePin(uint32_t pin, uint32_t outVal);
+
+/**
+ * @brief 读取模拟引脚最近一次写入的电平。
+ */
+uint32_t GPIO_SIM_readPin(uint32_t pin);
+
+/**
+ * @brief 指定被视为片选的引脚，拉低时计入片选次数。
+ */
+void GPIO_SIM_setChipSelectPin(uint32_t pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_GPIO_H */
@@ -0,0 +1,36 @@
+/**
+ * @file queue.h
+ * @brief 主机端 FreeRTOS 队列替身，静态存储上的单线程环形队列。
+ */
+
+#ifndef DRV8316_SIM_QUEUE_H
+#define DRV8316_SIM_QUEUE_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    uint8_t    *storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+} StaticQueue_t;
+
+typedef StaticQueue_t *QueueHandle_t;
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t itemSize,
+                                 uint8_t *storage, StaticQueue_t *buffer);
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t wait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_QUEUE_H */
@@ -0,0 +1,30 @@
+/**
+ * @file semphr.h
+ * @brief 主机端 FreeRTOS 互斥量替身，单线程下只记录持有状态。
+ */
+
+#ifndef DRV8316_SIM_SEMPHR_H
+#define DRV8316_SIM_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    BaseType_t taken;
+} StaticSemaphore_t;
+
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_SEMPHR_H */
@@ -0,0 +1,69 @@
+/**
+ * @file spi.h
+ * @brief 主机端 driverlib SPI 接口替身。
+ *
+ * 仅声明 DRV8316 驱动用到的 SPI 接口，编译时将本目录置于包含路径最前，
+ * drv8316s.h 中的 #include "spi.h" 即解析到本文件。发送的每一帧都交给
+ * DRV8316 行为模型处理，应答在一帧传输时间后进入模拟 RX FIFO。
+ */
+
+#ifndef DRV8316_SIM_SPI_H
+#define DRV8316_SIM_SPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv8316_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RX FIFO 深度，取值与 driverlib 一致。
+ */
+typedef enum
+{
+    SPI_FIFO_RXEMPTY = 0x0000U,
+    SPI_FIFO_RX0     = 0x0000U,
+    SPI_FIFO_RX1     = 0x0001U,
+    SPI_FIFO_RX2     = 0x0002U,
+    SPI_FIFO_RX3     = 0x0003U,
+    SPI_FIFO_RX4     = 0x0004U,
+    SPI_FIFO_RX5     = 0x0005U,
+    SPI_FIFO_RX6     = 0x0006U,
+    SPI_FIFO_RX7     = 0x0007U,
+    SPI_FIFO_RX8     = 0x0008U,
+    SPI_FIFO_RX9     = 0x0009U,
+    SPI_FIFO_RX10    = 0x000AU,
+    SPI_FIFO_RX11    = 0x000BU,
+    SPI_FIFO_RX12    = 0x000CU,
+    SPI_FIFO_RX13    = 0x000DU,
+    SPI_FIFO_RX14    = 0x000EU,
+    SPI_FIFO_RX15    = 0x000FU,
+    SPI_FIFO_RX16    = 0x0010U,
+    SPI_FIFO_RXFULL  = 0x0010U
+} SPI_RxFIFOLevel;
+
+/**
+ * @brief 时钟极性与相位，取值与 driverlib 一致，供 drv_spi.h 的配置结构编译。
+ */
+typedef enum
+{
+    SPI_PROT_POL0PHA0   = 0x0000U,
+    SPI_PROT_POL0PHA1   = 0x0002U,
+    SPI_PROT_POL1PHA0   = 0x0001U,
+    SPI_PROT_POL1PHA1   = 0x0003U
+} SPI_TransferProtocol;
+
+void SPI_resetRxFIFO(uint32_t base);
+void SPI_enableFIFO(uint32_t base);
+void SPI_writeDataBlockingNonFIFO(uint32_t base, uint16_t data);
+uint16_t SPI_readDataNonBlocking(uint32_t base);
+SPI_RxFIFOLevel SPI_getRxFIFOStatus(uint32_t base);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_SPI_H */
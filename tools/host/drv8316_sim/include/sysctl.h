@@ -0,0 +1,26 @@
+/**
+ * @file sysctl.h
+ * @brief 主机端 driverlib SysCtl 接口替身。
+ *
+ * 仅提供 DRV8316 驱动用到的 SysCtl_delay，按目标板的周期数推进模拟时钟。
+ */
+
+#ifndef DRV8316_SIM_SYSCTL_H
+#define DRV8316_SIM_SYSCTL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 延时 5 * count + 9 个 SYSCLK 周期，与 C28x 实现一致。
+ */
+void SysCtl_delay(uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_SYSCTL_H */
@@ -0,0 +1,27 @@
+/**
+ * @file task.h
+ * @brief 主机端 FreeRTOS 任务接口替身。
+ */
+
+#ifndef DRV8316_SIM_TASK_H
+#define DRV8316_SIM_TASK_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *TaskHandle_t;
+
+/** 返回模拟节拍。 */
+TickType_t xTaskGetTickCount(void);
+
+/** 模拟节拍前进 @p ticks。 */
+void vTaskDelay(TickType_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRV8316_SIM_TASK_H */
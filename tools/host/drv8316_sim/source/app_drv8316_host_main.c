@@ -0,0 +1,208 @@
+/**
+ * @file app_drv8316_host_main.c
+ * @brief 在主机上以 DRV8316 行为模型运行 app_drv8316.c 的维护任务。
+ *
+ * 维护任务与测试在同一线程中执行：任务每轮结束时调用 APP_EVENT_wait，本文件在
+ * 其中执行下一步测试动作（提交请求、推进节拍、检查器件寄存器），全部步骤完成后
+ * 以 longjmp 退出任务循环。任一检查失败时返回非零值。
+ */
+
+#include <stdio.h>
+#include <setjmp.h>
+
+#include "app_drv8316.h"
+#include "app_event.h"
+#include "app_stats.h"
+#include "drv_spi.h"
+#include "drv8316_sim.h"
+#include "gpio.h"
+
+/** 模拟的片选引脚。 */
+#define SIM_CS_GPIO         (11U)
+
+/** CONTROL_3 的模型地址。 */
+#define SIM_ADDR_CONTROL_3  (0x05U)
+
+/** 上电值与请求值。 */
+#define SIM_CTRL3_A         (0x12U)
+#define SIM_CTRL3_B         (0x34U)
+
+/** 扫描周期（节拍）。 */
+#define SIM_REFRESH_TICKS   (10U)
+
+static jmp_buf  s_taskExit;
+static uint16_t s_step = 0U;
+static uint16_t s_failures = 0U;
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+/**
+ * @brief 以当前快照为基础请求 CONTROL_3 取 @p value。
+ */
+static void SIM_requestCtrl3(uint16_t value)
+{
+    DRV8316_VARS_t vars;
+
+    SIM_check(APP_DRV8316_getStatusSnapshot(APP_DRV8316_DEVICE_0, &vars), "snapshot available");
+    vars.ctrlReg03.all = value;
+    SIM_check(APP_DRV8316_scheduleControlUpdate(APP_DRV8316_DEVICE_0, &vars), "control update accepted");
+}
+
+static uint32_t SIM_writeFrames(void)
+{
+    DRV8316_SIM_Counters counters;
+
+    DRV8316_SIM_getCounters(&counters);
+    DRV8316_SIM_clearCounters();
+
+    return counters.writeFrames;
+}
+
+/**
+ * @brief 维护任务每轮结束后执行的测试步骤。
+ *
+ * 第 0 轮为启动时的首次扫描；A→B→A 的两次请求都在同一个扫描周期内完成，
+ * 期间快照一直是扫描时读到的 A。
+ */
+static void SIM_taskStep(void)
+{
+    DRV8316_VARS_t vars;
+
+    switch(s_step)
+    {
+        case 0U:
+            SIM_check(APP_DRV8316_hasScanned(APP_DRV8316_DEVICE_0), "first scan reported");
+            (void)SIM_writeFrames();
+            SIM_requestCtrl3(SIM_CTRL3_B);
+            break;
+
+        case 1U:
+            SIM_check(DRV8316_SIM_getReg(SIM_ADDR_CONTROL_3) == SIM_CTRL3_B, "A->B written");
+            SIM_check(SIM_writeFrames() == 1U, "A->B single write");
+            SIM_requestCtrl3(SIM_CTRL3_A);
+            break;
+
+        case 2U:
+            SIM_check(DRV8316_SIM_getReg(SIM_ADDR_CONTROL_3) == SIM_CTRL3_A,
+                      "B->A within one scan period written back");
+            SIM_check(SIM_writeFrames() == 1U, "B->A single write");
+            SIM_requestCtrl3(SIM_CTRL3_A);
+            break;
+
+        case 3U:
+            SIM_check(SIM_writeFrames() == 0U, "request equal to device value not written");
+            vTaskDelay(SIM_REFRESH_TICKS);
+            break;
+
+        default:
+            SIM_check(APP_DRV8316_getStatusSnapshot(APP_DRV8316_DEVICE_0, &vars), "snapshot after scan");
+            SIM_check(vars.ctrlReg03.all == SIM_CTRL3_A, "snapshot after scan holds A");
+            longjmp(s_taskExit, 1);
+            break;
+    }
+
+    s_step++;
+    vTaskDelay(1U);
+}
+
+int main(void)
+{
+    static const APP_DRV8316_Config config =
+    {
+        .csGpio             = SIM_CS_GPIO,
+        .enableGpio         = DRV_SPI_INVALID_GPIO,
+        .refreshPeriodTicks = SIM_REFRESH_TICKS,
+        .autoEnable         = false,
+        .linkSelfTest       = false
+    };
+    DRV8316_VARS_t vars;
+
+    DRV8316_SIM_reset();
+    GPIO_SIM_setChipSelectPin(SIM_CS_GPIO);
+    DRV8316_SIM_setReg(SIM_ADDR_CONTROL_3, SIM_CTRL3_A);
+
+    APP_DRV8316_init(APP_DRV8316_DEVICE_0, &config);
+    SIM_check(APP_DRV8316_isReady(APP_DRV8316_DEVICE_0), "device ready");
+    SIM_check(!APP_DRV8316_hasScanned(APP_DRV8316_DEVICE_0), "no scan before task");
+    SIM_check(APP_DRV8316_getStatusSnapshot(APP_DRV8316_DEVICE_0, &vars) &&
+              (vars.ctrlReg03.all == SIM_CTRL3_A), "init snapshot holds CONTROL_3");
+
+    if(setjmp(s_taskExit) == 0)
+    {
+        APP_DRV8316_TASK(NULL);
+    }
+
+    SIM_check(DRV8316_SIM_getReg(SIM_ADDR_CONTROL_3) == SIM_CTRL3_A, "device ends at A");
+
+    if(s_failures == 0U)
+    {
+        printf("PASS\n");
+    }
+
+    return (s_failures == 0U) ? 0 : 1;
+}
+
+/*
+ * 维护任务依赖的替身。
+ */
+
+void DRV_SPI_attachToDRV8316(DRV8316_Handle handle, uint32_t csGpio, uint32_t enableGpio)
+{
+    (void)enableGpio;
+
+    DRV8316_setSPIHandle(handle, 0U);
+    DRV8316_setGPIOCSNumber(handle, csGpio);
+}
+
+bool DRV_SPI_runDRV8316SelfTest(DRV8316_Handle handle, DRV_SPI_SelfTestResult *result)
+{
+    (void)handle;
+    (void)result;
+
+    return true;
+}
+
+bool APP_EVENT_bind(uint16_t source)
+{
+    (void)source;
+
+    return true;
+}
+
+bool APP_EVENT_post(uint16_t source, uint16_t code, uint16_t arg)
+{
+    (void)source;
+    (void)code;
+    (void)arg;
+
+    return true;
+}
+
+bool APP_EVENT_receive(uint16_t source, APP_EVENT_Event *event)
+{
+    (void)source;
+    (void)event;
+
+    return false;
+}
+
+uint32_t APP_EVENT_wait(TickType_t timeout)
+{
+    (void)timeout;
+
+    SIM_taskStep();
+
+    return 0U;
+}
+
+void APP_STATS_taskEnd(uint32_t start)
+{
+    (void)start;
+}
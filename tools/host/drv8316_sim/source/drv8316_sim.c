@@ -0,0 +1,307 @@
+/**
+ * @file drv8316_sim.c
+ * @brief DRV8316 SPI 从机行为模型实现（主机端）。
+ */
+
+#include "drv8316_sim.h"
+#include "sysctl.h"
+
+#include <string.h>
+
+/** 帧字段掩码，与 drv8316s.h 中的定义一致。 */
+#define DRV8316_SIM_RW_MASK         (0x8000U)
+#define DRV8316_SIM_ADDR_MASK       (0x7E00U)
+#define DRV8316_SIM_ADDR_SHIFT      (9U)
+#define DRV8316_SIM_DATA_MASK       (0x00FFU)
+
+/** STATUS_0 中的故障位。 */
+#define DRV8316_SIM_STAT00_FAULT    (1U << 0)
+#define DRV8316_SIM_STAT00_SPI_FLT  (1U << 5)
+/** STATUS_2 中的 SPI 故障位。 */
+#define DRV8316_SIM_STAT02_ADDR_FLT (1U << 0)
+#define DRV8316_SIM_STAT02_PARITY   (1U << 2)
+/** CONTROL_1 中的 REG_LOCK 字段。 */
+#define DRV8316_SIM_REG_LOCK_MASK   (0x07U)
+/** CONTROL_2 中的 CLR_FLT 位，写 1 清除锁存故障后自动归零。 */
+#define DRV8316_SIM_CLR_FLT         (1U << 0)
+
+/**
+ * @brief 模型内部状态。
+ */
+typedef struct
+{
+    uint16_t regs[DRV8316_SIM_REG_COUNT]; /**< 寄存器文件。 */
+    uint16_t persistent[3];               /**< 持续存在的故障条件，对应 STATUS_0/1/2。 */
+    bool     locked;                      /**< REG_LOCK 是否处于锁定状态。 */
+    uint16_t corruptCount;                /**< 剩余待破坏的帧数。 */
+    uint32_t now;                         /**< 模拟时钟（SYSCLK 周期）。 */
+    uint32_t sysclkMHz;                   /**< 模拟 SYSCLK 频率（MHz）。 */
+    uint32_t frameCycles;                 /**< 一帧 16 bit 的传输周期数。 */
+    DRV8316_SIM_Counters counters;        /**< 统计计数。 */
+} DRV8316_SIM_State;
+
+static DRV8316_SIM_State s_sim;
+
+/**
+ * @brief 计算 16 bit 字中置 1 位数的奇偶性，返回 1 表示奇数个。
+ */
+static uint16_t DRV8316_SIM_oddParity(uint16_t word)
+{
+    word ^= (uint16_t)(word >> 8);
+    word ^= (uint16_t)(word >> 4);
+    word ^= (uint16_t)(word >> 2);
+    word ^= (uint16_t)(word >> 1);
+
+    return (uint16_t)(word & 1U);
+}
+
+/**
+ * @brief 重新锁存持续故障并根据各状态位更新 FAULT 汇总位。
+ */
+static void DRV8316_SIM_updateFaultSummary(void)
+{
+    uint16_t *regs = s_sim.regs;
+
+    regs[DRV8316_SIM_ADDR_STATUS_0] |= s_sim.persistent[0];
+    regs[DRV8316_SIM_ADDR_STATUS_1] |= s_sim.persistent[1];
+    regs[DRV8316_SIM_ADDR_STATUS_2] |= s_sim.persistent[2];
+
+    if(((regs[DRV8316_SIM_ADDR_STATUS_0] & (uint16_t)~DRV8316_SIM_STAT00_FAULT) != 0U) ||
+       (regs[DRV8316_SIM_ADDR_STATUS_1] != 0U) ||
+       (regs[DRV8316_SIM_ADDR_STATUS_2] != 0U))
+    {
+        regs[DRV8316_SIM_ADDR_STATUS_0] |= DRV8316_SIM_STAT00_FAULT;
+    }
+    else
+    {
+        regs[DRV8316_SIM_ADDR_STATUS_0] &= (uint16_t)~DRV8316_SIM_STAT00_FAULT;
+    }
+}
+
+/**
+ * @brief 锁存一个 SPI 通信故障。
+ */
+static void DRV8316_SIM_latchSpiFault(uint16_t stat02Bits)
+{
+    s_sim.regs[DRV8316_SIM_ADDR_STATUS_2] |= stat02Bits;
+    s_sim.regs[DRV8316_SIM_ADDR_STATUS_0] |= DRV8316_SIM_STAT00_SPI_FLT;
+}
+
+/**
+ * @brief 执行一次写访问，处理锁定、只读寄存器与 CLR_FLT。
+ */
+static void DRV8316_SIM_writeReg(uint16_t address, uint16_t data)
+{
+    if(address == DRV8316_SIM_ADDR_CONTROL_1)
+    {
+        uint16_t lock = data & DRV8316_SIM_REG_LOCK_MASK;
+
+        if(lock == DRV8316_SIM_REG_UNLOCK)
+        {
+            s_sim.locked = false;
+        }
+        else if(lock == DRV8316_SIM_REG_LOCK)
+        {
+            s_sim.locked = true;
+        }
+
+        s_sim.regs[address] = data;
+        return;
+    }
+
+    if(s_sim.locked)
+    {
+        s_sim.counters.lockedWrites++;
+        return;
+    }
+
+    /* 状态寄存器只读。 */
+    if(address <= DRV8316_SIM_ADDR_STATUS_2)
+    {
+        return;
+    }
+
+    if((address == DRV8316_SIM_ADDR_CONTROL_2) && ((data & DRV8316_SIM_CLR_FLT) != 0U))
+    {
+        s_sim.regs[DRV8316_SIM_ADDR_STATUS_0] = 0U;
+        s_sim.regs[DRV8316_SIM_ADDR_STATUS_1] = 0U;
+        s_sim.regs[DRV8316_SIM_ADDR_STATUS_2] = 0U;
+        data &= (uint16_t)~DRV8316_SIM_CLR_FLT;
+    }
+
+    s_sim.regs[address] = data;
+}
+
+void DRV8316_SIM_reset(void)
+{
+    uint32_t sysclkMHz   = s_sim.sysclkMHz;
+    uint32_t frameCycles = s_sim.frameCycles;
+
+    memset(&s_sim, 0, sizeof(s_sim));
+
+    /* 总线时序属于测试配置，复位后保留。 */
+    s_sim.sysclkMHz   = sysclkMHz;
+    s_sim.frameCycles = frameCycles;
+
+    if(s_sim.sysclkMHz == 0U)
+    {
+        DRV8316_SIM_setBusTiming(DRV8316_SIM_DEFAULT_SYSCLK_HZ, DRV8316_SIM_DEFAULT_BITRATE_HZ);
+    }
+}
+
+void DRV8316_SIM_setBusTiming(uint32_t sysclkHz, uint32_t bitRateHz)
+{
+    s_sim.sysclkMHz   = sysclkHz / 1000000UL;
+    s_sim.frameCycles = (uint32_t)((16ULL * sysclkHz) / bitRateHz);
+}
+
+uint32_t DRV8316_SIM_getFrameCycles(void)
+{
+    return s_sim.frameCycles;
+}
+
+uint32_t DRV8316_SIM_cyclesToNs(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000U) / s_sim.sysclkMHz);
+}
+
+uint16_t DRV8316_SIM_transfer(uint16_t mosi)
+{
+    uint16_t address;
+    uint16_t data = 0U;
+    bool     isRead;
+
+    if(s_sim.corruptCount > 0U)
+    {
+        s_sim.corruptCount--;
+        mosi ^= 0x0001U;
+    }
+
+    isRead  = ((mosi & DRV8316_SIM_RW_MASK) != 0U);
+    address = (uint16_t)((mosi & DRV8316_SIM_ADDR_MASK) >> DRV8316_SIM_ADDR_SHIFT);
+
+    s_sim.counters.frames++;
+
+    if(isRead)
+    {
+        s_sim.counters.readFrames++;
+    }
+    else
+    {
+        s_sim.counters.writeFrames++;
+    }
+
+    /* 偶校验：包括校验位在内整帧置 1 位数必须为偶数，否则整帧丢弃。 */
+    if(DRV8316_SIM_oddParity(mosi) != 0U)
+    {
+        s_sim.counters.parityErrors++;
+        DRV8316_SIM_latchSpiFault(DRV8316_SIM_STAT02_PARITY);
+    }
+    else if(address > DRV8316_SIM_LAST_VALID_ADDR)
+    {
+        s_sim.counters.addrErrors++;
+        DRV8316_SIM_latchSpiFault(DRV8316_SIM_STAT02_ADDR_FLT);
+    }
+    else
+    {
+        /* 应答数据为访问前的寄存器值，读写一致。 */
+        data = s_sim.regs[address] & DRV8316_SIM_DATA_MASK;
+
+        if(!isRead)
+        {
+            DRV8316_SIM_writeReg(address, mosi & DRV8316_SIM_DATA_MASK);
+        }
+    }
+
+    DRV8316_SIM_updateFaultSummary();
+
+    return (uint16_t)(((s_sim.regs[DRV8316_SIM_ADDR_STATUS_0] & DRV8316_SIM_DATA_MASK) << 8) | data);
+}
+
+void DRV8316_SIM_injectFault(uint16_t stat00, uint16_t stat01, uint16_t stat02, bool persistent)
+{
+    s_sim.regs[DRV8316_SIM_ADDR_STATUS_0] |= stat00 & DRV8316_SIM_DATA_MASK;
+    s_sim.regs[DRV8316_SIM_ADDR_STATUS_1] |= stat01 & DRV8316_SIM_DATA_MASK;
+    s_sim.regs[DRV8316_SIM_ADDR_STATUS_2] |= stat02 & DRV8316_SIM_DATA_MASK;
+
+    if(persistent)
+    {
+        s_sim.persistent[0] |= stat00 & DRV8316_SIM_DATA_MASK;
+        s_sim.persistent[1] |= stat01 & DRV8316_SIM_DATA_MASK;
+        s_sim.persistent[2] |= stat02 & DRV8316_SIM_DATA_MASK;
+    }
+
+    DRV8316_SIM_updateFaultSummary();
+}
+
+void DRV8316_SIM_releaseFaults(void)
+{
+    s_sim.persistent[0] = 0U;
+    s_sim.persistent[1] = 0U;
+    s_sim.persistent[2] = 0U;
+}
+
+void DRV8316_SIM_corruptFrames(uint16_t count)
+{
+    s_sim.corruptCount = count;
+}
+
+uint16_t DRV8316_SIM_getReg(uint16_t address)
+{
+    return (address < DRV8316_SIM_REG_COUNT) ? s_sim.regs[address] : 0U;
+}
+
+void DRV8316_SIM_setReg(uint16_t address, uint16_t value)
+{
+    if(address < DRV8316_SIM_REG_COUNT)
+    {
+        s_sim.regs[address] = value & DRV8316_SIM_DATA_MASK;
+    }
+}
+
+bool DRV8316_SIM_isLocked(void)
+{
+    return s_sim.locked;
+}
+
+void DRV8316_SIM_getCounters(DRV8316_SIM_Counters *counters)
+{
+    if(counters != NULL)
+    {
+        *counters = s_sim.counters;
+    }
+}
+
+void DRV8316_SIM_clearCounters(void)
+{
+    memset(&s_sim.counters, 0, sizeof(s_sim.counters));
+}
+
+void DRV8316_SIM_countRxPoll(void)
+{
+    s_sim.counters.rxPolls++;
+}
+
+void DRV8316_SIM_countCsAssert(void)
+{
+    s_sim.counters.csAsserts++;
+}
+
+void DRV8316_SIM_advance(uint32_t cycles)
+{
+    s_sim.now += cycles;
+    s_sim.counters.elapsedCycles += cycles;
+}
+
+uint32_t DRV8316_SIM_now(void)
+{
+    return s_sim.now;
+}
+
+void SysCtl_delay(uint32_t count)
+{
+    uint32_t cycles = (5U * count) + 9U;
+
+    s_sim.counters.delayCycles += cycles;
+    DRV8316_SIM_advance(cycles);
+}
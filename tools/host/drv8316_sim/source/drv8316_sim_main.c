@@ -0,0 +1,193 @@
+/**
+ * @file drv8316_sim_main.c
+ * @brief 在主机上以 DRV8316 行为模型运行真实驱动代码。
+ *
+ * 依次调用 drv8316s.c 中的各个接口，输出每次调用产生的 SPI 帧数、RX FIFO 轮询
+ * 次数、延时周期数与模拟耗时，并检查寄存器锁定、故障注入与校验错误的处理结果。
+ * 任一检查失败时返回非零值。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "drv8316s.h"
+#include "drv8316_sim.h"
+
+/** 模拟的片选与使能引脚编号。 */
+#define SIM_CS_GPIO     (11U)
+#define SIM_EN_GPIO     (12U)
+
+static DRV8316_Obj    s_drvObj;
+static DRV8316_VARS_t s_drvVars;
+static uint16_t       s_failures = 0U;
+
+/**
+ * @brief 输出自上次清零以来的计数，并清零以便统计下一次调用。
+ */
+static void SIM_report(const char *api)
+{
+    DRV8316_SIM_Counters counters;
+
+    DRV8316_SIM_getCounters(&counters);
+
+    printf("%-28s frames=%3lu (r%3lu/w%3lu) rxPolls=%6lu delay=%8lu cyc time=%9lu ns cs=%3lu\n",
+           api,
+           (unsigned long)counters.frames,
+           (unsigned long)counters.readFrames,
+           (unsigned long)counters.writeFrames,
+           (unsigned long)counters.rxPolls,
+           (unsigned long)counters.delayCycles,
+           (unsigned long)DRV8316_SIM_cyclesToNs(counters.elapsedCycles),
+           (unsigned long)counters.csAsserts);
+
+    DRV8316_SIM_clearCounters();
+}
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+/**
+ * @brief 逐个验证 buildCtrlWord 生成的帧均满足偶校验，且读帧表与之一致。
+ */
+static void SIM_checkFrameParity(void)
+{
+    uint16_t address;
+    uint16_t data;
+
+    for(address = 0U; address < 0x20U; address++)
+    {
+        for(data = 0U; data < 0x100U; data++)
+        {
+            uint16_t word = DRV8316_buildCtrlWord(DRV8316_CTRLMODE_WRITE,
+                                                  (DRV8316_Address_e)(address << 9),
+                                                  data);
+            uint16_t ones = 0U;
+
+            while(word != 0U)
+            {
+                ones = (uint16_t)(ones + (word & 1U));
+                word >>= 1;
+            }
+
+            if((ones & 1U) != 0U)
+            {
+                SIM_check(false, "buildCtrlWord parity");
+                return;
+            }
+        }
+
+        SIM_check(DRV8316_buildReadWord((DRV8316_Address_e)(address << 9)) ==
+                  DRV8316_buildCtrlWord(DRV8316_CTRLMODE_READ, (DRV8316_Address_e)(address << 9), 0U),
+                  "read frame table");
+    }
+}
+
+int main(void)
+{
+    DRV8316_Handle handle;
+    DRV8316_SIM_Counters counters;
+
+    DRV8316_SIM_reset();
+    GPIO_SIM_setChipSelectPin(SIM_CS_GPIO);
+
+    SIM_checkFrameParity();
+
+    handle = DRV8316_init(&s_drvObj);
+    DRV8316_setSPIHandle(handle, 0U);
+    DRV8316_setGPIOCSNumber(handle, SIM_CS_GPIO);
+    DRV8316_setGPIOENNumber(handle, SIM_EN_GPIO);
+    SIM_report("DRV8316_init");
+
+    DRV8316_setupSPI(handle, &s_drvVars);
+    SIM_report("DRV8316_setupSPI");
+
+    DRV8316_enable(handle);
+    SIM_check(!s_drvObj.enableTimeOut, "enable without fault");
+    SIM_check(DRV8316_SIM_getReg(DRV8316_SIM_ADDR_CONTROL_1) == DRV8316_SIM_REG_UNLOCK,
+              "enable unlocks registers");
+    SIM_report("DRV8316_enable");
+
+    s_drvVars.readCmd = true;
+    DRV8316_readData(handle, &s_drvVars);
+    SIM_report("DRV8316_readData");
+
+    s_drvVars.ctrlReg03.all = 0x12U;
+    s_drvVars.ctrlReg06.all = 0x05U;
+    s_drvVars.writeCmd = true;
+    DRV8316_writeData(handle, &s_drvVars);
+    SIM_check(DRV8316_SIM_getReg(0x05U) == 0x12U, "writeData CONTROL_3");
+    SIM_check(DRV8316_SIM_getReg(0x08U) == 0x05U, "writeData CONTROL_6");
+    SIM_report("DRV8316_writeData");
+
+    (void)DRV8316_readSPI(handle, DRV8316_ADDRESS_STATUS_0);
+    SIM_report("DRV8316_readSPI");
+
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_5, 0x01U);
+    SIM_report("DRV8316_writeSPI");
+
+    /* 锁定后写入应被忽略，解锁后恢复。 */
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_1, DRV8316_SIM_REG_LOCK);
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_3, 0x34U);
+    SIM_check(DRV8316_SIM_isLocked(), "lock with 110b");
+    SIM_check(DRV8316_SIM_getReg(0x05U) == 0x12U, "locked write ignored");
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_1, DRV8316_SIM_REG_UNLOCK);
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_3, 0x34U);
+    SIM_check(DRV8316_SIM_getReg(0x05U) == 0x34U, "unlocked write applied");
+    DRV8316_SIM_getCounters(&counters);
+    SIM_check(counters.lockedWrites == 1U, "locked write counted");
+    SIM_report("lock/unlock sequence");
+
+    /* 瞬态过流故障：读回后由 CLR_FLT 清除。 */
+    DRV8316_SIM_injectFault(DRV8316_OCP, DRV8316_OCP_HA, 0U, false);
+    s_drvVars.readCmd = true;
+    DRV8316_readData(handle, &s_drvVars);
+    SIM_check((s_drvVars.statReg00.all & (DRV8316_FAULT | DRV8316_OCP)) ==
+              (DRV8316_FAULT | DRV8316_OCP), "OCP fault reported");
+    SIM_check(s_drvVars.statReg01.all == DRV8316_OCP_HA, "OCP_HA reported");
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_2, 0x01U);
+    SIM_check(DRV8316_SIM_getReg(DRV8316_SIM_ADDR_STATUS_0) == 0U, "CLR_FLT clears fault");
+    SIM_report("fault inject + CLR_FLT");
+
+    /* 持续故障在 CLR_FLT 后立即重新锁存。 */
+    DRV8316_SIM_injectFault(DRV8316_OT, 0U, 0U, true);
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_2, 0x01U);
+    SIM_check((DRV8316_SIM_getReg(DRV8316_SIM_ADDR_STATUS_0) & DRV8316_OT) != 0U,
+              "persistent fault relatched");
+    DRV8316_SIM_releaseFaults();
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_2, 0x01U);
+    SIM_check(DRV8316_SIM_getReg(DRV8316_SIM_ADDR_STATUS_0) == 0U, "released fault cleared");
+    SIM_report("persistent fault");
+
+    /* 校验错误的写帧被丢弃并锁存 SPI_PARITY。 */
+    DRV8316_SIM_corruptFrames(1U);
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_3, 0x56U);
+    SIM_check(DRV8316_SIM_getReg(0x05U) == 0x34U, "corrupted write dropped");
+    SIM_check((DRV8316_SIM_getReg(DRV8316_SIM_ADDR_STATUS_2) & DRV8316_SPI_PARITY) != 0U,
+              "parity fault latched");
+    DRV8316_SIM_getCounters(&counters);
+    SIM_check(counters.parityErrors == 1U, "parity error counted");
+    SIM_report("parity error");
+
+    /* 读帧受干扰时驱动应重发并累计该寄存器的错误次数。 */
+    DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_2, 0x01U);
+    (void)DRV8316_readSPI(handle, DRV8316_ADDRESS_STATUS_0);
+    DRV8316_SIM_clearCounters();
+    DRV8316_SIM_corruptFrames(1U);
+    SIM_check(DRV8316_readSPI(handle, DRV8316_ADDRESS_CONTROL_3) == 0x34U, "read retried");
+    SIM_check(DRV8316_getRxErrorCount(handle, DRV8316_ADDRESS_CONTROL_3) == 1U,
+              "read error counted");
+    SIM_check(!s_drvObj.rxError, "retry recovered");
+    DRV8316_SIM_getCounters(&counters);
+    SIM_check(counters.readFrames == 2U, "one retry frame");
+    SIM_report("corrupted read + retry");
+
+    printf("%s (%u failure(s))\n", (s_failures == 0U) ? "PASS" : "FAIL", s_failures);
+
+    return (s_failures == 0U) ? 0 : 1;
+}
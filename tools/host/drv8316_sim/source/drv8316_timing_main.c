@@ -0,0 +1,80 @@
+/**
+ * @file drv8316_timing_main.c
+ * @brief 在主机上估算 DRV8316 单次 SPI 传输耗时。
+ *
+ * 以 100 MHz SYSCLK 分别在 1、5、10 MHz 波特率下运行真实驱动，输出单次读、
+ * 单次写以及一次完整寄存器扫描（DRV8316_readData）的模拟耗时，并给出总线实际
+ * 占用（16 bit 帧时间）所占的比例。
+ */
+
+#include <stdio.h>
+
+#include "drv8316s.h"
+#include "drv8316_sim.h"
+
+#define SIM_SYSCLK_HZ   (100000000UL)
+#define SIM_CS_GPIO     (11U)
+
+static const uint32_t s_bitRates[] = { 1000000UL, 5000000UL, 10000000UL };
+
+static DRV8316_Obj    s_drvObj;
+static DRV8316_VARS_t s_drvVars;
+
+/**
+ * @brief 读取并清零计数，返回本次调用的耗时（ns）。
+ */
+static uint32_t SIM_takeElapsedNs(void)
+{
+    DRV8316_SIM_Counters counters;
+
+    DRV8316_SIM_getCounters(&counters);
+    DRV8316_SIM_clearCounters();
+
+    return DRV8316_SIM_cyclesToNs(counters.elapsedCycles);
+}
+
+int main(void)
+{
+    uint16_t index;
+
+    printf("%8s %10s %10s %10s %12s %8s\n",
+           "bitrate", "frame(ns)", "read(ns)", "write(ns)", "scan10(ns)", "bus(%)");
+
+    for(index = 0U; index < (sizeof(s_bitRates) / sizeof(s_bitRates[0])); index++)
+    {
+        DRV8316_Handle handle;
+        uint32_t readNs;
+        uint32_t writeNs;
+        uint32_t scanNs;
+
+        DRV8316_SIM_setBusTiming(SIM_SYSCLK_HZ, s_bitRates[index]);
+        DRV8316_SIM_reset();
+        GPIO_SIM_setChipSelectPin(SIM_CS_GPIO);
+
+        handle = DRV8316_init(&s_drvObj);
+        DRV8316_setSPIHandle(handle, 0U);
+        DRV8316_setGPIOCSNumber(handle, SIM_CS_GPIO);
+        DRV8316_setTiming(handle, SIM_SYSCLK_HZ, s_bitRates[index]);
+        DRV8316_SIM_clearCounters();
+
+        (void)DRV8316_readSPI(handle, DRV8316_ADDRESS_STATUS_0);
+        readNs = SIM_takeElapsedNs();
+
+        DRV8316_writeSPI(handle, DRV8316_ADDRESS_CONTROL_3, 0x12U);
+        writeNs = SIM_takeElapsedNs();
+
+        s_drvVars.readCmd = true;
+        DRV8316_readData(handle, &s_drvVars);
+        scanNs = SIM_takeElapsedNs();
+
+        printf("%5lu MHz %10lu %10lu %10lu %12lu %7lu%%\n",
+               (unsigned long)(s_bitRates[index] / 1000000UL),
+               (unsigned long)s_drvObj.timing.frameTimeNs,
+               (unsigned long)readNs,
+               (unsigned long)writeNs,
+               (unsigned long)scanNs,
+               (unsigned long)((100UL * s_drvObj.timing.frameTimeNs) / readNs));
+    }
+
+    return 0;
+}
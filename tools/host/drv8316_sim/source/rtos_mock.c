@@ -0,0 +1,106 @@
+/**
+ * @file rtos_mock.c
+ * @brief 主机端 FreeRTOS 替身的实现：模拟节拍、静态队列与互斥量。
+ *
+ * 维护任务与调用者在同一线程中顺序执行，队列只需环形缓冲，互斥量只检查
+ * 加锁与解锁是否配对。
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+static TickType_t s_tick = 0U;
+
+TickType_t xTaskGetTickCount(void)
+{
+    return s_tick;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    s_tick += ticks;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t itemSize,
+                                 uint8_t *storage, StaticQueue_t *buffer)
+{
+    buffer->storage  = storage;
+    buffer->length   = length;
+    buffer->itemSize = itemSize;
+    buffer->head     = 0U;
+    buffer->count    = 0U;
+
+    return buffer;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t wait)
+{
+    UBaseType_t tail;
+
+    (void)wait;
+
+    if(queue->count >= queue->length)
+    {
+        return pdFAIL;
+    }
+
+    tail = (queue->head + queue->count) % queue->length;
+    memcpy(&queue->storage[tail * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait)
+{
+    (void)wait;
+
+    if(queue->count == 0U)
+    {
+        return pdFAIL;
+    }
+
+    memcpy(item, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1U) % queue->length;
+    queue->count--;
+
+    return pdPASS;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+    return queue->length - queue->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer)
+{
+    buffer->taken = pdFALSE;
+
+    return buffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t wait)
+{
+    (void)wait;
+
+    /* 单线程下重复加锁即为死锁。 */
+    if(mutex->taken != pdFALSE)
+    {
+        return pdFAIL;
+    }
+
+    mutex->taken = pdTRUE;
+
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex)
+{
+    mutex->taken = pdFALSE;
+
+    return pdPASS;
+}
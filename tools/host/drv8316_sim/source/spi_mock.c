@@ -0,0 +1,163 @@
+/**
+ * @file spi_mock.c
+ * @brief 主机端 SPI/GPIO 替身实现，将驱动发出的帧转交 DRV8316 行为模型。
+ *
+ * 模拟 RX FIFO 深度为 16 字。每发送一帧，应答在模拟时钟推进一帧传输时间后才
+ * 进入 FIFO；每次轮询 SPI_getRxFIFOStatus 都会推进模拟时钟，以此复现驱动中的
+ * 忙等待并得到每次传输的耗时。
+ */
+
+#include "spi.h"
+#include "gpio.h"
+
+/** 模拟 RX FIFO 深度，与 F28004x SPI FIFO 一致。 */
+#define SPI_SIM_FIFO_DEPTH      (16U)
+
+static uint16_t s_rxFifo[SPI_SIM_FIFO_DEPTH];
+static uint16_t s_rxCount       = 0U;
+/** 已发送但尚未进入 FIFO 的应答数量。 */
+static uint16_t s_rxPending     = 0U;
+/** 挂起应答进入 FIFO 的模拟时刻。 */
+static uint32_t s_rxReadyCycle  = 0U;
+
+static uint32_t s_pinLevel[GPIO_SIM_PIN_COUNT];
+static uint32_t s_csPin         = 0xFFFFFFFFUL;
+
+/**
+ * @brief 模拟时钟到达应答时刻后，将挂起应答移入 FIFO。
+ */
+static void SPI_SIM_updateFifo(bool force)
+{
+    if((s_rxPending == 0U) ||
+       (!force && ((int32_t)(DRV8316_SIM_now() - s_rxReadyCycle) < 0)))
+    {
+        return;
+    }
+
+    s_rxCount   = (uint16_t)(s_rxCount + s_rxPending);
+    s_rxPending = 0U;
+
+    if(s_rxCount > SPI_SIM_FIFO_DEPTH)
+    {
+        s_rxCount = SPI_SIM_FIFO_DEPTH;
+    }
+}
+
+void SPI_resetRxFIFO(uint32_t base)
+{
+    (void)base;
+
+    DRV8316_SIM_advance(DRV8316_SIM_SPI_WRITE_CYCLES);
+
+    s_rxCount   = 0U;
+    s_rxPending = 0U;
+}
+
+void SPI_enableFIFO(uint32_t base)
+{
+    (void)base;
+
+    DRV8316_SIM_advance(DRV8316_SIM_SPI_WRITE_CYCLES);
+}
+
+void SPI_writeDataBlockingNonFIFO(uint32_t base, uint16_t data)
+{
+    uint16_t response;
+
+    (void)base;
+
+    DRV8316_SIM_advance(DRV8316_SIM_SPI_WRITE_CYCLES);
+
+    response = DRV8316_SIM_transfer(data);
+
+    /* 阻塞写在上一帧移出后才返回，先前挂起的应答此时必然已经到达。 */
+    if(s_rxPending != 0U)
+    {
+        int32_t remain = (int32_t)(s_rxReadyCycle - DRV8316_SIM_now());
+
+        if(remain > 0)
+        {
+            DRV8316_SIM_advance((uint32_t)remain);
+        }
+
+        SPI_SIM_updateFifo(true);
+    }
+
+    if(s_rxCount < SPI_SIM_FIFO_DEPTH)
+    {
+        s_rxFifo[s_rxCount] = response;
+    }
+
+    s_rxPending    = 1U;
+    s_rxReadyCycle = DRV8316_SIM_now() + DRV8316_SIM_getFrameCycles();
+}
+
+uint16_t SPI_readDataNonBlocking(uint32_t base)
+{
+    uint16_t data;
+    uint16_t index;
+
+    (void)base;
+
+    DRV8316_SIM_advance(DRV8316_SIM_POLL_CYCLES);
+    SPI_SIM_updateFifo(false);
+
+    if(s_rxCount == 0U)
+    {
+        return 0U;
+    }
+
+    data = s_rxFifo[0];
+
+    for(index = 1U; index < s_rxCount; index++)
+    {
+        s_rxFifo[index - 1U] = s_rxFifo[index];
+    }
+
+    s_rxCount--;
+
+    return data;
+}
+
+SPI_RxFIFOLevel SPI_getRxFIFOStatus(uint32_t base)
+{
+    (void)base;
+
+    DRV8316_SIM_countRxPoll();
+    DRV8316_SIM_advance(DRV8316_SIM_POLL_CYCLES);
+    SPI_SIM_updateFifo(false);
+
+    return (SPI_RxFIFOLevel)s_rxCount;
+}
+
+void GPIO_writePin(uint32_t pin, uint32_t outVal)
+{
+    if(pin >= GPIO_SIM_PIN_COUNT)
+    {
+        return;
+    }
+
+    DRV8316_SIM_advance(DRV8316_SIM_GPIO_WRITE_CYCLES);
+
+    if((pin == s_csPin) && (outVal == 0U) && (s_pinLevel[pin] != 0U))
+    {
+        DRV8316_SIM_countCsAssert();
+    }
+
+    s_pinLevel[pin] = outVal;
+}
+
+uint32_t GPIO_SIM_readPin(uint32_t pin)
+{
+    return (pin < GPIO_SIM_PIN_COUNT) ? s_pinLevel[pin] : 0U;
+}
+
+void GPIO_SIM_setChipSelectPin(uint32_t pin)
+{
+    s_csPin = pin;
+
+    if(pin < GPIO_SIM_PIN_COUNT)
+    {
+        s_pinLevel[pin] = 1U;
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * @file eqep_encoder_sim.h
+ * @brief DRV_EQEP_PORT_* 的主机实现：增量编码器与 eQEP1 的时间步进模型。
+ *
+ * 每步 EQEP_ENCODER_SIM_STEP_CYCLES 个 SYSCLK 周期，模型包括：
+ *  - 转轴位置（计数，浮点），按给定的转速曲线积分，每跨过一个整数即一个计数边沿；
+ *  - 零位脉冲在转轴计数对每转计数取模为 0 的一格内为高，上升沿锁存计数器，正转时
+ *    复位为 0、反转时复位为最大值；计数器在 0 与最大值之间回绕；
+ *  - 捕获定时器按 SYSCLK/128 计数，饱和于 0xFFFF 并置溢出标志；每 4 个计数边沿
+ *    一次捕获事件，装入周期并清零定时器，期间方向改变置方向错误标志；
+ *  - 单位定时器超时锁存位置、捕获周期与捕获定时器；
+ *  - 中断标志在每步结束时按 drv_eqep_port.c 的中断服务程序处理。
+ */
+
+#ifndef EQEP_ENCODER_SIM_H
+#define EQEP_ENCODER_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_eqep.h"
+
+/** 每个模拟步的 SYSCLK 周期数，捕获时钟为 8 步，单位周期为 6250 步。 */
+#define EQEP_ENCODER_SIM_STEP_CYCLES    (16U)
+
+/** 每个单位超时中断处理之后调用，参数为当时的真实转速与转轴位置。 */
+typedef void (*EQEP_ENCODER_SIM_Observer)(double speedRps, double shaftCounts);
+
+/** 清除模型状态，转轴位于 shaftCounts，计数器为 0。 */
+void EQEP_ENCODER_SIM_reset(double shaftCounts);
+
+/** 设置单位超时观察者，NULL 表示不观察。 */
+void EQEP_ENCODER_SIM_setObserver(EQEP_ENCODER_SIM_Observer observer);
+
+/**
+ * @brief 运行 seconds 秒，转速从 startRps 线性变化到 endRps（转/秒）。
+ */
+void EQEP_ENCODER_SIM_run(double startRps, double endRps, double seconds);
+
+/** 之后的 counts 个计数边沿不计入计数器，模拟干扰造成的丢计数。 */
+void EQEP_ENCODER_SIM_dropCounts(uint16_t counts);
+
+/** 当前转轴位置（计数）。 */
+double EQEP_ENCODER_SIM_shaft(void);
+
+#endif /* EQEP_ENCODER_SIM_H */
@@ -0,0 +1,274 @@
+/**
+ * @file eqep_encoder_sim.c
+ * @brief 增量编码器与 eQEP1 的时间步进模型。
+ */
+
+#include <math.h>
+#include <stddef.h>
+
+#include "eqep_encoder_sim.h"
+
+#define SIM_SYSCLK_HZ           (100000000.0)
+#define SIM_CAP_STEPS           (DRV_EQEP_CAPCLK_DIV / EQEP_ENCODER_SIM_STEP_CYCLES)
+#define SIM_UNIT_STEPS          (DRV_EQEP_UNIT_PERIOD_CYCLES / EQEP_ENCODER_SIM_STEP_CYCLES)
+#define SIM_POSMAX              (DRV_EQEP_COUNTS_PER_REV - 1UL)
+
+/** 中断标志。 */
+#define SIM_INT_UNIT_TIMEOUT    (0x0001U)
+#define SIM_INT_INDEX           (0x0002U)
+
+/** 编码器。 */
+static double  s_shaft = 0.0;
+static double  s_speed = 0.0;
+static int64_t s_state = 0;
+static uint16_t s_drop = 0U;
+
+/** 位置计数器与锁存。 */
+static uint32_t s_counter = 0U;
+static uint32_t s_positionLatch = 0U;
+static uint32_t s_indexLatch = 0U;
+static bool     s_forward = true;
+
+/** 捕获单元。 */
+static uint16_t s_capDivider = 0U;
+static uint16_t s_prescaler = 0U;
+static uint16_t s_timer = 0U;
+static uint16_t s_period = 0U;
+static uint16_t s_timerLatch = 0U;
+static uint16_t s_periodLatch = 0U;
+static bool     s_overflow = false;
+static bool     s_dirError = false;
+static bool     s_dirChanged = false;
+
+/** 单位定时器与中断。 */
+static uint32_t s_unitSteps = 0U;
+static uint16_t s_intFlags = 0U;
+
+static EQEP_ENCODER_SIM_Observer s_observer = NULL;
+
+/**
+ * @brief 非负取模，转轴计数可以为负。
+ */
+static uint32_t EQEP_ENCODER_SIM_modRev(int64_t value)
+{
+    int64_t rev = (int64_t)DRV_EQEP_COUNTS_PER_REV;
+
+    return (uint32_t)(((value % rev) + rev) % rev);
+}
+
+/**
+ * @brief 一个计数边沿，转轴进入格 state。
+ */
+static void EQEP_ENCODER_SIM_edge(bool forward, int64_t state)
+{
+    if(forward != s_forward)
+    {
+        s_dirChanged = true;
+        s_forward = forward;
+    }
+
+    if(s_drop != 0U)
+    {
+        /* 丢失的边沿既不计数也不进入捕获预分频。 */
+        s_drop--;
+    }
+    else
+    {
+        if(forward)
+        {
+            s_counter = (s_counter >= SIM_POSMAX) ? 0U : (s_counter + 1U);
+        }
+        else
+        {
+            s_counter = (s_counter == 0U) ? SIM_POSMAX : (s_counter - 1U);
+        }
+
+        s_prescaler++;
+
+        if(s_prescaler >= DRV_EQEP_UPEVNT_COUNTS)
+        {
+            s_prescaler = 0U;
+            s_period = s_timer;
+            s_timer = 0U;
+
+            if(s_dirChanged)
+            {
+                s_dirError = true;
+                s_dirChanged = false;
+            }
+        }
+    }
+
+    /* 零位脉冲上升沿：锁存后按方向复位。 */
+    if(EQEP_ENCODER_SIM_modRev(state) == 0U)
+    {
+        s_indexLatch = s_counter;
+        s_counter = forward ? 0U : SIM_POSMAX;
+        s_intFlags |= SIM_INT_INDEX;
+    }
+}
+
+/**
+ * @brief 与 drv_eqep_port.c 的 DRV_EQEP_isr 相同的处理。
+ */
+static void EQEP_ENCODER_SIM_isr(void)
+{
+    uint16_t flags = s_intFlags;
+    uint16_t events = 0U;
+    DRV_EQEP_Latch latch;
+
+    latch.position      = s_positionLatch;
+    latch.indexPosition = s_indexLatch;
+    latch.capturePeriod = s_periodLatch;
+    latch.captureTimer  = s_timerLatch;
+    latch.status        = 0U;
+
+    if(s_forward)
+    {
+        latch.status |= DRV_EQEP_STS_FORWARD;
+    }
+
+    if(s_overflow)
+    {
+        latch.status |= DRV_EQEP_STS_CAP_OVERFLOW;
+    }
+
+    if(s_dirError)
+    {
+        latch.status |= DRV_EQEP_STS_CAP_DIR_ERROR;
+    }
+
+    if((flags & SIM_INT_INDEX) != 0U)
+    {
+        events |= DRV_EQEP_EVT_INDEX;
+    }
+
+    if((flags & SIM_INT_UNIT_TIMEOUT) != 0U)
+    {
+        events |= DRV_EQEP_EVT_UNIT_TIMEOUT;
+        s_overflow = false;
+        s_dirError = false;
+    }
+
+    DRV_EQEP_onEvents(events, &latch);
+
+    s_intFlags = 0U;
+
+    if(((flags & SIM_INT_UNIT_TIMEOUT) != 0U) && (s_observer != NULL))
+    {
+        s_observer(s_speed, s_shaft);
+    }
+}
+
+void EQEP_ENCODER_SIM_reset(double shaftCounts)
+{
+    s_shaft = shaftCounts;
+    s_speed = 0.0;
+    s_state = (int64_t)floor(shaftCounts);
+    s_drop = 0U;
+
+    s_counter = 0U;
+    s_positionLatch = 0U;
+    s_indexLatch = 0U;
+    s_forward = true;
+
+    s_capDivider = 0U;
+    s_prescaler = 0U;
+    s_timer = 0U;
+    s_period = 0U;
+    s_timerLatch = 0U;
+    s_periodLatch = 0U;
+    s_overflow = false;
+    s_dirError = false;
+    s_dirChanged = false;
+
+    s_unitSteps = 0U;
+    s_intFlags = 0U;
+    s_observer = NULL;
+}
+
+void EQEP_ENCODER_SIM_setObserver(EQEP_ENCODER_SIM_Observer observer)
+{
+    s_observer = observer;
+}
+
+void EQEP_ENCODER_SIM_run(double startRps, double endRps, double seconds)
+{
+    double dt = (double)EQEP_ENCODER_SIM_STEP_CYCLES / SIM_SYSCLK_HZ;
+    uint32_t steps = (uint32_t)((seconds / dt) + 0.5);
+    uint32_t i;
+
+    for(i = 0U; i < steps; i++)
+    {
+        int64_t state;
+
+        s_speed = startRps + ((endRps - startRps) * (double)(i + 1U) / (double)steps);
+        s_shaft += s_speed * (double)DRV_EQEP_COUNTS_PER_REV * dt;
+        state = (int64_t)floor(s_shaft);
+
+        while(s_state < state)
+        {
+            s_state++;
+            EQEP_ENCODER_SIM_edge(true, s_state);
+        }
+
+        while(s_state > state)
+        {
+            /* 反转时从格 s_state 进入格 s_state - 1。 */
+            s_state--;
+            EQEP_ENCODER_SIM_edge(false, s_state);
+        }
+
+        s_capDivider++;
+
+        if(s_capDivider >= SIM_CAP_STEPS)
+        {
+            s_capDivider = 0U;
+
+            if(s_timer == 0xFFFFU)
+            {
+                s_overflow = true;
+            }
+            else
+            {
+                s_timer++;
+            }
+        }
+
+        s_unitSteps++;
+
+        if(s_unitSteps >= SIM_UNIT_STEPS)
+        {
+            s_unitSteps = 0U;
+            s_positionLatch = s_counter;
+            s_periodLatch = s_period;
+            s_timerLatch = s_timer;
+            s_intFlags |= SIM_INT_UNIT_TIMEOUT;
+        }
+
+        if(s_intFlags != 0U)
+        {
+            EQEP_ENCODER_SIM_isr();
+        }
+    }
+}
+
+void EQEP_ENCODER_SIM_dropCounts(uint16_t counts)
+{
+    s_drop = counts;
+}
+
+double EQEP_ENCODER_SIM_shaft(void)
+{
+    return s_shaft;
+}
+
+bool DRV_EQEP_PORT_init(void)
+{
+    return true;
+}
+
+uint32_t DRV_EQEP_PORT_getPosition(void)
+{
+    return s_counter;
+}
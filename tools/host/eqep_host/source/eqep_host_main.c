@@ -0,0 +1,390 @@
+/**
+ * @file eqep_host_main.c
+ * @brief 在编码器模型上运行 drv_eqep.c，检查全速度范围的测速精度与方法选择、加减速、
+ *        停止、反转、电角度、零位误差与第一个零位。任一检查失败时返回非零值。
+ *
+ * 观察者在每个单位超时中断之后比较 DRV_EQEP_output.speedRps 与真实转速，允许的误差
+ * 为相对误差加绝对误差，相对误差覆盖两种方法在切换点附近约 2% 的量化。
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "drv_eqep.h"
+#include "eqep_encoder_sim.h"
+
+/** 测速允许的相对误差。 */
+#define SIM_SPEED_TOLERANCE     (0.025)
+
+/** 电角度允许的误差：两个计数。 */
+#define SIM_ANGLE_TOLERANCE     (2.0 * (double)DRV_EQEP_POLE_PAIRS / (double)DRV_EQEP_COUNTS_PER_REV)
+
+#define SIM_MODE_ANY            (-1)
+
+static unsigned int s_failures = 0U;
+
+/** 观察者的检查条件。 */
+static uint32_t s_ignore = 0U;
+static double   s_absTolerance = 0.0;
+static double   s_minSpeed = 0.0;
+static int      s_expectMode = SIM_MODE_ANY;
+
+/** 观察者的结果。 */
+static uint32_t s_samples = 0U;
+static uint32_t s_speedErrors = 0U;
+static uint32_t s_signErrors = 0U;
+static uint32_t s_modeErrors = 0U;
+static double   s_worst = 0.0;
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+static void SIM_observer(double speedRps, double shaftCounts)
+{
+    double measured = (double)DRV_EQEP_output.speedRps;
+    double error = fabs(measured - speedRps);
+    double limit = (SIM_SPEED_TOLERANCE * fabs(speedRps)) + s_absTolerance;
+
+    (void)shaftCounts;
+
+    s_samples++;
+
+    if((s_samples <= s_ignore) || (fabs(speedRps) < s_minSpeed))
+    {
+        return;
+    }
+
+    if(error > limit)
+    {
+        s_speedErrors++;
+
+        if((error - limit) > s_worst)
+        {
+            s_worst = error - limit;
+        }
+    }
+
+    if((measured * speedRps) <= 0.0)
+    {
+        s_signErrors++;
+    }
+
+    if((s_expectMode != SIM_MODE_ANY) && (DRV_EQEP_output.mode != (uint16_t)s_expectMode))
+    {
+        s_modeErrors++;
+    }
+}
+
+/**
+ * @brief 重新初始化模型与驱动，转轴位于 shaftCounts，开始观察。
+ */
+static void SIM_setup(double shaftCounts, uint32_t ignore, double absTolerance, int expectMode)
+{
+    EQEP_ENCODER_SIM_reset(shaftCounts);
+    SIM_check(DRV_EQEP_init(), "init");
+
+    s_ignore       = ignore;
+    s_absTolerance = absTolerance;
+    s_minSpeed     = 0.0;
+    s_expectMode   = expectMode;
+    s_samples      = 0U;
+    s_speedErrors  = 0U;
+    s_signErrors   = 0U;
+    s_modeErrors   = 0U;
+    s_worst        = 0.0;
+
+    EQEP_ENCODER_SIM_setObserver(SIM_observer);
+}
+
+static void SIM_report(const char *name)
+{
+    if((s_speedErrors != 0U) || (s_signErrors != 0U) || (s_modeErrors != 0U))
+    {
+        printf("%s: %lu samples, %lu speed, %lu sign, %lu mode errors, worst excess %.4f rps\n", name,
+               (unsigned long)s_samples, (unsigned long)s_speedErrors, (unsigned long)s_signErrors,
+               (unsigned long)s_modeErrors, s_worst);
+    }
+
+    SIM_check(s_speedErrors == 0U, name);
+    SIM_check(s_signErrors == 0U, name);
+    SIM_check(s_modeErrors == 0U, name);
+}
+
+/**
+ * @brief 电角度与转轴位置之差，回绕到 [-0.5, 0.5)。
+ */
+static double SIM_angleError(double offsetPu)
+{
+    double angle = (double)DRV_EQEP_updateAngle();
+    double truth = (EQEP_ENCODER_SIM_shaft() * (double)DRV_EQEP_POLE_PAIRS /
+                    (double)DRV_EQEP_COUNTS_PER_REV) + offsetPu;
+    double error = angle - (truth - floor(truth));
+
+    return error - floor(error + 0.5);
+}
+
+/**
+ * @brief 恒速：起步后的样本全部在允许误差内，且使用预期的测速方法。
+ */
+static void SIM_testConstant(double speedRps)
+{
+    double countsPerUnit = fabs(speedRps) * (double)DRV_EQEP_COUNTS_PER_REV / (double)DRV_EQEP_UNIT_HZ;
+    int mode = (countsPerUnit > (double)DRV_EQEP_TO_FREQ_COUNTS) ? (int)DRV_EQEP_MODE_FREQUENCY :
+                                                                  (int)DRV_EQEP_MODE_PERIOD;
+    char name[48];
+
+    (void)snprintf(name, sizeof(name), "constant %+.2f rps", speedRps);
+
+    /* 最低速度下前两个捕获事件约需 40 ms。 */
+    SIM_setup(1234.5, 60U, 0.0005, mode);
+    EQEP_ENCODER_SIM_run(speedRps, speedRps, 0.4);
+    SIM_report(name);
+}
+
+/**
+ * @brief 0 → 100 转/秒 → 0 的加减速：误差在范围内，上下各切换一次。
+ */
+static void SIM_testRamp(void)
+{
+    DRV_EQEP_Stats stats;
+
+    SIM_setup(100.5, 5U, 0.05, SIM_MODE_ANY);
+    s_minSpeed = 1.0;
+    EQEP_ENCODER_SIM_run(0.0, 100.0, 2.0);
+    EQEP_ENCODER_SIM_run(100.0, 0.0, 2.0);
+    SIM_report("ramp");
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.modeSwitches == 2U, "ramp: one switch each way");
+    SIM_check(DRV_EQEP_output.mode == (uint16_t)DRV_EQEP_MODE_PERIOD, "ramp: period mode at rest");
+}
+
+/**
+ * @brief 两个阈值之间保持当前方法：从高速减到 14 转/秒仍用频率法，从静止加到
+ *        14 转/秒仍用周期法；停在上阈值附近时只切换一次。
+ */
+static void SIM_testHysteresis(void)
+{
+    double edgeRps = ((double)DRV_EQEP_TO_FREQ_COUNTS + 0.4) * (double)DRV_EQEP_UNIT_HZ /
+                     (double)DRV_EQEP_COUNTS_PER_REV;
+    DRV_EQEP_Stats stats;
+
+    SIM_setup(100.5, 5U, 0.0005, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_run(20.0, 20.0, 0.1);
+    EQEP_ENCODER_SIM_run(20.0, 14.0, 0.1);
+    EQEP_ENCODER_SIM_run(14.0, 14.0, 0.2);
+    SIM_check(DRV_EQEP_output.mode == (uint16_t)DRV_EQEP_MODE_FREQUENCY, "hysteresis: keeps frequency");
+
+    SIM_setup(100.5, 5U, 0.0005, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_run(0.0, 14.0, 0.1);
+    EQEP_ENCODER_SIM_run(14.0, 14.0, 0.2);
+    SIM_check(DRV_EQEP_output.mode == (uint16_t)DRV_EQEP_MODE_PERIOD, "hysteresis: keeps period");
+
+    SIM_setup(100.5, 5U, 0.0005, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_run(edgeRps, edgeRps, 0.4);
+    SIM_report("hysteresis");
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.modeSwitches == 1U, "hysteresis: single switch");
+}
+
+/**
+ * @brief 停止：速度随捕获定时器单调下降，定时器溢出后为 0。
+ */
+static void SIM_testStop(void)
+{
+    DRV_EQEP_Stats stats;
+    float previous;
+    bool monotonic = true;
+    uint16_t i;
+
+    SIM_setup(100.5, 0U, 0.0, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_setObserver(NULL);
+    EQEP_ENCODER_SIM_run(2.0, 2.0, 0.2);
+    SIM_check(fabs(DRV_EQEP_output.speedRps - 2.0f) < 0.05f, "stop: running");
+
+    previous = DRV_EQEP_output.speedRps;
+
+    for(i = 0U; i < 100U; i++)
+    {
+        EQEP_ENCODER_SIM_run(0.0, 0.0, 0.001);
+
+        if(DRV_EQEP_output.speedRps > previous)
+        {
+            monotonic = false;
+        }
+
+        previous = DRV_EQEP_output.speedRps;
+
+        if(i == 19U)
+        {
+            SIM_check(DRV_EQEP_output.speedRps < 0.1f, "stop: decays within 20 ms");
+        }
+    }
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(monotonic, "stop: monotonic decay");
+    SIM_check(DRV_EQEP_output.speedRps == 0.0f, "stop: zero after overflow");
+    SIM_check(stats.captureOverflows > 0U, "stop: overflow counted");
+}
+
+/**
+ * @brief 反转：+5 → -5 转/秒，经过零点时符号正确，方向改变的样本被丢弃。
+ */
+static void SIM_testReversal(void)
+{
+    DRV_EQEP_Stats stats;
+
+    SIM_setup(100.5, 5U, 0.05, SIM_MODE_ANY);
+    s_minSpeed = 0.5;
+    EQEP_ENCODER_SIM_run(5.0, 5.0, 0.2);
+    EQEP_ENCODER_SIM_run(5.0, -5.0, 1.0);
+    EQEP_ENCODER_SIM_run(-5.0, -5.0, 0.2);
+    SIM_report("reversal");
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.captureDirErrors > 0U, "reversal: direction error counted");
+    SIM_check(fabs(DRV_EQEP_output.speedRps + 5.0f) < 0.1f, "reversal: final speed");
+}
+
+/**
+ * @brief 电角度：零位前未对齐，之后与转轴位置一致，偏移与反转后仍然一致。
+ */
+static void SIM_testAngle(void)
+{
+    double worst = 0.0;
+    double error;
+    uint16_t i;
+
+    SIM_setup(3000.5, 0U, 0.0, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_setObserver(NULL);
+
+    EQEP_ENCODER_SIM_run(3.0, 3.0, 0.05);
+    SIM_check(DRV_EQEP_output.aligned == 0U, "angle: not aligned before index");
+
+    EQEP_ENCODER_SIM_run(3.0, 3.0, 0.5);
+    SIM_check(DRV_EQEP_output.aligned != 0U, "angle: aligned after index");
+
+    for(i = 0U; i < 20U; i++)
+    {
+        EQEP_ENCODER_SIM_run(3.0, 3.0, 0.00037);
+        error = fabs(SIM_angleError(0.0));
+        worst = (error > worst) ? error : worst;
+    }
+
+    DRV_EQEP_setAngleOffset(1.25f);
+
+    for(i = 0U; i < 20U; i++)
+    {
+        EQEP_ENCODER_SIM_run(3.0, 3.0, 0.00037);
+        error = fabs(SIM_angleError(0.25));
+        worst = (error > worst) ? error : worst;
+    }
+
+    SIM_check(DRV_EQEP_output.anglePu >= 0.0f, "angle: in range");
+    SIM_check(DRV_EQEP_output.anglePu < 1.0f, "angle: in range");
+
+    EQEP_ENCODER_SIM_run(3.0, -3.0, 0.2);
+    EQEP_ENCODER_SIM_run(-3.0, -3.0, 0.5);
+
+    for(i = 0U; i < 20U; i++)
+    {
+        EQEP_ENCODER_SIM_run(-3.0, -3.0, 0.00037);
+        error = fabs(SIM_angleError(0.25));
+        worst = (error > worst) ? error : worst;
+    }
+
+    if(worst > SIM_ANGLE_TOLERANCE)
+    {
+        printf("angle: worst error %.5f pu\n", worst);
+    }
+
+    SIM_check(worst <= SIM_ANGLE_TOLERANCE, "angle: matches shaft");
+}
+
+/**
+ * @brief 丢计数：下一个零位报告偏差并由复位纠正。
+ */
+static void SIM_testIndexError(void)
+{
+    DRV_EQEP_Stats stats;
+
+    SIM_setup(100.5, 0U, 0.0, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_setObserver(NULL);
+    EQEP_ENCODER_SIM_run(5.0, 5.0, 0.5);
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.indexEvents >= 2U, "index: events");
+    SIM_check(stats.indexErrors == 0U, "index: no error without missed counts");
+
+    EQEP_ENCODER_SIM_dropCounts(3U);
+    EQEP_ENCODER_SIM_run(5.0, 5.0, 0.5);
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.indexErrors == 1U, "index: missed counts detected");
+    SIM_check(stats.lastIndexError == -3, "index: error value");
+
+    EQEP_ENCODER_SIM_run(5.0, 5.0, 0.5);
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.indexErrors == 1U, "index: corrected by reset");
+    SIM_check(fabs(SIM_angleError(0.0)) <= SIM_ANGLE_TOLERANCE, "index: angle after correction");
+}
+
+/**
+ * @brief 第一个零位复位计数器时不产生速度尖峰，也不误切换测速方法。
+ */
+static void SIM_testFirstIndex(double speedRps)
+{
+    DRV_EQEP_Stats stats;
+    char name[48];
+
+    (void)snprintf(name, sizeof(name), "first index %+.1f rps", speedRps);
+
+    SIM_setup(3500.5, 2U, 0.0005, SIM_MODE_ANY);
+    EQEP_ENCODER_SIM_run(speedRps, speedRps, 0.2);
+    SIM_report(name);
+
+    DRV_EQEP_getStats(&stats);
+    SIM_check(stats.indexEvents >= 1U, name);
+    SIM_check(stats.modeSwitches <= 1U, name);
+}
+
+int main(void)
+{
+    static const double speeds[] =
+    {
+        0.05, 0.2, 1.0, 5.0, 12.0, 14.0, 20.0, 50.0, 100.0,
+        -0.05, -3.0, -14.0, -40.0, -100.0
+    };
+    uint16_t i;
+
+    for(i = 0U; i < (uint16_t)(sizeof(speeds) / sizeof(speeds[0])); i++)
+    {
+        SIM_testConstant(speeds[i]);
+    }
+
+    SIM_testRamp();
+    SIM_testHysteresis();
+    SIM_testStop();
+    SIM_testReversal();
+    SIM_testAngle();
+    SIM_testIndexError();
+    SIM_testFirstIndex(20.0);
+    SIM_testFirstIndex(5.0);
+
+    if(s_failures != 0U)
+    {
+        printf("%u check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file fsi_link_mock.h
+ * @brief DRV_FSI_PORT_* 的主机实现：按 SYSCLK 周期推进的两板 FSI 链路模型。
+ *
+ * 模型包含本板与对端两个增减计数的 ePWM1 时基：
+ *  - 本板 TBPRD 可被 DRV_FSI_PORT_trimPeriod 微调，影子值在归零时装入，归零时调用
+ *    钩子函数（相当于控制中断）；
+ *  - 对端相对本板有可设的频率偏差（ppm）与初始相位，在每个顶点发出一帧，序号递增；
+ *  - 本板在每个顶点发出发送缓冲区中的帧，回环模式下由自己接收；发送缓冲区由软件
+ *    触发（保护窗口外）或帧完成事件从 DMA 源地址装入；
+ *  - 帧在顶点之后 FSI_LINK_MOCK_LATENCY 个周期到达，写入接收环形缓冲区的下一个槽，
+ *    槽首为到达时本板的 TBCTR 与计数方向；
+ *  - 接收端超过 DRV_FSI_PING_TIMEOUT_CYCLES 未收到帧时报告 Ping 看门狗超时；
+ *  - 可注入链路中断、下一帧硬件 CRC 错误（帧被丢弃）与下一帧写入后内存位翻转。
+ */
+
+#ifndef FSI_LINK_MOCK_H
+#define FSI_LINK_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_fsi.h"
+
+/** 标称 TBPRD：100 MHz、20 kHz 增减计数。 */
+#define FSI_LINK_MOCK_PERIOD        (2500U)
+
+/** 顶点到接收 DMA 完成的延迟。 */
+#define FSI_LINK_MOCK_LATENCY       (312U)
+
+/** 一帧的发送时间。 */
+#define FSI_LINK_MOCK_FRAME_CYCLES  (292U)
+
+/** 本板归零钩子。 */
+typedef void (*FSI_LINK_MOCK_Hook)(void);
+
+/** 清空模型状态，本板与对端计数器从 0 开始增计数。 */
+void FSI_LINK_MOCK_reset(void);
+
+/** 推进时间。 */
+void FSI_LINK_MOCK_run(uint32_t cycles);
+
+/** 设置本板归零钩子。 */
+void FSI_LINK_MOCK_setZeroHook(FSI_LINK_MOCK_Hook hook);
+
+/**
+ * @brief 使能对端主板。
+ *
+ * @param[in] ppm     对端时钟相对本板快多少 ppm，可为负。
+ * @param[in] counter 对端计数器初值（增计数）。
+ */
+void FSI_LINK_MOCK_setRemote(bool enabled, int32_t ppm, uint16_t counter);
+
+/** 中断或恢复链路。 */
+void FSI_LINK_MOCK_setBroken(bool broken);
+
+/** 下一帧以硬件 CRC 错误丢弃。 */
+void FSI_LINK_MOCK_injectHwCrcError(void);
+
+/** 下一帧写入接收缓冲区后翻转一位。 */
+void FSI_LINK_MOCK_injectCorruption(void);
+
+/** 本板发出的帧数与最近一帧。 */
+uint32_t FSI_LINK_MOCK_sentFrames(void);
+const uint16_t *FSI_LINK_MOCK_lastSent(void);
+
+/** 本板当前 TBPRD。 */
+uint16_t FSI_LINK_MOCK_localPeriod(void);
+
+/** 本板与对端归零时刻之差（周期），正值表示本板超前。 */
+int32_t FSI_LINK_MOCK_phaseOffset(void);
+
+#endif /* FSI_LINK_MOCK_H */
@@ -0,0 +1,386 @@
+/**
+ * @file fsi_host_main.c
+ * @brief 在链路模型上运行 drv_fsi.c，检查 CRC、回环收发与延迟测量、发送保护窗口、
+ *        从板锁相、数据错误、链路中断恢复与读者落后。任一检查失败时返回非零值。
+ *
+ * 钩子在本板计数器归零时执行，相当于控制中断：先 DRV_FSI_receive，再 DRV_FSI_send。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "drv_fsi.h"
+#include "fsi_link_mock.h"
+
+#define SIM_CYCLE           (2U * FSI_LINK_MOCK_PERIOD)
+
+static unsigned int s_failures = 0U;
+
+/** 钩子行为。 */
+static bool     s_hookSend = true;
+static uint16_t s_hookReadEvery = 1U;
+static uint16_t s_hookCount = 0U;
+static uint16_t s_sendCounter = 0U;
+
+/** 钩子观察到的结果。 */
+static uint32_t s_received = 0U;
+static uint32_t s_payloadErrors = 0U;
+static uint32_t s_orderErrors = 0U;
+static DRV_FSI_Frame s_last;
+static uint16_t s_first = 0U;
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+static int32_t SIM_abs(int32_t value)
+{
+    return (value < 0) ? -value : value;
+}
+
+/**
+ * @brief 回环：载荷第 0 字等于发送时的序号，其余字依次加 1。
+ */
+static void SIM_loopbackHook(void)
+{
+    DRV_FSI_Frame frame;
+    uint16_t payload[DRV_FSI_PAYLOAD_WORDS];
+    uint16_t i;
+
+    s_hookCount++;
+
+    if((s_hookCount % s_hookReadEvery) == 0U)
+    {
+        while(DRV_FSI_receive(&frame))
+        {
+            bool ok = (frame.payload[0] == frame.sequence);
+
+            for(i = 1U; i < DRV_FSI_PAYLOAD_WORDS; i++)
+            {
+                ok = ok && (frame.payload[i] == (uint16_t)(frame.payload[0] + i));
+            }
+
+            if(!ok && (frame.sequence != 0U))
+            {
+                s_payloadErrors++;
+            }
+
+            /* 每次读到的都是上一次归零时发送的帧。 */
+            if((s_hookReadEvery == 1U) && (frame.sequence != 0U) && (frame.sequence != s_sendCounter))
+            {
+                s_orderErrors++;
+            }
+
+            if(s_received == 0U)
+            {
+                s_first = frame.sequence;
+            }
+
+            s_last = frame;
+            s_received++;
+        }
+    }
+
+    if(s_hookSend)
+    {
+        s_sendCounter++;
+
+        for(i = 0U; i < DRV_FSI_PAYLOAD_WORDS; i++)
+        {
+            payload[i] = (uint16_t)(s_sendCounter + i);
+        }
+
+        (void)DRV_FSI_send(payload);
+    }
+}
+
+/**
+ * @brief 从板：只接收，载荷由对端按序号生成。
+ */
+static void SIM_slaveHook(void)
+{
+    DRV_FSI_Frame frame;
+
+    while(DRV_FSI_receive(&frame))
+    {
+        if(frame.payload[1] != (uint16_t)(frame.sequence * 16U + 1U))
+        {
+            s_payloadErrors++;
+        }
+
+        s_last = frame;
+        s_received++;
+    }
+}
+
+static void SIM_setup(FSI_LINK_MOCK_Hook hook)
+{
+    FSI_LINK_MOCK_reset();
+    FSI_LINK_MOCK_setZeroHook(hook);
+
+    s_hookSend      = true;
+    s_hookReadEvery = 1U;
+    s_hookCount     = 0U;
+    s_sendCounter   = 0U;
+    s_received      = 0U;
+    s_payloadErrors = 0U;
+    s_orderErrors   = 0U;
+    memset(&s_last, 0, sizeof(s_last));
+}
+
+static void SIM_runPeriods(uint32_t periods)
+{
+    FSI_LINK_MOCK_run(periods * SIM_CYCLE);
+}
+
+static void SIM_testCrc(void)
+{
+    const uint16_t data[4] = { 0x3132U, 0x3334U, 0x3536U, 0x3738U };
+
+    /* CRC-16/CCITT-FALSE("12345678")。 */
+    SIM_check(DRV_FSI_crc16(0xFFFFU, data, 4U) == 0xA12BU, "crc: reference value");
+}
+
+static uint16_t SIM_testLoopback(void)
+{
+    DRV_FSI_Stats stats;
+
+    SIM_setup(SIM_loopbackHook);
+    SIM_check(DRV_FSI_init(DRV_FSI_ROLE_MASTER, true), "loopback: init");
+    SIM_runPeriods(200U);
+    DRV_FSI_getStats(&stats);
+
+    SIM_check(s_received >= 199U, "loopback: one frame per period");
+    SIM_check(s_payloadErrors == 0U, "loopback: payload intact");
+    SIM_check(s_orderErrors == 0U, "loopback: frame sent at zero arrives before next zero");
+    SIM_check((stats.rxLost == 0U) && (stats.crcErrors == 0U) && (stats.torn == 0U), "loopback: no errors");
+    SIM_check(stats.linkUp && (stats.linkDowns == 0U), "loopback: link up");
+    SIM_check(stats.latency == FSI_LINK_MOCK_LATENCY, "loopback: latency measured");
+    SIM_check((stats.trim == 0) && (FSI_LINK_MOCK_localPeriod() == FSI_LINK_MOCK_PERIOD),
+              "loopback: PWM not trimmed");
+
+    return stats.latency;
+}
+
+static void SIM_testGuardWindow(void)
+{
+    uint16_t payload[DRV_FSI_PAYLOAD_WORDS];
+    uint16_t i;
+
+    SIM_setup(NULL);
+    SIM_check(DRV_FSI_init(DRV_FSI_ROLE_MASTER, true), "guard: init");
+
+    for(i = 0U; i < DRV_FSI_PAYLOAD_WORDS; i++)
+    {
+        payload[i] = 0x5A00U + i;
+    }
+
+    /* 顶点前 50 个计数调用：这一帧仍是旧数据，下一帧才是新数据。 */
+    FSI_LINK_MOCK_run(FSI_LINK_MOCK_PERIOD - 50U);
+    (void)DRV_FSI_send(payload);
+    FSI_LINK_MOCK_run(100U);
+    SIM_check(FSI_LINK_MOCK_sentFrames() == 1U, "guard: first top passed");
+    SIM_check(FSI_LINK_MOCK_lastSent()[0] == 0U, "guard: in-flight frame untouched");
+    FSI_LINK_MOCK_run(SIM_CYCLE);
+    SIM_check(FSI_LINK_MOCK_lastSent()[0] == 0x5A00U, "guard: deferred frame sent next period");
+
+    /* 顶点后 200 个计数调用：帧仍在发送，同样推迟。 */
+    FSI_LINK_MOCK_run(150U);
+    payload[0] = 0x6B00U;
+    (void)DRV_FSI_send(payload);
+    FSI_LINK_MOCK_run(SIM_CYCLE);
+    SIM_check(FSI_LINK_MOCK_lastSent()[0] == 0x6B00U, "guard: post-top call sent next period");
+
+    /* 归零附近调用：立即装入，本周期的顶点发出。 */
+    FSI_LINK_MOCK_run(FSI_LINK_MOCK_PERIOD);
+    payload[0] = 0x7C00U;
+    (void)DRV_FSI_send(payload);
+    FSI_LINK_MOCK_run(FSI_LINK_MOCK_PERIOD);
+    SIM_check(FSI_LINK_MOCK_lastSent()[0] == 0x7C00U, "guard: call outside window sent at next top");
+}
+
+/**
+ * @brief 从板锁相，返回锁定所需周期数（未锁定为 0）。
+ */
+static uint32_t SIM_lock(int32_t ppm, uint16_t remoteCounter, uint16_t latency, uint32_t maxPeriods)
+{
+    DRV_FSI_Stats stats;
+    uint32_t period;
+
+    SIM_setup(SIM_slaveHook);
+    FSI_LINK_MOCK_setRemote(true, ppm, remoteCounter);
+    SIM_check(DRV_FSI_init(DRV_FSI_ROLE_SLAVE, false), "sync: init");
+    DRV_FSI_setSyncLatency(latency);
+
+    for(period = 1U; period <= maxPeriods; period++)
+    {
+        SIM_runPeriods(1U);
+        DRV_FSI_getStats(&stats);
+
+        if(stats.locked)
+        {
+            return period;
+        }
+    }
+
+    return 0U;
+}
+
+static void SIM_testSync(uint16_t latency)
+{
+    static const struct
+    {
+        int32_t  ppm;
+        uint16_t counter;
+    } cases[] =
+    {
+        { 0, 700U }, { 500, 1200U }, { -500, 2000U }, { 2000, 100U }, { -2000, 2400U }
+    };
+    DRV_FSI_Stats stats;
+    uint16_t i;
+
+    for(i = 0U; i < (uint16_t)(sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        char what[96];
+        uint32_t periods = SIM_lock(cases[i].ppm, cases[i].counter, latency, 400U);
+
+        snprintf(what, sizeof(what), "sync %+ld ppm: locks within 400 periods", (long)cases[i].ppm);
+        SIM_check(periods != 0U, what);
+
+        /* 锁定后继续运行，检查相位保持。 */
+        SIM_runPeriods(200U);
+        DRV_FSI_getStats(&stats);
+
+        snprintf(what, sizeof(what), "sync %+ld ppm: phase held", (long)cases[i].ppm);
+        SIM_check(stats.locked && (SIM_abs(FSI_LINK_MOCK_phaseOffset()) <= DRV_FSI_SYNC_LOCK_COUNTS * 2), what);
+        SIM_check(s_payloadErrors == 0U, "sync: payload intact");
+        SIM_check((stats.rxLost == 0U) && (stats.outliers == 0U), "sync: no loss, no outliers");
+
+        printf("  %+5ld ppm: locked after %3lu periods, offset %ld, trim %d\n",
+               (long)cases[i].ppm, (unsigned long)periods, (long)FSI_LINK_MOCK_phaseOffset(), stats.trim);
+    }
+}
+
+static void SIM_testErrors(uint16_t latency)
+{
+    DRV_FSI_Stats stats;
+
+    SIM_check(SIM_lock(300, 1500U, latency, 400U) != 0U, "errors: initial lock");
+    SIM_runPeriods(10U);
+
+    FSI_LINK_MOCK_injectCorruption();
+    SIM_runPeriods(5U);
+    DRV_FSI_getStats(&stats);
+    SIM_check(stats.crcErrors == 1U, "errors: corrupted slot rejected");
+    SIM_check(stats.rxLost == 1U, "errors: corrupted frame counted as lost");
+
+    FSI_LINK_MOCK_injectHwCrcError();
+    SIM_runPeriods(5U);
+    DRV_FSI_getStats(&stats);
+    SIM_check(stats.hwCrcErrors == 1U, "errors: hardware CRC error counted");
+    SIM_check(stats.rxLost == 2U, "errors: dropped frame counted as lost");
+    SIM_check(stats.locked && (stats.outliers == 0U), "errors: lock kept");
+    SIM_check(s_payloadErrors == 0U, "errors: payload intact");
+}
+
+static void SIM_testLinkDown(uint16_t latency)
+{
+    DRV_FSI_Stats stats;
+    int16_t trim;
+    uint32_t period;
+
+    SIM_check(SIM_lock(800, 400U, latency, 400U) != 0U, "link: initial lock");
+    SIM_runPeriods(100U);
+    DRV_FSI_getStats(&stats);
+    trim = stats.trim;
+
+    FSI_LINK_MOCK_setBroken(true);
+    SIM_runPeriods((DRV_FSI_PING_TIMEOUT_CYCLES / SIM_CYCLE) + 10U);
+    DRV_FSI_getStats(&stats);
+    SIM_check(!stats.linkUp && (stats.linkDowns == 1U), "link: ping watchdog timeout");
+    SIM_check(!stats.locked, "link: lock dropped");
+    SIM_check(stats.trim == trim, "link: period trim held");
+
+    FSI_LINK_MOCK_setBroken(false);
+
+    for(period = 1U; period <= 400U; period++)
+    {
+        SIM_runPeriods(1U);
+        DRV_FSI_getStats(&stats);
+
+        if(stats.locked)
+        {
+            break;
+        }
+    }
+
+    SIM_check(stats.linkUp, "link: recovered");
+    SIM_check(stats.locked, "link: relocked");
+    SIM_check(stats.rxLost > 0U, "link: frames missed while down");
+    printf("  link down: relocked after %lu periods\n", (unsigned long)period);
+}
+
+static void SIM_testSlowReader(void)
+{
+    DRV_FSI_Stats stats;
+
+    /* 每 6 个周期读一次，多于接收槽数，只取最新一帧。 */
+    SIM_setup(SIM_loopbackHook);
+    s_hookReadEvery = 6U;
+    SIM_check(DRV_FSI_init(DRV_FSI_ROLE_MASTER, true), "slow reader: init");
+    SIM_runPeriods(120U);
+    DRV_FSI_getStats(&stats);
+
+    SIM_check((s_received >= 19U) && (s_received <= 20U), "slow reader: one frame per read");
+    SIM_check(s_payloadErrors == 0U, "slow reader: payload intact");
+    SIM_check((stats.torn == 0U) && (stats.crcErrors == 0U), "slow reader: no torn slots");
+    SIM_check((stats.rxFrames + stats.rxLost) == (uint32_t)(s_last.sequence - s_first) + 1U,
+              "slow reader: gaps counted");
+}
+
+static void SIM_testRepeats(void)
+{
+    DRV_FSI_Stats stats;
+
+    /* 停止发送后对端重复最后一帧，读者不再得到新帧，链路仍然正常。 */
+    SIM_setup(SIM_loopbackHook);
+    SIM_check(DRV_FSI_init(DRV_FSI_ROLE_MASTER, true), "repeats: init");
+    SIM_runPeriods(20U);
+    s_hookSend = false;
+    s_received = 0U;
+    SIM_runPeriods(20U);
+    DRV_FSI_getStats(&stats);
+
+    SIM_check(s_received <= 1U, "repeats: no new frames");
+    SIM_check(stats.repeats >= 18U, "repeats: repeats counted");
+    SIM_check(stats.linkUp, "repeats: link still up");
+}
+
+int main(void)
+{
+    uint16_t latency;
+
+    SIM_testCrc();
+    latency = SIM_testLoopback();
+    printf("loopback latency: %u TBCLK\n", (unsigned)latency);
+    SIM_testGuardWindow();
+    SIM_testSync(latency);
+    SIM_testErrors(latency);
+    SIM_testLinkDown(latency);
+    SIM_testSlowReader();
+    SIM_testRepeats();
+
+    if(s_failures != 0U)
+    {
+        printf("%u check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,425 @@
+/**
+ * @file fsi_link_mock.c
+ * @brief 两板 FSI 链路模型上的 DRV_FSI_PORT_* 实现。
+ */
+
+#include <string.h>
+
+#include "fsi_link_mock.h"
+
+/** 同时在途的帧数上限。 */
+#define FSI_LINK_MOCK_FLIGHT_DEPTH  (8U)
+
+/** 频率偏差以 1/1000000 为单位累加。 */
+#define FSI_LINK_MOCK_PPM_ONE       (1000000L)
+
+/**
+ * @brief 增减计数的时基。
+ */
+typedef struct
+{
+    uint16_t counter;
+    uint16_t period;
+    uint16_t shadow;
+    bool     up;
+} FSI_LINK_MOCK_TimeBase;
+
+/**
+ * @brief 在途的一帧。
+ */
+typedef struct
+{
+    uint32_t due;
+    uint16_t words[DRV_FSI_FRAME_WORDS];
+} FSI_LINK_MOCK_Flight;
+
+static FSI_LINK_MOCK_TimeBase s_local;
+static FSI_LINK_MOCK_TimeBase s_remote;
+static FSI_LINK_MOCK_Hook     s_hook = NULL;
+
+static bool     s_started = false;
+static bool     s_loopback = false;
+static uint32_t s_time = 0U;
+
+static uint16_t       s_txBuffer[DRV_FSI_FRAME_WORDS];
+static const uint16_t *s_txSource = NULL;
+static uint32_t       s_txDmaDue = 0U;
+static bool           s_txDmaPending = false;
+static uint16_t       s_lastSent[DRV_FSI_FRAME_WORDS];
+static uint32_t       s_sentFrames = 0U;
+
+static bool     s_remoteEnabled = false;
+static int32_t  s_remotePpm = 0;
+static int32_t  s_remoteAccumulator = 0;
+static uint16_t s_remoteSequence = 0U;
+
+static FSI_LINK_MOCK_Flight s_flight[FSI_LINK_MOCK_FLIGHT_DEPTH];
+static uint16_t s_flightCount = 0U;
+
+static uint16_t *s_rxRing = NULL;
+static uint16_t  s_rxNext = 0U;
+static uint32_t  s_lastRx = 0U;
+static bool      s_watchdogFired = false;
+
+static bool s_broken = false;
+static bool s_hwCrcNext = false;
+static bool s_corruptNext = false;
+
+static uint32_t s_localZero = 0U;
+static uint32_t s_remoteZero = 0U;
+
+static void FSI_LINK_MOCK_resetTimeBase(FSI_LINK_MOCK_TimeBase *timeBase, uint16_t counter)
+{
+    timeBase->counter = counter;
+    timeBase->period  = FSI_LINK_MOCK_PERIOD;
+    timeBase->shadow  = FSI_LINK_MOCK_PERIOD;
+    timeBase->up      = true;
+}
+
+void FSI_LINK_MOCK_reset(void)
+{
+    FSI_LINK_MOCK_resetTimeBase(&s_local, 0U);
+    FSI_LINK_MOCK_resetTimeBase(&s_remote, 0U);
+
+    s_hook              = NULL;
+    s_started           = false;
+    s_loopback          = false;
+    s_time              = 0U;
+    s_txSource          = NULL;
+    s_txDmaPending      = false;
+    s_sentFrames        = 0U;
+    s_remoteEnabled     = false;
+    s_remotePpm         = 0;
+    s_remoteAccumulator = 0;
+    s_remoteSequence    = 0U;
+    s_flightCount       = 0U;
+    s_rxRing            = NULL;
+    s_rxNext            = 0U;
+    s_lastRx            = 0U;
+    s_watchdogFired     = false;
+    s_broken            = false;
+    s_hwCrcNext         = false;
+    s_corruptNext       = false;
+    s_localZero         = 0U;
+    s_remoteZero        = 0U;
+
+    memset(s_txBuffer, 0, sizeof(s_txBuffer));
+    memset(s_lastSent, 0, sizeof(s_lastSent));
+}
+
+/**
+ * @brief 时基前进一个计数。
+ *
+ * @param[out] zero 计数器归零。
+ *
+ * @return 计数器到达顶点。
+ */
+static bool FSI_LINK_MOCK_step(FSI_LINK_MOCK_TimeBase *timeBase, bool *zero)
+{
+    *zero = false;
+
+    if(timeBase->up)
+    {
+        timeBase->counter++;
+
+        if(timeBase->counter >= timeBase->period)
+        {
+            timeBase->up = false;
+            return true;
+        }
+
+        return false;
+    }
+
+    timeBase->counter--;
+
+    if(timeBase->counter == 0U)
+    {
+        timeBase->up     = true;
+        timeBase->period = timeBase->shadow;
+        *zero = true;
+    }
+
+    return false;
+}
+
+static void FSI_LINK_MOCK_launch(const uint16_t *words)
+{
+    FSI_LINK_MOCK_Flight *flight;
+
+    if(s_broken || (s_flightCount >= FSI_LINK_MOCK_FLIGHT_DEPTH))
+    {
+        return;
+    }
+
+    flight = &s_flight[s_flightCount++];
+    flight->due = s_time + FSI_LINK_MOCK_LATENCY;
+    memcpy(flight->words, words, sizeof(flight->words));
+}
+
+/**
+ * @brief 接收 DMA：时间戳与帧写入下一个槽。
+ */
+static void FSI_LINK_MOCK_deliver(const uint16_t *words)
+{
+    uint16_t *slot;
+
+    if(s_hwCrcNext)
+    {
+        s_hwCrcNext = false;
+        DRV_FSI_onRxEvents(DRV_FSI_EVT_CRC_ERROR);
+        return;
+    }
+
+    s_lastRx = s_time;
+    s_watchdogFired = false;
+
+    if(s_rxRing == NULL)
+    {
+        return;
+    }
+
+    slot = &s_rxRing[s_rxNext * DRV_FSI_SLOT_WORDS];
+    slot[0] = s_local.counter;
+    slot[1] = s_local.up ? DRV_FSI_TBSTS_CTRDIR : 0U;
+    memcpy(&slot[DRV_FSI_STAMP_WORDS], words, DRV_FSI_FRAME_WORDS * sizeof(uint16_t));
+
+    if(s_corruptNext)
+    {
+        s_corruptNext = false;
+        slot[DRV_FSI_STAMP_WORDS + 3U] ^= 0x0040U;
+    }
+
+    s_rxNext = (uint16_t)((s_rxNext + 1U) % DRV_FSI_RX_SLOTS);
+}
+
+static void FSI_LINK_MOCK_remoteFrame(void)
+{
+    uint16_t words[DRV_FSI_FRAME_WORDS];
+    uint16_t i;
+
+    for(i = 0U; i < DRV_FSI_PAYLOAD_WORDS; i++)
+    {
+        words[i] = (uint16_t)(s_remoteSequence * 16U + i);
+    }
+
+    words[DRV_FSI_SEQ_INDEX] = s_remoteSequence;
+    words[DRV_FSI_CRC_INDEX] = DRV_FSI_crc16(0xFFFFU, words, DRV_FSI_CRC_INDEX);
+    s_remoteSequence++;
+
+    FSI_LINK_MOCK_launch(words);
+}
+
+static void FSI_LINK_MOCK_localTop(void)
+{
+    if(!s_started)
+    {
+        return;
+    }
+
+    memcpy(s_lastSent, s_txBuffer, sizeof(s_lastSent));
+    s_sentFrames++;
+
+    if(s_loopback)
+    {
+        FSI_LINK_MOCK_launch(s_txBuffer);
+    }
+
+    /* 帧发完后 TX DMA 事件从源地址重新装入发送缓冲区。 */
+    s_txDmaDue = s_time + FSI_LINK_MOCK_FRAME_CYCLES;
+    s_txDmaPending = true;
+}
+
+static void FSI_LINK_MOCK_tick(void)
+{
+    bool zero;
+    uint16_t i;
+
+    s_time++;
+
+    if(FSI_LINK_MOCK_step(&s_local, &zero))
+    {
+        FSI_LINK_MOCK_localTop();
+    }
+
+    if(zero)
+    {
+        s_localZero = s_time;
+
+        if(s_hook != NULL)
+        {
+            s_hook();
+        }
+    }
+
+    if(s_remoteEnabled)
+    {
+        s_remoteAccumulator += FSI_LINK_MOCK_PPM_ONE + s_remotePpm;
+
+        while(s_remoteAccumulator >= FSI_LINK_MOCK_PPM_ONE)
+        {
+            s_remoteAccumulator -= FSI_LINK_MOCK_PPM_ONE;
+
+            if(FSI_LINK_MOCK_step(&s_remote, &zero))
+            {
+                FSI_LINK_MOCK_remoteFrame();
+            }
+
+            if(zero)
+            {
+                s_remoteZero = s_time;
+            }
+        }
+    }
+
+    if(s_txDmaPending && (s_time >= s_txDmaDue))
+    {
+        s_txDmaPending = false;
+
+        if(s_txSource != NULL)
+        {
+            memcpy(s_txBuffer, s_txSource, sizeof(s_txBuffer));
+        }
+    }
+
+    i = 0U;
+
+    while(i < s_flightCount)
+    {
+        if(s_time >= s_flight[i].due)
+        {
+            FSI_LINK_MOCK_deliver(s_flight[i].words);
+            s_flightCount--;
+            memmove(&s_flight[i], &s_flight[i + 1U], (size_t)(s_flightCount - i) * sizeof(s_flight[0]));
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if(s_started && !s_watchdogFired && ((s_time - s_lastRx) > DRV_FSI_PING_TIMEOUT_CYCLES))
+    {
+        s_watchdogFired = true;
+        DRV_FSI_onRxEvents(DRV_FSI_EVT_PING_TIMEOUT);
+    }
+}
+
+void FSI_LINK_MOCK_run(uint32_t cycles)
+{
+    uint32_t i;
+
+    for(i = 0U; i < cycles; i++)
+    {
+        FSI_LINK_MOCK_tick();
+    }
+}
+
+void FSI_LINK_MOCK_setZeroHook(FSI_LINK_MOCK_Hook hook)
+{
+    s_hook = hook;
+}
+
+void FSI_LINK_MOCK_setRemote(bool enabled, int32_t ppm, uint16_t counter)
+{
+    s_remoteEnabled = enabled;
+    s_remotePpm     = ppm;
+    FSI_LINK_MOCK_resetTimeBase(&s_remote, counter);
+}
+
+void FSI_LINK_MOCK_setBroken(bool broken)
+{
+    s_broken = broken;
+}
+
+void FSI_LINK_MOCK_injectHwCrcError(void)
+{
+    s_hwCrcNext = true;
+}
+
+void FSI_LINK_MOCK_injectCorruption(void)
+{
+    s_corruptNext = true;
+}
+
+uint32_t FSI_LINK_MOCK_sentFrames(void)
+{
+    return s_sentFrames;
+}
+
+const uint16_t *FSI_LINK_MOCK_lastSent(void)
+{
+    return s_lastSent;
+}
+
+uint16_t FSI_LINK_MOCK_localPeriod(void)
+{
+    return s_local.period;
+}
+
+int32_t FSI_LINK_MOCK_phaseOffset(void)
+{
+    int32_t cycle = 2 * (int32_t)FSI_LINK_MOCK_PERIOD;
+    int32_t offset = (int32_t)(s_remoteZero - s_localZero);
+
+    offset %= cycle;
+
+    if(offset >= cycle / 2)
+    {
+        offset -= cycle;
+    }
+    else if(offset < -cycle / 2)
+    {
+        offset += cycle;
+    }
+
+    return offset;
+}
+
+bool DRV_FSI_PORT_init(bool loopback, uint16_t *rxRing)
+{
+    s_loopback = loopback;
+    s_rxRing   = rxRing;
+    s_rxNext   = 0U;
+    s_started  = false;
+
+    return true;
+}
+
+void DRV_FSI_PORT_start(const uint16_t *frame)
+{
+    memcpy(s_txBuffer, frame, sizeof(s_txBuffer));
+    s_txSource = frame;
+    s_lastRx   = s_time;
+    s_started  = true;
+}
+
+void DRV_FSI_PORT_setTxSource(const uint16_t *frame)
+{
+    uint32_t counter = s_local.counter;
+
+    s_txSource = frame;
+
+    if(( s_local.up && (counter + DRV_FSI_TX_GUARD_BEFORE >= s_local.period)) ||
+       (!s_local.up && (counter + DRV_FSI_TX_GUARD_AFTER >= s_local.period)))
+    {
+        return;
+    }
+
+    memcpy(s_txBuffer, frame, sizeof(s_txBuffer));
+}
+
+uint16_t DRV_FSI_PORT_getRxSlot(void)
+{
+    return s_rxNext;
+}
+
+uint16_t DRV_FSI_PORT_getPeriod(void)
+{
+    return FSI_LINK_MOCK_PERIOD;
+}
+
+void DRV_FSI_PORT_trimPeriod(int16_t counts)
+{
+    s_local.shadow = (uint16_t)((int32_t)FSI_LINK_MOCK_PERIOD + counts);
+}
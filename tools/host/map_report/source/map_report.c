@@ -0,0 +1,284 @@
+/**
+ * @file map_report.c
+ * @brief 从 C2000 链接映射文件中统计热路径段大小与 RAM 占用。
+ *
+ * 解析 MEMORY CONFIGURATION 与 SECTION ALLOCATION MAP 两部分：
+ *  - 输出 hotpath、FPUmathTables、.TI.ramfunc 以及命令行追加段的加载地址、运行
+ *    地址与长度；
+ *  - 输出所有 RAM 块（名称以 RAM 开头）的已用与剩余字数。
+ *
+ * 用法：map_report app.map [section ...]
+ * 任一关注段在映射文件中不存在时返回 1。
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPORT_MAX_SECTIONS     (16U)
+#define REPORT_MAX_MEMORIES     (48U)
+#define REPORT_LINE_LEN         (512U)
+#define REPORT_NAME_LEN         (64U)
+
+typedef struct
+{
+    char     name[REPORT_NAME_LEN];
+    int      found;
+    unsigned page;
+    uint32_t origin;
+    uint32_t length;
+    uint32_t runAddr;
+    int      hasRun;
+} ReportSection;
+
+typedef struct
+{
+    char     name[REPORT_NAME_LEN];
+    unsigned page;
+    uint32_t origin;
+    uint32_t length;
+    uint32_t used;
+} ReportMemory;
+
+typedef enum
+{
+    REPORT_PART_NONE = 0,
+    REPORT_PART_MEMORY,
+    REPORT_PART_SECTIONS
+} ReportPart;
+
+static ReportSection s_sections[REPORT_MAX_SECTIONS];
+static unsigned      s_sectionCount;
+static ReportMemory  s_memories[REPORT_MAX_MEMORIES];
+static unsigned      s_memoryCount;
+
+static void REPORT_addSection(const char *name)
+{
+    if(s_sectionCount < REPORT_MAX_SECTIONS)
+    {
+        ReportSection *sec = &s_sections[s_sectionCount++];
+
+        memset(sec, 0, sizeof(*sec));
+        strncpy(sec->name, name, REPORT_NAME_LEN - 1U);
+    }
+}
+
+static ReportSection *REPORT_findSection(const char *name)
+{
+    unsigned index;
+
+    for(index = 0U; index < s_sectionCount; index++)
+    {
+        if(strcmp(s_sections[index].name, name) == 0)
+        {
+            return &s_sections[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 解析段分配行中 "page origin length [RUN ADDR = xxx]" 部分。
+ */
+static void REPORT_parseAllocation(ReportSection *sec, const char *text)
+{
+    unsigned page;
+    unsigned long origin;
+    unsigned long length;
+    const char *run;
+
+    if((sec == NULL) || sec->found ||
+       (sscanf(text, "%u %lx %lx", &page, &origin, &length) != 3))
+    {
+        return;
+    }
+
+    sec->found  = 1;
+    sec->page   = page;
+    sec->origin = (uint32_t)origin;
+    sec->length = (uint32_t)length;
+
+    run = strstr(text, "RUN ADDR =");
+
+    if(run != NULL)
+    {
+        unsigned long runAddr;
+
+        if(sscanf(run + strlen("RUN ADDR ="), "%lx", &runAddr) == 1)
+        {
+            sec->runAddr = (uint32_t)runAddr;
+            sec->hasRun  = 1;
+        }
+    }
+}
+
+static void REPORT_parseMemory(const char *line, unsigned page)
+{
+    char name[REPORT_NAME_LEN];
+    unsigned long origin;
+    unsigned long length;
+    unsigned long used;
+    ReportMemory *mem;
+
+    if((s_memoryCount >= REPORT_MAX_MEMORIES) ||
+       (sscanf(line, " %63s %lx %lx %lx", name, &origin, &length, &used) != 4) ||
+       (strncmp(name, "RAM", 3U) != 0))
+    {
+        return;
+    }
+
+    mem = &s_memories[s_memoryCount++];
+    strcpy(mem->name, name);
+    mem->page   = page;
+    mem->origin = (uint32_t)origin;
+    mem->length = (uint32_t)length;
+    mem->used   = (uint32_t)used;
+}
+
+static int REPORT_parse(FILE *file)
+{
+    char line[REPORT_LINE_LEN];
+    ReportPart part = REPORT_PART_NONE;
+    ReportSection *pending = NULL;
+    unsigned page = 0U;
+
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        if(strncmp(line, "MEMORY CONFIGURATION", 20U) == 0)
+        {
+            part = REPORT_PART_MEMORY;
+            continue;
+        }
+
+        if(strncmp(line, "SECTION ALLOCATION MAP", 22U) == 0)
+        {
+            part = REPORT_PART_SECTIONS;
+            continue;
+        }
+
+        if(strncmp(line, "GLOBAL SYMBOLS", 14U) == 0)
+        {
+            part = REPORT_PART_NONE;
+            continue;
+        }
+
+        if(part == REPORT_PART_MEMORY)
+        {
+            if(sscanf(line, "PAGE %u", &page) == 1)
+            {
+                continue;
+            }
+
+            REPORT_parseMemory(line, page);
+        }
+        else if(part == REPORT_PART_SECTIONS)
+        {
+            char name[REPORT_NAME_LEN];
+            int consumed = 0;
+
+            if((line[0] == '*') && (pending != NULL))
+            {
+                /* 段名过长时分配信息在下一行，以 '*' 开头。 */
+                REPORT_parseAllocation(pending, line + 1);
+                pending = NULL;
+            }
+            else if((line[0] != ' ') && (line[0] != '\n') && (line[0] != '-') &&
+                    (sscanf(line, "%63s%n", name, &consumed) == 1))
+            {
+                pending = REPORT_findSection(name);
+
+                if(pending != NULL)
+                {
+                    unsigned pageTmp;
+
+                    if(sscanf(line + consumed, "%u", &pageTmp) == 1)
+                    {
+                        REPORT_parseAllocation(pending, line + consumed);
+                        pending = NULL;
+                    }
+                }
+            }
+        }
+    }
+
+    return (s_memoryCount > 0U) ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *file;
+    unsigned index;
+    uint32_t hotTotal = 0U;
+    int missing = 0;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s app.map [section ...]\n", argv[0]);
+        return 2;
+    }
+
+    REPORT_addSection("hotpath");
+    REPORT_addSection("FPUmathTables");
+    REPORT_addSection(".TI.ramfunc");
+
+    for(index = 2U; index < (unsigned)argc; index++)
+    {
+        REPORT_addSection(argv[index]);
+    }
+
+    file = fopen(argv[1], "r");
+
+    if(file == NULL)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+
+    if(REPORT_parse(file) != 0)
+    {
+        fprintf(stderr, "%s: no MEMORY CONFIGURATION found\n", argv[1]);
+        fclose(file);
+        return 2;
+    }
+
+    fclose(file);
+
+    printf("%-16s %4s %10s %10s %8s\n", "section", "page", "load", "run", "words");
+
+    for(index = 0U; index < s_sectionCount; index++)
+    {
+        const ReportSection *sec = &s_sections[index];
+
+        if(!sec->found)
+        {
+            printf("%-16s %4s %10s %10s %8s\n", sec->name, "-", "-", "-", "missing");
+            missing = 1;
+            continue;
+        }
+
+        printf("%-16s %4u 0x%08lX 0x%08lX %8lu\n", sec->name, sec->page,
+               (unsigned long)sec->origin,
+               (unsigned long)(sec->hasRun ? sec->runAddr : sec->origin),
+               (unsigned long)sec->length);
+
+        hotTotal += sec->length;
+    }
+
+    printf("%-16s %4s %10s %10s %8lu\n\n", "total", "", "", "", (unsigned long)hotTotal);
+
+    printf("%-10s %4s %10s %8s %8s %8s %6s\n", "memory", "page", "origin", "length", "used", "free", "use%");
+
+    for(index = 0U; index < s_memoryCount; index++)
+    {
+        const ReportMemory *mem = &s_memories[index];
+
+        printf("%-10s %4u 0x%08lX %8lu %8lu %8lu %5lu%%\n", mem->name, mem->page,
+               (unsigned long)mem->origin, (unsigned long)mem->length,
+               (unsigned long)mem->used, (unsigned long)(mem->length - mem->used),
+               (unsigned long)((mem->length != 0U) ? ((mem->used * 100UL) / mem->length) : 0U));
+    }
+
+    return missing;
+}
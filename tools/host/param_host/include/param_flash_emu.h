@@ -0,0 +1,50 @@
+/**
+ * @file param_flash_emu.h
+ * @brief APP_PARAM_PORT_* 的主机实现：两个参数扇区的 NOR 闪存模拟器。
+ *
+ * 模拟器遵循目标板闪存的限制：
+ *  - 擦除后各字为 0xFFFF，编程只能把位从 1 清为 0；
+ *  - 每个 8 字单元带 ECC，擦除前只能编程一次，重复编程记为违例并返回失败；
+ *  - 擦除与单元编程各计一次操作，可在第 n 次操作时模拟掉电：该操作只完成一部分
+ *    （编程写入前几个字且最后一个字只清除部分位，擦除只恢复部分位），此后所有
+ *    操作失败，直到 PARAM_FLASH_EMU_powerOn。
+ */
+
+#ifndef PARAM_FLASH_EMU_H
+#define PARAM_FLASH_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_param.h"
+
+/** 全部扇区擦除，清除掉电、故障与统计。 */
+void PARAM_FLASH_EMU_reset(void);
+
+/**
+ * @brief 从现在起的第 operation 次操作（从 1 计）中途掉电，0 表示取消。
+ */
+void PARAM_FLASH_EMU_cutAt(uint32_t operation);
+
+/** 已掉电。 */
+bool PARAM_FLASH_EMU_isCut(void);
+
+/** 重新上电，取消掉电状态，闪存内容保持。 */
+void PARAM_FLASH_EMU_powerOn(void);
+
+/** 把某字中 mask 所在的位清 0，模拟数据保持失效。 */
+void PARAM_FLASH_EMU_corrupt(uint16_t sector, uint16_t offset, uint16_t mask);
+
+/** 读取一个字，不经过 APP_PARAM_PORT_read。 */
+uint16_t PARAM_FLASH_EMU_peek(uint16_t sector, uint16_t offset);
+
+/** 累计操作数（擦除与单元编程）。 */
+uint32_t PARAM_FLASH_EMU_operations(void);
+
+/** 扇区擦除次数。 */
+uint32_t PARAM_FLASH_EMU_eraseCount(uint16_t sector);
+
+/** 重复编程或未对齐编程的次数。 */
+uint32_t PARAM_FLASH_EMU_violations(void);
+
+#endif /* PARAM_FLASH_EMU_H */
@@ -0,0 +1,188 @@
+/**
+ * @file param_flash_emu.c
+ * @brief 两个参数扇区的 NOR 闪存模拟器。
+ */
+
+#include <string.h>
+
+#include "param_flash_emu.h"
+
+static uint16_t s_flash[APP_PARAM_SECTOR_COUNT][APP_PARAM_SECTOR_WORDS];
+static bool     s_programmed[APP_PARAM_SECTOR_COUNT][APP_PARAM_SECTOR_UNITS];
+static uint32_t s_eraseCount[APP_PARAM_SECTOR_COUNT];
+
+static uint32_t s_operations = 0U;
+static uint32_t s_violations = 0U;
+static uint32_t s_cutCountdown = 0U;
+static bool     s_cut = false;
+static uint32_t s_random = 1U;
+
+/**
+ * @brief 掉电时部分完成的位模式由固定种子的 LCG 给出，结果可重复。
+ */
+static uint16_t PARAM_FLASH_EMU_random(void)
+{
+    s_random = (s_random * 1103515245UL) + 12345UL;
+
+    return (uint16_t)(s_random >> 16);
+}
+
+/**
+ * @brief 记一次操作，判断本次操作是否掉电。
+ *
+ * @retval false 已掉电，操作不执行。
+ * @param[out] partial 本次操作执行到一半时掉电。
+ */
+static bool PARAM_FLASH_EMU_begin(bool *partial)
+{
+    *partial = false;
+
+    if(s_cut)
+    {
+        return false;
+    }
+
+    s_operations++;
+
+    if(s_cutCountdown != 0U)
+    {
+        s_cutCountdown--;
+
+        if(s_cutCountdown == 0U)
+        {
+            s_cut = true;
+            *partial = true;
+        }
+    }
+
+    return true;
+}
+
+void PARAM_FLASH_EMU_reset(void)
+{
+    memset(s_flash, 0xFF, sizeof(s_flash));
+    memset(s_programmed, 0, sizeof(s_programmed));
+    memset(s_eraseCount, 0, sizeof(s_eraseCount));
+
+    s_operations   = 0U;
+    s_violations   = 0U;
+    s_cutCountdown = 0U;
+    s_cut          = false;
+    s_random       = 1U;
+}
+
+void PARAM_FLASH_EMU_cutAt(uint32_t operation)
+{
+    s_cutCountdown = operation;
+}
+
+bool PARAM_FLASH_EMU_isCut(void)
+{
+    return s_cut;
+}
+
+void PARAM_FLASH_EMU_powerOn(void)
+{
+    s_cut = false;
+    s_cutCountdown = 0U;
+}
+
+void PARAM_FLASH_EMU_corrupt(uint16_t sector, uint16_t offset, uint16_t mask)
+{
+    s_flash[sector][offset] &= (uint16_t)~mask;
+}
+
+uint16_t PARAM_FLASH_EMU_peek(uint16_t sector, uint16_t offset)
+{
+    return s_flash[sector][offset];
+}
+
+uint32_t PARAM_FLASH_EMU_operations(void)
+{
+    return s_operations;
+}
+
+uint32_t PARAM_FLASH_EMU_eraseCount(uint16_t sector)
+{
+    return s_eraseCount[sector];
+}
+
+uint32_t PARAM_FLASH_EMU_violations(void)
+{
+    return s_violations;
+}
+
+bool APP_PARAM_PORT_init(void)
+{
+    return true;
+}
+
+void APP_PARAM_PORT_read(uint16_t sector, uint16_t offset, uint16_t *data, uint16_t words)
+{
+    memcpy(data, &s_flash[sector][offset], (size_t)words * sizeof(uint16_t));
+}
+
+bool APP_PARAM_PORT_program(uint16_t sector, uint16_t offset, const uint16_t *data)
+{
+    uint16_t *dst = &s_flash[sector][offset];
+    uint16_t unit = (uint16_t)(offset / APP_PARAM_UNIT_WORDS);
+    uint16_t words = APP_PARAM_UNIT_WORDS;
+    bool partial;
+    uint16_t i;
+
+    if(((offset % APP_PARAM_UNIT_WORDS) != 0U) || s_programmed[sector][unit])
+    {
+        s_violations++;
+        return false;
+    }
+
+    if(!PARAM_FLASH_EMU_begin(&partial))
+    {
+        return false;
+    }
+
+    s_programmed[sector][unit] = true;
+
+    if(partial)
+    {
+        /* 前几个字写完，下一个字只清除了部分位。 */
+        words = (uint16_t)(PARAM_FLASH_EMU_random() % APP_PARAM_UNIT_WORDS);
+        dst[words] &= (uint16_t)(data[words] | PARAM_FLASH_EMU_random());
+    }
+
+    for(i = 0U; i < words; i++)
+    {
+        dst[i] &= data[i];
+    }
+
+    return !partial;
+}
+
+bool APP_PARAM_PORT_erase(uint16_t sector)
+{
+    bool partial;
+    uint16_t i;
+
+    if(!PARAM_FLASH_EMU_begin(&partial))
+    {
+        return false;
+    }
+
+    s_eraseCount[sector]++;
+
+    if(partial)
+    {
+        /* 擦除中途：各字只有部分位恢复为 1，整个扇区仍不可编程。 */
+        for(i = 0U; i < APP_PARAM_SECTOR_WORDS; i++)
+        {
+            s_flash[sector][i] |= PARAM_FLASH_EMU_random();
+        }
+
+        return false;
+    }
+
+    memset(s_flash[sector], 0xFF, sizeof(s_flash[sector]));
+    memset(s_programmed[sector], 0, sizeof(s_programmed[sector]));
+
+    return true;
+}
@@ -0,0 +1,375 @@
+/**
+ * @file param_host_main.c
+ * @brief 在闪存模拟器上运行 app_param.c，检查读写、版本、删除、整理与擦除均衡、
+ *        损坏记录跳过，以及在每一次擦写操作中途掉电后的恢复。任一检查失败时返回
+ *        非零值。
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "app_param.h"
+#include "param_flash_emu.h"
+
+/** 掉电扫描使用的参数编号数与各自的数据字数。 */
+#define SIM_PARAMS          (6U)
+
+/** 掉电扫描前把当前扇区写到只剩这么多单元，使扫描窗口覆盖一次整理。 */
+#define SIM_FILL_FREE       (12U)
+
+/** 掉电扫描窗口内的写入次数。 */
+#define SIM_STEPS           (24U)
+
+static const uint16_t s_simWords[SIM_PARAMS] = { 2U, 2U, 4U, 8U, 12U, 28U };
+
+static unsigned int s_failures = 0U;
+
+/** 各编号最后一次成功写入的值。 */
+static uint16_t s_model[SIM_PARAMS][APP_PARAM_MAX_WORDS];
+static bool     s_modelValid[SIM_PARAMS];
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+static void SIM_pattern(uint16_t id, uint32_t step, uint16_t *value)
+{
+    uint16_t i;
+
+    for(i = 0U; i < s_simWords[id]; i++)
+    {
+        value[i] = (uint16_t)((id * 1000U) + (step * 7U) + i);
+    }
+}
+
+static bool SIM_write(uint16_t id, uint32_t step)
+{
+    uint16_t value[APP_PARAM_MAX_WORDS];
+
+    SIM_pattern(id, step, value);
+
+    if(!APP_PARAM_write(id, 1U, value, s_simWords[id]))
+    {
+        return false;
+    }
+
+    memcpy(s_model[id], value, sizeof(value));
+    s_modelValid[id] = true;
+
+    return true;
+}
+
+static bool SIM_matches(uint16_t id, const uint16_t *expected)
+{
+    uint16_t value[APP_PARAM_MAX_WORDS];
+
+    if(!APP_PARAM_read(id, 1U, value, s_simWords[id]))
+    {
+        return false;
+    }
+
+    return memcmp(value, expected, s_simWords[id] * sizeof(uint16_t)) == 0;
+}
+
+static bool SIM_modelMatches(void)
+{
+    uint16_t id;
+
+    for(id = 0U; id < SIM_PARAMS; id++)
+    {
+        if(s_modelValid[id] ? !SIM_matches(id, s_model[id]) : APP_PARAM_read(id, 1U, s_model[id], s_simWords[id]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void SIM_testCrc(void)
+{
+    /* "12345678" 按字高字节在前，与逐字节的 CRC-16/CCITT-FALSE 相同。 */
+    static const uint16_t text[4] = { 0x3132U, 0x3334U, 0x3536U, 0x3738U };
+
+    SIM_check(APP_PARAM_crc16(0xFFFFU, text, 4U) == 0xA12BU, "crc reference value");
+}
+
+static void SIM_testBasic(void)
+{
+    APP_PARAM_Stats stats;
+    uint32_t frequency = 20000U;
+    uint16_t deadband[2] = { 10U, 12U };
+    float gains[2] = { 0.5f, 0.01f };
+    uint32_t readFrequency = 0U;
+    uint16_t readDeadband[2] = { 0U, 0U };
+    float readGains[2] = { 0.0f, 0.0f };
+    uint32_t operations;
+
+    PARAM_FLASH_EMU_reset();
+
+    SIM_check(!APP_PARAM_write(APP_PARAM_ID_PWM_FREQUENCY, 1U, &frequency, APP_PARAM_WORDS(frequency)),
+              "write before init rejected");
+    SIM_check(APP_PARAM_init(), "init formats blank flash");
+    APP_PARAM_getStats(&stats);
+    SIM_check(stats.ready && (stats.activeSector == 0U) && (stats.generation == 1U) && (stats.records == 0U),
+              "blank flash formatted as generation 1");
+    SIM_check(!APP_PARAM_read(APP_PARAM_ID_PWM_FREQUENCY, 1U, &readFrequency, APP_PARAM_WORDS(readFrequency)),
+              "missing parameter not read");
+
+    SIM_check(APP_PARAM_write(APP_PARAM_ID_PWM_FREQUENCY, 1U, &frequency, APP_PARAM_WORDS(frequency)) &&
+              APP_PARAM_write(APP_PARAM_ID_PWM_DEADBAND, 1U, deadband, APP_PARAM_WORDS(deadband)) &&
+              APP_PARAM_write(APP_PARAM_ID_CLA_GAINS, 1U, gains, APP_PARAM_WORDS(gains)),
+              "write parameters");
+
+    frequency = 16000U;
+    SIM_check(APP_PARAM_write(APP_PARAM_ID_PWM_FREQUENCY, 1U, &frequency, APP_PARAM_WORDS(frequency)),
+              "overwrite parameter");
+
+    operations = PARAM_FLASH_EMU_operations();
+    SIM_check(APP_PARAM_write(APP_PARAM_ID_PWM_DEADBAND, 1U, deadband, APP_PARAM_WORDS(deadband)) &&
+              (PARAM_FLASH_EMU_operations() == operations), "unchanged value not programmed");
+
+    /* 重新上电后由扫描重建索引。 */
+    SIM_check(APP_PARAM_init(), "reboot");
+    SIM_check(APP_PARAM_read(APP_PARAM_ID_PWM_FREQUENCY, 1U, &readFrequency, APP_PARAM_WORDS(readFrequency)) &&
+              (readFrequency == 16000U), "latest uint32 value after reboot");
+    SIM_check(APP_PARAM_read(APP_PARAM_ID_PWM_DEADBAND, 1U, readDeadband, APP_PARAM_WORDS(readDeadband)) &&
+              (readDeadband[0] == 10U) && (readDeadband[1] == 12U), "uint16 array after reboot");
+    SIM_check(APP_PARAM_read(APP_PARAM_ID_CLA_GAINS, 1U, readGains, APP_PARAM_WORDS(readGains)) &&
+              (readGains[0] == 0.5f) && (readGains[1] == 0.01f), "float array after reboot");
+
+    readFrequency = 1U;
+    SIM_check(!APP_PARAM_read(APP_PARAM_ID_PWM_FREQUENCY, 2U, &readFrequency, APP_PARAM_WORDS(readFrequency)) &&
+              (readFrequency == 1U), "version mismatch ignored");
+    SIM_check(!APP_PARAM_read(APP_PARAM_ID_PWM_FREQUENCY, 1U, readDeadband, 1U), "length mismatch ignored");
+    SIM_check(!APP_PARAM_write(APP_PARAM_MAX_ID, 1U, &frequency, 2U) &&
+              !APP_PARAM_write(3U, 1U, &frequency, 0U) &&
+              !APP_PARAM_write(3U, 1U, &frequency, APP_PARAM_MAX_WORDS + 1U), "invalid write rejected");
+
+    SIM_check(APP_PARAM_remove(APP_PARAM_ID_PWM_DEADBAND), "remove");
+    SIM_check(APP_PARAM_init(), "reboot after remove");
+    SIM_check(!APP_PARAM_read(APP_PARAM_ID_PWM_DEADBAND, 1U, readDeadband, APP_PARAM_WORDS(readDeadband)),
+              "removed parameter stays removed");
+
+    APP_PARAM_getStats(&stats);
+    SIM_check((stats.records == 2U) && (stats.skippedUnits == 0U), "record count after remove");
+    SIM_check(PARAM_FLASH_EMU_violations() == 0U, "no reprogrammed units");
+}
+
+static void SIM_testWear(void)
+{
+    APP_PARAM_Stats stats;
+    uint32_t step;
+    uint32_t erase0;
+    uint32_t erase1;
+    uint16_t id;
+
+    PARAM_FLASH_EMU_reset();
+    memset(s_modelValid, 0, sizeof(s_modelValid));
+    SIM_check(APP_PARAM_init(), "wear init");
+
+    for(step = 0U; step < 5000U; step++)
+    {
+        /* 编号 0 写得最频繁，其余轮流写入。 */
+        id = ((step % 2U) == 0U) ? 0U : (uint16_t)(1U + ((step / 2U) % (SIM_PARAMS - 1U)));
+
+        if(!SIM_write(id, step))
+        {
+            SIM_check(false, "wear write");
+            break;
+        }
+    }
+
+    APP_PARAM_getStats(&stats);
+    erase0 = PARAM_FLASH_EMU_eraseCount(0U);
+    erase1 = PARAM_FLASH_EMU_eraseCount(1U);
+
+    printf("wear: %u writes, %u compactions, erases SEC14 %u SEC15 %u\n", (unsigned int)stats.writes,
+           (unsigned int)stats.compactions, (unsigned int)erase0, (unsigned int)erase1);
+
+    SIM_check(stats.compactions > 10U, "log compacted repeatedly");
+    SIM_check((erase0 + 1U >= erase1) && (erase1 + 1U >= erase0), "erases balanced between sectors");
+    SIM_check(stats.generation == stats.compactions + 1U, "generation counts compactions");
+    SIM_check(SIM_modelMatches(), "latest values before reboot");
+
+    SIM_check(APP_PARAM_init(), "wear reboot");
+    SIM_check(SIM_modelMatches(), "latest values after reboot");
+    SIM_check(PARAM_FLASH_EMU_violations() == 0U, "no reprogrammed units during wear");
+}
+
+static void SIM_testCorruption(void)
+{
+    APP_PARAM_Stats stats;
+    uint16_t first[APP_PARAM_MAX_WORDS];
+
+    PARAM_FLASH_EMU_reset();
+    memset(s_modelValid, 0, sizeof(s_modelValid));
+    SIM_check(APP_PARAM_init(), "corruption init");
+
+    /* 编号 3 占 2 个单元：单元 1~2 为旧值，单元 3~4 为新值，单元 5 为编号 0。 */
+    (void)SIM_write(3U, 1U);
+    memcpy(first, s_model[3], sizeof(first));
+    (void)SIM_write(3U, 2U);
+    (void)SIM_write(0U, 3U);
+
+    PARAM_FLASH_EMU_corrupt(0U, (uint16_t)((3U * APP_PARAM_UNIT_WORDS) + 6U), 0x0008U);
+
+    SIM_check(APP_PARAM_init(), "reboot with corrupted record");
+    APP_PARAM_getStats(&stats);
+    SIM_check(stats.skippedUnits == 2U, "corrupted record skipped unit by unit");
+    SIM_check(SIM_matches(3U, first), "corrupted record falls back to previous value");
+    SIM_check(SIM_matches(0U, s_model[0]), "record after corrupted one still found");
+    SIM_check(SIM_write(3U, 4U) && APP_PARAM_init() && SIM_matches(3U, s_model[3]),
+              "store writable after corrupted record");
+}
+
+/**
+ * @brief 掉电扫描的初始状态：每个编号写一次，再写到当前扇区接近写满。
+ */
+static void SIM_powerSetup(void)
+{
+    APP_PARAM_Stats stats;
+    uint32_t step = 0U;
+
+    PARAM_FLASH_EMU_reset();
+    memset(s_modelValid, 0, sizeof(s_modelValid));
+    (void)APP_PARAM_init();
+
+    do
+    {
+        (void)SIM_write((uint16_t)(step % SIM_PARAMS), step);
+        step++;
+        APP_PARAM_getStats(&stats);
+    } while(stats.freeUnits > SIM_FILL_FREE);
+}
+
+/**
+ * @brief 扫描窗口：轮流写各编号，遇到失败时返回该编号，全部成功返回 SIM_PARAMS。
+ */
+static uint16_t SIM_powerSteps(uint16_t *pending)
+{
+    uint32_t step;
+
+    for(step = 0U; step < SIM_STEPS; step++)
+    {
+        uint16_t id = (uint16_t)((step * 5U) % SIM_PARAMS);
+
+        if(!SIM_write(id, 10000U + step))
+        {
+            SIM_pattern(id, 10000U + step, pending);
+            return id;
+        }
+    }
+
+    return SIM_PARAMS;
+}
+
+static void SIM_testPowerLoss(void)
+{
+    uint16_t pending[APP_PARAM_MAX_WORDS];
+    uint32_t operations;
+    uint32_t cut;
+    uint32_t failures = 0U;
+    uint32_t newValues = 0U;
+    uint32_t compactionsSeen = 0U;
+
+    /* 无掉电运行一次，得到窗口内的操作数。 */
+    SIM_powerSetup();
+    operations = PARAM_FLASH_EMU_operations();
+    SIM_check(SIM_powerSteps(pending) == SIM_PARAMS, "power-loss window without cut");
+    operations = PARAM_FLASH_EMU_operations() - operations;
+
+    for(cut = 1U; cut <= operations; cut++)
+    {
+        APP_PARAM_Stats stats;
+        uint16_t id;
+        uint16_t failed;
+        bool ok = true;
+
+        SIM_powerSetup();
+        PARAM_FLASH_EMU_cutAt(cut);
+        failed = SIM_powerSteps(pending);
+        APP_PARAM_getStats(&stats);
+
+        if(stats.compactions != 0U)
+        {
+            compactionsSeen++;
+        }
+
+        PARAM_FLASH_EMU_powerOn();
+
+        if((failed == SIM_PARAMS) || !APP_PARAM_init())
+        {
+            failures++;
+            continue;
+        }
+
+        /* 中断的写入可保持旧值或已生效，其余编号必须是最后一次成功写入的值。 */
+        if(SIM_matches(failed, pending))
+        {
+            memcpy(s_model[failed], pending, sizeof(pending));
+            s_modelValid[failed] = true;
+            newValues++;
+        }
+
+        ok = SIM_modelMatches();
+
+        /* 恢复后存储仍可写，并在再次上电后保持。 */
+        for(id = 0U; id < SIM_PARAMS; id++)
+        {
+            ok = ok && SIM_write(id, 20000U + id);
+        }
+
+        ok = ok && APP_PARAM_init() && SIM_modelMatches() && (PARAM_FLASH_EMU_violations() == 0U);
+
+        if(!ok)
+        {
+            printf("power cut at operation %u: recovery failed\n", (unsigned int)cut);
+            failures++;
+        }
+    }
+
+    printf("power loss: %u cut points, %u inside compaction, %u interrupted writes took effect\n",
+           (unsigned int)operations, (unsigned int)compactionsSeen, (unsigned int)newValues);
+
+    SIM_check(compactionsSeen > 0U, "power-loss window covers a compaction");
+    SIM_check(failures == 0U, "recovery after every power cut");
+}
+
+static void SIM_testFormatPowerLoss(void)
+{
+    APP_PARAM_Stats stats;
+
+    PARAM_FLASH_EMU_reset();
+    PARAM_FLASH_EMU_cutAt(2U);
+    SIM_check(!APP_PARAM_init(), "format interrupted by power cut");
+
+    PARAM_FLASH_EMU_powerOn();
+    SIM_check(APP_PARAM_init(), "format repeated after power cut");
+    APP_PARAM_getStats(&stats);
+    SIM_check((stats.generation == 1U) && (stats.records == 0U), "formatted after interrupted format");
+}
+
+int main(void)
+{
+    SIM_testCrc();
+    SIM_testBasic();
+    SIM_testWear();
+    SIM_testCorruption();
+    SIM_testPowerLoss();
+    SIM_testFormatPowerLoss();
+
+    if(s_failures != 0U)
+    {
+        printf("%u check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
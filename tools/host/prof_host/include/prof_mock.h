@@ -0,0 +1,37 @@
+/**
+ * @file prof_mock.h
+ * @brief APP_PROF 计数硬件的主机端替身接口。
+ *
+ * 以向下计数的 CPUTIMER 替身作为时间基准，取反即得到 SYSCLK 周期计数，与目标板
+ * APP_STATS_now 一致。测试代码以 PROF_MOCK_execute 声明"程序计数器到达某地址"，
+ * 替身据此模拟 ERAD 的起止比较与启停计数：到达起始地址时计数清零开始，到达结束
+ * 地址时停止并更新最大值。
+ */
+
+#ifndef PROF_MOCK_H
+#define PROF_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 推进 CPUTIMER 替身。 */
+void PROF_MOCK_advance(uint32_t cycles);
+
+/** 返回 CPUTIMER 替身的递增计数。 */
+uint32_t PROF_MOCK_now(void);
+
+/** 模拟执行到 address 处的指令。 */
+void PROF_MOCK_execute(uint32_t address);
+
+/** 模拟调试器占用计数硬件，下一次 APP_PROF_init 将失败。 */
+void PROF_MOCK_setDebuggerOwned(bool owned);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROF_MOCK_H */
@@ -0,0 +1,139 @@
+/**
+ * @file prof_cputimer_mock.c
+ * @brief 基于 CPUTIMER 替身的 APP_PROF_PORT_* 实现。
+ */
+
+#include "app_prof.h"
+#include "prof_mock.h"
+
+/**
+ * @brief 单个计数器的模拟状态，对应 ERAD 计数器的 COUNT 与 MAX_COUNT。
+ */
+typedef struct
+{
+    bool     attached;
+    bool     running;
+    uint32_t startAddr;
+    uint32_t endAddr;
+    uint32_t startTime;
+    uint32_t count;
+    uint32_t max;
+} PROF_MOCK_Counter;
+
+static PROF_MOCK_Counter s_counters[APP_PROF_MAX_REGIONS];
+/** CPUTIMER 替身，与硬件一样向下计数。 */
+static uint32_t          s_timer = 0xFFFFFFFFUL;
+static bool              s_debuggerOwned = false;
+
+void PROF_MOCK_advance(uint32_t cycles)
+{
+    s_timer -= cycles;
+}
+
+uint32_t PROF_MOCK_now(void)
+{
+    return ~s_timer;
+}
+
+void PROF_MOCK_execute(uint32_t address)
+{
+    uint16_t index;
+
+    for(index = 0U; index < APP_PROF_MAX_REGIONS; index++)
+    {
+        PROF_MOCK_Counter *counter = &s_counters[index];
+
+        if(!counter->attached)
+        {
+            continue;
+        }
+
+        if(address == counter->startAddr)
+        {
+            counter->running   = true;
+            counter->startTime = PROF_MOCK_now();
+            counter->count     = 0U;
+        }
+        else if((address == counter->endAddr) && counter->running)
+        {
+            counter->running = false;
+            counter->count   = PROF_MOCK_now() - counter->startTime;
+
+            if(counter->count > counter->max)
+            {
+                counter->max = counter->count;
+            }
+        }
+    }
+}
+
+void PROF_MOCK_setDebuggerOwned(bool owned)
+{
+    s_debuggerOwned = owned;
+}
+
+bool APP_PROF_PORT_init(void)
+{
+    uint16_t index;
+
+    if(s_debuggerOwned)
+    {
+        return false;
+    }
+
+    for(index = 0U; index < APP_PROF_MAX_REGIONS; index++)
+    {
+        s_counters[index].attached = false;
+        s_counters[index].running  = false;
+    }
+
+    return true;
+}
+
+void APP_PROF_PORT_attach(uint16_t index, uint32_t startAddr, uint32_t endAddr)
+{
+    PROF_MOCK_Counter *counter = &s_counters[index];
+
+    counter->attached  = true;
+    counter->running   = false;
+    counter->startAddr = startAddr;
+    counter->endAddr   = endAddr;
+    counter->count     = 0U;
+}
+
+uint32_t APP_PROF_PORT_takeCount(uint16_t index)
+{
+    PROF_MOCK_Counter *counter = &s_counters[index];
+    uint32_t count;
+
+    /* 硬件上计数进行中时两次读数不同，替身直接以运行状态判断。 */
+    if(counter->running)
+    {
+        return 0U;
+    }
+
+    count = counter->count;
+    counter->count = 0U;
+
+    return count;
+}
+
+uint32_t APP_PROF_PORT_getMax(uint16_t index)
+{
+    return s_counters[index].max;
+}
+
+void APP_PROF_PORT_clearMax(uint16_t index)
+{
+    s_counters[index].max = 0U;
+}
+
+uint16_t APP_PROF_PORT_lock(void)
+{
+    return 0U;
+}
+
+void APP_PROF_PORT_unlock(uint16_t state)
+{
+    (void)state;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file prof_host_main.c
+ * @brief 在主机上以 CPUTIMER 替身运行 app_prof.c 并检查统计结果。
+ *
+ * 以固定的执行时间序列模拟两个区域，检查采样得到的最小值、平均值与样本数、
+ * 两次采样之间未被采到的执行是否仍计入最大值、进行中的执行是否被跳过，以及
+ * 区域分配与调试器占用的失败路径。任一检查失败时返回非零值。
+ */
+
+#include <stdio.h>
+
+#include "app_prof.h"
+#include "prof_mock.h"
+
+/** 模拟的区域地址。 */
+#define SIM_ISR_START       (0x8000UL)
+#define SIM_ISR_END         (0x80A3UL)
+#define SIM_LOOP_START      (0x9000UL)
+#define SIM_LOOP_SIZE       (0x40UL)
+
+static uint16_t s_failures = 0U;
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+/**
+ * @brief 模拟一次完整执行：起始地址、区域内耗时、结束地址。
+ */
+static void SIM_run(uint32_t start, uint32_t end, uint32_t cycles)
+{
+    PROF_MOCK_execute(start);
+    PROF_MOCK_advance(cycles);
+    PROF_MOCK_execute(end);
+}
+
+static void SIM_report(uint16_t id)
+{
+    APP_PROF_Snapshot snap;
+
+    if(APP_PROF_getSnapshot(id, &snap))
+    {
+        printf("%-8s 0x%05lX-0x%05lX samples=%4lu last=%6lu min=%6lu avg=%6lu max=%6lu\n",
+               snap.name, (unsigned long)snap.startAddr, (unsigned long)snap.endAddr,
+               (unsigned long)snap.samples, (unsigned long)snap.lastCycles,
+               (unsigned long)snap.minCycles, (unsigned long)snap.avgCycles,
+               (unsigned long)snap.maxCycles);
+    }
+}
+
+int main(void)
+{
+    static const uint32_t isrCycles[] = { 420U, 380U, 400U, 450U, 350U };
+    APP_PROF_Snapshot snap;
+    uint16_t isrId = 0xFFFFU;
+    uint16_t loopId = 0xFFFFU;
+    uint16_t extra;
+    uint16_t index;
+
+    /* 调试器占用时初始化失败，之后不能分配区域。 */
+    PROF_MOCK_setDebuggerOwned(true);
+    SIM_check(!APP_PROF_init(), "init fails when debugger owns ERAD");
+    SIM_check(!APP_PROF_addRegion("isr", SIM_ISR_START, SIM_ISR_END, NULL),
+              "no region without hardware");
+    PROF_MOCK_setDebuggerOwned(false);
+
+    SIM_check(APP_PROF_init(), "init");
+    SIM_check(APP_PROF_addRegion("isr", SIM_ISR_START, SIM_ISR_END, &isrId), "add isr");
+    SIM_check(APP_PROF_addFunction("loop", SIM_LOOP_START, SIM_LOOP_SIZE, &loopId), "add loop");
+    SIM_check(!APP_PROF_addRegion("bad", 0x200UL, 0x100UL, NULL), "reversed range rejected");
+    SIM_check(!APP_PROF_addFunction("bad", 0x200UL, 0U, NULL), "empty function rejected");
+
+    /* 每次采样前执行一次，全部被采到。 */
+    for(index = 0U; index < (sizeof(isrCycles) / sizeof(isrCycles[0])); index++)
+    {
+        SIM_run(SIM_ISR_START, SIM_ISR_END, isrCycles[index]);
+        PROF_MOCK_advance(1000U);
+        APP_PROF_sample();
+    }
+
+    SIM_check(APP_PROF_getSnapshot(isrId, &snap), "isr snapshot");
+    SIM_check(snap.samples == 5U, "isr samples");
+    SIM_check(snap.minCycles == 350U, "isr min");
+    SIM_check(snap.maxCycles == 450U, "isr max");
+    SIM_check(snap.avgCycles == 400U, "isr avg");
+    SIM_check(snap.lastCycles == 350U, "isr last");
+    SIM_report(isrId);
+
+    /* 两次采样之间执行三次：只采到最后一次，最大值仍由硬件捕获。 */
+    SIM_run(SIM_LOOP_START, SIM_LOOP_START + SIM_LOOP_SIZE - 1U, 100U);
+    SIM_run(SIM_LOOP_START, SIM_LOOP_START + SIM_LOOP_SIZE - 1U, 900U);
+    SIM_run(SIM_LOOP_START, SIM_LOOP_START + SIM_LOOP_SIZE - 1U, 200U);
+    APP_PROF_sample();
+
+    SIM_check(APP_PROF_getSnapshot(loopId, &snap), "loop snapshot");
+    SIM_check(snap.samples == 1U, "loop samples");
+    SIM_check(snap.lastCycles == 200U, "loop last");
+    SIM_check(snap.maxCycles == 900U, "loop max from hardware");
+
+    /* 进行中的执行不采样，结束后的下一次采样得到完整周期。 */
+    PROF_MOCK_execute(SIM_LOOP_START);
+    PROF_MOCK_advance(300U);
+    APP_PROF_sample();
+    SIM_check(APP_PROF_getSnapshot(loopId, &snap) && (snap.samples == 1U),
+              "running region skipped");
+    PROF_MOCK_advance(200U);
+    PROF_MOCK_execute(SIM_LOOP_START + SIM_LOOP_SIZE - 1U);
+    APP_PROF_sample();
+    SIM_check(APP_PROF_getSnapshot(loopId, &snap) && (snap.lastCycles == 500U),
+              "completed region sampled");
+    SIM_check(snap.minCycles == 200U, "loop min");
+    SIM_check(snap.avgCycles == 350U, "loop avg");
+    SIM_report(loopId);
+
+    /* 无新执行时采样不改变统计。 */
+    APP_PROF_sample();
+    SIM_check(APP_PROF_getSnapshot(loopId, &snap) && (snap.samples == 2U), "idle sample ignored");
+
+    /* 计数器分配完后拒绝新区域。 */
+    SIM_check(APP_PROF_addRegion("r3", 0xA000UL, 0xA010UL, &extra), "add third");
+    SIM_check(APP_PROF_addRegion("r4", 0xB000UL, 0xB010UL, &extra), "add fourth");
+    SIM_check(!APP_PROF_addRegion("r5", 0xC000UL, 0xC010UL, &extra), "fifth rejected");
+    SIM_check(APP_PROF_getRegionCount() == APP_PROF_MAX_REGIONS, "region count");
+    SIM_check(!APP_PROF_getSnapshot(APP_PROF_MAX_REGIONS, &snap), "invalid id");
+
+    APP_PROF_reset();
+    SIM_check(APP_PROF_getSnapshot(isrId, &snap) && (snap.samples == 0U) &&
+              (snap.maxCycles == 0U) && (snap.avgCycles == 0U), "reset");
+
+    printf("%s (%u failure(s))\n", (s_failures == 0U) ? "PASS" : "FAIL", s_failures);
+
+    return (s_failures == 0U) ? 0 : 1;
+}
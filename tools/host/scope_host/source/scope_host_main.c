@@ -0,0 +1,288 @@
+/**
+ * @file scope_host_main.c
+ * @brief 在主机上运行 app_scope.c 并检查触发与预触发历史。
+ *
+ * 以已知的信号序列模拟控制中断，检查各触发方式的触发位置、预触发长度、冻结后不再
+ * 写入、记录分频、软件触发提前发生时历史缩短、控制时隙在中断内触发的位置以及参数检查。任一检查失败时返回非零值。
+ */
+
+#include <stdio.h>
+
+#include "app_scope.h"
+
+static unsigned int s_failures = 0U;
+
+/** 模拟的控制变量。 */
+static float    s_ramp;
+static int16_t  s_current;
+static uint16_t s_status;
+
+static void SIM_check(bool condition, const char *what)
+{
+    if(!condition)
+    {
+        printf("FAIL: %s\n", what);
+        s_failures++;
+    }
+}
+
+/**
+ * @brief 模拟一次控制中断：更新信号并记录，tick 作为斜坡信号的值。
+ */
+static void SIM_tick(uint32_t tick)
+{
+    s_ramp    = (float)tick;
+    s_current = (int16_t)(-(int32_t)(tick % 100U));
+    s_status  = (tick == 1500U) ? 0x0040U : 0x0001U;
+    APP_SCOPE_sample();
+}
+
+/**
+ * @brief 运行至冻结或达到上限，返回调用次数。
+ */
+static uint32_t SIM_runUntilDone(uint32_t first, uint32_t limit)
+{
+    uint32_t tick;
+
+    for(tick = first; tick < (first + limit); tick++)
+    {
+        SIM_tick(tick);
+
+        if(APP_SCOPE_getState() == (uint16_t)APP_SCOPE_STATE_DONE)
+        {
+            return tick;
+        }
+    }
+
+    return tick;
+}
+
+static void SIM_setup(void)
+{
+    APP_SCOPE_init();
+    SIM_check(APP_SCOPE_addChannel(&s_ramp, APP_SCOPE_TYPE_FLOAT32, NULL), "add float channel");
+    SIM_check(APP_SCOPE_addChannel(&s_current, APP_SCOPE_TYPE_INT16, NULL), "add int16 channel");
+    SIM_check(APP_SCOPE_addChannel(&s_status, APP_SCOPE_TYPE_UINT16, NULL), "add uint16 channel");
+}
+
+/**
+ * @brief 检查冻结后的数据：斜坡连续、触发点位置与触发值一致。
+ */
+static void SIM_checkCapture(float triggerValue, uint16_t expectPre, uint16_t divider,
+                             const char *what)
+{
+    APP_SCOPE_Capture capture;
+    float values[3];
+    float previous = 0.0f;
+    bool continuous = true;
+    uint16_t i;
+    char text[96];
+
+    SIM_check(APP_SCOPE_getCapture(&capture), what);
+    if(!APP_SCOPE_getCapture(&capture))
+    {
+        return;
+    }
+
+    for(i = 0U; i < capture.samples; i++)
+    {
+        (void)APP_SCOPE_readSample(i, values);
+
+        if((i > 0U) && (values[0] != (previous + (float)divider)))
+        {
+            continuous = false;
+        }
+
+        previous = values[0];
+    }
+
+    (void)APP_SCOPE_readSample(capture.triggerIndex, values);
+
+    snprintf(text, sizeof(text), "%s: continuous samples", what);
+    SIM_check(continuous, text);
+    snprintf(text, sizeof(text), "%s: trigger value %.0f (expected %.0f)", what,
+             (double)values[0], (double)triggerValue);
+    SIM_check(values[0] == triggerValue, text);
+    snprintf(text, sizeof(text), "%s: pre-trigger %u (expected %u)", what,
+             (unsigned int)capture.triggerIndex, (unsigned int)expectPre);
+    SIM_check(capture.triggerIndex == expectPre, text);
+    snprintf(text, sizeof(text), "%s: sample count", what);
+    SIM_check(capture.samples == (uint16_t)(APP_SCOPE_CAPACITY / 3U), text);
+}
+
+static void SIM_testModes(void)
+{
+    const uint16_t depth = APP_SCOPE_CAPACITY / 3U;
+    const uint16_t pre = (uint16_t)(((uint32_t)depth * 25U) / 100U);
+    APP_SCOPE_Config config = { APP_SCOPE_TRIG_RISING, 0U, 1000.0f, 0U, 25U, 1U };
+    float values[3];
+
+    SIM_setup();
+
+    /* 上升沿：斜坡越过 1000。 */
+    SIM_check(APP_SCOPE_arm(&config), "arm rising");
+    (void)SIM_runUntilDone(0U, 5000U);
+    SIM_checkCapture(1000.0f, pre, 1U, "rising edge");
+
+    /* 冻结后继续调用不改变数据。 */
+    SIM_tick(9999U);
+    (void)APP_SCOPE_readSample(0U, values);
+    SIM_check(values[0] == (1000.0f - (float)pre), "frozen after trigger");
+
+    /* 下降沿：int16 通道由 -80 回到 0 之前越过 -50 不算，-49 → -50 才算。 */
+    config.mode = APP_SCOPE_TRIG_FALLING;
+    config.channel = 1U;
+    config.level = -50.0f;
+    SIM_check(APP_SCOPE_arm(&config), "arm falling");
+    (void)SIM_runUntilDone(2000U, 5000U);
+    SIM_checkCapture((float)(2000U + pre + ((150U - (pre % 100U)) % 100U)), pre, 1U, "falling edge");
+
+    /* 故障位：第 1500 次的状态字置位 0x0040。 */
+    config.mode = APP_SCOPE_TRIG_FAULT;
+    config.channel = 2U;
+    config.mask = 0x0040U;
+    config.preTriggerPercent = 50U;
+    SIM_check(APP_SCOPE_arm(&config), "arm fault");
+    (void)SIM_runUntilDone(1000U, 5000U);
+    SIM_checkCapture(1500.0f, (uint16_t)(depth / 2U), 1U, "fault");
+
+    /* 电平 + 分频：每 4 次记录一次。 */
+    config.mode = APP_SCOPE_TRIG_ABOVE;
+    config.channel = 0U;
+    config.level = 4000.0f;
+    config.preTriggerPercent = 10U;
+    config.divider = 4U;
+    SIM_check(APP_SCOPE_arm(&config), "arm level");
+    (void)SIM_runUntilDone(0U, 20000U);
+    SIM_checkCapture(4000.0f, (uint16_t)(((uint32_t)depth * 10U) / 100U), 4U, "level with divider");
+}
+
+static void SIM_testManual(void)
+{
+    const uint16_t depth = APP_SCOPE_CAPACITY / 3U;
+    APP_SCOPE_Config config = { APP_SCOPE_TRIG_MANUAL, 0U, 0.0f, 0U, 50U, 1U };
+    APP_SCOPE_Capture capture;
+    float values[3];
+    uint32_t tick;
+
+    SIM_setup();
+
+    /* 预触发未记满时软件触发：历史缩短为已记录的 100 个采样。 */
+    SIM_check(APP_SCOPE_arm(&config), "arm manual");
+    for(tick = 0U; tick < 100U; tick++)
+    {
+        SIM_tick(tick);
+    }
+    APP_SCOPE_trigger();
+    (void)SIM_runUntilDone(100U, 5000U);
+
+    SIM_check(APP_SCOPE_getCapture(&capture), "manual capture");
+    SIM_check(capture.triggerIndex == 100U, "short pre-trigger history");
+    SIM_check(capture.samples == (uint16_t)(100U + depth - (depth / 2U)),
+              "short capture length");
+    (void)APP_SCOPE_readSample(capture.triggerIndex, values);
+    SIM_check(values[0] == 100.0f, "manual trigger sample");
+
+    /* 只有软件触发时持续滚动，不会自行冻结。 */
+    SIM_check(APP_SCOPE_arm(&config), "re-arm manual");
+    for(tick = 0U; tick < 10000U; tick++)
+    {
+        SIM_tick(tick);
+    }
+    SIM_check(APP_SCOPE_getState() == (uint16_t)APP_SCOPE_STATE_ARMED, "manual keeps rolling");
+    APP_SCOPE_stop();
+}
+
+/**
+ * @brief 按控制中断的顺序检查故障触发：快速时隙在检测到故障的中断中软件触发，
+ *        同一中断随后记录的采样即触发点，之前保留完整的预触发历史。
+ */
+static void SIM_testSlotTrigger(void)
+{
+    const uint16_t depth = APP_SCOPE_CAPACITY / 3U;
+    const uint16_t pre = (uint16_t)(((uint32_t)depth * 75U) / 100U);
+    const uint32_t fault = 3000U;
+    APP_SCOPE_Config config = { APP_SCOPE_TRIG_MANUAL, 0U, 0.0f, 0U, 75U, 1U };
+    APP_SCOPE_Capture capture;
+    float values[3];
+    uint32_t tick;
+    uint32_t done = 0U;
+
+    SIM_setup();
+    SIM_check(APP_SCOPE_arm(&config), "arm fault recorder");
+
+    for(tick = 0U; tick < (fault + depth); tick++)
+    {
+        /* 快速时隙先于记录执行。 */
+        if(tick == fault)
+        {
+            APP_SCOPE_trigger();
+        }
+
+        SIM_tick(tick);
+
+        if((done == 0U) && (APP_SCOPE_getState() == (uint16_t)APP_SCOPE_STATE_DONE))
+        {
+            done = tick;
+        }
+    }
+
+    SIM_check(done == (fault + depth - pre - 1U), "fault capture freezes after post-trigger depth");
+    SIM_check(APP_SCOPE_getCapture(&capture), "fault capture");
+    SIM_check(capture.triggerIndex == pre, "fault capture keeps full history");
+    (void)APP_SCOPE_readSample(capture.triggerIndex, values);
+    SIM_check(values[0] == (float)fault, "fault sample is the trigger point");
+    (void)APP_SCOPE_readSample(0U, values);
+    SIM_check(values[0] == (float)(fault - pre), "fault capture oldest sample");
+}
+
+static void SIM_testErrors(void)
+{
+    APP_SCOPE_Config config = { APP_SCOPE_TRIG_ABOVE, 0U, 0.0f, 0U, 50U, 1U };
+    uint16_t i;
+    bool added = true;
+
+    APP_SCOPE_init();
+    SIM_check(!APP_SCOPE_arm(&config), "arm without channels");
+
+    for(i = 0U; i < APP_SCOPE_MAX_CHANNELS; i++)
+    {
+        added = added && APP_SCOPE_addChannel(&s_ramp, APP_SCOPE_TYPE_FLOAT32, NULL);
+    }
+    SIM_check(added, "fill channels");
+    SIM_check(!APP_SCOPE_addChannel(&s_ramp, APP_SCOPE_TYPE_FLOAT32, NULL), "channel overflow");
+
+    config.preTriggerPercent = 101U;
+    SIM_check(!APP_SCOPE_arm(&config), "pre-trigger range");
+    config.preTriggerPercent = 50U;
+    config.divider = 0U;
+    SIM_check(!APP_SCOPE_arm(&config), "zero divider");
+    config.divider = 1U;
+    config.channel = APP_SCOPE_MAX_CHANNELS;
+    SIM_check(!APP_SCOPE_arm(&config), "trigger channel range");
+    config.channel = 0U;
+
+    SIM_check(APP_SCOPE_arm(&config), "arm");
+    SIM_check(!APP_SCOPE_addChannel(&s_ramp, APP_SCOPE_TYPE_FLOAT32, NULL), "add while running");
+    SIM_check(!APP_SCOPE_clearChannels(), "clear while running");
+    APP_SCOPE_stop();
+    SIM_check(APP_SCOPE_clearChannels(), "clear when stopped");
+}
+
+int main(void)
+{
+    SIM_testModes();
+    SIM_testManual();
+    SIM_testSlotTrigger();
+    SIM_testErrors();
+
+    if(s_failures != 0U)
+    {
+        printf("%u check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file sci_mock.h
+ * @brief 主机端 DRV_SCI 替身接口。
+ *
+ * 替身实现 drv_sci.h 的发送接口：DRV_SCI_send 只入队，SCI_MOCK_tick 每调用一次按
+ * 线路速率推进一个 tick 的传输时间，把相应字节写入文件描述符（伪终端主端），缓冲区
+ * 全部写出后清除 busy，与发送中断的行为一致。
+ */
+
+#ifndef SCI_MOCK_H
+#define SCI_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_sci.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 清空队列并设定输出与节拍。
+ *
+ * @param[in] fd     写入的文件描述符。
+ * @param[in] tickHz SCI_MOCK_tick 对应的频率。
+ */
+void SCI_MOCK_init(int fd, uint32_t tickHz);
+
+/**
+ * @brief 推进一个 tick 的线路时间。
+ */
+void SCI_MOCK_tick(void);
+
+/**
+ * @brief 直接向线路写入字节，用于注入损坏的数据。
+ */
+void SCI_MOCK_inject(const uint8_t *data, uint16_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCI_MOCK_H */
@@ -0,0 +1,95 @@
+/**
+ * @file telem_decoder.h
+ * @brief 遥测字节流解码器接口（主机端）。
+ *
+ * 解码器按字节接收串口数据，以 0x00 切分帧，调用 app_telem_frame.c 做 COBS 解码与
+ * CRC 校验，再按 app_telem.h 的包格式拆出流号、序号、时间戳与变量字节，通过回调交给
+ * 调用者。非法帧只计数并丢弃，下一个 0x00 之后自动重新同步；超长帧丢弃到下一个 0x00。
+ *
+ * 每个流的序号不连续时累计丢包数。解码器不依赖操作系统，可直接嵌入上位机程序。
+ */
+
+#ifndef TELEM_DECODER_H
+#define TELEM_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_telem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 可接收的最长帧（不含 0x00）。 */
+#define TELEM_DECODER_MAX_FRAME     (512U)
+
+/** 流号为 1 字节。 */
+#define TELEM_DECODER_STREAMS       (256U)
+
+/**
+ * @brief 解码后的包。
+ */
+typedef struct
+{
+    uint16_t stream;
+    uint16_t sequence;
+    uint32_t timestamp;
+    uint16_t payloadLength;
+    const uint16_t *payload;        /**< 变量字节，只在回调期间有效。 */
+} TELEM_Packet;
+
+typedef void (*TELEM_PacketCallback)(const TELEM_Packet *packet, void *context);
+
+/**
+ * @brief 解码统计。
+ */
+typedef struct
+{
+    uint32_t bytes;                 /**< 收到的字节数。 */
+    uint32_t packets;               /**< 通过校验的包数。 */
+    uint32_t badFrames;             /**< COBS 非法、CRC 不符或长度不足的帧数。 */
+    uint32_t oversize;              /**< 超过 TELEM_DECODER_MAX_FRAME 的帧数。 */
+    uint32_t lost;                  /**< 按序号推算的丢包数。 */
+} TELEM_DecoderStats;
+
+/**
+ * @brief 解码器状态，由调用者分配。
+ */
+typedef struct
+{
+    uint16_t             frame[TELEM_DECODER_MAX_FRAME];
+    uint16_t             raw[TELEM_DECODER_MAX_FRAME];
+    uint16_t             length;
+    bool                 discarding;
+    bool                 seen[TELEM_DECODER_STREAMS];
+    uint16_t             lastSequence[TELEM_DECODER_STREAMS];
+    TELEM_PacketCallback callback;
+    void                *context;
+    TELEM_DecoderStats   stats;
+} TELEM_Decoder;
+
+/**
+ * @brief 初始化解码器。
+ */
+void TELEM_DECODER_init(TELEM_Decoder *decoder, TELEM_PacketCallback callback, void *context);
+
+/**
+ * @brief 输入收到的字节。
+ */
+void TELEM_DECODER_feed(TELEM_Decoder *decoder, const uint8_t *data, size_t length);
+
+/**
+ * @brief 按偏移读取包内变量。
+ */
+uint16_t TELEM_DECODER_u16(const TELEM_Packet *packet, uint16_t offset);
+int16_t  TELEM_DECODER_i16(const TELEM_Packet *packet, uint16_t offset);
+uint32_t TELEM_DECODER_u32(const TELEM_Packet *packet, uint16_t offset);
+float    TELEM_DECODER_f32(const TELEM_Packet *packet, uint16_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEM_DECODER_H */
@@ -0,0 +1,141 @@
+/**
+ * @file sci_mock.c
+ * @brief 主机端 DRV_SCI 替身实现，按波特率把发送队列写入伪终端。
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "sci_mock.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+static DRV_SCI_TxBuffer *s_queue[DRV_SCI_TX_QUEUE_DEPTH];
+static uint16_t s_head = 0U;
+static uint16_t s_tail = 0U;
+static uint16_t s_index = 0U;
+
+static int s_fd = -1;
+static uint32_t s_tickHz = 1U;
+
+/** 线路额度，单位为 1 / tickHz 字节。 */
+static uint32_t s_credit = 0U;
+
+static DRV_SCI_Stats s_stats;
+
+static void SCI_MOCK_write(const uint8_t *data, size_t length)
+{
+    while(length > 0U)
+    {
+        ssize_t written = write(s_fd, data, length);
+
+        if(written <= 0)
+        {
+            continue;
+        }
+
+        data   += written;
+        length -= (size_t)written;
+    }
+}
+
+void SCI_MOCK_init(int fd, uint32_t tickHz)
+{
+    s_fd     = fd;
+    s_tickHz = (tickHz == 0U) ? 1U : tickHz;
+    s_head   = 0U;
+    s_tail   = 0U;
+    s_index  = 0U;
+    s_credit = 0U;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void SCI_MOCK_tick(void)
+{
+    uint8_t bytes[64];
+    size_t count = 0U;
+
+    s_credit += DRV_SCI_BAUD / DRV_SCI_BITS_PER_BYTE;
+
+    while((s_tail != s_head) && (s_credit >= s_tickHz))
+    {
+        DRV_SCI_TxBuffer *buffer = s_queue[s_tail & DRV_SCI_TX_QUEUE_MASK];
+
+        bytes[count] = (uint8_t)(buffer->data[s_index] & 0xFFU);
+        count++;
+        s_index++;
+        s_credit -= s_tickHz;
+        s_stats.txBytes++;
+
+        if(count == sizeof(bytes))
+        {
+            SCI_MOCK_write(bytes, count);
+            count = 0U;
+        }
+
+        if(s_index >= buffer->length)
+        {
+            s_index = 0U;
+            buffer->busy = 0U;
+            s_stats.txBuffers++;
+            s_tail++;
+        }
+    }
+
+    /* 线路空闲时不积累额度，与真实 UART 一致。 */
+    if(s_tail == s_head)
+    {
+        s_credit = 0U;
+    }
+
+    if(count > 0U)
+    {
+        SCI_MOCK_write(bytes, count);
+    }
+}
+
+void SCI_MOCK_inject(const uint8_t *data, uint16_t length)
+{
+    SCI_MOCK_write(data, length);
+}
+
+void DRV_SCI_init(void)
+{
+}
+
+bool DRV_SCI_send(DRV_SCI_TxBuffer *buffer)
+{
+    if((buffer == NULL) || (buffer->data == NULL) || (buffer->length == 0U) ||
+       (buffer->busy != 0U) || ((uint16_t)(s_head - s_tail) >= DRV_SCI_TX_QUEUE_DEPTH))
+    {
+        return false;
+    }
+
+    buffer->busy = 1U;
+    s_queue[s_head & DRV_SCI_TX_QUEUE_MASK] = buffer;
+    s_head++;
+
+    return true;
+}
+
+uint16_t DRV_SCI_getTxPending(void)
+{
+    return (uint16_t)(s_head - s_tail);
+}
+
+uint16_t DRV_SCI_read(uint16_t *data, uint16_t maxLength)
+{
+    (void)data;
+    (void)maxLength;
+
+    return 0U;
+}
+
+void DRV_SCI_getStats(DRV_SCI_Stats *stats)
+{
+    if(stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
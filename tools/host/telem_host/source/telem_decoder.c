@@ -0,0 +1,114 @@
+/**
+ * @file telem_decoder.c
+ * @brief 遥测字节流解码器实现（主机端）。
+ */
+
+#include "telem_decoder.h"
+
+#include <string.h>
+
+static void TELEM_DECODER_frame(TELEM_Decoder *decoder)
+{
+    TELEM_Packet packet;
+    uint16_t length = 0U;
+
+    if(!APP_TELEM_FRAME_decode(decoder->frame, decoder->length,
+                               decoder->raw, TELEM_DECODER_MAX_FRAME, &length) ||
+       (length < APP_TELEM_HEADER_BYTES))
+    {
+        decoder->stats.badFrames++;
+        return;
+    }
+
+    packet.stream        = decoder->raw[0];
+    packet.sequence      = decoder->raw[1];
+    packet.timestamp     = APP_TELEM_FRAME_getU32(&decoder->raw[2]);
+    packet.payloadLength = (uint16_t)(length - APP_TELEM_HEADER_BYTES);
+    packet.payload       = &decoder->raw[APP_TELEM_HEADER_BYTES];
+
+    if(decoder->seen[packet.stream])
+    {
+        decoder->stats.lost += (uint16_t)(packet.sequence - decoder->lastSequence[packet.stream] - 1U) & 0xFFU;
+    }
+
+    decoder->seen[packet.stream]         = true;
+    decoder->lastSequence[packet.stream] = packet.sequence;
+    decoder->stats.packets++;
+
+    if(decoder->callback != NULL)
+    {
+        decoder->callback(&packet, decoder->context);
+    }
+}
+
+void TELEM_DECODER_init(TELEM_Decoder *decoder, TELEM_PacketCallback callback, void *context)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->callback = callback;
+    decoder->context  = context;
+}
+
+void TELEM_DECODER_feed(TELEM_Decoder *decoder, const uint8_t *data, size_t length)
+{
+    size_t i;
+
+    for(i = 0U; i < length; i++)
+    {
+        uint8_t byte = data[i];
+
+        decoder->stats.bytes++;
+
+        if(byte == APP_TELEM_FRAME_DELIMITER)
+        {
+            /* 连续的 0x00 为空帧，直接跳过。 */
+            if(!decoder->discarding && (decoder->length != 0U))
+            {
+                TELEM_DECODER_frame(decoder);
+            }
+
+            decoder->length     = 0U;
+            decoder->discarding = false;
+            continue;
+        }
+
+        if(decoder->discarding)
+        {
+            continue;
+        }
+
+        if(decoder->length >= TELEM_DECODER_MAX_FRAME)
+        {
+            decoder->stats.oversize++;
+            decoder->discarding = true;
+            continue;
+        }
+
+        decoder->frame[decoder->length] = byte;
+        decoder->length++;
+    }
+}
+
+uint16_t TELEM_DECODER_u16(const TELEM_Packet *packet, uint16_t offset)
+{
+    return APP_TELEM_FRAME_getU16(&packet->payload[offset]);
+}
+
+int16_t TELEM_DECODER_i16(const TELEM_Packet *packet, uint16_t offset)
+{
+    return (int16_t)TELEM_DECODER_u16(packet, offset);
+}
+
+uint32_t TELEM_DECODER_u32(const TELEM_Packet *packet, uint16_t offset)
+{
+    return APP_TELEM_FRAME_getU32(&packet->payload[offset]);
+}
+
+float TELEM_DECODER_f32(const TELEM_Packet *packet, uint16_t offset)
+{
+    uint32_t bits = TELEM_DECODER_u32(packet, offset);
+    float value;
+
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
@@ -0,0 +1,419 @@
+/**
+ * @file telem_pty_test.c
+ * @brief 遥测伪终端回环测试（主机端）。
+ *
+ * 在 PC 上编译 app_telem.c 与 app_telem_frame.c，发送端经 sci_mock 按 115200 bit/s
+ * 写入伪终端主端，接收端从从端读取并交给 telem_decoder 解码，检查：
+ *  - CRC16 与 COBS 的已知向量及各长度的往返编码；
+ *  - 变量值与时间戳一致、每个流的序号连续；
+ *  - 需求超过线路速率时线路占满，各流仍按轮询轮流发出；
+ *  - 字节预算限制发送速率；
+ *  - 注入损坏数据后解码器丢弃坏帧并重新同步。
+ * 任一检查失败时返回非零值。
+ */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "app_telem.h"
+#include "sci_mock.h"
+#include "telem_decoder.h"
+
+#define TICK_HZ         (1000U)
+#define LINE_RATE       (DRV_SCI_BAUD / DRV_SCI_BITS_PER_BYTE)
+
+static int s_failures = 0;
+
+#define CHECK(cond, ...)                                    \
+    do                                                      \
+    {                                                       \
+        if(!(cond))                                         \
+        {                                                   \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);     \
+            printf(__VA_ARGS__);                            \
+            printf("\n");                                   \
+            s_failures++;                                   \
+        }                                                   \
+    } while(0)
+
+/** 被遥测的变量，模拟控制循环在每个 tick 更新。 */
+static volatile float    s_angle;
+static volatile uint32_t s_counter;
+static volatile int16_t  s_current;
+static volatile uint16_t s_status;
+
+/* 流 0 登记采集副本，由采集函数在组包前复制。 */
+static float    s_angleCopy;
+static uint32_t s_counterCopy;
+static int16_t  s_currentCopy;
+static uint32_t s_captures;
+
+/**
+ * @brief 接收端统计。
+ */
+typedef struct
+{
+    uint32_t packets[2];
+    uint32_t badValues;
+    uint32_t lastTimestamp;
+} RxContext;
+
+static int s_master = -1;
+static int s_slave = -1;
+static TELEM_Decoder s_decoder;
+
+static void openPty(void)
+{
+    struct termios tio;
+
+    s_master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if((s_master < 0) || (grantpt(s_master) != 0) || (unlockpt(s_master) != 0))
+    {
+        perror("posix_openpt");
+        exit(2);
+    }
+
+    s_slave = open(ptsname(s_master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if(s_slave < 0)
+    {
+        perror("open slave");
+        exit(2);
+    }
+
+    /* 原始模式：0x00、0x0A、0x11 等字节不做任何转换。 */
+    tcgetattr(s_slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(s_slave, TCSANOW, &tio);
+}
+
+static void drainSlave(void)
+{
+    uint8_t bytes[4096];
+
+    for(;;)
+    {
+        ssize_t count = read(s_slave, bytes, sizeof(bytes));
+
+        if(count <= 0)
+        {
+            break;
+        }
+
+        TELEM_DECODER_feed(&s_decoder, bytes, (size_t)count);
+    }
+}
+
+static void setSignals(uint32_t tick)
+{
+    s_angle   = (float)tick * 0.5f;
+    s_counter = tick;
+    s_current = (int16_t)(-(int32_t)(tick & 0x3FFFU));
+    s_status  = (uint16_t)(tick * 3U);
+}
+
+static void captureStream0(void *context)
+{
+    (void)context;
+
+    s_angleCopy   = s_angle;
+    s_counterCopy = s_counter;
+    s_currentCopy = s_current;
+    s_captures++;
+}
+
+static void onPacket(const TELEM_Packet *packet, void *context)
+{
+    RxContext *rx = (RxContext *)context;
+    uint32_t tick = packet->timestamp;
+
+    if(packet->stream < 2U)
+    {
+        rx->packets[packet->stream]++;
+    }
+
+    if(tick < rx->lastTimestamp)
+    {
+        rx->badValues++;
+    }
+
+    rx->lastTimestamp = tick;
+
+    /* 变量在组包时读取，与同一 tick 的时间戳对应。 */
+    if(packet->stream == 0U)
+    {
+        if((packet->payloadLength != 10U) ||
+           (TELEM_DECODER_f32(packet, 0U) != (float)tick * 0.5f) ||
+           (TELEM_DECODER_u32(packet, 4U) != tick) ||
+           (TELEM_DECODER_i16(packet, 8U) != (int16_t)(-(int32_t)(tick & 0x3FFFU))))
+        {
+            rx->badValues++;
+        }
+    }
+    else if(packet->stream == 1U)
+    {
+        if((packet->payloadLength != 2U) ||
+           (TELEM_DECODER_u16(packet, 0U) != (uint16_t)(tick * 3U)))
+        {
+            rx->badValues++;
+        }
+    }
+    else
+    {
+        rx->badValues++;
+    }
+}
+
+/**
+ * @brief 运行 ticks 个 tick，tick 编号从 *tick 开始。
+ */
+static void run(uint32_t *tick, uint32_t ticks)
+{
+    uint32_t i;
+
+    for(i = 0U; i < ticks; i++)
+    {
+        setSignals(*tick);
+        APP_TELEM_service(*tick);
+        SCI_MOCK_tick();
+        drainSlave();
+        (*tick)++;
+    }
+}
+
+/**
+ * @brief 暂停全部流并等待发送队列清空。
+ */
+static void flush(uint32_t *tick, uint16_t streams)
+{
+    uint16_t i;
+    uint32_t guard = 0U;
+
+    for(i = 0U; i < streams; i++)
+    {
+        (void)APP_TELEM_setPeriod(i, 0U);
+    }
+
+    while((DRV_SCI_getTxPending() != 0U) && (guard < 1000U))
+    {
+        run(tick, 1U);
+        guard++;
+    }
+
+    run(tick, 2U);
+}
+
+static void testFrame(void)
+{
+    static const uint16_t check[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    static const uint16_t cobsIn[4] = { 0x11U, 0x22U, 0x00U, 0x33U };
+    static const uint16_t cobsOut[5] = { 0x03U, 0x11U, 0x22U, 0x02U, 0x33U };
+    static uint16_t src[600];
+    static uint16_t enc[620];
+    static uint16_t dec[600];
+    uint16_t length;
+    uint16_t i;
+
+    CHECK(APP_TELEM_FRAME_crc16(0xFFFFU, check, 9U) == 0x29B1U, "crc16 check value");
+
+    length = APP_TELEM_FRAME_cobsEncode(cobsIn, 4U, enc);
+    CHECK((length == 5U) && (memcmp(enc, cobsOut, sizeof(cobsOut)) == 0), "cobs vector");
+
+    /* 各长度下全 0、全非 0 与混合内容的往返编码，覆盖 254 字节满块的边界。 */
+    for(length = 0U; length < 600U; length++)
+    {
+        uint16_t pattern;
+
+        for(pattern = 0U; pattern < 3U; pattern++)
+        {
+            uint16_t encoded;
+            uint16_t decoded = 0xFFFFU;
+            bool ok;
+
+            for(i = 0U; i < length; i++)
+            {
+                src[i] = (pattern == 0U) ? 0U :
+                         (pattern == 1U) ? (uint16_t)(1U + (i % 255U)) : (uint16_t)((i * 37U) & 0xFFU);
+            }
+
+            encoded = APP_TELEM_FRAME_cobsEncode(src, length, enc);
+
+            for(i = 0U; i < encoded; i++)
+            {
+                if(enc[i] == 0U)
+                {
+                    break;
+                }
+            }
+
+            ok = APP_TELEM_FRAME_cobsDecode(enc, encoded, dec, sizeof(dec) / sizeof(dec[0]), &decoded);
+
+            CHECK(i == encoded, "cobs output contains zero, length %u pattern %u", length, pattern);
+            CHECK(encoded <= (length + (length / 254U) + 1U), "cobs overhead, length %u", length);
+            CHECK(ok && (decoded == length) && (memcmp(src, dec, length * sizeof(src[0])) == 0),
+                  "cobs round trip, length %u pattern %u", length, pattern);
+        }
+    }
+
+    /* 帧编码与解码，CRC 错误被拒绝。 */
+    for(i = 0U; i < 10U; i++)
+    {
+        src[i] = (uint16_t)(i * 29U) & 0xFFU;
+    }
+
+    length = APP_TELEM_FRAME_encode(src, 10U, enc, APP_TELEM_FRAME_ENCODED_MAX(10U));
+    CHECK((length != 0U) && (enc[length - 1U] == 0U), "frame encode");
+    CHECK(APP_TELEM_FRAME_decode(enc, length - 1U, dec, 600U, &i) && (i == 10U), "frame decode");
+
+    enc[3] ^= 0x40U;
+    CHECK(!APP_TELEM_FRAME_decode(enc, length - 1U, dec, 600U, &i), "corrupted frame rejected");
+    CHECK(APP_TELEM_FRAME_encode(src, 10U, enc, APP_TELEM_FRAME_ENCODED_MAX(10U) - 1U) == 0U,
+          "frame capacity check");
+}
+
+int main(void)
+{
+    RxContext rx;
+    APP_TELEM_Stats stats;
+    uint32_t tick = 1U;
+    uint32_t bytesBefore;
+    uint32_t packetsBefore[2];
+    uint16_t stream0;
+    uint16_t stream1;
+
+    testFrame();
+
+    openPty();
+    SCI_MOCK_init(s_master, TICK_HZ);
+
+    memset(&rx, 0, sizeof(rx));
+    TELEM_DECODER_init(&s_decoder, onPacket, &rx);
+
+    /* 流 0：100 Hz，10 字节变量；流 1：1 kHz，2 字节变量。合计约 14 kB/s，超过线路速率。 */
+    APP_TELEM_init(TICK_HZ, 0U);
+    CHECK(APP_TELEM_addStream(10U, &stream0) && (stream0 == 0U), "add stream 0");
+    CHECK(APP_TELEM_addStream(1U, &stream1) && (stream1 == 1U), "add stream 1");
+    CHECK(APP_TELEM_setCapture(stream0, captureStream0, NULL), "set capture");
+    CHECK(!APP_TELEM_setCapture(5U, captureStream0, NULL), "bad capture stream rejected");
+    CHECK(APP_TELEM_addSignal(stream0, &s_angleCopy, APP_TELEM_TYPE_FLOAT32), "add float");
+    CHECK(APP_TELEM_addSignal(stream1, &s_status, APP_TELEM_TYPE_UINT16), "add uint16");
+    CHECK(APP_TELEM_addSignal(stream0, &s_counterCopy, APP_TELEM_TYPE_UINT32), "add uint32");
+    CHECK(APP_TELEM_addSignal(stream0, &s_currentCopy, APP_TELEM_TYPE_INT16), "add int16");
+    CHECK(!APP_TELEM_addSignal(5U, &s_current, APP_TELEM_TYPE_INT16), "bad stream rejected");
+    CHECK(!APP_TELEM_addSignal(stream0, NULL, APP_TELEM_TYPE_INT16), "null address rejected");
+    CHECK(!APP_TELEM_addSignal(stream0, &s_current, 9U), "bad type rejected");
+
+    /* 预热 1 秒，使额度与队列进入稳态，再统计 2 秒。 */
+    run(&tick, TICK_HZ);
+    bytesBefore      = s_decoder.stats.bytes;
+    packetsBefore[0] = rx.packets[0];
+    packetsBefore[1] = rx.packets[1];
+    run(&tick, 2U * TICK_HZ);
+
+    {
+        uint32_t bytes = s_decoder.stats.bytes - bytesBefore;
+        uint32_t rate0 = (rx.packets[0] - packetsBefore[0]) / 2U;
+        uint32_t rate1 = (rx.packets[1] - packetsBefore[1]) / 2U;
+
+        APP_TELEM_getStats(&stats);
+        printf("saturated: %u B/s (line %u), stream0 %u Hz, stream1 %u Hz, deferred %u, noBuffer %u\n",
+               (unsigned)(bytes / 2U), (unsigned)LINE_RATE, (unsigned)rate0, (unsigned)rate1,
+               (unsigned)stats.deferred, (unsigned)stats.noBuffer);
+
+        CHECK(bytes <= (2U * LINE_RATE) + 1U, "line rate exceeded: %u", (unsigned)bytes);
+        CHECK(bytes >= (2U * LINE_RATE * 95U) / 100U, "line not saturated: %u", (unsigned)bytes);
+        CHECK(rate0 >= 90U, "stream 0 starved: %u Hz", (unsigned)rate0);
+        CHECK(rate1 >= 700U, "stream 1 starved: %u Hz", (unsigned)rate1);
+        CHECK((stats.deferred + stats.noBuffer) > 0U, "saturation not reported");
+        CHECK(s_captures >= rx.packets[0], "capture not called before build");
+    }
+
+    flush(&tick, 2U);
+    CHECK(rx.badValues == 0U, "bad values: %u", (unsigned)rx.badValues);
+    CHECK(s_decoder.stats.lost == 0U, "lost packets: %u", (unsigned)s_decoder.stats.lost);
+    CHECK(s_decoder.stats.badFrames == 0U, "bad frames: %u", (unsigned)s_decoder.stats.badFrames);
+    CHECK(stats.frames <= s_decoder.stats.packets + APP_TELEM_PACKET_COUNT, "frames not delivered");
+
+    /* 字节预算 2000 B/s，只保留流 1。 */
+    APP_TELEM_setBudget(2000U);
+    (void)APP_TELEM_setPeriod(stream1, 1U);
+    run(&tick, TICK_HZ);
+    bytesBefore = s_decoder.stats.bytes;
+    run(&tick, 2U * TICK_HZ);
+
+    {
+        uint32_t bytes = s_decoder.stats.bytes - bytesBefore;
+
+        printf("budget: %u B/s (limit 2000)\n", (unsigned)(bytes / 2U));
+        CHECK(bytes <= 4000U + APP_TELEM_FRAME_MAX, "budget exceeded: %u", (unsigned)bytes);
+        CHECK(bytes >= 3800U, "budget underused: %u", (unsigned)bytes);
+    }
+
+    flush(&tick, 2U);
+
+    /* 注入：翻转一字节的帧、无分隔符的杂散字节、超长帧，其后的正常帧必须恢复解码。 */
+    {
+        static const uint8_t garbage[] = { 0x05U, 0x31U, 0x00U, 0x07U, 0xAAU, 0x55U };
+        uint16_t raw[APP_TELEM_RAW_MAX];
+        uint16_t frame[APP_TELEM_FRAME_MAX];
+        uint8_t bytes[APP_TELEM_FRAME_MAX];
+        uint8_t oversize[TELEM_DECODER_MAX_FRAME + 10U];
+        uint16_t length;
+        uint16_t i;
+        uint32_t badBefore = s_decoder.stats.badFrames;
+        uint32_t packetsStart = rx.packets[0] + rx.packets[1];
+
+        for(i = 0U; i < APP_TELEM_HEADER_BYTES; i++)
+        {
+            raw[i] = 0x11U + i;
+        }
+
+        length = APP_TELEM_FRAME_encode(raw, APP_TELEM_HEADER_BYTES, frame, APP_TELEM_FRAME_MAX);
+
+        for(i = 0U; i < length; i++)
+        {
+            bytes[i] = (uint8_t)frame[i];
+        }
+
+        bytes[2] ^= 0x01U;
+        SCI_MOCK_inject(bytes, length);
+        SCI_MOCK_inject(garbage, sizeof(garbage));
+        memset(oversize, 0x5A, sizeof(oversize));
+        SCI_MOCK_inject(oversize, sizeof(oversize));
+
+        APP_TELEM_setBudget(0U);
+        (void)APP_TELEM_setPeriod(stream0, 5U);
+        run(&tick, 200U);
+        flush(&tick, 2U);
+
+        printf("resync: %u bad frames, %u oversize, %u packets after injection\n",
+               (unsigned)(s_decoder.stats.badFrames - badBefore), (unsigned)s_decoder.stats.oversize,
+               (unsigned)(rx.packets[0] + rx.packets[1] - packetsStart));
+
+        CHECK((s_decoder.stats.badFrames - badBefore) >= 2U, "corruption not detected");
+        CHECK(s_decoder.stats.oversize == 1U, "oversize not detected");
+        CHECK((rx.packets[0] + rx.packets[1] - packetsStart) >= 35U, "no resync after corruption");
+        CHECK(rx.badValues == 0U, "bad values after resync: %u", (unsigned)rx.badValues);
+    }
+
+    close(s_slave);
+    close(s_master);
+
+    if(s_failures != 0)
+    {
+        printf("%d check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
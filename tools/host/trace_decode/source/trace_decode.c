@@ -0,0 +1,459 @@
+/**
+ * @file trace_decode.c
+ * @brief 将 APP_TRACE_buffer 的内存导出解码为时间线与延迟直方图。
+ *
+ * 输入为按目标板内存顺序排列的 16 bit 字（小端字节序），从 APP_TRACE_buffer
+ * 起始地址开始，至少包含头部与全部记录。32 bit 成员在目标板上低字在前。
+ *
+ * 用法：
+ *   trace_decode [-q] dump.bin    输出时间线（-q 时省略）与直方图
+ *   trace_decode --synth out.bin  生成一份合成导出，用于检查解码器本身
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_trace_events.h"
+
+#define TRACE_MAGIC         (0x5254U)
+#define TRACE_VERSION       (1U)
+#define TRACE_HEADER_WORDS  (8U)
+#define TRACE_RECORD_WORDS  (4U)
+
+#define TRACE_MAX_IDS       (64U)
+#define TRACE_HIST_BINS     (32U)
+
+typedef struct
+{
+    uint16_t id;
+    uint16_t arg;
+    uint32_t timestamp;
+} TraceRecord;
+
+/**
+ * @brief 以 2 的幂分档的延迟直方图，单位为 SYSCLK 周期。
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t    bins[TRACE_HIST_BINS];
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    sum;
+} TraceHist;
+
+static uint16_t s_sysclkMHz;
+
+static uint32_t TRACE_word32(const uint16_t *words)
+{
+    return (uint32_t)words[0] | ((uint32_t)words[1] << 16);
+}
+
+static const char *TRACE_eventName(uint16_t id)
+{
+    switch(id)
+    {
+        case APP_TRACE_EV_TASK_IN:          return "TASK_IN";
+        case APP_TRACE_EV_TASK_OUT:         return "TASK_OUT";
+        case APP_TRACE_EV_QUEUE_SEND:       return "QUEUE_SEND";
+        case APP_TRACE_EV_QUEUE_SEND_ISR:   return "QUEUE_SEND_ISR";
+        case APP_TRACE_EV_QUEUE_RECV:       return "QUEUE_RECV";
+        case APP_TRACE_EV_QUEUE_RECV_ISR:   return "QUEUE_RECV_ISR";
+        case APP_TRACE_EV_QUEUE_SEND_FAIL:  return "QUEUE_SEND_FAIL";
+        case APP_TRACE_EV_QUEUE_RECV_FAIL:  return "QUEUE_RECV_FAIL";
+        case APP_TRACE_EV_QUEUE_BLOCK_RECV: return "QUEUE_BLOCK_RECV";
+        case APP_TRACE_EV_NOTIFY:           return "NOTIFY";
+        case APP_TRACE_EV_NOTIFY_ISR:       return "NOTIFY_ISR";
+        case APP_TRACE_EV_NOTIFY_GIVE_ISR:  return "NOTIFY_GIVE_ISR";
+        case APP_TRACE_EV_NOTIFY_TAKE:      return "NOTIFY_TAKE";
+        case APP_TRACE_EV_ISR_ENTER:        return "ISR_ENTER";
+        case APP_TRACE_EV_ISR_EXIT:         return "ISR_EXIT";
+        default:                            break;
+    }
+
+    return (id >= APP_TRACE_EV_USER) ? "USER" : "UNKNOWN";
+}
+
+static double TRACE_toUs(uint64_t cycles)
+{
+    return (double)cycles / (double)s_sysclkMHz;
+}
+
+static void TRACE_histAdd(TraceHist *hist, uint32_t cycles)
+{
+    uint16_t bin = 0U;
+
+    while(((cycles >> bin) > 1U) && (bin < (TRACE_HIST_BINS - 1U)))
+    {
+        bin++;
+    }
+
+    hist->bins[bin]++;
+    hist->sum += cycles;
+
+    if((hist->count == 0U) || (cycles < hist->min))
+    {
+        hist->min = cycles;
+    }
+
+    if(cycles > hist->max)
+    {
+        hist->max = cycles;
+    }
+
+    hist->count++;
+}
+
+static void TRACE_histPrint(const TraceHist *hist)
+{
+    uint32_t peak = 0U;
+    uint16_t bin;
+
+    printf("\n%s: %u samples", hist->name, hist->count);
+
+    if(hist->count == 0U)
+    {
+        printf("\n");
+        return;
+    }
+
+    printf(", min %.2f us, avg %.2f us, max %.2f us\n",
+           TRACE_toUs(hist->min), TRACE_toUs(hist->sum / hist->count), TRACE_toUs(hist->max));
+
+    for(bin = 0U; bin < TRACE_HIST_BINS; bin++)
+    {
+        if(hist->bins[bin] > peak)
+        {
+            peak = hist->bins[bin];
+        }
+    }
+
+    for(bin = 0U; bin < TRACE_HIST_BINS; bin++)
+    {
+        uint32_t width;
+
+        if(hist->bins[bin] == 0U)
+        {
+            continue;
+        }
+
+        width = (uint32_t)(((uint64_t)hist->bins[bin] * 40U + peak - 1U) / peak);
+        printf("  >= %10u cyc %8u  ", 1U << bin, hist->bins[bin]);
+
+        while(width-- > 0U)
+        {
+            putchar('#');
+        }
+
+        putchar('\n');
+    }
+}
+
+/**
+ * @brief 读取导出文件，返回按时间先后排列的记录。
+ */
+static TraceRecord *TRACE_load(const char *path, uint32_t *count)
+{
+    FILE *file = fopen(path, "rb");
+    uint16_t header[TRACE_HEADER_WORDS];
+    uint16_t *words;
+    TraceRecord *records;
+    uint32_t capacity;
+    uint32_t sequence;
+    uint32_t first;
+    uint32_t index;
+    size_t total;
+    uint8_t raw[2];
+
+    if(file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    for(index = 0U; index < TRACE_HEADER_WORDS; index++)
+    {
+        if(fread(raw, 1U, 2U, file) != 2U)
+        {
+            fprintf(stderr, "%s: truncated header\n", path);
+            fclose(file);
+            return NULL;
+        }
+
+        header[index] = (uint16_t)(raw[0] | (raw[1] << 8));
+    }
+
+    if((header[0] != TRACE_MAGIC) || (header[1] != TRACE_VERSION) ||
+       (header[2] == 0U) || ((header[2] & (header[2] - 1U)) != 0U) || (header[3] == 0U))
+    {
+        fprintf(stderr, "%s: not an APP_TRACE_buffer dump (magic 0x%04X version %u)\n",
+                path, header[0], header[1]);
+        fclose(file);
+        return NULL;
+    }
+
+    capacity    = header[2];
+    s_sysclkMHz = header[3];
+    sequence    = TRACE_word32(&header[4]);
+    total       = (size_t)capacity * TRACE_RECORD_WORDS;
+    words       = calloc(total, sizeof(uint16_t));
+    records     = calloc(capacity, sizeof(TraceRecord));
+
+    if((words == NULL) || (records == NULL))
+    {
+        fclose(file);
+        free(words);
+        free(records);
+        return NULL;
+    }
+
+    for(index = 0U; index < total; index++)
+    {
+        if(fread(raw, 1U, 2U, file) != 2U)
+        {
+            fprintf(stderr, "%s: truncated record area\n", path);
+            fclose(file);
+            free(words);
+            free(records);
+            return NULL;
+        }
+
+        words[index] = (uint16_t)(raw[0] | (raw[1] << 8));
+    }
+
+    fclose(file);
+
+    /* 写满后最旧的记录位于下一个写入槽位。 */
+    *count = (sequence < capacity) ? sequence : capacity;
+    first  = (sequence < capacity) ? 0U : (sequence & (capacity - 1U));
+
+    for(index = 0U; index < *count; index++)
+    {
+        const uint16_t *slot = &words[((first + index) & (capacity - 1U)) * TRACE_RECORD_WORDS];
+
+        records[index].id        = slot[0];
+        records[index].arg       = slot[1];
+        records[index].timestamp = TRACE_word32(&slot[2]);
+    }
+
+    printf("capacity %u, sysclk %u MHz, %u events written, %u in buffer\n",
+           capacity, s_sysclkMHz, sequence, *count);
+
+    free(words);
+    return records;
+}
+
+static void TRACE_analyse(const TraceRecord *records, uint32_t count, int timeline)
+{
+    static TraceHist isrHist = { .name = "ISR duration" };
+    static TraceHist sliceHist = { .name = "Task run slice" };
+    static TraceHist notifyHist = { .name = "Notify to switch-in latency" };
+    uint32_t isrStart[TRACE_MAX_IDS]    = { 0U };
+    uint32_t taskStart[TRACE_MAX_IDS]   = { 0U };
+    uint32_t notifyTime[TRACE_MAX_IDS]  = { 0U };
+    uint8_t  isrOpen[TRACE_MAX_IDS]     = { 0U };
+    uint8_t  taskOpen[TRACE_MAX_IDS]    = { 0U };
+    uint8_t  notifyOpen[TRACE_MAX_IDS]  = { 0U };
+    uint64_t elapsed = 0U;
+    uint32_t index;
+
+    for(index = 0U; index < count; index++)
+    {
+        const TraceRecord *rec = &records[index];
+        uint16_t slot = (uint16_t)(rec->arg % TRACE_MAX_IDS);
+
+        /* 32 bit 时间戳回绕由无符号减法处理，相邻事件间隔须小于 42.9 s。 */
+        if(index > 0U)
+        {
+            elapsed += (uint32_t)(rec->timestamp - records[index - 1U].timestamp);
+        }
+
+        if(timeline)
+        {
+            printf("%14.2f us  %-16s 0x%04X", TRACE_toUs(elapsed), TRACE_eventName(rec->id), rec->arg);
+
+            if(rec->id >= APP_TRACE_EV_USER)
+            {
+                printf("  (user %u)", rec->id - APP_TRACE_EV_USER);
+            }
+
+            putchar('\n');
+        }
+
+        switch(rec->id)
+        {
+            case APP_TRACE_EV_ISR_ENTER:
+                isrStart[slot] = rec->timestamp;
+                isrOpen[slot]  = 1U;
+                break;
+
+            case APP_TRACE_EV_ISR_EXIT:
+                if(isrOpen[slot])
+                {
+                    TRACE_histAdd(&isrHist, rec->timestamp - isrStart[slot]);
+                    isrOpen[slot] = 0U;
+                }
+                break;
+
+            case APP_TRACE_EV_TASK_IN:
+                taskStart[slot] = rec->timestamp;
+                taskOpen[slot]  = 1U;
+
+                if(notifyOpen[slot])
+                {
+                    TRACE_histAdd(&notifyHist, rec->timestamp - notifyTime[slot]);
+                    notifyOpen[slot] = 0U;
+                }
+                break;
+
+            case APP_TRACE_EV_TASK_OUT:
+                if(taskOpen[slot])
+                {
+                    TRACE_histAdd(&sliceHist, rec->timestamp - taskStart[slot]);
+                    taskOpen[slot] = 0U;
+                }
+                break;
+
+            case APP_TRACE_EV_NOTIFY:
+            case APP_TRACE_EV_NOTIFY_ISR:
+            case APP_TRACE_EV_NOTIFY_GIVE_ISR:
+                /* 只保留第一次通知，测量被通知任务最长的等待。 */
+                if(!notifyOpen[slot])
+                {
+                    notifyTime[slot] = rec->timestamp;
+                    notifyOpen[slot] = 1U;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    TRACE_histPrint(&isrHist);
+    TRACE_histPrint(&sliceHist);
+    TRACE_histPrint(&notifyHist);
+}
+
+static void TRACE_putWord(FILE *file, uint16_t word)
+{
+    fputc(word & 0xFFU, file);
+    fputc(word >> 8, file);
+}
+
+/**
+ * @brief 生成合成导出：1 kHz 定时器中断通知任务 2，任务 1 为空闲任务，
+ *        写入条数超过容量以覆盖回绕路径，时间戳从接近回绕处开始。
+ */
+static int TRACE_synth(const char *path)
+{
+    enum { CAPACITY = 512U, MHZ = 100U };
+    static uint16_t words[CAPACITY * TRACE_RECORD_WORDS];
+    uint32_t sequence = 0U;
+    uint32_t now = 0xFFF00000UL;
+    uint32_t period;
+    uint32_t idle = 0U;
+    FILE *file;
+    uint16_t index;
+
+#define SYNTH_EMIT(evId, evArg, dt) do { \
+        uint16_t *slot_ = &words[(sequence & (CAPACITY - 1U)) * TRACE_RECORD_WORDS]; \
+        now += (dt); \
+        slot_[0] = (evId); slot_[1] = (evArg); \
+        slot_[2] = (uint16_t)(now & 0xFFFFU); slot_[3] = (uint16_t)(now >> 16); \
+        sequence++; \
+    } while(0)
+
+    srand(1U);
+
+    for(period = 0U; period < 200U; period++)
+    {
+        uint32_t isrCycles = 300U + (uint32_t)(rand() % 200);
+        uint32_t latency   = 150U + (uint32_t)(rand() % 100);
+        uint32_t work      = 2000U + (uint32_t)(rand() % 8000);
+
+        SYNTH_EMIT(APP_TRACE_EV_ISR_ENTER, 0U, idle);
+        SYNTH_EMIT(APP_TRACE_EV_NOTIFY_GIVE_ISR, 2U, isrCycles / 2U);
+        SYNTH_EMIT(APP_TRACE_EV_ISR_EXIT, 0U, isrCycles - isrCycles / 2U);
+        SYNTH_EMIT(APP_TRACE_EV_TASK_OUT, 1U, latency / 2U);
+        SYNTH_EMIT(APP_TRACE_EV_TASK_IN, 2U, latency - latency / 2U);
+        SYNTH_EMIT(APP_TRACE_EV_NOTIFY_TAKE, 2U, 40U);
+        SYNTH_EMIT(APP_TRACE_EV_QUEUE_SEND, 0x0003U, work);
+        SYNTH_EMIT(APP_TRACE_EV_QUEUE_BLOCK_RECV, 0x0001U, 60U);
+        SYNTH_EMIT(APP_TRACE_EV_TASK_OUT, 2U, 40U);
+        SYNTH_EMIT(APP_TRACE_EV_TASK_IN, 1U, 80U);
+        SYNTH_EMIT(APP_TRACE_EV_USER + 1U, (uint16_t)period, 20U);
+
+        /* 本周期剩余时间为空闲，计入下一次中断入口的间隔。 */
+        idle = (MHZ * 1000U) - isrCycles - latency - work - 240U;
+    }
+
+#undef SYNTH_EMIT
+
+    file = fopen(path, "wb");
+
+    if(file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    TRACE_putWord(file, TRACE_MAGIC);
+    TRACE_putWord(file, TRACE_VERSION);
+    TRACE_putWord(file, CAPACITY);
+    TRACE_putWord(file, MHZ);
+    TRACE_putWord(file, (uint16_t)(sequence & 0xFFFFU));
+    TRACE_putWord(file, (uint16_t)(sequence >> 16));
+    TRACE_putWord(file, 0U);
+    TRACE_putWord(file, 0U);
+
+    for(index = 0U; index < (CAPACITY * TRACE_RECORD_WORDS); index++)
+    {
+        TRACE_putWord(file, words[index]);
+    }
+
+    fclose(file);
+    printf("wrote %u events (%u kept) to %s\n", sequence, CAPACITY, path);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    TraceRecord *records;
+    uint32_t count = 0U;
+    int timeline = 1;
+    int arg = 1;
+
+    if((argc == 3) && (strcmp(argv[1], "--synth") == 0))
+    {
+        return TRACE_synth(argv[2]);
+    }
+
+    if((argc == 3) && (strcmp(argv[1], "-q") == 0))
+    {
+        timeline = 0;
+        arg = 2;
+    }
+
+    if(arg != (argc - 1))
+    {
+        fprintf(stderr, "usage: %s [-q] dump.bin\n       %s --synth out.bin\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    records = TRACE_load(argv[arg], &count);
+
+    if(records == NULL)
+    {
+        return 1;
+    }
+
+    TRACE_analyse(records, count, timeline);
+    free(records);
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file sci_pty.h
+ * @brief 主机端 DRV_SCI 替身接口，收发均经过文件描述符。
+ *
+ * 与 telem_host 的 sci_mock 相同，DRV_SCI_send 只入队，SCI_PTY_tick 每调用一次按
+ * 115200 bit/s 推进一个 tick 的线路时间并写出字节，缓冲区全部写出后清除 busy；
+ * 另外 DRV_SCI_read 以非阻塞方式从同一个文件描述符读取主机发来的字节。
+ * 文件描述符写满时停止推进，等同线路被占用。
+ */
+
+#ifndef SCI_PTY_H
+#define SCI_PTY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "drv_sci.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 清空队列并设定文件描述符与节拍。
+ *
+ * @param[in] fd     读写的文件描述符，须为非阻塞。
+ * @param[in] tickHz SCI_PTY_tick 对应的频率。
+ */
+void SCI_PTY_init(int fd, uint32_t tickHz);
+
+/**
+ * @brief 推进一个 tick 的线路时间。
+ */
+void SCI_PTY_tick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCI_PTY_H */
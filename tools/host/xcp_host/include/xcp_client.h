@@ -0,0 +1,160 @@
+/**
+ * @file xcp_client.h
+ * @brief XCP 风格标定协议的主机端客户端接口。
+ *
+ * 客户端在一个已打开的串口或伪终端文件描述符上收发 app_xcp.h 定义的帧。每条命令
+ * 带递增计数，等待计数相同的应答；等待期间收到的 DAQ 包交给回调，遥测包只计数。
+ * 连接时读取目标的整个符号表，之后按名称查找地址与类型。
+ *
+ * 写入分两步：XCP_CLIENT_stageValue 只暂存，XCP_CLIENT_commit 在目标控制中断的
+ * 安全点一次写入全部暂存值；XCP_CLIENT_writeValue 为单项写入加提交。
+ */
+
+#ifndef XCP_CLIENT_H
+#define XCP_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_xcp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 缓存的符号数上限。 */
+#define XCP_CLIENT_MAX_SYMBOLS      (128U)
+
+/** 超时与传输错误，不与目标的错误码重叠。 */
+#define XCP_CLIENT_ERR_TIMEOUT      (0x100U)
+#define XCP_CLIENT_ERR_IO           (0x101U)
+#define XCP_CLIENT_ERR_PROTOCOL     (0x102U)
+
+/**
+ * @brief 符号。
+ */
+typedef struct
+{
+    char     name[APP_XCP_NAME_MAX + 1U];
+    uint32_t address;
+    uint16_t type;
+    uint16_t flags;
+    uint16_t words;
+} XCP_ClientSymbol;
+
+/**
+ * @brief 目标状态。
+ */
+typedef struct
+{
+    uint16_t daqRunning;            /**< 运行中的 DAQ 列表掩码。 */
+    uint16_t staged;                /**< 暂存条目数。 */
+    uint32_t safePoints;            /**< 安全点计数。 */
+    uint32_t daqOverruns;           /**< DAQ 队列满丢弃的样本数。 */
+} XCP_ClientStatus;
+
+/**
+ * @brief DAQ 包。
+ */
+typedef struct
+{
+    uint16_t        list;
+    uint16_t        sequence;
+    uint32_t        timestamp;
+    uint16_t        words;
+    const uint16_t *data;           /**< 只在回调期间有效。 */
+} XCP_DaqPacket;
+
+typedef void (*XCP_DaqCallback)(const XCP_DaqPacket *packet, void *context);
+
+/**
+ * @brief 客户端状态，由调用者分配。
+ */
+typedef struct
+{
+    int              fd;
+    int              timeoutMs;
+    uint16_t         counter;
+    uint16_t         rxFrame[512];
+    uint16_t         rxLength;
+    bool             rxDiscard;
+    uint16_t         raw[512];
+    uint16_t         response[APP_XCP_RAW_MAX + APP_TELEM_FRAME_CRC_BYTES];
+    uint16_t         responseLength;
+    uint16_t         lastError;
+    XCP_ClientSymbol symbols[XCP_CLIENT_MAX_SYMBOLS];
+    uint16_t         symbolCount;
+    uint16_t         spaces;        /**< 目标登记的地址空间掩码。 */
+    XCP_DaqCallback  daqCallback;
+    void            *daqContext;
+    uint32_t         daqPackets;
+    uint32_t         otherPackets;
+    uint32_t         badFrames;
+} XCP_Client;
+
+void XCP_CLIENT_init(XCP_Client *client, int fd, int timeoutMs);
+void XCP_CLIENT_setDaqCallback(XCP_Client *client, XCP_DaqCallback callback, void *context);
+
+/**
+ * @brief 连接并读取符号表。
+ */
+bool XCP_CLIENT_connect(XCP_Client *client);
+bool XCP_CLIENT_disconnect(XCP_Client *client);
+bool XCP_CLIENT_getStatus(XCP_Client *client, XCP_ClientStatus *status);
+
+/**
+ * @brief 按名称查找符号，未找到时为 NULL。
+ */
+const XCP_ClientSymbol *XCP_CLIENT_findSymbol(const XCP_Client *client, const char *name);
+
+/**
+ * @brief 按地址读写，长度以 16 bit 字计。
+ */
+bool XCP_CLIENT_upload(XCP_Client *client, uint16_t extension, uint32_t address,
+                       uint16_t words, uint16_t *data);
+bool XCP_CLIENT_download(XCP_Client *client, uint16_t extension, uint32_t address,
+                         uint16_t words, const uint16_t *data);
+bool XCP_CLIENT_shortDownload(XCP_Client *client, uint16_t extension, uint32_t address,
+                              uint16_t words, const uint16_t *data);
+bool XCP_CLIENT_commit(XCP_Client *client);
+
+/**
+ * @brief 按符号类型换算读写。
+ */
+bool XCP_CLIENT_readValue(XCP_Client *client, const XCP_ClientSymbol *symbol, double *value);
+bool XCP_CLIENT_stageValue(XCP_Client *client, const XCP_ClientSymbol *symbol, double value);
+bool XCP_CLIENT_writeValue(XCP_Client *client, const XCP_ClientSymbol *symbol, double value);
+
+/**
+ * @brief 把字数组按符号类型换算为数值，DAQ 回调中使用。
+ */
+double XCP_CLIENT_decodeValue(uint16_t type, const uint16_t *words);
+
+/**
+ * @brief DAQ 列表配置。
+ */
+bool XCP_CLIENT_clearDaq(XCP_Client *client, uint16_t list);
+bool XCP_CLIENT_addDaq(XCP_Client *client, uint16_t list, uint32_t address, uint16_t words);
+bool XCP_CLIENT_setDaqPrescaler(XCP_Client *client, uint16_t list, uint16_t prescaler);
+bool XCP_CLIENT_startDaq(XCP_Client *client, uint16_t list, bool start);
+
+/**
+ * @brief 接收并分发 DAQ 包 timeoutMs 毫秒。
+ */
+void XCP_CLIENT_poll(XCP_Client *client, int timeoutMs);
+
+/**
+ * @brief 发送任意请求（不含计数）并等待应答，用于测试未定义的命令。
+ */
+bool XCP_CLIENT_command(XCP_Client *client, const uint16_t *request, uint16_t length);
+
+/**
+ * @brief 错误码的文字说明。
+ */
+const char *XCP_CLIENT_errorName(uint16_t code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XCP_CLIENT_H */
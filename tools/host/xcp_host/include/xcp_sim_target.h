@@ -0,0 +1,63 @@
+/**
+ * @file xcp_sim_target.h
+ * @brief 主机端模拟目标：以线程模拟控制中断，运行 app_xcp.c 的真实代码。
+ *
+ * 模拟目标的 CPU 内存是一个 XCP_SimMemory 结构，其中包含 components/pid 的 PID_Obj
+ * 及其微分滤波器，经 APP_XCP_setMemoryWindow 映射为从 0 开始的字地址。中断线程约每
+ * 100 us 依次执行 APP_XCP_safePoint、一次 PID 计算与一阶对象，再执行 APP_XCP_daqSample；
+ * 主循环每 1 ms 推进 SCI 线路时间并调用 APP_XCP_service，与目标板上中断和任务的分工
+ * 相同。
+ *
+ * 每次 PID 计算前检查两条不变式，违反时 violations 加 1：
+ *  - Ki == 2 * Kp；
+ *  - derFilter.b0 + derFilter.b1 == 1 + derFilter.a1。
+ * 主机端同时写入相关参数时，只有在同一次提交中写入才能保证不变式始终成立。
+ *
+ * 地址扩展 1 为 32 个 16 bit 寄存器的模拟异步空间，每次操作在 3 个 tick 后完成，
+ * 与 DRV8316 寄存器空间的时序相似。
+ */
+
+#ifndef XCP_SIM_TARGET_H
+#define XCP_SIM_TARGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 模拟异步空间的寄存器数。 */
+#define XCP_SIM_SPACE_REGS          (32U)
+
+/**
+ * @brief 模拟目标的内存。
+ */
+typedef struct
+{
+    PID_Obj   pid;
+    float32_t ref;                  /**< 给定。 */
+    float32_t output;               /**< PID 输出。 */
+    float32_t plant;                /**< 一阶对象输出，即反馈。 */
+    uint32_t  loops;                /**< 中断次数，也是 DAQ 时间戳。 */
+    uint32_t  violations;           /**< 不变式违反次数。 */
+    uint16_t  isrEnable;            /**< 0 时中断线程空转，用于检查提交超时。 */
+    uint16_t  reserved;
+} XCP_SimMemory;
+
+/**
+ * @brief 在文件描述符上运行模拟目标，直到 *stop 为 true。
+ *
+ * @param[in] fd 非阻塞的串口或伪终端。
+ *
+ * @retval false 线程创建失败。
+ */
+bool XCP_SIM_run(int fd, volatile const bool *stop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XCP_SIM_TARGET_H */
@@ -0,0 +1,169 @@
+/**
+ * @file sci_pty.c
+ * @brief 主机端 DRV_SCI 替身实现，按波特率写出发送队列并读取接收字节。
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "sci_pty.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+static DRV_SCI_TxBuffer *s_queue[DRV_SCI_TX_QUEUE_DEPTH];
+static uint16_t s_head = 0U;
+static uint16_t s_tail = 0U;
+static uint16_t s_index = 0U;
+
+static int s_fd = -1;
+static uint32_t s_tickHz = 1U;
+
+/** 线路额度，单位为 1 / tickHz 字节。 */
+static uint32_t s_credit = 0U;
+
+/** 已从队列取出、尚未写入文件描述符的字节。 */
+static uint8_t s_out[64];
+static size_t s_outLength = 0U;
+
+static DRV_SCI_Stats s_stats;
+
+/**
+ * @brief 写出缓存的字节，文件描述符已满时返回 false。
+ */
+static bool SCI_PTY_flush(void)
+{
+    size_t done = 0U;
+
+    while(done < s_outLength)
+    {
+        ssize_t written = write(s_fd, &s_out[done], s_outLength - done);
+
+        if(written <= 0)
+        {
+            if((written < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        done += (size_t)written;
+    }
+
+    memmove(s_out, &s_out[done], s_outLength - done);
+    s_outLength -= done;
+
+    return s_outLength == 0U;
+}
+
+void SCI_PTY_init(int fd, uint32_t tickHz)
+{
+    s_fd        = fd;
+    s_tickHz    = (tickHz == 0U) ? 1U : tickHz;
+    s_head      = 0U;
+    s_tail      = 0U;
+    s_index     = 0U;
+    s_credit    = 0U;
+    s_outLength = 0U;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void SCI_PTY_tick(void)
+{
+    if(!SCI_PTY_flush())
+    {
+        return;
+    }
+
+    s_credit += DRV_SCI_BAUD / DRV_SCI_BITS_PER_BYTE;
+
+    while((s_tail != s_head) && (s_credit >= s_tickHz) && (s_outLength < sizeof(s_out)))
+    {
+        DRV_SCI_TxBuffer *buffer = s_queue[s_tail & DRV_SCI_TX_QUEUE_MASK];
+
+        s_out[s_outLength] = (uint8_t)(buffer->data[s_index] & 0xFFU);
+        s_outLength++;
+        s_index++;
+        s_credit -= s_tickHz;
+        s_stats.txBytes++;
+
+        if(s_index >= buffer->length)
+        {
+            s_index = 0U;
+            buffer->busy = 0U;
+            s_stats.txBuffers++;
+            s_tail++;
+        }
+    }
+
+    /* 线路空闲时不积累额度，与真实 UART 一致。 */
+    if(s_tail == s_head)
+    {
+        s_credit = 0U;
+    }
+
+    (void)SCI_PTY_flush();
+}
+
+void DRV_SCI_init(void)
+{
+}
+
+bool DRV_SCI_send(DRV_SCI_TxBuffer *buffer)
+{
+    if((buffer == NULL) || (buffer->data == NULL) || (buffer->length == 0U) ||
+       (buffer->busy != 0U) || ((uint16_t)(s_head - s_tail) >= DRV_SCI_TX_QUEUE_DEPTH))
+    {
+        return false;
+    }
+
+    buffer->busy = 1U;
+    s_queue[s_head & DRV_SCI_TX_QUEUE_MASK] = buffer;
+    s_head++;
+
+    return true;
+}
+
+uint16_t DRV_SCI_getTxPending(void)
+{
+    return (uint16_t)(s_head - s_tail);
+}
+
+uint16_t DRV_SCI_read(uint16_t *data, uint16_t maxLength)
+{
+    uint8_t bytes[64];
+    ssize_t count;
+    uint16_t i;
+
+    if(maxLength > sizeof(bytes))
+    {
+        maxLength = sizeof(bytes);
+    }
+
+    count = read(s_fd, bytes, maxLength);
+
+    if(count <= 0)
+    {
+        return 0U;
+    }
+
+    for(i = 0U; i < (uint16_t)count; i++)
+    {
+        data[i] = bytes[i];
+    }
+
+    s_stats.rxBytes += (uint32_t)count;
+
+    return (uint16_t)count;
+}
+
+void DRV_SCI_getStats(DRV_SCI_Stats *stats)
+{
+    if(stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
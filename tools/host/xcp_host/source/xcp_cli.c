@@ -0,0 +1,276 @@
+/**
+ * @file xcp_cli.c
+ * @brief 标定协议命令行工具（主机端）。
+ *
+ * 用法：
+ *   xcp_cli <串口> list                          列出符号
+ *   xcp_cli <串口> get <名称> ...                读取
+ *   xcp_cli <串口> set <名称>=<值> ...           在同一次提交中写入全部参数
+ *   xcp_cli <串口> daq <毫秒> <分频> <名称> ...  以 DAQ 列表 0 采集并逐行打印
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "xcp_client.h"
+
+/** 一次 DAQ 采集的符号数上限。 */
+#define CLI_DAQ_SYMBOLS     (APP_XCP_DAQ_ENTRIES)
+
+typedef struct
+{
+    const XCP_ClientSymbol *symbols[CLI_DAQ_SYMBOLS];
+    uint16_t                count;
+} CliDaq;
+
+static const char *s_typeNames[] = { "float32", "int16", "uint16", "int32", "uint32" };
+
+static int openSerial(const char *path)
+{
+    struct termios tio;
+    int fd = open(path, O_RDWR | O_NOCTTY);
+
+    if(fd < 0)
+    {
+        perror(path);
+        return -1;
+    }
+
+    if(tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+static const XCP_ClientSymbol *findOrFail(const XCP_Client *client, const char *name)
+{
+    const XCP_ClientSymbol *symbol = XCP_CLIENT_findSymbol(client, name);
+
+    if(symbol == NULL)
+    {
+        fprintf(stderr, "unknown symbol: %s\n", name);
+    }
+
+    return symbol;
+}
+
+static void printDaq(const XCP_DaqPacket *packet, void *context)
+{
+    const CliDaq *daq = (const CliDaq *)context;
+    uint16_t offset = 0U;
+    uint16_t i;
+
+    printf("%10lu %3u", (unsigned long)packet->timestamp, packet->sequence);
+
+    for(i = 0U; (i < daq->count) && ((offset + daq->symbols[i]->words) <= packet->words); i++)
+    {
+        printf(" %12g", XCP_CLIENT_decodeValue(daq->symbols[i]->type, &packet->data[offset]));
+        offset += daq->symbols[i]->words;
+    }
+
+    printf("\n");
+}
+
+static int commandList(const XCP_Client *client)
+{
+    uint16_t i;
+
+    for(i = 0U; i < client->symbolCount; i++)
+    {
+        const XCP_ClientSymbol *symbol = &client->symbols[i];
+
+        printf("%-24s 0x%08lx %-7s %s\n", symbol->name, (unsigned long)symbol->address,
+               (symbol->type < 5U) ? s_typeNames[symbol->type] : "?",
+               ((symbol->flags & APP_XCP_SYM_WRITABLE) != 0U) ? "rw" : "ro");
+    }
+
+    return 0;
+}
+
+static int commandGet(XCP_Client *client, int argc, char **argv)
+{
+    int i;
+
+    for(i = 0; i < argc; i++)
+    {
+        const XCP_ClientSymbol *symbol = findOrFail(client, argv[i]);
+        double value;
+
+        if(symbol == NULL)
+        {
+            return 1;
+        }
+
+        if(!XCP_CLIENT_readValue(client, symbol, &value))
+        {
+            fprintf(stderr, "%s: %s\n", argv[i], XCP_CLIENT_errorName(client->lastError));
+            return 1;
+        }
+
+        printf("%s = %g\n", symbol->name, value);
+    }
+
+    return 0;
+}
+
+static int commandSet(XCP_Client *client, int argc, char **argv)
+{
+    int i;
+
+    for(i = 0; i < argc; i++)
+    {
+        char name[APP_XCP_NAME_MAX + 1U];
+        const char *equals = strchr(argv[i], '=');
+        const XCP_ClientSymbol *symbol;
+        size_t length;
+
+        if((equals == NULL) || ((length = (size_t)(equals - argv[i])) > APP_XCP_NAME_MAX))
+        {
+            fprintf(stderr, "expected name=value: %s\n", argv[i]);
+            return 1;
+        }
+
+        memcpy(name, argv[i], length);
+        name[length] = '\0';
+        symbol = findOrFail(client, name);
+
+        if((symbol == NULL) || !XCP_CLIENT_stageValue(client, symbol, strtod(equals + 1, NULL)))
+        {
+            if(symbol != NULL)
+            {
+                fprintf(stderr, "%s: %s\n", name, XCP_CLIENT_errorName(client->lastError));
+            }
+
+            (void)XCP_CLIENT_disconnect(client);
+            return 1;
+        }
+    }
+
+    if(!XCP_CLIENT_commit(client))
+    {
+        fprintf(stderr, "commit: %s\n", XCP_CLIENT_errorName(client->lastError));
+        return 1;
+    }
+
+    return 0;
+}
+
+static int commandDaq(XCP_Client *client, int argc, char **argv)
+{
+    CliDaq daq;
+    int duration;
+    int i;
+
+    if(argc < 3)
+    {
+        fprintf(stderr, "daq <ms> <prescaler> <name> ...\n");
+        return 1;
+    }
+
+    duration  = atoi(argv[0]);
+    daq.count = 0U;
+
+    if(!XCP_CLIENT_clearDaq(client, 0U) ||
+       !XCP_CLIENT_setDaqPrescaler(client, 0U, (uint16_t)atoi(argv[1])))
+    {
+        fprintf(stderr, "daq: %s\n", XCP_CLIENT_errorName(client->lastError));
+        return 1;
+    }
+
+    for(i = 2; (i < argc) && (daq.count < CLI_DAQ_SYMBOLS); i++)
+    {
+        const XCP_ClientSymbol *symbol = findOrFail(client, argv[i]);
+
+        if((symbol == NULL) || !XCP_CLIENT_addDaq(client, 0U, symbol->address, symbol->words))
+        {
+            if(symbol != NULL)
+            {
+                fprintf(stderr, "%s: %s\n", argv[i], XCP_CLIENT_errorName(client->lastError));
+            }
+
+            return 1;
+        }
+
+        daq.symbols[daq.count] = symbol;
+        daq.count++;
+    }
+
+    XCP_CLIENT_setDaqCallback(client, printDaq, &daq);
+
+    if(!XCP_CLIENT_startDaq(client, 0U, true))
+    {
+        fprintf(stderr, "start: %s\n", XCP_CLIENT_errorName(client->lastError));
+        return 1;
+    }
+
+    XCP_CLIENT_poll(client, duration);
+    (void)XCP_CLIENT_startDaq(client, 0U, false);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static XCP_Client client;
+    int fd;
+    int result;
+
+    if(argc < 3)
+    {
+        fprintf(stderr, "usage: %s <device> list | get <name>... | set <name>=<value>... | "
+                        "daq <ms> <prescaler> <name>...\n", argv[0]);
+        return 2;
+    }
+
+    fd = openSerial(argv[1]);
+
+    if(fd < 0)
+    {
+        return 2;
+    }
+
+    XCP_CLIENT_init(&client, fd, 1000);
+
+    if(!XCP_CLIENT_connect(&client))
+    {
+        fprintf(stderr, "connect: %s\n", XCP_CLIENT_errorName(client.lastError));
+        return 1;
+    }
+
+    if(strcmp(argv[2], "list") == 0)
+    {
+        result = commandList(&client);
+    }
+    else if(strcmp(argv[2], "get") == 0)
+    {
+        result = commandGet(&client, argc - 3, &argv[3]);
+    }
+    else if(strcmp(argv[2], "set") == 0)
+    {
+        result = commandSet(&client, argc - 3, &argv[3]);
+    }
+    else if(strcmp(argv[2], "daq") == 0)
+    {
+        result = commandDaq(&client, argc - 3, &argv[3]);
+    }
+    else
+    {
+        fprintf(stderr, "unknown command: %s\n", argv[2]);
+        result = 2;
+    }
+
+    close(fd);
+
+    return result;
+}
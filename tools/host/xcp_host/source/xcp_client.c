@@ -0,0 +1,619 @@
+/**
+ * @file xcp_client.c
+ * @brief XCP 风格标定协议客户端实现（主机端）。
+ */
+
+#include "xcp_client.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static long XCP_CLIENT_nowMs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (long)(now.tv_sec * 1000L) + (long)(now.tv_nsec / 1000000L);
+}
+
+static bool XCP_CLIENT_writeAll(XCP_Client *client, const uint8_t *data, size_t length)
+{
+    while(length > 0U)
+    {
+        ssize_t written = write(client->fd, data, length);
+
+        if(written < 0)
+        {
+            if((errno == EINTR) || (errno == EAGAIN))
+            {
+                struct pollfd pfd = { client->fd, POLLOUT, 0 };
+
+                (void)poll(&pfd, 1, 10);
+                continue;
+            }
+
+            return false;
+        }
+
+        data   += written;
+        length -= (size_t)written;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 处理一帧；是当前命令的应答时复制到 response 并返回 true。
+ */
+static bool XCP_CLIENT_frame(XCP_Client *client, uint16_t counter)
+{
+    uint16_t length = 0U;
+    uint16_t pid;
+
+    if(!APP_TELEM_FRAME_decode(client->rxFrame, client->rxLength, client->raw,
+                               (uint16_t)(sizeof(client->raw) / sizeof(client->raw[0])), &length) ||
+       (length < 2U))
+    {
+        client->badFrames++;
+        return false;
+    }
+
+    pid = client->raw[0];
+
+    if((pid == APP_XCP_PID_RES) || (pid == APP_XCP_PID_ERR))
+    {
+        /* 计数不符的为此前超时命令的迟到应答。 */
+        if((client->raw[1] != counter) || (length > (uint16_t)(sizeof(client->response) / sizeof(client->response[0]))))
+        {
+            return false;
+        }
+
+        memcpy(client->response, client->raw, length * sizeof(client->raw[0]));
+        client->responseLength = length;
+
+        return true;
+    }
+
+    if((pid >= APP_XCP_PID_DAQ) && (pid < (APP_XCP_PID_DAQ + APP_XCP_DAQ_LISTS)) && (length >= 6U))
+    {
+        uint16_t data[APP_XCP_DAQ_MAX_WORDS];
+        XCP_DaqPacket packet;
+        uint16_t i;
+
+        packet.list      = (uint16_t)(pid - APP_XCP_PID_DAQ);
+        packet.sequence  = client->raw[1];
+        packet.timestamp = APP_TELEM_FRAME_getU32(&client->raw[2]);
+        packet.words     = (uint16_t)((length - 6U) / 2U);
+        packet.data      = data;
+
+        if(packet.words > APP_XCP_DAQ_MAX_WORDS)
+        {
+            client->badFrames++;
+            return false;
+        }
+
+        for(i = 0U; i < packet.words; i++)
+        {
+            data[i] = APP_TELEM_FRAME_getU16(&client->raw[6U + (2U * i)]);
+        }
+
+        client->daqPackets++;
+
+        if(client->daqCallback != NULL)
+        {
+            client->daqCallback(&packet, client->daqContext);
+        }
+
+        return false;
+    }
+
+    /* 遥测包。 */
+    client->otherPackets++;
+
+    return false;
+}
+
+/**
+ * @brief 接收并分发帧，直到收到计数为 counter 的应答或超时；counter 大于 0xFF 时只分发。
+ */
+static bool XCP_CLIENT_receive(XCP_Client *client, uint16_t counter, int timeoutMs)
+{
+    long deadline = XCP_CLIENT_nowMs() + timeoutMs;
+
+    for(;;)
+    {
+        uint8_t buffer[256];
+        struct pollfd pfd = { client->fd, POLLIN, 0 };
+        long remaining = deadline - XCP_CLIENT_nowMs();
+        ssize_t count;
+        ssize_t i;
+
+        if(remaining <= 0)
+        {
+            return false;
+        }
+
+        if(poll(&pfd, 1, (int)remaining) <= 0)
+        {
+            continue;
+        }
+
+        count = read(client->fd, buffer, sizeof(buffer));
+
+        if(count <= 0)
+        {
+            if((count < 0) && (errno != EINTR) && (errno != EAGAIN))
+            {
+                client->lastError = XCP_CLIENT_ERR_IO;
+                return false;
+            }
+
+            continue;
+        }
+
+        for(i = 0; i < count; i++)
+        {
+            uint8_t byte = buffer[i];
+
+            if(byte == APP_TELEM_FRAME_DELIMITER)
+            {
+                bool matched = !client->rxDiscard && (client->rxLength != 0U) &&
+                               XCP_CLIENT_frame(client, counter);
+
+                client->rxLength  = 0U;
+                client->rxDiscard = false;
+
+                /* 同一批读到的其余帧继续分发，读完本批再返回。 */
+                if(matched)
+                {
+                    counter = 0xFFFFU;
+                    deadline = 0;
+                }
+
+                continue;
+            }
+
+            if(client->rxDiscard)
+            {
+                continue;
+            }
+
+            if(client->rxLength >= (uint16_t)(sizeof(client->rxFrame) / sizeof(client->rxFrame[0])))
+            {
+                client->badFrames++;
+                client->rxDiscard = true;
+                continue;
+            }
+
+            client->rxFrame[client->rxLength] = byte;
+            client->rxLength++;
+        }
+
+        if(deadline == 0)
+        {
+            return true;
+        }
+    }
+}
+
+bool XCP_CLIENT_command(XCP_Client *client, const uint16_t *request, uint16_t length)
+{
+    uint16_t raw[APP_XCP_RAW_MAX + APP_TELEM_FRAME_CRC_BYTES];
+    uint16_t frame[APP_XCP_FRAME_MAX];
+    uint8_t bytes[APP_XCP_FRAME_MAX];
+    uint16_t frameLength;
+    uint16_t counter;
+    uint16_t i;
+
+    if((length == 0U) || (length > (APP_XCP_RAW_MAX - 1U)))
+    {
+        client->lastError = XCP_CLIENT_ERR_PROTOCOL;
+        return false;
+    }
+
+    client->lastError = 0U;
+    counter = client->counter;
+    client->counter = (uint16_t)((client->counter + 1U) & 0xFFU);
+
+    raw[0] = request[0];
+    raw[1] = counter;
+
+    for(i = 1U; i < length; i++)
+    {
+        raw[i + 1U] = request[i] & 0xFFU;
+    }
+
+    frameLength = APP_TELEM_FRAME_encode(raw, (uint16_t)(length + 1U), frame, APP_XCP_FRAME_MAX);
+
+    for(i = 0U; i < frameLength; i++)
+    {
+        bytes[i] = (uint8_t)frame[i];
+    }
+
+    if((frameLength == 0U) || !XCP_CLIENT_writeAll(client, bytes, frameLength))
+    {
+        client->lastError = XCP_CLIENT_ERR_IO;
+        return false;
+    }
+
+    if(!XCP_CLIENT_receive(client, counter, client->timeoutMs))
+    {
+        if(client->lastError != XCP_CLIENT_ERR_IO)
+        {
+            client->lastError = XCP_CLIENT_ERR_TIMEOUT;
+        }
+
+        return false;
+    }
+
+    if(client->response[0] == APP_XCP_PID_ERR)
+    {
+        client->lastError = (client->responseLength >= 3U) ? client->response[2] : XCP_CLIENT_ERR_PROTOCOL;
+        return false;
+    }
+
+    client->lastError = 0U;
+
+    return true;
+}
+
+void XCP_CLIENT_init(XCP_Client *client, int fd, int timeoutMs)
+{
+    memset(client, 0, sizeof(*client));
+    client->fd        = fd;
+    client->timeoutMs = timeoutMs;
+}
+
+void XCP_CLIENT_setDaqCallback(XCP_Client *client, XCP_DaqCallback callback, void *context)
+{
+    client->daqCallback = callback;
+    client->daqContext  = context;
+}
+
+bool XCP_CLIENT_connect(XCP_Client *client)
+{
+    uint16_t request[4];
+    uint16_t count;
+    uint16_t i;
+
+    request[0] = APP_XCP_CMD_CONNECT;
+
+    if(!XCP_CLIENT_command(client, request, 1U) || (client->responseLength < 9U) ||
+       (client->response[2] != APP_XCP_VERSION))
+    {
+        return false;
+    }
+
+    count          = APP_TELEM_FRAME_getU16(&client->response[6]);
+    client->spaces = client->response[8];
+
+    if(count > XCP_CLIENT_MAX_SYMBOLS)
+    {
+        count = XCP_CLIENT_MAX_SYMBOLS;
+    }
+
+    client->symbolCount = 0U;
+
+    /* [类型][标志][字数][名称长度][地址 4B][名称]。 */
+    for(i = 0U; i < count; i++)
+    {
+        XCP_ClientSymbol *symbol = &client->symbols[i];
+        uint16_t length;
+        uint16_t j;
+
+        request[0] = APP_XCP_CMD_USER;
+        request[1] = APP_XCP_USER_GET_SYMBOL;
+        request[2] = i & 0xFFU;
+        request[3] = i >> 8;
+
+        if(!XCP_CLIENT_command(client, request, 4U) || (client->responseLength < 10U))
+        {
+            return false;
+        }
+
+        length = client->response[5];
+
+        if((length > APP_XCP_NAME_MAX) || (client->responseLength < (10U + length)))
+        {
+            client->lastError = XCP_CLIENT_ERR_PROTOCOL;
+            return false;
+        }
+
+        symbol->type    = client->response[2];
+        symbol->flags   = client->response[3];
+        symbol->words   = client->response[4];
+        symbol->address = APP_TELEM_FRAME_getU32(&client->response[6]);
+
+        for(j = 0U; j < length; j++)
+        {
+            symbol->name[j] = (char)client->response[10U + j];
+        }
+
+        symbol->name[length] = '\0';
+        client->symbolCount++;
+    }
+
+    return true;
+}
+
+bool XCP_CLIENT_disconnect(XCP_Client *client)
+{
+    uint16_t request = APP_XCP_CMD_DISCONNECT;
+
+    return XCP_CLIENT_command(client, &request, 1U);
+}
+
+bool XCP_CLIENT_getStatus(XCP_Client *client, XCP_ClientStatus *status)
+{
+    uint16_t request = APP_XCP_CMD_GET_STATUS;
+
+    if(!XCP_CLIENT_command(client, &request, 1U) || (client->responseLength < 12U))
+    {
+        return false;
+    }
+
+    status->daqRunning  = client->response[2];
+    status->staged      = client->response[3];
+    status->safePoints  = APP_TELEM_FRAME_getU32(&client->response[4]);
+    status->daqOverruns = APP_TELEM_FRAME_getU32(&client->response[8]);
+
+    return true;
+}
+
+const XCP_ClientSymbol *XCP_CLIENT_findSymbol(const XCP_Client *client, const char *name)
+{
+    uint16_t i;
+
+    for(i = 0U; i < client->symbolCount; i++)
+    {
+        if(strcmp(client->symbols[i].name, name) == 0)
+        {
+            return &client->symbols[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 组装 [命令][字数][扩展][地址 4B][数据]，返回不含计数的长度。
+ */
+static uint16_t XCP_CLIENT_access(uint16_t *request, uint16_t command, uint16_t extension,
+                                  uint32_t address, uint16_t words, const uint16_t *data)
+{
+    uint16_t length = 7U;
+    uint16_t i;
+
+    request[0] = command;
+    request[1] = words;
+    request[2] = extension;
+    (void)APP_TELEM_FRAME_putU32(&request[3], address);
+
+    for(i = 0U; (data != NULL) && (i < words); i++)
+    {
+        length += APP_TELEM_FRAME_putU16(&request[length], data[i]);
+    }
+
+    return length;
+}
+
+bool XCP_CLIENT_upload(XCP_Client *client, uint16_t extension, uint32_t address,
+                       uint16_t words, uint16_t *data)
+{
+    uint16_t request[APP_XCP_RAW_MAX];
+    uint16_t i;
+
+    if(!XCP_CLIENT_command(client, request,
+                           XCP_CLIENT_access(request, APP_XCP_CMD_SHORT_UPLOAD, extension, address, words, NULL)))
+    {
+        return false;
+    }
+
+    if(client->responseLength < (2U + (2U * words)))
+    {
+        client->lastError = XCP_CLIENT_ERR_PROTOCOL;
+        return false;
+    }
+
+    for(i = 0U; i < words; i++)
+    {
+        data[i] = APP_TELEM_FRAME_getU16(&client->response[2U + (2U * i)]);
+    }
+
+    return true;
+}
+
+bool XCP_CLIENT_download(XCP_Client *client, uint16_t extension, uint32_t address,
+                         uint16_t words, const uint16_t *data)
+{
+    uint16_t request[APP_XCP_RAW_MAX];
+
+    if(words > APP_XCP_MAX_WORDS)
+    {
+        client->lastError = XCP_CLIENT_ERR_PROTOCOL;
+        return false;
+    }
+
+    return XCP_CLIENT_command(client, request,
+                              XCP_CLIENT_access(request, APP_XCP_CMD_DOWNLOAD, extension, address, words, data));
+}
+
+bool XCP_CLIENT_shortDownload(XCP_Client *client, uint16_t extension, uint32_t address,
+                              uint16_t words, const uint16_t *data)
+{
+    uint16_t request[APP_XCP_RAW_MAX];
+
+    if(words > APP_XCP_MAX_WORDS)
+    {
+        client->lastError = XCP_CLIENT_ERR_PROTOCOL;
+        return false;
+    }
+
+    return XCP_CLIENT_command(client, request,
+                              XCP_CLIENT_access(request, APP_XCP_CMD_SHORT_DOWNLOAD, extension, address, words, data));
+}
+
+bool XCP_CLIENT_commit(XCP_Client *client)
+{
+    uint16_t request[2] = { APP_XCP_CMD_USER, APP_XCP_USER_COMMIT };
+
+    return XCP_CLIENT_command(client, request, 2U);
+}
+
+double XCP_CLIENT_decodeValue(uint16_t type, const uint16_t *words)
+{
+    uint32_t bits = (uint32_t)words[0];
+    float value;
+
+    switch(type)
+    {
+        case APP_XCP_TYPE_INT16:
+            return (double)(int16_t)words[0];
+
+        case APP_XCP_TYPE_UINT16:
+            return (double)words[0];
+
+        case APP_XCP_TYPE_INT32:
+            return (double)(int32_t)(bits | ((uint32_t)words[1] << 16));
+
+        case APP_XCP_TYPE_UINT32:
+            return (double)(bits | ((uint32_t)words[1] << 16));
+
+        default:
+            bits |= (uint32_t)words[1] << 16;
+            memcpy(&value, &bits, sizeof(value));
+            return (double)value;
+    }
+}
+
+static void XCP_CLIENT_encodeValue(uint16_t type, double value, uint16_t *words)
+{
+    uint32_t bits;
+    float single;
+
+    switch(type)
+    {
+        case APP_XCP_TYPE_INT16:
+            words[0] = (uint16_t)(int16_t)value;
+            return;
+
+        case APP_XCP_TYPE_UINT16:
+            words[0] = (uint16_t)value;
+            return;
+
+        case APP_XCP_TYPE_INT32:
+            bits = (uint32_t)(int32_t)value;
+            break;
+
+        case APP_XCP_TYPE_UINT32:
+            bits = (uint32_t)value;
+            break;
+
+        default:
+            single = (float)value;
+            memcpy(&bits, &single, sizeof(bits));
+            break;
+    }
+
+    words[0] = (uint16_t)(bits & 0xFFFFU);
+    words[1] = (uint16_t)(bits >> 16);
+}
+
+bool XCP_CLIENT_readValue(XCP_Client *client, const XCP_ClientSymbol *symbol, double *value)
+{
+    uint16_t words[2] = { 0U, 0U };
+
+    if(!XCP_CLIENT_upload(client, 0U, symbol->address, symbol->words, words))
+    {
+        return false;
+    }
+
+    *value = XCP_CLIENT_decodeValue(symbol->type, words);
+
+    return true;
+}
+
+bool XCP_CLIENT_stageValue(XCP_Client *client, const XCP_ClientSymbol *symbol, double value)
+{
+    uint16_t words[2];
+
+    XCP_CLIENT_encodeValue(symbol->type, value, words);
+
+    return XCP_CLIENT_download(client, 0U, symbol->address, symbol->words, words);
+}
+
+bool XCP_CLIENT_writeValue(XCP_Client *client, const XCP_ClientSymbol *symbol, double value)
+{
+    uint16_t words[2];
+
+    XCP_CLIENT_encodeValue(symbol->type, value, words);
+
+    return XCP_CLIENT_shortDownload(client, 0U, symbol->address, symbol->words, words);
+}
+
+bool XCP_CLIENT_clearDaq(XCP_Client *client, uint16_t list)
+{
+    uint16_t request[2] = { APP_XCP_CMD_CLEAR_DAQ_LIST, list };
+
+    return XCP_CLIENT_command(client, request, 2U);
+}
+
+bool XCP_CLIENT_addDaq(XCP_Client *client, uint16_t list, uint32_t address, uint16_t words)
+{
+    uint16_t request[7];
+
+    request[0] = APP_XCP_CMD_WRITE_DAQ;
+    request[1] = list;
+    request[2] = words;
+    (void)APP_TELEM_FRAME_putU32(&request[3], address);
+
+    return XCP_CLIENT_command(client, request, 7U);
+}
+
+bool XCP_CLIENT_setDaqPrescaler(XCP_Client *client, uint16_t list, uint16_t prescaler)
+{
+    uint16_t request[4];
+
+    request[0] = APP_XCP_CMD_SET_DAQ_LIST_MODE;
+    request[1] = list;
+    (void)APP_TELEM_FRAME_putU16(&request[2], prescaler);
+
+    return XCP_CLIENT_command(client, request, 4U);
+}
+
+bool XCP_CLIENT_startDaq(XCP_Client *client, uint16_t list, bool start)
+{
+    uint16_t request[3] = { APP_XCP_CMD_START_STOP_DAQ_LIST, list, start ? 1U : 0U };
+
+    return XCP_CLIENT_command(client, request, 3U);
+}
+
+void XCP_CLIENT_poll(XCP_Client *client, int timeoutMs)
+{
+    (void)XCP_CLIENT_receive(client, 0xFFFFU, timeoutMs);
+}
+
+const char *XCP_CLIENT_errorName(uint16_t code)
+{
+    switch(code)
+    {
+        case 0U:                                    return "OK";
+        case APP_XCP_ERR_CMD_BUSY:                  return "CMD_BUSY";
+        case APP_XCP_ERR_CMD_UNKNOWN:               return "CMD_UNKNOWN";
+        case APP_XCP_ERR_CMD_SYNTAX:                return "CMD_SYNTAX";
+        case APP_XCP_ERR_OUT_OF_RANGE:              return "OUT_OF_RANGE";
+        case APP_XCP_ERR_WRITE_PROTECTED:           return "WRITE_PROTECTED";
+        case APP_XCP_ERR_ACCESS_DENIED:             return "ACCESS_DENIED";
+        case APP_XCP_ERR_DAQ_ACTIVE:                return "DAQ_ACTIVE";
+        case APP_XCP_ERR_DAQ_CONFIG:                return "DAQ_CONFIG";
+        case APP_XCP_ERR_MEMORY_OVERFLOW:           return "MEMORY_OVERFLOW";
+        case APP_XCP_ERR_RESOURCE_UNAVAILABLE:      return "RESOURCE_UNAVAILABLE";
+        case XCP_CLIENT_ERR_TIMEOUT:                return "TIMEOUT";
+        case XCP_CLIENT_ERR_IO:                     return "IO";
+        default:                                    return "PROTOCOL";
+    }
+}
@@ -0,0 +1,429 @@
+/**
+ * @file xcp_pty_test.c
+ * @brief 标定协议伪终端回环测试（主机端）。
+ *
+ * 子进程在伪终端从端上运行模拟目标（app_xcp.c 的真实代码、线程模拟的控制中断、
+ * components/pid 的 PID 对象），父进程在主端上以 xcp_client 访问，检查：
+ *  - 连接后读到完整的符号表，上传的初值与模拟目标一致；
+ *  - 多个参数经一次提交写入时，控制中断从未看到半新半旧的参数组合，
+ *    逐项立即写入时则能看到，说明检查本身有效；
+ *  - 只读符号、窗口外地址、未知命令、暂存溢出与未登记的地址空间返回对应错误码；
+ *  - 异步地址空间的写入与读回；
+ *  - DAQ 包的序号连续、计数步长等于分频、运行中修改列表被拒绝、停止后不再发送；
+ *  - 控制中断停止后提交超时并返回 RESOURCE_UNAVAILABLE，参数保持原值。
+ * 任一检查失败时返回非零值。
+ */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "xcp_client.h"
+#include "xcp_sim_target.h"
+
+/** 原子提交的轮数。 */
+#define COMMIT_ROUNDS       (200U)
+
+static int s_failures = 0;
+
+#define CHECK(cond, ...)                                    \
+    do                                                      \
+    {                                                       \
+        if(!(cond))                                         \
+        {                                                   \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);     \
+            printf(__VA_ARGS__);                            \
+            printf("\n");                                   \
+            s_failures++;                                   \
+        }                                                   \
+    } while(0)
+
+static volatile bool s_stop = false;
+
+static void onTerm(int signal)
+{
+    (void)signal;
+    s_stop = true;
+}
+
+/**
+ * @brief DAQ 接收统计。
+ */
+typedef struct
+{
+    uint32_t packets[2];
+    uint32_t gaps[2];
+    uint32_t badSteps[2];
+    uint32_t badTimestamps;
+    bool     seen[2];
+    uint16_t lastSequence[2];
+    uint32_t lastCount[2];
+    uint16_t prescaler[2];
+} DaqContext;
+
+static void onDaq(const XCP_DaqPacket *packet, void *context)
+{
+    DaqContext *daq = (DaqContext *)context;
+    uint16_t list = packet->list;
+    uint32_t count;
+
+    if((list > 1U) || (packet->words < 2U))
+    {
+        return;
+    }
+
+    count = (uint32_t)XCP_CLIENT_decodeValue(APP_XCP_TYPE_UINT32, packet->data);
+
+    /* 时间戳为采样时的中断计数，与列表中的 loop.count 相同。 */
+    if(count != packet->timestamp)
+    {
+        daq->badTimestamps++;
+    }
+
+    if(daq->seen[list])
+    {
+        uint16_t step = (uint16_t)((packet->sequence - daq->lastSequence[list]) & 0xFFU);
+
+        if(step != 1U)
+        {
+            daq->gaps[list]++;
+        }
+
+        if((count - daq->lastCount[list]) != ((uint32_t)step * daq->prescaler[list]))
+        {
+            daq->badSteps[list]++;
+        }
+    }
+
+    daq->seen[list]         = true;
+    daq->lastSequence[list] = packet->sequence;
+    daq->lastCount[list]    = count;
+    daq->packets[list]++;
+}
+
+static pid_t startTarget(int *master)
+{
+    struct termios tio;
+    pid_t child;
+    int slave;
+
+    *master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if((*master < 0) || (grantpt(*master) != 0) || (unlockpt(*master) != 0))
+    {
+        perror("posix_openpt");
+        exit(2);
+    }
+
+    slave = open(ptsname(*master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if(slave < 0)
+    {
+        perror("open slave");
+        exit(2);
+    }
+
+    /* 原始模式：0x00、0x0A、0x11 等字节不做任何转换。 */
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    child = fork();
+
+    if(child < 0)
+    {
+        perror("fork");
+        exit(2);
+    }
+
+    if(child == 0)
+    {
+        close(*master);
+        signal(SIGTERM, onTerm);
+        exit(XCP_SIM_run(slave, &s_stop) ? 0 : 3);
+    }
+
+    close(slave);
+
+    return child;
+}
+
+static const XCP_ClientSymbol *symbol(const XCP_Client *client, const char *name)
+{
+    const XCP_ClientSymbol *found = XCP_CLIENT_findSymbol(client, name);
+
+    if(found == NULL)
+    {
+        printf("FAIL: symbol %s missing\n", name);
+        exit(1);
+    }
+
+    return found;
+}
+
+static double readValue(XCP_Client *client, const char *name)
+{
+    double value = 0.0;
+
+    CHECK(XCP_CLIENT_readValue(client, symbol(client, name), &value),
+          "read %s: %s", name, XCP_CLIENT_errorName(client->lastError));
+
+    return value;
+}
+
+static void testSymbols(XCP_Client *client)
+{
+    const XCP_ClientSymbol *count;
+
+    CHECK(client->symbolCount == 15U, "symbols %u", client->symbolCount);
+    CHECK(client->spaces == 0x3U, "spaces 0x%x", client->spaces);
+
+    count = symbol(client, "loop.count");
+    CHECK((count->type == APP_XCP_TYPE_UINT32) && (count->words == 2U) &&
+          ((count->flags & APP_XCP_SYM_WRITABLE) == 0U), "loop.count descriptor");
+    CHECK((symbol(client, "pid.Kp")->flags & APP_XCP_SYM_WRITABLE) != 0U, "pid.Kp writable");
+
+    CHECK(readValue(client, "pid.Kp") == 0.5, "Kp initial");
+    CHECK(readValue(client, "pid.Ki") == 1.0, "Ki initial");
+    CHECK(readValue(client, "pid.derFilter.a1") == -0.5, "a1 initial");
+    CHECK(readValue(client, "sim.isrEnable") == 1.0, "isrEnable initial");
+}
+
+/**
+ * @brief 每轮在一次提交中写入 Kp、Ki 与三个滤波器系数，保持两条不变式。
+ */
+static void testAtomicCommit(XCP_Client *client)
+{
+    const XCP_ClientSymbol *kp = symbol(client, "pid.Kp");
+    const XCP_ClientSymbol *ki = symbol(client, "pid.Ki");
+    const XCP_ClientSymbol *a1 = symbol(client, "pid.derFilter.a1");
+    const XCP_ClientSymbol *b0 = symbol(client, "pid.derFilter.b0");
+    const XCP_ClientSymbol *b1 = symbol(client, "pid.derFilter.b1");
+    XCP_ClientStatus status;
+    double loopsBefore = readValue(client, "loop.count");
+    uint32_t round;
+    bool ok = true;
+
+    for(round = 1U; (round <= COMMIT_ROUNDS) && ok; round++)
+    {
+        /* 取 1/64 的整数倍，浮点运算无舍入，不变式可以精确比较。 */
+        double gain = (double)(round % 61U + 1U) / 64.0;
+        double coeff = (double)(round % 29U + 1U) / 64.0;
+
+        ok = XCP_CLIENT_stageValue(client, kp, gain) &&
+             XCP_CLIENT_stageValue(client, ki, 2.0 * gain) &&
+             XCP_CLIENT_stageValue(client, b0, coeff) &&
+             XCP_CLIENT_stageValue(client, b1, coeff) &&
+             XCP_CLIENT_stageValue(client, a1, 2.0 * coeff - 1.0) &&
+             XCP_CLIENT_commit(client);
+
+        CHECK(ok, "commit round %u: %s", round, XCP_CLIENT_errorName(client->lastError));
+    }
+
+    CHECK(readValue(client, "loop.violations") == 0.0, "violations after atomic commits %.0f",
+          readValue(client, "loop.violations"));
+    CHECK(readValue(client, "pid.Kp") == (double)(COMMIT_ROUNDS % 61U + 1U) / 64.0, "Kp final");
+    CHECK(readValue(client, "loop.count") > loopsBefore, "control loop not running");
+    CHECK(XCP_CLIENT_getStatus(client, &status) && (status.staged == 0U), "stage not empty");
+
+    /* 对照：逐项立即写入，两次写入之间的中断会看到 Ki != 2 * Kp。 */
+    CHECK(XCP_CLIENT_writeValue(client, kp, 1.0), "short download Kp");
+    usleep(20000);
+    CHECK(XCP_CLIENT_writeValue(client, ki, 2.0), "short download Ki");
+    CHECK(readValue(client, "loop.violations") > 0.0, "non-atomic writes not detected");
+
+    printf("commits: %u rounds, loops %.0f\n", COMMIT_ROUNDS, readValue(client, "loop.count"));
+}
+
+static void testErrors(XCP_Client *client)
+{
+    const XCP_ClientSymbol *kp = symbol(client, "pid.Kp");
+    uint16_t words[2] = { 0U, 0U };
+    uint16_t request[2];
+    uint16_t i;
+
+    CHECK(!XCP_CLIENT_writeValue(client, symbol(client, "loop.count"), 1.0) &&
+          (client->lastError == APP_XCP_ERR_WRITE_PROTECTED), "read-only: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    /* 跨出可写符号的写入同样拒绝。 */
+    CHECK(!XCP_CLIENT_download(client, 0U, kp->address + 1U, 2U, words) &&
+          (client->lastError == APP_XCP_ERR_WRITE_PROTECTED), "straddling write: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    CHECK(!XCP_CLIENT_upload(client, 0U, 0x10000U, 1U, words) &&
+          (client->lastError == APP_XCP_ERR_OUT_OF_RANGE), "outside window: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    CHECK(!XCP_CLIENT_upload(client, 2U, 0U, 1U, words) &&
+          (client->lastError == APP_XCP_ERR_ACCESS_DENIED), "unregistered space: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    request[0] = 0xC0U;
+    CHECK(!XCP_CLIENT_command(client, request, 1U) &&
+          (client->lastError == APP_XCP_ERR_CMD_UNKNOWN), "unknown command: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    request[0] = APP_XCP_CMD_USER;
+    request[1] = 0x7FU;
+    CHECK(!XCP_CLIENT_command(client, request, 2U) &&
+          (client->lastError == APP_XCP_ERR_CMD_UNKNOWN), "unknown user command: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    for(i = 0U; i < APP_XCP_STAGE_ENTRIES; i++)
+    {
+        CHECK(XCP_CLIENT_stageValue(client, kp, 0.5), "stage %u", i);
+    }
+
+    CHECK(!XCP_CLIENT_stageValue(client, kp, 0.5) &&
+          (client->lastError == APP_XCP_ERR_MEMORY_OVERFLOW), "stage overflow: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    /* 断开丢弃暂存数据，Kp 保持原值。 */
+    CHECK(XCP_CLIENT_disconnect(client), "disconnect");
+    CHECK(XCP_CLIENT_connect(client), "reconnect");
+    CHECK(readValue(client, "pid.Kp") == 1.0, "staged data applied after disconnect");
+}
+
+static void testSpace(XCP_Client *client)
+{
+    uint16_t written[3] = { 0x1234U, 0x00FFU, 0xA55AU };
+    uint16_t readBack[3] = { 0U, 0U, 0U };
+
+    CHECK(XCP_CLIENT_shortDownload(client, 1U, 5U, 3U, written), "space write: %s",
+          XCP_CLIENT_errorName(client->lastError));
+    CHECK(XCP_CLIENT_upload(client, 1U, 5U, 3U, readBack), "space read: %s",
+          XCP_CLIENT_errorName(client->lastError));
+    CHECK(memcmp(written, readBack, sizeof(written)) == 0, "space data");
+
+    /* 异步空间没有安全点，暂存写入被拒绝。 */
+    CHECK(!XCP_CLIENT_download(client, 1U, 5U, 1U, written) &&
+          (client->lastError == APP_XCP_ERR_ACCESS_DENIED), "space stage: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    CHECK(!XCP_CLIENT_upload(client, 1U, XCP_SIM_SPACE_REGS - 1U, 2U, readBack) &&
+          (client->lastError == APP_XCP_ERR_CMD_BUSY), "space range: %s",
+          XCP_CLIENT_errorName(client->lastError));
+}
+
+static void testDaq(XCP_Client *client)
+{
+    const XCP_ClientSymbol *count = symbol(client, "loop.count");
+    const XCP_ClientSymbol *plant = symbol(client, "loop.plant");
+    const XCP_ClientSymbol *output = symbol(client, "loop.output");
+    DaqContext daq;
+    XCP_ClientStatus status;
+    uint32_t after;
+
+    memset(&daq, 0, sizeof(daq));
+    daq.prescaler[0] = 100U;
+    daq.prescaler[1] = 250U;
+    XCP_CLIENT_setDaqCallback(client, onDaq, &daq);
+
+    CHECK(XCP_CLIENT_clearDaq(client, 0U) &&
+          XCP_CLIENT_addDaq(client, 0U, count->address, count->words) &&
+          XCP_CLIENT_addDaq(client, 0U, plant->address, plant->words) &&
+          XCP_CLIENT_addDaq(client, 0U, output->address, output->words) &&
+          XCP_CLIENT_setDaqPrescaler(client, 0U, daq.prescaler[0]), "configure list 0: %s",
+          XCP_CLIENT_errorName(client->lastError));
+    CHECK(XCP_CLIENT_clearDaq(client, 1U) &&
+          XCP_CLIENT_addDaq(client, 1U, count->address, count->words) &&
+          XCP_CLIENT_setDaqPrescaler(client, 1U, daq.prescaler[1]), "configure list 1: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    CHECK(!XCP_CLIENT_startDaq(client, 2U, true) && (client->lastError == APP_XCP_ERR_DAQ_CONFIG),
+          "start empty list: %s", XCP_CLIENT_errorName(client->lastError));
+    CHECK(!XCP_CLIENT_setDaqPrescaler(client, 0U, 0U) && (client->lastError == APP_XCP_ERR_OUT_OF_RANGE),
+          "zero prescaler: %s", XCP_CLIENT_errorName(client->lastError));
+
+    CHECK(XCP_CLIENT_startDaq(client, 0U, true) && XCP_CLIENT_startDaq(client, 1U, true), "start");
+    CHECK(!XCP_CLIENT_addDaq(client, 0U, count->address, count->words) &&
+          (client->lastError == APP_XCP_ERR_DAQ_ACTIVE), "modify running list: %s",
+          XCP_CLIENT_errorName(client->lastError));
+
+    XCP_CLIENT_poll(client, 500);
+
+    /* DAQ 运行时命令仍然应答。 */
+    CHECK(readValue(client, "pid.Kp") == 1.0, "upload during DAQ");
+    CHECK(XCP_CLIENT_getStatus(client, &status) && (status.daqRunning == 0x3U), "running mask");
+    XCP_CLIENT_poll(client, 500);
+
+    CHECK(XCP_CLIENT_startDaq(client, 0U, false) && XCP_CLIENT_startDaq(client, 1U, false), "stop");
+    XCP_CLIENT_poll(client, 50);
+    after = daq.packets[0] + daq.packets[1];
+    XCP_CLIENT_poll(client, 100);
+
+    printf("daq: list0 %u packets, list1 %u packets, gaps %u/%u, overruns %u\n",
+           daq.packets[0], daq.packets[1], daq.gaps[0], daq.gaps[1], status.daqOverruns);
+
+    CHECK(daq.packets[0] > 20U, "list 0 packets %u", daq.packets[0]);
+    CHECK(daq.packets[1] > 8U, "list 1 packets %u", daq.packets[1]);
+    CHECK((daq.badSteps[0] == 0U) && (daq.badSteps[1] == 0U), "count step %u/%u",
+          daq.badSteps[0], daq.badSteps[1]);
+    CHECK((daq.gaps[0] == 0U) && (daq.gaps[1] == 0U), "sequence gaps %u/%u", daq.gaps[0], daq.gaps[1]);
+    CHECK(daq.badTimestamps == 0U, "timestamps %u", daq.badTimestamps);
+    CHECK((daq.packets[0] + daq.packets[1]) == after, "packets after stop");
+    CHECK(client->badFrames == 0U, "bad frames %u", client->badFrames);
+
+    XCP_CLIENT_setDaqCallback(client, NULL, NULL);
+}
+
+static void testTimeout(XCP_Client *client)
+{
+    const XCP_ClientSymbol *kp = symbol(client, "pid.Kp");
+    XCP_ClientStatus before;
+    XCP_ClientStatus after;
+
+    CHECK(XCP_CLIENT_writeValue(client, symbol(client, "sim.isrEnable"), 0.0), "stop isr");
+    CHECK(XCP_CLIENT_getStatus(client, &before), "status");
+    CHECK(XCP_CLIENT_stageValue(client, kp, 0.25), "stage Kp");
+    CHECK(!XCP_CLIENT_commit(client) && (client->lastError == APP_XCP_ERR_RESOURCE_UNAVAILABLE),
+          "commit without isr: %s", XCP_CLIENT_errorName(client->lastError));
+    CHECK(XCP_CLIENT_getStatus(client, &after) && (after.safePoints == before.safePoints) &&
+          (after.staged == 0U), "safe points %u -> %u", before.safePoints, after.safePoints);
+    CHECK(readValue(client, "pid.Kp") == 1.0, "timed out commit applied");
+}
+
+int main(void)
+{
+    XCP_Client client;
+    int master;
+    int status = 0;
+    pid_t child = startTarget(&master);
+
+    XCP_CLIENT_init(&client, master, 1000);
+
+    CHECK(XCP_CLIENT_connect(&client), "connect: %s", XCP_CLIENT_errorName(client.lastError));
+
+    if(s_failures == 0)
+    {
+        testSymbols(&client);
+        testAtomicCommit(&client);
+        testErrors(&client);
+        testSpace(&client);
+        testDaq(&client);
+        testTimeout(&client);
+    }
+
+    kill(child, SIGTERM);
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0), "target exit status 0x%x", status);
+
+    if(s_failures != 0)
+    {
+        printf("%d check(s) failed\n", s_failures);
+        return 1;
+    }
+
+    printf("PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file xcp_sim_main.c
+ * @brief 独立运行的模拟目标：打开伪终端并打印从端路径，供 xcp_cli 连接。
+ */
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "xcp_sim_target.h"
+
+static volatile bool s_stop = false;
+
+static void onSignal(int signal)
+{
+    (void)signal;
+    s_stop = true;
+}
+
+int main(void)
+{
+    struct termios tio;
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    int slave;
+
+    if((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+    {
+        perror("posix_openpt");
+        return 2;
+    }
+
+    /* 保持从端打开，客户端断开时主端不会读到挂断。 */
+    slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+
+    if(slave < 0)
+    {
+        perror("open slave");
+        return 2;
+    }
+
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    printf("%s\n", ptsname(master));
+    fflush(stdout);
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    return XCP_SIM_run(master, &s_stop) ? 0 : 3;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file xcp_sim_target.c
+ * @brief 主机端模拟目标实现。
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "xcp_sim_target.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "app_xcp.h"
+#include "sci_pty.h"
+
+/** 主循环节拍，与 FreeRTOS tick 相同。 */
+#define XCP_SIM_TICK_HZ             (1000U)
+
+/** 中断线程的间隔。 */
+#define XCP_SIM_ISR_PERIOD_NS       (100000L)
+
+/** 异步空间的操作延迟。 */
+#define XCP_SIM_SPACE_TICKS         (3U)
+
+static XCP_SimMemory s_memory;
+
+static const APP_XCP_Symbol s_symbols[] =
+{
+    { "pid.Kp",          &s_memory.pid.Kp,            APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.Ki",          &s_memory.pid.Ki,            APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.Kd",          &s_memory.pid.Kd,            APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.outMin",      &s_memory.pid.outMin,        APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.outMax",      &s_memory.pid.outMax,        APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.Ui",          &s_memory.pid.Ui,            APP_XCP_TYPE_FLOAT32, 0U },
+    { "pid.derFilter.a1", &s_memory.pid.derFilter.a1, APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.derFilter.b0", &s_memory.pid.derFilter.b0, APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "pid.derFilter.b1", &s_memory.pid.derFilter.b1, APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "loop.ref",        &s_memory.ref,               APP_XCP_TYPE_FLOAT32, APP_XCP_SYM_WRITABLE },
+    { "loop.output",     &s_memory.output,            APP_XCP_TYPE_FLOAT32, 0U },
+    { "loop.plant",      &s_memory.plant,             APP_XCP_TYPE_FLOAT32, 0U },
+    { "loop.count",      &s_memory.loops,             APP_XCP_TYPE_UINT32,  0U },
+    { "loop.violations", &s_memory.violations,        APP_XCP_TYPE_UINT32,  0U },
+    { "sim.isrEnable",   &s_memory.isrEnable,         APP_XCP_TYPE_UINT16,  APP_XCP_SYM_WRITABLE },
+};
+
+static uint16_t s_registers[XCP_SIM_SPACE_REGS];
+static uint32_t s_spaceAddress = 0U;
+static uint16_t s_spaceWords = 0U;
+static uint16_t s_spaceTicks = 0U;
+static bool     s_spaceWrite = false;
+static bool     s_spaceBusy = false;
+
+static volatile const bool *s_stop = NULL;
+
+static bool XCP_SIM_spaceStart(bool write, uint32_t address, uint16_t *data, uint16_t words)
+{
+    uint16_t i;
+
+    if(s_spaceBusy || (address >= XCP_SIM_SPACE_REGS) || (words > (XCP_SIM_SPACE_REGS - address)))
+    {
+        return false;
+    }
+
+    if(write)
+    {
+        for(i = 0U; i < words; i++)
+        {
+            s_registers[address + i] = data[i];
+        }
+    }
+
+    s_spaceAddress = address;
+    s_spaceWords   = words;
+    s_spaceWrite   = write;
+    s_spaceTicks   = 0U;
+    s_spaceBusy    = true;
+
+    return true;
+}
+
+static uint16_t XCP_SIM_spacePoll(uint16_t *data, uint16_t words)
+{
+    uint16_t i;
+
+    s_spaceTicks++;
+
+    if(s_spaceTicks < XCP_SIM_SPACE_TICKS)
+    {
+        return APP_XCP_SPACE_BUSY;
+    }
+
+    if(!s_spaceWrite)
+    {
+        for(i = 0U; (i < words) && (i < s_spaceWords); i++)
+        {
+            data[i] = s_registers[s_spaceAddress + i];
+        }
+    }
+
+    s_spaceBusy = false;
+
+    return APP_XCP_SPACE_DONE;
+}
+
+static const APP_XCP_Space s_space =
+{
+    XCP_SIM_spaceStart,
+    XCP_SIM_spacePoll
+};
+
+static void XCP_SIM_sleepUntil(struct timespec *next, long periodNs)
+{
+    next->tv_nsec += periodNs;
+
+    while(next->tv_nsec >= 1000000000L)
+    {
+        next->tv_nsec -= 1000000000L;
+        next->tv_sec++;
+    }
+
+    (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, next, NULL);
+}
+
+/**
+ * @brief 一次控制计算：检查不变式后运行 PID 与一阶对象。
+ */
+static void XCP_SIM_step(void)
+{
+    volatile XCP_SimMemory *memory = &s_memory;
+    float32_t output;
+
+    if(memory->pid.Ki != (2.0f * memory->pid.Kp))
+    {
+        memory->violations++;
+    }
+
+    if((memory->pid.derFilter.b0 + memory->pid.derFilter.b1) != (1.0f + memory->pid.derFilter.a1))
+    {
+        memory->violations++;
+    }
+
+    PID_run_parallel(&s_memory.pid, memory->ref, memory->plant, 0.0f, &output);
+
+    memory->output = output;
+    memory->plant += 0.01f * (output - memory->plant);
+    memory->loops++;
+}
+
+static void *XCP_SIM_isr(void *argument)
+{
+    struct timespec next;
+
+    (void)argument;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while(!*s_stop)
+    {
+        if(((volatile XCP_SimMemory *)&s_memory)->isrEnable != 0U)
+        {
+            APP_XCP_safePoint();
+            XCP_SIM_step();
+            APP_XCP_daqSample(((volatile XCP_SimMemory *)&s_memory)->loops);
+        }
+
+        XCP_SIM_sleepUntil(&next, XCP_SIM_ISR_PERIOD_NS);
+    }
+
+    return NULL;
+}
+
+bool XCP_SIM_run(int fd, volatile const bool *stop)
+{
+    struct timespec next;
+    pthread_t isr;
+
+    s_stop = stop;
+
+    (void)PID_init(&s_memory.pid, sizeof(s_memory.pid));
+    PID_setGains(&s_memory.pid, 0.5f, 1.0f, 0.0f);
+    PID_setMinMax(&s_memory.pid, -1.0f, 1.0f);
+    PID_setUi(&s_memory.pid, 0.0f);
+    PID_setDerFilterParams(&s_memory.pid, 0.25f, 0.25f, -0.5f, 0.0f, 0.0f);
+    s_memory.ref       = 0.5f;
+    s_memory.isrEnable = 1U;
+
+    SCI_PTY_init(fd, XCP_SIM_TICK_HZ);
+    APP_XCP_init(s_symbols, (uint16_t)(sizeof(s_symbols) / sizeof(s_symbols[0])));
+    APP_XCP_setMemoryWindow(&s_memory, sizeof(s_memory) / sizeof(uint16_t));
+    (void)APP_XCP_setSpace(1U, &s_space);
+
+    if(pthread_create(&isr, NULL, XCP_SIM_isr, NULL) != 0)
+    {
+        return false;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while(!*stop)
+    {
+        SCI_PTY_tick();
+        APP_XCP_service();
+        XCP_SIM_sleepUntil(&next, 1000000000L / XCP_SIM_TICK_HZ);
+    }
+
+    (void)pthread_join(isr, NULL);
+
+    return true;
+}